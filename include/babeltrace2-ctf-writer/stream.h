@@ -31,6 +31,7 @@ extern "C" {
 
 struct bt_ctf_stream;
 struct bt_ctf_event;
+struct bt_ctf_event_class;
 
 /*
  * bt_ctf_stream_get_discarded_events_count: get the number of discarded
@@ -147,6 +148,71 @@ extern int bt_ctf_stream_set_packet_context(
  */
 extern int bt_ctf_stream_flush(struct bt_ctf_stream *stream);
 
+/*
+ * bt_ctf_stream_get_event_template: get a stream's event template for a
+ * given event class.
+ *
+ * The returned event is created on the first call for a given event
+ * class and then reused: set its fields and write it with
+ * bt_ctf_stream_write_event() as many times as needed instead of
+ * creating an event per record. Its fields keep their values between
+ * writes, except for its header which is populated again on each
+ * write.
+ *
+ * @param stream Stream instance.
+ * @param event_class Event class (part of the stream's class) of the
+ *	event template.
+ *
+ * Returns an event instance on success, NULL on error.
+ */
+extern struct bt_ctf_event *bt_ctf_stream_get_event_template(
+		struct bt_ctf_stream *stream,
+		struct bt_ctf_event_class *event_class);
+
+/*
+ * bt_ctf_stream_write_event: write an event to the stream.
+ *
+ * Contrary to bt_ctf_stream_append_event(), the event is serialized
+ * immediately to the stream's current packet (opening it if needed)
+ * and the stream does not keep any reference to it: the event may be
+ * modified and written again afterwards, so that memory usage does not
+ * depend on the number of events in a packet. The stream's associated
+ * clock is sampled during this call if the event header's timestamp
+ * field is not set.
+ *
+ * The current packet is closed by bt_ctf_stream_flush() or, if a
+ * maximum packet size is set (see bt_ctf_stream_set_max_packet_size()),
+ * as soon as its content reaches this size. Events may not be appended
+ * with bt_ctf_stream_append_event() while a packet opened by this
+ * function is not closed, and vice versa.
+ *
+ * @param stream Stream instance.
+ * @param event Event instance (not appended to any stream) to write.
+ *
+ * Returns 0 on success, a negative value on error.
+ */
+extern int bt_ctf_stream_write_event(struct bt_ctf_stream *stream,
+		struct bt_ctf_event *event);
+
+/*
+ * bt_ctf_stream_set_max_packet_size: set the size from which a packet
+ * is closed automatically.
+ *
+ * When the content of the current packet reaches "max_packet_size"
+ * bytes after an event is written with bt_ctf_stream_write_event(),
+ * the packet is closed as if bt_ctf_stream_flush() was called. The
+ * stream class' packet context must have a "packet_size" field to
+ * write more than one packet.
+ *
+ * @param stream Stream instance.
+ * @param max_packet_size Size (bytes), or 0 to only close packets with
+ *	bt_ctf_stream_flush() (default).
+ *
+ * Returns 0 on success, a negative value on error.
+ */
+extern int bt_ctf_stream_set_max_packet_size(struct bt_ctf_stream *stream,
+		uint64_t max_packet_size);
+
 extern int bt_ctf_stream_is_writer(struct bt_ctf_stream *stream);
 
 extern
@@ -28,6 +28,7 @@
 #endif
 
 #include <babeltrace2/graph/component-class.h>
+#include <babeltrace2/graph/message.h>
 #include <babeltrace2/types.h>
 #include <babeltrace2/logging.h>
 
@@ -396,6 +397,115 @@ extern bt_logging_level bt_component_get_logging_level(
 
 /*! @} */
 
+/*!
+@name Statistics
+@{
+*/
+
+/*!
+@brief
+    Component statistics counters.
+
+The library maintains those counters while a \bt_graph runs, if you
+enabled its statistics with bt_graph_enable_statistics() (otherwise,
+they remain 0): for a \bt_src_comp or a \bt_flt_comp, they concern the
+"next" method calls of all its \bt_p_msg_iter; for a \bt_sink_comp,
+they concern its "consume" method calls.
+*/
+typedef enum bt_component_statistics_counter {
+	/*!
+	@brief
+	    Number of method calls.
+	*/
+	BT_COMPONENT_STATISTICS_COUNTER_METHOD_CALLS		= 0,
+
+	/*!
+	@brief
+	    Number of method calls which returned an "again" status.
+	*/
+	BT_COMPONENT_STATISTICS_COUNTER_AGAIN_STATUSES		= 1,
+
+	/*!
+	@brief
+	    Total number of \bt_p_msg which the message iterators
+	    returned (always 0 for a sink component).
+	*/
+	BT_COMPONENT_STATISTICS_COUNTER_MESSAGES		= 2,
+
+	/*!
+	@brief
+	    Maximum number of messages which a single "next" method
+	    call returned (always 0 for a sink component).
+	*/
+	BT_COMPONENT_STATISTICS_COUNTER_MAX_BATCH_SIZE		= 3,
+
+	/*!
+	@brief
+	    Cumulative time (ns) spent in the methods, including the
+	    time spent in the "next" methods of upstream message
+	    iterators.
+	*/
+	BT_COMPONENT_STATISTICS_COUNTER_TOTAL_TIME_NS		= 4,
+
+	/*!
+	@brief
+	    Cumulative time (ns) spent in the methods, excluding the
+	    time spent in the "next" methods of upstream message
+	    iterators.
+	*/
+	BT_COMPONENT_STATISTICS_COUNTER_SELF_TIME_NS		= 5,
+} bt_component_statistics_counter;
+
+/*!
+@brief
+    Returns the value of the statistics counter \bt_p{counter} of the
+    component \bt_p{component}.
+
+@param[in] component
+    Component of which to get a statistics counter.
+@param[in] counter
+    Statistics counter to get.
+
+@returns
+    Value of the statistics counter \bt_p{counter} of
+    \bt_p{component}.
+
+@bt_pre_not_null{component}
+
+@sa bt_component_get_statistics_message_count() &mdash;
+    Returns the number of messages of a given type which the message
+    iterators of a component returned.
+*/
+extern uint64_t bt_component_get_statistics_counter(
+		const bt_component *component,
+		bt_component_statistics_counter counter);
+
+/*!
+@brief
+    Returns the number of \bt_p_msg of type \bt_p{message_type} which
+    the \bt_p_msg_iter of the component \bt_p{component} returned.
+
+This is always 0 for a \bt_sink_comp.
+
+@param[in] component
+    Component of which to get a message count.
+@param[in] message_type
+    Type of the messages to count.
+
+@returns
+    Number of messages of type \bt_p{message_type} which the message
+    iterators of \bt_p{component} returned.
+
+@bt_pre_not_null{component}
+
+@sa bt_component_get_statistics_counter() &mdash;
+    Returns the value of a statistics counter of a component.
+*/
+extern uint64_t bt_component_get_statistics_message_count(
+		const bt_component *component, bt_message_type message_type);
+
+/*! @} */
+
 /*!
 @name Common reference count
 @{
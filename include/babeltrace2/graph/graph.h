@@ -1459,6 +1459,74 @@ and what you can and cannot do with a configured graph.
 */
 extern bt_graph_run_once_status bt_graph_run_once(bt_graph *graph);
 
+/*!
+@brief
+    Status codes for bt_graph_wait().
+*/
+typedef enum bt_graph_wait_status {
+	/*!
+	@brief
+	    Success.
+	*/
+	BT_GRAPH_WAIT_STATUS_OK			= __BT_FUNC_STATUS_OK,
+
+	/*!
+	@brief
+	    Cannot wait for the file descriptors.
+	*/
+	BT_GRAPH_WAIT_STATUS_ERROR		= __BT_FUNC_STATUS_ERROR,
+} bt_graph_wait_status;
+
+/*!
+@brief
+    Waits, for at most \bt_p{max_duration_us}&nbsp;µs, until a
+    \bt_msg_iter of the trace processing graph \bt_p{graph} which
+    returned "try again" during the last bt_graph_run() or
+    bt_graph_run_once() call is likely to be ready.
+
+Call this function after bt_graph_run() or bt_graph_run_once() returns
+"try again" instead of sleeping for a fixed amount of time.
+
+A message iterator declares what it's waiting for with
+bt_self_message_iterator_set_wait_fd() and
+bt_self_message_iterator_set_wait_timeout() before returning "try
+again". This function returns as soon as one of:
+
+- Any file descriptor which a message iterator declared is ready for
+  reading.
+
+- The earliest timeout which a message iterator declared expires.
+
+- \bt_p{max_duration_us}&nbsp;µs elapse.
+
+- The current thread receives a signal.
+
+If no message iterator declared anything to wait for, this function
+waits for \bt_p{max_duration_us}&nbsp;µs (or until the current thread
+receives a signal).
+
+@param[in] graph
+    Trace processing graph of which to wait for the message iterators.
+@param[in] max_duration_us
+    Maximum duration (µs) to wait.
+
+@retval #BT_GRAPH_WAIT_STATUS_OK
+    Success.
+@retval #BT_GRAPH_WAIT_STATUS_ERROR
+    Cannot wait for the file descriptors which message iterators
+    declared.
+
+@bt_pre_not_null{graph}
+
+@sa bt_self_message_iterator_set_wait_fd() &mdash;
+    Makes a message iterator declare a file descriptor to wait for.
+@sa bt_self_message_iterator_set_wait_timeout() &mdash;
+    Makes a message iterator declare a duration after which to try
+    again.
+*/
+extern bt_graph_wait_status bt_graph_wait(bt_graph *graph,
+		uint64_t max_duration_us);
+
 /*! @} */
 
 /*!
@@ -1557,6 +1625,34 @@ extern bt_interrupter *bt_graph_borrow_default_interrupter(bt_graph *graph);
 
 /*! @} */
 
+/*!
+@name Statistics
+@{
+*/
+
+/*!
+@brief
+    Makes the \bt_p_comp of the trace processing graph \bt_p{graph}
+    maintain their statistics while it runs.
+
+By default, a trace processing graph doesn't maintain the statistics
+of its components: all their counters remain 0.
+
+@param[in] graph
+    Trace processing graph of which to enable the component statistics.
+
+@bt_pre_not_null{graph}
+@pre
+    \bt_p{graph} is not configured yet (you didn't call bt_graph_run()
+    or bt_graph_run_once() on it).
+
+@sa bt_component_get_statistics_counter() &mdash;
+    Returns the value of a statistics counter of a component.
+*/
+extern void bt_graph_enable_statistics(bt_graph *graph);
+
+/*! @} */
+
 /*!
 @name Listeners
 @{
@@ -203,6 +203,72 @@ extern bt_bool bt_self_message_iterator_is_interrupted(
 
 /*! @} */
 
+/*!
+@name Wait conditions
+@{
+*/
+
+/*!
+@brief
+    Makes the \bt_msg_iter \bt_p{self_message_iterator} declare that
+    it's waiting for the file descriptor \bt_p{fd} to be ready for
+    reading.
+
+Call this function from the
+\ref api-msg-iter-cls-meth-next "\"next\" method" of
+\bt_p{self_message_iterator} before it returns
+#BT_MESSAGE_ITERATOR_CLASS_NEXT_METHOD_STATUS_AGAIN so that
+bt_graph_wait() returns as soon as there's something to read from
+\bt_p{fd} instead of sleeping for a fixed amount of time.
+
+The declaration only applies until the next bt_graph_run() or
+bt_graph_run_once() call. \bt_p{fd} must remain open until then.
+
+@param[in] self_message_iterator
+    Message iterator instance.
+@param[in] fd
+    File descriptor (socket on Windows) to wait for.
+
+@bt_pre_not_null{self_message_iterator}
+@pre
+    \bt_p{fd} is greater than or equal to 0.
+
+@sa bt_graph_wait() &mdash;
+    Waits until a graph's message iterator is likely to be ready.
+*/
+extern void bt_self_message_iterator_set_wait_fd(
+		bt_self_message_iterator *self_message_iterator, int fd);
+
+/*!
+@brief
+    Makes the \bt_msg_iter \bt_p{self_message_iterator} declare that
+    it's worth calling its
+    \ref api-msg-iter-cls-meth-next "\"next\" method" again in
+    \bt_p{timeout_us}&nbsp;µs.
+
+Call this function from the "next" method of \bt_p{self_message_iterator}
+before it returns #BT_MESSAGE_ITERATOR_CLASS_NEXT_METHOD_STATUS_AGAIN
+so that bt_graph_wait() returns after at most \bt_p{timeout_us}&nbsp;µs.
+
+The declaration only applies until the next bt_graph_run() or
+bt_graph_run_once() call.
+
+@param[in] self_message_iterator
+    Message iterator instance.
+@param[in] timeout_us
+    Duration (µs) after which to try again.
+
+@bt_pre_not_null{self_message_iterator}
+
+@sa bt_graph_wait() &mdash;
+    Waits until a graph's message iterator is likely to be ready.
+*/
+extern void bt_self_message_iterator_set_wait_timeout(
+		bt_self_message_iterator *self_message_iterator,
+		uint64_t timeout_us);
+
+/*! @} */
+
 /*!
 @name Configuration
 @{
@@ -29,6 +29,7 @@
 
 #include <stdint.h>
 
+#include <babeltrace2/trace-ir/field-path.h>
 #include <babeltrace2/types.h>
 
 #ifdef __cplusplus
@@ -956,6 +957,226 @@ extern const bt_value *bt_event_class_borrow_user_attributes_const(
 
 /*! @} */
 
+/*!
+@name Field path resolution
+@{
+*/
+
+/*!
+@brief
+    Status codes for bt_event_class_create_field_path().
+*/
+typedef enum bt_event_class_create_field_path_status {
+	/*!
+	@brief
+	    Success.
+	*/
+	BT_EVENT_CLASS_CREATE_FIELD_PATH_STATUS_OK		= __BT_FUNC_STATUS_OK,
+
+	/*!
+	@brief
+	    No field class matches the requested path.
+	*/
+	BT_EVENT_CLASS_CREATE_FIELD_PATH_STATUS_NOT_FOUND	= __BT_FUNC_STATUS_NOT_FOUND,
+
+	/*!
+	@brief
+	    Out of memory.
+	*/
+	BT_EVENT_CLASS_CREATE_FIELD_PATH_STATUS_MEMORY_ERROR	= __BT_FUNC_STATUS_MEMORY_ERROR,
+} bt_event_class_create_field_path_status;
+
+/*!
+@brief
+    Creates a \bt_field_path which locates, within the root scope
+    \bt_p{root_scope} of the instances of the event class
+    \bt_p{event_class}, the field reached by following the member or
+    option names \bt_p{names}.
+
+Starting from the root \bt_fc of the scope \bt_p{root_scope}, each
+name of \bt_p{names} is the name of a member of a
+\bt_struct_fc or of an option of a \bt_var_fc. This function
+automatically goes through the content of any \bt_opt_fc it meets on
+the way. You cannot go through an \bt_array_fc with this function.
+
+This function performs the name lookups once: you can then pass the
+resulting field path to bt_event_borrow_field_by_path_const() and to
+the typed getters of \ref api-tir-ev "events" to borrow the located
+field of any instance of \bt_p{event_class} without looking up any
+name.
+
+The root scope \bt_p{root_scope} is one of:
+
+- #BT_FIELD_PATH_SCOPE_PACKET_CONTEXT: the packet context field class
+  of the \bt_stream_cls of \bt_p{event_class}.
+- #BT_FIELD_PATH_SCOPE_EVENT_COMMON_CONTEXT: the event common context
+  field class of the stream class of \bt_p{event_class}.
+- #BT_FIELD_PATH_SCOPE_EVENT_SPECIFIC_CONTEXT: the specific context
+  field class of \bt_p{event_class}.
+- #BT_FIELD_PATH_SCOPE_EVENT_PAYLOAD: the payload field class of
+  \bt_p{event_class}.
+
+If \bt_p{name_count} is 0, the resulting field path locates the
+root field itself.
+
+@param[in] event_class
+    Event class of which to resolve the member names.
+@param[in] root_scope
+    Root scope from which to resolve the member names.
+@param[in] names
+    Member or option names, from the outermost to the innermost
+    (\bt_p{name_count} elements).
+@param[in] name_count
+    Number of elements in \bt_p{names}.
+@param[out] field_path
+    <strong>On success</strong>, \bt_p{*field_path} is a new field path
+    reference.
+
+@retval #BT_EVENT_CLASS_CREATE_FIELD_PATH_STATUS_OK
+    Success.
+@retval #BT_EVENT_CLASS_CREATE_FIELD_PATH_STATUS_NOT_FOUND
+    \bt_p{event_class} has no root field class for the scope
+    \bt_p{root_scope}, or one of the names of \bt_p{names} does not
+    name a member or an option.
+@retval #BT_EVENT_CLASS_CREATE_FIELD_PATH_STATUS_MEMORY_ERROR
+    Out of memory.
+
+@bt_pre_not_null{event_class}
+@pre
+    If \bt_p{name_count} is greater than 0, \bt_p{names} is not
+    \c NULL and none of its first \bt_p{name_count} elements is
+    \c NULL.
+@bt_pre_not_null{field_path}
+
+@post
+    <strong>On success</strong>, \bt_p{event_class} and its stream
+    class are frozen: the resulting field path remains valid for all
+    the instances of \bt_p{event_class}.
+
+@sa bt_event_borrow_field_by_path_const() &mdash;
+    Borrows the field of an event located by a field path.
+*/
+extern bt_event_class_create_field_path_status
+bt_event_class_create_field_path(const bt_event_class *event_class,
+		bt_field_path_scope root_scope, const char * const *names,
+		uint64_t name_count, const bt_field_path **field_path);
+
+/*! @} */
+
+/*!
+@name Payload field binary layout
+@{
+*/
+
+/*!
+@brief
+    Byte orders of an event class's payload field binary layout.
+*/
+typedef enum bt_event_class_binary_layout_byte_order {
+	/*!
+	@brief
+	    Little-endian.
+	*/
+	BT_EVENT_CLASS_BINARY_LAYOUT_BYTE_ORDER_LITTLE_ENDIAN,
+
+	/*!
+	@brief
+	    Big-endian.
+	*/
+	BT_EVENT_CLASS_BINARY_LAYOUT_BYTE_ORDER_BIG_ENDIAN,
+} bt_event_class_binary_layout_byte_order;
+
+/*!
+@brief
+    Status codes for bt_event_class_set_payload_field_binary_layout().
+*/
+typedef enum bt_event_class_set_payload_field_binary_layout_status {
+	/*!
+	@brief
+	    Success.
+	*/
+	BT_EVENT_CLASS_SET_PAYLOAD_FIELD_BINARY_LAYOUT_STATUS_OK		= __BT_FUNC_STATUS_OK,
+
+	/*!
+	@brief
+	    Out of memory.
+	*/
+	BT_EVENT_CLASS_SET_PAYLOAD_FIELD_BINARY_LAYOUT_STATUS_MEMORY_ERROR	= __BT_FUNC_STATUS_MEMORY_ERROR,
+} bt_event_class_set_payload_field_binary_layout_status;
+
+/*!
+@brief
+    Sets the binary layout of the payload fields of the instances of
+    the event class \bt_p{event_class}.
+
+A binary layout describes where the value of each leaf field of a
+payload field is within a raw payload of \bt_p{size} bits: a
+message iterator can then attach a raw payload to an event with
+bt_event_set_raw_payload() instead of setting the values of its
+payload field. The library decodes the payload field from this raw
+payload when something borrows the event's payload field for the
+first time, so that a payload field which nothing reads is never
+decoded.
+
+The leaf fields of the payload field, in depth-first order (the
+elements of a \bt_sarray_field in index order), are the
+\bt_int_field, \bt_real_field, and \bt_ba_field of the payload
+field. The value of the leaf field at index \em i is encoded, with
+the byte order \bt_p{byte_order}, within the \em n bits starting at
+bit offset <code>offsets[i]</code> of a raw payload, where \em n is:
+
+- For an integer field: the \ref api-tir-fc-int-prop-size "field value range"
+  of its class.
+- For a single-precision real field: 32.
+- For a double-precision real field: 64.
+- For a bit array field: the length of its class.
+
+Bit offset 0 is the least significant bit of the first byte of a raw
+payload for the little-endian byte order, and its most significant bit
+for the big-endian byte order.
+
+@param[in] event_class
+    Event class of which to set the payload field binary layout.
+@param[in] byte_order
+    Byte order of all the leaf field values.
+@param[in] offsets
+    Bit offsets of the leaf field values within a raw payload
+    (\bt_p{offset_count} elements).
+@param[in] offset_count
+    Number of elements in \bt_p{offsets}, that is, number of leaf
+    fields of a payload field.
+@param[in] size
+    Size of a raw payload (bits).
+
+@retval #BT_EVENT_CLASS_SET_PAYLOAD_FIELD_BINARY_LAYOUT_STATUS_OK
+    Success.
+@retval #BT_EVENT_CLASS_SET_PAYLOAD_FIELD_BINARY_LAYOUT_STATUS_MEMORY_ERROR
+    Out of memory.
+
+@bt_pre_not_null{event_class}
+@bt_pre_hot{event_class}
+@pre
+    \bt_p{event_class} has a payload field class which only contains,
+    recursively, \bt_struct_fc, \bt_sarray_fc, \bt_int_fc,
+    \bt_real_fc, and \bt_ba_fc.
+@pre
+    \bt_p{offset_count} is the number of leaf fields of a payload
+    field of \bt_p{event_class}.
+@bt_pre_not_null{offsets}
+@pre
+    Each leaf field value is entirely within the first \bt_p{size}
+    bits of a raw payload.
+
+@sa bt_event_set_raw_payload() &mdash;
+    Sets the raw payload of an event.
+*/
+extern bt_event_class_set_payload_field_binary_layout_status
+bt_event_class_set_payload_field_binary_layout(bt_event_class *event_class,
+		bt_event_class_binary_layout_byte_order byte_order,
+		const uint64_t *offsets, uint64_t offset_count, uint64_t size);
+
+/*! @} */
+
 /*!
 @name Reference count
 @{
@@ -27,6 +27,8 @@
 # error "Please include <babeltrace2/babeltrace.h> instead."
 #endif
 
+#include <stdint.h>
+
 #include <babeltrace2/types.h>
 
 #ifdef __cplusplus
@@ -372,6 +374,229 @@ extern const bt_field *bt_event_borrow_common_context_field_const(
 
 /*! @} */
 
+/*!
+@name Field access by field path
+@{
+*/
+
+/*!
+@brief
+    Borrows the \bt_field of the event \bt_p{event} which the
+    \bt_field_path \bt_p{field_path} locates.
+
+Create \bt_p{field_path} once with bt_event_class_create_field_path()
+and then use it with any instance of the same \bt_ev_cls: this
+function doesn't look up any member name.
+
+This function returns \c NULL if the located field is not currently
+part of \bt_p{event}, that is, if a \bt_var_field on the path
+currently contains another option or if an \bt_opt_field on the path
+currently has no field. It also returns \c NULL when the root scope of
+\bt_p{field_path} is #BT_FIELD_PATH_SCOPE_PACKET_CONTEXT and
+\bt_p{event} has no packet or its packet has no context field.
+
+@param[in] event
+    Event from which to borrow the field located by \bt_p{field_path}.
+@param[in] field_path
+    Field path which locates the field to borrow.
+
+@returns
+    \em Borrowed reference of the field of \bt_p{event} which
+    \bt_p{field_path} locates, or \c NULL if none.
+
+@bt_pre_not_null{event}
+@bt_pre_not_null{field_path}
+@pre
+    \bt_p{field_path} was created with
+    bt_event_class_create_field_path() from the class of \bt_p{event}.
+
+@sa bt_event_borrow_field_by_path_const() &mdash;
+    \c const version of this function.
+@sa bt_event_class_create_field_path() &mdash;
+    Creates a field path from member names.
+*/
+extern bt_field *bt_event_borrow_field_by_path(bt_event *event,
+		const bt_field_path *field_path);
+
+/*!
+@brief
+    Borrows the \bt_field of the event \bt_p{event} which the
+    \bt_field_path \bt_p{field_path} locates (\c const version).
+
+See bt_event_borrow_field_by_path().
+*/
+extern const bt_field *bt_event_borrow_field_by_path_const(
+		const bt_event *event, const bt_field_path *field_path);
+
+/*!
+@brief
+    Status codes for
+    bt_event_get_unsigned_integer_field_value_by_path() and
+    bt_event_get_signed_integer_field_value_by_path().
+*/
+typedef enum bt_event_get_field_value_by_path_status {
+	/*!
+	@brief
+	    Success.
+	*/
+	BT_EVENT_GET_FIELD_VALUE_BY_PATH_STATUS_OK		= __BT_FUNC_STATUS_OK,
+
+	/*!
+	@brief
+	    The field path doesn't locate any field of the event.
+	*/
+	BT_EVENT_GET_FIELD_VALUE_BY_PATH_STATUS_NOT_FOUND	= __BT_FUNC_STATUS_NOT_FOUND,
+} bt_event_get_field_value_by_path_status;
+
+/*!
+@brief
+    Sets \bt_p{*value} to the value of the \bt_uint_field of the event
+    \bt_p{event} which the \bt_field_path \bt_p{field_path} locates.
+
+This function is equivalent to calling
+bt_event_borrow_field_by_path_const() and then
+bt_field_integer_unsigned_get_value(), but without any intermediate
+function call.
+
+@param[in] event
+    Event from which to get the value of the field located by
+    \bt_p{field_path}.
+@param[in] field_path
+    Field path which locates the field of which to get the value.
+@param[out] value
+    <strong>On success</strong>, \bt_p{*value} is the value of the
+    located field.
+
+@retval #BT_EVENT_GET_FIELD_VALUE_BY_PATH_STATUS_OK
+    Success.
+@retval #BT_EVENT_GET_FIELD_VALUE_BY_PATH_STATUS_NOT_FOUND
+    bt_event_borrow_field_by_path_const() would return \c NULL.
+
+@bt_pre_not_null{event}
+@bt_pre_not_null{field_path}
+@pre
+    \bt_p{field_path} was created with
+    bt_event_class_create_field_path() from the class of \bt_p{event}.
+@pre
+    The field which \bt_p{field_path} locates, if any, is an
+    unsigned integer field.
+@bt_pre_not_null{value}
+
+@sa bt_event_get_signed_integer_field_value_by_path() &mdash;
+    Gets the value of a signed integer field located by a field path.
+*/
+extern bt_event_get_field_value_by_path_status
+bt_event_get_unsigned_integer_field_value_by_path(const bt_event *event,
+		const bt_field_path *field_path, uint64_t *value);
+
+/*!
+@brief
+    Sets \bt_p{*value} to the value of the \bt_sint_field of the event
+    \bt_p{event} which the \bt_field_path \bt_p{field_path} locates.
+
+This function is equivalent to calling
+bt_event_borrow_field_by_path_const() and then
+bt_field_integer_signed_get_value(), but without any intermediate
+function call.
+
+@param[in] event
+    Event from which to get the value of the field located by
+    \bt_p{field_path}.
+@param[in] field_path
+    Field path which locates the field of which to get the value.
+@param[out] value
+    <strong>On success</strong>, \bt_p{*value} is the value of the
+    located field.
+
+@retval #BT_EVENT_GET_FIELD_VALUE_BY_PATH_STATUS_OK
+    Success.
+@retval #BT_EVENT_GET_FIELD_VALUE_BY_PATH_STATUS_NOT_FOUND
+    bt_event_borrow_field_by_path_const() would return \c NULL.
+
+@bt_pre_not_null{event}
+@bt_pre_not_null{field_path}
+@pre
+    \bt_p{field_path} was created with
+    bt_event_class_create_field_path() from the class of \bt_p{event}.
+@pre
+    The field which \bt_p{field_path} locates, if any, is a
+    signed integer field.
+@bt_pre_not_null{value}
+
+@sa bt_event_get_unsigned_integer_field_value_by_path() &mdash;
+    Gets the value of an unsigned integer field located by a field
+    path.
+*/
+extern bt_event_get_field_value_by_path_status
+bt_event_get_signed_integer_field_value_by_path(const bt_event *event,
+		const bt_field_path *field_path, int64_t *value);
+
+/*! @} */
+
+/*!
+@name Raw payload
+@{
+*/
+
+/*!
+@brief
+    Status codes for bt_event_set_raw_payload().
+*/
+typedef enum bt_event_set_raw_payload_status {
+	/*!
+	@brief
+	    Success.
+	*/
+	BT_EVENT_SET_RAW_PAYLOAD_STATUS_OK		= __BT_FUNC_STATUS_OK,
+
+	/*!
+	@brief
+	    Out of memory.
+	*/
+	BT_EVENT_SET_RAW_PAYLOAD_STATUS_MEMORY_ERROR	= __BT_FUNC_STATUS_MEMORY_ERROR,
+} bt_event_set_raw_payload_status;
+
+/*!
+@brief
+    Sets the raw payload of the event \bt_p{event} to the raw payload
+    starting at bit offset \bt_p{offset} of \bt_p{data}, instead of
+    setting the values of its payload \bt_field.
+
+The payload field binary layout of the class of \bt_p{event} (see
+bt_event_class_set_payload_field_binary_layout()) describes the
+raw payload and its size.
+
+This function copies the raw payload: \bt_p{data} does not need to
+remain valid after it returns. The library decodes the payload field
+of \bt_p{event} from this raw payload when something borrows it for
+the first time with bt_event_borrow_payload_field(),
+bt_event_borrow_payload_field_const(), or a field path function.
+
+@param[in] event
+    Event of which to set the raw payload.
+@param[in] data
+    Buffer containing the raw payload.
+@param[in] offset
+    Offset of the raw payload within \bt_p{data} (bits).
+
+@retval #BT_EVENT_SET_RAW_PAYLOAD_STATUS_OK
+    Success.
+@retval #BT_EVENT_SET_RAW_PAYLOAD_STATUS_MEMORY_ERROR
+    Out of memory.
+
+@bt_pre_not_null{event}
+@bt_pre_hot{event}
+@pre
+    The class of \bt_p{event} has a payload field binary layout.
+@bt_pre_not_null{data}
+@pre
+    Nothing borrowed the payload field of \bt_p{event} yet.
+*/
+extern bt_event_set_raw_payload_status bt_event_set_raw_payload(
+		bt_event *event, const void *data, uint64_t offset);
+
+/*! @} */
+
 /*! @} */
 
 #ifdef __cplusplus
@@ -2306,6 +2306,13 @@ This function sets \bt_p{*labels} to the resulting array and
 On success, if there's no mapping ranges containing the value
 \bt_p{value}, \bt_p{*count} is 0.
 
+Once \bt_p{field_class} is part of a \bt_trace_cls (that is, once
+it's, or is contained in, the \bt_fc of a \bt_stream_cls or
+\bt_ev_cls), this function finds the labels with an interval index
+instead of scanning all the mappings, and it doesn't modify
+\bt_p{field_class}: you can call it from multiple threads concurrently,
+and \bt_p{*labels} remains valid as long as \bt_p{field_class} exists.
+
 @param[in] field_class
     Unsigned enumeration field class from which to get the labels of the
     mappings of which the ranges contain \bt_p{value}.
@@ -2568,6 +2575,13 @@ This function sets \bt_p{*labels} to the resulting array and
 On success, if there's no mapping ranges containing the value
 \bt_p{value}, \bt_p{*count} is 0.
 
+Once \bt_p{field_class} is part of a \bt_trace_cls (that is, once
+it's, or is contained in, the \bt_fc of a \bt_stream_cls or
+\bt_ev_cls), this function finds the labels with an interval index
+instead of scanning all the mappings, and it doesn't modify
+\bt_p{field_class}: you can call it from multiple threads concurrently,
+and \bt_p{*labels} remains valid as long as \bt_p{field_class} exists.
+
 @param[in] field_class
     Signed enumeration field class from which to get the labels of the
     mappings of which the ranges contain \bt_p{value}.
@@ -79,9 +79,9 @@ postcondition.
 
 The type of a packet is #bt_packet.
 
-<h1>Property</h1>
+<h1>Properties</h1>
 
-A packet has the following property:
+A packet has the following properties:
 
 <dl>
   <dt>\anchor api-tir-pkt-prop-ctx Context field</dt>
@@ -100,6 +100,20 @@ A packet has the following property:
     Use bt_packet_borrow_context_field() and
     bt_packet_borrow_context_field_const().
   </dd>
+
+  <dt>\anchor api-tir-pkt-prop-raw-data \bt_dt_opt Raw data</dt>
+  <dd>
+    Bytes of the packet as its producer read them, in the
+    \ref api-tir-trace-cls-prop-raw-pkt-fmt "raw packet format" of
+    the \bt_trace_cls of its \bt_stream, and the number of \bt_p_ev
+    which those bytes contain.
+
+    A component which understands this format and which receives all
+    the events of the packet can write those bytes as is instead of
+    encoding the events again.
+
+    Use bt_packet_set_raw_data() and bt_packet_get_raw_data().
+  </dd>
 </dl>
 */
 
@@ -137,7 +151,7 @@ A packet has the following property:
     returns #BT_TRUE.
     @endparblock
 
-On success, the returned packet has the following property value:
+On success, the returned packet has the following property values:
 
 <table>
   <tr>
@@ -149,6 +163,9 @@ On success, the returned packet has the following property value:
       Unset instance of the
       \ref api-tir-stream-cls-prop-pc-fc "packet context field class" of
       the \ref api-tir-stream-cls "class" of \bt_p{stream}.
+  <tr>
+    <td>\ref api-tir-pkt-prop-raw-data "Raw data"
+    <td>\em None
 </table>
 
 @param[in] stream
@@ -202,7 +219,7 @@ extern const bt_stream *bt_packet_borrow_stream_const(
 /*! @} */
 
 /*!
-@name Property
+@name Properties
 @{
 */
 
@@ -238,6 +255,104 @@ extern
 const bt_field *bt_packet_borrow_context_field_const(
 		const bt_packet *packet);
 
+/*!
+@brief
+    Status codes for bt_packet_set_raw_data().
+*/
+typedef enum bt_packet_set_raw_data_status {
+	/*!
+	@brief
+	    Success.
+	*/
+	BT_PACKET_SET_RAW_DATA_STATUS_OK		= __BT_FUNC_STATUS_OK,
+
+	/*!
+	@brief
+	    Out of memory.
+	*/
+	BT_PACKET_SET_RAW_DATA_STATUS_MEMORY_ERROR	= __BT_FUNC_STATUS_MEMORY_ERROR,
+} bt_packet_set_raw_data_status;
+
+/*!
+@brief
+    Sets the raw data of the packet \bt_p{packet} to a copy of the
+    \bt_p{size} bytes of \bt_p{data}, which contain
+    \bt_p{event_count} \bt_p_ev.
+
+See the \ref api-tir-pkt-prop-raw-data "raw data" property.
+
+Unlike the other properties of a packet, you can set its raw data
+after you created a \bt_pb_msg for it: the raw data of a packet is
+typically only complete once its producer reached its end. Set the
+raw data of \bt_p{packet} before you create its \bt_pe_msg: a
+downstream component only reads it when it handles this message.
+
+@param[in] packet
+    Packet of which to set the raw data.
+@param[in] data
+    Raw data of \bt_p{packet} (copied).
+@param[in] size
+    Size of \bt_p{data} (bytes).
+@param[in] event_count
+    Number of events which \bt_p{data} contains.
+
+@retval #BT_PACKET_SET_RAW_DATA_STATUS_OK
+    Success.
+@retval #BT_PACKET_SET_RAW_DATA_STATUS_MEMORY_ERROR
+    Out of memory.
+
+@bt_pre_not_null{packet}
+@pre
+    The \bt_trace_cls of the stream of \bt_p{packet} has a
+    \ref api-tir-trace-cls-prop-raw-pkt-fmt "raw packet format".
+@bt_pre_not_null{data}
+
+@sa bt_packet_get_raw_data() &mdash;
+    Returns the raw data of a packet.
+*/
+extern bt_packet_set_raw_data_status bt_packet_set_raw_data(
+		bt_packet *packet, const void *data, uint64_t size,
+		uint64_t event_count);
+
+/*!
+@brief
+    Returns the raw data of the packet \bt_p{packet}.
+
+See the \ref api-tir-pkt-prop-raw-data "raw data" property.
+
+@param[in] packet
+    Packet of which to get the raw data.
+@param[out] data
+    <strong>If this function returns
+    #BT_PROPERTY_AVAILABILITY_AVAILABLE</strong>, \bt_p{*data} is the
+    raw data of \bt_p{packet}. This pointer remains valid as long as
+    \bt_p{packet} exists.
+@param[out] size
+    <strong>If this function returns
+    #BT_PROPERTY_AVAILABILITY_AVAILABLE</strong>, \bt_p{*size} is the
+    size of \bt_p{*data} (bytes).
+@param[out] event_count
+    <strong>If this function returns
+    #BT_PROPERTY_AVAILABILITY_AVAILABLE</strong>, \bt_p{*event_count}
+    is the number of \bt_p_ev which \bt_p{*data} contains.
+
+@retval #BT_PROPERTY_AVAILABILITY_AVAILABLE
+    The raw data of \bt_p{packet} is available.
+@retval #BT_PROPERTY_AVAILABILITY_NOT_AVAILABLE
+    The raw data of \bt_p{packet} is not available.
+
+@bt_pre_not_null{packet}
+@bt_pre_not_null{data}
+@bt_pre_not_null{size}
+@bt_pre_not_null{event_count}
+
+@sa bt_packet_set_raw_data() &mdash;
+    Sets the raw data of a packet.
+*/
+extern bt_property_availability bt_packet_get_raw_data(
+		const bt_packet *packet, const void **data, uint64_t *size,
+		uint64_t *event_count);
+
 /*! @} */
 
 /*!
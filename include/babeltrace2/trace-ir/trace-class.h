@@ -133,6 +133,28 @@ A trace class has the following properties:
     bt_trace_class_borrow_user_attributes(), and
     bt_trace_class_borrow_user_attributes_const().
   </dd>
+
+  <dt>
+    \anchor api-tir-trace-cls-prop-raw-pkt-fmt
+    \bt_dt_opt Raw packet format
+  </dt>
+  <dd>
+    Name and description of the binary format of the
+    \ref api-tir-pkt-prop-raw-data "raw data" of the \bt_p_pkt of the
+    \bt_p_stream of the trace class.
+
+    The name identifies the format, for example <code>ctf-1.8</code>,
+    and the description is what a component needs, in addition to the
+    name, to interpret raw packet data, for example CTF&nbsp;1.8
+    metadata text. The library does not interpret them.
+
+    A producer only sets this property when it will set the raw data
+    of all the packets it creates for the streams of the trace class.
+
+    Use bt_trace_class_set_raw_packet_format(),
+    bt_trace_class_get_raw_packet_format_name(), and
+    bt_trace_class_get_raw_packet_format_description().
+  </dd>
 </dl>
 */
 
@@ -172,6 +194,9 @@ On success, the returned trace class has the following property values:
   <tr>
     <td>\ref api-tir-trace-cls-prop-user-attrs "User attributes"
     <td>Empty \bt_map_val
+  <tr>
+    <td>\ref api-tir-trace-cls-prop-raw-pkt-fmt "Raw packet format"
+    <td>\em None
 </table>
 
 @param[in] self_component
@@ -421,6 +446,121 @@ See bt_trace_class_borrow_user_attributes().
 extern const bt_value *bt_trace_class_borrow_user_attributes_const(
 		const bt_trace_class *trace_class);
 
+/*!
+@brief
+    Status codes for bt_trace_class_set_raw_packet_format().
+*/
+typedef enum bt_trace_class_set_raw_packet_format_status {
+	/*!
+	@brief
+	    Success.
+	*/
+	BT_TRACE_CLASS_SET_RAW_PACKET_FORMAT_STATUS_OK			= __BT_FUNC_STATUS_OK,
+
+	/*!
+	@brief
+	    Out of memory.
+	*/
+	BT_TRACE_CLASS_SET_RAW_PACKET_FORMAT_STATUS_MEMORY_ERROR	= __BT_FUNC_STATUS_MEMORY_ERROR,
+} bt_trace_class_set_raw_packet_format_status;
+
+/*!
+@brief
+    Sets the raw packet format of the trace class \bt_p{trace_class}
+    to copies of \bt_p{name} and \bt_p{description}.
+
+See the \ref api-tir-trace-cls-prop-raw-pkt-fmt "raw packet format"
+property.
+
+@param[in] trace_class
+    Trace class of which to set the raw packet format.
+@param[in] name
+    Name of the raw packet format (copied).
+@param[in] description
+    Description of the raw packet format (copied).
+
+@retval #BT_TRACE_CLASS_SET_RAW_PACKET_FORMAT_STATUS_OK
+    Success.
+@retval #BT_TRACE_CLASS_SET_RAW_PACKET_FORMAT_STATUS_MEMORY_ERROR
+    Out of memory.
+
+@bt_pre_not_null{trace_class}
+@bt_pre_hot{trace_class}
+@bt_pre_not_null{name}
+@bt_pre_not_null{description}
+
+@sa bt_trace_class_get_raw_packet_format_name() &mdash;
+    Returns the name of the raw packet format of a trace class.
+@sa bt_trace_class_get_raw_packet_format_description() &mdash;
+    Returns the description of the raw packet format of a trace class.
+*/
+extern bt_trace_class_set_raw_packet_format_status
+bt_trace_class_set_raw_packet_format(bt_trace_class *trace_class,
+		const char *name, const char *description);
+
+/*!
+@brief
+    Returns the name of the raw packet format of the trace class
+    \bt_p{trace_class}.
+
+See the \ref api-tir-trace-cls-prop-raw-pkt-fmt "raw packet format"
+property.
+
+If \bt_p{trace_class} has no raw packet format, this function returns
+\c NULL.
+
+@param[in] trace_class
+    Trace class of which to get the name of the raw packet format.
+
+@returns
+    @parblock
+    Name of the raw packet format of \bt_p{trace_class}, or \c NULL
+    if none.
+
+    The returned pointer remains valid as long as \bt_p{trace_class}
+    is not modified.
+    @endparblock
+
+@bt_pre_not_null{trace_class}
+
+@sa bt_trace_class_set_raw_packet_format() &mdash;
+    Sets the raw packet format of a trace class.
+*/
+extern const char *bt_trace_class_get_raw_packet_format_name(
+		const bt_trace_class *trace_class);
+
+/*!
+@brief
+    Returns the description of the raw packet format of the trace class
+    \bt_p{trace_class}.
+
+See the \ref api-tir-trace-cls-prop-raw-pkt-fmt "raw packet format"
+property.
+
+If \bt_p{trace_class} has no raw packet format, this function returns
+\c NULL.
+
+@param[in] trace_class
+    Trace class of which to get the description of the raw packet
+    format.
+
+@returns
+    @parblock
+    Description of the raw packet format of \bt_p{trace_class}, or
+    \c NULL if none.
+
+    The returned pointer remains valid as long as \bt_p{trace_class}
+    is not modified.
+    @endparblock
+
+@bt_pre_not_null{trace_class}
+
+@sa bt_trace_class_set_raw_packet_format() &mdash;
+    Sets the raw packet format of a trace class.
+*/
+extern const char *bt_trace_class_get_raw_packet_format_description(
+		const bt_trace_class *trace_class);
+
 /*! @} */
 
 /*!
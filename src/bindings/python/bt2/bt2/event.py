@@ -25,6 +25,7 @@ from bt2 import event_class as bt2_event_class
 from bt2 import packet as bt2_packet
 from bt2 import stream as bt2_stream
 from bt2 import field as bt2_field
+from bt2 import field_path as bt2_field_path
 
 
 class _EventConst(object._UniqueObject):
@@ -38,6 +39,7 @@ class _EventConst(object._UniqueObject):
         native_bt.event_borrow_specific_context_field_const
     )
     _borrow_payload_field_ptr = staticmethod(native_bt.event_borrow_payload_field_const)
+    _borrow_field_by_path_ptr = staticmethod(native_bt.event_borrow_field_by_path_const)
     _create_field_from_ptr = staticmethod(bt2_field._create_field_from_const_ptr)
 
     _event_class_pycls = property(lambda _: bt2_event_class._EventClassConst)
@@ -106,6 +108,56 @@ class _EventConst(object._UniqueObject):
             field_ptr, self._owner_ptr, self._owner_get_ref, self._owner_put_ref
         )
 
+    # Returns the field located by `field_path` (created with
+    # `create_field_path()` of the class of this event), or `None` if a
+    # variant or option field on the path doesn't currently contain it.
+    def field_by_path(self, field_path):
+        utils._check_type(field_path, bt2_field_path._FieldPathConst)
+        field_ptr = self._borrow_field_by_path_ptr(self._ptr, field_path._ptr)
+
+        if field_ptr is None:
+            return
+
+        return self._create_field_from_ptr(
+            field_ptr, self._owner_ptr, self._owner_get_ref, self._owner_put_ref
+        )
+
+    def _integer_field_value_by_path(self, field_path, field_class_types, get_value):
+        utils._check_type(field_path, bt2_field_path._FieldPathConst)
+        field_ptr = native_bt.event_borrow_field_by_path_const(
+            self._ptr, field_path._ptr
+        )
+
+        if field_ptr is None:
+            return
+
+        field_class_ptr = native_bt.field_borrow_class_const(field_ptr)
+
+        if native_bt.field_class_get_type(field_class_ptr) not in field_class_types:
+            raise TypeError("field path doesn't locate an integer field of this type")
+
+        return get_value(field_ptr)
+
+    def unsigned_integer_field_value_by_path(self, field_path):
+        return self._integer_field_value_by_path(
+            field_path,
+            (
+                native_bt.FIELD_CLASS_TYPE_UNSIGNED_INTEGER,
+                native_bt.FIELD_CLASS_TYPE_UNSIGNED_ENUMERATION,
+            ),
+            native_bt.field_integer_unsigned_get_value,
+        )
+
+    def signed_integer_field_value_by_path(self, field_path):
+        return self._integer_field_value_by_path(
+            field_path,
+            (
+                native_bt.FIELD_CLASS_TYPE_SIGNED_INTEGER,
+                native_bt.FIELD_CLASS_TYPE_SIGNED_ENUMERATION,
+            ),
+            native_bt.field_integer_signed_get_value,
+        )
+
     def __getitem__(self, key):
         utils._check_str(key)
         payload_field = self.payload_field
@@ -142,6 +194,7 @@ class _Event(_EventConst):
         native_bt.event_borrow_specific_context_field
     )
     _borrow_payload_field_ptr = staticmethod(native_bt.event_borrow_payload_field)
+    _borrow_field_by_path_ptr = staticmethod(native_bt.event_borrow_field_by_path)
     _create_field_from_ptr = staticmethod(bt2_field._create_field_from_ptr)
 
     _event_class_pycls = property(lambda _: bt2_event_class._EventClass)
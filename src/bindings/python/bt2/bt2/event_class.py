@@ -22,6 +22,7 @@
 
 from bt2 import native_bt, object, utils
 from bt2 import field_class as bt2_field_class
+from bt2 import field_path as bt2_field_path
 from bt2 import value as bt2_value
 
 
@@ -125,6 +126,30 @@ class _EventClassConst(object._SharedObject):
 
         return self._create_field_class_from_ptr_and_get_ref(fc_ptr)
 
+    # Resolves the member or option names `names` from the root scope
+    # `root_scope` (a `bt2.FieldPathScope` value) once: pass the
+    # returned field path to `field_by_path()` and friends of the
+    # events of this class to find the field without any name lookup.
+    def create_field_path(self, root_scope, names):
+        if root_scope not in bt2_field_path._SCOPE_TO_OBJ:
+            raise ValueError("invalid field path scope: {}".format(root_scope))
+
+        names = list(names)
+
+        for name in names:
+            utils._check_str(name)
+
+        status, ptr = native_bt.bt2_event_class_create_field_path(
+            self._ptr, root_scope, names
+        )
+
+        if status == native_bt.EVENT_CLASS_CREATE_FIELD_PATH_STATUS_NOT_FOUND:
+            raise KeyError(names)
+
+        utils._handle_func_status(status, 'cannot create field path')
+        assert ptr is not None
+        return bt2_field_path._FieldPathConst._create_from_ptr(ptr)
+
 
 class _EventClass(_EventClassConst):
     _borrow_stream_class_ptr = staticmethod(native_bt.event_class_borrow_stream_class)
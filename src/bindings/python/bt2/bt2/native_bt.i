@@ -217,6 +217,7 @@ void bt_bt2_exit_handler(void);
 %include "native_bt_autodisc.i"
 %include "native_bt_clock_class.i"
 %include "native_bt_clock_snapshot.i"
+%include "native_bt_columnar.i"
 %include "native_bt_component.i"
 %include "native_bt_component_class.i"
 %include "native_bt_connection.i"
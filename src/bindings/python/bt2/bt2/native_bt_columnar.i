@@ -0,0 +1,47 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/* Helper functions for Python */
+%{
+#include "native_bt_columnar.i.h"
+%}
+
+enum bt_bt2_columnar_column_kind {
+	BT_BT2_COLUMNAR_COLUMN_KIND_NONE,
+	BT_BT2_COLUMNAR_COLUMN_KIND_UNSIGNED_INTEGER,
+	BT_BT2_COLUMNAR_COLUMN_KIND_SIGNED_INTEGER,
+	BT_BT2_COLUMNAR_COLUMN_KIND_REAL,
+	BT_BT2_COLUMNAR_COLUMN_KIND_STRING,
+};
+
+struct bt_bt2_columnar_exporter;
+
+struct bt_bt2_columnar_exporter *bt_bt2_columnar_exporter_create(
+		PyObject *py_columns, PyObject *py_event_class_names);
+void bt_bt2_columnar_exporter_destroy(
+		struct bt_bt2_columnar_exporter *exporter);
+PyObject *bt_bt2_columnar_exporter_fill(
+		struct bt_bt2_columnar_exporter *exporter,
+		bt_message_iterator *iter, PyObject *py_pending_msgs,
+		uint64_t max_row_count);
+PyObject *bt_bt2_columnar_exporter_take_batch(
+		struct bt_bt2_columnar_exporter *exporter);
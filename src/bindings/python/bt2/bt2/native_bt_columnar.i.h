@@ -0,0 +1,878 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <stdbool.h>
+#include "common/common.h"
+#include "compat/glib.h"
+
+/*
+ * Columnar event exporter.
+ *
+ * An exporter consumes the messages of a message iterator and appends,
+ * for each event message of a selected event class, one row to
+ * contiguous per-column buffers: the event's timestamp, the event
+ * class's name, and the value of each requested field. No Python
+ * object is created per message.
+ */
+
+enum bt_bt2_columnar_column_kind {
+	/* No value seen yet */
+	BT_BT2_COLUMNAR_COLUMN_KIND_NONE,
+	BT_BT2_COLUMNAR_COLUMN_KIND_UNSIGNED_INTEGER,
+	BT_BT2_COLUMNAR_COLUMN_KIND_SIGNED_INTEGER,
+	BT_BT2_COLUMNAR_COLUMN_KIND_REAL,
+
+	/* Values are codes of the exporter's string dictionary */
+	BT_BT2_COLUMNAR_COLUMN_KIND_STRING,
+};
+
+union bt_bt2_columnar_value {
+	uint64_t u;
+	int64_t i;
+	double d;
+};
+
+struct bt_bt2_columnar_column {
+	bt_field_path_scope root_scope;
+
+	/* Array of `char *` (owned) */
+	GPtrArray *names;
+
+	enum bt_bt2_columnar_column_kind kind;
+
+	/* Array of `union bt_bt2_columnar_value`, one per row */
+	GArray *values;
+
+	/* Array of `uint8_t`, one per row: 1 if the value is valid */
+	GArray *validity;
+};
+
+struct bt_bt2_columnar_event_class_entry {
+	/* Owned */
+	const bt_event_class *event_class;
+
+	bool selected;
+
+	/* Dictionary code of the event class's name, or -1 if none */
+	int64_t name_code;
+
+	/*
+	 * Array of `const bt_field_path *` (owned), one per column:
+	 * `NULL` if the event class has no such field.
+	 */
+	GPtrArray *field_paths;
+};
+
+struct bt_bt2_columnar_exporter {
+	/* Array of `struct bt_bt2_columnar_column *` (owned) */
+	GPtrArray *columns;
+
+	/* Names of the selected event classes, or `NULL` for all of them */
+	GHashTable *event_class_names;
+
+	/*
+	 * `const bt_event_class *` (weak) ->
+	 * `struct bt_bt2_columnar_event_class_entry *` (owned)
+	 */
+	GHashTable *event_classes;
+
+	/* `char *` (owned) -> dictionary code + 1 */
+	GHashTable *dict;
+
+	/*
+	 * Strings added to `dict` since the last call to
+	 * bt_bt2_columnar_exporter_take_batch(), in code order (weak:
+	 * owned by `dict`)
+	 */
+	GPtrArray *new_dict_strings;
+
+	uint64_t row_count;
+
+	/* Array of `int64_t`: nanoseconds from origin */
+	GArray *timestamps;
+
+	/* Array of `uint8_t`: 1 if the timestamp is valid */
+	GArray *timestamp_validity;
+
+	/* Array of `int64_t`: dictionary codes of event class names */
+	GArray *event_class_name_codes;
+
+	/*
+	 * Array of `const bt_message *` (owned): messages which the
+	 * exporter got but did not consume because the current batch
+	 * was full, in order
+	 */
+	GPtrArray *pending_msgs;
+
+	/* True if the message iterator ended */
+	bool ended;
+};
+
+static
+void destroy_columnar_column(struct bt_bt2_columnar_column *column)
+{
+	if (!column) {
+		return;
+	}
+
+	if (column->names) {
+		g_ptr_array_free(column->names, TRUE);
+	}
+
+	if (column->values) {
+		g_array_free(column->values, TRUE);
+	}
+
+	if (column->validity) {
+		g_array_free(column->validity, TRUE);
+	}
+
+	g_free(column);
+}
+
+static
+void destroy_columnar_event_class_entry(
+		struct bt_bt2_columnar_event_class_entry *entry)
+{
+	if (!entry) {
+		return;
+	}
+
+	if (entry->field_paths) {
+		guint i;
+
+		for (i = 0; i < entry->field_paths->len; i++) {
+			bt_field_path_put_ref(entry->field_paths->pdata[i]);
+		}
+
+		g_ptr_array_free(entry->field_paths, TRUE);
+	}
+
+	bt_event_class_put_ref(entry->event_class);
+	g_free(entry);
+}
+
+static
+void bt_bt2_columnar_exporter_destroy(
+		struct bt_bt2_columnar_exporter *exporter)
+{
+	if (!exporter) {
+		return;
+	}
+
+	if (exporter->columns) {
+		g_ptr_array_free(exporter->columns, TRUE);
+	}
+
+	if (exporter->event_class_names) {
+		g_hash_table_destroy(exporter->event_class_names);
+	}
+
+	if (exporter->event_classes) {
+		g_hash_table_destroy(exporter->event_classes);
+	}
+
+	if (exporter->new_dict_strings) {
+		g_ptr_array_free(exporter->new_dict_strings, TRUE);
+	}
+
+	if (exporter->dict) {
+		g_hash_table_destroy(exporter->dict);
+	}
+
+	if (exporter->timestamps) {
+		g_array_free(exporter->timestamps, TRUE);
+	}
+
+	if (exporter->timestamp_validity) {
+		g_array_free(exporter->timestamp_validity, TRUE);
+	}
+
+	if (exporter->event_class_name_codes) {
+		g_array_free(exporter->event_class_name_codes, TRUE);
+	}
+
+	if (exporter->pending_msgs) {
+		guint i;
+
+		for (i = 0; i < exporter->pending_msgs->len; i++) {
+			bt_message_put_ref(exporter->pending_msgs->pdata[i]);
+		}
+
+		g_ptr_array_free(exporter->pending_msgs, TRUE);
+	}
+
+	g_free(exporter);
+}
+
+/*
+ * Creates a columnar exporter.
+ *
+ * `py_columns` is a list of `(root scope, list of member names)`
+ * tuples and `py_event_class_names` is either `None` (all the event
+ * classes) or a list of the names of the event classes to export. The
+ * caller checked their types.
+ *
+ * Returns `NULL` on memory error.
+ */
+static
+struct bt_bt2_columnar_exporter *bt_bt2_columnar_exporter_create(
+		PyObject *py_columns, PyObject *py_event_class_names)
+{
+	struct bt_bt2_columnar_exporter *exporter;
+	Py_ssize_t i;
+
+	BT_ASSERT(PyList_Check(py_columns));
+	exporter = g_new0(struct bt_bt2_columnar_exporter, 1);
+	if (!exporter) {
+		goto error;
+	}
+
+	exporter->columns = g_ptr_array_new_with_free_func(
+		(GDestroyNotify) destroy_columnar_column);
+	exporter->event_classes = g_hash_table_new_full(g_direct_hash,
+		g_direct_equal, NULL,
+		(GDestroyNotify) destroy_columnar_event_class_entry);
+	exporter->dict = g_hash_table_new_full(g_str_hash, g_str_equal,
+		g_free, NULL);
+	exporter->new_dict_strings = g_ptr_array_new();
+	exporter->timestamps = g_array_new(FALSE, FALSE, sizeof(int64_t));
+	exporter->timestamp_validity = g_array_new(FALSE, FALSE,
+		sizeof(uint8_t));
+	exporter->event_class_name_codes = g_array_new(FALSE, FALSE,
+		sizeof(int64_t));
+	exporter->pending_msgs = g_ptr_array_new();
+	if (!exporter->columns || !exporter->event_classes ||
+			!exporter->dict || !exporter->new_dict_strings ||
+			!exporter->timestamps ||
+			!exporter->timestamp_validity ||
+			!exporter->event_class_name_codes ||
+			!exporter->pending_msgs) {
+		goto error;
+	}
+
+	for (i = 0; i < PyList_Size(py_columns); i++) {
+		/* Borrowed references */
+		PyObject *py_column = PyList_GetItem(py_columns, i);
+		PyObject *py_names;
+		struct bt_bt2_columnar_column *column;
+		Py_ssize_t j;
+
+		BT_ASSERT(PyTuple_Check(py_column));
+		BT_ASSERT(PyTuple_Size(py_column) == 2);
+		py_names = PyTuple_GetItem(py_column, 1);
+		BT_ASSERT(PyList_Check(py_names));
+		column = g_new0(struct bt_bt2_columnar_column, 1);
+		if (!column) {
+			goto error;
+		}
+
+		g_ptr_array_add(exporter->columns, column);
+		column->root_scope = (bt_field_path_scope) PyLong_AsLong(
+			PyTuple_GetItem(py_column, 0));
+		column->names = g_ptr_array_new_with_free_func(g_free);
+		column->values = g_array_new(FALSE, FALSE,
+			sizeof(union bt_bt2_columnar_value));
+		column->validity = g_array_new(FALSE, FALSE, sizeof(uint8_t));
+		if (!column->names || !column->values || !column->validity) {
+			goto error;
+		}
+
+		for (j = 0; j < PyList_Size(py_names); j++) {
+			const char *name = PyUnicode_AsUTF8(
+				PyList_GetItem(py_names, j));
+
+			if (!name) {
+				PyErr_Clear();
+				goto error;
+			}
+
+			g_ptr_array_add(column->names, g_strdup(name));
+		}
+	}
+
+	if (py_event_class_names != Py_None) {
+		BT_ASSERT(PyList_Check(py_event_class_names));
+		exporter->event_class_names = g_hash_table_new_full(g_str_hash,
+			g_str_equal, g_free, NULL);
+		if (!exporter->event_class_names) {
+			goto error;
+		}
+
+		for (i = 0; i < PyList_Size(py_event_class_names); i++) {
+			const char *name = PyUnicode_AsUTF8(
+				PyList_GetItem(py_event_class_names, i));
+
+			if (!name) {
+				PyErr_Clear();
+				goto error;
+			}
+
+			g_hash_table_insert(exporter->event_class_names,
+				g_strdup(name), GINT_TO_POINTER(1));
+		}
+	}
+
+	goto end;
+
+error:
+	bt_bt2_columnar_exporter_destroy(exporter);
+	exporter = NULL;
+
+end:
+	return exporter;
+}
+
+/*
+ * Returns the dictionary code of `str`, adding it to the dictionary of
+ * `exporter` if needed.
+ */
+static
+int64_t get_columnar_dict_code(struct bt_bt2_columnar_exporter *exporter,
+		const char *str)
+{
+	gpointer code_plus_one = g_hash_table_lookup(exporter->dict, str);
+
+	if (!code_plus_one) {
+		char *key = g_strdup(str);
+
+		code_plus_one = GUINT_TO_POINTER(
+			g_hash_table_size(exporter->dict) + 1);
+		g_hash_table_insert(exporter->dict, key, code_plus_one);
+		g_ptr_array_add(exporter->new_dict_strings, key);
+	}
+
+	return (int64_t) GPOINTER_TO_UINT(code_plus_one) - 1;
+}
+
+/*
+ * Returns the entry of `event_class`, creating it if needed.
+ *
+ * Returns `NULL` with a Python exception set on memory error.
+ */
+static
+struct bt_bt2_columnar_event_class_entry *borrow_columnar_event_class_entry(
+		struct bt_bt2_columnar_exporter *exporter,
+		const bt_event_class *event_class)
+{
+	struct bt_bt2_columnar_event_class_entry *entry;
+	const char *name;
+	guint i;
+
+	entry = g_hash_table_lookup(exporter->event_classes, event_class);
+	if (entry) {
+		goto end;
+	}
+
+	entry = g_new0(struct bt_bt2_columnar_event_class_entry, 1);
+	if (!entry) {
+		goto error;
+	}
+
+	entry->event_class = event_class;
+	bt_event_class_get_ref(event_class);
+	name = bt_event_class_get_name(event_class);
+	entry->selected = !exporter->event_class_names ||
+		(name && bt_g_hash_table_contains(exporter->event_class_names,
+			name));
+	entry->name_code = name ? get_columnar_dict_code(exporter, name) : -1;
+	entry->field_paths = g_ptr_array_new();
+	if (!entry->field_paths) {
+		goto error;
+	}
+
+	for (i = 0; i < exporter->columns->len; i++) {
+		struct bt_bt2_columnar_column *column =
+			exporter->columns->pdata[i];
+		const bt_field_path *field_path = NULL;
+
+		if (entry->selected) {
+			bt_event_class_create_field_path_status status;
+
+			status = bt_event_class_create_field_path(event_class,
+				column->root_scope,
+				(const char * const *) column->names->pdata,
+				column->names->len, &field_path);
+			if (status ==
+					BT_EVENT_CLASS_CREATE_FIELD_PATH_STATUS_MEMORY_ERROR) {
+				goto error;
+			}
+		}
+
+		g_ptr_array_add(entry->field_paths, (gpointer) field_path);
+	}
+
+	g_hash_table_insert(exporter->event_classes, (gpointer) event_class,
+		entry);
+	goto end;
+
+error:
+	PyErr_SetString(py_mod_bt2_exc_memory_error,
+		"cannot create columnar exporter's event class entry");
+	destroy_columnar_event_class_entry(entry);
+	entry = NULL;
+
+end:
+	return entry;
+}
+
+static
+const char *columnar_column_kind_string(
+		enum bt_bt2_columnar_column_kind kind)
+{
+	switch (kind) {
+	case BT_BT2_COLUMNAR_COLUMN_KIND_UNSIGNED_INTEGER:
+		return "unsigned integer";
+	case BT_BT2_COLUMNAR_COLUMN_KIND_SIGNED_INTEGER:
+		return "signed integer";
+	case BT_BT2_COLUMNAR_COLUMN_KIND_REAL:
+		return "real";
+	case BT_BT2_COLUMNAR_COLUMN_KIND_STRING:
+		return "string";
+	default:
+		return "(unknown)";
+	}
+}
+
+/*
+ * Appends the value of `field` (`NULL` if the event has no such field)
+ * to `column`.
+ *
+ * Returns -1 with a Python exception set if the field's type is not
+ * supported or does not match the column's kind.
+ */
+static
+int append_columnar_field_value(struct bt_bt2_columnar_exporter *exporter,
+		struct bt_bt2_columnar_column *column, const bt_field *field)
+{
+	enum bt_bt2_columnar_column_kind kind;
+	union bt_bt2_columnar_value value;
+	uint8_t valid = 1;
+	bt_field_class_type type;
+
+	value.u = 0;
+
+	/* Unwrap option and variant fields */
+	while (field) {
+		type = bt_field_get_class_type(field);
+
+		if (bt_field_class_type_is(type, BT_FIELD_CLASS_TYPE_OPTION)) {
+			field = bt_field_option_borrow_field_const(field);
+		} else if (bt_field_class_type_is(type,
+				BT_FIELD_CLASS_TYPE_VARIANT)) {
+			field = bt_field_variant_borrow_selected_option_field_const(
+				field);
+		} else {
+			break;
+		}
+	}
+
+	if (!field) {
+		kind = column->kind;
+		valid = 0;
+	} else if (bt_field_class_type_is(type,
+			BT_FIELD_CLASS_TYPE_UNSIGNED_INTEGER)) {
+		kind = BT_BT2_COLUMNAR_COLUMN_KIND_UNSIGNED_INTEGER;
+		value.u = bt_field_integer_unsigned_get_value(field);
+	} else if (bt_field_class_type_is(type,
+			BT_FIELD_CLASS_TYPE_SIGNED_INTEGER)) {
+		kind = BT_BT2_COLUMNAR_COLUMN_KIND_SIGNED_INTEGER;
+		value.i = bt_field_integer_signed_get_value(field);
+	} else if (type == BT_FIELD_CLASS_TYPE_BOOL) {
+		kind = BT_BT2_COLUMNAR_COLUMN_KIND_UNSIGNED_INTEGER;
+		value.u = (uint64_t) bt_field_bool_get_value(field);
+	} else if (type == BT_FIELD_CLASS_TYPE_BIT_ARRAY) {
+		kind = BT_BT2_COLUMNAR_COLUMN_KIND_UNSIGNED_INTEGER;
+		value.u = bt_field_bit_array_get_value_as_integer(field);
+	} else if (type == BT_FIELD_CLASS_TYPE_SINGLE_PRECISION_REAL) {
+		kind = BT_BT2_COLUMNAR_COLUMN_KIND_REAL;
+		value.d = (double) bt_field_real_single_precision_get_value(
+			field);
+	} else if (type == BT_FIELD_CLASS_TYPE_DOUBLE_PRECISION_REAL) {
+		kind = BT_BT2_COLUMNAR_COLUMN_KIND_REAL;
+		value.d = bt_field_real_double_precision_get_value(field);
+	} else if (type == BT_FIELD_CLASS_TYPE_STRING) {
+		kind = BT_BT2_COLUMNAR_COLUMN_KIND_STRING;
+		value.i = get_columnar_dict_code(exporter,
+			bt_field_string_get_value(field));
+	} else {
+		PyErr_Format(PyExc_TypeError,
+			"unsupported field type for a column (not a scalar field): "
+			"field-class-type=%s",
+			bt_common_field_class_type_string(type));
+		goto error;
+	}
+
+	if (column->kind == BT_BT2_COLUMNAR_COLUMN_KIND_NONE) {
+		column->kind = kind;
+	} else if (kind != column->kind) {
+		PyErr_Format(PyExc_TypeError,
+			"field type does not match the column's type: "
+			"field-type=%s, column-type=%s",
+			columnar_column_kind_string(kind),
+			columnar_column_kind_string(column->kind));
+		goto error;
+	}
+
+	g_array_append_val(column->values, value);
+	g_array_append_val(column->validity, valid);
+	return 0;
+
+error:
+	return -1;
+}
+
+static
+void reset_columnar_batch(struct bt_bt2_columnar_exporter *exporter)
+{
+	guint i;
+
+	exporter->row_count = 0;
+	g_array_set_size(exporter->timestamps, 0);
+	g_array_set_size(exporter->timestamp_validity, 0);
+	g_array_set_size(exporter->event_class_name_codes, 0);
+
+	for (i = 0; i < exporter->columns->len; i++) {
+		struct bt_bt2_columnar_column *column =
+			exporter->columns->pdata[i];
+
+		g_array_set_size(column->values, 0);
+		g_array_set_size(column->validity, 0);
+	}
+}
+
+/*
+ * Appends a row for `msg` if it's an event message of a selected event
+ * class.
+ *
+ * Returns -1 with a Python exception set on error.
+ */
+static
+int append_columnar_row(struct bt_bt2_columnar_exporter *exporter,
+		const bt_message *msg)
+{
+	const bt_event *event;
+	struct bt_bt2_columnar_event_class_entry *entry;
+	int64_t timestamp = 0;
+	uint8_t timestamp_valid = 0;
+	guint i;
+	int ret = 0;
+
+	if (bt_message_get_type(msg) != BT_MESSAGE_TYPE_EVENT) {
+		goto end;
+	}
+
+	event = bt_message_event_borrow_event_const(msg);
+	entry = borrow_columnar_event_class_entry(exporter,
+		bt_event_borrow_class_const(event));
+	if (!entry) {
+		ret = -1;
+		goto end;
+	}
+
+	if (!entry->selected) {
+		goto end;
+	}
+
+	if (bt_message_event_borrow_stream_class_default_clock_class_const(
+			msg)) {
+		const bt_clock_snapshot *cs =
+			bt_message_event_borrow_default_clock_snapshot_const(
+				msg);
+
+		timestamp_valid = bt_clock_snapshot_get_ns_from_origin(cs,
+			&timestamp) ==
+				BT_CLOCK_SNAPSHOT_GET_NS_FROM_ORIGIN_STATUS_OK;
+	}
+
+	for (i = 0; i < exporter->columns->len; i++) {
+		const bt_field_path *field_path = entry->field_paths->pdata[i];
+		const bt_field *field = NULL;
+
+		if (field_path) {
+			field = bt_event_borrow_field_by_path_const(event,
+				field_path);
+		}
+
+		ret = append_columnar_field_value(exporter,
+			exporter->columns->pdata[i], field);
+		if (ret) {
+			goto end;
+		}
+	}
+
+	g_array_append_val(exporter->timestamps, timestamp);
+	g_array_append_val(exporter->timestamp_validity, timestamp_valid);
+	g_array_append_val(exporter->event_class_name_codes,
+		entry->name_code);
+	exporter->row_count++;
+
+end:
+	return ret;
+}
+
+/*
+ * Appends a row for `msg` to the current batch of `exporter`, putting
+ * its reference, or, if the current batch already contains
+ * `max_row_count` rows, moves `msg` to the pending messages of
+ * `exporter` for the next batch.
+ *
+ * After an error (`*ret` is not 0), only puts the reference of `msg`.
+ */
+static
+void append_or_keep_columnar_message(
+		struct bt_bt2_columnar_exporter *exporter,
+		const bt_message *msg, uint64_t max_row_count, int *ret)
+{
+	if (*ret) {
+		bt_message_put_ref(msg);
+	} else if (exporter->row_count >= max_row_count) {
+		g_ptr_array_add(exporter->pending_msgs, (gpointer) msg);
+	} else {
+		*ret = append_columnar_row(exporter, msg);
+		bt_message_put_ref(msg);
+	}
+}
+
+/*
+ * Appends the messages of the message array `msgs` to the current
+ * batch of `exporter`, keeping the ones which don't fit for the next
+ * batch.
+ */
+static
+int append_columnar_messages(struct bt_bt2_columnar_exporter *exporter,
+		const bt_message **msgs, uint64_t count,
+		uint64_t max_row_count)
+{
+	uint64_t i;
+	int ret = 0;
+
+	for (i = 0; i < count; i++) {
+		append_or_keep_columnar_message(exporter, msgs[i],
+			max_row_count, &ret);
+	}
+
+	return ret;
+}
+
+/*
+ * Appends the pending messages of `exporter` to its current batch
+ * until it contains `max_row_count` rows, keeping the other ones
+ * pending.
+ */
+static
+int append_columnar_pending_messages(
+		struct bt_bt2_columnar_exporter *exporter,
+		uint64_t max_row_count)
+{
+	guint i;
+	int ret = 0;
+
+	for (i = 0; i < exporter->pending_msgs->len; i++) {
+		const bt_message *msg = exporter->pending_msgs->pdata[i];
+
+		if (ret == 0 && exporter->row_count >= max_row_count) {
+			break;
+		}
+
+		if (ret == 0) {
+			ret = append_columnar_row(exporter, msg);
+		}
+
+		bt_message_put_ref(msg);
+	}
+
+	g_ptr_array_remove_range(exporter->pending_msgs, 0, i);
+	return ret;
+}
+
+/*
+ * Consumes messages until the current batch of `exporter` contains
+ * `max_row_count` rows or `iter` ends.
+ *
+ * The exporter first consumes its own pending messages, then the ones
+ * of `py_pending_msgs`, a list of message pointer objects which the
+ * caller already got from `iter` but did not consume yet (the exporter
+ * steals their references), and then the ones of `iter`. It keeps the
+ * messages which don't fit in the current batch for the next one.
+ *
+ * Returns the status of the last bt_message_iterator_next() call as a
+ * Python integer, except that the status is
+ * `__BT_FUNC_STATUS_OK` if the batch contains at least one row.
+ * Returns `NULL` with a Python exception set if a field's type is not
+ * supported or on memory error.
+ */
+static
+PyObject *bt_bt2_columnar_exporter_fill(
+		struct bt_bt2_columnar_exporter *exporter,
+		bt_message_iterator *iter, PyObject *py_pending_msgs,
+		uint64_t max_row_count)
+{
+	bt_message_iterator_next_status status =
+		BT_MESSAGE_ITERATOR_NEXT_STATUS_OK;
+	Py_ssize_t i;
+	int ret = 0;
+
+	BT_ASSERT(PyList_Check(py_pending_msgs));
+	reset_columnar_batch(exporter);
+	ret = append_columnar_pending_messages(exporter, max_row_count);
+
+	for (i = 0; i < PyList_Size(py_pending_msgs); i++) {
+		void *msg = NULL;
+		int res = SWIG_ConvertPtr(PyList_GetItem(py_pending_msgs, i),
+			&msg, SWIGTYPE_p_bt_message, 0);
+
+		BT_ASSERT(SWIG_IsOK(res));
+		append_or_keep_columnar_message(exporter, msg, max_row_count,
+			&ret);
+	}
+
+	if (ret) {
+		goto error;
+	}
+
+	while (!exporter->ended && exporter->row_count < max_row_count) {
+		bt_message_array_const msgs;
+		uint64_t count;
+
+		status = bt_message_iterator_next(iter, &msgs, &count);
+		if (status == BT_MESSAGE_ITERATOR_NEXT_STATUS_END) {
+			exporter->ended = true;
+			break;
+		} else if (status != BT_MESSAGE_ITERATOR_NEXT_STATUS_OK) {
+			break;
+		}
+
+		ret = append_columnar_messages(exporter, msgs, count,
+			max_row_count);
+		if (ret) {
+			goto error;
+		}
+	}
+
+	if (exporter->ended) {
+		status = BT_MESSAGE_ITERATOR_NEXT_STATUS_END;
+	}
+
+	if (exporter->row_count > 0 &&
+			(status == BT_MESSAGE_ITERATOR_NEXT_STATUS_END ||
+			status == BT_MESSAGE_ITERATOR_NEXT_STATUS_AGAIN)) {
+		status = BT_MESSAGE_ITERATOR_NEXT_STATUS_OK;
+	}
+
+	return SWIG_From_long_SS_long(status);
+
+error:
+	reset_columnar_batch(exporter);
+	return NULL;
+}
+
+static
+PyObject *create_pybytearray_from_garray(GArray *array)
+{
+	return PyByteArray_FromStringAndSize(array->data,
+		(Py_ssize_t) (array->len * g_array_get_element_size(array)));
+}
+
+/*
+ * Returns the current batch of `exporter` as the tuple
+ *
+ *     (row count, timestamps, timestamp validity,
+ *      event class name codes, columns, new dictionary strings)
+ *
+ * where each buffer is a `bytearray` and `columns` is a list of
+ * `(kind, values, validity)` tuples, one per column. New dictionary
+ * strings are the strings which the dictionary got since the last call,
+ * in code order.
+ *
+ * Returns `NULL` with a Python exception set on memory error.
+ */
+static
+PyObject *bt_bt2_columnar_exporter_take_batch(
+		struct bt_bt2_columnar_exporter *exporter)
+{
+	PyObject *py_batch = NULL;
+	PyObject *py_columns = NULL;
+	PyObject *py_new_strings = NULL;
+	guint i;
+
+	py_columns = PyList_New(exporter->columns->len);
+	if (!py_columns) {
+		goto error;
+	}
+
+	for (i = 0; i < exporter->columns->len; i++) {
+		struct bt_bt2_columnar_column *column =
+			exporter->columns->pdata[i];
+		PyObject *py_column = Py_BuildValue("(iNN)",
+			(int) column->kind,
+			create_pybytearray_from_garray(column->values),
+			create_pybytearray_from_garray(column->validity));
+
+		if (!py_column) {
+			goto error;
+		}
+
+		PyList_SET_ITEM(py_columns, i, py_column);
+	}
+
+	py_new_strings = PyList_New(exporter->new_dict_strings->len);
+	if (!py_new_strings) {
+		goto error;
+	}
+
+	for (i = 0; i < exporter->new_dict_strings->len; i++) {
+		PyObject *py_str = PyUnicode_FromString(
+			exporter->new_dict_strings->pdata[i]);
+
+		if (!py_str) {
+			goto error;
+		}
+
+		PyList_SET_ITEM(py_new_strings, i, py_str);
+	}
+
+	/* Py_BuildValue() steals the `N` references, even on error */
+	py_batch = Py_BuildValue("(KNNNNN)",
+		(unsigned long long) exporter->row_count,
+		create_pybytearray_from_garray(exporter->timestamps),
+		create_pybytearray_from_garray(exporter->timestamp_validity),
+		create_pybytearray_from_garray(
+			exporter->event_class_name_codes),
+		py_columns, py_new_strings);
+	py_columns = NULL;
+	py_new_strings = NULL;
+	if (!py_batch) {
+		goto error;
+	}
+
+	g_ptr_array_set_size(exporter->new_dict_strings, 0);
+	reset_columnar_batch(exporter);
+	goto end;
+
+error:
+	Py_XDECREF(py_columns);
+	Py_XDECREF(py_new_strings);
+
+end:
+	return py_batch;
+}
@@ -36,4 +36,34 @@
 	$result = SWIG_Python_AppendOutput($result, SWIG_From_int(*$1));
 }
 
+/* Output argument typemap for field path output (always appends) */
+%typemap(in, numinputs=0)
+	(const bt_field_path **)
+	(bt_field_path *temp_field_path = NULL) {
+	$1 = &temp_field_path;
+}
+
+%typemap(argout)
+	(const bt_field_path **) {
+	if (*$1) {
+		/* SWIG_Python_AppendOutput() steals the created object */
+		$result = SWIG_Python_AppendOutput($result,
+				SWIG_NewPointerObj(SWIG_as_voidptr(*$1),
+					SWIGTYPE_p_bt_field_path, 0));
+	} else {
+		/* SWIG_Python_AppendOutput() steals Py_None */
+		Py_INCREF(Py_None);
+		$result = SWIG_Python_AppendOutput($result, Py_None);
+	}
+}
+
 %include <babeltrace2/trace-ir/event-class.h>
+
+/* Helper functions for Python */
+%{
+#include "native_bt_event_class.i.h"
+%}
+
+bt_event_class_create_field_path_status bt_bt2_event_class_create_field_path(
+		const bt_event_class *event_class, bt_field_path_scope root_scope,
+		PyObject *py_names, const bt_field_path **field_path);
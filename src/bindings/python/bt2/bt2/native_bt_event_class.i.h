@@ -0,0 +1,65 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+static
+bt_event_class_create_field_path_status bt_bt2_event_class_create_field_path(
+		const bt_event_class *event_class, bt_field_path_scope root_scope,
+		PyObject *py_names, const bt_field_path **field_path)
+{
+	bt_event_class_create_field_path_status status;
+	const char **names = NULL;
+	Py_ssize_t name_count;
+	Py_ssize_t i;
+
+	BT_ASSERT(event_class);
+	BT_ASSERT(py_names);
+	BT_ASSERT(PyList_Check(py_names));
+	name_count = PyList_Size(py_names);
+
+	if (name_count > 0) {
+		names = g_new(const char *, name_count);
+		if (!names) {
+			status = BT_EVENT_CLASS_CREATE_FIELD_PATH_STATUS_MEMORY_ERROR;
+			goto end;
+		}
+	}
+
+	for (i = 0; i < name_count; i++) {
+		/* Borrowed reference; the caller checked that it's a `str` */
+		PyObject *py_name = PyList_GetItem(py_names, i);
+
+		BT_ASSERT(py_name);
+		names[i] = PyUnicode_AsUTF8(py_name);
+		if (!names[i]) {
+			PyErr_Clear();
+			status = BT_EVENT_CLASS_CREATE_FIELD_PATH_STATUS_MEMORY_ERROR;
+			goto end;
+		}
+	}
+
+	status = bt_event_class_create_field_path(event_class, root_scope,
+		names, (uint64_t) name_count, field_path);
+
+end:
+	g_free(names);
+	return status;
+}
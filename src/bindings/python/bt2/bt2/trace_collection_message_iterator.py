@@ -28,8 +28,10 @@ from bt2 import port as bt2_port
 from bt2 import component as bt2_component
 from bt2 import value as bt2_value
 from bt2 import plugin as bt2_plugin
+from bt2 import field_path as bt2_field_path
 import datetime
 from collections import namedtuple
+import collections.abc
 import numbers
 
 
@@ -268,10 +270,216 @@ class _TraceCollectionMessageIteratorProxySink(bt2_component._UserSinkComponent)
         self._msg_iter = self._create_message_iterator(self._input_ports['in'])
 
     def _user_consume(self):
+        # A columnar exporter in the message list requests a batch
+        # instead of a single message.
+        if type(self._msg_list[0]) is _ColumnarExporter:
+            self._msg_list[0]._fill(self._msg_iter)
+            return
+
         assert self._msg_list[0] is None
         self._msg_list[0] = next(self._msg_iter)
 
 
+_COLUMNAR_COLUMN_KIND_TO_FORMAT = {
+    native_bt.BT2_COLUMNAR_COLUMN_KIND_NONE: 'q',
+    native_bt.BT2_COLUMNAR_COLUMN_KIND_UNSIGNED_INTEGER: 'Q',
+    native_bt.BT2_COLUMNAR_COLUMN_KIND_SIGNED_INTEGER: 'q',
+    native_bt.BT2_COLUMNAR_COLUMN_KIND_REAL: 'd',
+    native_bt.BT2_COLUMNAR_COLUMN_KIND_STRING: 'q',
+}
+
+
+class _ColumnarColumn:
+    def __init__(self, kind, values, validity, dictionary):
+        self._kind = kind
+        self._values = values
+        self._validity = validity
+        self._dictionary = dictionary
+
+    # Values, one per event, as a memoryview of unsigned 64-bit
+    # integers (format `Q`), signed 64-bit integers (format `q`), or
+    # doubles (format `d`).
+    #
+    # If the column is dictionary-encoded, each value is an index of
+    # `dictionary`, or -1 if there's no string.
+    @property
+    def values(self):
+        return memoryview(self._values).cast(
+            _COLUMNAR_COLUMN_KIND_TO_FORMAT[self._kind]
+        )
+
+    # Validity, one byte per event: 0 if the event has no such field
+    # (the corresponding value is 0).
+    @property
+    def validity(self):
+        return memoryview(self._validity)
+
+    @property
+    def is_dictionary_encoded(self):
+        return self._kind == native_bt.BT2_COLUMNAR_COLUMN_KIND_STRING
+
+    @property
+    def dictionary(self):
+        return self._dictionary
+
+    def __len__(self):
+        return len(self._validity)
+
+
+class _ColumnarBatch(collections.abc.Mapping):
+    def __init__(self, event_count, timestamps, event_class_names, columns):
+        self._event_count = event_count
+        self._timestamps = timestamps
+        self._event_class_names = event_class_names
+        self._columns = columns
+
+    @property
+    def event_count(self):
+        return self._event_count
+
+    # Default clock snapshots of the events, in nanoseconds from origin
+    # (signed 64-bit integers), with their validity.
+    @property
+    def timestamps(self):
+        return self._timestamps
+
+    # Names of the event classes of the events (dictionary-encoded).
+    @property
+    def event_class_names(self):
+        return self._event_class_names
+
+    def __getitem__(self, key):
+        return self._columns[key]
+
+    def __len__(self):
+        return len(self._columns)
+
+    def __iter__(self):
+        return iter(self._columns)
+
+
+def _get_columnar_column_path(path):
+    if type(path) is str:
+        return bt2_field_path.FieldPathScope.EVENT_PAYLOAD, [path]
+
+    path = list(path)
+
+    if len(path) > 0 and type(path[0]) is not str:
+        root_scope = path.pop(0)
+
+        if root_scope not in bt2_field_path._SCOPE_TO_OBJ:
+            raise ValueError("invalid field path scope: {}".format(root_scope))
+    else:
+        root_scope = bt2_field_path.FieldPathScope.EVENT_PAYLOAD
+
+    for name in path:
+        utils._check_str(name)
+
+    return root_scope, path
+
+
+# Fills contiguous per-column buffers with the events of a message
+# iterator, without creating any Python object per event.
+#
+# The string dictionary, shared by all the dictionary-encoded columns,
+# only grows: a given string has the same code in all the batches of an
+# exporter.
+class _ColumnarExporter:
+    def __init__(self, columns, event_class_names, max_event_count):
+        self._ptr = None
+
+        if not isinstance(columns, collections.abc.Mapping):
+            raise TypeError(
+                "'{}' is not a 'collections.abc.Mapping' object".format(
+                    columns.__class__.__name__
+                )
+            )
+
+        self._column_names = []
+        native_columns = []
+
+        for name, path in columns.items():
+            utils._check_str(name)
+            self._column_names.append(name)
+            native_columns.append(_get_columnar_column_path(path))
+
+        if event_class_names is not None:
+            if type(event_class_names) is str:
+                event_class_names = [event_class_names]
+
+            event_class_names = list(event_class_names)
+
+            for name in event_class_names:
+                utils._check_str(name)
+
+        utils._check_uint64(max_event_count)
+
+        if max_event_count == 0:
+            raise ValueError('maximum event count must be greater than 0')
+
+        self._max_event_count = max_event_count
+        self._dictionary = []
+        ptr = native_bt.bt2_columnar_exporter_create(
+            native_columns, event_class_names
+        )
+
+        if ptr is None:
+            raise bt2._MemoryError('cannot create columnar exporter')
+
+        self._ptr = ptr
+
+    def __del__(self):
+        if self._ptr is not None:
+            native_bt.bt2_columnar_exporter_destroy(self._ptr)
+
+    # Called by the proxy sink to fill the current batch from
+    # `msg_iter`.
+    def _fill(self, msg_iter):
+        # Hand over the messages which the message iterator already
+        # got but did not return yet: the exporter consumes them first.
+        pending_msgs = msg_iter._current_msgs[msg_iter._at :]
+        msg_iter._current_msgs = []
+        msg_iter._at = 0
+        status = native_bt.bt2_columnar_exporter_fill(
+            self._ptr, msg_iter._ptr, pending_msgs, self._max_event_count
+        )
+        utils._handle_func_status(
+            status, 'unexpected error: cannot advance the message iterator'
+        )
+
+    def _take_batch(self):
+        (
+            event_count,
+            timestamps,
+            timestamp_validity,
+            event_class_name_codes,
+            native_columns,
+            new_strings,
+        ) = native_bt.bt2_columnar_exporter_take_batch(self._ptr)
+        self._dictionary.extend(new_strings)
+        columns = {}
+
+        for name, (kind, values, validity) in zip(self._column_names, native_columns):
+            columns[name] = _ColumnarColumn(kind, values, validity, self._dictionary)
+
+        return _ColumnarBatch(
+            event_count,
+            _ColumnarColumn(
+                native_bt.BT2_COLUMNAR_COLUMN_KIND_SIGNED_INTEGER,
+                timestamps,
+                timestamp_validity,
+                self._dictionary,
+            ),
+            _ColumnarColumn(
+                native_bt.BT2_COLUMNAR_COLUMN_KIND_STRING,
+                event_class_name_codes,
+                bytearray(b'\x01') * event_count,
+                self._dictionary,
+            ),
+            columns,
+        )
+
+
 class TraceCollectionMessageIterator(bt2_message_iterator._MessageIterator):
     def __init__(
         self,
@@ -402,6 +610,36 @@ class TraceCollectionMessageIterator(bt2_message_iterator._MessageIterator):
         self._msg_list[0] = None
         return msg
 
+    # Returns an iterator of `_ColumnarBatch` objects which contain the
+    # remaining events of this iterator, at most `max_event_count`
+    # events per batch.
+    #
+    # `columns` maps column names to field paths. A field path is
+    # either a payload member name, or a sequence of member names,
+    # optionally preceded with a `bt2.FieldPathScope` value (payload by
+    # default).
+    #
+    # If `event_class_names` is not `None`, only the events of the event
+    # classes having those names are exported. The other messages are
+    # skipped.
+    def columnar_batches(self, columns, event_class_names=None, max_event_count=4096):
+        exporter = _ColumnarExporter(columns, event_class_names, max_event_count)
+        return self._iter_columnar_batches(exporter)
+
+    def _iter_columnar_batches(self, exporter):
+        while True:
+            assert self._msg_list[0] is None
+            self._msg_list[0] = exporter
+
+            try:
+                self._graph.run_once()
+            except bt2.Stop:
+                return
+            finally:
+                self._msg_list[0] = None
+
+            yield exporter._take_batch()
+
     def _create_stream_intersection_trimmer(self, component, port):
         key = (component.addr, port.name)
         begin, end = self._stream_inter_port_to_range[key]
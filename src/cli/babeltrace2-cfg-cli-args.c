@@ -35,6 +35,7 @@
 #include <babeltrace2/babeltrace.h>
 #include "common/common.h"
 #include <glib.h>
+#include <glib/gstdio.h>
 #include <sys/types.h>
 #include "argpar/argpar.h"
 #include "babeltrace2-cfg.h"
@@ -46,6 +47,8 @@
 #include "babeltrace2-query.h"
 #include "autodisc/autodisc.h"
 #include "common/version.h"
+#include "compat/glib.h"
+#include "compat/stdlib.h"
 
 #define BT_CLI_LOGE_APPEND_CAUSE_OOM() BT_CLI_LOGE_APPEND_CAUSE("Out of memory.")
 
@@ -450,6 +453,21 @@ void bt_config_destroy(bt_object *obj)
 			g_ptr_array_free(cfg->cmd_data.run.connections,
 				TRUE);
 		}
+
+		if (cfg->cmd_data.run.jobs) {
+			/* Also removes the temporary text output files */
+			g_ptr_array_free(cfg->cmd_data.run.jobs, TRUE);
+		}
+
+		if (cfg->cmd_data.run.text_output_path) {
+			g_string_free(cfg->cmd_data.run.text_output_path,
+				TRUE);
+		}
+
+		if (cfg->cmd_data.run.tmp_dir) {
+			(void) g_rmdir(cfg->cmd_data.run.tmp_dir->str);
+			g_string_free(cfg->cmd_data.run.tmp_dir, TRUE);
+		}
 		break;
 	case BT_CONFIG_COMMAND_LIST_PLUGINS:
 		break;
@@ -868,6 +886,7 @@ enum {
 	OPT_FIELDS,
 	OPT_HELP,
 	OPT_INPUT_FORMAT,
+	OPT_JOBS,
 	OPT_LIST,
 	OPT_LOG_LEVEL,
 	OPT_NAMES,
@@ -882,7 +901,9 @@ enum {
 	OPT_RETRY_DURATION,
 	OPT_RUN_ARGS,
 	OPT_RUN_ARGS_0,
+	OPT_STATS,
 	OPT_STREAM_INTERSECTION,
+	OPT_TIME_SLICES,
 	OPT_TIMERANGE,
 	OPT_VERBOSE,
 	OPT_VERSION,
@@ -1756,6 +1777,9 @@ void print_run_usage(FILE *fp)
 	fprintf(fp, "      --retry-duration=DUR          When babeltrace2(1) needs to retry to run\n");
 	fprintf(fp, "                                    the graph later, retry in DUR µs\n");
 	fprintf(fp, "                                    (default: 100000)\n");
+	fprintf(fp, "      --stats                       Print the statistics of each component\n");
+	fprintf(fp, "                                    to the standard error stream after\n");
+	fprintf(fp, "                                    running the graph\n");
 	fprintf(fp, "  -h, --help                        Show this help and quit\n");
 	fprintf(fp, "\n");
 	fprintf(fp, "See `babeltrace2 --help` for the list of general options.\n");
@@ -1830,6 +1854,7 @@ struct bt_config *bt_config_run_from_args(int argc, const char *argv[],
 		{ OPT_PARAMS, 'p', "params", true },
 		{ OPT_RESET_BASE_PARAMS, 'r', "reset-base-params", false },
 		{ OPT_RETRY_DURATION, '\0', "retry-duration", true },
+		{ OPT_STATS, '\0', "stats", false },
 		ARGPAR_OPT_DESCR_SENTINEL
 	};
 
@@ -2045,6 +2070,9 @@ struct bt_config *bt_config_run_from_args(int argc, const char *argv[],
 				(uint64_t) retry_duration;
 			break;
 		}
+		case OPT_STATS:
+			cfg->cmd_data.run.print_stats = true;
+			break;
 		default:
 			BT_CLI_LOGE_APPEND_CAUSE("Unknown command-line option specified (option code %d).",
 				argpar_item_opt->descr->id);
@@ -2142,6 +2170,11 @@ void print_convert_usage(FILE *fp)
 	fprintf(fp, "                                    in the plugin PLUGIN, add it to the\n");
 	fprintf(fp, "                                    conversion graph, and optionally name it\n");
 	fprintf(fp, "                                    NAME\n");
+	fprintf(fp, "  -j, --jobs=N                      Convert each non-option argument within\n");
+	fprintf(fp, "                                    its own graph, running at most N graphs\n");
+	fprintf(fp, "                                    concurrently (`ctf` and `dummy` output\n");
+	fprintf(fp, "                                    formats only); with --time-slices, run\n");
+	fprintf(fp, "                                    at most N time slices concurrently\n");
 	fprintf(fp, "  -l, --log-level=LVL               Set the log level of the current component to LVL\n");
 	fprintf(fp, "                                    (`N`, `T`, `D`, `I`, `W`, `E`, or `F`)\n");
 	fprintf(fp, "  -p, --params=PARAMS               Add initialization parameters PARAMS to the\n");
@@ -2157,8 +2190,16 @@ void print_convert_usage(FILE *fp)
 	fprintf(fp, "      --run-args-0                  Print the equivalent arguments for the\n");
 	fprintf(fp, "                                    `run` command to the standard output,\n");
 	fprintf(fp, "                                    formatted for `xargs -0`, and quit\n");
+	fprintf(fp, "      --stats                       Print the statistics of each component\n");
+	fprintf(fp, "                                    to the standard error stream after\n");
+	fprintf(fp, "                                    running the graph\n");
 	fprintf(fp, "      --stream-intersection         Only process events when all streams\n");
 	fprintf(fp, "                                    are active\n");
+	fprintf(fp, "      --time-slices=K               Split the time range of the sources into\n");
+	fprintf(fp, "                                    K slices and convert each one within its\n");
+	fprintf(fp, "                                    own graph, concurrently (see --jobs);\n");
+	fprintf(fp, "                                    implies --no-delta with the `text`\n");
+	fprintf(fp, "                                    output format\n");
 	fprintf(fp, "  -h, --help                        Show this help and quit\n");
 	fprintf(fp, "\n");
 	fprintf(fp, "Implicit `source.ctf.fs` component options:\n");
@@ -2270,6 +2311,7 @@ const struct argpar_opt_descr convert_options[] = {
 	{ OPT_FIELDS, 'f', "fields", true },
 	{ OPT_HELP, 'h', "help", false },
 	{ OPT_INPUT_FORMAT, 'i', "input-format", true },
+	{ OPT_JOBS, 'j', "jobs", true },
 	{ OPT_LOG_LEVEL, 'l', "log-level", true },
 	{ OPT_NAMES, 'n', "names", true },
 	{ OPT_DEBUG_INFO, '\0', "debug-info", false },
@@ -2283,7 +2325,9 @@ const struct argpar_opt_descr convert_options[] = {
 	{ OPT_RETRY_DURATION, '\0', "retry-duration", true },
 	{ OPT_RUN_ARGS, '\0', "run-args", false },
 	{ OPT_RUN_ARGS_0, '\0', "run-args-0", false },
+	{ OPT_STATS, '\0', "stats", false },
 	{ OPT_STREAM_INTERSECTION, '\0', "stream-intersection", false },
+	{ OPT_TIME_SLICES, '\0', "time-slices", true },
 	{ OPT_TIMERANGE, '\0', "timerange", true },
 	{ OPT_VERBOSE, 'v', "verbose", false },
 	ARGPAR_OPT_DESCR_SENTINEL
@@ -3174,6 +3218,671 @@ enum convert_current_item_type {
 	CONVERT_CURRENT_ITEM_TYPE_NON_OPT,
 };
 
+static
+struct bt_config *bt_config_convert_from_args(int argc, const char *argv[],
+		int *retcode, const bt_value *plugin_paths,
+		int *default_log_level, const bt_interrupter *interrupter);
+
+/*
+ * Parses the argument of the convert command option `argpar_item_opt`
+ * as a number greater than 0 into `*val`.
+ *
+ * Returns 0 on success, or -1 if the argument is invalid.
+ */
+static
+int parse_convert_count_opt(const struct argpar_item_opt *argpar_item_opt,
+		uint64_t *val)
+{
+	int ret = 0;
+	gchar *end;
+	size_t arg_len = strlen(argpar_item_opt->arg);
+	int64_t count;
+
+	count = g_ascii_strtoll(argpar_item_opt->arg, &end, 10);
+	if (arg_len == 0 || end != (argpar_item_opt->arg + arg_len)) {
+		BT_CLI_LOGE_APPEND_CAUSE(
+			"Could not parse --%s option's argument as an unsigned integer: `%s`",
+			argpar_item_opt->descr->long_name, argpar_item_opt->arg);
+		goto error;
+	}
+
+	if (count < 1) {
+		BT_CLI_LOGE_APPEND_CAUSE(
+			"--%s option's argument must be greater than 0: %" PRId64,
+			argpar_item_opt->descr->long_name, count);
+		goto error;
+	}
+
+	*val = (uint64_t) count;
+	goto end;
+
+error:
+	ret = -1;
+
+end:
+	return ret;
+}
+
+/*
+ * Finds the --jobs and --time-slices options within the parsed
+ * arguments of a convert command.
+ *
+ * Sets `*max_jobs` and `*time_slice_count` to their values (0 if the
+ * option is missing) and `*non_opt_count` to the number of non-option
+ * arguments.
+ *
+ * Returns 0 on success, or -1 if an option's argument is invalid.
+ */
+static
+int get_convert_parallel_opts(const struct argpar_parse_ret *argpar_parse_ret,
+		uint64_t *max_jobs, uint64_t *time_slice_count,
+		uint64_t *non_opt_count)
+{
+	int ret = 0;
+	size_t i;
+
+	*max_jobs = 0;
+	*time_slice_count = 0;
+	*non_opt_count = 0;
+
+	for (i = 0; i < argpar_parse_ret->items->n_items; i++) {
+		struct argpar_item *argpar_item =
+			argpar_parse_ret->items->items[i];
+		struct argpar_item_opt *argpar_item_opt;
+
+		if (argpar_item->type == ARGPAR_ITEM_TYPE_NON_OPT) {
+			(*non_opt_count)++;
+			continue;
+		}
+
+		argpar_item_opt = (struct argpar_item_opt *) argpar_item;
+
+		switch (argpar_item_opt->descr->id) {
+		case OPT_JOBS:
+			ret = parse_convert_count_opt(argpar_item_opt, max_jobs);
+			break;
+		case OPT_TIME_SLICES:
+			ret = parse_convert_count_opt(argpar_item_opt,
+				time_slice_count);
+			break;
+		default:
+			break;
+		}
+
+		if (ret) {
+			goto end;
+		}
+	}
+
+end:
+	return ret;
+}
+
+/*
+ * Checks that the parsed arguments of a convert command are compatible
+ * with its parallel option `mode_opt_name`, and sets `*output_format`
+ * and `*output` to the arguments of its --output-format and --output
+ * options (`NULL` if missing).
+ *
+ * `allow_text` indicates whether or not the `text` output format, the
+ * default one, is supported.
+ *
+ * Returns 0 on success, or -1 on error.
+ */
+static
+int check_convert_parallel_args(const struct argpar_parse_ret *argpar_parse_ret,
+		const char *mode_opt_name, bool allow_text,
+		const char **output_format, const char **output)
+{
+	int ret = 0;
+	size_t i;
+
+	*output_format = NULL;
+	*output = NULL;
+
+	for (i = 0; i < argpar_parse_ret->items->n_items; i++) {
+		struct argpar_item *argpar_item =
+			argpar_parse_ret->items->items[i];
+		struct argpar_item_opt *argpar_item_opt;
+
+		if (argpar_item->type != ARGPAR_ITEM_TYPE_OPT) {
+			continue;
+		}
+
+		argpar_item_opt = (struct argpar_item_opt *) argpar_item;
+
+		switch (argpar_item_opt->descr->id) {
+		case OPT_OUTPUT_FORMAT:
+			*output_format = argpar_item_opt->arg;
+			break;
+		case OPT_OUTPUT:
+			*output = argpar_item_opt->arg;
+			break;
+		case OPT_COMPONENT:
+		{
+			char *name = NULL;
+			char *plugin_name = NULL;
+			char *comp_cls_name = NULL;
+			bt_component_class_type type = 0;
+
+			plugin_comp_cls_names(argpar_item_opt->arg, &name,
+				&plugin_name, &comp_cls_name, &type);
+			g_free(name);
+			g_free(plugin_name);
+			g_free(comp_cls_name);
+
+			if (type == BT_COMPONENT_CLASS_TYPE_SINK) {
+				BT_CLI_LOGE_APPEND_CAUSE(
+					"Cannot instantiate a sink component with the --%s option: %s",
+					mode_opt_name, argpar_item_opt->arg);
+				goto error;
+			}
+
+			break;
+		}
+		case OPT_RUN_ARGS:
+		case OPT_RUN_ARGS_0:
+			BT_CLI_LOGE_APPEND_CAUSE(
+				"Cannot specify the --%s option with the --%s option.",
+				argpar_item_opt->descr->long_name,
+				mode_opt_name);
+			goto error;
+		default:
+			break;
+		}
+	}
+
+	/*
+	 * The jobs run concurrently: a single sink cannot receive the
+	 * messages of the different jobs.
+	 */
+	if (!*output_format) {
+		if (allow_text) {
+			*output_format = "text";
+		}
+	} else if (strcmp(*output_format, "ctf") != 0 &&
+			strcmp(*output_format, "dummy") != 0 &&
+			(!allow_text || strcmp(*output_format, "text") != 0)) {
+		*output_format = NULL;
+	}
+
+	if (!*output_format) {
+		BT_CLI_LOGE_APPEND_CAUSE(
+			"The --%s option requires the %s output format (--output-format option).",
+			mode_opt_name,
+			allow_text ? "`text`, `ctf`, or `dummy`" :
+				"`ctf` or `dummy`");
+		goto error;
+	}
+
+	goto end;
+
+error:
+	ret = -1;
+
+end:
+	return ret;
+}
+
+/*
+ * Returns the arguments (array of `gchar *`) of a conversion job
+ * created from the parsed arguments of a convert command.
+ *
+ * The job arguments are the original ones without the --jobs and
+ * --time-slices options and, if `non_opt_index` is not `SIZE_MAX`,
+ * without the non-option arguments, and the --params and --log-level
+ * options which apply to them, other than the item #`non_opt_index`.
+ *
+ * If `output` is not `NULL`, it replaces the argument of the --output
+ * option (added if missing).
+ */
+static
+GPtrArray *create_convert_job_args(
+		const struct argpar_parse_ret *argpar_parse_ret,
+		size_t non_opt_index, const char *output)
+{
+	GPtrArray *job_args = g_ptr_array_new_with_free_func(g_free);
+	bool skip_item_opts = false;
+	bool has_output = false;
+	size_t i;
+
+	if (!job_args) {
+		BT_CLI_LOGE_APPEND_CAUSE_OOM();
+		goto end;
+	}
+
+	for (i = 0; i < argpar_parse_ret->items->n_items; i++) {
+		struct argpar_item *argpar_item =
+			argpar_parse_ret->items->items[i];
+		struct argpar_item_opt *argpar_item_opt;
+
+		if (argpar_item->type == ARGPAR_ITEM_TYPE_NON_OPT) {
+			/*
+			 * Skip the other non-option arguments and the
+			 * options which apply to them.
+			 */
+			skip_item_opts = non_opt_index != SIZE_MAX &&
+				i != non_opt_index;
+
+			if (!skip_item_opts) {
+				g_ptr_array_add(job_args, g_strdup(
+					((struct argpar_item_non_opt *)
+						argpar_item)->arg));
+			}
+
+			continue;
+		}
+
+		argpar_item_opt = (struct argpar_item_opt *) argpar_item;
+
+		switch (argpar_item_opt->descr->id) {
+		case OPT_JOBS:
+		case OPT_TIME_SLICES:
+			continue;
+		case OPT_COMPONENT:
+			skip_item_opts = false;
+			break;
+		case OPT_PARAMS:
+		case OPT_LOG_LEVEL:
+			if (skip_item_opts) {
+				continue;
+			}
+
+			break;
+		default:
+			break;
+		}
+
+		g_ptr_array_add(job_args, g_strdup_printf("--%s",
+			argpar_item_opt->descr->long_name));
+
+		if (!argpar_item_opt->descr->with_arg) {
+			continue;
+		}
+
+		if (argpar_item_opt->descr->id == OPT_OUTPUT && output) {
+			g_ptr_array_add(job_args, g_strdup(output));
+			has_output = true;
+		} else {
+			g_ptr_array_add(job_args,
+				g_strdup(argpar_item_opt->arg));
+		}
+	}
+
+	if (output && !has_output) {
+		g_ptr_array_add(job_args, g_strdup("--output"));
+		g_ptr_array_add(job_args, g_strdup(output));
+	}
+
+end:
+	return job_args;
+}
+
+/*
+ * Creates the run configuration of a conversion job named `name` from
+ * the convert command arguments `job_args` and appends it to the jobs
+ * of the parallel run configuration `cfg`.
+ *
+ * Returns 0 on success, or -1 on error.
+ */
+static
+int append_convert_job(struct bt_config *cfg, const char *name,
+		GPtrArray *job_args, const char *text_output_path,
+		int *retcode, const bt_value *plugin_paths,
+		int *default_log_level, const bt_interrupter *interrupter)
+{
+	int ret = 0;
+	struct bt_config_job *job = g_new0(struct bt_config_job, 1);
+
+	if (!job) {
+		BT_CLI_LOGE_APPEND_CAUSE_OOM();
+		goto error;
+	}
+
+	job->name = g_string_new(name);
+	if (!job->name) {
+		BT_CLI_LOGE_APPEND_CAUSE_OOM();
+		goto error;
+	}
+
+	if (text_output_path) {
+		job->text_output_path = g_string_new(text_output_path);
+		if (!job->text_output_path) {
+			BT_CLI_LOGE_APPEND_CAUSE_OOM();
+			goto error;
+		}
+	}
+
+	job->cfg = bt_config_convert_from_args((int) job_args->len,
+		(const char **) job_args->pdata, retcode, plugin_paths,
+		default_log_level, interrupter);
+	if (!job->cfg) {
+		BT_CLI_LOGE_APPEND_CAUSE(
+			"Cannot create the configuration of conversion job `%s`.",
+			name);
+		goto error;
+	}
+
+	BT_ASSERT(job->cfg->command == BT_CONFIG_COMMAND_RUN);
+	g_ptr_array_add(cfg->cmd_data.run.jobs, job);
+	job = NULL;
+	goto end;
+
+error:
+	ret = -1;
+
+end:
+	bt_config_job_destroy(job);
+	return ret;
+}
+
+/*
+ * Creates an empty parallel run configuration running at most
+ * `max_jobs` jobs concurrently.
+ */
+static
+struct bt_config *create_parallel_run_cfg(const bt_value *plugin_paths,
+		uint64_t max_jobs)
+{
+	struct bt_config *cfg = bt_config_run_create(plugin_paths);
+
+	if (!cfg) {
+		goto error;
+	}
+
+	cfg->cmd_data.run.jobs = g_ptr_array_new_with_free_func(
+		(GDestroyNotify) bt_config_job_destroy);
+	if (!cfg->cmd_data.run.jobs) {
+		BT_CLI_LOGE_APPEND_CAUSE_OOM();
+		goto error;
+	}
+
+	cfg->cmd_data.run.max_jobs = max_jobs;
+	goto end;
+
+error:
+	BT_OBJECT_PUT_REF_AND_RESET(cfg);
+
+end:
+	return cfg;
+}
+
+/*
+ * Returns the name, unique within `used_names`, of the output
+ * directory of the conversion job of the input `input`, adding it to
+ * `used_names`.
+ */
+static
+gchar *get_convert_job_dir_name(const char *input, GHashTable *used_names)
+{
+	gchar *base_name = g_path_get_basename(input);
+	gchar *dir_name = g_strdup(base_name);
+	unsigned int i = 0;
+
+	while (bt_g_hash_table_contains(used_names, dir_name)) {
+		g_free(dir_name);
+		dir_name = g_strdup_printf("%s-%u", base_name, i);
+		i++;
+	}
+
+	g_hash_table_insert(used_names, g_strdup(dir_name), NULL);
+	g_free(base_name);
+	return dir_name;
+}
+
+/*
+ * Creates a run configuration which contains one conversion job per
+ * non-option argument of `argpar_parse_ret`, at most `max_jobs` of
+ * them running concurrently.
+ *
+ * The arguments of a job are the original convert command arguments
+ * without the --jobs option and without the other non-option arguments
+ * (and their --params and --log-level options). With the `ctf` output
+ * format, the output directory of a job is a subdirectory of the
+ * --output directory named after its non-option argument.
+ *
+ * *retcode is set to the appropriate exit code to use.
+ */
+static
+struct bt_config *bt_config_convert_parallel_from_args(
+		const struct argpar_parse_ret *argpar_parse_ret,
+		uint64_t max_jobs, int *retcode, const bt_value *plugin_paths,
+		int *default_log_level, const bt_interrupter *interrupter)
+{
+	struct bt_config *cfg = NULL;
+	GPtrArray *job_args = NULL;
+	GHashTable *job_dir_names = NULL;
+	gchar *job_output = NULL;
+	const char *output_format;
+	const char *output;
+	size_t i;
+
+	if (check_convert_parallel_args(argpar_parse_ret, "jobs", false,
+			&output_format, &output)) {
+		goto error;
+	}
+
+	job_dir_names = g_hash_table_new_full(g_str_hash, g_str_equal,
+		g_free, NULL);
+	if (!job_dir_names) {
+		BT_CLI_LOGE_APPEND_CAUSE_OOM();
+		goto error;
+	}
+
+	cfg = create_parallel_run_cfg(plugin_paths, max_jobs);
+	if (!cfg) {
+		goto error;
+	}
+
+	for (i = 0; i < argpar_parse_ret->items->n_items; i++) {
+		struct argpar_item_non_opt *argpar_item_non_opt;
+
+		if (argpar_parse_ret->items->items[i]->type !=
+				ARGPAR_ITEM_TYPE_NON_OPT) {
+			continue;
+		}
+
+		argpar_item_non_opt = (struct argpar_item_non_opt *)
+			argpar_parse_ret->items->items[i];
+
+		if (strcmp(output_format, "ctf") == 0 && output) {
+			gchar *job_dir_name = get_convert_job_dir_name(
+				argpar_item_non_opt->arg, job_dir_names);
+
+			job_output = g_build_filename(output, job_dir_name,
+				NULL);
+			g_free(job_dir_name);
+		}
+
+		job_args = create_convert_job_args(argpar_parse_ret, i,
+			job_output);
+		if (!job_args) {
+			goto error;
+		}
+
+		if (append_convert_job(cfg, argpar_item_non_opt->arg,
+				job_args, NULL, retcode, plugin_paths,
+				default_log_level, interrupter)) {
+			goto error;
+		}
+
+		g_ptr_array_free(job_args, TRUE);
+		job_args = NULL;
+		g_free(job_output);
+		job_output = NULL;
+	}
+
+	goto end;
+
+error:
+	*retcode = 1;
+	BT_OBJECT_PUT_REF_AND_RESET(cfg);
+
+end:
+	if (job_args) {
+		g_ptr_array_free(job_args, TRUE);
+	}
+
+	if (job_dir_names) {
+		g_hash_table_destroy(job_dir_names);
+	}
+
+	g_free(job_output);
+	return cfg;
+}
+
+/*
+ * Creates a run configuration which contains `time_slice_count`
+ * conversion jobs, at most `max_jobs` of them running concurrently.
+ *
+ * Each job converts all the non-option arguments of `argpar_parse_ret`,
+ * but only the messages of its own time slice: the time range of the
+ * sources is only known when running the configuration.
+ *
+ * With the `ctf` output format, the output directory of time slice #i
+ * is the `slice-i` subdirectory of the --output directory. With the
+ * `text` output format, each job writes its text, without time deltas
+ * (--no-delta), to a temporary file: running the configuration copies
+ * those files, in time order, to the --output file or to the standard
+ * output.
+ *
+ * *retcode is set to the appropriate exit code to use.
+ */
+static
+struct bt_config *bt_config_convert_time_sliced_from_args(
+		const struct argpar_parse_ret *argpar_parse_ret,
+		uint64_t time_slice_count, uint64_t max_jobs, int *retcode,
+		const bt_value *plugin_paths, int *default_log_level,
+		const bt_interrupter *interrupter)
+{
+	struct bt_config *cfg = NULL;
+	GPtrArray *job_args = NULL;
+	gchar *job_name = NULL;
+	gchar *job_output = NULL;
+	const char *output_format;
+	const char *output;
+	bool text_output;
+	uint64_t i;
+
+	if (check_convert_parallel_args(argpar_parse_ret, "time-slices",
+			true, &output_format, &output)) {
+		goto error;
+	}
+
+	for (i = 0; i < argpar_parse_ret->items->n_items; i++) {
+		struct argpar_item_opt *argpar_item_opt =
+			(struct argpar_item_opt *) argpar_parse_ret->items->items[i];
+
+		/*
+		 * The time range of a slice is the same for all the
+		 * streams.
+		 */
+		if (argpar_parse_ret->items->items[i]->type ==
+				ARGPAR_ITEM_TYPE_OPT &&
+				argpar_item_opt->descr->id ==
+					OPT_STREAM_INTERSECTION) {
+			BT_CLI_LOGE_APPEND_CAUSE(
+				"Cannot specify the --stream-intersection option with the --time-slices option.");
+			goto error;
+		}
+	}
+
+	cfg = create_parallel_run_cfg(plugin_paths,
+		max_jobs > 0 ? max_jobs : time_slice_count);
+	if (!cfg) {
+		goto error;
+	}
+
+	cfg->cmd_data.run.time_slice_count = time_slice_count;
+	text_output = strcmp(output_format, "text") == 0;
+
+	if (text_output) {
+		gchar *tmp_dir = g_build_filename(g_get_tmp_dir(),
+			"babeltrace2-slices-XXXXXX", NULL);
+
+		if (!bt_mkdtemp(tmp_dir)) {
+			BT_CLI_LOGE_APPEND_CAUSE(
+				"Cannot create temporary directory: path=\"%s\", error=%s",
+				tmp_dir, g_strerror(errno));
+			g_free(tmp_dir);
+			goto error;
+		}
+
+		cfg->cmd_data.run.tmp_dir = g_string_new(tmp_dir);
+		g_free(tmp_dir);
+		if (!cfg->cmd_data.run.tmp_dir) {
+			BT_CLI_LOGE_APPEND_CAUSE_OOM();
+			goto error;
+		}
+
+		if (output) {
+			cfg->cmd_data.run.text_output_path =
+				g_string_new(output);
+			if (!cfg->cmd_data.run.text_output_path) {
+				BT_CLI_LOGE_APPEND_CAUSE_OOM();
+				goto error;
+			}
+		}
+	}
+
+	for (i = 0; i < time_slice_count; i++) {
+		job_name = g_strdup_printf("slice-%" PRIu64, i);
+
+		if (text_output) {
+			gchar *file_name = g_strdup_printf("%s.txt", job_name);
+
+			job_output = g_build_filename(
+				cfg->cmd_data.run.tmp_dir->str, file_name,
+				NULL);
+			g_free(file_name);
+		} else if (strcmp(output_format, "ctf") == 0 && output) {
+			job_output = g_build_filename(output, job_name, NULL);
+		}
+
+		job_args = create_convert_job_args(argpar_parse_ret,
+			SIZE_MAX, job_output);
+		if (!job_args) {
+			goto error;
+		}
+
+		if (text_output) {
+			/*
+			 * The first event of a time slice has no previous
+			 * event from which to compute a delta.
+			 */
+			g_ptr_array_add(job_args, g_strdup("--no-delta"));
+		}
+
+		if (append_convert_job(cfg, job_name, job_args,
+				text_output ? job_output : NULL, retcode,
+				plugin_paths, default_log_level, interrupter)) {
+			goto error;
+		}
+
+		g_ptr_array_free(job_args, TRUE);
+		job_args = NULL;
+		g_free(job_name);
+		job_name = NULL;
+		g_free(job_output);
+		job_output = NULL;
+	}
+
+	goto end;
+
+error:
+	*retcode = 1;
+	BT_OBJECT_PUT_REF_AND_RESET(cfg);
+
+end:
+	if (job_args) {
+		g_ptr_array_free(job_args, TRUE);
+	}
+
+	g_free(job_name);
+	g_free(job_output);
+	return cfg;
+}
+
 /*
  * Creates a Babeltrace config object from the arguments of a convert
  * command.
@@ -3222,6 +3931,9 @@ struct bt_config *bt_config_convert_from_args(int argc, const char *argv[],
 	GString *name_gstr = NULL;
 	GString *component_arg_for_run = NULL;
 	bt_value *live_inputs_array_val = NULL;
+	uint64_t max_jobs;
+	uint64_t time_slice_count;
+	uint64_t non_opt_count;
 
 	/*
 	 * Array of `struct implicit_component_args *` created for the sources
@@ -3356,6 +4068,32 @@ struct bt_config *bt_config_convert_from_args(int argc, const char *argv[],
 		goto end;
 	}
 
+	if (get_convert_parallel_opts(&argpar_parse_ret, &max_jobs,
+			&time_slice_count, &non_opt_count)) {
+		goto error;
+	}
+
+	if (time_slice_count > 1) {
+		cfg = bt_config_convert_time_sliced_from_args(
+			&argpar_parse_ret, time_slice_count, max_jobs,
+			retcode, plugin_paths, default_log_level,
+			interrupter);
+		if (!cfg) {
+			goto error;
+		}
+
+		goto end;
+	} else if (max_jobs > 0 && non_opt_count > 1) {
+		cfg = bt_config_convert_parallel_from_args(&argpar_parse_ret,
+			max_jobs, retcode, plugin_paths, default_log_level,
+			interrupter);
+		if (!cfg) {
+			goto error;
+		}
+
+		goto end;
+	}
+
 	for (i = 0; i < argpar_parse_ret.items->n_items; i++) {
 		struct argpar_item *argpar_item =
 			argpar_parse_ret.items->items[i];
@@ -3557,6 +4295,13 @@ struct bt_config *bt_config_convert_from_args(int argc, const char *argv[],
 					goto error;
 				}
 				break;
+			case OPT_STATS:
+				if (bt_value_array_append_string_element(run_args,
+						"--stats")) {
+					BT_CLI_LOGE_APPEND_CAUSE_OOM();
+					goto error;
+				}
+				break;
 			case OPT_BEGIN:
 			case OPT_CLOCK_CYCLES:
 			case OPT_CLOCK_DATE:
@@ -3574,6 +4319,7 @@ struct bt_config *bt_config_convert_from_args(int argc, const char *argv[],
 			case OPT_END:
 			case OPT_FIELDS:
 			case OPT_INPUT_FORMAT:
+			case OPT_JOBS:
 			case OPT_NAMES:
 			case OPT_NO_DELTA:
 			case OPT_OUTPUT_FORMAT:
@@ -3581,6 +4327,7 @@ struct bt_config *bt_config_convert_from_args(int argc, const char *argv[],
 			case OPT_RUN_ARGS:
 			case OPT_RUN_ARGS_0:
 			case OPT_STREAM_INTERSECTION:
+			case OPT_TIME_SLICES:
 			case OPT_TIMERANGE:
 			case OPT_VERBOSE:
 				/* Ignore in this pass */
@@ -25,6 +25,7 @@
 #include "common/common.h"
 #include <babeltrace2/babeltrace.h>
 #include <glib.h>
+#include <glib/gstdio.h>
 #include "babeltrace2-cfg.h"
 
 static
@@ -99,3 +100,22 @@ void bt_config_connection_destroy(struct bt_config_connection *connection)
 
 	g_free(connection);
 }
+
+void bt_config_job_destroy(struct bt_config_job *job)
+{
+	if (!job) {
+		return;
+	}
+
+	if (job->name) {
+		g_string_free(job->name, TRUE);
+	}
+
+	if (job->text_output_path) {
+		(void) g_unlink(job->text_output_path->str);
+		g_string_free(job->text_output_path, TRUE);
+	}
+
+	BT_OBJECT_PUT_REF_AND_RESET(job->cfg);
+	g_free(job);
+}
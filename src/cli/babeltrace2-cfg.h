@@ -61,6 +61,26 @@ struct bt_config_connection {
 	GString *arg;
 };
 
+struct bt_config;
+
+/* Conversion job of a parallel `convert` command */
+struct bt_config_job {
+	/* Converted input (non-option argument) or time slice name */
+	GString *name;
+
+	/* Run configuration of this job (owned by this) */
+	struct bt_config *cfg;
+
+	/*
+	 * Temporary text output file of this job, or `NULL`.
+	 *
+	 * When set, this file is copied, in job order, to the text
+	 * output of the parallel configuration once all the jobs
+	 * succeed.
+	 */
+	GString *text_output_path;
+};
+
 struct bt_config {
 	bt_object base;
 	bt_value *plugin_paths;
@@ -96,6 +116,48 @@ struct bt_config {
 			 * intersection of its streams.
 			 */
 			bool stream_intersection_mode;
+
+			/*
+			 * Whether or not to print the statistics of each
+			 * component after running the graph.
+			 */
+			bool print_stats;
+
+			/*
+			 * Array of pointers to struct bt_config_job, or
+			 * `NULL`.
+			 *
+			 * When set, the run configuration has no
+			 * components: running it means running the
+			 * graphs of those jobs, at most `max_jobs` at a
+			 * time, each one within its own thread.
+			 */
+			GPtrArray *jobs;
+
+			/* Maximum number of concurrently running jobs */
+			uint64_t max_jobs;
+
+			/*
+			 * If not 0, job #i converts the time slice #i of
+			 * `time_slice_count` equal slices of the time
+			 * range of the sources (the same for all jobs).
+			 */
+			uint64_t time_slice_count;
+
+			/*
+			 * Path of the file to which to copy the text
+			 * outputs of the jobs, or `NULL` for the standard
+			 * output.
+			 */
+			GString *text_output_path;
+
+			/*
+			 * Directory which contains the temporary text
+			 * output files of the jobs, or `NULL` (removed,
+			 * with those files, when destroying the
+			 * configuration).
+			 */
+			GString *tmp_dir;
 		} run;
 
 		/* BT_CONFIG_COMMAND_HELP */
@@ -138,4 +200,6 @@ int bt_config_append_plugin_paths(bt_value *plugin_paths,
 
 void bt_config_connection_destroy(struct bt_config_connection *connection);
 
+void bt_config_job_destroy(struct bt_config_job *job);
+
 #endif /* CLI_BABELTRACE_CFG_H */
@@ -33,6 +33,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include <stdio.h>
+#include <errno.h>
 #include <glib.h>
 #include <inttypes.h>
 #include <unistd.h>
@@ -1214,6 +1215,13 @@ struct cmd_run_ctx {
 	 * Association of struct port_id -> struct trace_range.
 	 */
 	GHashTable *intersections;
+
+	/*
+	 * Whether or not to trim all the source streams to
+	 * `time_slice` (set before initializing the context).
+	 */
+	bool has_time_slice;
+	struct trace_range time_slice;
 };
 
 /* Returns a timestamp of the form "(-)s.ns" */
@@ -1767,7 +1775,8 @@ end:
 
 static
 bt_get_greatest_operative_mip_version_status get_greatest_operative_mip_version(
-		struct bt_config *cfg, uint64_t *mip_version)
+		struct bt_config *cfg, bool insert_trimmers,
+		uint64_t *mip_version)
 {
 	bt_get_greatest_operative_mip_version_status status =
 		BT_GET_GREATEST_OPERATIVE_MIP_VERSION_STATUS_OK;
@@ -1805,10 +1814,11 @@ bt_get_greatest_operative_mip_version_status get_greatest_operative_mip_version(
 		goto end;
 	}
 
-	if (cfg->cmd_data.run.stream_intersection_mode) {
+	if (insert_trimmers) {
 		/*
-		 * Stream intersection mode adds `flt.utils.trimmer`
-		 * components; we need to include this type of component
+		 * Stream intersection and time slice modes add
+		 * `flt.utils.trimmer` components; we need to include
+		 * this type of component
 		 * in the component descriptor set to get the real
 		 * greatest operative MIP version.
 		 */
@@ -1859,6 +1869,9 @@ int cmd_run_ctx_init(struct cmd_run_ctx *ctx, struct bt_config *cfg)
 
 	if (cfg->cmd_data.run.stream_intersection_mode) {
 		ctx->stream_intersection_mode = true;
+	}
+
+	if (ctx->stream_intersection_mode || ctx->has_time_slice) {
 		ctx->intersections = g_hash_table_new_full(port_id_hash,
 			port_id_equal, port_id_destroy, trace_range_destroy);
 		if (!ctx->intersections) {
@@ -1871,7 +1884,7 @@ int cmd_run_ctx_init(struct cmd_run_ctx *ctx, struct bt_config *cfg)
 	 * the graph to create.
 	 */
 	mip_version_status = get_greatest_operative_mip_version(
-		cfg, &mip_version);
+		cfg, ctx->intersections != NULL, &mip_version);
 	if (mip_version_status == BT_GET_GREATEST_OPERATIVE_MIP_VERSION_STATUS_NO_MATCH) {
 		BT_CLI_LOGE_APPEND_CAUSE(
 			"Failed to find an operative message interchange "
@@ -1896,6 +1909,10 @@ int cmd_run_ctx_init(struct cmd_run_ctx *ctx, struct bt_config *cfg)
 		goto error;
 	}
 
+	if (cfg->cmd_data.run.print_stats) {
+		bt_graph_enable_statistics(ctx->graph);
+	}
+
 	bt_graph_add_interrupter(ctx->graph, the_interrupter);
 	add_listener_status = bt_graph_add_source_component_output_port_added_listener(
 		ctx->graph, graph_source_output_port_added_listener, ctx,
@@ -1925,6 +1942,95 @@ end:
 	return ret;
 }
 
+/*
+ * Sets `*begin_ns_u` and `*end_ns_u` to the time range of the stream info
+ * `stream_value`, an element of the `stream-infos` array of a
+ * `babeltrace.trace-infos` query result.
+ */
+static
+int get_stream_info_range_ns(const bt_value *stream_value,
+		uint64_t *begin_ns_u, uint64_t *end_ns_u)
+{
+	int64_t begin_ns, end_ns;
+	const bt_value *range_ns_value;
+	const bt_value *begin_value;
+	const bt_value *end_value;
+	int ret;
+
+	if (bt_value_get_type(stream_value) != BT_VALUE_TYPE_MAP) {
+		BT_CLI_LOGE_APPEND_CAUSE("Unexpected format of `babeltrace.trace-infos` query result: "
+			"expected streams array element to be a map, got %s.",
+			bt_common_value_type_string(bt_value_get_type(stream_value)));
+		goto error;
+	}
+
+	range_ns_value = bt_value_map_borrow_entry_value_const(
+		stream_value, "range-ns");
+	if (!range_ns_value) {
+		BT_CLI_LOGE_APPEND_CAUSE("Unexpected format of `babeltrace.trace-infos` query result: "
+			"missing expected `range-ns` key in stream map.");
+		goto error;
+	}
+
+	if (bt_value_get_type(range_ns_value) != BT_VALUE_TYPE_MAP) {
+		BT_CLI_LOGE_APPEND_CAUSE("Unexpected format of `babeltrace.trace-infos` query result: "
+			"expected `range-ns` entry value of stream map to be a map, got %s.",
+			bt_common_value_type_string(bt_value_get_type(range_ns_value)));
+		goto error;
+	}
+
+	begin_value = bt_value_map_borrow_entry_value_const(range_ns_value, "begin");
+	if (!begin_value) {
+		BT_CLI_LOGE_APPEND_CAUSE("Unexpected format of `babeltrace.trace-infos` query result: "
+			"missing expected `begin` key in range-ns map.");
+		goto error;
+	}
+
+	if (bt_value_get_type(begin_value) != BT_VALUE_TYPE_SIGNED_INTEGER) {
+		BT_CLI_LOGE_APPEND_CAUSE("Unexpected format of `babeltrace.trace-infos` query result: "
+			"expected `begin` entry value of range-ns map to be a signed integer, got %s.",
+			bt_common_value_type_string(bt_value_get_type(range_ns_value)));
+		goto error;
+	}
+
+	end_value = bt_value_map_borrow_entry_value_const(range_ns_value, "end");
+	if (!end_value) {
+		BT_CLI_LOGE_APPEND_CAUSE("Unexpected format of `babeltrace.trace-infos` query result: "
+			"missing expected `end` key in range-ns map.");
+		goto error;
+	}
+
+	if (bt_value_get_type(end_value) != BT_VALUE_TYPE_SIGNED_INTEGER) {
+		BT_CLI_LOGE_APPEND_CAUSE("Unexpected format of `babeltrace.trace-infos` query result: "
+			"expected `end` entry value of range-ns map to be a signed integer, got %s.",
+			bt_common_value_type_string(bt_value_get_type(range_ns_value)));
+		goto error;
+	}
+
+	begin_ns = bt_value_integer_signed_get(begin_value);
+	end_ns = bt_value_integer_signed_get(end_value);
+
+	if (begin_ns < 0 || end_ns < 0 || end_ns < begin_ns) {
+		BT_CLI_LOGE_APPEND_CAUSE(
+			"Invalid stream range values: "
+			"range-ns:begin=%" PRId64 ", "
+			"range-ns:end=%" PRId64,
+			begin_ns, end_ns);
+		goto error;
+	}
+
+	*begin_ns_u = begin_ns;
+	*end_ns_u = end_ns;
+	ret = 0;
+	goto end;
+
+error:
+	ret = -1;
+
+end:
+	return ret;
+}
+
 /*
  * Compute the intersection of all streams in the array `streams`, write it
  * in `range`.
@@ -1947,79 +2053,15 @@ int compute_stream_intersection(const bt_value *streams,
 	range->intersection_range_end_ns = UINT64_MAX;
 
 	for (i = 0; i < stream_count; i++) {
-		int64_t begin_ns, end_ns;
 		uint64_t begin_ns_u, end_ns_u;
 		const bt_value *stream_value;
-		const bt_value *range_ns_value;
-		const bt_value *begin_value;
-		const bt_value *end_value;
 
 		stream_value = bt_value_array_borrow_element_by_index_const(streams, i);
-		if (bt_value_get_type(stream_value) != BT_VALUE_TYPE_MAP) {
-			BT_CLI_LOGE_APPEND_CAUSE("Unexpected format of `babeltrace.trace-infos` query result: "
-				"expected streams array element to be a map, got %s.",
-				bt_common_value_type_string(bt_value_get_type(stream_value)));
-			goto error;
-		}
-
-		range_ns_value = bt_value_map_borrow_entry_value_const(
-			stream_value, "range-ns");
-		if (!range_ns_value) {
-			BT_CLI_LOGE_APPEND_CAUSE("Unexpected format of `babeltrace.trace-infos` query result: "
-				"missing expected `range-ns` key in stream map.");
-			goto error;
-		}
-
-		if (bt_value_get_type(range_ns_value) != BT_VALUE_TYPE_MAP) {
-			BT_CLI_LOGE_APPEND_CAUSE("Unexpected format of `babeltrace.trace-infos` query result: "
-				"expected `range-ns` entry value of stream map to be a map, got %s.",
-				bt_common_value_type_string(bt_value_get_type(range_ns_value)));
-			goto error;
-		}
-
-		begin_value = bt_value_map_borrow_entry_value_const(range_ns_value, "begin");
-		if (!begin_value) {
-			BT_CLI_LOGE_APPEND_CAUSE("Unexpected format of `babeltrace.trace-infos` query result: "
-				"missing expected `begin` key in range-ns map.");
-			goto error;
-		}
-
-		if (bt_value_get_type(begin_value) != BT_VALUE_TYPE_SIGNED_INTEGER) {
-			BT_CLI_LOGE_APPEND_CAUSE("Unexpected format of `babeltrace.trace-infos` query result: "
-				"expected `begin` entry value of range-ns map to be a signed integer, got %s.",
-				bt_common_value_type_string(bt_value_get_type(range_ns_value)));
-			goto error;
-		}
-
-		end_value = bt_value_map_borrow_entry_value_const(range_ns_value, "end");
-		if (!end_value) {
-			BT_CLI_LOGE_APPEND_CAUSE("Unexpected format of `babeltrace.trace-infos` query result: "
-				"missing expected `end` key in range-ns map.");
-			goto error;
-		}
-
-		if (bt_value_get_type(end_value) != BT_VALUE_TYPE_SIGNED_INTEGER) {
-			BT_CLI_LOGE_APPEND_CAUSE("Unexpected format of `babeltrace.trace-infos` query result: "
-				"expected `end` entry value of range-ns map to be a signed integer, got %s.",
-				bt_common_value_type_string(bt_value_get_type(range_ns_value)));
-			goto error;
-		}
-
-		begin_ns = bt_value_integer_signed_get(begin_value);
-		end_ns = bt_value_integer_signed_get(end_value);
-
-		if (begin_ns < 0 || end_ns < 0 || end_ns < begin_ns) {
-			BT_CLI_LOGE_APPEND_CAUSE(
-				"Invalid stream range values: "
-				"range-ns:begin=%" PRId64 ", "
-				"range-ns:end=%" PRId64,
-				begin_ns, end_ns);
+		if (get_stream_info_range_ns(stream_value, &begin_ns_u,
+				&end_ns_u)) {
 			goto error;
 		}
 
-		begin_ns_u = begin_ns;
-		end_ns_u = end_ns;
-
 		range->intersection_range_begin_ns =
 			MAX(range->intersection_range_begin_ns, begin_ns_u);
 		range->intersection_range_end_ns =
@@ -2127,10 +2169,16 @@ int set_stream_intersections(struct cmd_run_ctx *ctx,
 			goto end;
 		}
 
-		ret = compute_stream_intersection(stream_infos, &trace_intersection);
-		if (ret != 0) {
-			BT_CLI_LOGE_APPEND_CAUSE("Failed to compute trace streams intersection.");
-			goto end;
+		if (ctx->has_time_slice) {
+			/* Trim all the streams to the time slice */
+			trace_intersection = ctx->time_slice;
+		} else {
+			ret = compute_stream_intersection(stream_infos,
+				&trace_intersection);
+			if (ret != 0) {
+				BT_CLI_LOGE_APPEND_CAUSE("Failed to compute trace streams intersection.");
+				goto end;
+			}
 		}
 
 		for (stream_idx = 0; stream_idx < stream_count; stream_idx++) {
@@ -2219,6 +2267,124 @@ end:
 	return ret;
 }
 
+/*
+ * Sets `range` to the union of the time ranges of all the streams of
+ * the source components of the run configuration `cfg`, as reported by
+ * their `babeltrace.trace-infos` query.
+ */
+static
+int get_sources_time_range(struct bt_config *cfg, struct trace_range *range)
+{
+	int ret = 0;
+	const bt_value *query_result = NULL;
+	const bt_component_class_source *src_comp_cls = NULL;
+	bool has_stream = false;
+	guint i;
+
+	range->intersection_range_begin_ns = UINT64_MAX;
+	range->intersection_range_end_ns = 0;
+
+	for (i = 0; i < cfg->cmd_data.run.sources->len; i++) {
+		struct bt_config_component *cfg_comp =
+			g_ptr_array_index(cfg->cmd_data.run.sources, i);
+		const bt_component_class *comp_cls;
+		const char *fail_reason = NULL;
+		uint64_t trace_idx;
+
+		src_comp_cls = find_source_component_class(
+			cfg_comp->plugin_name->str,
+			cfg_comp->comp_cls_name->str);
+		if (!src_comp_cls) {
+			BT_CLI_LOGE_APPEND_CAUSE(
+				"Cannot find source component class: "
+				"plugin-name=\"%s\", comp-cls-name=\"%s\"",
+				cfg_comp->plugin_name->str,
+				cfg_comp->comp_cls_name->str);
+			goto error;
+		}
+
+		comp_cls = bt_component_class_source_as_component_class_const(
+			src_comp_cls);
+		ret = query(cfg, comp_cls, "babeltrace.trace-infos",
+			cfg_comp->params, &query_result, &fail_reason);
+		if (ret) {
+			BT_CLI_LOGE_APPEND_CAUSE("Failed to execute `babeltrace.trace-infos` query: %s: "
+				"comp-class-name=\"%s\"", fail_reason,
+				bt_component_class_get_name(comp_cls));
+			goto error;
+		}
+
+		if (!bt_value_is_array(query_result)) {
+			BT_CLI_LOGE_APPEND_CAUSE("`babeltrace.trace-infos` query: expecting result to be an array: "
+				"component-class-name=%s, actual-type=%s",
+				bt_component_class_get_name(comp_cls),
+				bt_common_value_type_string(bt_value_get_type(query_result)));
+			goto error;
+		}
+
+		for (trace_idx = 0;
+				trace_idx < bt_value_array_get_length(query_result);
+				trace_idx++) {
+			const bt_value *trace_info =
+				bt_value_array_borrow_element_by_index_const(
+					query_result, trace_idx);
+			const bt_value *stream_infos;
+			uint64_t stream_idx;
+
+			stream_infos = bt_value_is_map(trace_info) ?
+				bt_value_map_borrow_entry_value_const(
+					trace_info, "stream-infos") : NULL;
+			if (!stream_infos || !bt_value_is_array(stream_infos)) {
+				BT_CLI_LOGE_APPEND_CAUSE("`babeltrace.trace-infos` query: "
+					"expecting trace info to be a map with a `stream-infos` array entry: "
+					"component-class-name=%s",
+					bt_component_class_get_name(comp_cls));
+				goto error;
+			}
+
+			for (stream_idx = 0;
+					stream_idx < bt_value_array_get_length(stream_infos);
+					stream_idx++) {
+				uint64_t begin_ns, end_ns;
+
+				if (get_stream_info_range_ns(
+						bt_value_array_borrow_element_by_index_const(
+							stream_infos, stream_idx),
+						&begin_ns, &end_ns)) {
+					goto error;
+				}
+
+				range->intersection_range_begin_ns =
+					MIN(range->intersection_range_begin_ns,
+						begin_ns);
+				range->intersection_range_end_ns =
+					MAX(range->intersection_range_end_ns,
+						end_ns);
+				has_stream = true;
+			}
+		}
+
+		BT_VALUE_PUT_REF_AND_RESET(query_result);
+		BT_COMPONENT_CLASS_SOURCE_PUT_REF_AND_RESET(src_comp_cls);
+	}
+
+	if (!has_stream) {
+		BT_CLI_LOGE_APPEND_CAUSE(
+			"Source components have no streams with a known time range.");
+		goto error;
+	}
+
+	goto end;
+
+error:
+	ret = -1;
+
+end:
+	bt_value_put_ref(query_result);
+	bt_component_class_source_put_ref(src_comp_cls);
+	return ret;
+}
+
 static
 int cmd_run_ctx_create_components_from_config_components(
 		struct cmd_run_ctx *ctx, GPtrArray *cfg_components)
@@ -2302,7 +2468,7 @@ int cmd_run_ctx_create_components_from_config_components(
 			goto error;
 		}
 
-		if (ctx->stream_intersection_mode &&
+		if (ctx->intersections &&
 				cfg_comp->type == BT_COMPONENT_CLASS_TYPE_SOURCE) {
 			ret = set_stream_intersections(ctx, cfg_comp, comp_cls);
 			if (ret) {
@@ -2455,13 +2621,82 @@ end:
 }
 
 static
-enum bt_cmd_status cmd_run(struct bt_config *cfg)
+void print_comps_stats(GHashTable *comps, GPtrArray *cfg_comps)
 {
-	enum bt_cmd_status cmd_status;
-	struct cmd_run_ctx ctx = { 0 };
+	guint i;
+
+	for (i = 0; i < cfg_comps->len; i++) {
+		struct bt_config_component *cfg_comp = g_ptr_array_index(
+			cfg_comps, i);
+		GQuark quark = g_quark_from_string(cfg_comp->instance_name->str);
+
+		/*
+		 * Source, filter, and sink components are all
+		 * `bt_component` objects.
+		 */
+		const bt_component *comp = g_hash_table_lookup(comps,
+			GUINT_TO_POINTER(quark));
+
+		if (!comp) {
+			continue;
+		}
+
+		fprintf(stderr,
+			"%-24s %12" PRIu64 " %8" PRIu64 " %12" PRIu64
+			" %12" PRIu64 " %6" PRIu64 " %12.3f %12.3f\n",
+			cfg_comp->instance_name->str,
+			bt_component_get_statistics_counter(comp,
+				BT_COMPONENT_STATISTICS_COUNTER_METHOD_CALLS),
+			bt_component_get_statistics_counter(comp,
+				BT_COMPONENT_STATISTICS_COUNTER_AGAIN_STATUSES),
+			bt_component_get_statistics_counter(comp,
+				BT_COMPONENT_STATISTICS_COUNTER_MESSAGES),
+			bt_component_get_statistics_message_count(comp,
+				BT_MESSAGE_TYPE_EVENT),
+			bt_component_get_statistics_counter(comp,
+				BT_COMPONENT_STATISTICS_COUNTER_MAX_BATCH_SIZE),
+			(double) bt_component_get_statistics_counter(comp,
+				BT_COMPONENT_STATISTICS_COUNTER_TOTAL_TIME_NS) / 1e6,
+			(double) bt_component_get_statistics_counter(comp,
+				BT_COMPONENT_STATISTICS_COUNTER_SELF_TIME_NS) / 1e6);
+	}
+}
+
+/*
+ * Prints the statistics of each component of the graph to the
+ * standard error stream, in configuration order.
+ *
+ * For source and filter components, the statistics are those of their
+ * message iterators' "next" method calls; for sink components, they
+ * are those of their "consume" method calls.
+ */
+static
+void print_stats(struct cmd_run_ctx *ctx)
+{
+	struct bt_config *cfg = ctx->cfg;
+
+	fprintf(stderr, "%-24s %12s %8s %12s %12s %6s %12s %12s\n",
+		"Component", "Calls", "Again", "Messages", "Events",
+		"Batch", "Total (ms)", "Self (ms)");
+	print_comps_stats(ctx->src_components, cfg->cmd_data.run.sources);
+	print_comps_stats(ctx->flt_components, cfg->cmd_data.run.filters);
+	print_comps_stats(ctx->sink_components, cfg->cmd_data.run.sinks);
+}
+
+/*
+ * Initializes the context `ctx` of the run configuration `cfg`: creates
+ * the graph, the requested component instances, and connects their
+ * initially visible ports.
+ *
+ * On error, the caller still needs to call cmd_run_ctx_destroy().
+ */
+static
+int cmd_run_ctx_setup(struct cmd_run_ctx *ctx, struct bt_config *cfg)
+{
+	int ret = 0;
 
 	/* Initialize the command's context and the graph object */
-	if (cmd_run_ctx_init(&ctx, cfg)) {
+	if (cmd_run_ctx_init(ctx, cfg)) {
 		BT_CLI_LOGE_APPEND_CAUSE(
 			"Cannot initialize the command's context.");
 		goto error;
@@ -2476,7 +2711,7 @@ enum bt_cmd_status cmd_run(struct bt_config *cfg)
 	BT_LOGI_STR("Creating components.");
 
 	/* Create the requested component instances */
-	if (cmd_run_ctx_create_components(&ctx)) {
+	if (cmd_run_ctx_create_components(ctx)) {
 		BT_CLI_LOGE_APPEND_CAUSE("Cannot create components.");
 		goto error;
 	}
@@ -2490,17 +2725,36 @@ enum bt_cmd_status cmd_run(struct bt_config *cfg)
 	BT_LOGI_STR("Connecting components.");
 
 	/* Connect the initially visible component ports */
-	if (cmd_run_ctx_connect_ports(&ctx)) {
+	if (cmd_run_ctx_connect_ports(ctx)) {
 		BT_CLI_LOGE_APPEND_CAUSE(
 			"Cannot connect initial component ports.");
 		goto error;
 	}
 
+	goto end;
+
+error:
+	ret = -1;
+
+end:
+	return ret;
+}
+
+/*
+ * Runs the graph of the set up context `ctx` until it ends, fails, or
+ * is interrupted.
+ */
+static
+enum bt_cmd_status cmd_run_ctx_run(struct cmd_run_ctx *ctx)
+{
+	enum bt_cmd_status cmd_status;
+	struct bt_config *cfg = ctx->cfg;
+
 	BT_LOGI_STR("Running the graph.");
 
 	/* Run the graph */
 	while (true) {
-		bt_graph_run_status run_status = bt_graph_run(ctx.graph);
+		bt_graph_run_status run_status = bt_graph_run(ctx->graph);
 
 		/*
 		 * Reset console in case something messed with console
@@ -2526,15 +2780,27 @@ enum bt_cmd_status cmd_run(struct bt_config *cfg)
 			}
 
 			if (cfg->cmd_data.run.retry_duration_us > 0) {
-				BT_LOGT("Got BT_GRAPH_RUN_STATUS_AGAIN: sleeping: "
-					"time-us=%" PRIu64,
+				bt_graph_wait_status wait_status;
+
+				/*
+				 * Wait until an upstream message iterator is
+				 * likely to be ready, but no longer than the
+				 * retry duration.
+				 */
+				BT_LOGT("Got BT_GRAPH_RUN_STATUS_AGAIN: waiting: "
+					"max-time-us=%" PRIu64,
 					cfg->cmd_data.run.retry_duration_us);
+				wait_status = bt_graph_wait(ctx->graph,
+					cfg->cmd_data.run.retry_duration_us);
+				if (bt_interrupter_is_set(the_interrupter)) {
+					cmd_status = BT_CMD_STATUS_INTERRUPTED;
+					goto end;
+				}
 
-				if (usleep(cfg->cmd_data.run.retry_duration_us)) {
-					if (bt_interrupter_is_set(the_interrupter)) {
-						cmd_status = BT_CMD_STATUS_INTERRUPTED;
-						goto end;
-					}
+				if (wait_status != BT_GRAPH_WAIT_STATUS_OK) {
+					BT_CLI_LOGE_APPEND_CAUSE(
+						"Cannot wait for the graph's message iterators.");
+					goto error;
 				}
 			}
 			break;
@@ -2553,6 +2819,427 @@ error:
 	cmd_status = BT_CMD_STATUS_ERROR;
 
 end:
+	return cmd_status;
+}
+
+/* Conversion job of a parallel run configuration */
+struct cmd_run_job {
+	/* Weak */
+	struct bt_config_job *cfg_job;
+
+	struct cmd_run_ctx ctx;
+	enum bt_cmd_status status;
+
+	/* True if this job has nothing to convert (empty time slice) */
+	bool skip;
+
+	/* Error of the job's thread if `status` is not OK (owned by this) */
+	const bt_error *error;
+};
+
+struct cmd_run_jobs_ctx {
+	/* Array of struct cmd_run_job */
+	struct cmd_run_job *jobs;
+	guint job_count;
+
+	/* Index of the next job to run (atomic) */
+	gint next_job_index;
+};
+
+/*
+ * Runs the jobs of `data` (struct cmd_run_jobs_ctx *), one after the
+ * other, until there's no job left to run.
+ *
+ * The graph of each job is completely created and destroyed on the main
+ * thread: the object reference counts of the library are not atomic,
+ * so a worker thread only runs graphs which nothing else uses.
+ */
+static
+gpointer cmd_run_jobs_worker(gpointer data)
+{
+	struct cmd_run_jobs_ctx *jobs_ctx = data;
+
+	while (true) {
+		guint job_index = (guint) g_atomic_int_add(
+			&jobs_ctx->next_job_index, 1);
+		struct cmd_run_job *job;
+
+		if (job_index >= jobs_ctx->job_count) {
+			break;
+		}
+
+		job = &jobs_ctx->jobs[job_index];
+		if (job->skip) {
+			continue;
+		}
+
+		BT_LOGI("Running conversion job: name=\"%s\"",
+			job->cfg_job->name->str);
+		job->status = cmd_run_ctx_run(&job->ctx);
+		if (job->status != BT_CMD_STATUS_OK) {
+			job->error = bt_current_thread_take_error();
+		}
+	}
+
+	return NULL;
+}
+
+/*
+ * Returns the beginning of the time slice #`index` of `count` equal
+ * slices of `range`.
+ */
+static
+uint64_t get_time_slice_begin_ns(const struct trace_range *range,
+		uint64_t count, uint64_t index)
+{
+	uint64_t span = range->intersection_range_end_ns -
+		range->intersection_range_begin_ns;
+
+	return range->intersection_range_begin_ns + index * (span / count) +
+		index * (span % count) / count;
+}
+
+/*
+ * Sets the time slice of each job of `jobs_ctx` from the time range of
+ * the sources of the first job (all the jobs have the same sources),
+ * marking the jobs of empty slices as skipped.
+ */
+static
+int set_jobs_time_slices(struct cmd_run_jobs_ctx *jobs_ctx)
+{
+	int ret = 0;
+	struct trace_range range;
+	uint64_t count = jobs_ctx->job_count;
+	uint64_t i;
+
+	ret = get_sources_time_range(jobs_ctx->jobs[0].cfg_job->cfg, &range);
+	if (ret) {
+		BT_CLI_LOGE_APPEND_CAUSE(
+			"Cannot get the time range of the sources to slice.");
+		goto end;
+	}
+
+	BT_LOGI("Slicing time range: begin-ns=%" PRIu64 ", end-ns=%" PRIu64
+		", slice-count=%" PRIu64, range.intersection_range_begin_ns,
+		range.intersection_range_end_ns, count);
+
+	for (i = 0; i < count; i++) {
+		struct cmd_run_job *job = &jobs_ctx->jobs[i];
+		uint64_t begin_ns = get_time_slice_begin_ns(&range, count, i);
+		uint64_t end_ns;
+
+		if (i == count - 1) {
+			end_ns = range.intersection_range_end_ns;
+		} else {
+			uint64_t next_begin_ns = get_time_slice_begin_ns(
+				&range, count, i + 1);
+
+			if (next_begin_ns == begin_ns) {
+				/* Time range is shorter than the slice count */
+				job->skip = true;
+				continue;
+			}
+
+			/* Trimmer's range is inclusive */
+			end_ns = next_begin_ns - 1;
+		}
+
+		job->ctx.has_time_slice = true;
+		job->ctx.time_slice.intersection_range_begin_ns = begin_ns;
+		job->ctx.time_slice.intersection_range_end_ns = end_ns;
+	}
+
+end:
+	return ret;
+}
+
+/*
+ * Copies, in job order, the temporary text output files of the jobs of
+ * `jobs_ctx` to the text output of the parallel run configuration
+ * `cfg`.
+ */
+static
+int copy_jobs_text_outputs(struct bt_config *cfg,
+		struct cmd_run_jobs_ctx *jobs_ctx)
+{
+	int ret = 0;
+	FILE *out = stdout;
+	FILE *in = NULL;
+	char buf[65536];
+	guint i;
+
+	if (cfg->cmd_data.run.text_output_path) {
+		out = fopen(cfg->cmd_data.run.text_output_path->str, "wb");
+		if (!out) {
+			BT_CLI_LOGE_APPEND_CAUSE(
+				"Cannot open file: path=\"%s\", error=%s",
+				cfg->cmd_data.run.text_output_path->str,
+				g_strerror(errno));
+			goto error;
+		}
+	}
+
+	for (i = 0; i < jobs_ctx->job_count; i++) {
+		struct cmd_run_job *job = &jobs_ctx->jobs[i];
+		size_t len;
+
+		if (job->skip || !job->cfg_job->text_output_path) {
+			continue;
+		}
+
+		in = fopen(job->cfg_job->text_output_path->str, "rb");
+		if (!in) {
+			BT_CLI_LOGE_APPEND_CAUSE(
+				"Cannot open file: path=\"%s\", error=%s",
+				job->cfg_job->text_output_path->str,
+				g_strerror(errno));
+			goto error;
+		}
+
+		while ((len = fread(buf, 1, sizeof(buf), in)) > 0) {
+			if (fwrite(buf, 1, len, out) != len) {
+				BT_CLI_LOGE_APPEND_CAUSE("Cannot write text output: error=%s",
+					g_strerror(errno));
+				goto error;
+			}
+		}
+
+		if (ferror(in)) {
+			BT_CLI_LOGE_APPEND_CAUSE(
+				"Cannot read file: path=\"%s\", error=%s",
+				job->cfg_job->text_output_path->str,
+				g_strerror(errno));
+			goto error;
+		}
+
+		fclose(in);
+		in = NULL;
+	}
+
+	if (fflush(out)) {
+		BT_CLI_LOGE_APPEND_CAUSE("Cannot write text output: error=%s",
+			g_strerror(errno));
+		goto error;
+	}
+
+	goto end;
+
+error:
+	ret = -1;
+
+end:
+	if (in) {
+		fclose(in);
+	}
+
+	if (out != stdout) {
+		fclose(out);
+	}
+
+	return ret;
+}
+
+/*
+ * Runs the conversion jobs of the parallel run configuration `cfg`, at
+ * most `cfg->cmd_data.run.max_jobs` of them concurrently.
+ *
+ * The current thread is one of the worker threads.
+ */
+static
+enum bt_cmd_status cmd_run_jobs(struct bt_config *cfg)
+{
+	enum bt_cmd_status cmd_status = BT_CMD_STATUS_OK;
+	struct cmd_run_jobs_ctx jobs_ctx = { 0 };
+	GPtrArray *threads = NULL;
+	const bt_error *error = NULL;
+	guint thread_count;
+	guint i;
+
+	jobs_ctx.job_count = cfg->cmd_data.run.jobs->len;
+	jobs_ctx.jobs = g_new0(struct cmd_run_job, jobs_ctx.job_count);
+	if (!jobs_ctx.jobs) {
+		BT_CLI_LOGE_APPEND_CAUSE("Out of memory.");
+		goto error;
+	}
+
+	threads = g_ptr_array_new();
+	if (!threads) {
+		BT_CLI_LOGE_APPEND_CAUSE("Out of memory.");
+		goto error;
+	}
+
+	for (i = 0; i < jobs_ctx.job_count; i++) {
+		jobs_ctx.jobs[i].cfg_job =
+			g_ptr_array_index(cfg->cmd_data.run.jobs, i);
+	}
+
+	if (cfg->cmd_data.run.time_slice_count > 0) {
+		BT_ASSERT(jobs_ctx.job_count ==
+			cfg->cmd_data.run.time_slice_count);
+
+		if (set_jobs_time_slices(&jobs_ctx)) {
+			goto error;
+		}
+	}
+
+	/* Create all the graphs on the main thread */
+	for (i = 0; i < jobs_ctx.job_count; i++) {
+		struct cmd_run_job *job = &jobs_ctx.jobs[i];
+
+		if (job->skip) {
+			continue;
+		}
+
+		BT_LOGI("Setting up conversion job: name=\"%s\"",
+			job->cfg_job->name->str);
+
+		if (cmd_run_ctx_setup(&job->ctx, job->cfg_job->cfg)) {
+			BT_CLI_LOGE_APPEND_CAUSE(
+				"Cannot set up conversion job: name=\"%s\"",
+				job->cfg_job->name->str);
+			goto error;
+		}
+	}
+
+	thread_count = (guint) MIN(cfg->cmd_data.run.max_jobs,
+		(uint64_t) jobs_ctx.job_count);
+
+	/* The current thread is the first worker */
+	for (i = 1; i < thread_count; i++) {
+		GError *gerror = NULL;
+		GThread *thread = g_thread_try_new("bt-convert-job",
+			cmd_run_jobs_worker, &jobs_ctx, &gerror);
+
+		if (!thread) {
+			/* Carry on with the workers we have */
+			BT_LOGW("Cannot create worker thread: %s",
+				gerror->message);
+			g_error_free(gerror);
+			break;
+		}
+
+		g_ptr_array_add(threads, thread);
+	}
+
+	BT_LOGI("Running conversion jobs: job-count=%u, thread-count=%u",
+		jobs_ctx.job_count, threads->len + 1);
+	cmd_run_jobs_worker(&jobs_ctx);
+
+	for (i = 0; i < threads->len; i++) {
+		g_thread_join(g_ptr_array_index(threads, i));
+	}
+
+	/*
+	 * All the jobs ran: the status is "interrupted" if any job was
+	 * interrupted, otherwise "error" if any job failed.
+	 */
+	for (i = 0; i < jobs_ctx.job_count; i++) {
+		struct cmd_run_job *job = &jobs_ctx.jobs[i];
+
+		if (job->status == BT_CMD_STATUS_INTERRUPTED) {
+			cmd_status = BT_CMD_STATUS_INTERRUPTED;
+		} else if (job->status == BT_CMD_STATUS_ERROR &&
+				cmd_status == BT_CMD_STATUS_OK) {
+			cmd_status = BT_CMD_STATUS_ERROR;
+		}
+
+		/*
+		 * Only one error can be the current thread's error: keep
+		 * the one of the first failed job.
+		 */
+		if (job->error) {
+			if (!error) {
+				error = job->error;
+			} else {
+				bt_error_release(job->error);
+			}
+
+			job->error = NULL;
+		}
+	}
+
+	if (error) {
+		bt_current_thread_move_error(error);
+	}
+
+	if (cmd_status == BT_CMD_STATUS_ERROR) {
+		for (i = 0; i < jobs_ctx.job_count; i++) {
+			struct cmd_run_job *job = &jobs_ctx.jobs[i];
+
+			if (job->status == BT_CMD_STATUS_ERROR) {
+				BT_CLI_LOGE_APPEND_CAUSE(
+					"Conversion job failed: name=\"%s\"",
+					job->cfg_job->name->str);
+			}
+		}
+	}
+
+	goto end;
+
+error:
+	cmd_status = BT_CMD_STATUS_ERROR;
+
+end:
+	if (jobs_ctx.jobs) {
+		for (i = 0; i < jobs_ctx.job_count; i++) {
+			struct cmd_run_job *job = &jobs_ctx.jobs[i];
+
+			if (job->cfg_job && job->cfg_job->cfg->cmd_data.run.print_stats &&
+					job->ctx.graph) {
+				fprintf(stderr, "\nConversion job `%s`:\n\n",
+					job->cfg_job->name->str);
+				print_stats(&job->ctx);
+			}
+
+			cmd_run_ctx_destroy(&job->ctx);
+		}
+
+		/*
+		 * The text sinks close their output files when the graphs
+		 * are destroyed.
+		 */
+		if (cmd_status == BT_CMD_STATUS_OK &&
+				cfg->cmd_data.run.tmp_dir &&
+				copy_jobs_text_outputs(cfg, &jobs_ctx)) {
+			cmd_status = BT_CMD_STATUS_ERROR;
+		}
+
+		g_free(jobs_ctx.jobs);
+	}
+
+	if (threads) {
+		g_ptr_array_free(threads, TRUE);
+	}
+
+	return cmd_status;
+}
+
+static
+enum bt_cmd_status cmd_run(struct bt_config *cfg)
+{
+	enum bt_cmd_status cmd_status;
+	struct cmd_run_ctx ctx = { 0 };
+
+	if (cfg->cmd_data.run.jobs) {
+		cmd_status = cmd_run_jobs(cfg);
+		goto end;
+	}
+
+	if (cmd_run_ctx_setup(&ctx, cfg)) {
+		goto error;
+	}
+
+	cmd_status = cmd_run_ctx_run(&ctx);
+	goto end;
+
+error:
+	cmd_status = BT_CMD_STATUS_ERROR;
+
+end:
+	if (cfg->cmd_data.run.print_stats && ctx.graph) {
+		print_stats(&ctx);
+	}
+
 	cmd_run_ctx_destroy(&ctx);
 	return cmd_status;
 }
@@ -0,0 +1,92 @@
+#ifndef _BABELTRACE_COMMON_ZSTD_SEEKABLE_H
+#define _BABELTRACE_COMMON_ZSTD_SEEKABLE_H
+
+/*
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*
+ * Compressed CTF data stream file format.
+ *
+ * A compressed data stream file is a sequence of independent Zstandard
+ * frames, one per CTF packet, followed by a seek table within a
+ * skippable frame (all integers are little-endian):
+ *
+ *     Skippable frame magic number (0x184d2a5e)   32-bit
+ *     Size of the rest of the frame (bytes)       32-bit
+ *     For each Zstandard frame:
+ *         Compressed size (bytes)                  32-bit
+ *         Decompressed size (bytes)                32-bit
+ *         Checksum (if descriptor's bit 7 is set)  32-bit
+ *     Number of Zstandard frames                  32-bit
+ *     Seek table descriptor                        8-bit
+ *     Seekable format magic number (0x8f92eab1)   32-bit
+ *
+ * This is the Zstandard project's "seekable format", so that the
+ * standard `zstd` tool can decompress a compressed data stream file
+ * (it skips the seek table) to get the original data stream file.
+ *
+ * The decompressed content of all the frames is the data stream: the
+ * offsets of a CTF packet index (`.idx` file) are offsets within this
+ * decompressed content.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define BT_ZSTD_FRAME_MAGIC			UINT32_C(0xfd2fb528)
+#define BT_ZSTD_SKIPPABLE_FRAME_MAGIC		UINT32_C(0x184d2a5e)
+#define BT_ZSTD_SKIPPABLE_FRAME_MAGIC_MASK	UINT32_C(0xfffffff0)
+#define BT_ZSTD_SEEKABLE_MAGIC			UINT32_C(0x8f92eab1)
+#define BT_ZSTD_SKIPPABLE_FRAME_HEADER_SIZE	8
+#define BT_ZSTD_SEEK_TABLE_FOOTER_SIZE		9
+#define BT_ZSTD_SEEK_TABLE_DESCR_CHECKSUM	0x80
+
+static inline
+uint32_t bt_zstd_seekable_read_u32(const uint8_t *buf)
+{
+	return (uint32_t) buf[0] | ((uint32_t) buf[1] << 8) |
+		((uint32_t) buf[2] << 16) | ((uint32_t) buf[3] << 24);
+}
+
+static inline
+void bt_zstd_seekable_write_u32(uint8_t *buf, uint32_t val)
+{
+	buf[0] = (uint8_t) val;
+	buf[1] = (uint8_t) (val >> 8);
+	buf[2] = (uint8_t) (val >> 16);
+	buf[3] = (uint8_t) (val >> 24);
+}
+
+/*
+ * Returns whether or not `buf` (at least 4 bytes) is the beginning of
+ * a Zstandard frame or of a skippable frame.
+ */
+static inline
+bool bt_zstd_seekable_is_frame_start(const uint8_t *buf)
+{
+	uint32_t magic = bt_zstd_seekable_read_u32(buf);
+
+	return magic == BT_ZSTD_FRAME_MAGIC ||
+		(magic & BT_ZSTD_SKIPPABLE_FRAME_MAGIC_MASK) ==
+			(BT_ZSTD_SKIPPABLE_FRAME_MAGIC &
+				BT_ZSTD_SKIPPABLE_FRAME_MAGIC_MASK);
+}
+
+#endif /* _BABELTRACE_COMMON_ZSTD_SEEKABLE_H */
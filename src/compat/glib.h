@@ -75,4 +75,32 @@ end:
 }
 #endif
 
+#if GLIB_CHECK_VERSION(2,36,0)
+
+static inline guint
+bt_g_get_num_processors(void)
+{
+	return g_get_num_processors();
+}
+
+#else
+
+#include <unistd.h>
+
+static inline guint
+bt_g_get_num_processors(void)
+{
+#ifdef _SC_NPROCESSORS_ONLN
+	long count = sysconf(_SC_NPROCESSORS_ONLN);
+
+	if (count > 0) {
+		return (guint) count;
+	}
+#endif
+
+	return 1;
+}
+
+#endif
+
 #endif /* _BABELTRACE_COMPAT_GLIB_H */
@@ -26,7 +26,9 @@
 
 
 #include <time.h>
+#include <stdint.h>
 #include <stdlib.h>
+#include <glib.h>
 
 #ifdef __MINGW32__
 
@@ -95,4 +97,25 @@ struct tm *bt_localtime_r(const time_t *timep, struct tm *result)
 }
 
 #endif /* __MINGW32__ */
+
+/*
+ * Returns the current time of a monotonic clock, in nanoseconds, from
+ * an arbitrary origin.
+ */
+static inline
+uint64_t bt_get_monotonic_time_ns(void)
+{
+#if defined(__MINGW32__) || !defined(CLOCK_MONOTONIC)
+	return (uint64_t) g_get_monotonic_time() * UINT64_C(1000);
+#else
+	struct timespec ts;
+
+	if (clock_gettime(CLOCK_MONOTONIC, &ts)) {
+		return (uint64_t) g_get_monotonic_time() * UINT64_C(1000);
+	}
+
+	return (uint64_t) ts.tv_sec * UINT64_C(1000000000) +
+		(uint64_t) ts.tv_nsec;
+#endif
+}
 #endif /* _BABELTRACE_INCLUDE_COMPAT_TIME_H */
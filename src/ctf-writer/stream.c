@@ -1126,6 +1126,14 @@ struct bt_ctf_stream *bt_ctf_stream_create_with_id(
 		goto error;
 	}
 
+	stream->streaming.event_templates = g_hash_table_new_full(
+		g_direct_hash, g_direct_equal, NULL,
+		(GDestroyNotify) bt_ctf_object_put_ref);
+	if (!stream->streaming.event_templates) {
+		BT_LOGE_STR("Failed to allocate a GHashTable.");
+		goto error;
+	}
+
 	if (trace->common.packet_header_field_type) {
 		BT_LOGD("Creating stream's packet header field: "
 			"ft-addr=%p", trace->common.packet_header_field_type);
@@ -1419,6 +1427,14 @@ int bt_ctf_stream_append_event(struct bt_ctf_stream *stream,
 		goto end;
 	}
 
+	if (stream->streaming.packet_is_open) {
+		BT_LOGW("Cannot append an event to a stream of which the current packet was opened by bt_ctf_stream_write_event(): "
+			"stream-addr=%p, stream-name=\"%s\"",
+			stream, bt_ctf_stream_get_name(stream));
+		ret = -1;
+		goto end;
+	}
+
 	bt_ctf_object_set_parent(&event->common.base, &stream->common.base);
 	BT_LOGT_STR("Automatically populating the header of the event to append.");
 	ret = auto_populate_event_header(stream, event);
@@ -1607,6 +1623,22 @@ void reset_structure_field(struct bt_ctf_field *structure, const char *name)
 	}
 }
 
+static
+void reset_packet_context_auto_fields(struct bt_ctf_stream *stream)
+{
+	/* Reset automatically-set fields. */
+	if (stream->packet_context) {
+		reset_structure_field(stream->packet_context, "timestamp_begin");
+		reset_structure_field(stream->packet_context, "timestamp_end");
+		reset_structure_field(stream->packet_context, "packet_size");
+		reset_structure_field(stream->packet_context, "content_size");
+		reset_structure_field(stream->packet_context, "events_discarded");
+	}
+}
+
+static
+int streaming_close_packet(struct bt_ctf_stream *stream);
+
 int bt_ctf_stream_flush(struct bt_ctf_stream *stream)
 {
 	int ret = 0;
@@ -1624,6 +1656,12 @@ int bt_ctf_stream_flush(struct bt_ctf_stream *stream)
 		goto end_no_stream;
 	}
 
+	if (stream->streaming.packet_is_open) {
+		/* Events are already serialized: close the packet */
+		ret = streaming_close_packet(stream);
+		goto end_no_stream;
+	}
+
 	if (stream->packet_context) {
 		struct bt_ctf_field *packet_size_field;
 
@@ -1830,14 +1868,7 @@ int bt_ctf_stream_flush(struct bt_ctf_stream *stream)
 	bt_ctfser_close_current_packet(&stream->ctfser, packet_size_bits / 8);
 
 end:
-	/* Reset automatically-set fields. */
-	if (stream->packet_context) {
-		reset_structure_field(stream->packet_context, "timestamp_begin");
-		reset_structure_field(stream->packet_context, "timestamp_end");
-		reset_structure_field(stream->packet_context, "packet_size");
-		reset_structure_field(stream->packet_context, "content_size");
-		reset_structure_field(stream->packet_context, "events_discarded");
-	}
+	reset_packet_context_auto_fields(stream);
 
 	if (ret == 0) {
 		BT_LOGT("Flushed stream's current packet: "
@@ -1849,6 +1880,476 @@ end_no_stream:
 	return ret;
 }
 
+/*
+ * Opens a new packet for bt_ctf_stream_write_event() and serializes its
+ * header and initial context.
+ */
+static
+int streaming_open_packet(struct bt_ctf_stream *stream)
+{
+	int ret = 0;
+	struct bt_ctf_trace *trace;
+	struct bt_ctf_field *ts_begin_field = NULL;
+	struct bt_ctf_field *ts_end_field = NULL;
+	enum bt_ctf_byte_order native_byte_order;
+	uint64_t init_clock_value = 0;
+
+	BT_ASSERT_DBG(!stream->streaming.packet_is_open);
+
+	if (stream->events->len > 0) {
+		BT_LOGW("Cannot write an event to a stream with appended events which are not flushed: "
+			"stream-addr=%p, stream-name=\"%s\", event-count=%u",
+			stream, bt_ctf_stream_get_name(stream),
+			stream->events->len);
+		ret = -1;
+		goto end;
+	}
+
+	if (stream->flushed_packet_count >= 1) {
+		struct bt_ctf_field *packet_size_field = NULL;
+
+		if (stream->packet_context) {
+			packet_size_field =
+				bt_ctf_field_structure_get_field_by_name(
+					stream->packet_context, "packet_size");
+			bt_ctf_object_put_ref(packet_size_field);
+		}
+
+		if (!packet_size_field) {
+			BT_LOGW_STR("Cannot open more than one packet in a stream which has no packet context's `packet_size` field.");
+			ret = -1;
+			goto end;
+		}
+	}
+
+	BT_LOGT("Opening stream's packet for streaming: stream-addr=%p, "
+		"stream-name=\"%s\", packet-index=%u", stream,
+		bt_ctf_stream_get_name(stream), stream->flushed_packet_count);
+	trace = BT_CTF_FROM_COMMON(bt_ctf_stream_class_common_borrow_trace(
+		stream->common.stream_class));
+	BT_ASSERT_DBG(trace);
+	native_byte_order = bt_ctf_trace_get_native_byte_order(trace);
+
+	ret = auto_populate_packet_header(stream);
+	if (ret) {
+		BT_LOGW_STR("Cannot automatically populate the stream's packet header field.");
+		ret = -1;
+		goto end;
+	}
+
+	stream->streaming.set_ts_end = false;
+
+	if (stream->packet_context) {
+		/*
+		 * The events are not known yet: set the timestamps from
+		 * what's known now (provided `timestamp_begin` value or
+		 * last packet's ending timestamp); streaming_close_packet()
+		 * sets `timestamp_end` to its final value.
+		 */
+		ts_begin_field = bt_ctf_field_structure_get_field_by_name(
+			stream->packet_context, "timestamp_begin");
+		ts_end_field = bt_ctf_field_structure_get_field_by_name(
+			stream->packet_context, "timestamp_end");
+
+		if (ts_begin_field &&
+				bt_ctf_field_is_set_recursive(ts_begin_field)) {
+			ret = bt_ctf_field_integer_unsigned_get_value(
+				ts_begin_field, &init_clock_value);
+			BT_ASSERT_DBG(ret == 0);
+		} else if (stream->last_ts_end != -1ULL) {
+			init_clock_value = stream->last_ts_end;
+		}
+
+		if (stream->last_ts_end != -1ULL &&
+				init_clock_value < stream->last_ts_end) {
+			BT_LOGW("Packet's initial timestamp is less than previous "
+				"packet's final timestamp: "
+				"stream-addr=%p, stream-name=\"%s\", "
+				"cur-packet-ts-begin=%" PRIu64 ", "
+				"prev-packet-ts-end=%" PRIu64,
+				stream, bt_ctf_stream_get_name(stream),
+				init_clock_value, stream->last_ts_end);
+			ret = -1;
+			goto end;
+		}
+
+		if (ts_begin_field &&
+				!bt_ctf_field_is_set_recursive(ts_begin_field)) {
+			ret = set_integer_field_value(ts_begin_field,
+				init_clock_value);
+			BT_ASSERT_DBG(ret == 0);
+		}
+
+		if (ts_end_field &&
+				!bt_ctf_field_is_set_recursive(ts_end_field)) {
+			/* Placeholder until the packet is closed */
+			ret = set_integer_field_value(ts_end_field,
+				init_clock_value);
+			BT_ASSERT_DBG(ret == 0);
+			stream->streaming.set_ts_end = true;
+		}
+
+		/* Initialize packet/content sizes to `0`; we will overwrite later */
+		ret = auto_populate_packet_context(stream, false, 0, 0);
+		if (ret) {
+			BT_LOGW_STR("Cannot automatically populate the stream's packet context field.");
+			ret = -1;
+			goto end;
+		}
+	}
+
+	stream->streaming.cur_clock_value = init_clock_value;
+	ret = bt_ctfser_open_packet(&stream->ctfser);
+	if (ret) {
+		/* bt_ctfser_open_packet() logs errors */
+		ret = -1;
+		goto end;
+	}
+
+	if (stream->packet_header) {
+		BT_LOGT_STR("Serializing packet header field (initial).");
+		ret = bt_ctf_field_serialize_recursive(stream->packet_header,
+			&stream->ctfser, native_byte_order);
+		if (ret) {
+			BT_LOGW("Cannot serialize stream's packet header field: "
+				"field-addr=%p", stream->packet_header);
+			goto end;
+		}
+	}
+
+	if (stream->packet_context) {
+		/* Save packet context's position to overwrite it later */
+		stream->streaming.packet_context_offset_bits =
+			bt_ctfser_get_offset_in_current_packet_bits(
+				&stream->ctfser);
+		BT_LOGT_STR("Serializing packet context field (initial).");
+		ret = bt_ctf_field_serialize_recursive(stream->packet_context,
+			&stream->ctfser, native_byte_order);
+		if (ret) {
+			BT_LOGW("Cannot serialize stream's packet context field: "
+				"field-addr=%p", stream->packet_context);
+			goto end;
+		}
+	}
+
+	stream->streaming.packet_is_open = true;
+
+end:
+	if (ret) {
+		reset_packet_context_auto_fields(stream);
+	}
+
+	bt_ctf_object_put_ref(ts_begin_field);
+	bt_ctf_object_put_ref(ts_end_field);
+	return ret;
+}
+
+/*
+ * Closes the packet opened by streaming_open_packet(), rewriting its
+ * context now that its sizes and final timestamp are known.
+ */
+static
+int streaming_close_packet(struct bt_ctf_stream *stream)
+{
+	int ret = 0;
+	struct bt_ctf_trace *trace;
+	struct bt_ctf_field *field = NULL;
+	enum bt_ctf_byte_order native_byte_order;
+	uint64_t packet_size_bits;
+	uint64_t content_size_bits;
+
+	BT_ASSERT_DBG(stream->streaming.packet_is_open);
+	trace = BT_CTF_FROM_COMMON(bt_ctf_stream_class_common_borrow_trace(
+		stream->common.stream_class));
+	BT_ASSERT_DBG(trace);
+	native_byte_order = bt_ctf_trace_get_native_byte_order(trace);
+	content_size_bits = bt_ctfser_get_offset_in_current_packet_bits(
+		&stream->ctfser);
+
+	/* Set packet size; make it a multiple of 8 */
+	packet_size_bits = (content_size_bits + 7) & ~UINT64_C(7);
+
+	if (stream->packet_context) {
+		field = bt_ctf_field_structure_get_field_by_name(
+			stream->packet_context, "content_size");
+		if (!field && content_size_bits != packet_size_bits) {
+			BT_LOGW("Stream's packet context's `content_size` field is missing, "
+				"but current packet's content size is not equal to its packet size: "
+				"content-size=%" PRIu64 ", "
+				"packet-size=%" PRIu64,
+				content_size_bits, packet_size_bits);
+			ret = -1;
+			goto end;
+		}
+
+		BT_CTF_OBJECT_PUT_REF_AND_RESET(field);
+
+		if (stream->streaming.set_ts_end) {
+			field = bt_ctf_field_structure_get_field_by_name(
+				stream->packet_context, "timestamp_end");
+			BT_ASSERT_DBG(field);
+			ret = set_integer_field_value(field,
+				stream->streaming.cur_clock_value);
+			BT_ASSERT_DBG(ret == 0);
+			stream->last_ts_end = stream->streaming.cur_clock_value;
+			BT_CTF_OBJECT_PUT_REF_AND_RESET(field);
+		} else {
+			uint64_t ts_end = stream->streaming.cur_clock_value;
+
+			field = bt_ctf_field_structure_get_field_by_name(
+				stream->packet_context, "timestamp_end");
+			if (field) {
+				ret = bt_ctf_field_integer_unsigned_get_value(
+					field, &ts_end);
+				BT_ASSERT_DBG(ret == 0);
+
+				if (ts_end < stream->streaming.cur_clock_value) {
+					BT_LOGW("Packet's final timestamp is less than "
+						"computed packet's final timestamp: "
+						"stream-addr=%p, stream-name=\"%s\", "
+						"cur-packet-ts-end=%" PRIu64 ", "
+						"computed-packet-ts-end=%" PRIu64,
+						stream, bt_ctf_stream_get_name(stream),
+						ts_end,
+						stream->streaming.cur_clock_value);
+					ret = -1;
+					goto end;
+				}
+			}
+
+			stream->last_ts_end = ts_end;
+			BT_CTF_OBJECT_PUT_REF_AND_RESET(field);
+		}
+
+		bt_ctfser_set_offset_in_current_packet_bits(&stream->ctfser,
+			stream->streaming.packet_context_offset_bits);
+		ret = auto_populate_packet_context(stream, false,
+			packet_size_bits, content_size_bits);
+		if (ret) {
+			BT_LOGW_STR("Cannot automatically populate the stream's packet context field.");
+			ret = -1;
+			goto end;
+		}
+
+		BT_LOGT("Rewriting (serializing) packet context field.");
+		ret = bt_ctf_field_serialize_recursive(stream->packet_context,
+			&stream->ctfser, native_byte_order);
+		if (ret) {
+			BT_LOGW("Cannot serialize stream's packet context field: "
+				"field-addr=%p", stream->packet_context);
+			goto end;
+		}
+	} else {
+		stream->last_ts_end = stream->streaming.cur_clock_value;
+	}
+
+	stream->flushed_packet_count++;
+	bt_ctfser_close_current_packet(&stream->ctfser, packet_size_bits / 8);
+	BT_LOGT("Closed stream's current packet: "
+		"content-size=%" PRIu64 ", packet-size=%" PRIu64,
+		content_size_bits, packet_size_bits);
+
+end:
+	/*
+	 * Whatever happens, the packet is not open anymore: a failure
+	 * leaves it incomplete, like a failing bt_ctf_stream_flush().
+	 */
+	stream->streaming.packet_is_open = false;
+	reset_packet_context_auto_fields(stream);
+	bt_ctf_object_put_ref(field);
+	return ret;
+}
+
+struct bt_ctf_event *bt_ctf_stream_get_event_template(
+		struct bt_ctf_stream *stream,
+		struct bt_ctf_event_class *event_class)
+{
+	struct bt_ctf_event *event = NULL;
+
+	if (!stream) {
+		BT_LOGW_STR("Invalid parameter: stream is NULL.");
+		goto end;
+	}
+
+	if (!event_class) {
+		BT_LOGW_STR("Invalid parameter: event class is NULL.");
+		goto end;
+	}
+
+	if (bt_ctf_event_class_common_borrow_stream_class(
+			BT_CTF_TO_COMMON(event_class)) !=
+			stream->common.stream_class) {
+		BT_LOGW("Invalid parameter: event class is not part of the stream's class: "
+			"stream-addr=%p, stream-name=\"%s\", "
+			"event-class-addr=%p, event-class-name=\"%s\"",
+			stream, bt_ctf_stream_get_name(stream), event_class,
+			bt_ctf_event_class_get_name(event_class));
+		goto end;
+	}
+
+	event = g_hash_table_lookup(stream->streaming.event_templates,
+		event_class);
+	if (!event) {
+		event = bt_ctf_event_create(event_class);
+		if (!event) {
+			BT_LOGW("Cannot create event template: "
+				"stream-addr=%p, stream-name=\"%s\", "
+				"event-class-addr=%p, event-class-name=\"%s\"",
+				stream, bt_ctf_stream_get_name(stream),
+				event_class,
+				bt_ctf_event_class_get_name(event_class));
+			goto end;
+		}
+
+		g_hash_table_insert(stream->streaming.event_templates,
+			event_class, event);
+		BT_LOGD("Created event template: "
+			"stream-addr=%p, stream-name=\"%s\", event-addr=%p, "
+			"event-class-name=\"%s\"",
+			stream, bt_ctf_stream_get_name(stream), event,
+			bt_ctf_event_class_get_name(event_class));
+	}
+
+	bt_ctf_object_get_ref(event);
+
+end:
+	return event;
+}
+
+int bt_ctf_stream_write_event(struct bt_ctf_stream *stream,
+		struct bt_ctf_event *event)
+{
+	int ret = 0;
+	struct bt_ctf_trace *trace;
+	enum bt_ctf_byte_order native_byte_order;
+
+	if (!stream) {
+		BT_LOGW_STR("Invalid parameter: stream is NULL.");
+		ret = -1;
+		goto end;
+	}
+
+	if (!event) {
+		BT_LOGW_STR("Invalid parameter: event is NULL.");
+		ret = -1;
+		goto end;
+	}
+
+	if (event->common.base.parent || event->common.frozen) {
+		BT_LOGW("Invalid parameter: event is already appended to a stream: "
+			"stream-addr=%p, stream-name=\"%s\", event-addr=%p",
+			stream, bt_ctf_stream_get_name(stream), event);
+		ret = -1;
+		goto end;
+	}
+
+	if (bt_ctf_event_class_common_borrow_stream_class(
+			event->common.class) != stream->common.stream_class) {
+		BT_LOGW("Invalid parameter: event's class is not part of the stream's class: "
+			"stream-addr=%p, stream-name=\"%s\", event-addr=%p",
+			stream, bt_ctf_stream_get_name(stream), event);
+		ret = -1;
+		goto end;
+	}
+
+	if (!stream->streaming.packet_is_open) {
+		ret = streaming_open_packet(stream);
+		if (ret) {
+			/* streaming_open_packet() logs errors */
+			goto end;
+		}
+	}
+
+	ret = auto_populate_event_header(stream, event);
+	if (ret) {
+		/* auto_populate_event_header() reports errors */
+		goto end;
+	}
+
+	BT_CTF_ASSERT_PRE(bt_ctf_event_common_validate(BT_CTF_TO_COMMON(event)) == 0,
+		"Invalid event: event-addr=%p", event);
+
+	ret = visit_event_update_clock_value(event,
+		&stream->streaming.cur_clock_value);
+	if (ret) {
+		/* visit_event_update_clock_value() logs errors */
+		goto end;
+	}
+
+	trace = BT_CTF_FROM_COMMON(bt_ctf_stream_class_common_borrow_trace(
+		stream->common.stream_class));
+	native_byte_order = bt_ctf_trace_get_native_byte_order(trace);
+
+	if (event->common.header_field) {
+		ret = bt_ctf_field_serialize_recursive(
+			(void *) event->common.header_field->field,
+			&stream->ctfser, native_byte_order);
+		if (ret) {
+			BT_LOGW("Cannot serialize event's header field: "
+				"field-addr=%p",
+				event->common.header_field->field);
+			goto end;
+		}
+
+		/*
+		 * Reset the header so that its `timestamp` field is
+		 * automatically set again the next time this event (a
+		 * template, typically) is written.
+		 */
+		_bt_ctf_field_common_reset_recursive(
+			(void *) event->common.header_field->field);
+	}
+
+	if (event->common.stream_event_context_field) {
+		ret = bt_ctf_field_serialize_recursive(
+			(void *) event->common.stream_event_context_field,
+			&stream->ctfser, native_byte_order);
+		if (ret) {
+			BT_LOGW("Cannot serialize event's stream event context field: "
+				"field-addr=%p",
+				event->common.stream_event_context_field);
+			goto end;
+		}
+	}
+
+	ret = bt_ctf_event_serialize(event, &stream->ctfser,
+		native_byte_order);
+	if (ret) {
+		/* bt_ctf_event_serialize() logs errors */
+		goto end;
+	}
+
+	if (stream->streaming.max_packet_size > 0 &&
+			bt_ctfser_get_offset_in_current_packet_bits(
+				&stream->ctfser) / 8 >=
+			stream->streaming.max_packet_size) {
+		ret = streaming_close_packet(stream);
+	}
+
+end:
+	return ret;
+}
+
+int bt_ctf_stream_set_max_packet_size(struct bt_ctf_stream *stream,
+		uint64_t max_packet_size)
+{
+	int ret = 0;
+
+	if (!stream) {
+		BT_LOGW_STR("Invalid parameter: stream is NULL.");
+		ret = -1;
+		goto end;
+	}
+
+	stream->streaming.max_packet_size = max_packet_size;
+	BT_LOGT("Set stream's maximum packet size: "
+		"stream-addr=%p, stream-name=\"%s\", size=%" PRIu64,
+		stream, bt_ctf_stream_get_name(stream), max_packet_size);
+
+end:
+	return ret;
+}
+
 static
 void bt_ctf_stream_destroy(struct bt_ctf_object *obj)
 {
@@ -1857,6 +2358,24 @@ void bt_ctf_stream_destroy(struct bt_ctf_object *obj)
 	BT_LOGD("Destroying CTF writer stream object: addr=%p, name=\"%s\"",
 		stream, bt_ctf_stream_get_name(stream));
 
+	if (stream->streaming.packet_is_open) {
+		/*
+		 * The events of the current packet are already
+		 * serialized: close it instead of losing them.
+		 */
+		BT_LOGD_STR("Closing stream's current packet.");
+		if (streaming_close_packet(stream)) {
+			BT_LOGW("Cannot close stream's current packet: "
+				"addr=%p, name=\"%s\"",
+				stream, bt_ctf_stream_get_name(stream));
+		}
+	}
+
+	if (stream->streaming.event_templates) {
+		BT_LOGD_STR("Putting event templates.");
+		g_hash_table_destroy(stream->streaming.event_templates);
+	}
+
 	bt_ctf_stream_common_finalize(BT_CTF_TO_COMMON(stream));
 	bt_ctfser_fini(&stream->ctfser);
 
@@ -32,7 +32,9 @@
 #include "common/macros.h"
 #include <babeltrace2-ctf-writer/stream.h>
 #include "ctfser/ctfser.h"
+#include <stdbool.h>
 #include <stdint.h>
+#include <glib.h>
 
 #include "assert-pre.h"
 #include "object.h"
@@ -98,6 +100,42 @@ struct bt_ctf_stream {
 	unsigned int flushed_packet_count;
 	uint64_t discarded_events;
 	uint64_t last_ts_end;
+
+	/*
+	 * Streaming mode state (see bt_ctf_stream_write_event()): events
+	 * are serialized to the current packet as soon as they are
+	 * written instead of being kept in `events` until the stream is
+	 * flushed.
+	 */
+	struct {
+		/* True if a packet is currently open */
+		bool packet_is_open;
+
+		/* Offset of the packet context in the current packet (bits) */
+		uint64_t packet_context_offset_bits;
+
+		/* Current clock value of the current packet */
+		uint64_t cur_clock_value;
+
+		/*
+		 * True if the packet context's `timestamp_end` field of
+		 * the current packet is set automatically when closing it.
+		 */
+		bool set_ts_end;
+
+		/*
+		 * Content size (bytes) from which the current packet is
+		 * closed automatically, or 0 to only close it when the
+		 * stream is flushed.
+		 */
+		uint64_t max_packet_size;
+
+		/*
+		 * Event class (weak) to event template
+		 * (`struct bt_ctf_event *`, owned by this).
+		 */
+		GHashTable *event_templates;
+	} streaming;
 };
 
 BT_HIDDEN
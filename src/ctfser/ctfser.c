@@ -42,6 +42,31 @@
 #include "ctfser/ctfser.h"
 #include "compat/unistd.h"
 #include "compat/fcntl.h"
+#include "common/zstd-seekable.h"
+
+#ifdef BABELTRACE_HAVE_LIBZSTD
+# include <zstd.h>
+
+struct bt_ctfser_zstd_frame {
+	uint32_t compressed_size;
+	uint32_t decompressed_size;
+};
+
+struct bt_ctfser_zstd {
+	ZSTD_CCtx *cctx;
+	int level;
+
+	/* Current packet's (uncompressed) content */
+	uint8_t *packet_buf;
+
+	/* Compressed packet */
+	uint8_t *comp_buf;
+	size_t comp_buf_size;
+
+	/* Seek table entries (`struct bt_ctfser_zstd_frame`) */
+	GArray *frames;
+};
+#endif /* BABELTRACE_HAVE_LIBZSTD */
 
 static inline
 uint64_t get_packet_size_increment_bytes(struct bt_ctfser *ctfser)
@@ -55,10 +80,224 @@ void mmap_align_ctfser(struct bt_ctfser *ctfser)
 	ctfser->base_mma = mmap_align(ctfser->cur_packet_size_bytes,
 		PROT_READ | PROT_WRITE,
 		MAP_SHARED, ctfser->fd, ctfser->mmap_offset, ctfser->log_level);
+	if (ctfser->base_mma != MAP_FAILED) {
+		ctfser->cur_packet_addr =
+			((uint8_t *) mmap_align_addr(ctfser->base_mma)) +
+			ctfser->mmap_base_offset;
+	}
 }
 
-BT_HIDDEN
-int _bt_ctfser_increase_cur_packet_size(struct bt_ctfser *ctfser)
+#ifdef BABELTRACE_HAVE_LIBZSTD
+
+static
+int write_all(struct bt_ctfser *ctfser, const uint8_t *buf, size_t size)
+{
+	int ret = 0;
+
+	while (size > 0) {
+		ssize_t written = write(ctfser->fd, buf, size);
+
+		if (written < 0) {
+			if (errno == EINTR) {
+				continue;
+			}
+
+			BT_LOGE_ERRNO("Failed to write to stream file",
+				": path=\"%s\", fd=%d, size=%zu",
+				ctfser->path->str, ctfser->fd, size);
+			ret = -1;
+			goto end;
+		}
+
+		buf += written;
+		size -= (size_t) written;
+	}
+
+end:
+	return ret;
+}
+
+/*
+ * Grows the packet buffer so that it contains at least `size` bytes,
+ * zeroing the new bytes (the bit field writing functions expect a
+ * zeroed packet, like a newly allocated region of the stream file).
+ */
+static
+void zstd_grow_packet_buf(struct bt_ctfser *ctfser, uint64_t size)
+{
+	struct bt_ctfser_zstd *zstd = ctfser->zstd;
+	uint64_t old_size = ctfser->cur_packet_size_bytes;
+
+	if (size <= old_size) {
+		return;
+	}
+
+	zstd->packet_buf = g_realloc(zstd->packet_buf, size);
+	memset(zstd->packet_buf + old_size, 0, size - old_size);
+	ctfser->cur_packet_size_bytes = size;
+	ctfser->cur_packet_addr = zstd->packet_buf;
+}
+
+/*
+ * Compresses the previous packet (closed with
+ * bt_ctfser_close_current_packet(), but not written yet) as a single
+ * frame and appends it to the stream file.
+ */
+static
+int zstd_write_prev_packet(struct bt_ctfser *ctfser)
+{
+	struct bt_ctfser_zstd *zstd = ctfser->zstd;
+	struct bt_ctfser_zstd_frame frame;
+	size_t bound;
+	size_t comp_size;
+	int ret = 0;
+
+	if (ctfser->prev_packet_size_bytes == 0) {
+		goto end;
+	}
+
+	if (ctfser->prev_packet_size_bytes > UINT32_MAX) {
+		BT_LOGE("Packet is too large to be compressed: "
+			"path=\"%s\", packet-size-bytes=%" PRIu64,
+			ctfser->path->str, ctfser->prev_packet_size_bytes);
+		ret = -1;
+		goto end;
+	}
+
+	bound = ZSTD_compressBound(ctfser->prev_packet_size_bytes);
+	if (bound > zstd->comp_buf_size) {
+		zstd->comp_buf = g_realloc(zstd->comp_buf, bound);
+		zstd->comp_buf_size = bound;
+	}
+
+	comp_size = ZSTD_compressCCtx(zstd->cctx, zstd->comp_buf,
+		zstd->comp_buf_size, zstd->packet_buf,
+		ctfser->prev_packet_size_bytes, zstd->level);
+	if (ZSTD_isError(comp_size)) {
+		BT_LOGE("Failed to compress packet: path=\"%s\", "
+			"packet-size-bytes=%" PRIu64 ", error=\"%s\"",
+			ctfser->path->str, ctfser->prev_packet_size_bytes,
+			ZSTD_getErrorName(comp_size));
+		ret = -1;
+		goto end;
+	}
+
+	if (comp_size > UINT32_MAX) {
+		BT_LOGE("Compressed packet is too large: "
+			"path=\"%s\", compressed-size-bytes=%zu",
+			ctfser->path->str, comp_size);
+		ret = -1;
+		goto end;
+	}
+
+	ret = write_all(ctfser, zstd->comp_buf, comp_size);
+	if (ret) {
+		goto end;
+	}
+
+	frame.compressed_size = (uint32_t) comp_size;
+	frame.decompressed_size = (uint32_t) ctfser->prev_packet_size_bytes;
+	g_array_append_val(zstd->frames, frame);
+	BT_LOGD("Wrote compressed packet: path=\"%s\", "
+		"packet-size-bytes=%" PRIu64 ", "
+		"compressed-size-bytes=%zu",
+		ctfser->path->str, ctfser->prev_packet_size_bytes,
+		comp_size);
+	ctfser->prev_packet_size_bytes = 0;
+
+end:
+	return ret;
+}
+
+/*
+ * Appends the seek table frame to the stream file.
+ *
+ * Nothing is written if the stream file has no packets: like a
+ * non-compressed stream file, it remains empty.
+ */
+static
+int zstd_write_seek_table(struct bt_ctfser *ctfser)
+{
+	struct bt_ctfser_zstd *zstd = ctfser->zstd;
+	size_t frame_count = zstd->frames->len;
+	size_t size = BT_ZSTD_SKIPPABLE_FRAME_HEADER_SIZE + frame_count * 8 +
+		BT_ZSTD_SEEK_TABLE_FOOTER_SIZE;
+	uint8_t *buf;
+	uint8_t *pos;
+	size_t i;
+	int ret = 0;
+
+	if (frame_count == 0) {
+		goto end;
+	}
+
+	if (frame_count > UINT32_MAX) {
+		BT_LOGE("Too many packets to write a seek table: "
+			"path=\"%s\", packet-count=%zu",
+			ctfser->path->str, frame_count);
+		ret = -1;
+		goto end;
+	}
+
+	buf = g_malloc(size);
+	pos = buf;
+	bt_zstd_seekable_write_u32(pos, BT_ZSTD_SKIPPABLE_FRAME_MAGIC);
+	pos += 4;
+	bt_zstd_seekable_write_u32(pos,
+		(uint32_t) (size - BT_ZSTD_SKIPPABLE_FRAME_HEADER_SIZE));
+	pos += 4;
+
+	for (i = 0; i < frame_count; i++) {
+		struct bt_ctfser_zstd_frame *frame = &g_array_index(
+			zstd->frames, struct bt_ctfser_zstd_frame, i);
+
+		bt_zstd_seekable_write_u32(pos, frame->compressed_size);
+		pos += 4;
+		bt_zstd_seekable_write_u32(pos, frame->decompressed_size);
+		pos += 4;
+	}
+
+	bt_zstd_seekable_write_u32(pos, (uint32_t) frame_count);
+	pos += 4;
+
+	/* No checksums */
+	*pos = 0;
+	pos++;
+	bt_zstd_seekable_write_u32(pos, BT_ZSTD_SEEKABLE_MAGIC);
+	ret = write_all(ctfser, buf, size);
+	g_free(buf);
+
+end:
+	return ret;
+}
+
+static
+void zstd_destroy(struct bt_ctfser_zstd *zstd)
+{
+	if (!zstd) {
+		return;
+	}
+
+	ZSTD_freeCCtx(zstd->cctx);
+	g_free(zstd->packet_buf);
+	g_free(zstd->comp_buf);
+
+	if (zstd->frames) {
+		g_array_free(zstd->frames, TRUE);
+	}
+
+	g_free(zstd);
+}
+
+#endif /* BABELTRACE_HAVE_LIBZSTD */
+
+/*
+ * Increases the size of the current packet by `increment_bytes` bytes,
+ * remapping it once.
+ */
+static
+int increase_cur_packet_size(struct bt_ctfser *ctfser,
+		uint64_t increment_bytes)
 {
 	int ret;
 
@@ -70,6 +309,16 @@ int _bt_ctfser_increase_cur_packet_size(struct bt_ctfser *ctfser)
 		ctfser->path->str, ctfser->fd,
 		ctfser->offset_in_cur_packet_bits,
 		ctfser->cur_packet_size_bytes);
+
+#ifdef BABELTRACE_HAVE_LIBZSTD
+	if (ctfser->zstd) {
+		zstd_grow_packet_buf(ctfser, ctfser->cur_packet_size_bytes +
+			increment_bytes);
+		ret = 0;
+		goto end;
+	}
+#endif
+
 	ret = munmap_align(ctfser->base_mma);
 	if (ret) {
 		BT_LOGE_ERRNO("Failed to perform an aligned memory unmapping",
@@ -77,8 +326,7 @@ int _bt_ctfser_increase_cur_packet_size(struct bt_ctfser *ctfser)
 		goto end;
 	}
 
-	ctfser->cur_packet_size_bytes += get_packet_size_increment_bytes(
-		ctfser);
+	ctfser->cur_packet_size_bytes += increment_bytes;
 
 	do {
 		ret = bt_posix_fallocate(ctfser->fd, ctfser->mmap_offset,
@@ -110,6 +358,48 @@ end:
 	return ret;
 }
 
+BT_HIDDEN
+int _bt_ctfser_increase_cur_packet_size(struct bt_ctfser *ctfser)
+{
+	return increase_cur_packet_size(ctfser,
+		get_packet_size_increment_bytes(ctfser));
+}
+
+BT_HIDDEN
+int bt_ctfser_write_bytes(struct bt_ctfser *ctfser, const void *data,
+		uint64_t size_bytes)
+{
+	int ret = 0;
+	uint64_t size_bits = size_bytes * 8;
+
+	BT_ASSERT(ctfser->offset_in_cur_packet_bits % 8 == 0);
+
+	if (!_bt_ctfser_has_space_left(ctfser, size_bits)) {
+		/*
+		 * Grow the packet once, by a multiple of the usual
+		 * increment, instead of once per increment.
+		 */
+		uint64_t increment_bytes =
+			get_packet_size_increment_bytes(ctfser);
+		uint64_t missing_bytes =
+			_bt_ctfser_offset_bytes(ctfser) + size_bytes -
+			ctfser->cur_packet_size_bytes;
+
+		ret = increase_cur_packet_size(ctfser,
+			(missing_bytes + increment_bytes - 1) /
+				increment_bytes * increment_bytes);
+		if (ret) {
+			goto end;
+		}
+	}
+
+	memcpy(_bt_ctfser_get_addr(ctfser), data, size_bytes);
+	_bt_ctfser_incr_offset(ctfser, size_bits);
+
+end:
+	return ret;
+}
+
 BT_HIDDEN
 int bt_ctfser_init(struct bt_ctfser *ctfser, const char *path, int log_level)
 {
@@ -134,6 +424,54 @@ end:
 	return ret;
 }
 
+BT_HIDDEN
+int bt_ctfser_init_compressed(struct bt_ctfser *ctfser, const char *path,
+		int compression_level, int log_level)
+{
+#ifdef BABELTRACE_HAVE_LIBZSTD
+	struct bt_ctfser_zstd *zstd;
+	int ret;
+
+	ret = bt_ctfser_init(ctfser, path, log_level);
+	if (ret) {
+		goto end;
+	}
+
+	zstd = g_new0(struct bt_ctfser_zstd, 1);
+	ctfser->zstd = zstd;
+	zstd->level = compression_level;
+	zstd->frames = g_array_new(FALSE, FALSE,
+		sizeof(struct bt_ctfser_zstd_frame));
+	zstd->cctx = ZSTD_createCCtx();
+	if (!zstd->cctx) {
+		BT_LOGE("Failed to create a Zstandard compression context: "
+			"path=\"%s\"", path);
+		(void) bt_ctfser_fini(ctfser);
+		ret = -1;
+		goto end;
+	}
+
+end:
+	return ret;
+#else
+	BT_LOG_WRITE_CUR_LVL(BT_LOG_ERROR, log_level, BT_LOG_TAG,
+		"Cannot write compressed stream file: "
+		"Babeltrace was built without Zstandard support: "
+		"path=\"%s\"", path);
+	return -1;
+#endif
+}
+
+BT_HIDDEN
+bool bt_ctfser_compression_is_supported(void)
+{
+#ifdef BABELTRACE_HAVE_LIBZSTD
+	return true;
+#else
+	return false;
+#endif
+}
+
 BT_HIDDEN
 int bt_ctfser_fini(struct bt_ctfser *ctfser)
 {
@@ -143,6 +481,27 @@ int bt_ctfser_fini(struct bt_ctfser *ctfser)
 		goto free_path;
 	}
 
+#ifdef BABELTRACE_HAVE_LIBZSTD
+	if (ctfser->zstd) {
+		/*
+		 * The whole stream file is written with write(): no
+		 * memory map to unmap nor preallocated space to
+		 * truncate.
+		 */
+		ret = zstd_write_prev_packet(ctfser);
+		if (ret) {
+			goto end;
+		}
+
+		ret = zstd_write_seek_table(ctfser);
+		if (ret) {
+			goto end;
+		}
+
+		goto close;
+	}
+#endif
+
 	if (ctfser->base_mma) {
 		/* Unmap old base */
 		ret = munmap_align(ctfser->base_mma);
@@ -172,7 +531,9 @@ int bt_ctfser_fini(struct bt_ctfser *ctfser)
 		goto end;
 	}
 
-
+#ifdef BABELTRACE_HAVE_LIBZSTD
+close:
+#endif
 	ret = close(ctfser->fd);
 	if (ret) {
 		BT_LOGE_ERRNO("Failed to close stream file",
@@ -188,6 +549,11 @@ free_path:
 		ctfser->path = NULL;
 	}
 
+#ifdef BABELTRACE_HAVE_LIBZSTD
+	zstd_destroy(ctfser->zstd);
+	ctfser->zstd = NULL;
+#endif
+
 end:
 	return ret;
 }
@@ -202,6 +568,29 @@ int bt_ctfser_open_packet(struct bt_ctfser *ctfser)
 		ctfser->path->str, ctfser->fd,
 		ctfser->prev_packet_size_bytes);
 
+#ifdef BABELTRACE_HAVE_LIBZSTD
+	if (ctfser->zstd) {
+		ret = zstd_write_prev_packet(ctfser);
+		if (ret) {
+			goto end;
+		}
+
+		/*
+		 * Reuse the packet buffer, keeping its current size
+		 * (at least the initial size of a packet).
+		 */
+		if (ctfser->zstd->packet_buf) {
+			memset(ctfser->zstd->packet_buf, 0,
+				ctfser->cur_packet_size_bytes);
+		}
+
+		zstd_grow_packet_buf(ctfser,
+			get_packet_size_increment_bytes(ctfser));
+		ctfser->offset_in_cur_packet_bits = 0;
+		goto end;
+	}
+#endif
+
 	if (ctfser->base_mma) {
 		/* Unmap old base (previous packet) */
 		ret = munmap_align(ctfser->base_mma);
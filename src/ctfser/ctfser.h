@@ -46,6 +46,8 @@
 #include "compat/bitfield.h"
 #include <glib.h>
 
+struct bt_ctfser_zstd;
+
 struct bt_ctfser {
 	/* Stream file's descriptor */
 	int fd;
@@ -71,6 +73,23 @@ struct bt_ctfser {
 	/* Memory map base address */
 	struct mmap_align *base_mma;
 
+	/*
+	 * Address of the current packet's first byte: within the memory
+	 * map, or within the packet buffer of `zstd`.
+	 */
+	uint8_t *cur_packet_addr;
+
+	/*
+	 * Compression state, or `NULL` to write the packets as is to the
+	 * stream file (memory map).
+	 *
+	 * When set, the current packet is written to a buffer which is
+	 * compressed as a single Zstandard frame when the next packet is
+	 * opened or when the serializer is finalized, and the stream
+	 * file ends with a seek table (see "common/zstd-seekable.h").
+	 */
+	struct bt_ctfser_zstd *zstd;
+
 	/* Stream file's path (for debugging) */
 	GString *path;
 
@@ -87,11 +106,29 @@ BT_HIDDEN
 int bt_ctfser_init(struct bt_ctfser *ctfser, const char *path,
 		int log_level);
 
+/*
+ * Like bt_ctfser_init(), but compresses each packet of the stream file
+ * with Zstandard at the compression level `compression_level`.
+ *
+ * Fails if Babeltrace was built without Zstandard support (see
+ * bt_ctfser_compression_is_supported()).
+ */
+BT_HIDDEN
+int bt_ctfser_init_compressed(struct bt_ctfser *ctfser, const char *path,
+		int compression_level, int log_level);
+
+/*
+ * Returns whether or not bt_ctfser_init_compressed() is available.
+ */
+BT_HIDDEN
+bool bt_ctfser_compression_is_supported(void);
+
 /*
  * Finalizes a CTF serializer.
  *
  * This function truncates the stream file so that there's no extra
- * padding after the last packet, and then closes the file.
+ * padding after the last packet, and then closes the file. For a
+ * compressed stream file, it also writes the seek table.
  */
 BT_HIDDEN
 int bt_ctfser_fini(struct bt_ctfser *ctfser);
@@ -114,6 +151,15 @@ void bt_ctfser_close_current_packet(struct bt_ctfser *ctfser,
 BT_HIDDEN
 int _bt_ctfser_increase_cur_packet_size(struct bt_ctfser *ctfser);
 
+/*
+ * Writes the `size_bytes` bytes of `data` as is at the current offset
+ * (byte-aligned) within the current packet, growing the packet once if
+ * needed.
+ */
+BT_HIDDEN
+int bt_ctfser_write_bytes(struct bt_ctfser *ctfser, const void *data,
+		uint64_t size_bytes);
+
 static inline
 uint64_t _bt_ctfser_cur_packet_size_bits(struct bt_ctfser *ctfser)
 {
@@ -137,8 +183,7 @@ uint8_t *_bt_ctfser_get_addr(struct bt_ctfser *ctfser)
 {
 	/* Only makes sense to get the address after aligning on byte */
 	BT_ASSERT_DBG(ctfser->offset_in_cur_packet_bits % 8 == 0);
-	return ((uint8_t *) mmap_align_addr(ctfser->base_mma)) +
-		ctfser->mmap_base_offset + _bt_ctfser_offset_bytes(ctfser);
+	return ctfser->cur_packet_addr + _bt_ctfser_offset_bytes(ctfser);
 }
 
 static inline
@@ -420,12 +465,10 @@ int bt_ctfser_write_unsigned_int(struct bt_ctfser *ctfser, uint64_t value,
 	}
 
 	if (byte_order == LITTLE_ENDIAN) {
-		bt_bitfield_write_le(mmap_align_addr(ctfser->base_mma) +
-			ctfser->mmap_base_offset, uint8_t,
+		bt_bitfield_write_le(ctfser->cur_packet_addr, uint8_t,
 			ctfser->offset_in_cur_packet_bits, size_bits, value);
 	} else {
-		bt_bitfield_write_be(mmap_align_addr(ctfser->base_mma) +
-			ctfser->mmap_base_offset, uint8_t,
+		bt_bitfield_write_be(ctfser->cur_packet_addr, uint8_t,
 			ctfser->offset_in_cur_packet_bits, size_bits, value);
 	}
 
@@ -465,12 +508,10 @@ int bt_ctfser_write_signed_int(struct bt_ctfser *ctfser, int64_t value,
 	}
 
 	if (byte_order == LITTLE_ENDIAN) {
-		bt_bitfield_write_le(mmap_align_addr(ctfser->base_mma) +
-			ctfser->mmap_base_offset, uint8_t,
+		bt_bitfield_write_le(ctfser->cur_packet_addr, uint8_t,
 			ctfser->offset_in_cur_packet_bits, size_bits, value);
 	} else {
-		bt_bitfield_write_be(mmap_align_addr(ctfser->base_mma) +
-			ctfser->mmap_base_offset, uint8_t,
+		bt_bitfield_write_be(ctfser->cur_packet_addr, uint8_t,
 			ctfser->offset_in_cur_packet_bits, size_bits, value);
 	}
 
@@ -30,7 +30,9 @@
 #define BT_LOG_TAG "FD-CACHE"
 #include "logging/log.h"
 
+#include <errno.h>
 #include <fcntl.h>
+#include <inttypes.h>
 #include <sys/stat.h>
 #include <sys/types.h>
 #include <unistd.h>
@@ -48,6 +50,9 @@ struct fd_handle_internal {
 	struct bt_fd_cache_handle fd_handle;
 	uint64_t ref_count;
 	struct file_key *key;
+
+	/* Link in the cache's idle handle queue, if `ref_count` is 0 */
+	GList idle_link;
 };
 
 static
@@ -108,6 +113,9 @@ int bt_fd_cache_init(struct bt_fd_cache *fdc, int log_level)
 	int ret = 0;
 
 	fdc->log_level = log_level;
+	fdc->open_fd_count = 0;
+	fdc->max_open_fds = BT_FD_CACHE_DEFAULT_MAX_OPEN_FDS;
+	g_queue_init(&fdc->idle_handles);
 	fdc->cache = g_hash_table_new_full(file_key_hash, file_key_equal,
 		file_key_destroy, (GDestroyNotify) fd_cache_handle_internal_destroy);
 	if (!fdc->cache) {
@@ -117,6 +125,61 @@ int bt_fd_cache_init(struct bt_fd_cache *fdc, int log_level)
 	return ret;
 }
 
+/*
+ * Closes the file descriptor of the idle handle `fd_internal` and
+ * removes it from the cache.
+ */
+static
+void evict_idle_handle(struct bt_fd_cache *fdc,
+		struct fd_handle_internal *fd_internal)
+{
+	gboolean ret;
+
+	BT_ASSERT(fd_internal->ref_count == 0);
+	BT_LOGD("Closing idle file descriptor: fd=%d",
+		fd_internal->fd_handle.fd);
+	g_queue_unlink(&fdc->idle_handles, &fd_internal->idle_link);
+
+	if (close(fd_internal->fd_handle.fd) == -1) {
+		BT_LOGE_ERRNO("Failed to close file descriptor",
+			": fd=%d", fd_internal->fd_handle.fd);
+	}
+
+	fd_internal->fd_handle.fd = -1;
+	BT_ASSERT(fdc->open_fd_count > 0);
+	fdc->open_fd_count--;
+	ret = g_hash_table_remove(fdc->cache, fd_internal->key);
+	BT_ASSERT(ret);
+}
+
+/*
+ * Closes idle file descriptors, least recently used first, until at
+ * most `max_open_fds` file descriptors are open or there are no more
+ * idle handles.
+ */
+static
+void evict_idle_handles(struct bt_fd_cache *fdc, uint64_t max_open_fds)
+{
+	while (fdc->open_fd_count > max_open_fds) {
+		GList *link = g_queue_peek_head_link(&fdc->idle_handles);
+
+		if (!link) {
+			break;
+		}
+
+		evict_idle_handle(fdc, link->data);
+	}
+}
+
+BT_HIDDEN
+void bt_fd_cache_set_max_open_fds(struct bt_fd_cache *fdc,
+		uint64_t max_open_fds)
+{
+	BT_ASSERT(max_open_fds > 0);
+	fdc->max_open_fds = max_open_fds;
+	evict_idle_handles(fdc, fdc->max_open_fds);
+}
+
 BT_HIDDEN
 void bt_fd_cache_fini(struct bt_fd_cache *fdc)
 {
@@ -124,6 +187,8 @@ void bt_fd_cache_fini(struct bt_fd_cache *fdc)
 		goto end;
 	}
 
+	evict_idle_handles(fdc, 0);
+
 	/*
 	 * All handle should have been removed for the hashtable at this point.
 	 */
@@ -164,10 +229,32 @@ struct bt_fd_cache_handle *bt_fd_cache_get_handle(struct bt_fd_cache *fdc,
 	fk.ino = statbuf.st_ino;
 
 	fd_internal = g_hash_table_lookup(fdc->cache, &fk);
-	if (!fd_internal) {
+	if (fd_internal && fd_internal->ref_count == 0) {
+		/* Reuse an idle file descriptor. */
+		g_queue_unlink(&fdc->idle_handles, &fd_internal->idle_link);
+	} else if (!fd_internal) {
 		struct file_key *file_key;
 
+		/*
+		 * Make room for the new file descriptor, closing the least
+		 * recently used idle ones if needed.
+		 */
+		evict_idle_handles(fdc, fdc->max_open_fds - 1);
 		fd = open(path, O_RDONLY);
+		if (fd < 0 && (errno == EMFILE || errno == ENFILE) &&
+				!g_queue_is_empty(&fdc->idle_handles)) {
+			/*
+			 * The process (or system) is out of file
+			 * descriptors: close all the idle ones and try
+			 * again.
+			 */
+			BT_LOGD("Too many open files: closing idle file descriptors and retrying: "
+				"path=%s, open-fd-count=%" PRIu64, path,
+				fdc->open_fd_count);
+			evict_idle_handles(fdc, 0);
+			fd = open(path, O_RDONLY);
+		}
+
 		if (fd < 0) {
 			BT_LOGE_ERRNO("Failed to open file", "path=%s", path);
 			goto error;
@@ -180,7 +267,7 @@ struct bt_fd_cache_handle *bt_fd_cache_get_handle(struct bt_fd_cache *fdc,
 		}
 
 		file_key = g_new0(struct file_key, 1);
-		if (!fd_internal) {
+		if (!file_key) {
 			BT_LOGE_STR("Failed to allocate file key.");
 			goto error;
 		}
@@ -190,9 +277,11 @@ struct bt_fd_cache_handle *bt_fd_cache_get_handle(struct bt_fd_cache *fdc,
 		fd_internal->fd_handle.fd = fd;
 		fd_internal->ref_count = 0;
 		fd_internal->key = file_key;
+		fd_internal->idle_link.data = fd_internal;
 
 		/* Insert the newly created fd handle. */
 		g_hash_table_insert(fdc->cache, fd_internal->key, fd_internal);
+		fdc->open_fd_count++;
 	}
 
 	fd_internal->ref_count++;
@@ -211,6 +300,10 @@ error:
 		}
 	}
 
+	if (fd_internal) {
+		fd_internal->fd_handle.fd = -1;
+	}
+
 	fd_cache_handle_internal_destroy(fd_internal);
 	fd_internal = NULL;
 end:
@@ -231,19 +324,16 @@ void bt_fd_cache_put_handle(struct bt_fd_cache *fdc,
 
 	BT_ASSERT(fd_internal->ref_count > 0);
 
-	if (fd_internal->ref_count > 1) {
-		fd_internal->ref_count--;
-	} else {
-		gboolean ret;
-		int close_ret;
+	fd_internal->ref_count--;
 
-		close_ret = close(fd_internal->fd_handle.fd);
-		if (close_ret == -1) {
-			BT_LOGE_ERRNO("Failed to close file descriptor",
-				": fd=%d", fd_internal->fd_handle.fd);
-		}
-		ret = g_hash_table_remove(fdc->cache, fd_internal->key);
-		BT_ASSERT(ret);
+	if (fd_internal->ref_count == 0) {
+		/*
+		 * Keep the file descriptor open as the most recently used
+		 * idle one: it is closed when the cache needs room.
+		 */
+		g_queue_push_tail_link(&fdc->idle_handles,
+			&fd_internal->idle_link);
+		evict_idle_handles(fdc, fdc->max_open_fds);
 	}
 
 end:
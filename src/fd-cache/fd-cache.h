@@ -28,8 +28,16 @@
  * SOFTWARE.
  */
 
+#include <stdint.h>
+#include <glib.h>
 #include "common/macros.h"
 
+/*
+ * Default maximum number of file descriptors a cache keeps open at
+ * the same time.
+ */
+#define BT_FD_CACHE_DEFAULT_MAX_OPEN_FDS	128
+
 struct bt_fd_cache_handle {
 	int fd;
 };
@@ -37,6 +45,24 @@ struct bt_fd_cache_handle {
 struct bt_fd_cache {
 	int log_level;
 	GHashTable *cache;
+
+	/*
+	 * Handles which are not referenced anymore but of which the file
+	 * descriptor is kept open in case they are requested again, least
+	 * recently used first. Weak: the handles belong to `cache`.
+	 */
+	GQueue idle_handles;
+
+	/* Number of file descriptors currently open through this cache */
+	uint64_t open_fd_count;
+
+	/*
+	 * Maximum number of open file descriptors. Idle handles are
+	 * closed, least recently used first, to stay within this limit.
+	 * Handles which are still referenced are never closed, so the
+	 * limit can be exceeded temporarily if they are all in use.
+	 */
+	uint64_t max_open_fds;
 };
 
 static inline
@@ -51,6 +77,15 @@ int bt_fd_cache_init(struct bt_fd_cache *fdc, int log_level);
 BT_HIDDEN
 void bt_fd_cache_fini(struct bt_fd_cache *fdc);
 
+/*
+ * Sets the maximum number of file descriptors `fdc` keeps open at the
+ * same time to `max_open_fds` (greater than 0), closing idle file
+ * descriptors immediately if needed.
+ */
+BT_HIDDEN
+void bt_fd_cache_set_max_open_fds(struct bt_fd_cache *fdc,
+		uint64_t max_open_fds);
+
 BT_HIDDEN
 struct bt_fd_cache_handle *bt_fd_cache_get_handle(struct bt_fd_cache *fdc,
 		const char *path);
@@ -33,6 +33,7 @@
 #include <babeltrace2/graph/graph.h>
 #include "common/macros.h"
 #include "compat/compiler.h"
+#include "compat/time.h"
 #include <babeltrace2/types.h>
 #include <babeltrace2/value.h>
 #include "lib/value.h"
@@ -47,6 +48,7 @@
 #include "connection.h"
 #include "graph.h"
 #include "message/iterator.h"
+#include "message/message.h"
 #include "port.h"
 #include "lib/func-status.h"
 
@@ -612,6 +614,124 @@ bt_logging_level bt_component_get_logging_level(
 	return component->log_level;
 }
 
+/* Innermost measured method call of the current thread */
+static __thread struct bt_component_statistics_call *cur_stats_call;
+
+BT_HIDDEN
+void bt_component_statistics_begin_call(
+		struct bt_component_statistics_call *call)
+{
+	call->child_time_ns = 0;
+	call->parent = cur_stats_call;
+	cur_stats_call = call;
+	call->begin_ns = bt_get_monotonic_time_ns();
+}
+
+static inline
+unsigned int msg_type_index(enum bt_message_type type)
+{
+	unsigned int index = 0;
+
+	while (!((unsigned int) type & (1U << index))) {
+		index++;
+	}
+
+	BT_ASSERT_DBG(index < BT_COMPONENT_STATISTICS_MSG_TYPE_COUNT);
+	return index;
+}
+
+BT_HIDDEN
+void bt_component_statistics_end_call(struct bt_component *comp,
+		struct bt_component_statistics_call *call, int status,
+		const struct bt_message * const *msgs, uint64_t msg_count)
+{
+	struct bt_component_statistics *stats = &comp->stats;
+	uint64_t elapsed_ns = bt_get_monotonic_time_ns() - call->begin_ns;
+	uint64_t i;
+
+	BT_ASSERT_DBG(cur_stats_call == call);
+	cur_stats_call = call->parent;
+
+	if (call->parent) {
+		call->parent->child_time_ns += elapsed_ns;
+	}
+
+	stats->method_calls++;
+	stats->total_time_ns += elapsed_ns;
+	stats->self_time_ns += elapsed_ns - call->child_time_ns;
+
+	if (status == BT_FUNC_STATUS_AGAIN) {
+		stats->again_statuses++;
+	}
+
+	if (status != BT_FUNC_STATUS_OK || msg_count == 0) {
+		goto end;
+	}
+
+	stats->messages += msg_count;
+
+	if (msg_count > stats->max_batch_size) {
+		stats->max_batch_size = msg_count;
+	}
+
+	for (i = 0; i < msg_count; i++) {
+		stats->messages_by_type[msg_type_index(msgs[i]->type)]++;
+	}
+
+end:
+	return;
+}
+
+uint64_t bt_component_get_statistics_counter(
+		const struct bt_component *component,
+		enum bt_component_statistics_counter counter)
+{
+	uint64_t value = 0;
+
+	BT_ASSERT_PRE_DEV_NON_NULL(component, "Component");
+	BT_ASSERT_PRE_DEV(counter >= BT_COMPONENT_STATISTICS_COUNTER_METHOD_CALLS &&
+		counter <= BT_COMPONENT_STATISTICS_COUNTER_SELF_TIME_NS,
+		"Invalid statistics counter: counter=%d", counter);
+
+	switch (counter) {
+	case BT_COMPONENT_STATISTICS_COUNTER_METHOD_CALLS:
+		value = component->stats.method_calls;
+		break;
+	case BT_COMPONENT_STATISTICS_COUNTER_AGAIN_STATUSES:
+		value = component->stats.again_statuses;
+		break;
+	case BT_COMPONENT_STATISTICS_COUNTER_MESSAGES:
+		value = component->stats.messages;
+		break;
+	case BT_COMPONENT_STATISTICS_COUNTER_MAX_BATCH_SIZE:
+		value = component->stats.max_batch_size;
+		break;
+	case BT_COMPONENT_STATISTICS_COUNTER_TOTAL_TIME_NS:
+		value = component->stats.total_time_ns;
+		break;
+	case BT_COMPONENT_STATISTICS_COUNTER_SELF_TIME_NS:
+		value = component->stats.self_time_ns;
+		break;
+	default:
+		bt_common_abort();
+	}
+
+	return value;
+}
+
+uint64_t bt_component_get_statistics_message_count(
+		const struct bt_component *component,
+		enum bt_message_type message_type)
+{
+	BT_ASSERT_PRE_DEV_NON_NULL(component, "Component");
+	BT_ASSERT_PRE_DEV(message_type != 0 &&
+		(message_type & (message_type - 1)) == 0 &&
+		message_type < (1 << BT_COMPONENT_STATISTICS_MSG_TYPE_COUNT),
+		"Invalid message type: type=%d", message_type);
+	return component->stats.messages_by_type[
+		msg_type_index(message_type)];
+}
+
 uint64_t bt_self_component_get_graph_mip_version(
 		bt_self_component *self_component)
 {
@@ -48,6 +48,38 @@ struct bt_component_destroy_listener {
 
 struct bt_graph;
 
+/* Number of message types (see `bt_message_type`) */
+#define BT_COMPONENT_STATISTICS_MSG_TYPE_COUNT	8
+
+/* See `bt_component_statistics_counter` */
+struct bt_component_statistics {
+	uint64_t method_calls;
+	uint64_t again_statuses;
+	uint64_t messages;
+
+	/* Indexed by the position of the `bt_message_type` bit */
+	uint64_t messages_by_type[BT_COMPONENT_STATISTICS_MSG_TYPE_COUNT];
+
+	uint64_t max_batch_size;
+	uint64_t total_time_ns;
+	uint64_t self_time_ns;
+};
+
+/*
+ * Method call being measured, between
+ * bt_component_statistics_begin_call() and
+ * bt_component_statistics_end_call().
+ */
+struct bt_component_statistics_call {
+	uint64_t begin_ns;
+
+	/* Time spent in the measured calls made during this one */
+	uint64_t child_time_ns;
+
+	/* Enclosing measured call of the same thread, or `NULL` */
+	struct bt_component_statistics_call *parent;
+};
+
 struct bt_component {
 	struct bt_object base;
 	struct bt_component_class *class;
@@ -71,6 +103,9 @@ struct bt_component {
 	GArray *destroy_listeners;
 
 	bool initialized;
+
+	/* Maintained by the graph while it runs */
+	struct bt_component_statistics stats;
 };
 
 static inline
@@ -80,6 +115,20 @@ struct bt_graph *bt_component_borrow_graph(struct bt_component *comp)
 	return (void *) bt_object_borrow_parent(&comp->base);
 }
 
+BT_HIDDEN
+void bt_component_statistics_begin_call(
+		struct bt_component_statistics_call *call);
+
+/*
+ * Ends the call `call` to a method of `comp` which returned `status`
+ * and, for a message iterator's "next" method, the `msg_count`
+ * messages `msgs`.
+ */
+BT_HIDDEN
+void bt_component_statistics_end_call(struct bt_component *comp,
+		struct bt_component_statistics_call *call, int status,
+		const struct bt_message * const *msgs, uint64_t msg_count);
+
 BT_HIDDEN
 int bt_component_create(struct bt_component_class *component_class,
 		const char *name, bt_logging_level log_level,
@@ -35,7 +35,10 @@
 #include "common/common.h"
 #include <babeltrace2/types.h>
 #include <babeltrace2/value.h>
+#include "lib/self-trace.h"
 #include "lib/value.h"
+#include <errno.h>
+#include <inttypes.h>
 #include <unistd.h>
 #include <stdbool.h>
 #include <glib.h>
@@ -129,6 +132,11 @@ void destroy_graph(struct bt_object *obj)
 
 	BT_OBJECT_PUT_REF_AND_RESET(graph->default_interrupter);
 
+	if (graph->wait.poll_fds) {
+		g_array_free(graph->wait.poll_fds, TRUE);
+		graph->wait.poll_fds = NULL;
+	}
+
 	if (graph->sinks_to_consume) {
 		g_queue_free(graph->sinks_to_consume);
 		graph->sinks_to_consume = NULL;
@@ -268,6 +276,13 @@ struct bt_graph *bt_graph_create(uint64_t mip_version)
 	}
 
 	bt_graph_add_interrupter(graph, graph->default_interrupter);
+	graph->wait.poll_fds = g_array_new(FALSE, FALSE, sizeof(GPollFD));
+	if (!graph->wait.poll_fds) {
+		BT_LIB_LOGE_APPEND_CAUSE("Failed to allocate one GArray.");
+		goto error;
+	}
+
+	graph->wait.deadline_us = INT64_MAX;
 	ret = bt_object_pool_initialize(&graph->event_msg_pool,
 		(bt_object_pool_new_object_func) bt_message_event_new,
 		(bt_object_pool_destroy_object_func) destroy_message_event,
@@ -448,12 +463,35 @@ int consume_graph_sink(struct bt_component_sink *comp)
 {
 	enum bt_component_class_sink_consume_method_status consume_status;
 	struct bt_component_class_sink *sink_class = NULL;
+	struct bt_component_statistics_call stats_call;
+	bool statistics_enabled;
 
 	BT_ASSERT_DBG(comp);
+	statistics_enabled = bt_component_borrow_graph(
+		(void *) comp)->statistics_enabled;
 	sink_class = (void *) comp->parent.class;
 	BT_ASSERT_DBG(sink_class->methods.consume);
 	BT_LIB_LOGD("Calling user's consume method: %!+c", comp);
+
+	if (G_UNLIKELY(bt_self_trace_is_enabled())) {
+		bt_self_trace_sink_consume_begin(comp, comp->parent.name->str);
+	}
+
+	if (G_UNLIKELY(statistics_enabled)) {
+		bt_component_statistics_begin_call(&stats_call);
+	}
+
 	consume_status = sink_class->methods.consume((void *) comp);
+
+	if (G_UNLIKELY(statistics_enabled)) {
+		bt_component_statistics_end_call((void *) comp, &stats_call,
+			consume_status, NULL, 0);
+	}
+
+	if (G_UNLIKELY(bt_self_trace_is_enabled())) {
+		bt_self_trace_sink_consume_end(comp, consume_status);
+	}
+
 	BT_LOGD("User method returned: status=%s",
 		bt_common_func_status_string(consume_status));
 	BT_ASSERT_POST_DEV(consume_status == BT_FUNC_STATUS_OK ||
@@ -575,6 +613,13 @@ end:
 	return status;
 }
 
+static inline
+void reset_wait_conditions(struct bt_graph *graph)
+{
+	g_array_set_size(graph->wait.poll_fds, 0);
+	graph->wait.deadline_us = INT64_MAX;
+}
+
 enum bt_graph_run_once_status bt_graph_run_once(struct bt_graph *graph)
 {
 	enum bt_graph_run_once_status status;
@@ -593,6 +638,7 @@ enum bt_graph_run_once_status bt_graph_run_once(struct bt_graph *graph)
 		goto end;
 	}
 
+	reset_wait_conditions(graph);
 	status = consume_no_check(graph);
 	bt_graph_set_can_consume(graph, true);
 
@@ -618,6 +664,7 @@ enum bt_graph_run_status bt_graph_run(struct bt_graph *graph)
 	}
 
 	BT_LIB_LOGI("Running graph: %!+g", graph);
+	reset_wait_conditions(graph);
 
 	do {
 		/*
@@ -670,6 +717,102 @@ end:
 	return status;
 }
 
+BT_HIDDEN
+void bt_graph_add_wait_fd(struct bt_graph *graph, int fd)
+{
+	GPollFD poll_fd = {
+		.fd = fd,
+		.events = G_IO_IN | G_IO_HUP | G_IO_ERR,
+		.revents = 0,
+	};
+	guint i;
+
+	BT_ASSERT(graph);
+	BT_ASSERT(fd >= 0);
+
+	for (i = 0; i < graph->wait.poll_fds->len; i++) {
+		if (g_array_index(graph->wait.poll_fds, GPollFD, i).fd == fd) {
+			/* Already waiting for this one */
+			goto end;
+		}
+	}
+
+	g_array_append_val(graph->wait.poll_fds, poll_fd);
+	BT_LIB_LOGD("Added file descriptor to wait for: %![graph-]+g, fd=%d",
+		graph, fd);
+
+end:
+	return;
+}
+
+BT_HIDDEN
+void bt_graph_add_wait_timeout(struct bt_graph *graph, uint64_t timeout_us)
+{
+	int64_t deadline_us;
+
+	BT_ASSERT(graph);
+
+	if (timeout_us > (uint64_t) (INT64_MAX - g_get_monotonic_time())) {
+		deadline_us = INT64_MAX;
+	} else {
+		deadline_us = g_get_monotonic_time() + (int64_t) timeout_us;
+	}
+
+	graph->wait.deadline_us = MIN(graph->wait.deadline_us, deadline_us);
+	BT_LIB_LOGD("Added timeout to wait for: %![graph-]+g, "
+		"timeout-us=%" PRIu64, graph, timeout_us);
+}
+
+enum bt_graph_wait_status bt_graph_wait(struct bt_graph *graph,
+		uint64_t max_duration_us)
+{
+	enum bt_graph_wait_status status = BT_FUNC_STATUS_OK;
+	uint64_t duration_us = max_duration_us;
+	gint timeout_ms;
+	gint ret;
+
+	BT_ASSERT_PRE_NO_ERROR();
+	BT_ASSERT_PRE_NON_NULL(graph, "Graph");
+
+	if (graph->wait.deadline_us != INT64_MAX) {
+		int64_t now_us = g_get_monotonic_time();
+
+		if (graph->wait.deadline_us <= now_us) {
+			duration_us = 0;
+		} else {
+			duration_us = MIN(duration_us,
+				(uint64_t) (graph->wait.deadline_us - now_us));
+		}
+	}
+
+	/* Round up: never wake up before the deadline */
+	if (duration_us > (uint64_t) G_MAXINT * 1000) {
+		timeout_ms = G_MAXINT;
+	} else {
+		timeout_ms = (gint) ((duration_us + 999) / 1000);
+	}
+
+	BT_LIB_LOGD("Waiting for graph's message iterators: %![graph-]+g, "
+		"fd-count=%u, timeout-ms=%d", graph,
+		graph->wait.poll_fds->len, timeout_ms);
+
+	if (timeout_ms == 0 && graph->wait.poll_fds->len == 0) {
+		goto end;
+	}
+
+	ret = g_poll((GPollFD *) graph->wait.poll_fds->data,
+		graph->wait.poll_fds->len, timeout_ms);
+	if (ret < 0 && errno != EINTR) {
+		BT_LIB_LOGE_APPEND_CAUSE("Failed to poll file descriptors: "
+			"%![graph-]+g, %s", graph, g_strerror(errno));
+		status = BT_FUNC_STATUS_ERROR;
+		goto end;
+	}
+
+end:
+	return status;
+}
+
 enum bt_graph_add_listener_status
 bt_graph_add_source_component_output_port_added_listener(
 		struct bt_graph *graph,
@@ -1195,6 +1338,16 @@ struct bt_interrupter *bt_graph_borrow_default_interrupter(bt_graph *graph)
 	return graph->default_interrupter;
 }
 
+void bt_graph_enable_statistics(struct bt_graph *graph)
+{
+	BT_ASSERT_PRE_NON_NULL(graph, "Graph");
+	BT_ASSERT_PRE(graph->config_state ==
+		BT_GRAPH_CONFIGURATION_STATE_CONFIGURING,
+		"Graph is already configured: %!+g", graph);
+	graph->statistics_enabled = true;
+	BT_LIB_LOGI("Enabled component statistics: %!+g", graph);
+}
+
 void bt_graph_get_ref(const struct bt_graph *graph)
 {
 	bt_object_get_ref(graph);
@@ -121,6 +121,12 @@ struct bt_graph {
 
 	enum bt_graph_configuration_state config_state;
 
+	/*
+	 * True if the components maintain their statistics (see
+	 * bt_graph_enable_statistics()).
+	 */
+	bool statistics_enabled;
+
 	struct {
 		GArray *source_output_port_added;
 		GArray *filter_output_port_added;
@@ -152,6 +158,22 @@ struct bt_graph {
 	 * array (on destruction).
 	 */
 	GPtrArray *messages;
+
+	/*
+	 * Conditions which message iterators declared, while the graph
+	 * was running, to be woken up by bt_graph_wait(). Reset when the
+	 * graph starts running.
+	 */
+	struct {
+		/* Array of `GPollFD` */
+		GArray *poll_fds;
+
+		/*
+		 * Earliest monotonic time (µs, see g_get_monotonic_time())
+		 * at which to wake up, or INT64_MAX if none.
+		 */
+		int64_t deadline_us;
+	} wait;
 };
 
 static inline
@@ -180,6 +202,12 @@ void bt_graph_add_message(struct bt_graph *graph,
 BT_HIDDEN
 bool bt_graph_is_interrupted(const struct bt_graph *graph);
 
+BT_HIDDEN
+void bt_graph_add_wait_fd(struct bt_graph *graph, int fd);
+
+BT_HIDDEN
+void bt_graph_add_wait_timeout(struct bt_graph *graph, uint64_t timeout_us);
+
 static inline
 const char *bt_graph_configuration_state_string(
 		enum bt_graph_configuration_state state)
@@ -48,6 +48,7 @@
 #include "common/assert.h"
 #include "lib/assert-pre.h"
 #include "lib/assert-post.h"
+#include "lib/self-trace.h"
 #include <stdint.h>
 #include <inttypes.h>
 #include <stdbool.h>
@@ -805,7 +806,19 @@ call_iterator_next_method(
 
 	BT_ASSERT_DBG(iterator->methods.next);
 	BT_LOGD_STR("Calling user's \"next\" method.");
+
+	if (G_UNLIKELY(bt_self_trace_is_enabled())) {
+		bt_self_trace_iterator_next_begin(iterator,
+			iterator->upstream_component->name->str);
+	}
+
 	status = iterator->methods.next(iterator, msgs, capacity, user_count);
+
+	if (G_UNLIKELY(bt_self_trace_is_enabled())) {
+		bt_self_trace_iterator_next_end(iterator, status,
+			status == BT_FUNC_STATUS_OK ? *user_count : 0);
+	}
+
 	BT_LOGD("User method returned: status=%s, msg-count=%" PRIu64,
 		bt_common_func_status_string(status), *user_count);
 
@@ -827,6 +840,7 @@ bt_message_iterator_next(
 		bt_message_array_const *msgs, uint64_t *user_count)
 {
 	enum bt_message_iterator_next_status status = BT_FUNC_STATUS_OK;
+	struct bt_component_statistics_call stats_call;
 
 	BT_ASSERT_PRE_DEV_NO_ERROR();
 	BT_ASSERT_PRE_DEV_NON_NULL(iterator, "Message iterator");
@@ -852,9 +866,20 @@ bt_message_iterator_next(
 	 * and status.
 	 */
 	*user_count = 0;
+
+	if (G_UNLIKELY(iterator->graph->statistics_enabled)) {
+		bt_component_statistics_begin_call(&stats_call);
+	}
+
 	status = (int) call_iterator_next_method(iterator,
 		(void *) iterator->msgs->pdata, MSG_BATCH_SIZE,
 		user_count);
+
+	if (G_UNLIKELY(iterator->graph->statistics_enabled)) {
+		bt_component_statistics_end_call(iterator->upstream_component,
+			&stats_call, status, (void *) iterator->msgs->pdata,
+			*user_count);
+	}
 	BT_LOGD("User method returned: status=%s, msg-count=%" PRIu64,
 		bt_common_func_status_string(status), *user_count);
 	if (status < 0) {
@@ -1938,6 +1963,26 @@ bt_bool bt_self_message_iterator_is_interrupted(
 	return (bt_bool) bt_graph_is_interrupted(iterator->graph);
 }
 
+void bt_self_message_iterator_set_wait_fd(
+		struct bt_self_message_iterator *self_msg_iter, int fd)
+{
+	struct bt_message_iterator *iterator = (void *) self_msg_iter;
+
+	BT_ASSERT_PRE_NON_NULL(iterator, "Message iterator");
+	BT_ASSERT_PRE(fd >= 0, "Invalid file descriptor: fd=%d", fd);
+	bt_graph_add_wait_fd(iterator->graph, fd);
+}
+
+void bt_self_message_iterator_set_wait_timeout(
+		struct bt_self_message_iterator *self_msg_iter,
+		uint64_t timeout_us)
+{
+	struct bt_message_iterator *iterator = (void *) self_msg_iter;
+
+	BT_ASSERT_PRE_NON_NULL(iterator, "Message iterator");
+	bt_graph_add_wait_timeout(iterator->graph, timeout_us);
+}
+
 void bt_message_iterator_get_ref(
 		const struct bt_message_iterator *iterator)
 {
@@ -752,11 +752,13 @@ static inline void format_event(char **buf_ch, bool extended,
 	BUF_APPEND(", %sis-frozen=%d, "
 		"%scommon-context-field-addr=%p, "
 		"%sspecific-context-field-addr=%p, "
-		"%spayload-field-addr=%p, ",
+		"%spayload-field-addr=%p, "
+		"%spayload-field-is-pending=%d, ",
 		PRFIELD(event->frozen),
 		PRFIELD(event->common_context_field),
 		PRFIELD(event->specific_context_field),
-		PRFIELD(event->payload_field));
+		PRFIELD(event->payload_field),
+		PRFIELD((int) event->raw_payload.is_set));
 	BUF_APPEND(", %sevent-class-addr=%p", PRFIELD(event->class));
 
 	if (!event->class) {
@@ -55,6 +55,28 @@ void bt_logging_set_global_level(enum bt_logging_level log_level)
 	bt_lib_log_level = log_level;
 }
 
+/*
+ * Entry points of the asynchronous logging backend (see
+ * `src/logging/log.c`).
+ *
+ * Those functions would normally be BT_HIDDEN, but all the modules
+ * which log (CLI, plugins, Python bindings, and so on) use the single
+ * backend instance of the library through them, so that a single
+ * flusher thread writes all the log lines in order. They are therefore
+ * exposed, but not part of the public ABI.
+ */
+int bt_lib_log_async_is_enabled(void)
+{
+	return bt_log_async_is_enabled();
+}
+
+int bt_lib_log_async_write(int lvl, const char *tag, const char *func,
+		const char *file, unsigned line, const char *text,
+		size_t text_sz)
+{
+	return bt_log_async_write(lvl, tag, func, file, line, text, text_sz);
+}
+
 static
 void __attribute__((constructor)) bt_logging_ctor(void)
 {
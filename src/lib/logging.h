@@ -73,6 +73,18 @@ int bt_lib_log_level;
 void bt_lib_log(const char *func, const char *file, unsigned line,
 		int lvl, const char *tag, const char *fmt, ...);
 
+/*
+ * Asynchronous logging backend entry points, used by the other modules
+ * (see `src/lib/logging.c`).
+ *
+ * Exposed, but not part of the public ABI (see bt_lib_log()).
+ */
+int bt_lib_log_async_is_enabled(void);
+
+int bt_lib_log_async_write(int lvl, const char *tag, const char *func,
+		const char *file, unsigned line, const char *text,
+		size_t text_sz);
+
 #define BT_LIB_LOG_AND_APPEND(_lvl, _fmt, ...)				\
 	do {								\
 		bt_lib_maybe_log_and_append_cause(			\
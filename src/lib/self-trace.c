@@ -0,0 +1,628 @@
+/*
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#define BT_LOG_TAG "LIB/SELF-TRACE"
+#include "lib/logging.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <glib.h>
+#include <glib/gstdio.h>
+#include "common/assert.h"
+#include "common/macros.h"
+#include "compat/endian.h"
+#include "ctfser/ctfser.h"
+
+#include "self-trace.h"
+
+/* Approximate maximum content size of a data stream packet */
+#define PACKET_MAX_CONTENT_SIZE_BYTES	(1024 * 1024)
+
+enum event_class_id {
+	EVENT_CLASS_ID_ITERATOR_NEXT_BEGIN	= 0,
+	EVENT_CLASS_ID_ITERATOR_NEXT_END	= 1,
+	EVENT_CLASS_ID_SINK_CONSUME_BEGIN	= 2,
+	EVENT_CLASS_ID_SINK_CONSUME_END		= 3,
+	EVENT_CLASS_ID_LOG			= 4,
+};
+
+/*
+ * Clock values are microseconds since an arbitrary, monotonic origin
+ * (g_get_monotonic_time()); the clock class's offset maps them to the
+ * real time at initialization.
+ */
+static const char * const metadata_fmt =
+	"/* CTF 1.8 */\n"
+	"\n"
+	"typealias integer { size = 8; align = 8; signed = false; } := uint8_t;\n"
+	"typealias integer { size = 32; align = 8; signed = false; } := uint32_t;\n"
+	"typealias integer { size = 32; align = 8; signed = true; } := int32_t;\n"
+	"typealias integer { size = 64; align = 8; signed = false; } := uint64_t;\n"
+	"\n"
+	"trace {\n"
+	"	major = 1;\n"
+	"	minor = 8;\n"
+	"	byte_order = %s;\n"
+	"	packet.header := struct {\n"
+	"		uint32_t magic;\n"
+	"	};\n"
+	"};\n"
+	"\n"
+	"env {\n"
+	"	domain = \"babeltrace2\";\n"
+	"	tracer_name = \"libbabeltrace2\";\n"
+	"	vpid = %d;\n"
+	"};\n"
+	"\n"
+	"clock {\n"
+	"	name = monotonic;\n"
+	"	description = \"Monotonic clock\";\n"
+	"	freq = 1000000;\n"
+	"	offset_s = %" PRId64 ";\n"
+	"	offset = %" PRId64 ";\n"
+	"	absolute = false;\n"
+	"};\n"
+	"\n"
+	"typealias integer {\n"
+	"	size = 64; align = 8; signed = false;\n"
+	"	map = clock.monotonic.value;\n"
+	"} := uint64_clock_monotonic_t;\n"
+	"\n"
+	"stream {\n"
+	"	packet.context := struct {\n"
+	"		uint64_t packet_size;\n"
+	"		uint64_t content_size;\n"
+	"		uint64_clock_monotonic_t timestamp_begin;\n"
+	"		uint64_clock_monotonic_t timestamp_end;\n"
+	"	};\n"
+	"	event.header := struct {\n"
+	"		uint32_t id;\n"
+	"		uint64_clock_monotonic_t timestamp;\n"
+	"	};\n"
+	"};\n"
+	"\n"
+	"event {\n"
+	"	name = \"iterator_next_begin\";\n"
+	"	id = 0;\n"
+	"	fields := struct {\n"
+	"		uint64_t iterator;\n"
+	"		string component_name;\n"
+	"	};\n"
+	"};\n"
+	"\n"
+	"event {\n"
+	"	name = \"iterator_next_end\";\n"
+	"	id = 1;\n"
+	"	fields := struct {\n"
+	"		uint64_t iterator;\n"
+	"		int32_t status;\n"
+	"		uint64_t msg_count;\n"
+	"	};\n"
+	"};\n"
+	"\n"
+	"event {\n"
+	"	name = \"sink_consume_begin\";\n"
+	"	id = 2;\n"
+	"	fields := struct {\n"
+	"		uint64_t component;\n"
+	"		string component_name;\n"
+	"	};\n"
+	"};\n"
+	"\n"
+	"event {\n"
+	"	name = \"sink_consume_end\";\n"
+	"	id = 3;\n"
+	"	fields := struct {\n"
+	"		uint64_t component;\n"
+	"		int32_t status;\n"
+	"	};\n"
+	"};\n"
+	"\n"
+	"event {\n"
+	"	name = \"log\";\n"
+	"	id = 4;\n"
+	"	fields := struct {\n"
+	"		int32_t level;\n"
+	"		string tag;\n"
+	"		string msg;\n"
+	"	};\n"
+	"};\n";
+
+BT_HIDDEN
+bool bt_self_trace_enabled;
+
+static struct {
+	/* Protects all the members below */
+	GMutex lock;
+
+	struct bt_ctfser ctfser;
+	bool packet_is_open;
+	uint64_t packet_context_offset_bits;
+	uint64_t packet_ts_begin;
+	uint64_t last_ts;
+} self_trace;
+
+/*
+ * True while the current thread writes to the self trace: the
+ * serializer's own log statements must not be recorded.
+ */
+static __thread bool writing;
+
+static
+int write_u32(uint64_t value)
+{
+	return bt_ctfser_write_byte_aligned_unsigned_int(&self_trace.ctfser,
+		value, 8, 32, BYTE_ORDER);
+}
+
+static
+int write_s32(int64_t value)
+{
+	return bt_ctfser_write_byte_aligned_signed_int(&self_trace.ctfser,
+		value, 8, 32, BYTE_ORDER);
+}
+
+static
+int write_u64(uint64_t value)
+{
+	return bt_ctfser_write_byte_aligned_unsigned_int(&self_trace.ctfser,
+		value, 8, 64, BYTE_ORDER);
+}
+
+static
+int write_packet_context(uint64_t size_bits)
+{
+	int ret;
+
+	/* Packet total size and content size */
+	ret = write_u64(size_bits);
+	if (ret) {
+		goto end;
+	}
+
+	ret = write_u64(size_bits);
+	if (ret) {
+		goto end;
+	}
+
+	/* Beginning and end times */
+	ret = write_u64(self_trace.packet_ts_begin);
+	if (ret) {
+		goto end;
+	}
+
+	ret = write_u64(self_trace.last_ts);
+
+end:
+	return ret;
+}
+
+static
+int open_packet(void)
+{
+	int ret;
+
+	BT_ASSERT(!self_trace.packet_is_open);
+	ret = bt_ctfser_open_packet(&self_trace.ctfser);
+	if (ret) {
+		goto end;
+	}
+
+	/* Packet header: magic */
+	ret = write_u32(UINT64_C(0xc1fc1fc1));
+	if (ret) {
+		goto end;
+	}
+
+	/* Save packet context's offset to rewrite it when closing */
+	self_trace.packet_context_offset_bits =
+		bt_ctfser_get_offset_in_current_packet_bits(&self_trace.ctfser);
+	self_trace.packet_ts_begin = self_trace.last_ts;
+	ret = write_packet_context(0);
+	if (ret) {
+		goto end;
+	}
+
+	self_trace.packet_is_open = true;
+
+end:
+	return ret;
+}
+
+static
+int close_packet(void)
+{
+	int ret;
+	uint64_t size_bits;
+
+	BT_ASSERT(self_trace.packet_is_open);
+
+	/* All the fields are byte-aligned */
+	size_bits = bt_ctfser_get_offset_in_current_packet_bits(
+		&self_trace.ctfser);
+	bt_ctfser_set_offset_in_current_packet_bits(&self_trace.ctfser,
+		self_trace.packet_context_offset_bits);
+	ret = write_packet_context(size_bits);
+	if (ret) {
+		goto end;
+	}
+
+	bt_ctfser_close_current_packet(&self_trace.ctfser, size_bits / 8);
+	self_trace.packet_is_open = false;
+
+end:
+	return ret;
+}
+
+/*
+ * Opens a packet if needed and writes the header of an event of which
+ * the class ID is `id`.
+ *
+ * Called with the lock held.
+ */
+static
+int begin_event(enum event_class_id id)
+{
+	int ret = 0;
+	uint64_t ts = (uint64_t) g_get_monotonic_time();
+
+	/* Keep the clock values monotonic within the stream */
+	if (ts > self_trace.last_ts) {
+		self_trace.last_ts = ts;
+	}
+
+	if (self_trace.packet_is_open &&
+			bt_ctfser_get_offset_in_current_packet_bits(
+				&self_trace.ctfser) / 8 >=
+				PACKET_MAX_CONTENT_SIZE_BYTES) {
+		ret = close_packet();
+		if (ret) {
+			goto end;
+		}
+	}
+
+	if (!self_trace.packet_is_open) {
+		ret = open_packet();
+		if (ret) {
+			goto end;
+		}
+	}
+
+	ret = write_u32(id);
+	if (ret) {
+		goto end;
+	}
+
+	ret = write_u64(self_trace.last_ts);
+
+end:
+	return ret;
+}
+
+static
+void lock(void)
+{
+	g_mutex_lock(&self_trace.lock);
+	writing = true;
+}
+
+/*
+ * Unlocks the self trace, disabling self-tracing if `ret` indicates
+ * that writing the last event failed.
+ */
+static
+void unlock(int ret)
+{
+	if (ret) {
+		bt_self_trace_enabled = false;
+	}
+
+	writing = false;
+	g_mutex_unlock(&self_trace.lock);
+
+	if (ret) {
+		BT_LOGW_STR("Cannot write self trace event: disabling self-tracing.");
+	}
+}
+
+BT_HIDDEN
+void bt_self_trace_iterator_next_begin(const void *iterator,
+		const char *comp_name)
+{
+	int ret;
+
+	lock();
+	if (!bt_self_trace_enabled) {
+		ret = 0;
+		goto end;
+	}
+
+	ret = begin_event(EVENT_CLASS_ID_ITERATOR_NEXT_BEGIN);
+	if (ret) {
+		goto end;
+	}
+
+	ret = write_u64((uint64_t) (uintptr_t) iterator);
+	if (ret) {
+		goto end;
+	}
+
+	ret = bt_ctfser_write_string(&self_trace.ctfser, comp_name);
+
+end:
+	unlock(ret);
+}
+
+BT_HIDDEN
+void bt_self_trace_iterator_next_end(const void *iterator, int status,
+		uint64_t msg_count)
+{
+	int ret;
+
+	lock();
+	if (!bt_self_trace_enabled) {
+		ret = 0;
+		goto end;
+	}
+
+	ret = begin_event(EVENT_CLASS_ID_ITERATOR_NEXT_END);
+	if (ret) {
+		goto end;
+	}
+
+	ret = write_u64((uint64_t) (uintptr_t) iterator);
+	if (ret) {
+		goto end;
+	}
+
+	ret = write_s32(status);
+	if (ret) {
+		goto end;
+	}
+
+	ret = write_u64(msg_count);
+
+end:
+	unlock(ret);
+}
+
+BT_HIDDEN
+void bt_self_trace_sink_consume_begin(const void *comp,
+		const char *comp_name)
+{
+	int ret;
+
+	lock();
+	if (!bt_self_trace_enabled) {
+		ret = 0;
+		goto end;
+	}
+
+	ret = begin_event(EVENT_CLASS_ID_SINK_CONSUME_BEGIN);
+	if (ret) {
+		goto end;
+	}
+
+	ret = write_u64((uint64_t) (uintptr_t) comp);
+	if (ret) {
+		goto end;
+	}
+
+	ret = bt_ctfser_write_string(&self_trace.ctfser, comp_name);
+
+end:
+	unlock(ret);
+}
+
+BT_HIDDEN
+void bt_self_trace_sink_consume_end(const void *comp, int status)
+{
+	int ret;
+
+	lock();
+	if (!bt_self_trace_enabled) {
+		ret = 0;
+		goto end;
+	}
+
+	ret = begin_event(EVENT_CLASS_ID_SINK_CONSUME_END);
+	if (ret) {
+		goto end;
+	}
+
+	ret = write_u64((uint64_t) (uintptr_t) comp);
+	if (ret) {
+		goto end;
+	}
+
+	ret = write_s32(status);
+
+end:
+	unlock(ret);
+}
+
+/*
+ * Library's log output callback when log statements are also recorded:
+ * records the log statement and then writes it to the standard error
+ * stream.
+ */
+static
+void log_output_callback(const bt_log_message *msg, void *arg)
+{
+	int ret = 0;
+	char *text = NULL;
+
+	if (writing || !bt_self_trace_enabled) {
+		goto output;
+	}
+
+	text = g_strndup(msg->msg_b, msg->p - msg->msg_b);
+	if (!text) {
+		goto output;
+	}
+
+	lock();
+	if (!bt_self_trace_enabled) {
+		goto end;
+	}
+
+	ret = begin_event(EVENT_CLASS_ID_LOG);
+	if (ret) {
+		goto end;
+	}
+
+	ret = write_s32(msg->lvl);
+	if (ret) {
+		goto end;
+	}
+
+	ret = bt_ctfser_write_string(&self_trace.ctfser,
+		msg->tag ? msg->tag : "");
+	if (ret) {
+		goto end;
+	}
+
+	ret = bt_ctfser_write_string(&self_trace.ctfser, text);
+
+end:
+	unlock(ret);
+
+output:
+	g_free(text);
+	bt_log_out_stderr_callback(msg, arg);
+}
+
+static
+int write_metadata(const char *dir)
+{
+	int ret = 0;
+	gint64 real_time = g_get_real_time();
+	gint64 mono_time = g_get_monotonic_time();
+	gint64 offset_us = real_time - mono_time;
+	gchar *path = g_build_filename(dir, "metadata", NULL);
+	gchar *metadata = NULL;
+	FILE *fp = NULL;
+
+	metadata = g_strdup_printf(metadata_fmt,
+		BYTE_ORDER == LITTLE_ENDIAN ? "le" : "be",
+		(int) getpid(), offset_us / G_USEC_PER_SEC,
+		offset_us % G_USEC_PER_SEC);
+	fp = g_fopen(path, "wb");
+	if (!fp) {
+		BT_LOGE_ERRNO("Cannot open self trace's metadata file",
+			": path=\"%s\"", path);
+		ret = -1;
+		goto end;
+	}
+
+	if (fwrite(metadata, strlen(metadata), 1, fp) != 1) {
+		BT_LOGE_ERRNO("Cannot write self trace's metadata file",
+			": path=\"%s\"", path);
+		ret = -1;
+		goto end;
+	}
+
+end:
+	if (fp && fclose(fp)) {
+		BT_LOGE_ERRNO("Cannot close self trace's metadata file",
+			": path=\"%s\"", path);
+		ret = -1;
+	}
+
+	g_free(metadata);
+	g_free(path);
+	return ret;
+}
+
+static
+void __attribute__((constructor)) bt_self_trace_ctor(void)
+{
+	const char *dir = getenv("LIBBABELTRACE2_SELF_TRACE_DIR");
+	const char *logs = getenv("LIBBABELTRACE2_SELF_TRACE_LOGS");
+	gchar *stream_path = NULL;
+
+	if (!dir || strlen(dir) == 0) {
+		goto end;
+	}
+
+	if (g_mkdir_with_parents(dir, 0755)) {
+		BT_LOGE_ERRNO("Cannot create self trace's directory",
+			": path=\"%s\"", dir);
+		goto end;
+	}
+
+	if (write_metadata(dir)) {
+		goto end;
+	}
+
+	stream_path = g_build_filename(dir, "stream", NULL);
+	if (bt_ctfser_init(&self_trace.ctfser, stream_path,
+			bt_lib_log_level)) {
+		BT_LOGE("Cannot initialize self trace's CTF serializer: "
+			"path=\"%s\"", stream_path);
+		goto end;
+	}
+
+	g_mutex_init(&self_trace.lock);
+	bt_self_trace_enabled = true;
+
+	if (logs && strcmp(logs, "1") == 0) {
+		bt_log_set_output_v(BT_LOG_OUT_STDERR_MASK, NULL,
+			log_output_callback);
+	}
+
+	BT_LOGI("Self-tracing enabled: dir=\"%s\"", dir);
+
+end:
+	g_free(stream_path);
+}
+
+static
+void __attribute__((destructor)) bt_self_trace_dtor(void)
+{
+	int ret = 0;
+
+	if (!bt_self_trace_enabled) {
+		goto end;
+	}
+
+	lock();
+	bt_self_trace_enabled = false;
+
+	if (self_trace.packet_is_open) {
+		ret = close_packet();
+	}
+
+	(void) bt_ctfser_fini(&self_trace.ctfser);
+	writing = false;
+	g_mutex_unlock(&self_trace.lock);
+
+	if (ret) {
+		BT_LOGW_STR("Cannot close self trace's last packet.");
+	}
+
+end:
+	return;
+}
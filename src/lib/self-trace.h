@@ -0,0 +1,64 @@
+#ifndef BABELTRACE_LIB_SELF_TRACE_H
+#define BABELTRACE_LIB_SELF_TRACE_H
+
+/*
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*
+ * Self-tracing: when the `LIBBABELTRACE2_SELF_TRACE_DIR` environment
+ * variable is set, the library writes the begin and end of each call to
+ * a message iterator's "next" method and to a sink component's
+ * "consume" method, and optionally its own log statements, as a CTF 1.8
+ * trace in this directory.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "common/macros.h"
+
+BT_HIDDEN
+extern bool bt_self_trace_enabled;
+
+static inline
+bool bt_self_trace_is_enabled(void)
+{
+	return bt_self_trace_enabled;
+}
+
+/*
+ * `iterator` is only used to identify the message iterator: it's
+ * written as an address.
+ */
+BT_HIDDEN
+void bt_self_trace_iterator_next_begin(const void *iterator,
+		const char *comp_name);
+
+BT_HIDDEN
+void bt_self_trace_iterator_next_end(const void *iterator, int status,
+		uint64_t msg_count);
+
+BT_HIDDEN
+void bt_self_trace_sink_consume_begin(const void *comp,
+		const char *comp_name);
+
+BT_HIDDEN
+void bt_self_trace_sink_consume_end(const void *comp, int status);
+
+#endif /* BABELTRACE_LIB_SELF_TRACE_H */
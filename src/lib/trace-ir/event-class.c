@@ -42,6 +42,7 @@
 #include "event-class.h"
 #include "event.h"
 #include "field-class.h"
+#include "field-path.h"
 #include "field.h"
 #include "resolve-field-path.h"
 #include "stream-class.h"
@@ -75,6 +76,12 @@ void destroy_event_class(struct bt_object *obj)
 	BT_OBJECT_PUT_REF_AND_RESET(event_class->specific_context_fc);
 	BT_LOGD_STR("Putting payload field class.");
 	BT_OBJECT_PUT_REF_AND_RESET(event_class->payload_fc);
+
+	if (event_class->payload_binary_layout.leaves) {
+		g_array_free(event_class->payload_binary_layout.leaves, TRUE);
+		event_class->payload_binary_layout.leaves = NULL;
+	}
+
 	bt_object_pool_finalize(&event_class->event_pool);
 	g_free(obj);
 }
@@ -400,6 +407,13 @@ bt_event_class_set_payload_field_class(
 
 	bt_field_class_make_part_of_trace_class(field_class);
 	bt_object_put_ref(event_class->payload_fc);
+
+	/* A payload field binary layout is specific to a field class */
+	if (event_class->payload_binary_layout.leaves) {
+		g_array_free(event_class->payload_binary_layout.leaves, TRUE);
+		event_class->payload_binary_layout.leaves = NULL;
+	}
+
 	event_class->payload_fc = field_class;
 	bt_object_get_ref_no_null_check(event_class->payload_fc);
 	bt_field_class_freeze(field_class);
@@ -409,6 +423,291 @@ end:
 	return ret;
 }
 
+static
+const struct bt_field_class *borrow_root_field_class(
+		const struct bt_event_class *event_class,
+		enum bt_field_path_scope root_scope)
+{
+	const struct bt_stream_class *stream_class =
+		bt_event_class_borrow_stream_class_inline(event_class);
+
+	switch (root_scope) {
+	case BT_FIELD_PATH_SCOPE_PACKET_CONTEXT:
+		return stream_class->packet_context_fc;
+	case BT_FIELD_PATH_SCOPE_EVENT_COMMON_CONTEXT:
+		return stream_class->event_common_context_fc;
+	case BT_FIELD_PATH_SCOPE_EVENT_SPECIFIC_CONTEXT:
+		return event_class->specific_context_fc;
+	case BT_FIELD_PATH_SCOPE_EVENT_PAYLOAD:
+		return event_class->payload_fc;
+	default:
+		bt_common_abort();
+	}
+}
+
+/*
+ * Appends to `field_path` the items to go from `fc` to its member or
+ * option named `name`, going through the content of any option field
+ * class on the way. Returns the field class of the member or option, or
+ * `NULL` if there's none.
+ */
+static
+const struct bt_field_class *append_named_field_class_items(
+		struct bt_field_path *field_path,
+		const struct bt_field_class *fc, const char *name)
+{
+	const struct bt_field_class_named_field_class_container *container_fc;
+	struct bt_named_field_class *named_fc;
+	struct bt_field_path_item item;
+	gpointer orig_key;
+	gpointer value;
+
+	while (bt_field_class_type_is(fc->type, BT_FIELD_CLASS_TYPE_OPTION)) {
+		item.type = BT_FIELD_PATH_ITEM_TYPE_CURRENT_OPTION_CONTENT;
+		item.index = UINT64_C(-1);
+		bt_field_path_append_item(field_path, &item);
+		fc = ((const struct bt_field_class_option *) fc)->content_fc;
+	}
+
+	if (fc->type != BT_FIELD_CLASS_TYPE_STRUCTURE &&
+			!bt_field_class_type_is(fc->type,
+				BT_FIELD_CLASS_TYPE_VARIANT)) {
+		/* Not a container of named field classes */
+		fc = NULL;
+		goto end;
+	}
+
+	container_fc = (const void *) fc;
+	if (!g_hash_table_lookup_extended(container_fc->name_to_index, name,
+			&orig_key, &value)) {
+		fc = NULL;
+		goto end;
+	}
+
+	item.type = BT_FIELD_PATH_ITEM_TYPE_INDEX;
+	item.index = GPOINTER_TO_UINT(value);
+	bt_field_path_append_item(field_path, &item);
+	named_fc = container_fc->named_fcs->pdata[item.index];
+	fc = named_fc->fc;
+
+end:
+	return fc;
+}
+
+enum bt_event_class_create_field_path_status
+bt_event_class_create_field_path(const struct bt_event_class *event_class,
+		enum bt_field_path_scope root_scope, const char * const *names,
+		uint64_t name_count, const struct bt_field_path **field_path)
+{
+	enum bt_event_class_create_field_path_status status =
+		BT_FUNC_STATUS_OK;
+	const struct bt_field_class *fc;
+	struct bt_field_path *new_field_path = NULL;
+	uint64_t i;
+
+	BT_ASSERT_PRE_NO_ERROR();
+	BT_ASSERT_PRE_NON_NULL(event_class, "Event class");
+	BT_ASSERT_PRE(name_count == 0 || names,
+		"Member names array is NULL: name-count=%" PRIu64, name_count);
+	BT_ASSERT_PRE_NON_NULL(field_path, "Field path (output)");
+	fc = borrow_root_field_class(event_class, root_scope);
+	if (!fc) {
+		BT_LIB_LOGD("Event class has no such root field class: "
+			"%![ec-]+E, scope=%s", event_class,
+			bt_common_scope_string(root_scope));
+		status = BT_FUNC_STATUS_NOT_FOUND;
+		goto end;
+	}
+
+	new_field_path = bt_field_path_create();
+	if (!new_field_path) {
+		BT_LIB_LOGE_APPEND_CAUSE("Failed to create a field path object.");
+		status = BT_FUNC_STATUS_MEMORY_ERROR;
+		goto end;
+	}
+
+	new_field_path->root = root_scope;
+
+	for (i = 0; i < name_count; i++) {
+		BT_ASSERT_PRE(names[i], "Member name #%" PRIu64 " is NULL.", i);
+		fc = append_named_field_class_items(new_field_path, fc,
+			names[i]);
+		if (!fc) {
+			BT_LIB_LOGD("Cannot find member or option: "
+				"%![ec-]+E, scope=%s, name-index=%" PRIu64 ", "
+				"name=\"%s\"", event_class,
+				bt_common_scope_string(root_scope),
+				i, names[i]);
+			BT_OBJECT_PUT_REF_AND_RESET(new_field_path);
+			status = BT_FUNC_STATUS_NOT_FOUND;
+			goto end;
+		}
+	}
+
+	/*
+	 * The returned field path is only valid as long as the field
+	 * classes of `event_class` and of its stream class don't
+	 * change.
+	 */
+	bt_event_class_freeze(event_class);
+	bt_stream_class_freeze(
+		bt_event_class_borrow_stream_class_inline(event_class));
+	BT_LIB_LOGD("Created field path from member names: "
+		"%![ec-]+E, %![fp-]+P", event_class, new_field_path);
+	*field_path = new_field_path;
+
+end:
+	return status;
+}
+
+/*
+ * Appends one `struct bt_event_class_binary_layout_leaf` to `leaves`,
+ * with its size set, for each leaf field class of `fc`, in depth-first
+ * order.
+ *
+ * Returns -1 if `fc` contains a field class which a binary layout
+ * cannot describe.
+ */
+static
+int append_binary_layout_leaves(const struct bt_field_class *fc,
+		GArray *leaves)
+{
+	struct bt_event_class_binary_layout_leaf leaf = { 0 };
+	uint64_t i;
+	int ret = 0;
+
+	switch (fc->type) {
+	case BT_FIELD_CLASS_TYPE_STRUCTURE:
+	{
+		const struct bt_field_class_structure *struct_fc =
+			(const void *) fc;
+
+		for (i = 0; i < struct_fc->common.named_fcs->len; i++) {
+			const struct bt_named_field_class *named_fc =
+				struct_fc->common.named_fcs->pdata[i];
+
+			ret = append_binary_layout_leaves(named_fc->fc, leaves);
+			if (ret) {
+				goto end;
+			}
+		}
+
+		goto end;
+	}
+	case BT_FIELD_CLASS_TYPE_STATIC_ARRAY:
+	{
+		const struct bt_field_class_array_static *array_fc =
+			(const void *) fc;
+
+		for (i = 0; i < array_fc->length; i++) {
+			ret = append_binary_layout_leaves(
+				array_fc->common.element_fc, leaves);
+			if (ret) {
+				goto end;
+			}
+		}
+
+		goto end;
+	}
+	case BT_FIELD_CLASS_TYPE_BIT_ARRAY:
+		leaf.size = ((const struct bt_field_class_bit_array *) fc)->length;
+		break;
+	case BT_FIELD_CLASS_TYPE_SINGLE_PRECISION_REAL:
+		leaf.size = 32;
+		break;
+	case BT_FIELD_CLASS_TYPE_DOUBLE_PRECISION_REAL:
+		leaf.size = 64;
+		break;
+	default:
+		if (!bt_field_class_type_is(fc->type,
+				BT_FIELD_CLASS_TYPE_INTEGER)) {
+			ret = -1;
+			goto end;
+		}
+
+		leaf.size = ((const struct bt_field_class_integer *) fc)->range;
+		break;
+	}
+
+	g_array_append_val(leaves, leaf);
+
+end:
+	return ret;
+}
+
+enum bt_event_class_set_payload_field_binary_layout_status
+bt_event_class_set_payload_field_binary_layout(
+		struct bt_event_class *event_class,
+		enum bt_event_class_binary_layout_byte_order byte_order,
+		const uint64_t *offsets, uint64_t offset_count, uint64_t size)
+{
+	enum bt_event_class_set_payload_field_binary_layout_status status =
+		BT_FUNC_STATUS_OK;
+	GArray *leaves = NULL;
+	uint64_t i;
+	int ret;
+
+	BT_ASSERT_PRE_NO_ERROR();
+	BT_ASSERT_PRE_NON_NULL(event_class, "Event class");
+	BT_ASSERT_PRE_NON_NULL(offsets, "Offsets");
+	BT_ASSERT_PRE_DEV_EVENT_CLASS_HOT(event_class);
+	BT_ASSERT_PRE(event_class->payload_fc,
+		"Event class has no payload field class: %!+E", event_class);
+	leaves = g_array_new(FALSE, FALSE,
+		sizeof(struct bt_event_class_binary_layout_leaf));
+	if (!leaves) {
+		BT_LIB_LOGE_APPEND_CAUSE("Failed to allocate a GArray.");
+		status = BT_FUNC_STATUS_MEMORY_ERROR;
+		goto end;
+	}
+
+	ret = append_binary_layout_leaves(event_class->payload_fc, leaves);
+	BT_ASSERT_PRE(ret == 0,
+		"Payload field class contains a field class which is not a "
+		"structure, static array, integer, real, or bit array "
+		"field class: %!+E", event_class);
+	BT_ASSERT_PRE(leaves->len == offset_count,
+		"Offset count is not the number of leaf fields of a payload "
+		"field: %![ec-]+E, leaf-count=%u, offset-count=%" PRIu64,
+		event_class, leaves->len, offset_count);
+
+	for (i = 0; i < offset_count; i++) {
+		struct bt_event_class_binary_layout_leaf *leaf =
+			&g_array_index(leaves,
+				struct bt_event_class_binary_layout_leaf, i);
+
+		leaf->offset = offsets[i];
+		BT_ASSERT_PRE(leaf->offset <= size &&
+			leaf->size <= size - leaf->offset,
+			"Leaf field value is not within the raw payload: "
+			"%![ec-]+E, leaf-index=%" PRIu64 ", "
+			"leaf-offset=%" PRIu64 ", leaf-size=%" PRIu64 ", "
+			"size=%" PRIu64, event_class, i, leaf->offset,
+			leaf->size, size);
+	}
+
+	if (event_class->payload_binary_layout.leaves) {
+		g_array_free(event_class->payload_binary_layout.leaves, TRUE);
+	}
+
+	event_class->payload_binary_layout.leaves = leaves;
+	leaves = NULL;
+	event_class->payload_binary_layout.byte_order = byte_order;
+	event_class->payload_binary_layout.size = size;
+	BT_LIB_LOGD("Set event class's payload field binary layout: "
+		"%!+E, leaf-count=%" PRIu64 ", byte-order=%s, "
+		"size=%" PRIu64, event_class, offset_count,
+		byte_order == BT_EVENT_CLASS_BINARY_LAYOUT_BYTE_ORDER_BIG_ENDIAN ?
+			"big-endian" : "little-endian", size);
+
+end:
+	if (leaves) {
+		g_array_free(leaves, TRUE);
+	}
+
+	return status;
+}
+
 BT_HIDDEN
 void _bt_event_class_freeze(const struct bt_event_class *event_class)
 {
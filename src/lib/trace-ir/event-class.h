@@ -41,6 +41,14 @@
 
 #include "trace.h"
 
+struct bt_event_class_binary_layout_leaf {
+	/* Offset of the leaf field value within a raw payload (bits) */
+	uint64_t offset;
+
+	/* Size of the leaf field value (bits) */
+	uint64_t size;
+};
+
 struct bt_event_class {
 	struct bt_object base;
 	struct bt_field_class *specific_context_fc;
@@ -66,6 +74,25 @@ struct bt_event_class {
 		const char *value;
 	} emf_uri;
 
+	/*
+	 * Payload field binary layout (see
+	 * bt_event_class_set_payload_field_binary_layout()): `leaves` is
+	 * `NULL` if the event class has none.
+	 */
+	struct {
+		/*
+		 * Array of `struct bt_event_class_binary_layout_leaf`,
+		 * one for each leaf field of a payload field, in
+		 * depth-first order
+		 */
+		GArray *leaves;
+
+		enum bt_event_class_binary_layout_byte_order byte_order;
+
+		/* Size of a raw payload (bits) */
+		uint64_t size;
+	} payload_binary_layout;
+
 	/* Pool of `struct bt_event *` */
 	struct bt_object_pool event_pool;
 
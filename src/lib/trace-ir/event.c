@@ -31,12 +31,16 @@
 #include <babeltrace2/trace-ir/packet.h>
 #include <babeltrace2/trace-ir/trace.h>
 #include "common/assert.h"
+#include "compat/bitfield.h"
 #include "compat/compiler.h"
+#include "lib/func-status.h"
 #include <inttypes.h>
 #include <stdbool.h>
 
 #include "field.h"
 #include "field-class.h"
+#include "field-path.h"
+#include "field-wrapper.h"
 #include "event.h"
 #include "stream-class.h"
 #include "stream.h"
@@ -185,17 +189,362 @@ const struct bt_field *bt_event_borrow_specific_context_field_const(
 	return event->specific_context_field;
 }
 
+static
+void decode_raw_payload_field(struct bt_field *field,
+		const struct bt_event_class *event_class, const uint8_t *buf,
+		uint64_t offset, uint64_t *leaf_index)
+{
+	const struct bt_event_class_binary_layout_leaf *leaf;
+	bool is_big_endian;
+	uint64_t at;
+	uint64_t i;
+
+	switch (field->class->type) {
+	case BT_FIELD_CLASS_TYPE_STRUCTURE:
+	{
+		struct bt_field_structure *struct_field = (void *) field;
+
+		for (i = 0; i < struct_field->fields->len; i++) {
+			decode_raw_payload_field(struct_field->fields->pdata[i],
+				event_class, buf, offset, leaf_index);
+		}
+
+		return;
+	}
+	case BT_FIELD_CLASS_TYPE_STATIC_ARRAY:
+	{
+		struct bt_field_array *array_field = (void *) field;
+
+		for (i = 0; i < array_field->length; i++) {
+			decode_raw_payload_field(array_field->fields->pdata[i],
+				event_class, buf, offset, leaf_index);
+		}
+
+		return;
+	}
+	default:
+		break;
+	}
+
+	BT_ASSERT_DBG(*leaf_index <
+		event_class->payload_binary_layout.leaves->len);
+	leaf = &g_array_index(event_class->payload_binary_layout.leaves,
+		struct bt_event_class_binary_layout_leaf, *leaf_index);
+	(*leaf_index)++;
+	at = offset + leaf->offset;
+	is_big_endian = event_class->payload_binary_layout.byte_order ==
+		BT_EVENT_CLASS_BINARY_LAYOUT_BYTE_ORDER_BIG_ENDIAN;
+
+	switch (field->class->type) {
+	case BT_FIELD_CLASS_TYPE_SINGLE_PRECISION_REAL:
+	{
+		union {
+			uint32_t u;
+			float f;
+		} f32;
+
+		if (is_big_endian) {
+			bt_bitfield_read_be(buf, uint8_t, at, 32, &f32.u);
+		} else {
+			bt_bitfield_read_le(buf, uint8_t, at, 32, &f32.u);
+		}
+
+		((struct bt_field_real *) field)->value = (double) f32.f;
+		break;
+	}
+	case BT_FIELD_CLASS_TYPE_DOUBLE_PRECISION_REAL:
+	{
+		union {
+			uint64_t u;
+			double d;
+		} f64;
+
+		if (is_big_endian) {
+			bt_bitfield_read_be(buf, uint8_t, at, 64, &f64.u);
+		} else {
+			bt_bitfield_read_le(buf, uint8_t, at, 64, &f64.u);
+		}
+
+		((struct bt_field_real *) field)->value = f64.d;
+		break;
+	}
+	case BT_FIELD_CLASS_TYPE_BIT_ARRAY:
+	{
+		uint64_t value;
+
+		if (is_big_endian) {
+			bt_bitfield_read_be(buf, uint8_t, at, leaf->size, &value);
+		} else {
+			bt_bitfield_read_le(buf, uint8_t, at, leaf->size, &value);
+		}
+
+		((struct bt_field_bit_array *) field)->value_as_int = value;
+		break;
+	}
+	default:
+	{
+		struct bt_field_integer *int_field = (void *) field;
+
+		BT_ASSERT_DBG(bt_field_class_type_is(field->class->type,
+			BT_FIELD_CLASS_TYPE_INTEGER));
+
+		if (bt_field_class_type_is(field->class->type,
+				BT_FIELD_CLASS_TYPE_SIGNED_INTEGER)) {
+			int64_t value;
+
+			if (is_big_endian) {
+				bt_bitfield_read_be(buf, uint8_t, at,
+					leaf->size, &value);
+			} else {
+				bt_bitfield_read_le(buf, uint8_t, at,
+					leaf->size, &value);
+			}
+
+			int_field->value.i = value;
+		} else {
+			uint64_t value;
+
+			if (is_big_endian) {
+				bt_bitfield_read_be(buf, uint8_t, at,
+					leaf->size, &value);
+			} else {
+				bt_bitfield_read_le(buf, uint8_t, at,
+					leaf->size, &value);
+			}
+
+			int_field->value.u = value;
+		}
+
+		break;
+	}
+	}
+
+	bt_field_set_single(field, true);
+}
+
+/*
+ * Decodes the payload field of `event` from its raw payload.
+ */
+static
+void decode_raw_payload(const struct bt_event *event)
+{
+	struct bt_event *mut_event = (void *) event;
+	uint64_t leaf_index = 0;
+
+	BT_ASSERT_DBG(event->payload_field);
+	BT_ASSERT_DBG(event->raw_payload.buf);
+	BT_LIB_LOGD("Decoding event's raw payload: %!+e", event);
+	decode_raw_payload_field(event->payload_field, event->class,
+		event->raw_payload.buf->data, event->raw_payload.offset,
+		&leaf_index);
+	BT_ASSERT_DBG(leaf_index ==
+		event->class->payload_binary_layout.leaves->len);
+	mut_event->raw_payload.is_set = false;
+}
+
+static inline
+struct bt_field *borrow_payload_field(const struct bt_event *event)
+{
+	if (G_UNLIKELY(event->raw_payload.is_set)) {
+		decode_raw_payload(event);
+	}
+
+	return event->payload_field;
+}
+
 struct bt_field *bt_event_borrow_payload_field(struct bt_event *event)
 {
 	BT_ASSERT_PRE_DEV_NON_NULL(event, "Event");
-	return event->payload_field;
+	return borrow_payload_field(event);
 }
 
 const struct bt_field *bt_event_borrow_payload_field_const(
 		const struct bt_event *event)
 {
 	BT_ASSERT_PRE_DEV_NON_NULL(event, "Event");
-	return event->payload_field;
+	return borrow_payload_field(event);
+}
+
+enum bt_event_set_raw_payload_status bt_event_set_raw_payload(
+		struct bt_event *event, const void *data, uint64_t offset)
+{
+	const struct bt_event_class *event_class;
+	uint64_t byte_count;
+
+	BT_ASSERT_PRE_DEV_NO_ERROR();
+	BT_ASSERT_PRE_DEV_NON_NULL(event, "Event");
+	BT_ASSERT_PRE_DEV_NON_NULL(data, "Data");
+	BT_ASSERT_PRE_DEV_EVENT_HOT(event);
+	event_class = event->class;
+	BT_ASSERT_PRE_DEV(event_class->payload_binary_layout.leaves,
+		"Event's class has no payload field binary layout: %!+e",
+		event);
+
+	if (G_UNLIKELY(!event->raw_payload.buf)) {
+		event->raw_payload.buf = g_byte_array_new();
+		if (!event->raw_payload.buf) {
+			BT_LIB_LOGE_APPEND_CAUSE(
+				"Failed to allocate a GByteArray.");
+			return BT_FUNC_STATUS_MEMORY_ERROR;
+		}
+	}
+
+	event->raw_payload.offset = offset % 8;
+	byte_count = (event->raw_payload.offset +
+		event_class->payload_binary_layout.size + 7) / 8;
+	g_byte_array_set_size(event->raw_payload.buf, 0);
+	g_byte_array_append(event->raw_payload.buf,
+		(const guint8 *) data + offset / 8, (guint) byte_count);
+	event->raw_payload.is_set = true;
+	return BT_FUNC_STATUS_OK;
+}
+
+static inline
+struct bt_field *borrow_root_field(struct bt_event *event,
+		enum bt_field_path_scope root_scope)
+{
+	struct bt_field *field = NULL;
+
+	switch (root_scope) {
+	case BT_FIELD_PATH_SCOPE_PACKET_CONTEXT:
+		if (event->packet && event->packet->context_field) {
+			field = event->packet->context_field->field;
+		}
+
+		break;
+	case BT_FIELD_PATH_SCOPE_EVENT_COMMON_CONTEXT:
+		field = event->common_context_field;
+		break;
+	case BT_FIELD_PATH_SCOPE_EVENT_SPECIFIC_CONTEXT:
+		field = event->specific_context_field;
+		break;
+	case BT_FIELD_PATH_SCOPE_EVENT_PAYLOAD:
+		field = borrow_payload_field(event);
+		break;
+	default:
+		bt_common_abort();
+	}
+
+	return field;
+}
+
+struct bt_field *bt_event_borrow_field_by_path(struct bt_event *event,
+		const struct bt_field_path *field_path)
+{
+	struct bt_field *field;
+	uint64_t i;
+
+	BT_ASSERT_PRE_DEV_NON_NULL(event, "Event");
+	BT_ASSERT_PRE_DEV_NON_NULL(field_path, "Field path");
+	field = borrow_root_field(event, field_path->root);
+
+	for (i = 0; field && i < field_path->items->len; i++) {
+		const struct bt_field_path_item *item =
+			bt_field_path_borrow_item_by_index_inline(field_path,
+				i);
+
+		switch (item->type) {
+		case BT_FIELD_PATH_ITEM_TYPE_INDEX:
+			if (field->class->type == BT_FIELD_CLASS_TYPE_STRUCTURE) {
+				struct bt_field_structure *struct_field =
+					(void *) field;
+
+				BT_ASSERT_PRE_DEV(item->index <
+					struct_field->fields->len,
+					"Field path item's index is out of "
+					"bounds: %![field-]+f, %![fp-]+P, "
+					"item-index=%" PRIu64,
+					field, field_path, i);
+				field = struct_field->fields->pdata[item->index];
+			} else {
+				struct bt_field_variant *var_field =
+					(void *) field;
+
+				BT_ASSERT_PRE_DEV_FIELD_IS_VARIANT(field,
+					"Field located by field path item");
+
+				/* Another option may be selected */
+				field = var_field->selected_field &&
+					var_field->selected_index ==
+						item->index ?
+					var_field->selected_field : NULL;
+			}
+
+			break;
+		case BT_FIELD_PATH_ITEM_TYPE_CURRENT_OPTION_CONTENT:
+			BT_ASSERT_PRE_DEV_FIELD_IS_OPTION(field,
+				"Field located by field path item");
+
+			/* `NULL` if the option field has no field */
+			field = ((struct bt_field_option *) field)->selected_field;
+			break;
+		default:
+			BT_ASSERT_PRE_DEV(false,
+				"Field path contains an unsupported item: "
+				"%![fp-]+P, item-index=%" PRIu64 ", "
+				"item-type=%s", field_path, i,
+				bt_field_path_item_type_string(item->type));
+			field = NULL;
+			break;
+		}
+	}
+
+	return field;
+}
+
+const struct bt_field *bt_event_borrow_field_by_path_const(
+		const struct bt_event *event,
+		const struct bt_field_path *field_path)
+{
+	return bt_event_borrow_field_by_path((void *) event, field_path);
+}
+
+enum bt_event_get_field_value_by_path_status
+bt_event_get_unsigned_integer_field_value_by_path(
+		const struct bt_event *event,
+		const struct bt_field_path *field_path, uint64_t *value)
+{
+	enum bt_event_get_field_value_by_path_status status =
+		BT_FUNC_STATUS_OK;
+	const struct bt_field *field;
+
+	BT_ASSERT_PRE_DEV_NON_NULL(value, "Value (output)");
+	field = bt_event_borrow_field_by_path_const(event, field_path);
+	if (!field) {
+		status = BT_FUNC_STATUS_NOT_FOUND;
+		goto end;
+	}
+
+	BT_ASSERT_PRE_DEV_FIELD_IS_UNSIGNED_INT(field,
+		"Field located by field path");
+	*value = ((const struct bt_field_integer *) field)->value.u;
+
+end:
+	return status;
+}
+
+enum bt_event_get_field_value_by_path_status
+bt_event_get_signed_integer_field_value_by_path(
+		const struct bt_event *event,
+		const struct bt_field_path *field_path, int64_t *value)
+{
+	enum bt_event_get_field_value_by_path_status status =
+		BT_FUNC_STATUS_OK;
+	const struct bt_field *field;
+
+	BT_ASSERT_PRE_DEV_NON_NULL(value, "Value (output)");
+	field = bt_event_borrow_field_by_path_const(event, field_path);
+	if (!field) {
+		status = BT_FUNC_STATUS_NOT_FOUND;
+		goto end;
+	}
+
+	BT_ASSERT_PRE_DEV_FIELD_IS_SIGNED_INT(field,
+		"Field located by field path");
+	*value = ((const struct bt_field_integer *) field)->value.i;
+
+end:
+	return status;
 }
 
 BT_HIDDEN
@@ -222,6 +571,11 @@ void bt_event_destroy(struct bt_event *event)
 		event->payload_field = NULL;
 	}
 
+	if (event->raw_payload.buf) {
+		g_byte_array_free(event->raw_payload.buf, TRUE);
+		event->raw_payload.buf = NULL;
+	}
+
 	BT_LOGD_STR("Putting event's class.");
 	bt_object_put_ref(event->class);
 	BT_LOGD_STR("Putting event's packet.");
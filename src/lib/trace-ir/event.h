@@ -66,6 +66,22 @@ struct bt_event {
 	struct bt_field *common_context_field;
 	struct bt_field *specific_context_field;
 	struct bt_field *payload_field;
+
+	/*
+	 * Raw payload (see bt_event_set_raw_payload()) from which to
+	 * decode `payload_field` when something borrows it.
+	 */
+	struct {
+		/* Bytes of the raw payload (`NULL` until needed) */
+		GByteArray *buf;
+
+		/* Offset of the raw payload within `buf` (bits, < 8) */
+		uint64_t offset;
+
+		/* True if `payload_field` is not decoded yet */
+		bool is_set;
+	} raw_payload;
+
 	bool frozen;
 };
 
@@ -122,6 +138,7 @@ void bt_event_reset(struct bt_event *event)
 	BT_ASSERT_DBG(event);
 	BT_LIB_LOGD("Resetting event: %!+e", event);
 	bt_event_set_is_frozen(event, false);
+	event->raw_payload.is_set = false;
 	bt_object_put_ref_no_null_check(&event->stream->base);
 	event->stream = NULL;
 
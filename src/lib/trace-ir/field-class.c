@@ -328,6 +328,24 @@ void finalize_enumeration_field_class_mapping(
 	BT_OBJECT_PUT_REF_AND_RESET(mapping->range_set);
 }
 
+static
+void finalize_enumeration_field_class_index(
+		struct bt_field_class_enumeration *fc)
+{
+	if (fc->index.segments) {
+		g_array_free(fc->index.segments, TRUE);
+		fc->index.segments = NULL;
+	}
+
+	if (fc->index.labels) {
+		g_ptr_array_free(fc->index.labels, TRUE);
+		fc->index.labels = NULL;
+	}
+
+	g_free(fc->index.direct);
+	fc->index.direct = NULL;
+}
+
 static
 void destroy_enumeration_field_class(struct bt_object *obj)
 {
@@ -354,6 +372,7 @@ void destroy_enumeration_field_class(struct bt_object *obj)
 		fc->label_buf = NULL;
 	}
 
+	finalize_enumeration_field_class_index(fc);
 	g_free(fc);
 }
 
@@ -531,22 +550,47 @@ bt_field_class_enumeration_signed_mapping_borrow_ranges_const(
 	return (const void *) mapping->range_set;
 }
 
-enum bt_field_class_enumeration_get_mapping_labels_for_value_status
-bt_field_class_enumeration_unsigned_get_mapping_labels_for_value(
-		const struct bt_field_class *fc, uint64_t value,
-		bt_field_class_enumeration_mapping_label_array *label_array,
-		uint64_t *count)
+/*
+ * Converts the raw bits of an enumeration field class value or range
+ * bound to an index key (see the `index` member of
+ * `struct bt_field_class_enumeration`).
+ */
+static inline
+uint64_t enumeration_field_class_key(bool is_signed, uint64_t bits)
 {
-	const struct bt_field_class_enumeration *enum_fc = (const void *) fc;
-	uint64_t i;
+	return is_signed ? bits ^ (UINT64_C(1) << 63) : bits;
+}
 
-	BT_ASSERT_PRE_DEV_NO_ERROR();
-	BT_ASSERT_PRE_DEV_NON_NULL(fc, "Field class");
-	BT_ASSERT_PRE_DEV_NON_NULL(label_array, "Label array (output)");
-	BT_ASSERT_PRE_DEV_NON_NULL(count, "Count (output)");
-	BT_ASSERT_PRE_DEV_FC_HAS_ID(fc, BT_FIELD_CLASS_TYPE_UNSIGNED_ENUMERATION,
-		"Field class");
-	g_ptr_array_set_size(enum_fc->label_buf, 0);
+static inline
+bool enumeration_field_class_is_signed(
+		const struct bt_field_class_enumeration *enum_fc)
+{
+	return enum_fc->common.common.type ==
+		BT_FIELD_CLASS_TYPE_SIGNED_ENUMERATION;
+}
+
+static
+gint compare_uint64(gconstpointer a, gconstpointer b)
+{
+	const uint64_t val_a = *(const uint64_t *) a;
+	const uint64_t val_b = *(const uint64_t *) b;
+
+	if (val_a < val_b) {
+		return -1;
+	} else if (val_a > val_b) {
+		return 1;
+	} else {
+		return 0;
+	}
+}
+
+static
+void append_enumeration_field_class_labels_for_key(
+		const struct bt_field_class_enumeration *enum_fc,
+		uint64_t key, GPtrArray *labels)
+{
+	const bool is_signed = enumeration_field_class_is_signed(enum_fc);
+	uint64_t i;
 
 	for (i = 0; i < enum_fc->mappings->len; i++) {
 		uint64_t j;
@@ -558,36 +602,49 @@ bt_field_class_enumeration_unsigned_get_mapping_labels_for_value(
 				BT_INTEGER_RANGE_SET_RANGE_AT_INDEX(
 					mapping->range_set, j);
 
-			if (value >= range->lower.u &&
-					value <= range->upper.u) {
-				g_ptr_array_add(enum_fc->label_buf,
-					mapping->label->str);
+			if (key >= enumeration_field_class_key(is_signed,
+						range->lower.u) &&
+					key <= enumeration_field_class_key(
+						is_signed, range->upper.u)) {
+				g_ptr_array_add(labels, mapping->label->str);
 				break;
 			}
 		}
 	}
-
-	*label_array = (void *) enum_fc->label_buf->pdata;
-	*count = (uint64_t) enum_fc->label_buf->len;
-	return BT_FUNC_STATUS_OK;
 }
 
-enum bt_field_class_enumeration_get_mapping_labels_for_value_status
-bt_field_class_enumeration_signed_get_mapping_labels_for_value(
-		const struct bt_field_class *fc, int64_t value,
-		bt_field_class_enumeration_mapping_label_array *label_array,
-		uint64_t *count)
-{
-	const struct bt_field_class_enumeration *enum_fc = (const void *) fc;
+/*
+ * Builds the interval index of `enum_fc`.
+ *
+ * The range bounds split the key space into elementary intervals in
+ * which all the values have the same labels: the index contains the
+ * ones having at least one label, in order.
+ *
+ * On failure, `enum_fc` has no index and the label lookup functions
+ * fall back to scanning all the mappings.
+ */
+static
+void build_enumeration_field_class_index(
+		struct bt_field_class_enumeration *enum_fc)
+{
+	const bool is_signed = enumeration_field_class_is_signed(enum_fc);
+	const uint64_t direct_base_key =
+		enumeration_field_class_key(is_signed, 0);
+	const uint64_t direct_last_key = direct_base_key +
+		BT_FIELD_CLASS_ENUM_INDEX_DIRECT_SIZE - 1;
+	GArray *bounds;
 	uint64_t i;
 
-	BT_ASSERT_PRE_DEV_NO_ERROR();
-	BT_ASSERT_PRE_DEV_NON_NULL(fc, "Field class");
-	BT_ASSERT_PRE_DEV_NON_NULL(label_array, "Label array (output)");
-	BT_ASSERT_PRE_DEV_NON_NULL(count, "Count (output)");
-	BT_ASSERT_PRE_DEV_FC_HAS_ID(fc, BT_FIELD_CLASS_TYPE_SIGNED_ENUMERATION,
-		"Field class");
-	g_ptr_array_set_size(enum_fc->label_buf, 0);
+	BT_ASSERT(!enum_fc->index.segments);
+	bounds = g_array_new(FALSE, FALSE, sizeof(uint64_t));
+	enum_fc->index.segments = g_array_new(FALSE, FALSE,
+		sizeof(struct bt_field_class_enumeration_index_segment));
+	enum_fc->index.labels = g_ptr_array_new();
+	if (!bounds || !enum_fc->index.segments || !enum_fc->index.labels) {
+		BT_LIB_LOGW("Failed to allocate enumeration field class index: "
+			"%!+F", enum_fc);
+		goto error;
+	}
 
 	for (i = 0; i < enum_fc->mappings->len; i++) {
 		uint64_t j;
@@ -598,18 +655,216 @@ bt_field_class_enumeration_signed_get_mapping_labels_for_value(
 			const struct bt_integer_range *range = (const void *)
 				BT_INTEGER_RANGE_SET_RANGE_AT_INDEX(
 					mapping->range_set, j);
+			uint64_t key = enumeration_field_class_key(is_signed,
+				range->lower.u);
+
+			g_array_append_val(bounds, key);
+			key = enumeration_field_class_key(is_signed,
+				range->upper.u);
+			if (key != UINT64_MAX) {
+				key++;
+				g_array_append_val(bounds, key);
+			}
+		}
+	}
+
+	g_array_sort(bounds, compare_uint64);
+
+	for (i = 0; i < bounds->len; i++) {
+		struct bt_field_class_enumeration_index_segment segment;
+		uint64_t next_i;
 
-			if (value >= range->lower.i &&
-					value <= range->upper.i) {
-				g_ptr_array_add(enum_fc->label_buf,
-					mapping->label->str);
+		segment.lower_key = g_array_index(bounds, uint64_t, i);
+		if (i > 0 &&
+				segment.lower_key ==
+					g_array_index(bounds, uint64_t, i - 1)) {
+			/* Duplicate bound */
+			continue;
+		}
+
+		for (next_i = i + 1; next_i < bounds->len; next_i++) {
+			if (g_array_index(bounds, uint64_t, next_i) !=
+					segment.lower_key) {
 				break;
 			}
 		}
+
+		segment.upper_key = next_i < bounds->len ?
+			g_array_index(bounds, uint64_t, next_i) - 1 :
+			UINT64_MAX;
+		segment.first_label = enum_fc->index.labels->len;
+		append_enumeration_field_class_labels_for_key(enum_fc,
+			segment.lower_key, enum_fc->index.labels);
+		segment.label_count = enum_fc->index.labels->len -
+			segment.first_label;
+		if (segment.label_count > 0) {
+			g_array_append_val(enum_fc->index.segments, segment);
+		}
 	}
 
-	*label_array = (void *) enum_fc->label_buf->pdata;
-	*count = (uint64_t) enum_fc->label_buf->len;
+	/* Direct table of the small values */
+	for (i = 0; i < enum_fc->index.segments->len; i++) {
+		const struct bt_field_class_enumeration_index_segment *segment =
+			&g_array_index(enum_fc->index.segments,
+				struct bt_field_class_enumeration_index_segment,
+				i);
+		uint64_t key;
+
+		for (key = MAX(segment->lower_key, direct_base_key);
+				key <= MIN(segment->upper_key, direct_last_key);
+				key++) {
+			if (!enum_fc->index.direct) {
+				uint64_t k;
+
+				enum_fc->index.direct = g_new(uint32_t,
+					BT_FIELD_CLASS_ENUM_INDEX_DIRECT_SIZE);
+				if (!enum_fc->index.direct) {
+					BT_LIB_LOGW("Failed to allocate enumeration "
+						"field class index's direct table: "
+						"%!+F", enum_fc);
+					goto error;
+				}
+
+				for (k = 0;
+						k < BT_FIELD_CLASS_ENUM_INDEX_DIRECT_SIZE;
+						k++) {
+					enum_fc->index.direct[k] = UINT32_MAX;
+				}
+			}
+
+			enum_fc->index.direct[key - direct_base_key] =
+				(uint32_t) i;
+		}
+	}
+
+	BT_LIB_LOGD("Built enumeration field class index: "
+		"%!+F, segment-count=%u, label-count=%u, has-direct-table=%d",
+		enum_fc, enum_fc->index.segments->len,
+		enum_fc->index.labels->len, !!enum_fc->index.direct);
+	goto end;
+
+error:
+	finalize_enumeration_field_class_index(enum_fc);
+
+end:
+	if (bounds) {
+		g_array_free(bounds, TRUE);
+	}
+}
+
+static inline
+const struct bt_field_class_enumeration_index_segment *
+find_enumeration_field_class_index_segment(
+		const struct bt_field_class_enumeration *enum_fc,
+		uint64_t key, uint64_t direct_base_key)
+{
+	const GArray *segments = enum_fc->index.segments;
+	const struct bt_field_class_enumeration_index_segment *segment = NULL;
+	uint64_t low = 0;
+	uint64_t high = segments->len;
+
+	if (enum_fc->index.direct &&
+			key - direct_base_key <
+				BT_FIELD_CLASS_ENUM_INDEX_DIRECT_SIZE) {
+		const uint32_t segment_index =
+			enum_fc->index.direct[key - direct_base_key];
+
+		if (segment_index != UINT32_MAX) {
+			segment = &g_array_index(segments,
+				struct bt_field_class_enumeration_index_segment,
+				segment_index);
+		}
+
+		goto end;
+	}
+
+	/* Find the first segment of which the upper key is >= `key` */
+	while (low < high) {
+		const uint64_t mid = low + (high - low) / 2;
+
+		if (g_array_index(segments,
+				struct bt_field_class_enumeration_index_segment,
+				mid).upper_key < key) {
+			low = mid + 1;
+		} else {
+			high = mid;
+		}
+	}
+
+	if (low < segments->len) {
+		segment = &g_array_index(segments,
+			struct bt_field_class_enumeration_index_segment, low);
+		if (segment->lower_key > key) {
+			segment = NULL;
+		}
+	}
+
+end:
+	return segment;
+}
+
+static inline
+void get_enumeration_field_class_mapping_labels_for_key(
+		const struct bt_field_class_enumeration *enum_fc, uint64_t key,
+		uint64_t direct_base_key,
+		bt_field_class_enumeration_mapping_label_array *label_array,
+		uint64_t *count)
+{
+	if (G_LIKELY(enum_fc->index.segments)) {
+		const struct bt_field_class_enumeration_index_segment *segment =
+			find_enumeration_field_class_index_segment(enum_fc,
+				key, direct_base_key);
+
+		if (segment) {
+			*label_array = (void *) &g_ptr_array_index(
+				enum_fc->index.labels, segment->first_label);
+			*count = segment->label_count;
+		} else {
+			*label_array = (void *) enum_fc->index.labels->pdata;
+			*count = 0;
+		}
+	} else {
+		/* Not part of a trace class yet: scan the mappings */
+		g_ptr_array_set_size(enum_fc->label_buf, 0);
+		append_enumeration_field_class_labels_for_key(enum_fc, key,
+			enum_fc->label_buf);
+		*label_array = (void *) enum_fc->label_buf->pdata;
+		*count = (uint64_t) enum_fc->label_buf->len;
+	}
+}
+
+enum bt_field_class_enumeration_get_mapping_labels_for_value_status
+bt_field_class_enumeration_unsigned_get_mapping_labels_for_value(
+		const struct bt_field_class *fc, uint64_t value,
+		bt_field_class_enumeration_mapping_label_array *label_array,
+		uint64_t *count)
+{
+	BT_ASSERT_PRE_DEV_NO_ERROR();
+	BT_ASSERT_PRE_DEV_NON_NULL(fc, "Field class");
+	BT_ASSERT_PRE_DEV_NON_NULL(label_array, "Label array (output)");
+	BT_ASSERT_PRE_DEV_NON_NULL(count, "Count (output)");
+	BT_ASSERT_PRE_DEV_FC_HAS_ID(fc, BT_FIELD_CLASS_TYPE_UNSIGNED_ENUMERATION,
+		"Field class");
+	get_enumeration_field_class_mapping_labels_for_key((const void *) fc,
+		value, 0, label_array, count);
+	return BT_FUNC_STATUS_OK;
+}
+
+enum bt_field_class_enumeration_get_mapping_labels_for_value_status
+bt_field_class_enumeration_signed_get_mapping_labels_for_value(
+		const struct bt_field_class *fc, int64_t value,
+		bt_field_class_enumeration_mapping_label_array *label_array,
+		uint64_t *count)
+{
+	BT_ASSERT_PRE_DEV_NO_ERROR();
+	BT_ASSERT_PRE_DEV_NON_NULL(fc, "Field class");
+	BT_ASSERT_PRE_DEV_NON_NULL(label_array, "Label array (output)");
+	BT_ASSERT_PRE_DEV_NON_NULL(count, "Count (output)");
+	BT_ASSERT_PRE_DEV_FC_HAS_ID(fc, BT_FIELD_CLASS_TYPE_SIGNED_ENUMERATION,
+		"Field class");
+	get_enumeration_field_class_mapping_labels_for_key((const void *) fc,
+		enumeration_field_class_key(true, (uint64_t) value),
+		enumeration_field_class_key(true, 0), label_array, count);
 	return BT_FUNC_STATUS_OK;
 }
 
@@ -2178,7 +2433,10 @@ void bt_field_class_make_part_of_trace_class(const struct bt_field_class *c_fc)
 		"Field class is already part of a trace: %!+F", fc);
 	fc->part_of_trace_class = true;
 
-	if (fc->type == BT_FIELD_CLASS_TYPE_STRUCTURE ||
+	if (bt_field_class_type_is(fc->type, BT_FIELD_CLASS_TYPE_ENUMERATION)) {
+		/* Its mappings cannot change anymore */
+		build_enumeration_field_class_index((void *) fc);
+	} else if (fc->type == BT_FIELD_CLASS_TYPE_STRUCTURE ||
 			bt_field_class_type_is(fc->type,
 				BT_FIELD_CLASS_TYPE_VARIANT)) {
 		struct bt_field_class_named_field_class_container *container_fc =
@@ -2196,6 +2454,11 @@ void bt_field_class_make_part_of_trace_class(const struct bt_field_class *c_fc)
 		struct bt_field_class_array *array_fc = (void *) fc;
 
 		bt_field_class_make_part_of_trace_class(array_fc->element_fc);
+	} else if (bt_field_class_type_is(fc->type,
+			BT_FIELD_CLASS_TYPE_OPTION)) {
+		struct bt_field_class_option *opt_fc = (void *) fc;
+
+		bt_field_class_make_part_of_trace_class(opt_fc->content_fc);
 	}
 }
 
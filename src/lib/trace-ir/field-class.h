@@ -274,6 +274,22 @@ struct bt_field_class_enumeration_mapping {
 struct bt_field_class_enumeration_unsigned_mapping;
 struct bt_field_class_enumeration_signed_mapping;
 
+/*
+ * Number of small values (0 and up) of which an enumeration field
+ * class index finds the segment without a binary search.
+ */
+#define BT_FIELD_CLASS_ENUM_INDEX_DIRECT_SIZE	256
+
+struct bt_field_class_enumeration_index_segment {
+	uint64_t lower_key;
+	uint64_t upper_key;
+
+	/* Index of the first label of this segment within `index.labels` */
+	uint32_t first_label;
+
+	uint32_t label_count;
+};
+
 struct bt_field_class_enumeration {
 	struct bt_field_class_integer common;
 
@@ -288,8 +304,50 @@ struct bt_field_class_enumeration {
 	 * bt_field_class_enumeration_signed_get_mapping_labels_for_value().
 	 *
 	 * The actual strings are owned by the mappings above.
+	 *
+	 * Only used when `index` below is not built.
 	 */
 	GPtrArray *label_buf;
+
+	/*
+	 * Sorted interval index of the mappings, built when the field
+	 * class becomes part of a trace class (its mappings cannot change
+	 * anymore).
+	 *
+	 * The index is never modified once built, so that
+	 * bt_field_class_enumeration_unsigned_get_mapping_labels_for_value()
+	 * and
+	 * bt_field_class_enumeration_signed_get_mapping_labels_for_value()
+	 * return slices of `labels` and can run concurrently.
+	 *
+	 * All the bounds are keys: unsigned values as is, and signed
+	 * values with their sign bit flipped, so that comparing keys as
+	 * unsigned integers preserves the order of the values.
+	 */
+	struct {
+		/*
+		 * Array of `struct bt_field_class_enumeration_index_segment`:
+		 * sorted, disjoint intervals which contain at least one
+		 * label, each one having the same labels for all its
+		 * values. `NULL` if the index is not built.
+		 */
+		GArray *segments;
+
+		/*
+		 * Array of `const char *`: labels of all the segments, in
+		 * mapping order for each segment. The actual strings are
+		 * owned by the mappings above.
+		 */
+		GPtrArray *labels;
+
+		/*
+		 * Segment index (within `segments`) of each of the
+		 * `BT_FIELD_CLASS_ENUM_INDEX_DIRECT_SIZE` values starting
+		 * at 0, or `UINT32_MAX` if no segment contains the value.
+		 * `NULL` if no segment contains any of those values.
+		 */
+		uint32_t *direct;
+	} index;
 };
 
 struct bt_field_class_real {
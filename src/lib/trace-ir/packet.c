@@ -38,6 +38,7 @@
 #include "packet.h"
 #include "stream-class.h"
 #include "stream.h"
+#include "trace-class.h"
 #include "trace.h"
 #include "lib/func-status.h"
 
@@ -65,6 +66,63 @@ const struct bt_field *bt_packet_borrow_context_field_const(
 	return bt_packet_borrow_context_field((void *) packet);
 }
 
+enum bt_packet_set_raw_data_status bt_packet_set_raw_data(
+		struct bt_packet *packet, const void *data, uint64_t size,
+		uint64_t event_count)
+{
+	enum bt_packet_set_raw_data_status status = BT_FUNC_STATUS_OK;
+
+	BT_ASSERT_PRE_DEV_NO_ERROR();
+	BT_ASSERT_PRE_DEV_NON_NULL(packet, "Packet");
+	BT_ASSERT_PRE_DEV_NON_NULL(data, "Data");
+	BT_ASSERT_PRE_DEV(bt_stream_class_borrow_trace_class_inline(
+		packet->stream->class)->raw_packet_format.name,
+		"Packet's trace class has no raw packet format: %!+a",
+		packet);
+
+	/*
+	 * The raw data of a packet is not part of its frozen state: a
+	 * producer typically only has it once it reached the end of
+	 * the packet, after it emitted its packet beginning message.
+	 */
+	if (G_UNLIKELY(!packet->raw_data.buf)) {
+		packet->raw_data.buf = g_byte_array_new();
+		if (!packet->raw_data.buf) {
+			BT_LIB_LOGE_APPEND_CAUSE(
+				"Failed to allocate a GByteArray.");
+			status = BT_FUNC_STATUS_MEMORY_ERROR;
+			goto end;
+		}
+	}
+
+	g_byte_array_set_size(packet->raw_data.buf, 0);
+	g_byte_array_append(packet->raw_data.buf, data, (guint) size);
+	packet->raw_data.event_count = event_count;
+	packet->raw_data.is_set = true;
+
+end:
+	return status;
+}
+
+enum bt_property_availability bt_packet_get_raw_data(
+		const struct bt_packet *packet, const void **data,
+		uint64_t *size, uint64_t *event_count)
+{
+	BT_ASSERT_PRE_DEV_NON_NULL(packet, "Packet");
+	BT_ASSERT_PRE_DEV_NON_NULL(data, "Data (output)");
+	BT_ASSERT_PRE_DEV_NON_NULL(size, "Size (output)");
+	BT_ASSERT_PRE_DEV_NON_NULL(event_count, "Event count (output)");
+
+	if (!packet->raw_data.is_set) {
+		return BT_PROPERTY_AVAILABILITY_NOT_AVAILABLE;
+	}
+
+	*data = packet->raw_data.buf->data;
+	*size = packet->raw_data.buf->len;
+	*event_count = packet->raw_data.event_count;
+	return BT_PROPERTY_AVAILABILITY_AVAILABLE;
+}
+
 BT_HIDDEN
 void _bt_packet_set_is_frozen(const struct bt_packet *packet, bool is_frozen)
 {
@@ -95,6 +153,8 @@ void reset_packet(struct bt_packet *packet)
 		bt_field_set_is_frozen(packet->context_field->field, false);
 		bt_field_reset(packet->context_field->field);
 	}
+
+	packet->raw_data.is_set = false;
 }
 
 static
@@ -164,6 +224,11 @@ void bt_packet_destroy(struct bt_packet *packet)
 		packet->context_field = NULL;
 	}
 
+	if (packet->raw_data.buf) {
+		g_byte_array_free(packet->raw_data.buf, TRUE);
+		packet->raw_data.buf = NULL;
+	}
+
 	BT_LOGD_STR("Putting packet's stream.");
 	BT_OBJECT_PUT_REF_AND_RESET(packet->stream);
 	g_free(packet);
@@ -24,6 +24,7 @@
  */
 
 #include <stdbool.h>
+#include <glib.h>
 #include "common/assert.h"
 #include <babeltrace2/trace-ir/clock-snapshot.h>
 #include <babeltrace2/trace-ir/packet.h>
@@ -39,6 +40,19 @@ struct bt_packet {
 	struct bt_object base;
 	struct bt_field_wrapper *context_field;
 	struct bt_stream *stream;
+
+	/* Raw data (see bt_packet_set_raw_data()) */
+	struct {
+		/*
+		 * Owned by this; kept when the packet is recycled to
+		 * reuse its allocation.
+		 */
+		GByteArray *buf;
+
+		uint64_t event_count;
+		bool is_set;
+	} raw_data;
+
 	bool frozen;
 };
 
@@ -127,6 +127,16 @@ void destroy_trace_class(struct bt_object *obj)
 		tc->stream_classes = NULL;
 	}
 
+	if (tc->raw_packet_format.name) {
+		g_string_free(tc->raw_packet_format.name, TRUE);
+		tc->raw_packet_format.name = NULL;
+	}
+
+	if (tc->raw_packet_format.description) {
+		g_string_free(tc->raw_packet_format.description, TRUE);
+		tc->raw_packet_format.description = NULL;
+	}
+
 	g_free(tc);
 }
 
@@ -353,6 +363,56 @@ void bt_trace_class_set_user_attributes(struct bt_trace_class *trace_class,
 	bt_object_get_ref_no_null_check(trace_class->user_attributes);
 }
 
+enum bt_trace_class_set_raw_packet_format_status
+bt_trace_class_set_raw_packet_format(struct bt_trace_class *trace_class,
+		const char *name, const char *description)
+{
+	enum bt_trace_class_set_raw_packet_format_status status =
+		BT_FUNC_STATUS_OK;
+
+	BT_ASSERT_PRE_NO_ERROR();
+	BT_ASSERT_PRE_NON_NULL(trace_class, "Trace class");
+	BT_ASSERT_PRE_NON_NULL(name, "Name");
+	BT_ASSERT_PRE_NON_NULL(description, "Description");
+	BT_ASSERT_PRE_DEV_TRACE_CLASS_HOT(trace_class);
+
+	if (!trace_class->raw_packet_format.name) {
+		trace_class->raw_packet_format.name = g_string_new(NULL);
+		trace_class->raw_packet_format.description = g_string_new(NULL);
+		if (!trace_class->raw_packet_format.name ||
+				!trace_class->raw_packet_format.description) {
+			BT_LIB_LOGE_APPEND_CAUSE("Failed to allocate a GString.");
+			status = BT_FUNC_STATUS_MEMORY_ERROR;
+			goto end;
+		}
+	}
+
+	g_string_assign(trace_class->raw_packet_format.name, name);
+	g_string_assign(trace_class->raw_packet_format.description,
+		description);
+	BT_LIB_LOGD("Set trace class's raw packet format: %!+T, "
+		"name=\"%s\"", trace_class, name);
+
+end:
+	return status;
+}
+
+const char *bt_trace_class_get_raw_packet_format_name(
+		const struct bt_trace_class *trace_class)
+{
+	BT_ASSERT_PRE_DEV_NON_NULL(trace_class, "Trace class");
+	return trace_class->raw_packet_format.name ?
+		trace_class->raw_packet_format.name->str : NULL;
+}
+
+const char *bt_trace_class_get_raw_packet_format_description(
+		const struct bt_trace_class *trace_class)
+{
+	BT_ASSERT_PRE_DEV_NON_NULL(trace_class, "Trace class");
+	return trace_class->raw_packet_format.description ?
+		trace_class->raw_packet_format.description->str : NULL;
+}
+
 void bt_trace_class_get_ref(const struct bt_trace_class *trace_class)
 {
 	bt_object_get_ref(trace_class);
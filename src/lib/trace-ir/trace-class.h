@@ -51,6 +51,16 @@ struct bt_trace_class {
 	GPtrArray *stream_classes;
 
 	bool assigns_automatic_stream_class_id;
+
+	/*
+	 * Raw packet format (see bt_trace_class_set_raw_packet_format()):
+	 * `NULL` if not set.
+	 */
+	struct {
+		GString *name;
+		GString *description;
+	} raw_packet_format;
+
 	GArray *destruction_listeners;
 	bool frozen;
 };
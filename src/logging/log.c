@@ -146,6 +146,32 @@ extern unsigned long pthread_getsequence_np(pthread_t *);
 #ifndef BT_LOG_EOL
 	#define BT_LOG_EOL "\n"
 #endif
+/* When defined, the asynchronous backend is available (ignored on Windows).
+ * It is only used when the BABELTRACE_LOGGING_ASYNC environment variable
+ * is set to `1`: log statements of the global output then only format
+ * their message and copy it, with the level, tag, source location,
+ * timestamp, pid and tid, to a per-thread ring buffer. A background
+ * thread formats the rest of the log lines and writes them.
+ */
+#if defined(_WIN32) || defined(_WIN64)
+	#define BT_LOG_USE_ASYNC 0
+#else
+	#define BT_LOG_USE_ASYNC 1
+#endif
+/* Size, in bytes, of the per-thread ring buffers of the asynchronous
+ * backend. Must be a power of two. Log statements executed while the
+ * ring buffer of their thread is full are dropped, and the number of
+ * dropped records is reported.
+ */
+#ifndef BT_LOG_ASYNC_RING_SZ
+	#define BT_LOG_ASYNC_RING_SZ (256 * 1024)
+#endif
+/* Period, in milliseconds, at which the asynchronous backend's flusher
+ * thread drains the per-thread ring buffers.
+ */
+#ifndef BT_LOG_ASYNC_FLUSH_PERIOD_MS
+	#define BT_LOG_ASYNC_FLUSH_PERIOD_MS 10
+#endif
 /* Default delimiter that separates parts of log message. Can NOT contain '%'
  * or '\0'.
  *
@@ -297,6 +323,7 @@ extern unsigned long pthread_getsequence_np(pthread_t *);
 #include <stddef.h>
 #include <stdlib.h>
 #include <stdio.h>
+#include <glib.h>
 
 #define BT_LOG_OUTPUT_LEVEL dummy
 
@@ -530,6 +557,17 @@ typedef struct mem_block
 }
 mem_block;
 
+/* Log message context saved when a log statement is executed, to be put
+ * later (asynchronous backend).
+ */
+typedef struct saved_ctx
+{
+	gint64 time_us;
+	int pid;
+	int tid;
+}
+saved_ctx;
+
 static void time_callback(struct tm *const tm, unsigned *const usec);
 static void pid_callback(int *const pid, int *const tid);
 static void buffer_callback(bt_log_message *msg, char *buf);
@@ -780,6 +818,23 @@ static INLINE void tcache_set(const struct timeval *const tv, struct tm *const t
 }
 #endif
 
+#if _BT_LOG_MESSAGE_FORMAT_DATETIME_USED && !defined(_WIN32) && !defined(_WIN64)
+static void tv_to_tm(const struct timeval *const tv,
+					 struct tm *const tm, unsigned *const msec)
+{
+	#ifndef TCACHE
+	localtime_r(&tv->tv_sec, tm);
+	#else
+	if (!tcache_get(tv, tm))
+	{
+		localtime_r(&tv->tv_sec, tm);
+		tcache_set(tv, tm);
+	}
+	#endif
+	*msec = (unsigned)tv->tv_usec / 1000;
+}
+#endif
+
 static void time_callback(struct tm *const tm, unsigned *const msec)
 {
 #if !_BT_LOG_MESSAGE_FORMAT_DATETIME_USED
@@ -800,16 +855,7 @@ static void time_callback(struct tm *const tm, unsigned *const msec)
 	#else
 	struct timeval tv;
 	gettimeofday(&tv, 0);
-		#ifndef TCACHE
-		localtime_r(&tv.tv_sec, tm);
-		#else
-		if (!tcache_get(&tv, tm))
-		{
-			localtime_r(&tv.tv_sec, tm);
-			tcache_set(&tv, tm);
-		}
-		#endif
-	*msec = (unsigned)tv.tv_usec / 1000;
+	tv_to_tm(&tv, tm, msec);
 	#endif
 #endif
 }
@@ -1070,22 +1116,52 @@ static INLINE char *put_uint(unsigned v, const unsigned w, const char wc,
 #define _BT_LOG_MESSAGE_FORMAT_PUT_R(field) \
 	_PP_CONCAT_3(_BT_LOG_MESSAGE_FORMAT_PUT_R_, _, field)
 
-static void put_ctx(bt_log_message *const msg)
+/* Puts the context of the current log statement, or the saved context
+ * `sctx` if not null.
+ */
+static void put_ctx(bt_log_message *const msg, const saved_ctx *const sctx)
 {
 	_PP_MAP(_BT_LOG_MESSAGE_FORMAT_INIT, BT_LOG_MESSAGE_CTX_FORMAT)
 #if !_BT_LOG_MESSAGE_FORMAT_FIELDS(BT_LOG_MESSAGE_CTX_FORMAT)
 	VAR_UNUSED(msg);
+	VAR_UNUSED(sctx);
 #else
 	#if _BT_LOG_MESSAGE_FORMAT_DATETIME_USED
 	struct tm tm;
 	unsigned msec;
-	g_time_cb(&tm, &msec);
 	#endif
 	#if _BT_LOG_MESSAGE_FORMAT_CONTAINS(PID, BT_LOG_MESSAGE_CTX_FORMAT) || \
 		_BT_LOG_MESSAGE_FORMAT_CONTAINS(TID, BT_LOG_MESSAGE_CTX_FORMAT)
 	int pid, tid;
-	g_pid_cb(&pid, &tid);
 	#endif
+	#if BT_LOG_USE_ASYNC
+	if (0 != sctx)
+	{
+		#if _BT_LOG_MESSAGE_FORMAT_DATETIME_USED
+		struct timeval tv;
+		tv.tv_sec = (time_t)(sctx->time_us / G_USEC_PER_SEC);
+		tv.tv_usec = (suseconds_t)(sctx->time_us % G_USEC_PER_SEC);
+		tv_to_tm(&tv, &tm, &msec);
+		#endif
+		#if _BT_LOG_MESSAGE_FORMAT_CONTAINS(PID, BT_LOG_MESSAGE_CTX_FORMAT) || \
+			_BT_LOG_MESSAGE_FORMAT_CONTAINS(TID, BT_LOG_MESSAGE_CTX_FORMAT)
+		pid = sctx->pid;
+		tid = sctx->tid;
+		#endif
+	}
+	else
+	#else
+	VAR_UNUSED(sctx);
+	#endif
+	{
+		#if _BT_LOG_MESSAGE_FORMAT_DATETIME_USED
+		g_time_cb(&tm, &msec);
+		#endif
+		#if _BT_LOG_MESSAGE_FORMAT_CONTAINS(PID, BT_LOG_MESSAGE_CTX_FORMAT) || \
+			_BT_LOG_MESSAGE_FORMAT_CONTAINS(TID, BT_LOG_MESSAGE_CTX_FORMAT)
+		g_pid_cb(&pid, &tid);
+		#endif
+	}
 
 	#if BT_LOG_OPTIMIZE_SIZE
 	int n;
@@ -1241,6 +1317,498 @@ static void output_mem(const bt_log_spec *log, bt_log_message *const msg,
 	}
 }
 
+/* Puts the color, context, tag and source location parts of a log line,
+ * using the saved context `sctx` if not null.
+ */
+static void put_head(bt_log_message *const msg, const unsigned mask,
+					 const saved_ctx *const sctx,
+					 const src_location *const src, const char *const tag)
+{
+	const char *color_p = "";
+	const char *color_e = color_p;
+
+	switch (msg->lvl) {
+	case BT_LOG_INFO:
+		color_p = bt_common_color_fg_blue();
+		color_e = color_p + strlen(color_p);
+		break;
+	case BT_LOG_WARNING:
+		color_p = bt_common_color_fg_yellow();
+		color_e = color_p + strlen(color_p);
+		break;
+	case BT_LOG_ERROR:
+	case BT_LOG_FATAL:
+		color_p = bt_common_color_fg_red();
+		color_e = color_p + strlen(color_p);
+		break;
+	default:
+		break;
+	}
+
+	msg->p = put_stringn(color_p, color_e, msg->p, msg->e);
+
+	if (BT_LOG_PUT_CTX & mask)
+	{
+		put_ctx(msg, sctx);
+	}
+	if (BT_LOG_PUT_TAG & mask)
+	{
+		put_tag(msg, tag);
+	}
+	if (0 != src && BT_LOG_PUT_SRC & mask)
+	{
+		put_src(msg, src);
+	}
+}
+
+static void put_tail(bt_log_message *const msg)
+{
+	const char *rst_color_p = bt_common_color_reset();
+	const char *rst_color_e = rst_color_p + strlen(rst_color_p);
+	msg->p = put_stringn(rst_color_p, rst_color_e, msg->p, msg->e);
+}
+
+#if BT_LOG_USE_ASYNC
+/* Asynchronous backend.
+ *
+ * There is a single instance of this backend per process: the one of
+ * libbabeltrace2, which all the other modules (CLI, plugins, Python
+ * bindings) reach through bt_lib_log_async_is_enabled() and
+ * bt_lib_log_async_write(), so that one flusher thread writes the log
+ * lines of all the modules in order. Those functions are weak
+ * references: a module which does not link with libbabeltrace2 writes
+ * synchronously.
+ *
+ * Each thread which writes a log statement gets its own ring buffer,
+ * which only this thread writes (head) and only the flusher thread reads
+ * (tail), so that no lock is needed to record a log statement. A record
+ * is an async_record header followed by the null-terminated tag,
+ * function name and file name (copied, as the module which contains
+ * them can be unloaded before the record is written) and by the
+ * formatted message, padded to the header's alignment. The flusher
+ * thread periodically drains all the ring buffers, formatting and
+ * writing the log lines with the global output of libbabeltrace2.
+ */
+
+/* Maximum size of a recorded tag, function name or file name, including
+ * its null character (longer strings are truncated).
+ */
+#define ASYNC_STR_SZ 256
+
+typedef struct async_record
+{
+	saved_ctx ctx;
+	unsigned line;
+	int has_src;
+	int lvl;
+	unsigned tag_sz;
+	unsigned func_sz;
+	unsigned file_sz;
+	unsigned text_sz;
+}
+async_record;
+
+typedef struct async_ring
+{
+	/* Total number of bytes written (producer) and read (flusher) */
+	size_t head;
+	size_t tail;
+
+	/* Number of dropped records since the last report */
+	unsigned long dropped;
+
+	/* Nonzero when the producer thread exited */
+	int orphaned;
+
+	struct async_ring *next;
+	char buf[BT_LOG_ASYNC_RING_SZ];
+}
+async_ring;
+
+#define ASYNC_RECORD_MAX_SZ \
+	(sizeof(async_record) + 3 * ASYNC_STR_SZ + BT_LOG_BUF_SZ + \
+	 sizeof(async_record))
+
+STATIC_ASSERT(async_ring_sz_is_pow2,
+			  0 == (BT_LOG_ASYNC_RING_SZ & (BT_LOG_ASYNC_RING_SZ - 1)));
+STATIC_ASSERT(async_record_fits_ring, ASYNC_RECORD_MAX_SZ <= BT_LOG_ASYNC_RING_SZ);
+
+/* Implemented by libbabeltrace2 (see `src/lib/logging.c`) */
+int bt_lib_log_async_is_enabled(void) __attribute__((weak));
+int bt_lib_log_async_write(int lvl, const char *tag, const char *func,
+		const char *file, unsigned line, const char *text,
+		size_t text_sz) __attribute__((weak));
+
+static void async_ring_release(gpointer data);
+
+/* State of the backend instance of libbabeltrace2: 0 (not initialized
+ * yet), 1 (disabled), or 2 (enabled).
+ */
+static gsize g_async_state;
+
+/* Set once the backend instance is stopped: log statements are
+ * synchronous.
+ */
+static int g_async_stopped;
+
+/* Number of threads which are recording a log statement */
+static int g_async_writers;
+
+/* Protects `g_async_rings`, `g_async_stop`, and the `orphaned` member
+ * of the rings.
+ */
+static GMutex g_async_lock;
+static GCond g_async_cond;
+static int g_async_stop;
+static async_ring *g_async_rings;
+static GThread *g_async_flusher;
+static GPrivate g_async_ring_key = G_PRIVATE_INIT(async_ring_release);
+static __thread async_ring *g_async_cur_ring;
+
+/* Flusher's copy of the record being written */
+static char g_async_record_buf[ASYNC_RECORD_MAX_SZ];
+
+/* Whether the log statements of this module use the backend instance of
+ * libbabeltrace2: 0 (not known yet), 1 (no), or 2 (yes).
+ */
+static int g_async_used;
+
+static INLINE size_t async_record_size(const size_t sz)
+{
+	return (sz + sizeof(async_record) - 1) / sizeof(async_record) *
+		sizeof(async_record);
+}
+
+static void async_ring_copy_in(async_ring *const ring, const size_t pos,
+							   const void *const d, const size_t sz)
+{
+	const size_t off = pos & (BT_LOG_ASYNC_RING_SZ - 1);
+	const size_t first = sz < BT_LOG_ASYNC_RING_SZ - off?
+		sz: BT_LOG_ASYNC_RING_SZ - off;
+	memcpy(ring->buf + off, d, first);
+	memcpy(ring->buf, (const char *)d + first, sz - first);
+}
+
+static void async_ring_copy_out(const async_ring *const ring, const size_t pos,
+								void *const d, const size_t sz)
+{
+	const size_t off = pos & (BT_LOG_ASYNC_RING_SZ - 1);
+	const size_t first = sz < BT_LOG_ASYNC_RING_SZ - off?
+		sz: BT_LOG_ASYNC_RING_SZ - off;
+	memcpy(d, ring->buf + off, first);
+	memcpy((char *)d + first, ring->buf, sz - first);
+}
+
+/* Copies the null-terminated string `s` (empty if null), truncated to
+ * `sz - 1` bytes, at `pos` in `ring`.
+ */
+static void async_ring_copy_in_str(async_ring *const ring, const size_t pos,
+								   const char *const s, const unsigned sz)
+{
+	async_ring_copy_in(ring, pos, s? s: "", sz - 1);
+	async_ring_copy_in(ring, pos + sz - 1, "", 1);
+}
+
+static unsigned async_str_size(const char *const s)
+{
+	return (s? (unsigned)strnlen(s, ASYNC_STR_SZ - 1): 0) + 1;
+}
+
+static void async_output_record(const async_record *const rec,
+								const char *const tag, const char *const func,
+								const char *const file, const char *const text)
+{
+	const bt_log_spec *const log = &global_spec;
+	const unsigned mask = log->output->mask;
+	const src_location src = {func, file, rec->line};
+	bt_log_message msg;
+	msg.lvl = rec->lvl;
+	msg.tag = tag;
+	g_buffer_cb(&msg, logging_buf);
+	put_head(&msg, mask, &rec->ctx, rec->has_src? &src: 0, tag);
+	if (BT_LOG_PUT_MSG & mask)
+	{
+		msg.msg_b = msg.p;
+		msg.p = put_stringn(text, text + rec->text_sz, msg.p, msg.e);
+	}
+	put_tail(&msg);
+	log->output->callback(&msg, log->output->arg);
+}
+
+static void async_output_dropped(const unsigned long dropped)
+{
+	const bt_log_spec *const log = &global_spec;
+	const unsigned mask = log->output->mask;
+	bt_log_message msg;
+	int n;
+	msg.lvl = BT_LOG_WARNING;
+	msg.tag = "LOGGING";
+	g_buffer_cb(&msg, logging_buf);
+	put_head(&msg, mask, 0, 0, msg.tag);
+	if (BT_LOG_PUT_MSG & mask)
+	{
+		msg.msg_b = msg.p;
+		n = snprintf(msg.p, nprintf_size(&msg),
+					 "Dropped %lu log records: asynchronous ring buffer is full.",
+					 dropped);
+		put_nprintf(&msg, n);
+	}
+	put_tail(&msg);
+	log->output->callback(&msg, log->output->arg);
+}
+
+/* Writes all the records of `ring`. Called with `g_async_lock` held.
+ */
+static void async_drain_ring(async_ring *const ring)
+{
+	const size_t head = __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE);
+	size_t tail = ring->tail;
+	unsigned long dropped;
+	while (tail != head)
+	{
+		async_record *const rec = (async_record *)g_async_record_buf;
+		const char *const tag = (const char *)(rec + 1);
+		const char *const func = tag + rec->tag_sz;
+		const char *file;
+		size_t sz;
+		async_ring_copy_out(ring, tail, rec, sizeof(*rec));
+		sz = rec->tag_sz + rec->func_sz + rec->file_sz + rec->text_sz;
+		async_ring_copy_out(ring, tail + sizeof(*rec), rec + 1, sz);
+		file = func + rec->func_sz;
+		async_output_record(rec, tag, func, file, file + rec->file_sz);
+		tail += async_record_size(sizeof(*rec) + sz);
+		__atomic_store_n(&ring->tail, tail, __ATOMIC_RELEASE);
+	}
+	dropped = __atomic_exchange_n(&ring->dropped, 0, __ATOMIC_RELAXED);
+	if (0 != dropped)
+	{
+		async_output_dropped(dropped);
+	}
+}
+
+/* Drains all the ring buffers, freeing the ones of exited threads, or
+ * all of them if `free_all` is nonzero. Called with `g_async_lock` held.
+ */
+static void async_drain(const int free_all)
+{
+	async_ring **ringp = &g_async_rings;
+	while (0 != *ringp)
+	{
+		async_ring *const ring = *ringp;
+		async_drain_ring(ring);
+		if (free_all || ring->orphaned)
+		{
+			*ringp = ring->next;
+			g_free(ring);
+			continue;
+		}
+		ringp = &ring->next;
+	}
+}
+
+static gpointer async_flusher_thread(gpointer data)
+{
+	VAR_UNUSED(data);
+	g_mutex_lock(&g_async_lock);
+	while (!g_async_stop)
+	{
+		const gint64 end_time = g_get_monotonic_time() +
+			BT_LOG_ASYNC_FLUSH_PERIOD_MS * G_TIME_SPAN_MILLISECOND;
+		g_cond_wait_until(&g_async_cond, &g_async_lock, end_time);
+		async_drain(0);
+	}
+	g_mutex_unlock(&g_async_lock);
+	return 0;
+}
+
+/* Called when a thread which owns a ring buffer exits. Once the backend
+ * is stopped, all the ring buffers are already freed.
+ */
+static void async_ring_release(gpointer data)
+{
+	async_ring *const ring = data;
+	g_mutex_lock(&g_async_lock);
+	if (!__atomic_load_n(&g_async_stopped, __ATOMIC_SEQ_CST))
+	{
+		ring->orphaned = 1;
+	}
+	g_mutex_unlock(&g_async_lock);
+}
+
+static async_ring *async_get_ring(void)
+{
+	async_ring *ring = g_async_cur_ring;
+	if (0 != ring)
+	{
+		return ring;
+	}
+	ring = g_try_new0(async_ring, 1);
+	if (0 == ring)
+	{
+		return 0;
+	}
+	g_mutex_lock(&g_async_lock);
+	ring->next = g_async_rings;
+	g_async_rings = ring;
+	g_mutex_unlock(&g_async_lock);
+	g_private_set(&g_async_ring_key, ring);
+	g_async_cur_ring = ring;
+	return ring;
+}
+
+/* Returns whether the backend instance of this module (only used in
+ * libbabeltrace2) is enabled, starting its flusher thread the first
+ * time.
+ */
+BT_HIDDEN
+int bt_log_async_is_enabled(void)
+{
+	if (g_once_init_enter(&g_async_state))
+	{
+		gsize state = 1;
+		const char *const env = getenv("BABELTRACE_LOGGING_ASYNC");
+		if (env && 0 == strcmp(env, "1"))
+		{
+			g_async_flusher = g_thread_try_new("bt-log-flusher",
+					async_flusher_thread, 0, 0);
+			if (g_async_flusher)
+			{
+				state = 2;
+			}
+		}
+		g_once_init_leave(&g_async_state, state);
+	}
+	return 2 == g_async_state &&
+		!__atomic_load_n(&g_async_stopped, __ATOMIC_RELAXED);
+}
+
+/* Records a log statement, of which `text` is the formatted message, in
+ * the ring buffer of the current thread. Returns zero if the log
+ * statement must be written synchronously instead.
+ */
+BT_HIDDEN
+int bt_log_async_write(const int lvl, const char *const tag,
+					   const char *const func, const char *const file,
+					   const unsigned line, const char *const text,
+					   const size_t text_sz)
+{
+	async_ring *ring;
+	async_record rec;
+	size_t head, tail, rec_sz, pos;
+	int ret = 0;
+	__atomic_add_fetch(&g_async_writers, 1, __ATOMIC_SEQ_CST);
+	if (2 != g_async_state ||
+		__atomic_load_n(&g_async_stopped, __ATOMIC_SEQ_CST))
+	{
+		goto end;
+	}
+	ring = async_get_ring();
+	if (0 == ring)
+	{
+		goto end;
+	}
+	ret = !0;
+	rec.ctx.time_us = g_get_real_time();
+	rec.ctx.pid = 0;
+	rec.ctx.tid = 0;
+	g_pid_cb(&rec.ctx.pid, &rec.ctx.tid);
+	rec.has_src = 0 != file;
+	rec.line = line;
+	rec.lvl = lvl;
+	rec.tag_sz = async_str_size(tag);
+	rec.func_sz = async_str_size(func);
+	rec.file_sz = async_str_size(file);
+	rec.text_sz = (unsigned)text_sz;
+	rec_sz = async_record_size(sizeof(rec) + rec.tag_sz + rec.func_sz +
+							   rec.file_sz + rec.text_sz);
+	head = ring->head;
+	tail = __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE);
+	if (rec_sz > BT_LOG_ASYNC_RING_SZ - (head - tail))
+	{
+		__atomic_fetch_add(&ring->dropped, 1, __ATOMIC_RELAXED);
+		goto end;
+	}
+	pos = head;
+	async_ring_copy_in(ring, pos, &rec, sizeof(rec));
+	pos += sizeof(rec);
+	async_ring_copy_in_str(ring, pos, tag, rec.tag_sz);
+	pos += rec.tag_sz;
+	async_ring_copy_in_str(ring, pos, func, rec.func_sz);
+	pos += rec.func_sz;
+	async_ring_copy_in_str(ring, pos, file, rec.file_sz);
+	pos += rec.file_sz;
+	async_ring_copy_in(ring, pos, text, rec.text_sz);
+	__atomic_store_n(&ring->head, head + rec_sz, __ATOMIC_RELEASE);
+
+end:
+	__atomic_sub_fetch(&g_async_writers, 1, __ATOMIC_SEQ_CST);
+	return ret;
+}
+
+/* Returns whether the log statements of this module use the backend
+ * instance of libbabeltrace2.
+ */
+static int async_is_used(void)
+{
+	if (0 == g_async_used)
+	{
+		g_async_used = 0 != bt_lib_log_async_is_enabled &&
+			0 != bt_lib_log_async_write &&
+			bt_lib_log_async_is_enabled()? 2: 1;
+	}
+	return 2 == g_async_used;
+}
+
+/* Stops the flusher thread when the process exits or when
+ * libbabeltrace2 is unloaded, writing the remaining records and freeing
+ * all the ring buffers. Only the instance of libbabeltrace2 ever
+ * starts.
+ */
+static void __attribute__((destructor)) async_fini(void)
+{
+	if (2 != g_async_state)
+	{
+		return;
+	}
+	__atomic_store_n(&g_async_stopped, 1, __ATOMIC_SEQ_CST);
+	/* Wait for the threads which are recording a log statement */
+	while (0 != __atomic_load_n(&g_async_writers, __ATOMIC_SEQ_CST))
+	{
+		g_thread_yield();
+	}
+	g_mutex_lock(&g_async_lock);
+	g_async_stop = 1;
+	g_cond_signal(&g_async_cond);
+	g_mutex_unlock(&g_async_lock);
+	g_thread_join(g_async_flusher);
+	g_mutex_lock(&g_async_lock);
+	async_drain(!0);
+	g_mutex_unlock(&g_async_lock);
+}
+#else
+BT_HIDDEN
+int bt_log_async_is_enabled(void)
+{
+	return 0;
+}
+
+BT_HIDDEN
+int bt_log_async_write(const int lvl, const char *const tag,
+					   const char *const func, const char *const file,
+					   const unsigned line, const char *const text,
+					   const size_t text_sz)
+{
+	VAR_UNUSED(lvl);
+	VAR_UNUSED(tag);
+	VAR_UNUSED(func);
+	VAR_UNUSED(file);
+	VAR_UNUSED(line);
+	VAR_UNUSED(text);
+	VAR_UNUSED(text_sz);
+	return 0;
+}
+#endif
+
 BT_HIDDEN
 void bt_log_set_tag_prefix(const char *const prefix)
 {
@@ -1279,48 +1847,34 @@ static void _bt_log_write_imp(
 	msg.lvl = lvl;
 	msg.tag = tag;
 	g_buffer_cb(&msg, buf);
-	const char *rst_color_p = bt_common_color_reset();
-	const char *rst_color_e = rst_color_p + strlen(rst_color_p);
-	const char *color_p = "";
-	const char *color_e = color_p;
-
-	switch (lvl) {
-	case BT_LOG_INFO:
-		color_p = bt_common_color_fg_blue();
-		color_e = color_p + strlen(color_p);
-		break;
-	case BT_LOG_WARNING:
-		color_p = bt_common_color_fg_yellow();
-		color_e = color_p + strlen(color_p);
-		break;
-	case BT_LOG_ERROR:
-	case BT_LOG_FATAL:
-		color_p = bt_common_color_fg_red();
-		color_e = color_p + strlen(color_p);
-		break;
-	default:
-		break;
-	}
-
-	msg.p = put_stringn(color_p, color_e, msg.p, msg.e);
-
-	if (BT_LOG_PUT_CTX & mask)
+#if BT_LOG_USE_ASYNC
+	/* Memory dumps, custom specs and fatal messages (the process is
+	 * about to abort) are always written synchronously.
+	 */
+	if (&global_spec == log && 0 == mem && BT_LOG_FATAL > lvl &&
+		async_is_used())
 	{
-		put_ctx(&msg);
-	}
-	if (BT_LOG_PUT_TAG & mask)
-	{
-		put_tag(&msg, tag);
-	}
-	if (0 != src && BT_LOG_PUT_SRC & mask)
-	{
-		put_src(&msg, src);
+		va_list va_async;
+		int written;
+		va_copy(va_async, va);
+		put_msg(&msg, fmt, va_async);
+		va_end(va_async);
+		written = bt_lib_log_async_write(lvl, tag, src? src->func: 0,
+				src? src->file: 0, src? src->line: 0, msg.msg_b,
+				(size_t)(msg.p - msg.msg_b));
+		if (written)
+		{
+			return;
+		}
+		g_buffer_cb(&msg, buf);
 	}
+#endif
+	put_head(&msg, mask, 0, src, tag);
 	if (BT_LOG_PUT_MSG & mask)
 	{
 		put_msg(&msg, fmt, va);
 	}
-	msg.p = put_stringn(rst_color_p, rst_color_e, msg.p, msg.e);
+	put_tail(&msg);
 	log->output->callback(&msg, log->output->arg);
 	if (0 != mem && BT_LOG_PUT_MSG & mask)
 	{
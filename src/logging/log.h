@@ -558,6 +558,29 @@ static _BT_LOG_INLINE void bt_log_set_output_p(const bt_log_output *const output
 	bt_log_set_output_v(output->mask, output->arg, output->callback);
 }
 
+/* Asynchronous backend of libbabeltrace2 (see `src/lib/logging.c`).
+ *
+ * bt_log_async_is_enabled() returns whether the backend is enabled
+ * (BABELTRACE_LOGGING_ASYNC environment variable set to `1`), starting
+ * its flusher thread the first time.
+ *
+ * bt_log_async_write() records a log statement, of which `text` is the
+ * formatted message (`text_sz` bytes, not null-terminated), to be
+ * written later by the flusher thread. It returns zero if the log
+ * statement must be written synchronously instead.
+ *
+ * Only the instance of libbabeltrace2 is used: the other modules call
+ * those functions through bt_lib_log_async_is_enabled() and
+ * bt_lib_log_async_write().
+ */
+BT_HIDDEN
+int bt_log_async_is_enabled(void);
+
+BT_HIDDEN
+int bt_log_async_write(int lvl, const char *tag, const char *func,
+		const char *file, unsigned line, const char *text,
+		size_t text_sz);
+
 /* Used with _AUX macros and allows to override global format and output
  * facility. Use BT_LOG_GLOBAL_FORMAT and BT_LOG_GLOBAL_OUTPUT for values from
  * global configuration. Example:
@@ -337,6 +337,20 @@ BT_HIDDEN
 int ctf_visitor_generate_ir_visit_node(struct ctf_visitor_generate_ir *visitor,
 		struct ctf_node *node);
 
+/*
+ * Makes `visitor` use the CTF IR trace class `tc` (which the visitor
+ * takes ownership of) instead of the result of visiting a metadata
+ * AST, and translates it to its trace IR trace class, if any.
+ *
+ * `tc` is a CTF IR trace class on which all the metadata passes ran,
+ * except the dispatch tables one, as loaded from the metadata cache.
+ * The visitor must not have visited any node.
+ */
+BT_HIDDEN
+int ctf_visitor_generate_ir_set_ctf_trace_class(
+		struct ctf_visitor_generate_ir *visitor,
+		struct ctf_trace_class *tc);
+
 BT_HIDDEN
 int ctf_visitor_semantic_check(int depth, struct ctf_node *node,
 		struct meta_log_config *log_cfg);
@@ -0,0 +1,1160 @@
+/*
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#define BT_COMP_LOG_SELF_COMP (log_cfg->self_comp)
+#define BT_LOG_OUTPUT_LEVEL (log_cfg->log_level)
+#define BT_LOG_TAG "PLUGIN/CTF/META/CACHE"
+#include "logging/comp-logging.h"
+
+#include <babeltrace2/babeltrace.h>
+#include "common/macros.h"
+#include "common/assert.h"
+#include <glib.h>
+#include <stdint.h>
+#include <string.h>
+#include <inttypes.h>
+
+#include "ctf-meta-cache.h"
+#include "decoder.h"
+#include "logging.h"
+
+#define CTF_META_CACHE_MAGIC		UINT32_C(0xc7fcac4e)
+
+/*
+ * Version of the serialization format: increment it when changing
+ * what this file reads and writes, or when changing what the metadata
+ * passes compute, so that the existing entries become cache misses.
+ */
+#define CTF_META_CACHE_VERSION		1
+
+#define CTF_META_CACHE_FILE_SUFFIX	".ctfmc"
+
+/* Serialization state */
+struct writer {
+	GByteArray *buf;
+};
+
+/*
+ * Deserialization state.
+ *
+ * An error is sticky: once `error` is true, all the read functions
+ * return zero values, so that the callers only need to check it once
+ * in a while.
+ */
+struct reader {
+	const uint8_t *data;
+	size_t len;
+	size_t at;
+	bool error;
+};
+
+static
+void write_bytes(struct writer *w, const void *data, size_t len)
+{
+	g_byte_array_append(w->buf, data, len);
+}
+
+static
+void write_u64(struct writer *w, uint64_t val)
+{
+	write_bytes(w, &val, sizeof(val));
+}
+
+static
+void write_i64(struct writer *w, int64_t val)
+{
+	write_bytes(w, &val, sizeof(val));
+}
+
+static
+void write_bool(struct writer *w, bool val)
+{
+	uint8_t u8 = val ? 1 : 0;
+
+	write_bytes(w, &u8, sizeof(u8));
+}
+
+static
+void write_str(struct writer *w, const GString *str)
+{
+	write_u64(w, str->len);
+	write_bytes(w, str->str, str->len);
+}
+
+static
+void write_field_path(struct writer *w, struct ctf_field_path *fp)
+{
+	uint64_t i;
+
+	write_i64(w, fp->root);
+	write_u64(w, fp->path->len);
+
+	for (i = 0; i < fp->path->len; i++) {
+		write_i64(w, ctf_field_path_borrow_index_by_index(fp, i));
+	}
+}
+
+static
+int64_t clock_class_index(struct ctf_trace_class *tc,
+		struct ctf_clock_class *cc)
+{
+	uint64_t i;
+
+	if (!cc) {
+		return -1;
+	}
+
+	for (i = 0; i < tc->clock_classes->len; i++) {
+		if (tc->clock_classes->pdata[i] == cc) {
+			return (int64_t) i;
+		}
+	}
+
+	bt_common_abort();
+}
+
+static
+void write_named_field_class(struct writer *w, struct ctf_trace_class *tc,
+		struct ctf_named_field_class *named_fc);
+
+static
+void write_field_class(struct writer *w, struct ctf_trace_class *tc,
+		struct ctf_field_class *fc)
+{
+	uint64_t i;
+
+	write_bool(w, fc);
+	if (!fc) {
+		return;
+	}
+
+	write_u64(w, fc->type);
+	write_u64(w, fc->alignment);
+	write_bool(w, fc->in_ir);
+
+	switch (fc->type) {
+	case CTF_FIELD_CLASS_TYPE_INT:
+	case CTF_FIELD_CLASS_TYPE_ENUM:
+	{
+		struct ctf_field_class_int *int_fc = (void *) fc;
+
+		write_u64(w, int_fc->base.byte_order);
+		write_u64(w, int_fc->base.size);
+		write_u64(w, int_fc->meaning);
+		write_bool(w, int_fc->is_signed);
+		write_u64(w, int_fc->disp_base);
+		write_u64(w, int_fc->encoding);
+		write_i64(w, int_fc->storing_index);
+		write_i64(w, clock_class_index(tc, int_fc->mapped_clock_class));
+
+		if (fc->type == CTF_FIELD_CLASS_TYPE_ENUM) {
+			struct ctf_field_class_enum *enum_fc = (void *) fc;
+
+			write_u64(w, enum_fc->mappings->len);
+
+			for (i = 0; i < enum_fc->mappings->len; i++) {
+				struct ctf_field_class_enum_mapping *mapping =
+					ctf_field_class_enum_borrow_mapping_by_index(
+						enum_fc, i);
+
+				write_str(w, mapping->label);
+				write_u64(w, mapping->ranges->len);
+				write_bytes(w, mapping->ranges->data,
+					mapping->ranges->len *
+						sizeof(struct ctf_range));
+			}
+		}
+
+		break;
+	}
+	case CTF_FIELD_CLASS_TYPE_FLOAT:
+	{
+		struct ctf_field_class_float *float_fc = (void *) fc;
+
+		write_u64(w, float_fc->base.byte_order);
+		write_u64(w, float_fc->base.size);
+		break;
+	}
+	case CTF_FIELD_CLASS_TYPE_STRING:
+	{
+		struct ctf_field_class_string *string_fc = (void *) fc;
+
+		write_u64(w, string_fc->encoding);
+		break;
+	}
+	case CTF_FIELD_CLASS_TYPE_STRUCT:
+	{
+		struct ctf_field_class_struct *struct_fc = (void *) fc;
+
+		write_u64(w, struct_fc->members->len);
+
+		for (i = 0; i < struct_fc->members->len; i++) {
+			write_named_field_class(w, tc,
+				ctf_field_class_struct_borrow_member_by_index(
+					struct_fc, i));
+		}
+
+		break;
+	}
+	case CTF_FIELD_CLASS_TYPE_ARRAY:
+	{
+		struct ctf_field_class_array *array_fc = (void *) fc;
+
+		write_field_class(w, tc, array_fc->base.elem_fc);
+		write_bool(w, array_fc->base.is_text);
+		write_u64(w, array_fc->meaning);
+		write_u64(w, array_fc->length);
+		break;
+	}
+	case CTF_FIELD_CLASS_TYPE_SEQUENCE:
+	{
+		struct ctf_field_class_sequence *seq_fc = (void *) fc;
+
+		write_field_class(w, tc, seq_fc->base.elem_fc);
+		write_bool(w, seq_fc->base.is_text);
+		write_str(w, seq_fc->length_ref);
+		write_field_path(w, &seq_fc->length_path);
+		write_u64(w, seq_fc->stored_length_index);
+		break;
+	}
+	case CTF_FIELD_CLASS_TYPE_VARIANT:
+	{
+		struct ctf_field_class_variant *var_fc = (void *) fc;
+
+		write_str(w, var_fc->tag_ref);
+		write_field_path(w, &var_fc->tag_path);
+		write_u64(w, var_fc->stored_tag_index);
+		write_u64(w, var_fc->options->len);
+
+		for (i = 0; i < var_fc->options->len; i++) {
+			write_named_field_class(w, tc,
+				ctf_field_class_variant_borrow_option_by_index(
+					var_fc, i));
+		}
+
+		break;
+	}
+	default:
+		bt_common_abort();
+	}
+}
+
+static
+void write_named_field_class(struct writer *w, struct ctf_trace_class *tc,
+		struct ctf_named_field_class *named_fc)
+{
+	/* The translated name is computed again from the original name */
+	write_str(w, named_fc->orig_name);
+	write_field_class(w, tc, named_fc->fc);
+}
+
+static
+void write_event_class(struct writer *w, struct ctf_trace_class *tc,
+		struct ctf_event_class *ec)
+{
+	write_str(w, ec->name);
+	write_u64(w, ec->id);
+	write_str(w, ec->emf_uri);
+	write_u64(w, ec->log_level);
+	write_bool(w, ec->is_log_level_set);
+	write_field_class(w, tc, ec->spec_context_fc);
+	write_field_class(w, tc, ec->payload_fc);
+}
+
+static
+void write_stream_class(struct writer *w, struct ctf_trace_class *tc,
+		struct ctf_stream_class *sc)
+{
+	uint64_t i;
+
+	write_u64(w, sc->id);
+	write_bool(w, sc->packets_have_ts_begin);
+	write_bool(w, sc->packets_have_ts_end);
+	write_bool(w, sc->has_discarded_events);
+	write_bool(w, sc->has_discarded_packets);
+	write_bool(w, sc->discarded_events_have_default_cs);
+	write_bool(w, sc->discarded_packets_have_default_cs);
+	write_field_class(w, tc, sc->packet_context_fc);
+	write_field_class(w, tc, sc->event_header_fc);
+	write_field_class(w, tc, sc->event_common_context_fc);
+	write_i64(w, clock_class_index(tc, sc->default_clock_class));
+	write_u64(w, sc->event_classes->len);
+
+	for (i = 0; i < sc->event_classes->len; i++) {
+		write_event_class(w, tc, sc->event_classes->pdata[i]);
+	}
+}
+
+static
+void write_clock_class(struct writer *w, struct ctf_clock_class *cc)
+{
+	write_str(w, cc->name);
+	write_str(w, cc->description);
+	write_u64(w, cc->frequency);
+	write_u64(w, cc->precision);
+	write_i64(w, cc->offset_seconds);
+	write_u64(w, cc->offset_cycles);
+	write_bytes(w, cc->uuid, sizeof(cc->uuid));
+	write_bool(w, cc->has_uuid);
+	write_bool(w, cc->is_absolute);
+}
+
+static
+void write_trace_class(struct writer *w, struct ctf_trace_class *tc)
+{
+	uint32_t header[2] = { CTF_META_CACHE_MAGIC, CTF_META_CACHE_VERSION };
+	uint64_t i;
+
+	write_bytes(w, header, sizeof(header));
+	write_u64(w, tc->major);
+	write_u64(w, tc->minor);
+	write_bytes(w, tc->uuid, sizeof(tc->uuid));
+	write_bool(w, tc->is_uuid_set);
+	write_u64(w, tc->default_byte_order);
+	write_u64(w, tc->stored_value_count);
+	write_u64(w, tc->clock_classes->len);
+
+	for (i = 0; i < tc->clock_classes->len; i++) {
+		write_clock_class(w, tc->clock_classes->pdata[i]);
+	}
+
+	write_u64(w, tc->env_entries->len);
+
+	for (i = 0; i < tc->env_entries->len; i++) {
+		struct ctf_trace_class_env_entry *entry =
+			ctf_trace_class_borrow_env_entry_by_index(tc, i);
+
+		write_u64(w, entry->type);
+		write_str(w, entry->name);
+		write_i64(w, entry->value.i);
+		write_str(w, entry->value.str);
+	}
+
+	write_field_class(w, tc, tc->packet_header_fc);
+	write_u64(w, tc->stream_classes->len);
+
+	for (i = 0; i < tc->stream_classes->len; i++) {
+		write_stream_class(w, tc, tc->stream_classes->pdata[i]);
+	}
+}
+
+static
+const void *read_bytes(struct reader *r, size_t len)
+{
+	const void *data;
+
+	if (r->error || len > r->len - r->at) {
+		r->error = true;
+		return NULL;
+	}
+
+	data = &r->data[r->at];
+	r->at += len;
+	return data;
+}
+
+static
+uint64_t read_u64(struct reader *r)
+{
+	const void *data = read_bytes(r, sizeof(uint64_t));
+	uint64_t val = 0;
+
+	if (data) {
+		memcpy(&val, data, sizeof(val));
+	}
+
+	return val;
+}
+
+static
+int64_t read_i64(struct reader *r)
+{
+	return (int64_t) read_u64(r);
+}
+
+static
+bool read_bool(struct reader *r)
+{
+	const uint8_t *data = read_bytes(r, 1);
+
+	return data && *data;
+}
+
+/*
+ * Reads an element count, failing if there are not at least
+ * `min_elem_size` bytes left for each element: this prevents huge
+ * allocations because of an invalid count.
+ */
+static
+uint64_t read_count(struct reader *r, size_t min_elem_size)
+{
+	uint64_t count = read_u64(r);
+
+	if (!r->error && count > (r->len - r->at) / min_elem_size) {
+		r->error = true;
+	}
+
+	return r->error ? 0 : count;
+}
+
+static
+void read_str(struct reader *r, GString *str)
+{
+	uint64_t len = read_count(r, 1);
+	const char *data = read_bytes(r, len);
+
+	g_string_truncate(str, 0);
+
+	if (data) {
+		g_string_append_len(str, data, len);
+	}
+}
+
+static
+void read_field_path(struct reader *r, struct ctf_field_path *fp)
+{
+	uint64_t len, i;
+
+	fp->root = read_i64(r);
+	len = read_count(r, sizeof(int64_t));
+
+	for (i = 0; i < len; i++) {
+		ctf_field_path_append_index(fp, read_i64(r));
+	}
+}
+
+static
+struct ctf_clock_class *read_clock_class_ref(struct reader *r,
+		struct ctf_trace_class *tc)
+{
+	int64_t index = read_i64(r);
+
+	if (index < 0) {
+		return NULL;
+	}
+
+	if ((uint64_t) index >= tc->clock_classes->len) {
+		r->error = true;
+		return NULL;
+	}
+
+	return tc->clock_classes->pdata[index];
+}
+
+static
+struct ctf_field_class *read_field_class(struct reader *r,
+		struct ctf_trace_class *tc);
+
+static
+void read_int_field_class_content(struct reader *r,
+		struct ctf_trace_class *tc, struct ctf_field_class_int *int_fc)
+{
+	int_fc->base.byte_order = read_u64(r);
+	int_fc->base.size = read_u64(r);
+	int_fc->meaning = read_u64(r);
+	int_fc->is_signed = read_bool(r);
+	int_fc->disp_base = read_u64(r);
+	int_fc->encoding = read_u64(r);
+	int_fc->storing_index = read_i64(r);
+	int_fc->mapped_clock_class = read_clock_class_ref(r, tc);
+}
+
+static
+struct ctf_field_class *read_field_class(struct reader *r,
+		struct ctf_trace_class *tc)
+{
+	struct ctf_field_class *fc = NULL;
+	enum ctf_field_class_type type;
+	unsigned int alignment;
+	bool in_ir;
+	uint64_t count, i;
+
+	if (!read_bool(r)) {
+		/* No field class, or error */
+		goto end;
+	}
+
+	type = read_u64(r);
+	alignment = read_u64(r);
+	in_ir = read_bool(r);
+	if (r->error) {
+		goto end;
+	}
+
+	switch (type) {
+	case CTF_FIELD_CLASS_TYPE_INT:
+	{
+		struct ctf_field_class_int *int_fc =
+			ctf_field_class_int_create();
+
+		fc = (void *) int_fc;
+		read_int_field_class_content(r, tc, int_fc);
+		break;
+	}
+	case CTF_FIELD_CLASS_TYPE_ENUM:
+	{
+		struct ctf_field_class_enum *enum_fc =
+			ctf_field_class_enum_create();
+
+		fc = (void *) enum_fc;
+		read_int_field_class_content(r, tc, (void *) enum_fc);
+		count = read_count(r, sizeof(uint64_t) * 2);
+
+		for (i = 0; i < count && !r->error; i++) {
+			struct ctf_field_class_enum_mapping *mapping;
+			uint64_t range_count;
+			const void *ranges;
+
+			g_array_set_size(enum_fc->mappings,
+				enum_fc->mappings->len + 1);
+			mapping = ctf_field_class_enum_borrow_mapping_by_index(
+				enum_fc, enum_fc->mappings->len - 1);
+			_ctf_field_class_enum_mapping_init(mapping);
+			read_str(r, mapping->label);
+			range_count = read_count(r, sizeof(struct ctf_range));
+			ranges = read_bytes(r,
+				range_count * sizeof(struct ctf_range));
+			if (ranges) {
+				g_array_append_vals(mapping->ranges, ranges,
+					range_count);
+			}
+		}
+
+		break;
+	}
+	case CTF_FIELD_CLASS_TYPE_FLOAT:
+	{
+		struct ctf_field_class_float *float_fc =
+			ctf_field_class_float_create();
+
+		fc = (void *) float_fc;
+		float_fc->base.byte_order = read_u64(r);
+		float_fc->base.size = read_u64(r);
+		break;
+	}
+	case CTF_FIELD_CLASS_TYPE_STRING:
+	{
+		struct ctf_field_class_string *string_fc =
+			ctf_field_class_string_create();
+
+		fc = (void *) string_fc;
+		string_fc->encoding = read_u64(r);
+		break;
+	}
+	case CTF_FIELD_CLASS_TYPE_STRUCT:
+	{
+		struct ctf_field_class_struct *struct_fc =
+			ctf_field_class_struct_create();
+
+		fc = (void *) struct_fc;
+		count = read_count(r, sizeof(uint64_t) + 1);
+
+		for (i = 0; i < count && !r->error; i++) {
+			GString *orig_name = g_string_new(NULL);
+			struct ctf_field_class *member_fc;
+
+			read_str(r, orig_name);
+			member_fc = read_field_class(r, tc);
+			if (member_fc) {
+				ctf_field_class_struct_append_member(struct_fc,
+					orig_name->str, member_fc);
+			} else {
+				r->error = true;
+			}
+
+			g_string_free(orig_name, TRUE);
+		}
+
+		break;
+	}
+	case CTF_FIELD_CLASS_TYPE_ARRAY:
+	{
+		struct ctf_field_class_array *array_fc =
+			ctf_field_class_array_create();
+
+		fc = (void *) array_fc;
+		array_fc->base.elem_fc = read_field_class(r, tc);
+		array_fc->base.is_text = read_bool(r);
+		array_fc->meaning = read_u64(r);
+		array_fc->length = read_u64(r);
+		if (!array_fc->base.elem_fc) {
+			r->error = true;
+		}
+
+		break;
+	}
+	case CTF_FIELD_CLASS_TYPE_SEQUENCE:
+	{
+		struct ctf_field_class_sequence *seq_fc =
+			ctf_field_class_sequence_create();
+
+		fc = (void *) seq_fc;
+		seq_fc->base.elem_fc = read_field_class(r, tc);
+		seq_fc->base.is_text = read_bool(r);
+		read_str(r, seq_fc->length_ref);
+		read_field_path(r, &seq_fc->length_path);
+		seq_fc->stored_length_index = read_u64(r);
+		if (!seq_fc->base.elem_fc) {
+			r->error = true;
+		}
+
+		break;
+	}
+	case CTF_FIELD_CLASS_TYPE_VARIANT:
+	{
+		struct ctf_field_class_variant *var_fc =
+			ctf_field_class_variant_create();
+
+		fc = (void *) var_fc;
+		read_str(r, var_fc->tag_ref);
+		read_field_path(r, &var_fc->tag_path);
+		var_fc->stored_tag_index = read_u64(r);
+		count = read_count(r, sizeof(uint64_t) + 1);
+
+		for (i = 0; i < count && !r->error; i++) {
+			GString *orig_name = g_string_new(NULL);
+			struct ctf_field_class *option_fc;
+
+			read_str(r, orig_name);
+			option_fc = read_field_class(r, tc);
+			if (option_fc) {
+				ctf_field_class_variant_append_option(var_fc,
+					orig_name->str, option_fc);
+			} else {
+				r->error = true;
+			}
+
+			g_string_free(orig_name, TRUE);
+		}
+
+		break;
+	}
+	default:
+		r->error = true;
+		goto end;
+	}
+
+	/*
+	 * Set the alignment last: appending a structure member can
+	 * change it.
+	 */
+	fc->alignment = alignment;
+	fc->in_ir = in_ir;
+
+	if (r->error) {
+		ctf_field_class_destroy(fc);
+		fc = NULL;
+	}
+
+end:
+	return fc;
+}
+
+static
+struct ctf_event_class *read_event_class(struct reader *r,
+		struct ctf_trace_class *tc)
+{
+	struct ctf_event_class *ec = ctf_event_class_create();
+
+	read_str(r, ec->name);
+	ec->id = read_u64(r);
+	read_str(r, ec->emf_uri);
+	ec->log_level = read_u64(r);
+	ec->is_log_level_set = read_bool(r);
+	ec->spec_context_fc = read_field_class(r, tc);
+	ec->payload_fc = read_field_class(r, tc);
+	if (r->error) {
+		ctf_event_class_destroy(ec);
+		ec = NULL;
+	}
+
+	return ec;
+}
+
+static
+struct ctf_stream_class *read_stream_class(struct reader *r,
+		struct ctf_trace_class *tc)
+{
+	struct ctf_stream_class *sc = ctf_stream_class_create();
+	uint64_t count, i;
+
+	sc->id = read_u64(r);
+	sc->packets_have_ts_begin = read_bool(r);
+	sc->packets_have_ts_end = read_bool(r);
+	sc->has_discarded_events = read_bool(r);
+	sc->has_discarded_packets = read_bool(r);
+	sc->discarded_events_have_default_cs = read_bool(r);
+	sc->discarded_packets_have_default_cs = read_bool(r);
+	sc->packet_context_fc = read_field_class(r, tc);
+	sc->event_header_fc = read_field_class(r, tc);
+	sc->event_common_context_fc = read_field_class(r, tc);
+	sc->default_clock_class = read_clock_class_ref(r, tc);
+	count = read_count(r, sizeof(uint64_t) * 3);
+
+	for (i = 0; i < count && !r->error; i++) {
+		struct ctf_event_class *ec = read_event_class(r, tc);
+
+		if (ec) {
+			ctf_stream_class_append_event_class(sc, ec);
+		}
+	}
+
+	if (r->error) {
+		ctf_stream_class_destroy(sc);
+		sc = NULL;
+	}
+
+	return sc;
+}
+
+static
+struct ctf_clock_class *read_clock_class(struct reader *r)
+{
+	struct ctf_clock_class *cc = ctf_clock_class_create();
+	const void *uuid;
+
+	read_str(r, cc->name);
+	read_str(r, cc->description);
+	cc->frequency = read_u64(r);
+	cc->precision = read_u64(r);
+	cc->offset_seconds = read_i64(r);
+	cc->offset_cycles = read_u64(r);
+	uuid = read_bytes(r, sizeof(cc->uuid));
+	if (uuid) {
+		memcpy(cc->uuid, uuid, sizeof(cc->uuid));
+	}
+
+	cc->has_uuid = read_bool(r);
+	cc->is_absolute = read_bool(r);
+	if (r->error) {
+		ctf_clock_class_destroy(cc);
+		cc = NULL;
+	}
+
+	return cc;
+}
+
+static
+struct ctf_trace_class *read_trace_class(struct reader *r)
+{
+	struct ctf_trace_class *tc = ctf_trace_class_create();
+	const uint32_t *header;
+	const void *uuid;
+	uint64_t count, i;
+
+	header = read_bytes(r, sizeof(uint32_t) * 2);
+	if (!header || header[0] != CTF_META_CACHE_MAGIC ||
+			header[1] != CTF_META_CACHE_VERSION) {
+		r->error = true;
+		goto end;
+	}
+
+	tc->major = read_u64(r);
+	tc->minor = read_u64(r);
+	uuid = read_bytes(r, sizeof(tc->uuid));
+	if (uuid) {
+		memcpy(tc->uuid, uuid, sizeof(tc->uuid));
+	}
+
+	tc->is_uuid_set = read_bool(r);
+	tc->default_byte_order = read_u64(r);
+	tc->stored_value_count = read_u64(r);
+	count = read_count(r, sizeof(uint64_t) * 2);
+
+	for (i = 0; i < count && !r->error; i++) {
+		struct ctf_clock_class *cc = read_clock_class(r);
+
+		if (cc) {
+			g_ptr_array_add(tc->clock_classes, cc);
+		}
+	}
+
+	count = read_count(r, sizeof(uint64_t) * 3);
+
+	for (i = 0; i < count && !r->error; i++) {
+		enum ctf_trace_class_env_entry_type type = read_u64(r);
+		GString *name = g_string_new(NULL);
+		GString *str_value = g_string_new(NULL);
+		int64_t i_value;
+
+		read_str(r, name);
+		i_value = read_i64(r);
+		read_str(r, str_value);
+		if (!r->error) {
+			ctf_trace_class_append_env_entry(tc, name->str, type,
+				str_value->str, i_value);
+		}
+
+		g_string_free(name, TRUE);
+		g_string_free(str_value, TRUE);
+	}
+
+	tc->packet_header_fc = read_field_class(r, tc);
+	count = read_count(r, sizeof(uint64_t) * 2);
+
+	for (i = 0; i < count && !r->error; i++) {
+		struct ctf_stream_class *sc = read_stream_class(r, tc);
+
+		if (sc) {
+			g_ptr_array_add(tc->stream_classes, sc);
+		}
+	}
+
+	if (r->at != r->len) {
+		/* Trailing data */
+		r->error = true;
+	}
+
+end:
+	if (r->error) {
+		ctf_trace_class_destroy(tc);
+		tc = NULL;
+	}
+
+	return tc;
+}
+
+/*
+ * Borrows the field class located at `fp`, within the scope `scope`
+ * of `sc` and `ec`, checking everything as the field path comes from
+ * a cache file.
+ */
+static
+struct ctf_field_class *borrow_field_class_from_path(
+		struct ctf_field_path *fp, enum ctf_scope scope,
+		struct ctf_trace_class *tc, struct ctf_stream_class *sc,
+		struct ctf_event_class *ec)
+{
+	struct ctf_field_class *fc = NULL;
+	uint64_t i;
+
+	if (fp->root < CTF_SCOPE_PACKET_HEADER || fp->root > scope) {
+		goto end;
+	}
+
+	switch (fp->root) {
+	case CTF_SCOPE_PACKET_HEADER:
+		fc = tc->packet_header_fc;
+		break;
+	case CTF_SCOPE_PACKET_CONTEXT:
+		fc = sc ? sc->packet_context_fc : NULL;
+		break;
+	case CTF_SCOPE_EVENT_HEADER:
+		fc = sc ? sc->event_header_fc : NULL;
+		break;
+	case CTF_SCOPE_EVENT_COMMON_CONTEXT:
+		fc = sc ? sc->event_common_context_fc : NULL;
+		break;
+	case CTF_SCOPE_EVENT_SPECIFIC_CONTEXT:
+		fc = ec ? ec->spec_context_fc : NULL;
+		break;
+	case CTF_SCOPE_EVENT_PAYLOAD:
+		fc = ec ? ec->payload_fc : NULL;
+		break;
+	default:
+		bt_common_abort();
+	}
+
+	for (i = 0; i < fp->path->len && fc; i++) {
+		int64_t index = ctf_field_path_borrow_index_by_index(fp, i);
+
+		if (!fc->is_compound) {
+			fc = NULL;
+			break;
+		}
+
+		if ((fc->type == CTF_FIELD_CLASS_TYPE_STRUCT ||
+				fc->type == CTF_FIELD_CLASS_TYPE_VARIANT) &&
+				(index < 0 || (uint64_t) index >=
+					ctf_field_class_compound_get_field_class_count(fc))) {
+			fc = NULL;
+			break;
+		}
+
+		fc = ctf_field_class_compound_borrow_field_class_by_index(fc,
+			index);
+	}
+
+end:
+	return fc;
+}
+
+/*
+ * Sets the weak length and tag field classes of the sequence and
+ * variant field classes of `fc` (within the scope `scope`) from their
+ * field paths, and the ranges of the variant field classes from their
+ * tag field class.
+ */
+static
+int link_field_class(struct ctf_field_class *fc, enum ctf_scope scope,
+		struct ctf_trace_class *tc, struct ctf_stream_class *sc,
+		struct ctf_event_class *ec)
+{
+	int ret = 0;
+	uint64_t i;
+
+	if (!fc) {
+		goto end;
+	}
+
+	if (fc->type == CTF_FIELD_CLASS_TYPE_SEQUENCE) {
+		struct ctf_field_class_sequence *seq_fc = (void *) fc;
+		struct ctf_field_class *length_fc =
+			borrow_field_class_from_path(&seq_fc->length_path,
+				scope, tc, sc, ec);
+
+		if (!length_fc || (length_fc->type != CTF_FIELD_CLASS_TYPE_INT &&
+				length_fc->type != CTF_FIELD_CLASS_TYPE_ENUM)) {
+			ret = -1;
+			goto end;
+		}
+
+		seq_fc->length_fc = (void *) length_fc;
+	} else if (fc->type == CTF_FIELD_CLASS_TYPE_VARIANT) {
+		struct ctf_field_class_variant *var_fc = (void *) fc;
+		struct ctf_field_class *tag_fc =
+			borrow_field_class_from_path(&var_fc->tag_path,
+				scope, tc, sc, ec);
+
+		if (!tag_fc || tag_fc->type != CTF_FIELD_CLASS_TYPE_ENUM) {
+			ret = -1;
+			goto end;
+		}
+
+		ctf_field_class_variant_set_tag_field_class(var_fc,
+			(void *) tag_fc);
+	}
+
+	if (!fc->is_compound) {
+		goto end;
+	}
+
+	for (i = 0; i < ctf_field_class_compound_get_field_class_count(fc);
+			i++) {
+		ret = link_field_class(
+			ctf_field_class_compound_borrow_field_class_by_index(
+				fc, i),
+			scope, tc, sc, ec);
+		if (ret) {
+			goto end;
+		}
+	}
+
+end:
+	return ret;
+}
+
+static
+int link_trace_class(struct ctf_trace_class *tc)
+{
+	int ret;
+	uint64_t sc_i, ec_i;
+
+	ret = link_field_class(tc->packet_header_fc, CTF_SCOPE_PACKET_HEADER,
+		tc, NULL, NULL);
+	if (ret) {
+		goto end;
+	}
+
+	for (sc_i = 0; sc_i < tc->stream_classes->len; sc_i++) {
+		struct ctf_stream_class *sc = tc->stream_classes->pdata[sc_i];
+
+		ret = link_field_class(sc->packet_context_fc,
+			CTF_SCOPE_PACKET_CONTEXT, tc, sc, NULL);
+		if (ret) {
+			goto end;
+		}
+
+		ret = link_field_class(sc->event_header_fc,
+			CTF_SCOPE_EVENT_HEADER, tc, sc, NULL);
+		if (ret) {
+			goto end;
+		}
+
+		ret = link_field_class(sc->event_common_context_fc,
+			CTF_SCOPE_EVENT_COMMON_CONTEXT, tc, sc, NULL);
+		if (ret) {
+			goto end;
+		}
+
+		for (ec_i = 0; ec_i < sc->event_classes->len; ec_i++) {
+			struct ctf_event_class *ec =
+				sc->event_classes->pdata[ec_i];
+
+			ret = link_field_class(ec->spec_context_fc,
+				CTF_SCOPE_EVENT_SPECIFIC_CONTEXT, tc, sc, ec);
+			if (ret) {
+				goto end;
+			}
+
+			ret = link_field_class(ec->payload_fc,
+				CTF_SCOPE_EVENT_PAYLOAD, tc, sc, ec);
+			if (ret) {
+				goto end;
+			}
+		}
+	}
+
+end:
+	return ret;
+}
+
+static
+gchar *cache_file_path(const char *cache_dir, const char *key)
+{
+	gchar *basename = g_strconcat(key, CTF_META_CACHE_FILE_SUFFIX, NULL);
+	gchar *path = g_build_filename(cache_dir, basename, NULL);
+
+	g_free(basename);
+	return path;
+}
+
+BT_HIDDEN
+gchar *ctf_meta_cache_key(const char *text, size_t len,
+		const struct ctf_metadata_decoder_config *config)
+{
+	GChecksum *checksum = g_checksum_new(G_CHECKSUM_SHA256);
+	gchar *config_str;
+	gchar *key;
+
+	BT_ASSERT(checksum);
+
+	/*
+	 * The clock class offsets are applied while visiting the AST,
+	 * and the "in IR" pass only runs when there's a trace IR trace
+	 * class: both are part of the key.
+	 *
+	 * So are the package version, as another version can compute
+	 * something else without changing `CTF_META_CACHE_VERSION`, and
+	 * the size of the ranges, which this file reads and writes as
+	 * is.
+	 */
+	config_str = g_strdup_printf("%s;%d;%zu;%" PRId64 ";%" PRId64 ";%d;%d;",
+		VERSION, CTF_META_CACHE_VERSION, sizeof(struct ctf_range),
+		config->clock_class_offset_s,
+		config->clock_class_offset_ns,
+		(int) config->force_clock_class_origin_unix_epoch,
+		(int) (config->self_comp != NULL));
+	g_checksum_update(checksum, (const guchar *) config_str, -1);
+	g_checksum_update(checksum, (const guchar *) text, len);
+	key = g_strdup(g_checksum_get_string(checksum));
+	g_free(config_str);
+	g_checksum_free(checksum);
+	return key;
+}
+
+BT_HIDDEN
+struct ctf_trace_class *ctf_meta_cache_load(const char *cache_dir,
+		const char *key, struct meta_log_config *log_cfg)
+{
+	struct ctf_trace_class *tc = NULL;
+	gchar *path = cache_file_path(cache_dir, key);
+	GMappedFile *mapped_file;
+	GError *error = NULL;
+	struct reader r = { 0 };
+
+	mapped_file = g_mapped_file_new(path, FALSE, &error);
+	if (!mapped_file) {
+		if (g_error_matches(error, G_FILE_ERROR, G_FILE_ERROR_NOENT)) {
+			BT_COMP_LOGD("Metadata cache miss: path=\"%s\"", path);
+		} else {
+			BT_COMP_LOGW("Cannot open metadata cache file: "
+				"path=\"%s\", msg=\"%s\"", path,
+				error->message);
+		}
+
+		goto end;
+	}
+
+	r.data = (const uint8_t *) g_mapped_file_get_contents(mapped_file);
+	r.len = g_mapped_file_get_length(mapped_file);
+	tc = read_trace_class(&r);
+	if (!tc) {
+		BT_COMP_LOGW("Invalid metadata cache file: path=\"%s\", "
+			"size=%zu, offset=%zu", path, r.len, r.at);
+		goto end;
+	}
+
+	if (link_trace_class(tc)) {
+		BT_COMP_LOGW("Invalid field path in metadata cache file: "
+			"path=\"%s\"", path);
+		ctf_trace_class_destroy(tc);
+		tc = NULL;
+		goto end;
+	}
+
+	BT_COMP_LOGI("Loaded CTF IR trace class from metadata cache: "
+		"path=\"%s\", stream-class-count=%u", path,
+		tc->stream_classes->len);
+
+end:
+	if (mapped_file) {
+		g_mapped_file_unref(mapped_file);
+	}
+
+	if (error) {
+		g_error_free(error);
+	}
+
+	g_free(path);
+	return tc;
+}
+
+BT_HIDDEN
+int ctf_meta_cache_save(struct ctf_trace_class *tc, const char *cache_dir,
+		const char *key, struct meta_log_config *log_cfg)
+{
+	int ret = 0;
+	gchar *path = cache_file_path(cache_dir, key);
+	GError *error = NULL;
+	struct writer w;
+
+	w.buf = g_byte_array_new();
+	BT_ASSERT(w.buf);
+	write_trace_class(&w, tc);
+
+	if (g_mkdir_with_parents(cache_dir, 0755)) {
+		BT_COMP_LOGW_ERRNO("Cannot create metadata cache directory",
+			": path=\"%s\"", cache_dir);
+		ret = -1;
+		goto end;
+	}
+
+	/* g_file_set_contents() writes a temporary file, then renames it */
+	if (!g_file_set_contents(path, (const gchar *) w.buf->data,
+			w.buf->len, &error)) {
+		BT_COMP_LOGW("Cannot write metadata cache file: "
+			"path=\"%s\", msg=\"%s\"", path, error->message);
+		ret = -1;
+		goto end;
+	}
+
+	BT_COMP_LOGI("Wrote metadata cache file: path=\"%s\", size=%u",
+		path, w.buf->len);
+
+end:
+	if (error) {
+		g_error_free(error);
+	}
+
+	g_byte_array_free(w.buf, TRUE);
+	g_free(path);
+	return ret;
+}
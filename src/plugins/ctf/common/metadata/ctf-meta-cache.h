@@ -0,0 +1,70 @@
+#ifndef _CTF_META_CACHE_H
+#define _CTF_META_CACHE_H
+
+/*
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ */
+
+#include <stddef.h>
+#include <glib.h>
+#include "common/macros.h"
+
+#include "ctf-meta.h"
+
+struct meta_log_config;
+struct ctf_metadata_decoder_config;
+
+/*
+ * Pre-resolved metadata cache.
+ *
+ * A cache entry is a file, in a cache directory, which contains a
+ * compact binary serialization of a CTF IR trace class once all the
+ * metadata passes (resolving, value storing indexes, and the rest)
+ * are done. Its name is a key which depends on the metadata text and
+ * on the decoding configuration, so that a cache directory can be
+ * shared by any number of traces.
+ *
+ * The cache entries are native: they are only valid for the build of
+ * the plugin which wrote them (see `CTF_META_CACHE_VERSION` in
+ * `ctf-meta-cache.c`), and an entry written on a machine with a
+ * different byte order is considered invalid.
+ */
+
+/*
+ * Returns the cache key (new string) of the metadata text `text`
+ * (`len` bytes) decoded with the configuration `config`.
+ */
+BT_HIDDEN
+gchar *ctf_meta_cache_key(const char *text, size_t len,
+		const struct ctf_metadata_decoder_config *config);
+
+/*
+ * Loads the cache entry `key` from the cache directory `cache_dir`.
+ *
+ * Returns a new CTF IR trace class which is not translated yet, or
+ * `NULL` if there's no such entry or if it's invalid.
+ */
+BT_HIDDEN
+struct ctf_trace_class *ctf_meta_cache_load(const char *cache_dir,
+		const char *key, struct meta_log_config *log_cfg);
+
+/*
+ * Saves the CTF IR trace class `tc` as the cache entry `key` of the
+ * cache directory `cache_dir`, creating the directory if needed.
+ *
+ * The entry is written atomically: concurrent readers either find the
+ * complete entry or no entry.
+ */
+BT_HIDDEN
+int ctf_meta_cache_save(struct ctf_trace_class *tc, const char *cache_dir,
+		const char *key, struct meta_log_config *log_cfg);
+
+#endif /* _CTF_META_CACHE_H */
@@ -0,0 +1,153 @@
+/*
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#define BT_COMP_LOG_SELF_COMP (log_cfg->self_comp)
+#define BT_LOG_OUTPUT_LEVEL (log_cfg->log_level)
+#define BT_LOG_TAG "PLUGIN/CTF/META/EC-JOBS"
+#include "logging/comp-logging.h"
+
+#include <babeltrace2/babeltrace.h>
+#include "common/macros.h"
+#include "common/assert.h"
+#include <glib.h>
+#include <stdint.h>
+#include <inttypes.h>
+
+#include "ctf-meta-visitors.h"
+#include "logging.h"
+#include "../worker-pool.h"
+
+/* Minimum number of event classes per worker thread */
+#define MIN_EVENT_CLASSES_PER_WORKER	256
+
+struct ec_job {
+	/* Weak */
+	struct ctf_stream_class *sc;
+
+	/* Weak */
+	struct ctf_event_class *ec;
+
+	/* Result of `func` */
+	int ret;
+
+	/* Output of `func` (passed to `merge_func`) */
+	void *out;
+};
+
+struct ec_jobs_ctx {
+	ctf_event_class_job_func func;
+	void *data;
+
+	/* Array of `struct ec_job` */
+	GArray *jobs;
+};
+
+static
+void run_ec_job(guint job_index, void *worker_data, void *data)
+{
+	struct ec_jobs_ctx *ctx = data;
+	struct ec_job *job = &g_array_index(ctx->jobs, struct ec_job,
+		job_index);
+
+	job->ret = ctx->func(job->sc, job->ec, &job->out, ctx->data);
+}
+
+BT_HIDDEN
+int ctf_trace_class_for_each_event_class(struct ctf_trace_class *tc,
+		ctf_event_class_job_func func,
+		ctf_event_class_job_merge_func merge_func, void *data,
+		struct meta_log_config *log_cfg)
+{
+	int ret = 0;
+	uint64_t i;
+	struct ec_jobs_ctx ctx = {
+		.func = func,
+		.data = data,
+		.jobs = NULL,
+	};
+	const struct ctf_worker_pool_config pool_config = {
+		.thread_name = "bt-ctf-meta-job",
+		.min_jobs_per_worker = MIN_EVENT_CLASSES_PER_WORKER,
+		.init_func = NULL,
+		.job_func = run_ec_job,
+		.fini_func = NULL,
+		.log_level = log_cfg->log_level,
+		.self_comp = log_cfg->self_comp,
+	};
+
+	ctx.jobs = g_array_new(FALSE, TRUE, sizeof(struct ec_job));
+	if (!ctx.jobs) {
+		BT_COMP_LOGE_STR("Failed to allocate one GArray.");
+		ret = -1;
+		goto end;
+	}
+
+	/* Jobs are in stream class, then event class order */
+	for (i = 0; i < tc->stream_classes->len; i++) {
+		struct ctf_stream_class *sc = tc->stream_classes->pdata[i];
+		uint64_t j;
+
+		for (j = 0; j < sc->event_classes->len; j++) {
+			struct ec_job job = {
+				.sc = sc,
+				.ec = sc->event_classes->pdata[j],
+				.ret = 0,
+				.out = NULL,
+			};
+
+			if (job.ec->is_translated) {
+				continue;
+			}
+
+			g_array_append_val(ctx.jobs, job);
+		}
+	}
+
+	ctf_worker_pool_run(&pool_config, ctx.jobs->len, &ctx);
+
+	/*
+	 * Merge the outputs in order on the current thread, and return
+	 * the result of the first failing job so that the outcome does
+	 * not depend on the scheduling of the workers.
+	 */
+	for (i = 0; i < ctx.jobs->len; i++) {
+		struct ec_job *job = &g_array_index(ctx.jobs, struct ec_job, i);
+
+		if (job->ret && !ret) {
+			BT_COMP_LOGE("Event class job failed: "
+				"sc-id=%" PRIu64 ", ec-id=%" PRIu64 ", "
+				"ec-name=\"%s\", ret=%d",
+				job->sc->id, job->ec->id, job->ec->name->str,
+				job->ret);
+			ret = job->ret;
+		}
+
+		if (merge_func) {
+			merge_func(job->sc, job->ec, job->out, data);
+		}
+	}
+
+end:
+	if (ctx.jobs) {
+		g_array_free(ctx.jobs, TRUE);
+	}
+
+	return ret;
+}
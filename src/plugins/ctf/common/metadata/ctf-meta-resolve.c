@@ -1175,7 +1175,7 @@ int resolve_event_class_field_classes(struct resolve_context *ctx,
 
 	ctx->ec = ec;
 	ctx->scopes.event_spec_context = ec->spec_context_fc;
-	ret = resolve_root_class(CTF_SCOPE_EVENT_COMMON_CONTEXT, ctx);
+	ret = resolve_root_class(CTF_SCOPE_EVENT_SPECIFIC_CONTEXT, ctx);
 	if (ret) {
 		BT_COMP_LOGE("Cannot resolve event specific context field class: "
 			"ret=%d", ret);
@@ -1202,7 +1202,6 @@ int resolve_stream_class_field_classes(struct resolve_context *ctx,
 		struct ctf_stream_class *sc)
 {
 	int ret = 0;
-	uint64_t i;
 
 	BT_ASSERT(!ctx->scopes.packet_context);
 	BT_ASSERT(!ctx->scopes.event_header);
@@ -1227,7 +1226,7 @@ int resolve_stream_class_field_classes(struct resolve_context *ctx,
 		}
 
 		ctx->scopes.event_common_context = sc->event_common_context_fc;
-		ret = resolve_root_class(CTF_SCOPE_EVENT_SPECIFIC_CONTEXT, ctx);
+		ret = resolve_root_class(CTF_SCOPE_EVENT_COMMON_CONTEXT, ctx);
 		if (ret) {
 			BT_COMP_LOGE("Cannot resolve event common context field class: "
 				"ret=%d", ret);
@@ -1235,22 +1234,6 @@ int resolve_stream_class_field_classes(struct resolve_context *ctx,
 		}
 	}
 
-	ctx->scopes.packet_context = sc->packet_context_fc;
-	ctx->scopes.event_header = sc->event_header_fc;
-	ctx->scopes.event_common_context = sc->event_common_context_fc;
-
-	for (i = 0; i < sc->event_classes->len; i++) {
-		struct ctf_event_class *ec = sc->event_classes->pdata[i];
-
-		ret = resolve_event_class_field_classes(ctx, ec);
-		if (ret) {
-			BT_COMP_LOGE("Cannot resolve event class's field classes: "
-				"ec-id=%" PRIu64 ", ec-name=\"%s\"",
-				ec->id, ec->name->str);
-			goto end;
-		}
-	}
-
 end:
 	ctx->scopes.packet_context = NULL;
 	ctx->scopes.event_header = NULL;
@@ -1259,6 +1242,69 @@ end:
 	return ret;
 }
 
+struct resolve_event_class_jobs_data {
+	struct ctf_trace_class *tc;
+	struct meta_log_config *log_cfg;
+};
+
+/*
+ * Event class job (see ctf_trace_class_for_each_event_class()): the
+ * field classes of an event class only depend on its own field classes
+ * and on the ones of its stream and trace classes, so that each job
+ * has its own context.
+ *
+ * A job only resolves (modifies) the field classes of its own event
+ * class: resolve_stream_class_field_classes() already resolved the
+ * shared stream class scopes, which jobs only read.
+ */
+static
+int resolve_event_class_job(struct ctf_stream_class *sc,
+		struct ctf_event_class *ec, void **out, void *data)
+{
+	int ret;
+	struct resolve_event_class_jobs_data *jobs_data = data;
+	struct meta_log_config *log_cfg = jobs_data->log_cfg;
+	struct ctf_trace_class *tc = jobs_data->tc;
+	struct resolve_context local_ctx = {
+		.log_level = log_cfg->log_level,
+		.self_comp = log_cfg->self_comp,
+		.tc = tc,
+		.sc = sc,
+		.ec = NULL,
+		.scopes = {
+			.packet_header = tc->packet_header_fc,
+			.packet_context = sc->packet_context_fc,
+			.event_header = sc->event_header_fc,
+			.event_common_context = sc->event_common_context_fc,
+			.event_spec_context = NULL,
+			.event_payload = NULL,
+		},
+		.root_scope = -1,
+		.cur_fc = NULL,
+	};
+	struct resolve_context *ctx = &local_ctx;
+
+	ctx->field_class_stack = field_class_stack_create();
+	if (!ctx->field_class_stack) {
+		BT_COMP_LOGE_STR("Cannot create field class stack.");
+		ret = -1;
+		goto end;
+	}
+
+	ret = resolve_event_class_field_classes(ctx, ec);
+	if (ret) {
+		BT_COMP_LOGE("Cannot resolve event class's field classes: "
+			"sc-id=%" PRIu64 ", ec-id=%" PRIu64 ", "
+			"ec-name=\"%s\"",
+			sc->id, ec->id, ec->name->str);
+		goto end;
+	}
+
+end:
+	field_class_stack_destroy(ctx->field_class_stack);
+	return ret;
+}
+
 BT_HIDDEN
 int ctf_trace_class_resolve_field_classes(struct ctf_trace_class *tc,
 		struct meta_log_config *log_cfg)
@@ -1283,6 +1329,7 @@ int ctf_trace_class_resolve_field_classes(struct ctf_trace_class *tc,
 		.cur_fc = NULL,
 	};
 	struct resolve_context *ctx = &local_ctx;
+	struct resolve_event_class_jobs_data jobs_data;
 
 	/* Initialize class stack */
 	ctx->field_class_stack = field_class_stack_create();
@@ -1315,6 +1362,18 @@ int ctf_trace_class_resolve_field_classes(struct ctf_trace_class *tc,
 		}
 	}
 
+	/*
+	 * Event class field classes are independent from one event
+	 * class to the other: resolve them in parallel.
+	 */
+	jobs_data.tc = tc;
+	jobs_data.log_cfg = log_cfg;
+	ret = ctf_trace_class_for_each_event_class(tc,
+		resolve_event_class_job, NULL, &jobs_data, log_cfg);
+	if (ret) {
+		goto end;
+	}
+
 end:
 	field_class_stack_destroy(ctx->field_class_stack);
 	return ret;
@@ -12,9 +12,15 @@
  * all copies or substantial portions of the Software.
  */
 
+#define BT_COMP_LOG_SELF_COMP (log_cfg->self_comp)
+#define BT_LOG_OUTPUT_LEVEL (log_cfg->log_level)
+#define BT_LOG_TAG "PLUGIN/CTF/META/TRANSLATE"
+#include "logging/comp-logging.h"
+
 #include <babeltrace2/babeltrace.h>
 #include "common/macros.h"
 #include "common/assert.h"
+#include "common/align.h"
 #include <glib.h>
 #include <stdbool.h>
 #include <stdint.h>
@@ -22,6 +28,7 @@
 #include <inttypes.h>
 
 #include "ctf-meta-visitors.h"
+#include "logging.h"
 
 struct ctx {
 	bt_self_component *self_comp;
@@ -496,25 +503,206 @@ bt_field_class *scope_ctf_field_class_to_ir(struct ctx *ctx)
 	return ir_fc;
 }
 
+static
+bool append_bit_array_binary_layout_offset(
+		struct ctf_field_class_bit_array *fc, GArray *offsets,
+		uint64_t *at, enum ctf_byte_order *byte_order)
+{
+	bool ret = true;
+
+	if (fc->byte_order != CTF_BYTE_ORDER_LITTLE &&
+			fc->byte_order != CTF_BYTE_ORDER_BIG) {
+		ret = false;
+		goto end;
+	}
+
+	if (*byte_order == CTF_BYTE_ORDER_UNKNOWN) {
+		*byte_order = fc->byte_order;
+	} else if (fc->byte_order != *byte_order) {
+		ret = false;
+		goto end;
+	}
+
+	g_array_append_val(offsets, *at);
+	*at += fc->size;
+
+end:
+	return ret;
+}
+
+/*
+ * Appends the bit offsets of the leaf fields of an instance of `fc`
+ * starting at bit offset `*at` to `offsets`, in depth-first order, and
+ * sets `*at` to the bit offset following this instance.
+ *
+ * Returns false if `fc` has no static binary layout, that is, if it
+ * contains a field class which is not translated to trace IR, of which
+ * the instance size varies, of which the message iterator needs the
+ * decoded value, or of which the byte order differs from the others.
+ */
+static
+bool append_static_binary_layout_offsets(struct ctf_field_class *fc,
+		GArray *offsets, uint64_t *at, enum ctf_byte_order *byte_order)
+{
+	bool ret = true;
+	uint64_t i;
+
+	if (!fc->in_ir) {
+		ret = false;
+		goto end;
+	}
+
+	*at = ALIGN(*at, (uint64_t) fc->alignment);
+
+	switch (fc->type) {
+	case CTF_FIELD_CLASS_TYPE_INT:
+	case CTF_FIELD_CLASS_TYPE_ENUM:
+	{
+		struct ctf_field_class_int *int_fc = (void *) fc;
+
+		if (int_fc->meaning != CTF_FIELD_CLASS_MEANING_NONE ||
+				int_fc->storing_index >= 0 ||
+				int_fc->mapped_clock_class) {
+			ret = false;
+			goto end;
+		}
+
+		ret = append_bit_array_binary_layout_offset(&int_fc->base,
+			offsets, at, byte_order);
+		break;
+	}
+	case CTF_FIELD_CLASS_TYPE_FLOAT:
+		ret = append_bit_array_binary_layout_offset((void *) fc,
+			offsets, at, byte_order);
+		break;
+	case CTF_FIELD_CLASS_TYPE_STRUCT:
+	{
+		struct ctf_field_class_struct *struct_fc = (void *) fc;
+
+		for (i = 0; i < struct_fc->members->len; i++) {
+			struct ctf_named_field_class *named_fc =
+				ctf_field_class_struct_borrow_member_by_index(
+					struct_fc, i);
+
+			ret = append_static_binary_layout_offsets(named_fc->fc,
+				offsets, at, byte_order);
+			if (!ret) {
+				goto end;
+			}
+		}
+
+		break;
+	}
+	case CTF_FIELD_CLASS_TYPE_ARRAY:
+	{
+		struct ctf_field_class_array *array_fc = (void *) fc;
+
+		if (array_fc->base.is_text ||
+				array_fc->meaning != CTF_FIELD_CLASS_MEANING_NONE) {
+			ret = false;
+			goto end;
+		}
+
+		for (i = 0; i < array_fc->length; i++) {
+			ret = append_static_binary_layout_offsets(
+				array_fc->base.elem_fc, offsets, at,
+				byte_order);
+			if (!ret) {
+				goto end;
+			}
+		}
+
+		break;
+	}
+	default:
+		ret = false;
+		break;
+	}
+
+end:
+	return ret;
+}
+
+/*
+ * Sets the payload field binary layout of `ir_ec` if the payload field
+ * class of the current event class has a static binary layout.
+ *
+ * The offsets are relative to the beginning of the payload field: the
+ * alignment of a structure field class is the greatest alignment of its
+ * members, so that the layout does not depend on where the payload
+ * field starts within a packet.
+ */
 static inline
-void ctf_event_class_to_ir(struct ctx *ctx)
+void ctf_event_class_set_ir_payload_binary_layout(struct ctx *ctx,
+		bt_event_class *ir_ec)
 {
 	int ret;
-	bt_event_class *ir_ec = NULL;
-	bt_field_class *ir_fc;
+	GArray *offsets;
+	uint64_t size = 0;
+	enum ctf_byte_order byte_order = CTF_BYTE_ORDER_UNKNOWN;
+
+	offsets = g_array_new(FALSE, FALSE, sizeof(uint64_t));
+	BT_ASSERT(offsets);
+
+	if (!append_static_binary_layout_offsets(ctx->ec->payload_fc,
+			offsets, &size, &byte_order) || offsets->len == 0) {
+		goto end;
+	}
+
+	ret = bt_event_class_set_payload_field_binary_layout(ir_ec,
+		byte_order == CTF_BYTE_ORDER_BIG ?
+			BT_EVENT_CLASS_BINARY_LAYOUT_BYTE_ORDER_BIG_ENDIAN :
+			BT_EVENT_CLASS_BINARY_LAYOUT_BYTE_ORDER_LITTLE_ENDIAN,
+		(const uint64_t *) offsets->data, offsets->len, size);
+	BT_ASSERT(ret == 0);
+	ctx->ec->has_payload_binary_layout = true;
+	ctx->ec->payload_size = size;
+
+end:
+	g_array_free(offsets, TRUE);
+}
 
+/*
+ * Creates the (empty) trace IR event class of the current event class
+ * if it's not translated yet.
+ *
+ * This must be called from the thread which owns the trace IR stream
+ * class as it adds the event class to it.
+ */
+static inline
+void ctf_event_class_create_ir(struct ctx *ctx)
+{
 	BT_ASSERT(ctx->ec);
 
 	if (ctx->ec->is_translated) {
-		ir_ec = bt_stream_class_borrow_event_class_by_id(
-			ctx->ir_sc, ctx->ec->id);
-		BT_ASSERT(ir_ec);
 		goto end;
 	}
 
-	ir_ec = bt_event_class_create_with_id(ctx->ir_sc, ctx->ec->id);
+	ctx->ec->ir_ec = bt_event_class_create_with_id(ctx->ir_sc,
+		ctx->ec->id);
+	BT_ASSERT(ctx->ec->ir_ec);
+	bt_event_class_put_ref(ctx->ec->ir_ec);
+
+end:
+	return;
+}
+
+/*
+ * Translates the properties and field classes of the current event
+ * class to its trace IR event class, which ctf_event_class_create_ir()
+ * created.
+ */
+static inline
+void ctf_event_class_to_ir(struct ctx *ctx)
+{
+	int ret;
+	bt_event_class *ir_ec;
+	bt_field_class *ir_fc;
+
+	BT_ASSERT(ctx->ec);
+	BT_ASSERT(!ctx->ec->is_translated);
+	ir_ec = ctx->ec->ir_ec;
 	BT_ASSERT(ir_ec);
-	bt_event_class_put_ref(ir_ec);
 	ctx->scope = CTF_SCOPE_EVENT_SPECIFIC_CONTEXT;
 	ir_fc = scope_ctf_field_class_to_ir(ctx);
 	if (ir_fc) {
@@ -531,6 +719,7 @@ void ctf_event_class_to_ir(struct ctx *ctx)
 			ir_fc);
 		BT_ASSERT(ret == 0);
 		bt_field_class_put_ref(ir_fc);
+		ctf_event_class_set_ir_payload_binary_layout(ctx, ir_ec);
 	}
 
 	if (ctx->ec->name->len > 0) {
@@ -548,10 +737,138 @@ void ctf_event_class_to_ir(struct ctx *ctx)
 	}
 
 	ctx->ec->is_translated = true;
-	ctx->ec->ir_ec = ir_ec;
+}
+
+static inline
+bool ctf_scope_is_stream_class_scope(enum ctf_scope scope)
+{
+	return scope == CTF_SCOPE_PACKET_CONTEXT ||
+		scope == CTF_SCOPE_EVENT_COMMON_CONTEXT;
+}
+
+/*
+ * Returns whether or not the trace IR field class of `fc` (or of one
+ * of its children) refers to a length or selector field class of a
+ * stream class scope.
+ */
+static
+bool ctf_field_class_refers_to_stream_class(struct ctf_field_class *fc)
+{
+	bool refers = false;
+	uint64_t i;
+
+	if (!fc || !fc->in_ir) {
+		goto end;
+	}
+
+	switch (fc->type) {
+	case CTF_FIELD_CLASS_TYPE_SEQUENCE:
+	{
+		struct ctf_field_class_sequence *seq_fc = (void *) fc;
+
+		if (!seq_fc->base.is_text &&
+				ctf_scope_is_stream_class_scope(
+					seq_fc->length_path.root)) {
+			refers = true;
+			goto end;
+		}
+
+		break;
+	}
+	case CTF_FIELD_CLASS_TYPE_VARIANT:
+	{
+		struct ctf_field_class_variant *var_fc = (void *) fc;
+
+		if (ctf_scope_is_stream_class_scope(var_fc->tag_path.root)) {
+			refers = true;
+			goto end;
+		}
+
+		break;
+	}
+	default:
+		break;
+	}
+
+	switch (fc->type) {
+	case CTF_FIELD_CLASS_TYPE_STRUCT:
+	case CTF_FIELD_CLASS_TYPE_VARIANT:
+	case CTF_FIELD_CLASS_TYPE_SEQUENCE:
+	case CTF_FIELD_CLASS_TYPE_ARRAY:
+		for (i = 0; i < ctf_field_class_compound_get_field_class_count(fc);
+				i++) {
+			if (ctf_field_class_refers_to_stream_class(
+					ctf_field_class_compound_borrow_field_class_by_index(
+						fc, i))) {
+				refers = true;
+				goto end;
+			}
+		}
+
+		break;
+	default:
+		break;
+	}
 
 end:
-	return;
+	return refers;
+}
+
+struct translate_event_class_jobs_data {
+	bt_self_component *self_comp;
+	bt_trace_class *ir_tc;
+	struct ctf_trace_class *tc;
+};
+
+static
+void translate_event_class(struct translate_event_class_jobs_data *jobs_data,
+		struct ctf_stream_class *sc, struct ctf_event_class *ec)
+{
+	struct ctx ctx = {
+		.self_comp = jobs_data->self_comp,
+		.ir_tc = jobs_data->ir_tc,
+		.ir_sc = sc->ir_sc,
+		.tc = jobs_data->tc,
+		.sc = sc,
+		.ec = ec,
+	};
+
+	ctf_event_class_to_ir(&ctx);
+}
+
+/*
+ * Event class job (see ctf_trace_class_for_each_event_class()): the
+ * trace IR field classes of an event class are independent from the
+ * ones of the other event classes, except when they refer to a length
+ * or selector field class of a stream class scope: the library would
+ * then get a reference on this shared field class, and library
+ * reference counts are not atomic. Leave the translation of such event
+ * classes to the merge function (setting `*out` to `ec`).
+ */
+static
+int translate_event_class_job(struct ctf_stream_class *sc,
+		struct ctf_event_class *ec, void **out, void *data)
+{
+	if (ctf_field_class_refers_to_stream_class(ec->spec_context_fc) ||
+			ctf_field_class_refers_to_stream_class(
+				ec->payload_fc)) {
+		*out = ec;
+		goto end;
+	}
+
+	translate_event_class(data, sc, ec);
+
+end:
+	return 0;
+}
+
+static
+void merge_translated_event_class_job(struct ctf_stream_class *sc,
+		struct ctf_event_class *ec, void *out, void *data)
+{
+	if (out) {
+		translate_event_class(data, sc, ec);
+	}
 }
 
 
@@ -674,14 +991,15 @@ end:
 }
 
 BT_HIDDEN
-int ctf_trace_class_translate(bt_self_component *self_comp,
-		bt_trace_class *ir_tc, struct ctf_trace_class *tc)
+int ctf_trace_class_translate(bt_trace_class *ir_tc,
+		struct ctf_trace_class *tc, struct meta_log_config *log_cfg)
 {
 	int ret = 0;
 	uint64_t i;
 	struct ctx ctx = { 0 };
+	struct translate_event_class_jobs_data jobs_data;
 
-	ctx.self_comp = self_comp;
+	ctx.self_comp = log_cfg->self_comp;
 	ctx.tc = tc;
 	ctx.ir_tc = ir_tc;
 	ret = ctf_trace_class_to_ir(&ctx);
@@ -698,13 +1016,24 @@ int ctf_trace_class_translate(bt_self_component *self_comp,
 		for (j = 0; j < ctx.sc->event_classes->len; j++) {
 			ctx.ec = ctx.sc->event_classes->pdata[j];
 
-			ctf_event_class_to_ir(&ctx);
+			ctf_event_class_create_ir(&ctx);
 			ctx.ec = NULL;
 		}
 
 		ctx.sc = NULL;
 	}
 
+	/*
+	 * The trace IR event classes exist, in order: translate their
+	 * field classes in parallel.
+	 */
+	jobs_data.self_comp = log_cfg->self_comp;
+	jobs_data.ir_tc = ir_tc;
+	jobs_data.tc = tc;
+	ret = ctf_trace_class_for_each_event_class(tc,
+		translate_event_class_job, merge_translated_event_class_job,
+		&jobs_data, log_cfg);
+
 end:
 	return ret;
 }
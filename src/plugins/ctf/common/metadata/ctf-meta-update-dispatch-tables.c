@@ -0,0 +1,329 @@
+/*
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ */
+
+#include <babeltrace2/babeltrace.h>
+#include "common/macros.h"
+#include "common/assert.h"
+#include <glib.h>
+#include <stdint.h>
+#include <string.h>
+#include <inttypes.h>
+
+#include "ctf-meta-visitors.h"
+
+static
+gint compare_uint64(gconstpointer a, gconstpointer b)
+{
+	const uint64_t val_a = *(const uint64_t *) a;
+	const uint64_t val_b = *(const uint64_t *) b;
+
+	if (val_a < val_b) {
+		return -1;
+	} else if (val_a > val_b) {
+		return 1;
+	} else {
+		return 0;
+	}
+}
+
+/*
+ * Compiles the option selection tables of `var_fc`.
+ *
+ * The range bounds split the key space into elementary intervals in
+ * which all the keys select the same option: the intervals selecting
+ * an option, with adjacent intervals selecting the same option merged,
+ * become `var_fc->selection.intervals`. If they span few enough keys,
+ * `var_fc->selection.direct` maps each key of this span to its option
+ * index.
+ */
+static
+void compile_variant_field_class(struct ctf_field_class_variant *var_fc)
+{
+	GArray *bounds;
+	GArray *intervals;
+	uint64_t i;
+
+	BT_ASSERT(var_fc->tag_fc);
+	BT_ASSERT(!var_fc->selection.intervals);
+	bounds = g_array_new(FALSE, FALSE, sizeof(uint64_t));
+	BT_ASSERT(bounds);
+	intervals = g_array_new(FALSE, FALSE,
+		sizeof(struct ctf_field_class_variant_range));
+	BT_ASSERT(intervals);
+
+	for (i = 0; i < var_fc->ranges->len; i++) {
+		struct ctf_field_class_variant_range *range =
+			ctf_field_class_variant_borrow_range_by_index(var_fc, i);
+		uint64_t key = ctf_field_class_variant_tag_key(var_fc,
+			range->range.lower.u);
+
+		g_array_append_val(bounds, key);
+		key = ctf_field_class_variant_tag_key(var_fc,
+			range->range.upper.u);
+		if (key != UINT64_MAX) {
+			key++;
+			g_array_append_val(bounds, key);
+		}
+	}
+
+	g_array_sort(bounds, compare_uint64);
+
+	for (i = 0; i < bounds->len; i++) {
+		struct ctf_field_class_variant_range interval;
+		uint64_t next_i;
+		int64_t option_index;
+
+		interval.range.lower.u = g_array_index(bounds, uint64_t, i);
+		if (i > 0 && interval.range.lower.u ==
+				g_array_index(bounds, uint64_t, i - 1)) {
+			/* Duplicate bound */
+			continue;
+		}
+
+		for (next_i = i + 1; next_i < bounds->len; next_i++) {
+			if (g_array_index(bounds, uint64_t, next_i) !=
+					interval.range.lower.u) {
+				break;
+			}
+		}
+
+		interval.range.upper.u = next_i < bounds->len ?
+			g_array_index(bounds, uint64_t, next_i) - 1 :
+			UINT64_MAX;
+		/* Not compiled yet: checks each range in order */
+		option_index = ctf_field_class_variant_find_option_index(
+			var_fc, ctf_field_class_variant_tag_key(var_fc,
+				interval.range.lower.u));
+		if (option_index < 0) {
+			continue;
+		}
+
+		interval.option_index = (uint64_t) option_index;
+
+		if (intervals->len > 0) {
+			struct ctf_field_class_variant_range *last =
+				&g_array_index(intervals,
+					struct ctf_field_class_variant_range,
+					intervals->len - 1);
+
+			if (last->option_index == interval.option_index &&
+					last->range.upper.u + 1 ==
+						interval.range.lower.u) {
+				last->range.upper.u = interval.range.upper.u;
+				continue;
+			}
+		}
+
+		g_array_append_val(intervals, interval);
+	}
+
+	g_array_free(bounds, TRUE);
+	var_fc->selection.intervals = intervals;
+
+	if (intervals->len > 0) {
+		const struct ctf_field_class_variant_range *first =
+			&g_array_index(intervals,
+				struct ctf_field_class_variant_range, 0);
+		const struct ctf_field_class_variant_range *last =
+			&g_array_index(intervals,
+				struct ctf_field_class_variant_range,
+				intervals->len - 1);
+
+		if (last->range.upper.u - first->range.lower.u <
+				CTF_META_VARIANT_DIRECT_TABLE_MAX_LEN) {
+			var_fc->selection.direct_base_key =
+				first->range.lower.u;
+			var_fc->selection.direct_len =
+				last->range.upper.u - first->range.lower.u + 1;
+			var_fc->selection.direct = g_new(int64_t,
+				var_fc->selection.direct_len);
+			BT_ASSERT(var_fc->selection.direct);
+
+			for (i = 0; i < var_fc->selection.direct_len; i++) {
+				var_fc->selection.direct[i] = -1;
+			}
+
+			for (i = 0; i < intervals->len; i++) {
+				const struct ctf_field_class_variant_range *interval =
+					&g_array_index(intervals,
+						struct ctf_field_class_variant_range,
+						i);
+				uint64_t key;
+
+				for (key = interval->range.lower.u;
+						key <= interval->range.upper.u;
+						key++) {
+					var_fc->selection.direct[key -
+						var_fc->selection.direct_base_key] =
+						(int64_t) interval->option_index;
+				}
+			}
+		}
+	}
+}
+
+static
+void compile_field_class(struct ctf_field_class *fc)
+{
+	uint64_t i;
+
+	if (!fc) {
+		goto end;
+	}
+
+	switch (fc->type) {
+	case CTF_FIELD_CLASS_TYPE_STRUCT:
+	{
+		struct ctf_field_class_struct *struct_fc = (void *) fc;
+
+		for (i = 0; i < struct_fc->members->len; i++) {
+			struct ctf_named_field_class *named_fc =
+				ctf_field_class_struct_borrow_member_by_index(
+					struct_fc, i);
+
+			compile_field_class(named_fc->fc);
+		}
+
+		break;
+	}
+	case CTF_FIELD_CLASS_TYPE_VARIANT:
+	{
+		struct ctf_field_class_variant *var_fc = (void *) fc;
+
+		if (!var_fc->selection.intervals) {
+			compile_variant_field_class(var_fc);
+		}
+
+		for (i = 0; i < var_fc->options->len; i++) {
+			struct ctf_named_field_class *named_fc =
+				ctf_field_class_variant_borrow_option_by_index(
+					var_fc, i);
+
+			compile_field_class(named_fc->fc);
+		}
+
+		break;
+	}
+	case CTF_FIELD_CLASS_TYPE_ARRAY:
+	case CTF_FIELD_CLASS_TYPE_SEQUENCE:
+	{
+		struct ctf_field_class_array_base *array_fc = (void *) fc;
+
+		compile_field_class(array_fc->elem_fc);
+		break;
+	}
+	default:
+		break;
+	}
+
+end:
+	return;
+}
+
+/*
+ * Returns a new table of the classes `classes`, indexed by their ID,
+ * or `NULL` if their IDs are too sparse. `get_id` returns the ID of a
+ * class.
+ */
+static
+GPtrArray *create_id_table(GPtrArray *classes,
+		uint64_t (*get_id)(const void *class))
+{
+	GPtrArray *table = NULL;
+	uint64_t max_len = MAX((uint64_t) CTF_META_ID_TABLE_MIN_MAX_LEN,
+		(uint64_t) classes->len * 4);
+	uint64_t i;
+
+	for (i = 0; i < classes->len; i++) {
+		if (get_id(classes->pdata[i]) >= max_len) {
+			goto end;
+		}
+	}
+
+	table = g_ptr_array_new();
+	BT_ASSERT(table);
+
+	for (i = 0; i < classes->len; i++) {
+		const uint64_t id = get_id(classes->pdata[i]);
+
+		if (id >= table->len) {
+			g_ptr_array_set_size(table, id + 1);
+		}
+
+		table->pdata[id] = classes->pdata[i];
+	}
+
+end:
+	return table;
+}
+
+static
+uint64_t get_stream_class_id(const void *class)
+{
+	const struct ctf_stream_class *sc = class;
+
+	return sc->id;
+}
+
+static
+uint64_t get_event_class_id(const void *class)
+{
+	const struct ctf_event_class *ec = class;
+
+	return ec->id;
+}
+
+BT_HIDDEN
+int ctf_trace_class_update_dispatch_tables(struct ctf_trace_class *ctf_tc)
+{
+	uint64_t i;
+
+	if (!ctf_tc->is_translated) {
+		compile_field_class(ctf_tc->packet_header_fc);
+	}
+
+	for (i = 0; i < ctf_tc->stream_classes->len; i++) {
+		uint64_t j;
+		struct ctf_stream_class *sc = ctf_tc->stream_classes->pdata[i];
+
+		if (!sc->is_translated) {
+			compile_field_class(sc->packet_context_fc);
+			compile_field_class(sc->event_header_fc);
+			compile_field_class(sc->event_common_context_fc);
+		}
+
+		for (j = 0; j < sc->event_classes->len; j++) {
+			struct ctf_event_class *ec =
+				sc->event_classes->pdata[j];
+
+			if (!ec->is_translated) {
+				compile_field_class(ec->spec_context_fc);
+				compile_field_class(ec->payload_fc);
+			}
+		}
+
+		if (sc->event_class_table) {
+			g_ptr_array_free(sc->event_class_table, TRUE);
+		}
+
+		sc->event_class_table = create_id_table(sc->event_classes,
+			get_event_class_id);
+	}
+
+	if (ctf_tc->stream_class_table) {
+		g_ptr_array_free(ctf_tc->stream_class_table, TRUE);
+	}
+
+	ctf_tc->stream_class_table = create_id_table(ctf_tc->stream_classes,
+		get_stream_class_id);
+	return 0;
+}
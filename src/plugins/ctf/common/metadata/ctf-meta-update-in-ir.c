@@ -238,14 +238,60 @@ end:
 	return;
 }
 
+/*
+ * Event class job (see ctf_trace_class_for_each_event_class()): a
+ * field class within an event class can only depend on a field class
+ * of the same event class, or of its stream or trace class, so that
+ * each job records the dependents it finds in its own hash table.
+ */
+static
+int update_event_class_in_ir_job(struct ctf_stream_class *sc,
+		struct ctf_event_class *ec, void **out, void *data)
+{
+	GHashTable *ft_dependents = g_hash_table_new(g_direct_hash,
+		g_direct_equal);
+
+	BT_ASSERT(ft_dependents);
+	update_field_class_in_ir(ec->payload_fc, ft_dependents);
+	update_field_class_in_ir(ec->spec_context_fc, ft_dependents);
+	*out = ft_dependents;
+	return 0;
+}
+
+static
+void merge_event_class_in_ir_job(struct ctf_stream_class *sc,
+		struct ctf_event_class *ec, void *out, void *data)
+{
+	GHashTable *ft_dependents = data;
+	GHashTable *ec_ft_dependents = out;
+	GHashTableIter iter;
+	gpointer key;
+
+	if (!ec_ft_dependents) {
+		return;
+	}
+
+	g_hash_table_iter_init(&iter, ec_ft_dependents);
+
+	while (g_hash_table_iter_next(&iter, &key, NULL)) {
+		g_hash_table_insert(ft_dependents, key, key);
+	}
+
+	g_hash_table_destroy(ec_ft_dependents);
+}
+
 /*
  * Scopes and field classes are processed in reverse order because we need
  * to know if a given integer field class has dependents (sequence or
  * variant field classes) when we reach it. Dependents can only be located
  * after the length/tag field class in the metadata tree.
+ *
+ * This means processing all the event classes first, then the stream
+ * classes, then the trace class.
  */
 BT_HIDDEN
-int ctf_trace_class_update_in_ir(struct ctf_trace_class *ctf_tc)
+int ctf_trace_class_update_in_ir(struct ctf_trace_class *ctf_tc,
+		struct meta_log_config *log_cfg)
 {
 	int ret = 0;
 	uint64_t i;
@@ -255,21 +301,15 @@ int ctf_trace_class_update_in_ir(struct ctf_trace_class *ctf_tc)
 
 	BT_ASSERT(ft_dependents);
 
+	ret = ctf_trace_class_for_each_event_class(ctf_tc,
+		update_event_class_in_ir_job, merge_event_class_in_ir_job,
+		ft_dependents, log_cfg);
+	if (ret) {
+		goto end;
+	}
+
 	for (i = 0; i < ctf_tc->stream_classes->len; i++) {
 		struct ctf_stream_class *sc = ctf_tc->stream_classes->pdata[i];
-		uint64_t j;
-
-		for (j = 0; j < sc->event_classes->len; j++) {
-			struct ctf_event_class *ec = sc->event_classes->pdata[j];
-
-			if (ec->is_translated) {
-				continue;
-			}
-
-			update_field_class_in_ir(ec->payload_fc, ft_dependents);
-			update_field_class_in_ir(ec->spec_context_fc,
-				ft_dependents);
-		}
 
 		if (!sc->is_translated) {
 			update_field_class_in_ir(sc->event_common_context_fc,
@@ -286,6 +326,7 @@ int ctf_trace_class_update_in_ir(struct ctf_trace_class *ctf_tc)
 			false);
 	}
 
+end:
 	g_hash_table_destroy(ft_dependents);
 	return ret;
 }
@@ -22,13 +22,48 @@
 
 struct meta_log_config;
 
+/*
+ * Event class job function: processes the event class `ec` of the
+ * stream class `sc`, possibly setting `*out` to an output for the
+ * corresponding merge function.
+ *
+ * This function can be called from any thread: it must only modify
+ * `ec`, its field classes, its trace IR event class, and `*out`.
+ */
+typedef int (*ctf_event_class_job_func)(struct ctf_stream_class *sc,
+		struct ctf_event_class *ec, void **out, void *data);
+
+/*
+ * Event class job merge function: merges (and frees) the output `out`
+ * of the job of the event class `ec`.
+ *
+ * This function is always called from the calling thread of
+ * ctf_trace_class_for_each_event_class().
+ */
+typedef void (*ctf_event_class_job_merge_func)(struct ctf_stream_class *sc,
+		struct ctf_event_class *ec, void *out, void *data);
+
+/*
+ * Calls `func` for each event class of `tc` which is not translated
+ * yet, using worker threads when there are many event classes, and
+ * then calls `merge_func` (if not `NULL`) for each of them, in order.
+ *
+ * Returns the result of the first failing job, in stream class, then
+ * event class order, or 0.
+ */
+BT_HIDDEN
+int ctf_trace_class_for_each_event_class(struct ctf_trace_class *tc,
+		ctf_event_class_job_func func,
+		ctf_event_class_job_merge_func merge_func, void *data,
+		struct meta_log_config *log_cfg);
+
 BT_HIDDEN
 int ctf_trace_class_resolve_field_classes(struct ctf_trace_class *tc,
 		struct meta_log_config *log_cfg);
 
 BT_HIDDEN
-int ctf_trace_class_translate(bt_self_component *self_comp,
-		bt_trace_class *ir_tc, struct ctf_trace_class *tc);
+int ctf_trace_class_translate(bt_trace_class *ir_tc,
+		struct ctf_trace_class *tc, struct meta_log_config *log_cfg);
 
 BT_HIDDEN
 int ctf_trace_class_update_default_clock_classes(
@@ -36,7 +71,8 @@ int ctf_trace_class_update_default_clock_classes(
 		struct meta_log_config *log_cfg);
 
 BT_HIDDEN
-int ctf_trace_class_update_in_ir(struct ctf_trace_class *ctf_tc);
+int ctf_trace_class_update_in_ir(struct ctf_trace_class *ctf_tc,
+		struct meta_log_config *log_cfg);
 
 BT_HIDDEN
 int ctf_trace_class_update_meanings(struct ctf_trace_class *ctf_tc);
@@ -50,6 +86,9 @@ int ctf_trace_class_update_value_storing_indexes(struct ctf_trace_class *ctf_tc)
 BT_HIDDEN
 int ctf_trace_class_update_stream_class_config(struct ctf_trace_class *ctf_tc);
 
+BT_HIDDEN
+int ctf_trace_class_update_dispatch_tables(struct ctf_trace_class *ctf_tc);
+
 BT_HIDDEN
 int ctf_trace_class_validate(struct ctf_trace_class *ctf_tc,
 		struct meta_log_config *log_cfg);
@@ -24,6 +24,19 @@
 #include <stdint.h>
 #include <string.h>
 
+/*
+ * A stream class or event class table indexed by ID is only built when
+ * its length (greatest ID + 1) is at most the greatest of this value
+ * and four times the number of classes.
+ */
+#define CTF_META_ID_TABLE_MIN_MAX_LEN		1024
+
+/*
+ * Maximum number of tag values of a variant field class's direct
+ * option index table.
+ */
+#define CTF_META_VARIANT_DIRECT_TABLE_MAX_LEN	256
+
 enum ctf_field_class_type {
 	CTF_FIELD_CLASS_TYPE_INT,
 	CTF_FIELD_CLASS_TYPE_ENUM,
@@ -194,6 +207,32 @@ struct ctf_field_class_variant {
 
 	/* Weak */
 	struct ctf_field_class_enum *tag_fc;
+
+	/*
+	 * Option selection tables, compiled from `ranges` by
+	 * ctf_trace_class_update_dispatch_tables() once the tag field
+	 * class is resolved.
+	 *
+	 * All the bounds are keys (see ctf_field_class_variant_tag_key()).
+	 */
+	struct {
+		/*
+		 * Array of `struct ctf_field_class_variant_range`:
+		 * sorted, disjoint key intervals, each one selecting the
+		 * option of the first range of `ranges` which contains
+		 * it. `NULL` if not compiled yet.
+		 */
+		GArray *intervals;
+
+		/*
+		 * Option index of each of the `direct_len` keys starting
+		 * at `direct_base_key`, or -1 for no option. `NULL` if
+		 * the intervals span too many keys.
+		 */
+		int64_t *direct;
+		uint64_t direct_base_key;
+		uint64_t direct_len;
+	} selection;
 };
 
 struct ctf_field_class_array_base {
@@ -232,6 +271,17 @@ struct ctf_event_class {
 	/* Owned by this */
 	struct ctf_field_class *payload_fc;
 
+	/*
+	 * True if the payload field class has a static binary layout,
+	 * set during translation: the message iterator can then attach
+	 * the raw payload to an event instead of decoding its payload
+	 * field (see bt_event_set_raw_payload()).
+	 */
+	bool has_payload_binary_layout;
+
+	/* Payload size (bits) if `has_payload_binary_layout` is true */
+	uint64_t payload_size;
+
 	/* Weak, set during translation */
 	bt_event_class *ir_ec;
 };
@@ -264,6 +314,18 @@ struct ctf_stream_class {
 	 */
 	GHashTable *event_classes_by_id;
 
+	/*
+	 * Array of `struct ctf_event_class *` (weak) indexed by event
+	 * class ID (`NULL` for unused IDs), built by
+	 * ctf_trace_class_update_dispatch_tables() when the IDs are
+	 * dense enough, otherwise `NULL`.
+	 *
+	 * This table can miss event classes which were added since it
+	 * was built: ctf_stream_class_borrow_event_class_by_id() falls
+	 * back to `event_classes_by_id` in this case.
+	 */
+	GPtrArray *event_class_table;
+
 	/* Weak */
 	struct ctf_clock_class *default_clock_class;
 
@@ -304,6 +366,13 @@ struct ctf_trace_class {
 	/* Array of `struct ctf_stream_class *` */
 	GPtrArray *stream_classes;
 
+	/*
+	 * Array of `struct ctf_stream_class *` (weak) indexed by stream
+	 * class ID: same as the `event_class_table` member of
+	 * `struct ctf_stream_class`, but for stream classes.
+	 */
+	GPtrArray *stream_class_table;
+
 	/* Array of `struct ctf_trace_class_env_entry` */
 	GArray *env_entries;
 
@@ -643,6 +712,12 @@ void _ctf_field_class_variant_destroy(struct ctf_field_class_variant *fc)
 		g_array_free(fc->ranges, TRUE);
 	}
 
+	if (fc->selection.intervals) {
+		g_array_free(fc->selection.intervals, TRUE);
+	}
+
+	g_free(fc->selection.direct);
+
 	if (fc->tag_ref) {
 		g_string_free(fc->tag_ref, TRUE);
 	}
@@ -929,6 +1004,93 @@ ctf_field_class_variant_borrow_range_by_index(
 		index);
 }
 
+/*
+ * Converts the raw bits of a tag value or range bound of the variant
+ * field class `fc` to a selection key: unsigned values as is, and
+ * signed values with their sign bit flipped, so that comparing keys as
+ * unsigned integers preserves the order of the values.
+ */
+static inline
+uint64_t ctf_field_class_variant_tag_key(struct ctf_field_class_variant *fc,
+		uint64_t bits)
+{
+	BT_ASSERT_DBG(fc->tag_fc);
+	return fc->tag_fc->base.is_signed ? bits ^ (UINT64_C(1) << 63) : bits;
+}
+
+/*
+ * Returns the index of the option of the variant field class `fc`
+ * which the tag value `tag_bits` (raw bits) selects, or -1 if none.
+ */
+static inline
+int64_t ctf_field_class_variant_find_option_index(
+		struct ctf_field_class_variant *fc, uint64_t tag_bits)
+{
+	const uint64_t key = ctf_field_class_variant_tag_key(fc, tag_bits);
+	const GArray *intervals = fc->selection.intervals;
+	int64_t option_index = -1;
+	uint64_t low = 0;
+	uint64_t high;
+	uint64_t i;
+
+	if (G_LIKELY(fc->selection.direct)) {
+		if (key - fc->selection.direct_base_key <
+				fc->selection.direct_len) {
+			option_index = fc->selection.direct[
+				key - fc->selection.direct_base_key];
+		}
+
+		goto end;
+	}
+
+	if (G_LIKELY(intervals)) {
+		/* First interval of which the upper key is >= `key` */
+		high = intervals->len;
+
+		while (low < high) {
+			const uint64_t mid = low + (high - low) / 2;
+
+			if (g_array_index(intervals,
+					struct ctf_field_class_variant_range,
+					mid).range.upper.u < key) {
+				low = mid + 1;
+			} else {
+				high = mid;
+			}
+		}
+
+		if (low < intervals->len) {
+			const struct ctf_field_class_variant_range *interval =
+				&g_array_index(intervals,
+					struct ctf_field_class_variant_range,
+					low);
+
+			if (interval->range.lower.u <= key) {
+				option_index = (int64_t) interval->option_index;
+			}
+		}
+
+		goto end;
+	}
+
+	/* Not compiled: check each range */
+	for (i = 0; i < fc->ranges->len; i++) {
+		struct ctf_field_class_variant_range *range =
+			ctf_field_class_variant_borrow_range_by_index(fc, i);
+
+		if (key >= ctf_field_class_variant_tag_key(fc,
+					range->range.lower.u) &&
+				key <= ctf_field_class_variant_tag_key(fc,
+					range->range.upper.u)) {
+			option_index = (int64_t) range->option_index;
+			break;
+		}
+	}
+
+end:
+	return option_index;
+}
+
 static inline
 void ctf_field_class_variant_append_option(struct ctf_field_class_variant *fc,
 		const char *orig_name, struct ctf_field_class *option_fc)
@@ -1558,6 +1720,10 @@ void ctf_stream_class_destroy(struct ctf_stream_class *sc)
 		g_hash_table_destroy(sc->event_classes_by_id);
 	}
 
+	if (sc->event_class_table) {
+		g_ptr_array_free(sc->event_class_table, TRUE);
+	}
+
 	ctf_field_class_destroy(sc->packet_context_fc);
 	ctf_field_class_destroy(sc->event_header_fc);
 	ctf_field_class_destroy(sc->event_common_context_fc);
@@ -1578,6 +1744,17 @@ struct ctf_event_class *ctf_stream_class_borrow_event_class_by_id(
 		struct ctf_stream_class *sc, uint64_t type)
 {
 	BT_ASSERT_DBG(sc);
+
+	if (G_LIKELY(sc->event_class_table &&
+			type < sc->event_class_table->len)) {
+		struct ctf_event_class *ec =
+			sc->event_class_table->pdata[type];
+
+		if (G_LIKELY(ec)) {
+			return ec;
+		}
+	}
+
 	return g_hash_table_lookup(sc->event_classes_by_id,
 		GUINT_TO_POINTER((guint) type));
 }
@@ -1673,6 +1850,10 @@ void ctf_trace_class_destroy(struct ctf_trace_class *tc)
 		g_ptr_array_free(tc->stream_classes, TRUE);
 	}
 
+	if (tc->stream_class_table) {
+		g_ptr_array_free(tc->stream_class_table, TRUE);
+	}
+
 	if (tc->env_entries) {
 		uint64_t i;
 
@@ -1723,6 +1904,14 @@ struct ctf_stream_class *ctf_trace_class_borrow_stream_class_by_id(
 
 	BT_ASSERT_DBG(tc);
 
+	if (G_LIKELY(tc->stream_class_table &&
+			id < tc->stream_class_table->len)) {
+		ret_sc = tc->stream_class_table->pdata[id];
+		if (G_LIKELY(ret_sc)) {
+			goto end;
+		}
+	}
+
 	for (i = 0; i < tc->stream_classes->len; i++) {
 		struct ctf_stream_class *sc = tc->stream_classes->pdata[i];
 
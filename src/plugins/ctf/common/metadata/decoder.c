@@ -30,6 +30,7 @@
 #include <string.h>
 
 #include "ast.h"
+#include "ctf-meta-cache.h"
 #include "decoder.h"
 #include "scanner.h"
 #include "logging.h"
@@ -44,6 +45,10 @@ struct ctf_metadata_decoder {
 	bt_uuid_t uuid;
 	bool is_uuid_set;
 	int bo;
+
+	/* True if content was appended (or tried to be) */
+	bool has_content;
+
 	struct ctf_metadata_decoder_config config;
 	struct meta_log_config log_cfg;
 };
@@ -194,6 +199,9 @@ enum ctf_metadata_decoder_status ctf_metadata_decoder_append_content(
 	bool close_fp = false;
 	long start_pos = -1;
 	bool is_packetized;
+	bool use_cache;
+	GString *cache_text = NULL;
+	gchar *cache_key = NULL;
 
 	BT_ASSERT(mdec);
 	ret = ctf_metadata_decoder_is_packetized(fp, &is_packetized, &mdec->bo,
@@ -277,11 +285,63 @@ enum ctf_metadata_decoder_status ctf_metadata_decoder_append_content(
 
 	/* Save the file's position: we'll seek back to append the plain text */
 	BT_ASSERT(fp);
+	use_cache = mdec->config.cache_dir && mdec->config.create_trace_class &&
+		!mdec->has_content;
+	mdec->has_content = true;
 
-	if (mdec->config.keep_plain_text) {
+	if (mdec->config.keep_plain_text || use_cache) {
 		start_pos = ftell(fp);
 	}
 
+	if (use_cache) {
+		struct ctf_trace_class *tc;
+
+		/*
+		 * Read the whole metadata text to compute its cache key,
+		 * and then try to load the pre-resolved CTF IR trace
+		 * class instead of parsing it.
+		 */
+		cache_text = g_string_new(NULL);
+		ret = bt_common_append_file_content_to_g_string(cache_text,
+			fp);
+		if (ret) {
+			BT_COMP_LOGE("Failed to read metadata text: "
+				"ret=%d, mdec-addr=%p", ret, mdec);
+			status = CTF_METADATA_DECODER_STATUS_ERROR;
+			goto end;
+		}
+
+		cache_key = ctf_meta_cache_key(cache_text->str,
+			cache_text->len, &mdec->config);
+		tc = ctf_meta_cache_load(mdec->config.cache_dir, cache_key,
+			&mdec->log_cfg);
+		if (tc) {
+			ret = ctf_visitor_generate_ir_set_ctf_trace_class(
+				mdec->visitor, tc);
+			if (ret) {
+				BT_COMP_LOGE("Failed to use CTF IR trace class from metadata cache: "
+					"mdec-addr=%p, ret=%d", mdec, ret);
+				status = CTF_METADATA_DECODER_STATUS_IR_VISITOR_ERROR;
+				goto end;
+			}
+
+			if (mdec->config.keep_plain_text) {
+				g_string_append_len(mdec->text,
+					cache_text->str, cache_text->len);
+			}
+
+			goto end;
+		}
+
+		ret = fseek(fp, start_pos, SEEK_SET);
+		if (ret) {
+			BT_COMP_LOGE("Failed to seek file: ret=%d, mdec-addr=%p",
+				ret, mdec);
+			status = CTF_METADATA_DECODER_STATUS_ERROR;
+			goto end;
+		}
+	}
+
 	/* Append the metadata text content */
 	ret = ctf_scanner_append_ast(mdec->scanner, fp);
 	if (ret) {
@@ -340,6 +400,14 @@ enum ctf_metadata_decoder_status ctf_metadata_decoder_append_content(
 		}
 	}
 
+	if (cache_key) {
+		/* A cache entry is an optimization: ignore errors */
+		(void) ctf_meta_cache_save(
+			ctf_visitor_generate_ir_borrow_ctf_trace_class(
+				mdec->visitor),
+			mdec->config.cache_dir, cache_key, &mdec->log_cfg);
+	}
+
 end:
 #if YYDEBUG
 	yydebug = 0;
@@ -354,6 +422,12 @@ end:
 
 	free(buf);
 
+	if (cache_text) {
+		g_string_free(cache_text, TRUE);
+	}
+
+	g_free(cache_key);
+
 	return status;
 }
 
@@ -59,6 +59,20 @@ struct ctf_metadata_decoder_config {
 	 * ctf_metadata_decoder_append_content().
 	 */
 	bool keep_plain_text;
+
+	/*
+	 * Directory of the pre-resolved metadata cache (see
+	 * `ctf-meta-cache.h`), or `NULL` to always parse the metadata
+	 * text; weak.
+	 *
+	 * The cache is only used for the first call to
+	 * ctf_metadata_decoder_append_content(), and only when
+	 * `create_trace_class` is true: only set it when the decoder
+	 * receives the whole metadata at once. On a cache hit, there's
+	 * no metadata AST: don't call
+	 * ctf_metadata_decoder_get_trace_class_uuid() in this case.
+	 */
+	const char *cache_dir;
 };
 
 /*
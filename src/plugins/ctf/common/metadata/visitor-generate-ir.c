@@ -4696,6 +4696,43 @@ struct ctf_trace_class *ctf_visitor_generate_ir_borrow_ctf_trace_class(
 	return ctx->ctf_tc;
 }
 
+BT_HIDDEN
+int ctf_visitor_generate_ir_set_ctf_trace_class(
+		struct ctf_visitor_generate_ir *visitor,
+		struct ctf_trace_class *tc)
+{
+	int ret;
+	struct ctx *ctx = (void *) visitor;
+
+	BT_ASSERT(ctx);
+	BT_ASSERT(tc);
+	BT_ASSERT(!ctx->is_trace_visited);
+	BT_ASSERT(ctx->ctf_tc->stream_classes->len == 0);
+	ctf_trace_class_destroy(ctx->ctf_tc);
+	ctx->ctf_tc = tc;
+	ctx->is_trace_visited = true;
+
+	/* Compile event class, stream class, and variant dispatch tables */
+	ret = ctf_trace_class_update_dispatch_tables(ctx->ctf_tc);
+	if (ret) {
+		ret = -EINVAL;
+		goto end;
+	}
+
+	if (ctx->trace_class) {
+		/* Copy CTF metadata -> IR metadata */
+		ret = ctf_trace_class_translate(ctx->trace_class,
+				ctx->ctf_tc, &ctx->log_cfg);
+		if (ret) {
+			ret = -EINVAL;
+			goto end;
+		}
+	}
+
+end:
+	return ret;
+}
+
 BT_HIDDEN
 int ctf_visitor_generate_ir_visit_node(struct ctf_visitor_generate_ir *visitor,
 		struct ctf_node *node)
@@ -4902,7 +4939,8 @@ int ctf_visitor_generate_ir_visit_node(struct ctf_visitor_generate_ir *visitor,
 		 * to create IR fields anyway, so we leave all the
 		 * `in_ir` members false.
 		 */
-		ret = ctf_trace_class_update_in_ir(ctx->ctf_tc);
+		ret = ctf_trace_class_update_in_ir(ctx->ctf_tc,
+			&ctx->log_cfg);
 		if (ret) {
 			ret = -EINVAL;
 			goto end;
@@ -4923,6 +4961,13 @@ int ctf_visitor_generate_ir_visit_node(struct ctf_visitor_generate_ir *visitor,
 		goto end;
 	}
 
+	/* Compile event class, stream class, and variant dispatch tables */
+	ret = ctf_trace_class_update_dispatch_tables(ctx->ctf_tc);
+	if (ret) {
+		ret = -EINVAL;
+		goto end;
+	}
+
 	/*
 	 * If there are fields which are not related to the CTF format
 	 * itself in the packet header and in event header field
@@ -4933,8 +4978,8 @@ int ctf_visitor_generate_ir_visit_node(struct ctf_visitor_generate_ir *visitor,
 
 	if (ctx->trace_class) {
 		/* Copy new CTF metadata -> new IR metadata */
-		ret = ctf_trace_class_translate(ctx->log_cfg.self_comp,
-				ctx->trace_class, ctx->ctf_tc);
+		ret = ctf_trace_class_translate(ctx->trace_class,
+				ctx->ctf_tc, &ctx->log_cfg);
 		if (ret) {
 			ret = -EINVAL;
 			goto end;
@@ -34,6 +34,7 @@
 #include <stddef.h>
 #include <stdbool.h>
 #include "common/assert.h"
+#include "common/align.h"
 #include <string.h>
 #include <babeltrace2/babeltrace.h>
 #include "common/common.h"
@@ -134,6 +135,25 @@ struct ctf_msg_iter {
 	 */
 	bool dry_run;
 
+	/*
+	 * True to attach the raw payload of an event to its event object
+	 * instead of decoding its payload field when its class has a
+	 * static payload binary layout (see ctf_msg_iter_set_lazy_payloads()).
+	 */
+	bool lazy_payloads;
+
+	/*
+	 * True to attach the raw bytes of each complete packet to its
+	 * packet object (see ctf_msg_iter_set_raw_packets()).
+	 */
+	bool raw_packets;
+
+	/* Number of event messages emitted for the current packet */
+	uint64_t cur_packet_event_count;
+
+	/* Buffer receiving the raw bytes of the current packet */
+	GByteArray *raw_packet_buf;
+
 	/*
 	 * Current dynamic scope field pointer.
 	 *
@@ -988,6 +1008,7 @@ enum ctf_msg_iter_status set_current_packet(struct ctf_msg_iter *msg_it)
 		goto error;
 	}
 
+	msg_it->cur_packet_event_count = 0;
 	goto end;
 
 error:
@@ -1503,6 +1524,47 @@ enum ctf_msg_iter_status read_event_payload_begin_state(
 		goto end;
 	}
 
+	if (msg_it->lazy_payloads && !msg_it->dry_run &&
+			msg_it->meta.ec->has_payload_binary_layout) {
+		size_t payload_at = ALIGN(packet_at(msg_it),
+			(size_t) event_payload_fc->alignment) -
+			msg_it->buf.packet_offset;
+		size_t payload_end_at = payload_at +
+			msg_it->meta.ec->payload_size;
+
+		/*
+		 * Only defer the decoding if the whole payload is within
+		 * the current buffer: otherwise, decode it as usual.
+		 */
+		if (payload_end_at <= buf_size_bits(msg_it)) {
+			bt_event_set_raw_payload_status set_status;
+
+			BT_COMP_LOGT("Setting event's raw payload: "
+				"msg-it-addr=%p, event-class-addr=%p, "
+				"event-class-name=\"%s\", "
+				"event-class-id=%" PRId64 ", "
+				"payload-size=%" PRIu64,
+				msg_it, msg_it->meta.ec,
+				msg_it->meta.ec->name->str,
+				msg_it->meta.ec->id,
+				msg_it->meta.ec->payload_size);
+			set_status = bt_event_set_raw_payload(msg_it->event,
+				msg_it->buf.addr, payload_at);
+			if (set_status) {
+				BT_COMP_LOGE_APPEND_CAUSE(self_comp,
+					"Cannot set event's raw payload: "
+					"msg-it-addr=%p, status=%s", msg_it,
+					bt_common_func_status_string(set_status));
+				status = CTF_MSG_ITER_STATUS_MEMORY_ERROR;
+				goto end;
+			}
+
+			buf_consume_bits(msg_it, payload_end_at - msg_it->buf.at);
+			msg_it->state = STATE_EMIT_MSG_EVENT;
+			goto end;
+		}
+	}
+
 	if (event_payload_fc->in_ir && !msg_it->dry_run) {
 		BT_ASSERT_DBG(!msg_it->dscopes.event_payload);
 		msg_it->dscopes.event_payload =
@@ -2392,8 +2454,7 @@ struct ctf_field_class *bfcr_borrow_variant_selected_field_class_cb(
 		struct ctf_field_class *fc, void *data)
 {
 	int ret;
-	uint64_t i;
-	int64_t option_index = -1;
+	int64_t option_index;
 	struct ctf_msg_iter *msg_it = data;
 	struct ctf_field_class_variant *var_fc = (void *) fc;
 	struct ctf_named_field_class *selected_option = NULL;
@@ -2408,34 +2469,8 @@ struct ctf_field_class *bfcr_borrow_variant_selected_field_class_cb(
 	tag.u = g_array_index(msg_it->stored_values, uint64_t,
 		var_fc->stored_tag_index);
 
-	/*
-	 * Check each range to find the selected option's index.
-	 */
-	if (var_fc->tag_fc->base.is_signed) {
-		for (i = 0; i < var_fc->ranges->len; i++) {
-			struct ctf_field_class_variant_range *range =
-				ctf_field_class_variant_borrow_range_by_index(
-					var_fc, i);
-
-			if (tag.i >= range->range.lower.i &&
-					tag.i <= range->range.upper.i) {
-				option_index = (int64_t) range->option_index;
-				break;
-			}
-		}
-	} else {
-		for (i = 0; i < var_fc->ranges->len; i++) {
-			struct ctf_field_class_variant_range *range =
-				ctf_field_class_variant_borrow_range_by_index(
-					var_fc, i);
-
-			if (tag.u >= range->range.lower.u &&
-					tag.u <= range->range.upper.u) {
-				option_index = (int64_t) range->option_index;
-				break;
-			}
-		}
-	}
+	/* Find the selected option's index */
+	option_index = ctf_field_class_variant_find_option_index(var_fc, tag.u);
 
 	if (option_index < 0) {
 		BT_COMP_LOGE_APPEND_CAUSE(self_comp,
@@ -2586,6 +2621,66 @@ bt_message *emit_delayed_packet_beg_msg(struct ctf_msg_iter *msg_it)
 }
 
 
+/*
+ * Reads the raw bytes of the current packet through the medium and
+ * attaches them, with the number of emitted events, to the current
+ * packet object.
+ */
+static
+int attach_raw_packet_data(struct ctf_msg_iter *msg_it)
+{
+	enum ctf_msg_iter_medium_status medium_status;
+	bt_packet_set_raw_data_status set_status;
+	bt_self_component *self_comp = msg_it->self_comp;
+	int ret = 0;
+
+	if (!msg_it->raw_packet_buf) {
+		msg_it->raw_packet_buf = g_byte_array_new();
+		if (!msg_it->raw_packet_buf) {
+			BT_COMP_LOGE_APPEND_CAUSE(self_comp,
+				"Failed to allocate a GByteArray.");
+			goto error;
+		}
+	}
+
+	g_byte_array_set_size(msg_it->raw_packet_buf, 0);
+	medium_status = msg_it->medium.medops.read_packet(
+		msg_it->raw_packet_buf, msg_it->medium.data);
+	if (medium_status == CTF_MSG_ITER_MEDIUM_STATUS_EOF) {
+		/* Not available for this packet: not an error */
+		BT_COMP_LOGD("Raw packet data is not available: "
+			"msg-it-addr=%p, packet-addr=%p",
+			msg_it, msg_it->packet);
+		goto end;
+	} else if (medium_status != CTF_MSG_ITER_MEDIUM_STATUS_OK) {
+		BT_COMP_LOGE_APPEND_CAUSE(self_comp,
+			"Cannot read raw packet data: "
+			"msg-it-addr=%p, packet-addr=%p, status=%s",
+			msg_it, msg_it->packet,
+			ctf_msg_iter_medium_status_string(medium_status));
+		goto error;
+	}
+
+	set_status = bt_packet_set_raw_data(msg_it->packet,
+		msg_it->raw_packet_buf->data, msg_it->raw_packet_buf->len,
+		msg_it->cur_packet_event_count);
+	if (set_status != BT_PACKET_SET_RAW_DATA_STATUS_OK) {
+		BT_COMP_LOGE_APPEND_CAUSE(self_comp,
+			"Cannot set packet's raw data: "
+			"msg-it-addr=%p, packet-addr=%p",
+			msg_it, msg_it->packet);
+		goto error;
+	}
+
+	goto end;
+
+error:
+	ret = -1;
+
+end:
+	return ret;
+}
+
 static
 bt_message *create_msg_packet_end(struct ctf_msg_iter *msg_it)
 {
@@ -2649,6 +2744,14 @@ bt_message *create_msg_packet_end(struct ctf_msg_iter *msg_it)
 
 	BT_ASSERT(msg_it->self_msg_iter);
 
+	if (msg_it->raw_packets && msg_it->medium.medops.read_packet) {
+		if (attach_raw_packet_data(msg_it)) {
+			/* attach_raw_packet_data() logs errors */
+			msg = NULL;
+			goto end;
+		}
+	}
+
 	if (msg_it->meta.sc->packets_have_ts_end) {
 		BT_ASSERT(msg_it->snapshots.end_clock != UINT64_C(-1));
 		msg = bt_message_packet_end_create_with_default_clock_snapshot(
@@ -2874,6 +2977,10 @@ void ctf_msg_iter_destroy(struct ctf_msg_iter *msg_it)
 		g_array_free(msg_it->stored_values, TRUE);
 	}
 
+	if (msg_it->raw_packet_buf) {
+		g_byte_array_free(msg_it->raw_packet_buf, TRUE);
+	}
+
 	g_free(msg_it);
 }
 
@@ -2923,6 +3030,7 @@ enum ctf_msg_iter_status ctf_msg_iter_get_next_message(
 			} else {
 				*message = msg_it->event_msg;
 				msg_it->event_msg = NULL;
+				msg_it->cur_packet_event_count++;
 			}
 			goto end;
 		case STATE_EMIT_MSG_DISCARDED_EVENTS:
@@ -3201,3 +3309,17 @@ void ctf_msg_iter_set_dry_run(struct ctf_msg_iter *msg_it,
 {
 	msg_it->dry_run = val;
 }
+
+BT_HIDDEN
+void ctf_msg_iter_set_lazy_payloads(struct ctf_msg_iter *msg_it,
+		bool val)
+{
+	msg_it->lazy_payloads = val;
+}
+
+BT_HIDDEN
+void ctf_msg_iter_set_raw_packets(struct ctf_msg_iter *msg_it,
+		bool val)
+{
+	msg_it->raw_packets = val;
+}
@@ -219,6 +219,25 @@ struct ctf_msg_iter_medium_ops {
 	 */
 	bt_stream * (* borrow_stream)(bt_stream_class *stream_class,
 			int64_t stream_id, void *data);
+
+	/**
+	 * Appends the complete raw bytes of the current packet, that
+	 * is, the packet of which the last buffer returned by
+	 * request_bytes() is part, to \p buf.
+	 *
+	 * This *optional* method is only called when raw packets are
+	 * enabled (see ctf_msg_iter_set_raw_packets()), when the
+	 * message iterator is about to create a packet end message.
+	 *
+	 * Return #CTF_MSG_ITER_MEDIUM_STATUS_EOF if the raw bytes of
+	 * the current packet are not available.
+	 *
+	 * @param buf		Byte array to append to
+	 * @param data		User data
+	 * @returns		One of #ctf_msg_iter_medium_status values
+	 */
+	enum ctf_msg_iter_medium_status (* read_packet)(GByteArray *buf,
+			void *data);
 };
 
 /** CTF message iterator. */
@@ -333,6 +352,26 @@ BT_HIDDEN
 void ctf_msg_iter_set_dry_run(struct ctf_msg_iter *msg_it,
 		bool val);
 
+/*
+ * Sets whether or not `msg_it` attaches the raw payload of an event to
+ * the event object instead of decoding its payload field, for the event
+ * classes having a static payload binary layout. The library then
+ * decodes the payload field only if something reads it.
+ */
+BT_HIDDEN
+void ctf_msg_iter_set_lazy_payloads(struct ctf_msg_iter *msg_it,
+		bool val);
+
+/*
+ * Sets whether or not `msg_it` attaches the raw bytes of each complete
+ * packet, as well as its number of events, to the packet object (see
+ * bt_packet_set_raw_data()) when the medium implements
+ * ctf_msg_iter_medium_ops::read_packet().
+ */
+BT_HIDDEN
+void ctf_msg_iter_set_raw_packets(struct ctf_msg_iter *msg_it,
+		bool val);
+
 static inline
 const char *ctf_msg_iter_medium_status_string(
 		enum ctf_msg_iter_medium_status status)
@@ -0,0 +1,143 @@
+/*
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#define BT_COMP_LOG_SELF_COMP (config->self_comp)
+#define BT_LOG_OUTPUT_LEVEL (config->log_level)
+#define BT_LOG_TAG "PLUGIN/CTF/WORKER-POOL"
+#include "logging/comp-logging.h"
+
+#include <babeltrace2/babeltrace.h>
+#include "common/macros.h"
+#include "common/assert.h"
+#include "compat/glib.h"
+#include <glib.h>
+#include <stdbool.h>
+
+#include "worker-pool.h"
+
+/* Maximum number of worker threads */
+#define MAX_WORKERS	16
+
+struct worker_pool_ctx {
+	/* Weak */
+	const struct ctf_worker_pool_config *config;
+
+	void *data;
+	guint job_count;
+
+	/* Index of the next job to run (atomic) */
+	volatile gint next_job_index;
+};
+
+static
+gpointer worker_pool_worker(gpointer data)
+{
+	struct worker_pool_ctx *ctx = data;
+	const struct ctf_worker_pool_config *config = ctx->config;
+	void *worker_data = NULL;
+
+	if (config->init_func && config->init_func(ctx->data, &worker_data)) {
+		/* The other workers run the jobs */
+		BT_COMP_LOGW_STR("Cannot initialize worker.");
+		goto end;
+	}
+
+	while (true) {
+		guint job_index = (guint) g_atomic_int_add(
+			&ctx->next_job_index, 1);
+
+		if (job_index >= ctx->job_count) {
+			break;
+		}
+
+		config->job_func(job_index, worker_data, ctx->data);
+	}
+
+	if (config->fini_func) {
+		config->fini_func(worker_data, ctx->data);
+	}
+
+end:
+	return NULL;
+}
+
+static
+guint get_worker_count(const struct ctf_worker_pool_config *config,
+		guint job_count)
+{
+	guint count = job_count / MAX(config->min_jobs_per_worker, 1);
+
+	count = MIN(count, bt_g_get_num_processors());
+	return MAX(MIN(count, MAX_WORKERS), 1);
+}
+
+BT_HIDDEN
+void ctf_worker_pool_run(const struct ctf_worker_pool_config *config,
+		guint job_count, void *data)
+{
+	guint i;
+	guint worker_count;
+	GPtrArray *threads;
+	struct worker_pool_ctx ctx = {
+		.config = config,
+		.data = data,
+		.job_count = job_count,
+		.next_job_index = 0,
+	};
+
+	BT_ASSERT(config->job_func);
+	worker_count = get_worker_count(config, job_count);
+	threads = g_ptr_array_new();
+	if (!threads) {
+		/* Carry on with the current thread only */
+		BT_COMP_LOGW_STR("Failed to allocate one GPtrArray.");
+		worker_count = 1;
+	}
+
+	/* The current thread is the first worker */
+	for (i = 1; i < worker_count; i++) {
+		GError *gerror = NULL;
+		GThread *thread = g_thread_try_new(config->thread_name,
+			worker_pool_worker, &ctx, &gerror);
+
+		if (!thread) {
+			/* Carry on with the workers we have */
+			BT_COMP_LOGW("Cannot create worker thread: %s",
+				gerror->message);
+			g_error_free(gerror);
+			break;
+		}
+
+		g_ptr_array_add(threads, thread);
+	}
+
+	BT_COMP_LOGD("Running jobs: thread-name=\"%s\", job-count=%u, "
+		"thread-count=%u", config->thread_name, job_count,
+		threads ? threads->len + 1 : 1);
+	worker_pool_worker(&ctx);
+
+	if (threads) {
+		for (i = 0; i < threads->len; i++) {
+			g_thread_join(g_ptr_array_index(threads, i));
+		}
+
+		g_ptr_array_free(threads, TRUE);
+	}
+}
@@ -0,0 +1,90 @@
+#ifndef CTF_WORKER_POOL_H
+#define CTF_WORKER_POOL_H
+
+/*
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <babeltrace2/babeltrace.h>
+#include <glib.h>
+#include "common/macros.h"
+
+/*
+ * Worker initialization function: sets `*worker_data` to the state of
+ * a new worker, which the worker passes to the job and finalization
+ * functions.
+ *
+ * Returns 0 on success. A worker which fails to initialize does not
+ * run any job.
+ */
+typedef int (*ctf_worker_pool_init_func)(void *data, void **worker_data);
+
+/*
+ * Job function: runs the job at index `job_index`.
+ *
+ * This function can be called from any thread.
+ */
+typedef void (*ctf_worker_pool_job_func)(guint job_index,
+		void *worker_data, void *data);
+
+/* Worker finalization function */
+typedef void (*ctf_worker_pool_fini_func)(void *worker_data, void *data);
+
+struct ctf_worker_pool_config {
+	/* Name of the worker threads */
+	const char *thread_name;
+
+	/*
+	 * Minimum number of jobs per worker thread: below this,
+	 * creating a thread costs more than what it saves.
+	 */
+	guint min_jobs_per_worker;
+
+	/* Optional */
+	ctf_worker_pool_init_func init_func;
+
+	ctf_worker_pool_job_func job_func;
+
+	/* Optional */
+	ctf_worker_pool_fini_func fini_func;
+
+	bt_logging_level log_level;
+
+	/* Weak, optional */
+	bt_self_component *self_comp;
+};
+
+/*
+ * Runs `job_count` jobs with the functions of `config`, passing them
+ * `data`, and returns when all the workers are done.
+ *
+ * The calling thread is the first worker: this function only creates
+ * other worker threads (at most one per processor) when there are at
+ * least `config->min_jobs_per_worker` jobs per worker. The workers
+ * take the next job to run until there's none left, so that a job
+ * can run on any worker, in any order: the caller is responsible for
+ * processing the results of the jobs in order afterwards.
+ *
+ * If all the workers fail to initialize, some jobs don't run.
+ */
+BT_HIDDEN
+void ctf_worker_pool_run(const struct ctf_worker_pool_config *config,
+		guint job_count, void *data);
+
+#endif /* CTF_WORKER_POOL_H */
@@ -173,8 +173,14 @@ struct fs_sink_stream *fs_sink_stream_create(struct fs_sink_trace *trace,
 
 	set_stream_file_name(stream);
 	g_string_append_printf(path, "/%s", stream->file_name->str);
-	ret = bt_ctfser_init(&stream->ctfser, path->str,
-		stream->log_level);
+	if (trace->fs_sink->compress) {
+		ret = bt_ctfser_init_compressed(&stream->ctfser, path->str,
+			trace->fs_sink->compression_level, stream->log_level);
+	} else {
+		ret = bt_ctfser_init(&stream->ctfser, path->str,
+			stream->log_level);
+	}
+
 	if (ret) {
 		goto error;
 	}
@@ -624,6 +630,17 @@ int fs_sink_stream_open_packet(struct fs_sink_stream *stream,
 			bt_clock_snapshot_get_value(cs);
 	}
 
+	if (stream->trace->raw_metadata) {
+		/*
+		 * The whole packet is written as is when closing it
+		 * (see write_raw_packet()).
+		 */
+		ret = 0;
+		stream->packet_state.event_count = 0;
+		stream->packet_state.is_open = true;
+		goto end;
+	}
+
 	/* Open packet */
 	ret = bt_ctfser_open_packet(&stream->ctfser);
 	if (ret) {
@@ -689,6 +706,63 @@ end:
 	return ret;
 }
 
+/*
+ * Writes the raw data of the current packet as is.
+ *
+ * The raw data must exist and must contain as many events as this
+ * stream received for the current packet: otherwise, something
+ * between the source and this component removed or added events, and
+ * the raw data does not represent the packet anymore.
+ */
+static
+int write_raw_packet(struct fs_sink_stream *stream)
+{
+	int ret;
+	const void *data;
+	uint64_t size;
+	uint64_t event_count;
+	bt_property_availability avail;
+
+	BT_ASSERT(stream->packet_state.packet);
+	avail = bt_packet_get_raw_data(stream->packet_state.packet, &data,
+		&size, &event_count);
+	if (avail != BT_PROPERTY_AVAILABILITY_AVAILABLE) {
+		BT_COMP_LOGE("Packet has no raw data: "
+			"stream-file-name=%s, packet-seq-num=%" PRIu64,
+			stream->file_name->str, stream->packet_state.seq_num);
+		ret = -1;
+		goto end;
+	}
+
+	if (event_count != stream->packet_state.event_count) {
+		BT_COMP_LOGE("Packet's raw data does not match the packet's "
+			"received events: "
+			"stream-file-name=%s, packet-seq-num=%" PRIu64 ", "
+			"raw-event-count=%" PRIu64 ", event-count=%" PRIu64,
+			stream->file_name->str, stream->packet_state.seq_num,
+			event_count, stream->packet_state.event_count);
+		ret = -1;
+		goto end;
+	}
+
+	ret = bt_ctfser_open_packet(&stream->ctfser);
+	if (ret) {
+		/* bt_ctfser_open_packet() logs errors */
+		goto end;
+	}
+
+	ret = bt_ctfser_write_bytes(&stream->ctfser, data, size);
+	if (ret) {
+		/* bt_ctfser_write_bytes() logs errors */
+		goto end;
+	}
+
+	bt_ctfser_close_current_packet(&stream->ctfser, size);
+
+end:
+	return ret;
+}
+
 BT_HIDDEN
 int fs_sink_stream_close_packet(struct fs_sink_stream *stream,
 		const bt_clock_snapshot *cs)
@@ -701,6 +775,15 @@ int fs_sink_stream_close_packet(struct fs_sink_stream *stream,
 		stream->packet_state.end_cs = bt_clock_snapshot_get_value(cs);
 	}
 
+	if (stream->trace->raw_metadata) {
+		ret = write_raw_packet(stream);
+		if (ret) {
+			goto end;
+		}
+
+		goto update_state;
+	}
+
 	stream->packet_state.content_size =
 		bt_ctfser_get_offset_in_current_packet_bits(&stream->ctfser);
 	stream->packet_state.total_size =
@@ -718,6 +801,7 @@ int fs_sink_stream_close_packet(struct fs_sink_stream *stream,
 	bt_ctfser_close_current_packet(&stream->ctfser,
 		stream->packet_state.total_size / 8);
 
+update_state:
 	/* Partially copy current packet state to previous packet state */
 	stream->prev_packet_state.end_cs = stream->packet_state.end_cs;
 	stream->prev_packet_state.discarded_events_counter =
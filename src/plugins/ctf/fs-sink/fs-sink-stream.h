@@ -89,6 +89,12 @@ struct fs_sink_stream {
 		/* Sequence number (free running) of the current packet */
 		uint64_t seq_num;
 
+		/*
+		 * Number of events received for the current packet when
+		 * writing raw packets (see `fs_sink_trace::raw_metadata`).
+		 */
+		uint64_t event_count;
+
 		/*
 		 * Offset of the packet context structure within the
 		 * current packet (bits).
@@ -29,6 +29,7 @@
 #include <stdio.h>
 #include <stdbool.h>
 #include <glib.h>
+#include <string.h>
 #include "common/assert.h"
 #include "ctfser/ctfser.h"
 
@@ -512,7 +513,12 @@ void fs_sink_trace_destroy(struct fs_sink_trace *trace)
 
 	tsdl = g_string_new(NULL);
 	BT_ASSERT(tsdl);
-	translate_trace_ctf_ir_to_tsdl(trace->trace, tsdl);
+
+	if (trace->raw_metadata) {
+		g_string_assign(tsdl, trace->raw_metadata->str);
+	} else {
+		translate_trace_ctf_ir_to_tsdl(trace->trace, tsdl);
+	}
 
 	BT_ASSERT(trace->metadata_path);
 	fh = fopen(trace->metadata_path->str, "wb");
@@ -553,6 +559,11 @@ void fs_sink_trace_destroy(struct fs_sink_trace *trace)
 	g_string_free(trace->metadata_path, TRUE);
 	trace->metadata_path = NULL;
 
+	if (trace->raw_metadata) {
+		g_string_free(trace->raw_metadata, TRUE);
+		trace->raw_metadata = NULL;
+	}
+
 	fs_sink_ctf_trace_destroy(trace->trace);
 	trace->trace = NULL;
 	g_free(trace);
@@ -584,6 +595,8 @@ struct fs_sink_trace *fs_sink_trace_create(struct fs_sink_comp *fs_sink,
 	int ret;
 	struct fs_sink_trace *trace = g_new0(struct fs_sink_trace, 1);
 	bt_trace_add_listener_status trace_status;
+	const bt_trace_class *ir_tc;
+	const char *raw_fmt_name;
 
 	if (!trace) {
 		goto end;
@@ -610,6 +623,18 @@ struct fs_sink_trace *fs_sink_trace_create(struct fs_sink_comp *fs_sink,
 	trace->metadata_path = g_string_new(trace->path->str);
 	BT_ASSERT(trace->metadata_path);
 	g_string_append(trace->metadata_path, "/metadata");
+
+	ir_tc = bt_trace_borrow_class_const(ir_trace);
+	raw_fmt_name = bt_trace_class_get_raw_packet_format_name(ir_tc);
+	if (raw_fmt_name &&
+			strcmp(raw_fmt_name, FS_SINK_RAW_PACKET_FORMAT_NAME) == 0) {
+		trace->raw_metadata = g_string_new(
+			bt_trace_class_get_raw_packet_format_description(ir_tc));
+		BT_ASSERT(trace->raw_metadata);
+		BT_COMP_LOGI("Writing raw packets of trace: path=\"%s\"",
+			trace->path->str);
+	}
+
 	trace->streams = g_hash_table_new_full(g_direct_hash, g_direct_equal,
 		NULL, (GDestroyNotify) fs_sink_stream_destroy);
 	BT_ASSERT(trace->streams);
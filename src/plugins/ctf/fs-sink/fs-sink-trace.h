@@ -33,6 +33,13 @@
 
 struct fs_sink_comp;
 
+/*
+ * Raw packet format of a trace class (see
+ * bt_trace_class_set_raw_packet_format()) of which this component can
+ * write the metadata and the packets as is.
+ */
+#define FS_SINK_RAW_PACKET_FORMAT_NAME	"ctf-1.8"
+
 struct fs_sink_trace {
 	bt_logging_level log_level;
 	struct fs_sink_comp *fs_sink;
@@ -62,6 +69,16 @@ struct fs_sink_trace {
 	/* `metadata` file path */
 	GString *metadata_path;
 
+	/*
+	 * TSDL metadata text to write as is, when the trace class has
+	 * a compatible raw packet format: in this case, this component
+	 * writes the raw data of each packet (see
+	 * bt_packet_get_raw_data()) instead of encoding its events.
+	 *
+	 * `NULL` if not available.
+	 */
+	GString *raw_metadata;
+
 	/*
 	 * Hash table of `const bt_stream *` (weak) to
 	 * `struct fs_sink_stream *` (owned by hash table).
@@ -28,6 +28,9 @@
 #include <babeltrace2/babeltrace.h>
 #include <stdio.h>
 #include <stdbool.h>
+#include <inttypes.h>
+#include <limits.h>
+#include <string.h>
 #include <glib.h>
 #include "common/assert.h"
 #include "ctfser/ctfser.h"
@@ -65,12 +68,21 @@ end:
 	return status;
 }
 
+/* Default Zstandard compression level (see `compression` parameter) */
+#define DEFAULT_COMPRESSION_LEVEL	3
+
+static const char *compression_choices[] = { "none", "zstd", NULL };
+
 static struct bt_param_validation_map_value_entry_descr fs_sink_params_descr[] = {
 	{ "path", BT_PARAM_VALIDATION_MAP_VALUE_ENTRY_MANDATORY, { .type = BT_VALUE_TYPE_STRING } },
 	{ "assume-single-trace", BT_PARAM_VALIDATION_MAP_VALUE_ENTRY_OPTIONAL, { .type = BT_VALUE_TYPE_BOOL } },
 	{ "ignore-discarded-events", BT_PARAM_VALIDATION_MAP_VALUE_ENTRY_OPTIONAL, { .type = BT_VALUE_TYPE_BOOL } },
 	{ "ignore-discarded-packets", BT_PARAM_VALIDATION_MAP_VALUE_ENTRY_OPTIONAL, { .type = BT_VALUE_TYPE_BOOL } },
 	{ "quiet", BT_PARAM_VALIDATION_MAP_VALUE_ENTRY_OPTIONAL, { .type = BT_VALUE_TYPE_BOOL } },
+	{ "compression", BT_PARAM_VALIDATION_MAP_VALUE_ENTRY_OPTIONAL, { BT_VALUE_TYPE_STRING, .string = {
+		.choices = compression_choices,
+	} } },
+	{ "compression-level", BT_PARAM_VALIDATION_MAP_VALUE_ENTRY_OPTIONAL, { .type = BT_VALUE_TYPE_SIGNED_INTEGER } },
 	BT_PARAM_VALIDATION_MAP_VALUE_ENTRY_END
 };
 
@@ -123,6 +135,38 @@ configure_component(struct fs_sink_comp *fs_sink, const bt_value *params)
 		fs_sink->quiet = (bool) bt_value_bool_get(value);
 	}
 
+	value = bt_value_map_borrow_entry_value_const(params,
+		"compression");
+	if (value) {
+		fs_sink->compress =
+			strcmp(bt_value_string_get(value), "zstd") == 0;
+	}
+
+	if (fs_sink->compress && !bt_ctfser_compression_is_supported()) {
+		BT_COMP_LOGE_APPEND_CAUSE(fs_sink->self_comp,
+			"Cannot compress the data stream files: "
+			"Babeltrace was built without Zstandard support.");
+		status = BT_COMPONENT_CLASS_INITIALIZE_METHOD_STATUS_ERROR;
+		goto end;
+	}
+
+	fs_sink->compression_level = DEFAULT_COMPRESSION_LEVEL;
+	value = bt_value_map_borrow_entry_value_const(params,
+		"compression-level");
+	if (value) {
+		int64_t level = bt_value_integer_signed_get(value);
+
+		if (level < INT_MIN || level > INT_MAX) {
+			BT_COMP_LOGE_APPEND_CAUSE(fs_sink->self_comp,
+				"Invalid `compression-level` parameter: "
+				"value=%" PRId64, level);
+			status = BT_COMPONENT_CLASS_INITIALIZE_METHOD_STATUS_ERROR;
+			goto end;
+		}
+
+		fs_sink->compression_level = (int) level;
+	}
+
 	status = BT_COMPONENT_CLASS_INITIALIZE_METHOD_STATUS_OK;
 
 end:
@@ -289,6 +333,24 @@ bt_component_class_sink_consume_method_status handle_event_msg(
 		goto end;
 	}
 
+	if (stream->trace->raw_metadata) {
+		/*
+		 * The event is part of the packet's raw data: only
+		 * count it to validate the raw data when the packet
+		 * ends.
+		 */
+		if (G_UNLIKELY(!stream->packet_state.is_open)) {
+			BT_COMP_LOGE("Cannot write the raw packets of a stream "
+				"without packets: stream-file-name=%s",
+				stream->file_name->str);
+			status = BT_COMPONENT_CLASS_SINK_CONSUME_METHOD_STATUS_ERROR;
+			goto end;
+		}
+
+		stream->packet_state.event_count++;
+		goto end;
+	}
+
 	ret = try_translate_event_class_trace_ir_to_ctf_ir(fs_sink,
 		stream->sc, bt_event_borrow_class_const(ir_event), &ec);
 	if (ret) {
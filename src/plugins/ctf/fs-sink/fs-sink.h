@@ -58,6 +58,15 @@ struct fs_sink_comp {
 	 */
 	bool quiet;
 
+	/*
+	 * True to compress the data stream files (see
+	 * bt_ctfser_init_compressed()).
+	 */
+	bool compress;
+
+	/* Zstandard compression level when `compress` is true */
+	int compression_level;
+
 	/*
 	 * Hash table of `const bt_trace *` (weak) to
 	 * `struct fs_sink_trace *` (owned by hash table).
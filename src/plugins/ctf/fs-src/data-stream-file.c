@@ -42,6 +42,7 @@
 #include "../common/msg-iter/msg-iter.h"
 #include "common/assert.h"
 #include "data-stream-file.h"
+#include "zstd-file.h"
 #include <string.h>
 
 static inline
@@ -77,12 +78,18 @@ enum ctf_msg_iter_medium_status ds_file_munmap(
 		goto end;
 	}
 
+	if (ds_file->zfile) {
+		/* Decompressed frame: owned by `ds_file->zfile` */
+		ds_file->mmap_addr = NULL;
+		status = CTF_MSG_ITER_MEDIUM_STATUS_OK;
+		goto end;
+	}
+
 	if (bt_munmap(ds_file->mmap_addr, ds_file->mmap_len)) {
 		BT_COMP_LOGE_ERRNO("Cannot memory-unmap file",
-			": address=%p, size=%zu, file_path=\"%s\", file=%p",
+			": address=%p, size=%zu, file_path=\"%s\"",
 			ds_file->mmap_addr, ds_file->mmap_len,
-			ds_file->file ? ds_file->file->path->str : "NULL",
-			ds_file->file ? ds_file->file->fp : NULL);
+			ds_file->file ? ds_file->file->path->str : "NULL");
 		status = CTF_MSG_ITER_MEDIUM_STATUS_ERROR;
 		goto end;
 	}
@@ -110,12 +117,13 @@ enum ctf_msg_iter_medium_status ds_file_mmap(
 		struct ctf_fs_ds_file *ds_file, off_t requested_offset_in_file)
 {
 	enum ctf_msg_iter_medium_status status;
+	int fd;
 	bt_self_component *self_comp = ds_file->self_comp;
 	bt_logging_level log_level = ds_file->log_level;
 
 	/* Ensure the requested offset is in the file range. */
 	BT_ASSERT(requested_offset_in_file >= 0);
-	BT_ASSERT(requested_offset_in_file < ds_file->file->size);
+	BT_ASSERT(requested_offset_in_file < ds_file->size);
 
 	/*
 	 * If the mapping already contains the requested offset, just adjust
@@ -134,6 +142,30 @@ enum ctf_msg_iter_medium_status ds_file_mmap(
 		goto end;
 	}
 
+	if (ds_file->zfile) {
+		/*
+		 * Compressed data stream file: "map" the decompressed
+		 * content of the frame containing
+		 * `requested_offset_in_file`.
+		 */
+		const struct ctf_fs_zstd_frame *frame =
+			ctf_fs_zstd_file_load_frame(ds_file->zfile,
+				requested_offset_in_file);
+
+		if (!frame) {
+			status = CTF_MSG_ITER_MEDIUM_STATUS_ERROR;
+			goto end;
+		}
+
+		ds_file->mmap_addr = ds_file->zfile->buf;
+		ds_file->mmap_offset_in_file = frame->content_offset;
+		ds_file->mmap_len = frame->content_size;
+		ds_file->request_offset_in_mapping =
+			requested_offset_in_file - frame->content_offset;
+		status = CTF_MSG_ITER_MEDIUM_STATUS_OK;
+		goto end;
+	}
+
 	/*
 	 * Compute a mapping that has the required alignment properties and
 	 * contains `requested_offset_in_file`.
@@ -142,23 +174,38 @@ enum ctf_msg_iter_medium_status ds_file_mmap(
 		requested_offset_in_file % bt_mmap_get_offset_align_size(ds_file->log_level);
 	ds_file->mmap_offset_in_file =
 		requested_offset_in_file - ds_file->request_offset_in_mapping;
-	ds_file->mmap_len = MIN(ds_file->file->size - ds_file->mmap_offset_in_file,
+	ds_file->mmap_len = MIN(ds_file->size - ds_file->mmap_offset_in_file,
 		ds_file->mmap_max_len);
 
 	BT_ASSERT(ds_file->mmap_len > 0);
 
+	/*
+	 * The mapping remains valid once the file descriptor is closed,
+	 * so only hold it while mapping: this keeps the number of open
+	 * files bounded by the file descriptor cache's limit.
+	 */
+	fd = ctf_fs_file_get_fd(ds_file->file);
+	if (fd < 0) {
+		status = CTF_MSG_ITER_MEDIUM_STATUS_ERROR;
+		goto end;
+	}
+
 	ds_file->mmap_addr = bt_mmap((void *) 0, ds_file->mmap_len,
-			PROT_READ, MAP_PRIVATE, fileno(ds_file->file->fp),
+			PROT_READ, MAP_PRIVATE, fd,
 			ds_file->mmap_offset_in_file, ds_file->log_level);
 	if (ds_file->mmap_addr == MAP_FAILED) {
-		BT_COMP_LOGE("Cannot memory-map address (size %zu) of file \"%s\" (%p) at offset %jd: %s",
+		BT_COMP_LOGE("Cannot memory-map address (size %zu) of file \"%s\" (fd %d) at offset %jd: %s",
 				ds_file->mmap_len, ds_file->file->path->str,
-				ds_file->file->fp, (intmax_t) ds_file->mmap_offset_in_file,
+				fd, (intmax_t) ds_file->mmap_offset_in_file,
 				strerror(errno));
+		ds_file->mmap_addr = NULL;
+		ctf_fs_file_put_fd(ds_file->file);
 		status = CTF_MSG_ITER_MEDIUM_STATUS_ERROR;
 		goto end;
 	}
 
+	ctf_fs_file_put_fd(ds_file->file);
+
 	status = CTF_MSG_ITER_MEDIUM_STATUS_OK;
 
 end:
@@ -192,7 +239,7 @@ enum ctf_msg_iter_medium_status ds_file_mmap_next(
 	 * If the current mapping coincides with the end of the file, there is
 	 * no next mapping.
 	 */
-	if (ds_file->mmap_offset_in_file + ds_file->mmap_len == ds_file->file->size) {
+	if (ds_file->mmap_offset_in_file + ds_file->mmap_len == ds_file->size) {
 		status = CTF_MSG_ITER_MEDIUM_STATUS_EOF;
 		goto end;
 	}
@@ -223,9 +270,9 @@ enum ctf_msg_iter_medium_status medop_request_bytes(
 	 */
 	if (remaining_mmap_bytes(ds_file) == 0) {
 		/* Are we at the end of the file? */
-		if (ds_file->mmap_offset_in_file >= ds_file->file->size) {
-			BT_COMP_LOGD("Reached end of file \"%s\" (%p)",
-				ds_file->file->path->str, ds_file->file->fp);
+		if (ds_file->mmap_offset_in_file >= ds_file->size) {
+			BT_COMP_LOGD("Reached end of file \"%s\"",
+				ds_file->file->path->str);
 			status = CTF_MSG_ITER_MEDIUM_STATUS_EOF;
 			goto end;
 		}
@@ -237,9 +284,8 @@ enum ctf_msg_iter_medium_status medop_request_bytes(
 		case CTF_MSG_ITER_MEDIUM_STATUS_EOF:
 			goto end;
 		default:
-			BT_COMP_LOGE("Cannot memory-map next region of file \"%s\" (%p)",
-					ds_file->file->path->str,
-					ds_file->file->fp);
+			BT_COMP_LOGE("Cannot memory-map next region of file \"%s\"",
+					ds_file->file->path->str);
 			goto error;
 		}
 	}
@@ -291,7 +337,7 @@ enum ctf_msg_iter_medium_status medop_seek(off_t offset, void *data)
 	struct ctf_fs_ds_file *ds_file = data;
 
 	BT_ASSERT(offset >= 0);
-	BT_ASSERT(offset < ds_file->file->size);
+	BT_ASSERT(offset < ds_file->size);
 
 	return ds_file_mmap(ds_file, offset);
 }
@@ -421,8 +467,7 @@ enum ctf_msg_iter_medium_status medop_group_switch_packet(void *void_data)
 	 * Otherwise, look up the next index entry / packet and prepare it
 	 *  for reading.
 	 */
-	index_entry = g_ptr_array_index(
-		data->ds_file_group->index->entries,
+	index_entry = ctf_fs_ds_index_borrow_entry(data->ds_file_group->index,
 		data->next_index_entry_index);
 
 	status = ctf_fs_ds_group_medops_set_file(
@@ -438,6 +483,57 @@ end:
 	return status;
 }
 
+/*
+ * Appends the packet which `data` is currently reading, as described by
+ * its index entry, to `buf`.
+ *
+ * This changes the current mapping of `data->file`: this is fine
+ * because the message iterator calls this at the end of a packet, and
+ * medop_group_switch_packet() maps the next packet anyway.
+ */
+static
+enum ctf_msg_iter_medium_status medop_group_read_packet(GByteArray *buf,
+		void *void_data)
+{
+	struct ctf_fs_ds_group_medops_data *data = void_data;
+	struct ctf_fs_ds_index_entry *index_entry;
+	enum ctf_msg_iter_medium_status status = CTF_MSG_ITER_MEDIUM_STATUS_OK;
+	uint64_t offset;
+	uint64_t end_offset;
+
+	BT_ASSERT(data->next_index_entry_index > 0);
+	BT_ASSERT(data->file);
+	index_entry = ctf_fs_ds_index_borrow_entry(data->ds_file_group->index,
+		data->next_index_entry_index - 1);
+	offset = index_entry->offset;
+	end_offset = index_entry->offset + index_entry->packet_size;
+
+	if (end_offset > (uint64_t) data->file->size) {
+		/* Truncated packet: not available */
+		status = CTF_MSG_ITER_MEDIUM_STATUS_EOF;
+		goto end;
+	}
+
+	while (offset < end_offset) {
+		size_t len;
+
+		status = ds_file_mmap(data->file, offset);
+		if (status != CTF_MSG_ITER_MEDIUM_STATUS_OK) {
+			goto end;
+		}
+
+		len = MIN(data->file->mmap_len -
+			data->file->request_offset_in_mapping,
+			end_offset - offset);
+		g_byte_array_append(buf, (const guint8 *) data->file->mmap_addr +
+			data->file->request_offset_in_mapping, len);
+		offset += len;
+	}
+
+end:
+	return status;
+}
+
 BT_HIDDEN
 void ctf_fs_ds_group_medops_data_destroy(
 		struct ctf_fs_ds_group_medops_data *data)
@@ -506,6 +602,7 @@ struct ctf_msg_iter_medium_ops ctf_fs_ds_group_medops = {
 	.request_bytes = medop_group_request_bytes,
 	.borrow_stream = medop_group_borrow_stream,
 	.switch_packet = medop_group_switch_packet,
+	.read_packet = medop_group_read_packet,
 
 	/*
 	 * We don't support seeking using this medops.  It would probably be
@@ -514,21 +611,19 @@ struct ctf_msg_iter_medium_ops ctf_fs_ds_group_medops = {
 	.seek = NULL,
 };
 
+/*
+ * Appends a zeroed entry, without packet sequence number, to `index`
+ * and returns it.
+ */
 static
-struct ctf_fs_ds_index_entry *ctf_fs_ds_index_entry_create(
-		bt_self_component *self_comp, bt_logging_level log_level)
+struct ctf_fs_ds_index_entry *ctf_fs_ds_index_append_entry(
+		struct ctf_fs_ds_index *index)
 {
 	struct ctf_fs_ds_index_entry *entry;
 
-	entry = g_new0(struct ctf_fs_ds_index_entry, 1);
-	if (!entry) {
-		BT_COMP_LOGE_APPEND_CAUSE(self_comp, "Failed to allocate a ctf_fs_ds_index_entry.");
-		goto end;
-	}
-
+	g_array_set_size(index->entries, index->entries->len + 1);
+	entry = ctf_fs_ds_index_borrow_entry(index, index->entries->len - 1);
 	entry->packet_seq_num = UINT64_MAX;
-
-end:
 	return entry;
 }
 
@@ -545,7 +640,7 @@ static
 struct ctf_fs_ds_index *build_index_from_idx_file(
 		struct ctf_fs_ds_file *ds_file,
 		struct ctf_fs_ds_file_info *file_info,
-		struct ctf_msg_iter *msg_iter)
+		struct ctf_msg_iter *msg_iter, bool bounds_only)
 {
 	int ret;
 	gchar *directory = NULL;
@@ -557,11 +652,12 @@ struct ctf_fs_ds_index *build_index_from_idx_file(
 	const char *mmap_begin = NULL, *file_pos = NULL;
 	const struct ctf_packet_index_file_hdr *header = NULL;
 	struct ctf_fs_ds_index *index = NULL;
-	struct ctf_fs_ds_index_entry *index_entry = NULL, *prev_index_entry = NULL;
+	struct ctf_fs_ds_index_entry *index_entry, *prev_index_entry = NULL;
 	uint64_t total_packets_size = 0;
 	size_t file_index_entry_size;
 	size_t file_entry_count;
-	size_t i;
+	size_t entry_count;
+	size_t i, entry_i;
 	struct ctf_stream_class *sc;
 	struct ctf_msg_iter_packet_properties props;
 	uint32_t version_major, version_minor;
@@ -631,7 +727,6 @@ struct ctf_fs_ds_index *build_index_from_idx_file(
 	mmap_begin = g_mapped_file_get_contents(mapped_file);
 	header = (struct ctf_packet_index_file_hdr *) mmap_begin;
 
-	file_pos = g_mapped_file_get_contents(mapped_file) + sizeof(*header);
 	if (be32toh(header->magic) != CTF_INDEX_MAGIC) {
 		BT_COMP_LOGW_STR("Invalid LTTng trace index: \"magic\" field validation failed");
 		goto error;
@@ -662,23 +757,37 @@ struct ctf_fs_ds_index *build_index_from_idx_file(
 		goto error;
 	}
 
-	for (i = 0; i < file_entry_count; i++) {
-		struct ctf_packet_index *file_index =
-				(struct ctf_packet_index *) file_pos;
-		uint64_t packet_size = be64toh(file_index->packet_size);
+	/*
+	 * Allocate all the entries at once and convert the file's
+	 * entries in place.
+	 *
+	 * With `bounds_only`, only convert the first and last entries.
+	 */
+	entry_count = bounds_only ? MIN(file_entry_count, 2) :
+		file_entry_count;
+	g_array_set_size(index->entries, entry_count);
+
+	for (entry_i = 0; entry_i < entry_count; entry_i++) {
+		struct ctf_packet_index *file_index;
+		uint64_t packet_size;
+
+		i = entry_i;
+
+		if (bounds_only && entry_i == 1) {
+			i = file_entry_count - 1;
+		}
+
+		file_pos = mmap_begin + sizeof(*header) +
+			i * file_index_entry_size;
+		file_index = (struct ctf_packet_index *) file_pos;
+		packet_size = be64toh(file_index->packet_size);
 
 		if (packet_size % CHAR_BIT) {
 			BT_COMP_LOGW("Invalid packet size encountered in LTTng trace index file");
 			goto error;
 		}
 
-		index_entry = ctf_fs_ds_index_entry_create(
-			ds_file->self_comp, ds_file->log_level);
-		if (!index_entry) {
-			BT_COMP_LOGE_APPEND_CAUSE(ds_file->self_comp,
-				"Failed to create a ctf_fs_ds_index_entry.");
-			goto error;
-		}
+		index_entry = ctf_fs_ds_index_borrow_entry(index, entry_i);
 
 		/* Set path to stream file. */
 		index_entry->path = file_info->path->str;
@@ -688,7 +797,8 @@ struct ctf_fs_ds_index *build_index_from_idx_file(
 		index_entry->packet_size = packet_size;
 
 		index_entry->offset = be64toh(file_index->offset);
-		if (i != 0 && index_entry->offset < prev_index_entry->offset) {
+		if (entry_i != 0 &&
+				index_entry->offset < prev_index_entry->offset) {
 			BT_COMP_LOGW("Invalid, non-monotonic, packet offset encountered in LTTng trace index file: "
 				"previous offset=%" PRIu64 ", current offset=%" PRIu64,
 				prev_index_entry->offset, index_entry->offset);
@@ -723,23 +833,28 @@ struct ctf_fs_ds_index *build_index_from_idx_file(
 
 		if (version_minor >= 1) {
 			index_entry->packet_seq_num = be64toh(file_index->packet_seq_num);
+		} else {
+			index_entry->packet_seq_num = UINT64_MAX;
 		}
 
 		total_packets_size += packet_size;
-		file_pos += file_index_entry_size;
-
 		prev_index_entry = index_entry;
+	}
 
-		/* Give ownership of `index_entry` to `index->entries`. */
-		g_ptr_array_add(index->entries, index_entry);
-		index_entry = NULL;
+	if (bounds_only && prev_index_entry) {
+		/*
+		 * The entries in between were not read: the last
+		 * packet must end where the stream ends instead.
+		 */
+		total_packets_size = prev_index_entry->offset +
+			prev_index_entry->packet_size;
 	}
 
 	/* Validate that the index addresses the complete stream. */
-	if (ds_file->file->size != total_packets_size) {
+	if (ds_file->size != total_packets_size) {
 		BT_COMP_LOGW("Invalid LTTng trace index file; indexed size != stream file size: "
 			"file-size=%" PRIu64 ", total-packets-size=%" PRIu64,
-			ds_file->file->size, total_packets_size);
+			ds_file->size, total_packets_size);
 		goto error;
 	}
 end:
@@ -755,7 +870,6 @@ end:
 	return index;
 error:
 	ctf_fs_ds_index_destroy(index);
-	g_free(index_entry);
 	index = NULL;
 	goto end;
 }
@@ -819,7 +933,7 @@ static
 struct ctf_fs_ds_index *build_index_from_stream_file(
 		struct ctf_fs_ds_file *ds_file,
 		struct ctf_fs_ds_file_info *file_info,
-		struct ctf_msg_iter *msg_iter)
+		struct ctf_msg_iter *msg_iter, bool bounds_only)
 {
 	int ret;
 	struct ctf_fs_ds_index *index = NULL;
@@ -843,10 +957,10 @@ struct ctf_fs_ds_index *build_index_from_stream_file(
 		if (current_packet_offset_bytes < 0) {
 			BT_COMP_LOGE_STR("Cannot get the current packet's offset.");
 			goto error;
-		} else if (current_packet_offset_bytes > ds_file->file->size) {
+		} else if (current_packet_offset_bytes > ds_file->size) {
 			BT_COMP_LOGE_STR("Unexpected current packet's offset (larger than file).");
 			goto error;
-		} else if (current_packet_offset_bytes == ds_file->file->size) {
+		} else if (current_packet_offset_bytes == ds_file->size) {
 			/* No more data */
 			break;
 		}
@@ -867,27 +981,30 @@ struct ctf_fs_ds_index *build_index_from_stream_file(
 			current_packet_size_bytes =
 				(uint64_t) props.exp_packet_total_size / 8;
 		} else {
-			current_packet_size_bytes = ds_file->file->size;
+			current_packet_size_bytes = ds_file->size;
 		}
 
 		if (current_packet_offset_bytes + current_packet_size_bytes >
-				ds_file->file->size) {
+				ds_file->size) {
 			BT_COMP_LOGW("Invalid packet size reported in file: stream=\"%s\", "
 					"packet-offset=%jd, packet-size-bytes=%jd, "
 					"file-size=%jd",
 					ds_file->file->path->str,
 					(intmax_t) current_packet_offset_bytes,
 					(intmax_t) current_packet_size_bytes,
-					(intmax_t) ds_file->file->size);
+					(intmax_t) ds_file->size);
 			goto error;
 		}
 
-		index_entry = ctf_fs_ds_index_entry_create(
-			ds_file->self_comp, ds_file->log_level);
-		if (!index_entry) {
-			BT_COMP_LOGE_APPEND_CAUSE(ds_file->self_comp,
-				"Failed to create a ctf_fs_ds_index_entry.");
-			goto error;
+		if (bounds_only && index->entries->len == 2) {
+			/*
+			 * Each packet's offset depends on the size of
+			 * the previous one, so all the packets must be
+			 * visited, but only the last one is kept.
+			 */
+			index_entry = ctf_fs_ds_index_borrow_entry(index, 1);
+		} else {
+			index_entry = ctf_fs_ds_index_append_entry(index);
 		}
 
 		/* Set path to stream file. */
@@ -896,12 +1013,9 @@ struct ctf_fs_ds_index *build_index_from_stream_file(
 		ret = init_index_entry(index_entry, ds_file, &props,
 			current_packet_size_bytes, current_packet_offset_bytes);
 		if (ret) {
-			g_free(index_entry);
 			goto error;
 		}
 
-		g_ptr_array_add(index->entries, index_entry);
-
 		current_packet_offset_bytes += current_packet_size_bytes;
 		BT_COMP_LOGD("Seeking to next packet: current-packet-offset=%jd, "
 			"next-packet-offset=%jd",
@@ -918,14 +1032,15 @@ error:
 	goto end;
 }
 
-BT_HIDDEN
-struct ctf_fs_ds_file *ctf_fs_ds_file_create(
-		struct ctf_fs_trace *ctf_fs_trace,
+static
+struct ctf_fs_ds_file *create_ds_file(struct ctf_fs_trace *ctf_fs_trace,
+		struct bt_fd_cache *fd_cache,
 		bt_self_message_iterator *self_msg_iter,
 		bt_stream *stream, const char *path,
 		bt_logging_level log_level)
 {
 	int ret;
+	bool is_compressed;
 	const size_t offset_align = bt_mmap_get_offset_align_size(log_level);
 	struct ctf_fs_ds_file *ds_file = g_new0(struct ctf_fs_ds_file, 1);
 
@@ -945,11 +1060,27 @@ struct ctf_fs_ds_file *ctf_fs_ds_file_create(
 	bt_stream_get_ref(ds_file->stream);
 	ds_file->metadata = ctf_fs_trace->metadata;
 	g_string_assign(ds_file->file->path, path);
-	ret = ctf_fs_file_open(ds_file->file, "rb");
+	ret = ctf_fs_file_open_with_fd_cache(ds_file->file, fd_cache);
 	if (ret) {
 		goto error;
 	}
 
+	ret = ctf_fs_zstd_file_is_compressed(ds_file->file, &is_compressed);
+	if (ret) {
+		goto error;
+	}
+
+	if (is_compressed) {
+		ds_file->zfile = ctf_fs_zstd_file_create(ds_file->file);
+		if (!ds_file->zfile) {
+			goto error;
+		}
+
+		ds_file->size = ds_file->zfile->content_size;
+	} else {
+		ds_file->size = ds_file->file->size;
+	}
+
 	ds_file->mmap_max_len = offset_align * 2048;
 
 	goto end;
@@ -963,24 +1094,47 @@ end:
 	return ds_file;
 }
 
+BT_HIDDEN
+struct ctf_fs_ds_file *ctf_fs_ds_file_create(
+		struct ctf_fs_trace *ctf_fs_trace,
+		bt_self_message_iterator *self_msg_iter,
+		bt_stream *stream, const char *path,
+		bt_logging_level log_level)
+{
+	return create_ds_file(ctf_fs_trace, &ctf_fs_trace->fd_cache,
+		self_msg_iter, stream, path, log_level);
+}
+
+BT_HIDDEN
+struct ctf_fs_ds_file *ctf_fs_ds_file_create_with_fd_cache(
+		struct ctf_fs_trace *ctf_fs_trace,
+		struct bt_fd_cache *fd_cache, const char *path,
+		bt_logging_level log_level)
+{
+	return create_ds_file(ctf_fs_trace, fd_cache, NULL, NULL, path,
+		log_level);
+}
+
 BT_HIDDEN
 struct ctf_fs_ds_index *ctf_fs_ds_file_build_index(
 		struct ctf_fs_ds_file *ds_file,
 		struct ctf_fs_ds_file_info *file_info,
-		struct ctf_msg_iter *msg_iter)
+		struct ctf_msg_iter *msg_iter, bool bounds_only)
 {
 	struct ctf_fs_ds_index *index;
 	bt_self_component *self_comp = ds_file->self_comp;
 	bt_logging_level log_level = ds_file->log_level;
 
-	index = build_index_from_idx_file(ds_file, file_info, msg_iter);
+	index = build_index_from_idx_file(ds_file, file_info, msg_iter,
+		bounds_only);
 	if (index) {
 		goto end;
 	}
 
 	BT_COMP_LOGI("Failed to build index from .index file; "
 		"falling back to stream indexing.");
-	index = build_index_from_stream_file(ds_file, file_info, msg_iter);
+	index = build_index_from_stream_file(ds_file, file_info, msg_iter,
+		bounds_only);
 end:
 	return index;
 }
@@ -997,7 +1151,8 @@ struct ctf_fs_ds_index *ctf_fs_ds_index_create(bt_logging_level log_level,
 		goto error;
 	}
 
-	index->entries = g_ptr_array_new_with_free_func((GDestroyNotify) g_free);
+	index->entries = g_array_new(FALSE, TRUE,
+		sizeof(struct ctf_fs_ds_index_entry));
 	if (!index->entries) {
 		BT_COMP_LOG_CUR_LVL(BT_LOG_ERROR, log_level, self_comp,
 			"Failed to allocate index entries.");
@@ -1022,6 +1177,7 @@ void ctf_fs_ds_file_destroy(struct ctf_fs_ds_file *ds_file)
 
 	bt_stream_put_ref(ds_file->stream);
 	(void) ds_file_munmap(ds_file);
+	ctf_fs_zstd_file_destroy(ds_file->zfile);
 
 	if (ds_file->file) {
 		ctf_fs_file_destroy(ds_file->file);
@@ -1038,7 +1194,7 @@ void ctf_fs_ds_index_destroy(struct ctf_fs_ds_index *index)
 	}
 
 	if (index->entries) {
-		g_ptr_array_free(index->entries, TRUE);
+		g_array_free(index->entries, TRUE);
 	}
 	g_free(index);
 }
@@ -34,6 +34,7 @@
 
 struct ctf_fs_component;
 struct ctf_fs_file;
+struct ctf_fs_zstd_file;
 struct ctf_fs_trace;
 struct ctf_fs_ds_file;
 struct ctf_fs_ds_file_group;
@@ -64,6 +65,18 @@ struct ctf_fs_ds_file {
 	/* Owned by this */
 	struct ctf_fs_file *file;
 
+	/*
+	 * Owned by this, set if `file` is a compressed data stream file:
+	 * a mapping is then the decompressed content of a single frame.
+	 */
+	struct ctf_fs_zstd_file *zfile;
+
+	/*
+	 * Size of the data stream: size of the decompressed content if
+	 * `zfile` is set, or size of `file` otherwise.
+	 */
+	off_t size;
+
 	/* Owned by this */
 	bt_stream *stream;
 
@@ -95,14 +108,37 @@ struct ctf_fs_ds_file *ctf_fs_ds_file_create(
 		bt_stream *stream, const char *path,
 		bt_logging_level log_level);
 
+/*
+ * Like ctf_fs_ds_file_create() without message iterator and stream,
+ * but opens the file through `fd_cache` instead of the file
+ * descriptor cache of `ctf_fs_trace`.
+ *
+ * Use this to read data stream files of the same trace from
+ * different threads, each one with its own file descriptor cache.
+ */
+BT_HIDDEN
+struct ctf_fs_ds_file *ctf_fs_ds_file_create_with_fd_cache(
+		struct ctf_fs_trace *ctf_fs_trace,
+		struct bt_fd_cache *fd_cache, const char *path,
+		bt_logging_level log_level);
+
 BT_HIDDEN
 void ctf_fs_ds_file_destroy(struct ctf_fs_ds_file *stream);
 
+/*
+ * Builds the index of `ds_file`, from its LTTng index file if
+ * available, or from its packets otherwise.
+ *
+ * If `bounds_only` is true, the returned index only contains the
+ * entries of the first and last packets of `ds_file`, which is enough
+ * to get its time range. With an LTTng index file, this function then
+ * only reads the header and those two entries.
+ */
 BT_HIDDEN
 struct ctf_fs_ds_index *ctf_fs_ds_file_build_index(
 		struct ctf_fs_ds_file *ds_file,
 		struct ctf_fs_ds_file_info *ds_file_info,
-		struct ctf_msg_iter *msg_iter);
+		struct ctf_msg_iter *msg_iter, bool bounds_only);
 
 BT_HIDDEN
 struct ctf_fs_ds_index *ctf_fs_ds_index_create(bt_logging_level log_level,
@@ -30,6 +30,7 @@
 #include <sys/stat.h>
 #include <unistd.h>
 #include <glib.h>
+#include "common/assert.h"
 #include "file.h"
 
 BT_HIDDEN
@@ -39,6 +40,8 @@ void ctf_fs_file_destroy(struct ctf_fs_file *file)
 		return;
 	}
 
+	ctf_fs_file_put_fd(file);
+
 	if (file->fp) {
 		BT_COMP_LOGD("Closing file \"%s\" (%p)",
 				file->path ? file->path->str : NULL, file->fp);
@@ -125,3 +128,75 @@ error:
 end:
 	return ret;
 }
+
+BT_HIDDEN
+int ctf_fs_file_open_with_fd_cache(struct ctf_fs_file *file,
+		struct bt_fd_cache *fd_cache)
+{
+	int ret = 0;
+	int fd;
+	struct stat stat;
+
+	BT_ASSERT(!file->fp);
+	BT_ASSERT(!file->fd_cache);
+	file->fd_cache = fd_cache;
+	BT_COMP_LOGI("Opening file \"%s\" through file descriptor cache",
+		file->path->str);
+	fd = ctf_fs_file_get_fd(file);
+	if (fd < 0) {
+		goto error;
+	}
+
+	if (fstat(fd, &stat)) {
+		BT_COMP_LOGE_APPEND_CAUSE_ERRNO(file->self_comp,
+			"Cannot get file information",
+			": path=%s", file->path->str);
+		goto error;
+	}
+
+	file->size = stat.st_size;
+	BT_COMP_LOGI("File is %jd bytes", (intmax_t) file->size);
+	goto end;
+
+error:
+	ret = -1;
+
+end:
+	ctf_fs_file_put_fd(file);
+	return ret;
+}
+
+BT_HIDDEN
+int ctf_fs_file_get_fd(struct ctf_fs_file *file)
+{
+	int fd = -1;
+
+	BT_ASSERT(file->fd_cache);
+
+	if (!file->fd_handle) {
+		file->fd_handle = bt_fd_cache_get_handle(file->fd_cache,
+			file->path->str);
+		if (!file->fd_handle) {
+			BT_COMP_LOGE_APPEND_CAUSE_ERRNO(file->self_comp,
+				"Cannot open file", ": path=%s",
+				file->path->str);
+			goto end;
+		}
+	}
+
+	fd = bt_fd_cache_handle_get_fd(file->fd_handle);
+
+end:
+	return fd;
+}
+
+BT_HIDDEN
+void ctf_fs_file_put_fd(struct ctf_fs_file *file)
+{
+	if (!file->fd_handle) {
+		return;
+	}
+
+	bt_fd_cache_put_handle(file->fd_cache, file->fd_handle);
+	file->fd_handle = NULL;
+}
@@ -38,4 +38,26 @@ struct ctf_fs_file *ctf_fs_file_create(bt_logging_level log_level,
 BT_HIDDEN
 int ctf_fs_file_open(struct ctf_fs_file *file, const char *mode);
 
+/*
+ * Opens `file` for reading through `fd_cache` and sets its size.
+ *
+ * Contrary to ctf_fs_file_open(), `file` does not keep a file
+ * descriptor open: get one with ctf_fs_file_get_fd() when needed and
+ * put it back with ctf_fs_file_put_fd() as soon as possible so that
+ * the cache may close it.
+ */
+BT_HIDDEN
+int ctf_fs_file_open_with_fd_cache(struct ctf_fs_file *file,
+		struct bt_fd_cache *fd_cache);
+
+/*
+ * Returns a file descriptor for `file`, opened with
+ * ctf_fs_file_open_with_fd_cache(), or -1 on error.
+ */
+BT_HIDDEN
+int ctf_fs_file_get_fd(struct ctf_fs_file *file);
+
+BT_HIDDEN
+void ctf_fs_file_put_fd(struct ctf_fs_file *file);
+
 #endif /* CTF_FS_FILE_H */
@@ -44,6 +44,7 @@
 #include "../common/metadata/decoder.h"
 #include "../common/metadata/ctf-meta-configure-ir-trace.h"
 #include "../common/msg-iter/msg-iter.h"
+#include "../common/worker-pool.h"
 #include "query.h"
 #include "plugins/common/param-validation/param-validation.h"
 
@@ -264,6 +265,17 @@ bt_message_iterator_class_initialize_method_status ctf_fs_iterator_init(
 		goto error;
 	}
 
+	ctf_msg_iter_set_lazy_payloads(msg_iter_data->msg_iter,
+		port_data->ctf_fs->lazy_payloads);
+
+	/*
+	 * The trace class only has a raw packet format with the
+	 * `raw-packets` parameter (see ctf_fs_metadata_set_trace_class()).
+	 */
+	ctf_msg_iter_set_raw_packets(msg_iter_data->msg_iter,
+		bt_trace_class_get_raw_packet_format_name(
+			msg_iter_data->ds_file_group->ctf_fs_trace->metadata->trace_class));
+
 	/*
 	 * This iterator can seek forward if its stream class has a default
 	 * clock class.
@@ -310,6 +322,7 @@ void ctf_fs_trace_destroy(struct ctf_fs_trace *ctf_fs_trace)
 		g_free(ctf_fs_trace->metadata);
 	}
 
+	bt_fd_cache_fini(&ctf_fs_trace->fd_cache);
 	g_free(ctf_fs_trace);
 }
 
@@ -326,6 +339,7 @@ void ctf_fs_destroy(struct ctf_fs_component *ctf_fs)
 		g_ptr_array_free(ctf_fs->port_data, TRUE);
 	}
 
+	g_free(ctf_fs->metadata_config.cache_dir);
 	g_free(ctf_fs);
 }
 
@@ -666,28 +680,35 @@ bool ds_index_entries_equal(
 }
 
 /*
- * Insert `entry` into `index`, without duplication.
+ * Insert a copy of `entry` into `index`, without duplication.
  *
  * The entry is inserted only if there isn't an identical entry already.
- *
- * In any case, the ownership of `entry` is transferred to this function.  So if
- * the entry is not inserted, it is freed.
  */
 
 static
 void ds_index_insert_ds_index_entry_sorted(
 	struct ctf_fs_ds_index *index,
-	struct ctf_fs_ds_index_entry *entry)
+	const struct ctf_fs_ds_index_entry *entry)
 {
-	guint i;
-	struct ctf_fs_ds_index_entry *other_entry;
+	guint low = 0;
+	guint high = index->entries->len;
 
-	/* Find the spot where to insert this index entry. */
-	for (i = 0; i < index->entries->len; i++) {
-		other_entry = g_ptr_array_index(index->entries, i);
+	/*
+	 * Find the spot where to insert this index entry: the first entry
+	 * which doesn't begin before it.
+	 *
+	 * The entries of `index` are sorted by beginning time, and the
+	 * entries to merge are usually later than all of them, so avoid a
+	 * linear scan.
+	 */
+	while (low < high) {
+		guint mid = low + (high - low) / 2;
 
-		if (entry->timestamp_begin_ns <= other_entry->timestamp_begin_ns) {
-			break;
+		if (ctf_fs_ds_index_borrow_entry(index, mid)->timestamp_begin_ns <
+				entry->timestamp_begin_ns) {
+			low = mid + 1;
+		} else {
+			high = mid;
 		}
 	}
 
@@ -698,11 +719,10 @@ void ds_index_insert_ds_index_entry_sorted(
 	 * snapshots of the same trace.  We then want the index to contain
 	 * a reference to only one copy of that packet.
 	 */
-	if (i == index->entries->len ||
-			!ds_index_entries_equal(entry, other_entry)) {
-		array_insert(index->entries, entry, i);
-	} else {
-		g_free(entry);
+	if (low == index->entries->len ||
+			!ds_index_entries_equal(entry,
+				ctf_fs_ds_index_borrow_entry(index, low))) {
+		g_array_insert_val(index->entries, low, *entry);
 	}
 }
 
@@ -712,34 +732,69 @@ void merge_ctf_fs_ds_indexes(struct ctf_fs_ds_index *dest, struct ctf_fs_ds_inde
 	guint i;
 
 	for (i = 0; i < src->entries->len; i++) {
-		struct ctf_fs_ds_index_entry *entry =
-			g_ptr_array_index(src->entries, i);
+		ds_index_insert_ds_index_entry_sorted(dest,
+			ctf_fs_ds_index_borrow_entry(src, i));
+	}
+}
 
-		/*
-		* Ownership of the ctf_fs_ds_index_entry is transferred to
-		* ds_index_insert_ds_index_entry_sorted.
-		*/
-		g_ptr_array_index(src->entries, i) = NULL;
-		ds_index_insert_ds_index_entry_sorted(dest, entry);
+/*
+ * Properties of a data stream file, read by scan_ds_file().
+ */
+struct ds_file_scan {
+	/* Owned by this */
+	gchar *path;
+
+	/* Owned by this */
+	struct ctf_fs_ds_file_info *ds_file_info;
+
+	/* Owned by this */
+	struct ctf_fs_ds_index *index;
+
+	/* Weak */
+	struct ctf_stream_class *sc;
+
+	int64_t stream_instance_id;
+
+	/* Result of scan_ds_file() */
+	int ret;
+
+	/*
+	 * Error of a failed scan_ds_file() call, taken from the thread
+	 * which made it (owned by this).
+	 */
+	const bt_error *error;
+};
+
+static
+void ds_file_scan_fini(struct ds_file_scan *scan)
+{
+	g_free(scan->path);
+	ctf_fs_ds_file_info_destroy(scan->ds_file_info);
+	ctf_fs_ds_index_destroy(scan->index);
+
+	if (scan->error) {
+		bt_error_release(scan->error);
 	}
 }
 
+/*
+ * Reads the properties of the data stream file `scan->path`, opening
+ * it through `fd_cache`, and builds its index.
+ *
+ * This function only reads `ctf_fs_trace`: you may call it from
+ * different threads at the same time, each one with its own file
+ * descriptor cache.
+ */
 static
-int add_ds_file_to_ds_file_group(struct ctf_fs_trace *ctf_fs_trace,
-		const char *path)
+int scan_ds_file(struct ctf_fs_trace *ctf_fs_trace,
+		struct bt_fd_cache *fd_cache, struct ds_file_scan *scan)
 {
-	int64_t stream_instance_id = -1;
 	int64_t begin_ns = -1;
-	struct ctf_fs_ds_file_group *ds_file_group = NULL;
-	bool add_group = false;
 	int ret;
-	size_t i;
 	struct ctf_fs_ds_file *ds_file = NULL;
-	struct ctf_fs_ds_file_info *ds_file_info = NULL;
-	struct ctf_fs_ds_index *index = NULL;
 	struct ctf_msg_iter *msg_iter = NULL;
-	struct ctf_stream_class *sc = NULL;
 	struct ctf_msg_iter_packet_properties props;
+	const char *path = scan->path;
 	bt_logging_level log_level = ctf_fs_trace->log_level;
 	bt_self_component *self_comp = ctf_fs_trace->self_comp;
 	bt_self_component_class *self_comp_class = ctf_fs_trace->self_comp_class;
@@ -748,8 +803,8 @@ int add_ds_file_to_ds_file_group(struct ctf_fs_trace *ctf_fs_trace,
 	 * Create a temporary ds_file to read some properties about the data
 	 * stream file.
 	 */
-	ds_file = ctf_fs_ds_file_create(ctf_fs_trace, NULL, NULL, path,
-		log_level);
+	ds_file = ctf_fs_ds_file_create_with_fd_cache(ctf_fs_trace, fd_cache,
+		path, log_level);
 	if (!ds_file) {
 		goto error;
 	}
@@ -773,18 +828,18 @@ int add_ds_file_to_ds_file_group(struct ctf_fs_trace *ctf_fs_trace,
 		goto error;
 	}
 
-	sc = ctf_trace_class_borrow_stream_class_by_id(ds_file->metadata->tc,
-		props.stream_class_id);
-	BT_ASSERT(sc);
-	stream_instance_id = props.data_stream_id;
+	scan->sc = ctf_trace_class_borrow_stream_class_by_id(
+		ds_file->metadata->tc, props.stream_class_id);
+	BT_ASSERT(scan->sc);
+	scan->stream_instance_id = props.data_stream_id;
 
 	if (props.snapshots.beginning_clock != UINT64_C(-1)) {
-		BT_ASSERT(sc->default_clock_class);
+		BT_ASSERT(scan->sc->default_clock_class);
 		ret = bt_util_clock_cycles_to_ns_from_origin(
 			props.snapshots.beginning_clock,
-			sc->default_clock_class->frequency,
-			sc->default_clock_class->offset_seconds,
-			sc->default_clock_class->offset_cycles, &begin_ns);
+			scan->sc->default_clock_class->frequency,
+			scan->sc->default_clock_class->offset_seconds,
+			scan->sc->default_clock_class->offset_cycles, &begin_ns);
 		if (ret) {
 			BT_COMP_OR_COMP_CLASS_LOGE_APPEND_CAUSE(self_comp, self_comp_class,
 				"Cannot convert clock cycles to nanoseconds from origin (`%s`).",
@@ -793,13 +848,14 @@ int add_ds_file_to_ds_file_group(struct ctf_fs_trace *ctf_fs_trace,
 		}
 	}
 
-	ds_file_info = ctf_fs_ds_file_info_create(path, begin_ns);
-	if (!ds_file_info) {
+	scan->ds_file_info = ctf_fs_ds_file_info_create(path, begin_ns);
+	if (!scan->ds_file_info) {
 		goto error;
 	}
 
-	index = ctf_fs_ds_file_build_index(ds_file, ds_file_info, msg_iter);
-	if (!index) {
+	scan->index = ctf_fs_ds_file_build_index(ds_file, scan->ds_file_info,
+		msg_iter, ctf_fs_trace->bounds_only_indexes);
+	if (!scan->index) {
 		BT_COMP_OR_COMP_CLASS_LOGE_APPEND_CAUSE(
 			self_comp, self_comp_class,
 			"Failed to index CTF stream file \'%s\'",
@@ -807,6 +863,38 @@ int add_ds_file_to_ds_file_group(struct ctf_fs_trace *ctf_fs_trace,
 		goto error;
 	}
 
+	ret = 0;
+	goto end;
+
+error:
+	ret = -1;
+
+end:
+	ctf_fs_ds_file_destroy(ds_file);
+
+	if (msg_iter) {
+		ctf_msg_iter_destroy(msg_iter);
+	}
+
+	return ret;
+}
+
+/*
+ * Adds the data stream file of `scan`, a successful scan, to a data
+ * stream file group of `ctf_fs_trace`, moving its file info and index.
+ */
+static
+int add_ds_file_scan_to_ds_file_group(struct ctf_fs_trace *ctf_fs_trace,
+		struct ds_file_scan *scan)
+{
+	int64_t stream_instance_id = scan->stream_instance_id;
+	int64_t begin_ns = scan->ds_file_info->begin_ns;
+	struct ctf_fs_ds_file_group *ds_file_group = NULL;
+	struct ctf_stream_class *sc = scan->sc;
+	bool add_group = false;
+	int ret = 0;
+	size_t i;
+
 	if (begin_ns == -1) {
 		/*
 		 * No beginning timestamp to sort the stream files
@@ -825,16 +913,16 @@ int add_ds_file_to_ds_file_group(struct ctf_fs_trace *ctf_fs_trace,
 		 * group.
 		 */
 		ds_file_group = ctf_fs_ds_file_group_create(ctf_fs_trace,
-			sc, UINT64_C(-1), index);
+			sc, UINT64_C(-1), scan->index);
 		/* Ownership of index is transferred. */
-		index = NULL;
+		scan->index = NULL;
 
 		if (!ds_file_group) {
 			goto error;
 		}
 
 		ds_file_group_insert_ds_file_info_sorted(ds_file_group,
-			BT_MOVE_REF(ds_file_info));
+			BT_MOVE_REF(scan->ds_file_info));
 
 		add_group = true;
 		goto end;
@@ -859,20 +947,20 @@ int add_ds_file_to_ds_file_group(struct ctf_fs_trace *ctf_fs_trace,
 
 	if (!ds_file_group) {
 		ds_file_group = ctf_fs_ds_file_group_create(ctf_fs_trace,
-			sc, stream_instance_id, index);
+			sc, stream_instance_id, scan->index);
 		/* Ownership of index is transferred. */
-		index = NULL;
+		scan->index = NULL;
 		if (!ds_file_group) {
 			goto error;
 		}
 
 		add_group = true;
 	} else {
-		merge_ctf_fs_ds_indexes(ds_file_group->index, index);
+		merge_ctf_fs_ds_indexes(ds_file_group->index, scan->index);
 	}
 
 	ds_file_group_insert_ds_file_info_sorted(ds_file_group,
-		BT_MOVE_REF(ds_file_info));
+		BT_MOVE_REF(scan->ds_file_info));
 
 	goto end;
 
@@ -886,14 +974,201 @@ end:
 		g_ptr_array_add(ctf_fs_trace->ds_file_groups, ds_file_group);
 	}
 
-	ctf_fs_ds_file_destroy(ds_file);
-	ctf_fs_ds_file_info_destroy(ds_file_info);
+	return ret;
+}
 
-	if (msg_iter) {
-		ctf_msg_iter_destroy(msg_iter);
+static
+int add_ds_file_to_ds_file_group(struct ctf_fs_trace *ctf_fs_trace,
+		const char *path)
+{
+	int ret;
+	struct ds_file_scan scan = { 0 };
+
+	scan.path = g_strdup(path);
+	if (!scan.path) {
+		ret = -1;
+		goto end;
+	}
+
+	ret = scan_ds_file(ctf_fs_trace, &ctf_fs_trace->fd_cache, &scan);
+	if (ret) {
+		goto end;
+	}
+
+	ret = add_ds_file_scan_to_ds_file_group(ctf_fs_trace, &scan);
+
+end:
+	ds_file_scan_fini(&scan);
+	return ret;
+}
+
+/*
+ * Minimum number of data stream files per worker thread when scanning
+ * them in parallel.
+ */
+#define MIN_DS_FILES_PER_SCAN_WORKER	2
+
+struct ds_file_scans_ctx {
+	/* Weak */
+	struct ctf_fs_trace *ctf_fs_trace;
+
+	/* Array of `struct ds_file_scan` */
+	GArray *scans;
+};
+
+static
+int init_ds_file_scans_worker(void *data, void **worker_data)
+{
+	struct ds_file_scans_ctx *ctx = data;
+	struct bt_fd_cache *fd_cache;
+	bt_logging_level log_level = ctx->ctf_fs_trace->log_level;
+	bt_self_component *self_comp = ctx->ctf_fs_trace->self_comp;
+	int ret = 0;
+
+	/*
+	 * The file descriptor cache of the trace is not thread-safe:
+	 * each worker has its own. Each file is only read once, so
+	 * there's no point in keeping idle file descriptors open.
+	 */
+	fd_cache = g_new0(struct bt_fd_cache, 1);
+	if (!fd_cache || bt_fd_cache_init(fd_cache, log_level)) {
+		/*
+		 * This worker does not run any scan: the other
+		 * workers run them.
+		 */
+		BT_COMP_LOGE_STR("Cannot initialize file descriptor cache.");
+		g_free(fd_cache);
+		ret = -1;
+		goto end;
+	}
+
+	bt_fd_cache_set_max_open_fds(fd_cache, 1);
+	*worker_data = fd_cache;
+
+end:
+	return ret;
+}
+
+static
+void run_ds_file_scan(guint scan_index, void *worker_data, void *data)
+{
+	struct ds_file_scans_ctx *ctx = data;
+	struct ds_file_scan *scan = &g_array_index(ctx->scans,
+		struct ds_file_scan, scan_index);
+
+	scan->ret = scan_ds_file(ctx->ctf_fs_trace, worker_data, scan);
+	if (scan->ret) {
+		/*
+		 * The current thread error is thread-local: keep it so
+		 * that the calling thread can move it back.
+		 */
+		scan->error = bt_current_thread_take_error();
+	}
+}
+
+static
+void fini_ds_file_scans_worker(void *worker_data, void *data)
+{
+	struct bt_fd_cache *fd_cache = worker_data;
+
+	bt_fd_cache_fini(fd_cache);
+	g_free(fd_cache);
+}
+
+/*
+ * Scans the data stream files `paths` (array of `gchar *`) in
+ * parallel, and then adds them to the data stream file groups of
+ * `ctf_fs_trace` in order.
+ */
+static
+int add_ds_files_to_ds_file_groups_parallel(
+		struct ctf_fs_trace *ctf_fs_trace, GPtrArray *paths)
+{
+	int ret = 0;
+	guint i;
+	bt_logging_level log_level = ctf_fs_trace->log_level;
+	bt_self_component *self_comp = ctf_fs_trace->self_comp;
+	bt_self_component_class *self_comp_class = ctf_fs_trace->self_comp_class;
+	struct ds_file_scans_ctx ctx = {
+		.ctf_fs_trace = ctf_fs_trace,
+		.scans = NULL,
+	};
+	const struct ctf_worker_pool_config pool_config = {
+		.thread_name = "bt-ctf-fs-scan",
+		.min_jobs_per_worker = MIN_DS_FILES_PER_SCAN_WORKER,
+		.init_func = init_ds_file_scans_worker,
+		.job_func = run_ds_file_scan,
+		.fini_func = fini_ds_file_scans_worker,
+		.log_level = log_level,
+		.self_comp = self_comp,
+	};
+
+	ctx.scans = g_array_sized_new(FALSE, TRUE, sizeof(struct ds_file_scan),
+		paths->len);
+	if (!ctx.scans) {
+		BT_COMP_OR_COMP_CLASS_LOGE_APPEND_CAUSE(self_comp, self_comp_class,
+			"Failed to allocate one GArray.");
+		goto error;
+	}
+
+	for (i = 0; i < paths->len; i++) {
+		/*
+		 * A scan which no worker runs (if all of them fail to
+		 * initialize) remains failed.
+		 */
+		struct ds_file_scan scan = {
+			.path = g_ptr_array_index(paths, i),
+			.ret = -1,
+		};
+
+		/* Ownership of the path is transferred */
+		paths->pdata[i] = NULL;
+		g_array_append_val(ctx.scans, scan);
+	}
+
+	BT_COMP_LOGI("Scanning data stream files: file-count=%u",
+		ctx.scans->len);
+	ctf_worker_pool_run(&pool_config, ctx.scans->len, &ctx);
+
+	/*
+	 * Add the data stream files in order on the current thread, and
+	 * report the first failing scan so that the outcome does not
+	 * depend on the scheduling of the workers.
+	 */
+	for (i = 0; i < ctx.scans->len; i++) {
+		struct ds_file_scan *scan = &g_array_index(ctx.scans,
+			struct ds_file_scan, i);
+
+		if (!scan->ret) {
+			scan->ret = add_ds_file_scan_to_ds_file_group(
+				ctf_fs_trace, scan);
+		} else if (scan->error) {
+			BT_CURRENT_THREAD_MOVE_ERROR_AND_RESET(scan->error);
+		}
+
+		if (scan->ret) {
+			BT_COMP_OR_COMP_CLASS_LOGE_APPEND_CAUSE(self_comp, self_comp_class,
+				"Cannot add stream file `%s` to stream file group",
+				scan->path);
+			goto error;
+		}
+	}
+
+	goto end;
+
+error:
+	ret = -1;
+
+end:
+	if (ctx.scans) {
+		for (i = 0; i < ctx.scans->len; i++) {
+			ds_file_scan_fini(&g_array_index(ctx.scans,
+				struct ds_file_scan, i));
+		}
+
+		g_array_free(ctx.scans, TRUE);
 	}
 
-	ctf_fs_ds_index_destroy(index);
 	return ret;
 }
 
@@ -904,6 +1179,7 @@ int create_ds_file_groups(struct ctf_fs_trace *ctf_fs_trace)
 	const char *basename;
 	GError *error = NULL;
 	GDir *dir = NULL;
+	GPtrArray *paths = NULL;
 	bt_logging_level log_level = ctf_fs_trace->log_level;
 	bt_self_component *self_comp = ctf_fs_trace->self_comp;
 	bt_self_component_class *self_comp_class = ctf_fs_trace->self_comp_class;
@@ -918,6 +1194,19 @@ int create_ds_file_groups(struct ctf_fs_trace *ctf_fs_trace)
 		goto error;
 	}
 
+	if (ctf_fs_trace->bounds_only_indexes) {
+		/*
+		 * Collect the paths of the data stream files to scan
+		 * them in parallel below.
+		 */
+		paths = g_ptr_array_new_with_free_func(g_free);
+		if (!paths) {
+			BT_COMP_OR_COMP_CLASS_LOGE_APPEND_CAUSE(self_comp, self_comp_class,
+				"Failed to allocate a GPtrArray.");
+			goto error;
+		}
+	}
+
 	while ((basename = g_dir_read_name(dir))) {
 		struct ctf_fs_file *file;
 
@@ -954,7 +1243,8 @@ int create_ds_file_groups(struct ctf_fs_trace *ctf_fs_trace)
 			continue;
 		}
 
-		ret = ctf_fs_file_open(file, "rb");
+		ret = ctf_fs_file_open_with_fd_cache(file,
+			&ctf_fs_trace->fd_cache);
 		if (ret) {
 			BT_COMP_OR_COMP_CLASS_LOGE_APPEND_CAUSE(self_comp, self_comp_class,
 				"Cannot open stream file `%s`",
@@ -969,6 +1259,12 @@ int create_ds_file_groups(struct ctf_fs_trace *ctf_fs_trace)
 			continue;
 		}
 
+		if (paths) {
+			g_ptr_array_add(paths, g_strdup(file->path->str));
+			ctf_fs_file_destroy(file);
+			continue;
+		}
+
 		ret = add_ds_file_to_ds_file_group(ctf_fs_trace,
 			file->path->str);
 		if (ret) {
@@ -982,6 +1278,14 @@ int create_ds_file_groups(struct ctf_fs_trace *ctf_fs_trace)
 		ctf_fs_file_destroy(file);
 	}
 
+	if (paths) {
+		ret = add_ds_files_to_ds_file_groups_parallel(ctf_fs_trace,
+			paths);
+		if (ret) {
+			goto error;
+		}
+	}
+
 	goto end;
 
 error:
@@ -993,6 +1297,10 @@ end:
 		dir = NULL;
 	}
 
+	if (paths) {
+		g_ptr_array_free(paths, TRUE);
+	}
+
 	if (error) {
 		g_error_free(error);
 	}
@@ -1054,7 +1362,7 @@ struct ctf_fs_trace *ctf_fs_trace_create(
 		bt_self_component_class *self_comp_class,
 		const char *path, const char *name,
 		struct ctf_fs_metadata_config *metadata_config,
-		bt_logging_level log_level)
+		bool bounds_only_indexes, bt_logging_level log_level)
 {
 	struct ctf_fs_trace *ctf_fs_trace;
 	int ret;
@@ -1070,11 +1378,17 @@ struct ctf_fs_trace *ctf_fs_trace_create(
 	ctf_fs_trace->log_level = log_level;
 	ctf_fs_trace->self_comp = self_comp;
 	ctf_fs_trace->self_comp_class = self_comp_class;
+	ctf_fs_trace->bounds_only_indexes = bounds_only_indexes;
 	ctf_fs_trace->path = g_string_new(path);
 	if (!ctf_fs_trace->path) {
 		goto error;
 	}
 
+	ret = bt_fd_cache_init(&ctf_fs_trace->fd_cache, log_level);
+	if (ret) {
+		goto error;
+	}
+
 	ctf_fs_trace->metadata = g_new0(struct ctf_fs_metadata, 1);
 	if (!ctf_fs_trace->metadata) {
 		goto error;
@@ -1199,7 +1513,8 @@ int ctf_fs_component_create_ctf_fs_trace_one_path(
 	}
 
 	ctf_fs_trace = ctf_fs_trace_create(self_comp, self_comp_class, norm_path->str,
-		trace_name, &ctf_fs->metadata_config, log_level);
+		trace_name, &ctf_fs->metadata_config,
+		ctf_fs->bounds_only_indexes, log_level);
 	if (!ctf_fs_trace) {
 		BT_COMP_OR_COMP_CLASS_LOGE_APPEND_CAUSE(self_comp, self_comp_class,
 			"Cannot create trace for `%s`.",
@@ -1602,8 +1917,8 @@ int fix_index_lttng_event_after_packet_bug(struct ctf_fs_trace *trace)
 				entry_i++) {
 			struct ctf_fs_ds_index_entry *curr_entry, *next_entry;
 
-			curr_entry = g_ptr_array_index(index->entries, entry_i);
-			next_entry = g_ptr_array_index(index->entries, entry_i + 1);
+			curr_entry = ctf_fs_ds_index_borrow_entry(index, entry_i);
+			next_entry = ctf_fs_ds_index_borrow_entry(index, entry_i + 1);
 
 			/*
 			 * 1. Set the current index entry `end` timestamp to
@@ -1617,7 +1932,7 @@ int fix_index_lttng_event_after_packet_bug(struct ctf_fs_trace *trace)
 		 * 2. Fix the last entry by decoding the last event of the last
 		 * packet.
 		 */
-		last_entry = g_ptr_array_index(index->entries,
+		last_entry = ctf_fs_ds_index_borrow_entry(index,
 			index->entries->len - 1);
 		BT_ASSERT(last_entry);
 
@@ -1687,8 +2002,8 @@ int fix_index_barectf_event_before_packet_bug(struct ctf_fs_trace *trace)
 		for (entry_i = 1; entry_i < index->entries->len;
 				entry_i++) {
 			struct ctf_fs_ds_index_entry *curr_entry, *prev_entry;
-			prev_entry = g_ptr_array_index(index->entries, entry_i - 1);
-			curr_entry = g_ptr_array_index(index->entries, entry_i);
+			prev_entry = ctf_fs_ds_index_borrow_entry(index, entry_i - 1);
+			curr_entry = ctf_fs_ds_index_borrow_entry(index, entry_i);
 			/*
 			 * 2. Set the current entry `begin` timestamp to the
 			 * timestamp of the first event of the current packet.
@@ -1759,7 +2074,7 @@ int fix_index_lttng_crash_quirk(struct ctf_fs_trace *trace)
 		BT_ASSERT(index->entries);
 		BT_ASSERT(index->entries->len > 0);
 
-		last_entry = g_ptr_array_index(index->entries,
+		last_entry = ctf_fs_ds_index_borrow_entry(index,
 			index->entries->len - 1);
 		BT_ASSERT(last_entry);
 
@@ -1786,8 +2101,8 @@ int fix_index_lttng_crash_quirk(struct ctf_fs_trace *trace)
 		for (entry_idx = 0; entry_idx < index->entries->len - 1;
 				entry_idx++) {
 			struct ctf_fs_ds_index_entry *curr_entry, *next_entry;
-			curr_entry = g_ptr_array_index(index->entries, entry_idx);
-			next_entry = g_ptr_array_index(index->entries, entry_idx + 1);
+			curr_entry = ctf_fs_ds_index_borrow_entry(index, entry_idx);
+			next_entry = ctf_fs_ds_index_borrow_entry(index, entry_idx + 1);
 
 			if (curr_entry->timestamp_end == 0 &&
 					curr_entry->timestamp_begin != 0) {
@@ -2172,10 +2487,19 @@ int ctf_fs_component_create_ctf_fs_trace(
 		traces->pdata[0] = NULL;
 	}
 
-	ret = fix_packet_index_tracer_bugs(ctf_fs, self_comp, self_comp_class);
-	if (ret) {
-		BT_COMP_OR_COMP_CLASS_LOGE_APPEND_CAUSE(self_comp, self_comp_class,
-			"Failed to fix packet index tracer bugs.");
+	/*
+	 * The fixups need all the packets of the indexes: bounds-only
+	 * indexes are only used to get the stream time ranges as fast
+	 * as possible, so don't apply them.
+	 */
+	if (!ctf_fs->bounds_only_indexes) {
+		ret = fix_packet_index_tracer_bugs(ctf_fs, self_comp,
+			self_comp_class);
+		if (ret) {
+			BT_COMP_OR_COMP_CLASS_LOGE_APPEND_CAUSE(self_comp,
+				self_comp_class,
+				"Failed to fix packet index tracer bugs.");
+		}
 	}
 
 	/*
@@ -2326,6 +2650,9 @@ static const struct bt_param_validation_map_value_entry_descr fs_params_entries_
 	{ "clock-class-offset-s", BT_PARAM_VALIDATION_MAP_VALUE_ENTRY_OPTIONAL, { .type = BT_VALUE_TYPE_SIGNED_INTEGER } },
 	{ "clock-class-offset-ns", BT_PARAM_VALIDATION_MAP_VALUE_ENTRY_OPTIONAL, { .type = BT_VALUE_TYPE_SIGNED_INTEGER } },
 	{ "force-clock-class-origin-unix-epoch", BT_PARAM_VALIDATION_MAP_VALUE_ENTRY_OPTIONAL, { .type = BT_VALUE_TYPE_BOOL } },
+	{ "lazy-payloads", BT_PARAM_VALIDATION_MAP_VALUE_ENTRY_OPTIONAL, { .type = BT_VALUE_TYPE_BOOL } },
+	{ "raw-packets", BT_PARAM_VALIDATION_MAP_VALUE_ENTRY_OPTIONAL, { .type = BT_VALUE_TYPE_BOOL } },
+	{ "metadata-cache-dir", BT_PARAM_VALIDATION_MAP_VALUE_ENTRY_OPTIONAL, { .type = BT_VALUE_TYPE_STRING } },
 	BT_PARAM_VALIDATION_MAP_VALUE_ENTRY_END
 };
 
@@ -2378,6 +2705,29 @@ bool read_src_fs_parameters(const bt_value *params,
 			bt_value_bool_get(value);
 	}
 
+	/* lazy-payloads parameter */
+	value = bt_value_map_borrow_entry_value_const(params,
+		"lazy-payloads");
+	if (value) {
+		ctf_fs->lazy_payloads = bt_value_bool_get(value);
+	}
+
+	/* raw-packets parameter */
+	value = bt_value_map_borrow_entry_value_const(params,
+		"raw-packets");
+	if (value) {
+		ctf_fs->metadata_config.raw_packets =
+			bt_value_bool_get(value);
+	}
+
+	/* metadata-cache-dir parameter */
+	value = bt_value_map_borrow_entry_value_const(params,
+		"metadata-cache-dir");
+	if (value) {
+		ctf_fs->metadata_config.cache_dir =
+			g_strdup(bt_value_string_get(value));
+	}
+
 	/* trace-name parameter */
 	*trace_name = bt_value_map_borrow_entry_value_const(params, "trace-name");
 
@@ -2474,6 +2824,9 @@ bt_component_class_query_method_status ctf_fs_query(
 	} else if (strcmp(object, "babeltrace.trace-infos") == 0) {
 		status = trace_infos_query(comp_class, params, log_level,
 			result);
+	} else if (strcmp(object, "light-trace-infos") == 0) {
+		status = light_trace_infos_query(comp_class, params,
+			log_level, result);
 	} else if (!strcmp(object, "babeltrace.support-info")) {
 		status = support_info_query(comp_class, params, log_level, result);
 	} else {
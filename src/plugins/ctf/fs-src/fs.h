@@ -29,8 +29,11 @@
  */
 
 #include <stdbool.h>
+#include <glib.h>
+#include "common/assert.h"
 #include "common/macros.h"
 #include <babeltrace2/babeltrace.h>
+#include "fd-cache/fd-cache.h"
 #include "data-stream-file.h"
 #include "metadata.h"
 #include "../common/metadata/decoder.h"
@@ -50,6 +53,15 @@ struct ctf_fs_file {
 	/* Owned by this */
 	FILE *fp;
 
+	/*
+	 * Weak, set if the file was opened with
+	 * ctf_fs_file_open_with_fd_cache().
+	 */
+	struct bt_fd_cache *fd_cache;
+
+	/* Owned by this, set between ctf_fs_file_get_fd() and ctf_fs_file_put_fd() */
+	struct bt_fd_cache_handle *fd_handle;
+
 	off_t size;
 };
 
@@ -79,6 +91,18 @@ struct ctf_fs_component {
 	struct ctf_fs_trace *trace;
 
 	struct ctf_fs_metadata_config metadata_config;
+
+	/*
+	 * True to defer the decoding of event payload fields until
+	 * something reads them (`lazy-payloads` parameter).
+	 */
+	bool lazy_payloads;
+
+	/*
+	 * True to only index the first and last packets of each data
+	 * stream file (see `struct ctf_fs_trace`).
+	 */
+	bool bounds_only_indexes;
 };
 
 struct ctf_fs_trace {
@@ -106,6 +130,23 @@ struct ctf_fs_trace {
 
 	/* Next automatic stream ID when not provided by packet header */
 	uint64_t next_stream_id;
+
+	/*
+	 * File descriptor cache used to access the data stream files,
+	 * so that the number of open files stays bounded whatever the
+	 * number of data stream files.
+	 */
+	struct bt_fd_cache fd_cache;
+
+	/*
+	 * True if the indexes of the data stream file groups only
+	 * contain the first and last packets of each data stream file.
+	 *
+	 * Such indexes are only good to get the time ranges of the
+	 * streams: the data stream files are then scanned in parallel
+	 * and the tracer bug fixups are not applied.
+	 */
+	bool bounds_only_indexes;
 };
 
 struct ctf_fs_ds_index_entry {
@@ -137,10 +178,24 @@ struct ctf_fs_ds_index_entry {
 };
 
 struct ctf_fs_ds_index {
-	/* Array of pointer to struct ctf_fs_ds_index_entry. */
-	GPtrArray *entries;
+	/*
+	 * Array of struct ctf_fs_ds_index_entry, stored contiguously
+	 * (no per-entry allocation).
+	 *
+	 * Adding entries can move them: don't keep a borrowed entry
+	 * across an insertion.
+	 */
+	GArray *entries;
 };
 
+static inline
+struct ctf_fs_ds_index_entry *ctf_fs_ds_index_borrow_entry(
+		struct ctf_fs_ds_index *index, guint i)
+{
+	BT_ASSERT_DBG(i < index->entries->len);
+	return &g_array_index(index->entries, struct ctf_fs_ds_index_entry, i);
+}
+
 struct ctf_fs_ds_file_group {
 	/*
 	 * Array of struct ctf_fs_ds_file_info, owned by this.
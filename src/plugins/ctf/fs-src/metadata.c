@@ -104,6 +104,8 @@ int ctf_fs_metadata_set_trace_class(
 		.force_clock_class_origin_unix_epoch =
 			config ? config->force_clock_class_origin_unix_epoch : false,
 		.create_trace_class = true,
+		.keep_plain_text = config ? config->raw_packets : false,
+		.cache_dir = config ? config->cache_dir : NULL,
 	};
 	bt_logging_level log_level = ctf_fs_trace->log_level;
 
@@ -138,6 +140,27 @@ int ctf_fs_metadata_set_trace_class(
 			ctf_fs_trace->metadata->decoder);
 	BT_ASSERT(ctf_fs_trace->metadata->tc);
 
+	/*
+	 * The packets of this trace can only be written as is when the
+	 * metadata which describes them is also written as is, that
+	 * is, when the decoder doesn't alter the clock classes.
+	 */
+	if (config && config->raw_packets &&
+			ctf_fs_trace->metadata->trace_class &&
+			config->clock_class_offset_s == 0 &&
+			config->clock_class_offset_ns == 0 &&
+			!config->force_clock_class_origin_unix_epoch) {
+		if (bt_trace_class_set_raw_packet_format(
+				ctf_fs_trace->metadata->trace_class,
+				CTF_FS_RAW_PACKET_FORMAT_NAME,
+				ctf_metadata_decoder_get_text(
+					ctf_fs_trace->metadata->decoder))) {
+			BT_COMP_LOGE("Cannot set trace class's raw packet format.");
+			ret = -1;
+			goto end;
+		}
+	}
+
 end:
 	ctf_fs_file_destroy(file);
 	return ret;
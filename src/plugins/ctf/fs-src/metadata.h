@@ -31,6 +31,9 @@
 
 #define CTF_FS_METADATA_FILENAME	"metadata"
 
+/* Raw packet format of the trace classes (CTF 1.8 TSDL and packets) */
+#define CTF_FS_RAW_PACKET_FORMAT_NAME	"ctf-1.8"
+
 struct ctf_fs_trace;
 struct ctf_fs_metadata;
 
@@ -38,6 +41,19 @@ struct ctf_fs_metadata_config {
 	bool force_clock_class_origin_unix_epoch;
 	int64_t clock_class_offset_s;
 	int64_t clock_class_offset_ns;
+
+	/*
+	 * True to set the raw packet format of the trace class when the
+	 * data stream packets can be written as is (`raw-packets`
+	 * parameter).
+	 */
+	bool raw_packets;
+
+	/*
+	 * Directory of the pre-resolved metadata cache
+	 * (`metadata-cache-dir` parameter), or `NULL`.
+	 */
+	gchar *cache_dir;
 };
 
 BT_HIDDEN
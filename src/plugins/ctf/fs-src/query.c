@@ -240,12 +240,11 @@ int populate_stream_info(struct ctf_fs_ds_file_group *group,
 	BT_ASSERT(group->index->entries->len > 0);
 
 	/* First entry. */
-	first_ds_index_entry = (struct ctf_fs_ds_index_entry *) g_ptr_array_index(
-		group->index->entries, 0);
+	first_ds_index_entry = ctf_fs_ds_index_borrow_entry(group->index, 0);
 
 	/* Last entry. */
-	last_ds_index_entry = (struct ctf_fs_ds_index_entry *) g_ptr_array_index(
-		group->index->entries, group->index->entries->len - 1);
+	last_ds_index_entry = ctf_fs_ds_index_borrow_entry(group->index,
+		group->index->entries->len - 1);
 
 	stream_range->begin_ns = first_ds_index_entry->timestamp_begin_ns;
 	stream_range->end_ns = last_ds_index_entry->timestamp_end_ns;
@@ -333,11 +332,16 @@ end:
 	return ret;
 }
 
-BT_HIDDEN
-bt_component_class_query_method_status trace_infos_query(
+/*
+ * Common part of trace_infos_query() and light_trace_infos_query():
+ * if `bounds_only_indexes` is true, only index the first and last
+ * packets of each data stream file.
+ */
+static
+bt_component_class_query_method_status query_trace_infos(
 		bt_self_component_class_source *self_comp_class_src,
-		const bt_value *params, bt_logging_level log_level,
-		const bt_value **user_result)
+		const bt_value *params, bool bounds_only_indexes,
+		bt_logging_level log_level, const bt_value **user_result)
 {
 	struct ctf_fs_component *ctf_fs = NULL;
 	bt_component_class_query_method_status status =
@@ -366,6 +370,8 @@ bt_component_class_query_method_status trace_infos_query(
 		goto error;
 	}
 
+	ctf_fs->bounds_only_indexes = bounds_only_indexes;
+
 	if (!read_src_fs_parameters(params, &inputs_value, &trace_name_value,
 			ctf_fs, NULL, self_comp_class)) {
 		status = BT_COMPONENT_CLASS_QUERY_METHOD_STATUS_ERROR;
@@ -416,6 +422,26 @@ end:
 	return status;
 }
 
+BT_HIDDEN
+bt_component_class_query_method_status trace_infos_query(
+		bt_self_component_class_source *self_comp_class_src,
+		const bt_value *params, bt_logging_level log_level,
+		const bt_value **user_result)
+{
+	return query_trace_infos(self_comp_class_src, params, false,
+		log_level, user_result);
+}
+
+BT_HIDDEN
+bt_component_class_query_method_status light_trace_infos_query(
+		bt_self_component_class_source *self_comp_class_src,
+		const bt_value *params, bt_logging_level log_level,
+		const bt_value **user_result)
+{
+	return query_trace_infos(self_comp_class_src, params, true,
+		log_level, user_result);
+}
+
 BT_HIDDEN
 bt_component_class_query_method_status support_info_query(
 		bt_self_component_class_source *comp_class,
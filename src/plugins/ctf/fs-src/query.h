@@ -40,6 +40,17 @@ bt_component_class_query_method_status trace_infos_query(
 		const bt_value *params, bt_logging_level log_level,
 		const bt_value **result);
 
+/*
+ * Like trace_infos_query(), but only reads the LTTng index files, or
+ * the packet headers and contexts, of the data stream files, in
+ * parallel, and doesn't apply the tracer bug fixups.
+ */
+BT_HIDDEN
+bt_component_class_query_method_status light_trace_infos_query(
+		bt_self_component_class_source *comp_class,
+		const bt_value *params, bt_logging_level log_level,
+		const bt_value **result);
+
 BT_HIDDEN
 bt_component_class_query_method_status support_info_query(
 		bt_self_component_class_source *comp_class,
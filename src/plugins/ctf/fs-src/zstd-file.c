@@ -0,0 +1,484 @@
+/*
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#define BT_COMP_LOG_SELF_COMP (zfile->self_comp)
+#define BT_LOG_OUTPUT_LEVEL (zfile->log_level)
+#define BT_LOG_TAG "PLUGIN/SRC.CTF.FS/ZSTD-FILE"
+#include "logging/comp-logging.h"
+
+#include <errno.h>
+#include <inttypes.h>
+#include <string.h>
+#include <sys/types.h>
+#include <unistd.h>
+#include <glib.h>
+#include "common/assert.h"
+#include "common/zstd-seekable.h"
+#include "file.h"
+#include "zstd-file.h"
+
+#ifdef BABELTRACE_HAVE_LIBZSTD
+# include <zstd.h>
+#endif
+
+/*
+ * Reads exactly `size` bytes at the offset `offset` of the file `fd`.
+ */
+static
+int read_at(struct ctf_fs_zstd_file *zfile, int fd, off_t offset,
+		uint8_t *buf, size_t size)
+{
+	int ret = 0;
+
+	if (lseek(fd, offset, SEEK_SET) < 0) {
+		BT_COMP_LOGE_APPEND_CAUSE_ERRNO(zfile->self_comp,
+			"Cannot seek within file",
+			": path=\"%s\", offset=%jd",
+			zfile->file->path->str, (intmax_t) offset);
+		ret = -1;
+		goto end;
+	}
+
+	while (size > 0) {
+		ssize_t read_size = read(fd, buf, size);
+
+		if (read_size < 0) {
+			if (errno == EINTR) {
+				continue;
+			}
+
+			BT_COMP_LOGE_APPEND_CAUSE_ERRNO(zfile->self_comp,
+				"Cannot read file",
+				": path=\"%s\", size=%zu",
+				zfile->file->path->str, size);
+			ret = -1;
+			goto end;
+		}
+
+		if (read_size == 0) {
+			BT_COMP_LOGE_APPEND_CAUSE(zfile->self_comp,
+				"Unexpected end of file: path=\"%s\", "
+				"remaining-size=%zu",
+				zfile->file->path->str, size);
+			ret = -1;
+			goto end;
+		}
+
+		buf += read_size;
+		size -= (size_t) read_size;
+	}
+
+end:
+	return ret;
+}
+
+/*
+ * Reads the seek table footer of `zfile`, setting `*frame_count` and
+ * `*descr`.
+ *
+ * Returns 1 if `zfile` has no seek table footer.
+ */
+static
+int read_seek_table_footer(struct ctf_fs_zstd_file *zfile, int fd,
+		uint32_t *frame_count, uint8_t *descr)
+{
+	uint8_t footer[BT_ZSTD_SEEK_TABLE_FOOTER_SIZE];
+	off_t file_size = zfile->file->size;
+	int ret;
+
+	if (file_size < BT_ZSTD_SKIPPABLE_FRAME_HEADER_SIZE +
+			BT_ZSTD_SEEK_TABLE_FOOTER_SIZE) {
+		ret = 1;
+		goto end;
+	}
+
+	ret = read_at(zfile, fd, file_size - BT_ZSTD_SEEK_TABLE_FOOTER_SIZE,
+		footer, sizeof(footer));
+	if (ret) {
+		goto end;
+	}
+
+	if (bt_zstd_seekable_read_u32(&footer[5]) != BT_ZSTD_SEEKABLE_MAGIC) {
+		ret = 1;
+		goto end;
+	}
+
+	*frame_count = bt_zstd_seekable_read_u32(&footer[0]);
+	*descr = footer[4];
+
+end:
+	return ret;
+}
+
+BT_HIDDEN
+int ctf_fs_zstd_file_is_compressed(struct ctf_fs_file *file,
+		bool *is_compressed)
+{
+	struct ctf_fs_zstd_file tmp_zfile = {
+		.log_level = file->log_level,
+		.self_comp = file->self_comp,
+		.file = file,
+	};
+	struct ctf_fs_zstd_file *zfile = &tmp_zfile;
+	uint8_t magic[4];
+	uint32_t frame_count;
+	uint8_t descr;
+	int fd;
+	int ret = 0;
+
+	*is_compressed = false;
+
+	if (file->size < BT_ZSTD_SKIPPABLE_FRAME_HEADER_SIZE +
+			BT_ZSTD_SEEK_TABLE_FOOTER_SIZE) {
+		goto end;
+	}
+
+	fd = ctf_fs_file_get_fd(file);
+	if (fd < 0) {
+		ret = -1;
+		goto end;
+	}
+
+	ret = read_at(zfile, fd, 0, magic, sizeof(magic));
+	if (ret) {
+		goto put_fd;
+	}
+
+	if (!bt_zstd_seekable_is_frame_start(magic)) {
+		goto put_fd;
+	}
+
+	/*
+	 * A data stream file could start with those four bytes by
+	 * chance: also require a seek table.
+	 */
+	ret = read_seek_table_footer(zfile, fd, &frame_count, &descr);
+	if (ret < 0) {
+		goto put_fd;
+	}
+
+	if (ret == 1) {
+		BT_COMP_LOGW("File starts with a Zstandard frame, but has no seek table: "
+			"considering it as a non-compressed data stream file: "
+			"path=\"%s\"", file->path->str);
+		ret = 0;
+		goto put_fd;
+	}
+
+	*is_compressed = true;
+
+put_fd:
+	ctf_fs_file_put_fd(file);
+
+end:
+	return ret;
+}
+
+#ifdef BABELTRACE_HAVE_LIBZSTD
+
+/*
+ * Reads the seek table of `zfile` to build its frame array.
+ */
+static
+int read_seek_table(struct ctf_fs_zstd_file *zfile)
+{
+	uint8_t *table = NULL;
+	uint32_t frame_count;
+	uint8_t descr;
+	size_t entry_size;
+	size_t table_size;
+	off_t table_offset;
+	off_t offset = 0;
+	off_t content_offset = 0;
+	uint32_t i;
+	int fd;
+	int ret;
+
+	fd = ctf_fs_file_get_fd(zfile->file);
+	if (fd < 0) {
+		ret = -1;
+		goto end;
+	}
+
+	ret = read_seek_table_footer(zfile, fd, &frame_count, &descr);
+	if (ret < 0) {
+		goto put_fd;
+	}
+
+	if (ret == 1) {
+		BT_COMP_LOGE_APPEND_CAUSE(zfile->self_comp,
+			"Compressed data stream file has no seek table: "
+			"path=\"%s\"", zfile->file->path->str);
+		ret = -1;
+		goto put_fd;
+	}
+
+	entry_size = descr & BT_ZSTD_SEEK_TABLE_DESCR_CHECKSUM ? 12 : 8;
+	table_size = BT_ZSTD_SKIPPABLE_FRAME_HEADER_SIZE +
+		(size_t) frame_count * entry_size +
+		BT_ZSTD_SEEK_TABLE_FOOTER_SIZE;
+	if ((off_t) table_size > zfile->file->size) {
+		BT_COMP_LOGE_APPEND_CAUSE(zfile->self_comp,
+			"Invalid seek table: larger than the file: "
+			"path=\"%s\", frame-count=%" PRIu32 ", "
+			"file-size=%jd", zfile->file->path->str,
+			frame_count, (intmax_t) zfile->file->size);
+		ret = -1;
+		goto put_fd;
+	}
+
+	table_offset = zfile->file->size - (off_t) table_size;
+	table = g_malloc(table_size);
+	ret = read_at(zfile, fd, table_offset, table, table_size);
+	if (ret) {
+		goto put_fd;
+	}
+
+	if (bt_zstd_seekable_read_u32(table) != BT_ZSTD_SKIPPABLE_FRAME_MAGIC ||
+			bt_zstd_seekable_read_u32(&table[4]) !=
+				table_size - BT_ZSTD_SKIPPABLE_FRAME_HEADER_SIZE) {
+		BT_COMP_LOGE_APPEND_CAUSE(zfile->self_comp,
+			"Invalid seek table: bad skippable frame header: "
+			"path=\"%s\"", zfile->file->path->str);
+		ret = -1;
+		goto put_fd;
+	}
+
+	for (i = 0; i < frame_count; i++) {
+		const uint8_t *entry = &table[BT_ZSTD_SKIPPABLE_FRAME_HEADER_SIZE +
+			(size_t) i * entry_size];
+		struct ctf_fs_zstd_frame frame;
+
+		frame.offset = offset;
+		frame.content_offset = content_offset;
+		frame.size = bt_zstd_seekable_read_u32(entry);
+		frame.content_size = bt_zstd_seekable_read_u32(&entry[4]);
+		offset += (off_t) frame.size;
+		content_offset += (off_t) frame.content_size;
+
+		if (frame.content_size == 0) {
+			/* Nothing to read: skip */
+			continue;
+		}
+
+		g_array_append_val(zfile->frames, frame);
+	}
+
+	if (offset != table_offset) {
+		BT_COMP_LOGE_APPEND_CAUSE(zfile->self_comp,
+			"Invalid seek table: frames do not cover the file: "
+			"path=\"%s\", frames-size=%jd, "
+			"seek-table-offset=%jd", zfile->file->path->str,
+			(intmax_t) offset, (intmax_t) table_offset);
+		ret = -1;
+		goto put_fd;
+	}
+
+	zfile->content_size = content_offset;
+	BT_COMP_LOGI("Read seek table of compressed data stream file: "
+		"path=\"%s\", frame-count=%" PRIu32 ", "
+		"decompressed-size=%jd", zfile->file->path->str,
+		frame_count, (intmax_t) zfile->content_size);
+
+put_fd:
+	ctf_fs_file_put_fd(zfile->file);
+
+end:
+	g_free(table);
+	return ret;
+}
+
+#endif /* BABELTRACE_HAVE_LIBZSTD */
+
+BT_HIDDEN
+struct ctf_fs_zstd_file *ctf_fs_zstd_file_create(struct ctf_fs_file *file)
+{
+	struct ctf_fs_zstd_file *zfile = g_new0(struct ctf_fs_zstd_file, 1);
+
+	zfile->log_level = file->log_level;
+	zfile->self_comp = file->self_comp;
+	zfile->file = file;
+	zfile->cur_frame_index = -1;
+
+#ifdef BABELTRACE_HAVE_LIBZSTD
+	zfile->frames = g_array_new(FALSE, FALSE,
+		sizeof(struct ctf_fs_zstd_frame));
+	zfile->dctx = ZSTD_createDCtx();
+	if (!zfile->dctx) {
+		BT_COMP_LOGE_APPEND_CAUSE(zfile->self_comp,
+			"Cannot create a Zstandard decompression context.");
+		goto error;
+	}
+
+	if (read_seek_table(zfile)) {
+		goto error;
+	}
+
+	goto end;
+#else
+	BT_COMP_LOGE_APPEND_CAUSE(zfile->self_comp,
+		"Cannot read compressed data stream file: "
+		"Babeltrace was built without Zstandard support: "
+		"path=\"%s\"", file->path->str);
+	goto error;
+#endif
+
+error:
+	ctf_fs_zstd_file_destroy(zfile);
+	zfile = NULL;
+
+#ifdef BABELTRACE_HAVE_LIBZSTD
+end:
+#endif
+	return zfile;
+}
+
+BT_HIDDEN
+void ctf_fs_zstd_file_destroy(struct ctf_fs_zstd_file *zfile)
+{
+	if (!zfile) {
+		return;
+	}
+
+#ifdef BABELTRACE_HAVE_LIBZSTD
+	ZSTD_freeDCtx(zfile->dctx);
+#endif
+
+	if (zfile->frames) {
+		g_array_free(zfile->frames, TRUE);
+	}
+
+	g_free(zfile->comp_buf);
+	g_free(zfile->buf);
+	g_free(zfile);
+}
+
+/*
+ * Returns the index of the frame of `zfile` which contains the
+ * decompressed content offset `offset`.
+ */
+static
+guint find_frame(struct ctf_fs_zstd_file *zfile, off_t offset)
+{
+	guint low = 0;
+	guint high = zfile->frames->len;
+
+	while (high - low > 1) {
+		guint mid = low + (high - low) / 2;
+
+		if (g_array_index(zfile->frames, struct ctf_fs_zstd_frame,
+				mid).content_offset <= offset) {
+			low = mid;
+		} else {
+			high = mid;
+		}
+	}
+
+	return low;
+}
+
+BT_HIDDEN
+const struct ctf_fs_zstd_frame *ctf_fs_zstd_file_load_frame(
+		struct ctf_fs_zstd_file *zfile, off_t offset)
+{
+	struct ctf_fs_zstd_frame *frame = NULL;
+	guint frame_index;
+
+	BT_ASSERT(offset >= 0);
+	BT_ASSERT(offset < zfile->content_size);
+	frame_index = find_frame(zfile, offset);
+
+	if ((gint64) frame_index == zfile->cur_frame_index) {
+		frame = &g_array_index(zfile->frames,
+			struct ctf_fs_zstd_frame, frame_index);
+		goto end;
+	}
+
+#ifdef BABELTRACE_HAVE_LIBZSTD
+	{
+		struct ctf_fs_zstd_frame *new_frame = &g_array_index(
+			zfile->frames, struct ctf_fs_zstd_frame, frame_index);
+		size_t content_size;
+		int fd;
+		int ret;
+
+		/* Current frame's content is about to be overwritten */
+		zfile->cur_frame_index = -1;
+
+		if (new_frame->size > zfile->comp_buf_size) {
+			zfile->comp_buf = g_realloc(zfile->comp_buf,
+				new_frame->size);
+			zfile->comp_buf_size = new_frame->size;
+		}
+
+		if (new_frame->content_size > zfile->buf_size) {
+			zfile->buf = g_realloc(zfile->buf,
+				new_frame->content_size);
+			zfile->buf_size = new_frame->content_size;
+		}
+
+		fd = ctf_fs_file_get_fd(zfile->file);
+		if (fd < 0) {
+			goto end;
+		}
+
+		ret = read_at(zfile, fd, new_frame->offset, zfile->comp_buf,
+			new_frame->size);
+		ctf_fs_file_put_fd(zfile->file);
+		if (ret) {
+			goto end;
+		}
+
+		content_size = ZSTD_decompressDCtx(zfile->dctx, zfile->buf,
+			new_frame->content_size, zfile->comp_buf,
+			new_frame->size);
+		if (ZSTD_isError(content_size)) {
+			BT_COMP_LOGE_APPEND_CAUSE(zfile->self_comp,
+				"Cannot decompress frame: path=\"%s\", "
+				"frame-offset=%jd, error=\"%s\"",
+				zfile->file->path->str,
+				(intmax_t) new_frame->offset,
+				ZSTD_getErrorName(content_size));
+			goto end;
+		}
+
+		if (content_size != new_frame->content_size) {
+			BT_COMP_LOGE_APPEND_CAUSE(zfile->self_comp,
+				"Unexpected decompressed frame size: "
+				"path=\"%s\", frame-offset=%jd, "
+				"expected-size=%zu, size=%zu",
+				zfile->file->path->str,
+				(intmax_t) new_frame->offset,
+				new_frame->content_size, content_size);
+			goto end;
+		}
+
+		BT_COMP_LOGD("Decompressed frame: path=\"%s\", "
+			"frame-offset=%jd, size=%zu, decompressed-size=%zu",
+			zfile->file->path->str, (intmax_t) new_frame->offset,
+			new_frame->size, content_size);
+		zfile->cur_frame_index = (gint64) frame_index;
+		frame = new_frame;
+	}
+#endif
+
+end:
+	return frame;
+}
@@ -0,0 +1,116 @@
+#ifndef CTF_FS_ZSTD_FILE_H
+#define CTF_FS_ZSTD_FILE_H
+
+/*
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <sys/types.h>
+#include <glib.h>
+#include "common/macros.h"
+#include <babeltrace2/babeltrace.h>
+
+struct ctf_fs_file;
+
+/*
+ * Frame of a compressed data stream file.
+ *
+ * A compressed data stream file is a sequence of Zstandard frames
+ * followed by a seek table (see "common/zstd-seekable.h"). Its content
+ * is the concatenation of the decompressed frames: all the offsets
+ * which the CTF message iterator and the `.idx` files deal with are
+ * offsets within this decompressed content.
+ */
+struct ctf_fs_zstd_frame {
+	/* Offset of the compressed frame within the file */
+	off_t offset;
+
+	/* Offset of the frame's content within the decompressed content */
+	off_t content_offset;
+
+	size_t size;
+	size_t content_size;
+};
+
+struct ctf_fs_zstd_file {
+	bt_logging_level log_level;
+
+	/* Weak */
+	bt_self_component *self_comp;
+
+	/* Weak */
+	struct ctf_fs_file *file;
+
+	/* Array of `struct ctf_fs_zstd_frame`, in file order */
+	GArray *frames;
+
+	/* Size of the decompressed content */
+	off_t content_size;
+
+	/* Decompression context (`ZSTD_DCtx *`) */
+	void *dctx;
+
+	/* Compressed frame being decompressed */
+	uint8_t *comp_buf;
+	size_t comp_buf_size;
+
+	/*
+	 * Content of the frame at index `cur_frame_index`, or of no
+	 * frame if `cur_frame_index` is -1.
+	 */
+	uint8_t *buf;
+	size_t buf_size;
+	gint64 cur_frame_index;
+};
+
+/*
+ * Sets `*is_compressed` to whether or not `file`, opened with
+ * ctf_fs_file_open_with_fd_cache(), starts with a Zstandard frame.
+ */
+BT_HIDDEN
+int ctf_fs_zstd_file_is_compressed(struct ctf_fs_file *file,
+		bool *is_compressed);
+
+/*
+ * Creates a decompressing reader for the compressed data stream file
+ * `file` (weak), opened with ctf_fs_file_open_with_fd_cache(), reading
+ * its seek table.
+ *
+ * Fails if Babeltrace was built without Zstandard support.
+ */
+BT_HIDDEN
+struct ctf_fs_zstd_file *ctf_fs_zstd_file_create(struct ctf_fs_file *file);
+
+BT_HIDDEN
+void ctf_fs_zstd_file_destroy(struct ctf_fs_zstd_file *zfile);
+
+/*
+ * Decompresses, if not already done, the frame of `zfile` which
+ * contains the decompressed content offset `offset`, and returns it.
+ *
+ * The returned frame's content is available at `zfile->buf` until the
+ * next call to this function.
+ */
+BT_HIDDEN
+const struct ctf_fs_zstd_frame *ctf_fs_zstd_file_load_frame(
+		struct ctf_fs_zstd_file *zfile, off_t offset);
+
+#endif /* CTF_FS_ZSTD_FILE_H */
@@ -1530,6 +1530,21 @@ return_status:
 	}
 
 end:
+	if (status == BT_MESSAGE_ITERATOR_CLASS_NEXT_METHOD_STATUS_AGAIN) {
+		/*
+		 * Let the graph user know when it's worth trying again
+		 * instead of having it sleep for an arbitrary duration.
+		 */
+		bt_self_message_iterator_set_wait_timeout(self_msg_it,
+			lttng_live_msg_iter->retry_timeout_us);
+		lttng_live_msg_iter->retry_timeout_us = MIN(
+			lttng_live_msg_iter->retry_timeout_us * 2,
+			LTTNG_LIVE_MAX_RETRY_TIMEOUT_US);
+	} else if (status == BT_MESSAGE_ITERATOR_CLASS_NEXT_METHOD_STATUS_OK) {
+		lttng_live_msg_iter->retry_timeout_us =
+			LTTNG_LIVE_MIN_RETRY_TIMEOUT_US;
+	}
+
 	return status;
 }
 
@@ -1557,6 +1572,7 @@ struct lttng_live_msg_iter *lttng_live_msg_iter_create(
 	lttng_live_msg_iter->active_stream_iter = 0;
 	lttng_live_msg_iter->last_msg_ts_ns = INT64_MIN;
 	lttng_live_msg_iter->was_interrupted = false;
+	lttng_live_msg_iter->retry_timeout_us = LTTNG_LIVE_MIN_RETRY_TIMEOUT_US;
 
 	lttng_live_msg_iter->sessions = g_ptr_array_new_with_free_func(
 		(GDestroyNotify) lttng_live_destroy_session);
@@ -235,6 +235,13 @@ struct lttng_live_component {
 	bool has_msg_iter;
 };
 
+/*
+ * The relay daemon doesn't notify viewers when new data is available:
+ * poll it often while data flows, and back off while it's idle.
+ */
+#define LTTNG_LIVE_MIN_RETRY_TIMEOUT_US		1000
+#define LTTNG_LIVE_MAX_RETRY_TIMEOUT_US		100000
+
 struct lttng_live_msg_iter {
 	bt_logging_level log_level;
 	bt_self_component *self_comp;
@@ -259,6 +266,15 @@ struct lttng_live_msg_iter {
 
 	/* True if the iterator was interrupted. */
 	bool was_interrupted;
+
+	/*
+	 * Duration (µs) after which to try again the next time the
+	 * relay daemon has no data for us: starts at
+	 * LTTNG_LIVE_MIN_RETRY_TIMEOUT_US and doubles, up to
+	 * LTTNG_LIVE_MAX_RETRY_TIMEOUT_US, each time we come back
+	 * empty-handed.
+	 */
+	uint64_t retry_timeout_us;
 };
 
 enum lttng_live_iterator_status {
@@ -61,6 +61,40 @@
 #define ADDR_STR_LEN 20
 #define BUILD_ID_NOTE_NAME "GNU"
 
+/*
+ * Entry of a bin_info's address range to compile unit index.
+ */
+struct bin_info_cu_range {
+	/* Address range: [low_addr, high_addr[ */
+	uint64_t low_addr;
+	uint64_t high_addr;
+
+	/*
+	 * Greatest high address of this range and of all the ranges
+	 * before it in the sorted index: ranges can overlap, so a
+	 * lookup must keep on checking the previous ranges while this
+	 * is greater than the address.
+	 */
+	uint64_t max_high_addr;
+
+	/* Offset of the compile unit's header in the DWARF file */
+	Dwarf_Off cu_offset;
+};
+
+/*
+ * Compile unit found while building a bin_info's address range to
+ * compile unit index.
+ */
+struct bin_info_cu {
+	Dwarf_Off cu_offset;
+
+	/* Offset of the CU's root DIE */
+	Dwarf_Off die_offset;
+
+	/* Whether or not `.debug_aranges` has at least one range for it */
+	bool has_arange;
+};
+
 BT_HIDDEN
 int bin_info_init(bt_logging_level log_level, bt_self_component *self_comp)
 {
@@ -137,7 +171,7 @@ void bin_info_destroy(struct bin_info *bin)
 		return;
 	}
 
-	dwarf_end(bin->dwarf_info);
+	bt_dwarf_file_put(bin->dwarf_file);
 
 	g_free(bin->debug_info_dir);
 	g_free(bin->elf_path);
@@ -148,7 +182,6 @@ void bin_info_destroy(struct bin_info *bin)
 	elf_end(bin->elf_file);
 
 	bt_fd_cache_put_handle(bin->fd_cache, bin->elf_handle);
-	bt_fd_cache_put_handle(bin->fd_cache, bin->dwarf_handle);
 
 	g_free(bin);
 }
@@ -453,58 +486,33 @@ error:
 static
 int bin_info_set_dwarf_info_from_path(struct bin_info *bin, char *path)
 {
-	int ret = 0;
-	struct bt_fd_cache_handle *dwarf_handle = NULL;
-	struct bt_dwarf_cu *cu = NULL;
-	Dwarf *dwarf_info = NULL;
+	struct bt_dwarf_file *dwarf_file = NULL;
 
 	if (!bin || !path) {
 		goto error;
 	}
 
-	dwarf_handle = bt_fd_cache_get_handle(bin->fd_cache, path);
-	if (!dwarf_handle) {
-		goto error;
-	}
-
-	dwarf_info = dwarf_begin(bt_fd_cache_handle_get_fd(dwarf_handle),
-		DWARF_C_READ);
-	if (!dwarf_info) {
-		goto error;
-	}
-
 	/*
-	 * Check if the dwarf info has any CU. If not, the
-	 * executable's object file contains no DWARF info.
+	 * The DWARF file is shared with the other bin_info objects
+	 * needing it, so that it's only parsed once per process.
 	 */
-	cu = bt_dwarf_cu_create(dwarf_info);
-	if (!cu) {
-		goto error;
-	}
-
-	ret = bt_dwarf_cu_next(cu);
-	if (ret) {
+	dwarf_file = bt_dwarf_file_cache_get(path, bin->log_level,
+		bin->self_comp);
+	if (!dwarf_file) {
 		goto error;
 	}
 
-	bin->dwarf_handle = dwarf_handle;
 	bin->dwarf_path = g_strdup(path);
 	if (!bin->dwarf_path) {
 		goto error;
 	}
-	bin->dwarf_info = dwarf_info;
-	free(cu);
 
+	bin->dwarf_file = dwarf_file;
+	bin->dwarf_info = dwarf_file->dwarf_info;
 	return 0;
 
 error:
-	if (bin) {
-		bt_fd_cache_put_handle(bin->fd_cache, dwarf_handle);
-	}
-	dwarf_end(dwarf_info);
-	g_free(dwarf_info);
-	free(cu);
-
+	bt_dwarf_file_put(dwarf_file);
 	return -1;
 }
 
@@ -974,6 +982,283 @@ error:
 	return ret;
 }
 
+static
+gint compare_cu_ranges(gconstpointer a, gconstpointer b)
+{
+	const struct bin_info_cu_range *range_a = a;
+	const struct bin_info_cu_range *range_b = b;
+
+	if (range_a->low_addr < range_b->low_addr) {
+		return -1;
+	} else if (range_a->low_addr > range_b->low_addr) {
+		return 1;
+	}
+
+	return 0;
+}
+
+/*
+ * Returns the compile unit of `cus` of which the root DIE is located
+ * at `die_offset`, or `NULL` if there's none.
+ *
+ * `cus` is sorted by offset.
+ */
+static
+struct bin_info_cu *find_cu_by_die_offset(GArray *cus, Dwarf_Off die_offset)
+{
+	guint low = 0;
+	guint high = cus->len;
+
+	while (low < high) {
+		guint mid = low + (high - low) / 2;
+		struct bin_info_cu *cu = &g_array_index(cus,
+			struct bin_info_cu, mid);
+
+		if (cu->die_offset == die_offset) {
+			return cu;
+		} else if (cu->die_offset < die_offset) {
+			low = mid + 1;
+		} else {
+			high = mid;
+		}
+	}
+
+	return NULL;
+}
+
+/**
+ * Build the address range to compile unit index of the DWARF file of
+ * a bin_info.
+ *
+ * The ranges come from the `.debug_aranges` section when it exists.
+ * The ranges of compile units which it does not cover are read from
+ * their root DIE (`DW_AT_low_pc`/`DW_AT_high_pc` or `DW_AT_ranges`).
+ *
+ * If the ranges of some compile unit cannot be read, the index is
+ * marked as incomplete so that lookups fall back to iterating all the
+ * compile units when the index does not find an address.
+ *
+ * The DWARF file's lock must be held.
+ *
+ * @param bin	bin_info instance with DWARF info
+ * @returns	0 on success, -1 on failure
+ */
+static
+int bin_info_build_cu_ranges(struct bin_info *bin)
+{
+	struct bt_dwarf_cu *dwarf_cu = NULL;
+	GArray *cus = NULL;
+	GArray *ranges = NULL;
+	Dwarf_Aranges *aranges;
+	size_t aranges_count, i;
+	bool complete = true;
+	int ret;
+
+	BT_ASSERT(bin->dwarf_info);
+	BT_ASSERT(!bin->dwarf_file->cu_ranges);
+
+	cus = g_array_new(FALSE, FALSE, sizeof(struct bin_info_cu));
+	if (!cus) {
+		goto error;
+	}
+
+	ranges = g_array_new(FALSE, FALSE, sizeof(struct bin_info_cu_range));
+	if (!ranges) {
+		goto error;
+	}
+
+	/* Find all the compile units */
+	dwarf_cu = bt_dwarf_cu_create(bin->dwarf_info);
+	if (!dwarf_cu) {
+		goto error;
+	}
+
+	while ((ret = bt_dwarf_cu_next(dwarf_cu)) == 0) {
+		struct bin_info_cu cu = {
+			.cu_offset = dwarf_cu->offset,
+			.die_offset = dwarf_cu->offset + dwarf_cu->header_size,
+			.has_arange = false,
+		};
+
+		g_array_append_val(cus, cu);
+	}
+
+	if (ret < 0) {
+		goto error;
+	}
+
+	/* Ranges from `.debug_aranges` */
+	if (dwarf_getaranges(bin->dwarf_info, &aranges, &aranges_count) == 0) {
+		for (i = 0; i < aranges_count; i++) {
+			Dwarf_Arange *arange = dwarf_onearange(aranges, i);
+			struct bin_info_cu_range range;
+			struct bin_info_cu *cu;
+			Dwarf_Addr addr;
+			Dwarf_Word length;
+			Dwarf_Off die_offset;
+
+			if (!arange || dwarf_getarangeinfo(arange, &addr,
+					&length, &die_offset)) {
+				continue;
+			}
+
+			cu = find_cu_by_die_offset(cus, die_offset);
+			if (!cu || length == 0) {
+				continue;
+			}
+
+			range.low_addr = addr;
+			range.high_addr = addr + length;
+			range.cu_offset = cu->cu_offset;
+			g_array_append_val(ranges, range);
+			cu->has_arange = true;
+		}
+	}
+
+	/* Ranges of the root DIEs of the other compile units */
+	for (i = 0; i < cus->len; i++) {
+		struct bin_info_cu *cu = &g_array_index(cus,
+			struct bin_info_cu, i);
+		Dwarf_Die cu_die;
+		Dwarf_Addr base, start, end;
+		ptrdiff_t offset = 0;
+
+		if (cu->has_arange) {
+			continue;
+		}
+
+		if (!dwarf_offdie(bin->dwarf_info, cu->die_offset, &cu_die)) {
+			complete = false;
+			continue;
+		}
+
+		while ((offset = dwarf_ranges(&cu_die, offset, &base, &start,
+				&end)) > 0) {
+			struct bin_info_cu_range range = {
+				.low_addr = start,
+				.high_addr = end,
+				.cu_offset = cu->cu_offset,
+			};
+
+			if (start < end) {
+				g_array_append_val(ranges, range);
+			}
+		}
+
+		if (offset < 0) {
+			complete = false;
+		}
+	}
+
+	g_array_sort(ranges, compare_cu_ranges);
+
+	for (i = 0; i < ranges->len; i++) {
+		struct bin_info_cu_range *range = &g_array_index(ranges,
+			struct bin_info_cu_range, i);
+
+		range->max_high_addr = range->high_addr;
+
+		if (i > 0) {
+			range->max_high_addr = MAX(range->max_high_addr,
+				g_array_index(ranges, struct bin_info_cu_range,
+					i - 1).max_high_addr);
+		}
+	}
+
+	BT_COMP_LOGD("Built address range to compile unit index: "
+		"path=\"%s\", cu-count=%u, range-count=%u, complete=%d",
+		bin->dwarf_path, cus->len, ranges->len, complete);
+	bin->dwarf_file->cu_ranges = ranges;
+	bin->dwarf_file->cu_ranges_complete = complete;
+	ranges = NULL;
+	ret = 0;
+	goto end;
+
+error:
+	ret = -1;
+
+end:
+	bt_dwarf_cu_destroy(dwarf_cu);
+
+	if (cus) {
+		g_array_free(cus, TRUE);
+	}
+
+	if (ranges) {
+		g_array_free(ranges, TRUE);
+	}
+
+	return ret;
+}
+
+/**
+ * Find, with the address range to compile unit index of the DWARF file
+ * of `bin` (built if needed), the compile unit containing a given
+ * address.
+ *
+ * On success, the out parameter `cu_offset` is set if found. On
+ * failure, it remains unchanged.
+ *
+ * The DWARF file's lock must be held.
+ *
+ * @param bin		bin_info instance with DWARF info
+ * @param addr		Address (relative to the base address for PIC)
+ * @param cu_offset	Out parameter, the offset of the compile unit's
+ *			header
+ * @returns		0 if found, 1 if not found, -1 on failure
+ */
+static
+int bin_info_find_cu_offset(struct bin_info *bin, uint64_t addr,
+		Dwarf_Off *cu_offset)
+{
+	struct bt_dwarf_file *dwarf_file = bin->dwarf_file;
+	const struct bin_info_cu_range *range;
+	guint low = 0;
+	guint high;
+
+	if (!dwarf_file->cu_ranges) {
+		if (bin_info_build_cu_ranges(bin)) {
+			return -1;
+		}
+	}
+
+	/* Find the last range of which the low address is <= `addr` */
+	high = dwarf_file->cu_ranges->len;
+
+	while (low < high) {
+		guint mid = low + (high - low) / 2;
+
+		range = &g_array_index(dwarf_file->cu_ranges,
+			struct bin_info_cu_range, mid);
+		if (range->low_addr <= addr) {
+			low = mid + 1;
+		} else {
+			high = mid;
+		}
+	}
+
+	/*
+	 * Ranges can overlap or be nested: check the previous ranges
+	 * too, as long as one of them can still contain `addr`.
+	 */
+	while (low > 0) {
+		range = &g_array_index(dwarf_file->cu_ranges,
+			struct bin_info_cu_range, low - 1);
+		if (addr >= range->max_high_addr) {
+			break;
+		}
+
+		if (addr < range->high_addr) {
+			*cu_offset = range->cu_offset;
+			return 0;
+		}
+
+		low--;
+	}
+
+	return 1;
+}
+
 /**
  * Get the name of the function containing a given address within a
  * given compile unit (CU).
@@ -1076,6 +1361,7 @@ int bin_info_lookup_dwarf_function_name(struct bin_info *bin, uint64_t addr,
 	int ret = 0;
 	char *_func_name = NULL;
 	struct bt_dwarf_cu *cu = NULL;
+	Dwarf_Off cu_offset;
 
 	if (!bin || !func_name) {
 		goto error;
@@ -1086,14 +1372,40 @@ int bin_info_lookup_dwarf_function_name(struct bin_info *bin, uint64_t addr,
 		goto error;
 	}
 
-	while (bt_dwarf_cu_next(cu) == 0) {
+	ret = bin_info_find_cu_offset(bin, addr, &cu_offset);
+	if (ret < 0) {
+		goto error;
+	}
+
+	if (ret == 0) {
+		/* Only look in the compile unit containing the address */
+		if (bt_dwarf_cu_seek(cu, cu_offset)) {
+			goto error;
+		}
+
 		ret = bin_info_lookup_cu_function_name(cu, addr, &_func_name);
 		if (ret) {
 			goto error;
 		}
+	}
 
-		if (_func_name) {
-			break;
+	if (!_func_name && !bin->dwarf_file->cu_ranges_complete) {
+		/*
+		 * The index could be missing this address: check all
+		 * the CUs, from the first one.
+		 */
+		cu->next_offset = 0;
+
+		while (bt_dwarf_cu_next(cu) == 0) {
+			ret = bin_info_lookup_cu_function_name(cu, addr,
+				&_func_name);
+			if (ret) {
+				goto error;
+			}
+
+			if (_func_name) {
+				break;
+			}
 		}
 	}
 
@@ -1161,8 +1473,10 @@ int bin_info_lookup_function_name(struct bin_info *bin,
 				"ret=%d", ret);
 		}
 	} else {
+		bt_dwarf_file_lock(bin->dwarf_file);
 		ret = bin_info_lookup_dwarf_function_name(bin, addr,
 				&_func_name);
+		bt_dwarf_file_unlock(bin->dwarf_file);
 		if (ret) {
 			BT_COMP_LOGI("Failed to lookup function name (DWARF): "
 				"ret=%d", ret);
@@ -1526,12 +1840,116 @@ error:
 	return -1;
 }
 
+static
+struct source_location *source_location_copy(
+		const struct source_location *src_loc)
+{
+	struct source_location *copy = g_new0(struct source_location, 1);
+
+	if (!copy) {
+		goto error;
+	}
+
+	copy->line_no = src_loc->line_no;
+
+	if (src_loc->filename) {
+		copy->filename = g_strdup(src_loc->filename);
+		if (!copy->filename) {
+			goto error;
+		}
+	}
+
+	return copy;
+
+error:
+	source_location_destroy(copy);
+	return NULL;
+}
+
+/**
+ * Get the source location for a given address, looking only in the
+ * compile unit which the address range index of `bin` designates,
+ * unless this index is incomplete and does not find it.
+ *
+ * The DWARF file's lock must be held.
+ *
+ * @param bin		bin_info instance with DWARF info
+ * @param addr		Address (relative to the base address for PIC)
+ * @param src_loc	Out parameter, the source location, set if found
+ * @returns		0 on success, -1 on failure
+ */
+static
+int bin_info_lookup_dwarf_source_location(struct bin_info *bin,
+		uint64_t addr, struct source_location **src_loc)
+{
+	struct bt_dwarf_cu *cu = NULL;
+	struct source_location *_src_loc = NULL;
+	Dwarf_Off cu_offset;
+	int ret;
+
+	cu = bt_dwarf_cu_create(bin->dwarf_info);
+	if (!cu) {
+		goto error;
+	}
+
+	ret = bin_info_find_cu_offset(bin, addr, &cu_offset);
+	if (ret < 0) {
+		goto error;
+	}
+
+	if (ret == 0) {
+		/* Only look in the compile unit containing the address */
+		if (bt_dwarf_cu_seek(cu, cu_offset)) {
+			goto error;
+		}
+
+		ret = bin_info_lookup_cu_src_loc(cu, addr, &_src_loc);
+		if (ret) {
+			goto error;
+		}
+	}
+
+	if (!_src_loc && !bin->dwarf_file->cu_ranges_complete) {
+		/*
+		 * The index could be missing this address: check all
+		 * the CUs, from the first one.
+		 */
+		cu->next_offset = 0;
+
+		while (bt_dwarf_cu_next(cu) == 0) {
+			ret = bin_info_lookup_cu_src_loc(cu, addr, &_src_loc);
+			if (ret) {
+				goto error;
+			}
+
+			if (_src_loc) {
+				break;
+			}
+		}
+	}
+
+	bt_dwarf_cu_destroy(cu);
+	if (_src_loc) {
+		*src_loc = _src_loc;
+	}
+
+	return 0;
+
+error:
+	source_location_destroy(_src_loc);
+	bt_dwarf_cu_destroy(cu);
+	return -1;
+}
+
 BT_HIDDEN
 int bin_info_lookup_source_location(struct bin_info *bin, uint64_t addr,
 		struct source_location **src_loc)
 {
-	struct bt_dwarf_cu *cu = NULL;
+	struct bt_dwarf_file *dwarf_file;
 	struct source_location *_src_loc = NULL;
+	struct source_location *cached_src_loc = NULL;
+	gpointer cached;
+	uint64_t *key = NULL;
 
 	if (!bin || !src_loc) {
 		goto error;
@@ -1570,33 +1988,70 @@ int bin_info_lookup_source_location(struct bin_info *bin, uint64_t addr,
 		addr -= bin->low_addr;
 	}
 
-	cu = bt_dwarf_cu_create(bin->dwarf_info);
-	if (!cu) {
-		goto error;
-	}
+	dwarf_file = bin->dwarf_file;
+	bt_dwarf_file_lock(dwarf_file);
 
-	while (bt_dwarf_cu_next(cu) == 0) {
-		int ret;
+	if (!dwarf_file->src_loc_cache) {
+		dwarf_file->src_loc_cache = g_hash_table_new_full(g_int64_hash,
+			g_int64_equal, (GDestroyNotify) g_free,
+			(GDestroyNotify) source_location_destroy);
+		if (!dwarf_file->src_loc_cache) {
+			goto error_unlock;
+		}
+	}
 
-		ret = bin_info_lookup_cu_src_loc(cu, addr, &_src_loc);
-		if (ret) {
-			goto error;
+	/*
+	 * Finding the source location of an inlined function's
+	 * callsite means walking DIEs: reuse a previous result for
+	 * this address, if any.
+	 */
+	if (g_hash_table_lookup_extended(dwarf_file->src_loc_cache, &addr,
+			NULL, &cached)) {
+		if (cached) {
+			_src_loc = source_location_copy(cached);
+			if (!_src_loc) {
+				goto error_unlock;
+			}
 		}
 
-		if (_src_loc) {
-			break;
+		goto end_unlock;
+	}
+
+	if (bin_info_lookup_dwarf_source_location(bin, addr, &_src_loc)) {
+		goto error_unlock;
+	}
+
+	key = g_new0(uint64_t, 1);
+	if (!key) {
+		goto error_unlock;
+	}
+
+	*key = addr;
+
+	if (_src_loc) {
+		cached_src_loc = source_location_copy(_src_loc);
+		if (!cached_src_loc) {
+			goto error_unlock;
 		}
 	}
 
-	bt_dwarf_cu_destroy(cu);
+	g_hash_table_insert(dwarf_file->src_loc_cache, key, cached_src_loc);
+	key = NULL;
+
+end_unlock:
+	bt_dwarf_file_unlock(dwarf_file);
+
 	if (_src_loc) {
 		*src_loc = _src_loc;
 	}
 
 	return 0;
 
+error_unlock:
+	bt_dwarf_file_unlock(dwarf_file);
+
 error:
+	g_free(key);
 	source_location_destroy(_src_loc);
-	bt_dwarf_cu_destroy(cu);
 	return -1;
 }
@@ -32,8 +32,10 @@
 #include <stdbool.h>
 #include <gelf.h>
 #include <elfutils/libdw.h>
+#include <glib.h>
 #include "common/macros.h"
 #include "fd-cache/fd-cache.h"
+#include "dwarf-file-cache.h"
 
 #define DEFAULT_DEBUG_DIR "/usr/lib/debug"
 #define DEBUG_SUBDIR ".debug"
@@ -58,7 +60,10 @@ struct bin_info {
 	gchar *dwarf_path;
 	/* libelf and libdw objects representing the files. */
 	Elf *elf_file;
+	/* Weak ref. Owned by `dwarf_file`. */
 	Dwarf *dwarf_info;
+	/* Shared, process-wide DWARF file; owned by bin_info. */
+	struct bt_dwarf_file *dwarf_file;
 	/* Optional build ID info. */
 	uint8_t *build_id;
 	size_t build_id_len;
@@ -66,9 +71,8 @@ struct bin_info {
 	/* Optional debug link info. */
 	gchar *dbg_link_filename;
 	uint32_t dbg_link_crc;
-	/* fd cache handles to ELF and DWARF files. */
+	/* fd cache handle to ELF file. */
 	struct bt_fd_cache_handle *elf_handle;
-	struct bt_fd_cache_handle *dwarf_handle;
 	/* Configuration. */
 	gchar *debug_info_dir;
 	/* Denotes whether the executable is position independent code. */
@@ -41,6 +41,7 @@
 
 #include "bin-info.h"
 #include "debug-info.h"
+#include "dwarf-file-cache.h"
 #include "trace-ir-data-copy.h"
 #include "trace-ir-mapping.h"
 #include "trace-ir-metadata-copy.h"
@@ -111,6 +112,15 @@ struct proc_debug_info_sources {
 	 */
 	GHashTable *baddr_to_bin_info;
 
+	/*
+	 * Array of (struct bin_info *), sorted by base address, to find
+	 * the binary containing a given address with a binary search;
+	 * weak references (owned by `baddr_to_bin_info`).
+	 *
+	 * Updated incrementally as binaries are loaded and unloaded.
+	 */
+	GPtrArray *bin_infos_by_addr;
+
 	/*
 	 * Hash table: IP (pointer to uint64_t) to (struct debug_info_source *);
 	 * owned by proc_debug_info_sources.
@@ -138,6 +148,18 @@ struct debug_info {
 	GQuark q_lib_load;
 	GQuark q_lib_unload;
 	struct bt_fd_cache *fd_cache; /* Weak ref. Owned by the iterator. */
+
+	/* Lookup statistics, logged when destroying this object. */
+	struct {
+		/* IP found in a process's IP to debug info source cache */
+		uint64_t ip_cache_hits;
+
+		/* IP resolved through the binary containing it */
+		uint64_t ip_cache_misses;
+
+		/* IP not contained by any known binary */
+		uint64_t unresolved;
+	} stats;
 };
 
 static
@@ -260,6 +282,10 @@ void proc_debug_info_sources_destroy(
 		return;
 	}
 
+	if (proc_dbg_info_src->bin_infos_by_addr) {
+		g_ptr_array_free(proc_dbg_info_src->bin_infos_by_addr, TRUE);
+	}
+
 	if (proc_dbg_info_src->baddr_to_bin_info) {
 		g_hash_table_destroy(proc_dbg_info_src->baddr_to_bin_info);
 	}
@@ -288,6 +314,11 @@ struct proc_debug_info_sources *proc_debug_info_sources_create(void)
 		goto error;
 	}
 
+	proc_dbg_info_src->bin_infos_by_addr = g_ptr_array_new();
+	if (!proc_dbg_info_src->bin_infos_by_addr) {
+		goto error;
+	}
+
 	proc_dbg_info_src->ip_to_debug_info_src = g_hash_table_new_full(
 		g_int64_hash, g_int64_equal, (GDestroyNotify) g_free,
 		(GDestroyNotify) debug_info_source_destroy);
@@ -451,61 +482,134 @@ bool event_has_payload_field(const bt_event *event,
 	return event_borrow_payload_field(event, field_name);
 }
 
+/*
+ * Returns the index, within `proc_dbg_info_src->bin_infos_by_addr`, of
+ * the first binary of which the base address is greater than `addr`.
+ */
 static
-struct debug_info_source *proc_debug_info_sources_get_entry(
-		struct debug_info *debug_info,
-		struct proc_debug_info_sources *proc_dbg_info_src, uint64_t ip)
+guint proc_debug_info_sources_bin_info_upper_bound(
+		struct proc_debug_info_sources *proc_dbg_info_src,
+		uint64_t addr)
 {
-	struct debug_info_source *debug_info_src = NULL;
-	gpointer key = g_new0(uint64_t, 1);
-	GHashTableIter iter;
-	gpointer baddr, value;
+	GPtrArray *bins = proc_dbg_info_src->bin_infos_by_addr;
+	guint low = 0;
+	guint high = bins->len;
 
-	if (!key) {
+	while (low < high) {
+		guint mid = low + (high - low) / 2;
+		struct bin_info *bin = g_ptr_array_index(bins, mid);
+
+		if (bin->low_addr <= addr) {
+			low = mid + 1;
+		} else {
+			high = mid;
+		}
+	}
+
+	return low;
+}
+
+static
+void proc_debug_info_sources_add_bin_info(
+		struct proc_debug_info_sources *proc_dbg_info_src,
+		struct bin_info *bin)
+{
+	guint index = proc_debug_info_sources_bin_info_upper_bound(
+		proc_dbg_info_src, bin->low_addr);
+
+	g_ptr_array_insert(proc_dbg_info_src->bin_infos_by_addr, index, bin);
+}
+
+static
+void proc_debug_info_sources_remove_bin_info(
+		struct proc_debug_info_sources *proc_dbg_info_src,
+		struct bin_info *bin)
+{
+	GPtrArray *bins = proc_dbg_info_src->bin_infos_by_addr;
+	guint index = proc_debug_info_sources_bin_info_upper_bound(
+		proc_dbg_info_src, bin->low_addr);
+
+	/* Base addresses are unique: it's the entry just before */
+	BT_ASSERT(index > 0);
+	BT_ASSERT(g_ptr_array_index(bins, index - 1) == bin);
+	g_ptr_array_remove_index(bins, index - 1);
+}
+
+static
+struct bin_info *proc_debug_info_sources_find_bin_info(
+		struct proc_debug_info_sources *proc_dbg_info_src,
+		uint64_t addr)
+{
+	struct bin_info *bin = NULL;
+	guint index = proc_debug_info_sources_bin_info_upper_bound(
+		proc_dbg_info_src, addr);
+
+	if (index == 0) {
+		/* All binaries are above this address */
 		goto end;
 	}
 
-	*((uint64_t *) key) = ip;
+	bin = g_ptr_array_index(proc_dbg_info_src->bin_infos_by_addr,
+		index - 1);
+	if (!bin_info_has_address(bin, addr)) {
+		bin = NULL;
+	}
+
+end:
+	return bin;
+}
+
+static
+struct debug_info_source *proc_debug_info_sources_get_entry(
+		struct debug_info *debug_info,
+		struct proc_debug_info_sources *proc_dbg_info_src, uint64_t ip)
+{
+	struct debug_info_source *debug_info_src = NULL;
+	gpointer key = NULL;
+	struct bin_info *bin;
 
 	/* Look in IP to debug infos hash table first. */
 	debug_info_src = g_hash_table_lookup(
-		proc_dbg_info_src->ip_to_debug_info_src, key);
+		proc_dbg_info_src->ip_to_debug_info_src, &ip);
 	if (debug_info_src) {
+		debug_info->stats.ip_cache_hits++;
 		goto end;
 	}
 
-	/* Check in all bin_infos. */
-	g_hash_table_iter_init(&iter, proc_dbg_info_src->baddr_to_bin_info);
+	/* Find the binary containing this address. */
+	bin = proc_debug_info_sources_find_bin_info(proc_dbg_info_src, ip);
+	if (!bin) {
+		debug_info->stats.unresolved++;
+		goto end;
+	}
 
-	while (g_hash_table_iter_next(&iter, &baddr, &value))
-	{
-		struct bin_info *bin = value;
+	debug_info->stats.ip_cache_misses++;
 
-		if (!bin_info_has_address(value, ip)) {
-			continue;
-		}
+	/*
+	 * Found; add it to cache.
+	 *
+	 * FIXME: this should be bounded in size (and implement
+	 * a caching policy), and entries should be prunned when
+	 * libraries are unmapped.
+	 */
+	debug_info_src = debug_info_source_create_from_bin(bin, ip,
+		debug_info->self_comp);
+	if (!debug_info_src) {
+		goto end;
+	}
 
-		/*
-		 * Found; add it to cache.
-		 *
-		 * FIXME: this should be bounded in size (and implement
-		 * a caching policy), and entries should be prunned when
-		 * libraries are unmapped.
-		 */
-		debug_info_src = debug_info_source_create_from_bin(bin, ip,
-			debug_info->self_comp);
-		if (debug_info_src) {
-			g_hash_table_insert(
-				proc_dbg_info_src->ip_to_debug_info_src, key,
-				debug_info_src);
-			/* Ownership passed to ht. */
-			key = NULL;
-		}
-		break;
+	key = g_new0(uint64_t, 1);
+	if (!key) {
+		debug_info_source_destroy(debug_info_src);
+		debug_info_src = NULL;
+		goto end;
 	}
 
+	*((uint64_t *) key) = ip;
+	g_hash_table_insert(proc_dbg_info_src->ip_to_debug_info_src, key,
+		debug_info_src);
+
 end:
-	free(key);
 	return debug_info_src;
 }
 
@@ -583,6 +687,12 @@ void debug_info_destroy(struct debug_info *debug_info)
 	log_level = debug_info->log_level;
 	self_comp = debug_info->self_comp;
 
+	BT_COMP_LOGI("Destroying debug info: ip-cache-hits=%" PRIu64 ", "
+		"ip-cache-misses=%" PRIu64 ", unresolved-ips=%" PRIu64,
+		debug_info->stats.ip_cache_hits,
+		debug_info->stats.ip_cache_misses,
+		debug_info->stats.unresolved);
+
 	if (debug_info->vpid_to_proc_dbg_info_src) {
 		g_hash_table_destroy(debug_info->vpid_to_proc_dbg_info_src);
 	}
@@ -784,6 +894,7 @@ void handle_bin_info_event(struct debug_info *debug_info,
 	g_hash_table_insert(proc_dbg_info_src->baddr_to_bin_info, key, bin);
 	/* Ownership passed to ht. */
 	key = NULL;
+	proc_debug_info_sources_add_bin_info(proc_dbg_info_src, bin);
 
 end:
 	g_free(key);
@@ -810,6 +921,7 @@ void handle_event_lib_unload(struct debug_info *debug_info,
 {
 	gboolean ret;
 	struct proc_debug_info_sources *proc_dbg_info_src;
+	struct bin_info *bin;
 	uint64_t baddr;
 	int64_t vpid;
 
@@ -829,6 +941,10 @@ void handle_event_lib_unload(struct debug_info *debug_info,
 		goto end;
 	}
 
+	bin = g_hash_table_lookup(proc_dbg_info_src->baddr_to_bin_info,
+		(gpointer) &baddr);
+	BT_ASSERT(bin);
+	proc_debug_info_sources_remove_bin_info(proc_dbg_info_src, bin);
 	ret = g_hash_table_remove(proc_dbg_info_src->baddr_to_bin_info,
 		(gpointer) &baddr);
 	BT_ASSERT(ret);
@@ -852,6 +968,7 @@ void handle_event_statedump_start(struct debug_info *debug_info,
 		goto end;
 	}
 
+	g_ptr_array_set_size(proc_dbg_info_src->bin_infos_by_addr, 0);
 	g_hash_table_remove_all(proc_dbg_info_src->baddr_to_bin_info);
 	g_hash_table_remove_all(proc_dbg_info_src->ip_to_debug_info_src);
 
@@ -2124,3 +2241,13 @@ void debug_info_msg_iter_finalize(bt_self_message_iterator *it)
 
 	debug_info_msg_iter_destroy(debug_info_msg_iter);
 }
+
+BT_HIDDEN
+void debug_info_plugin_finalize(void)
+{
+	/*
+	 * All the components are destroyed at this point: close the
+	 * DWARF files which remain in the process-wide cache.
+	 */
+	bt_dwarf_file_cache_clear_unused();
+}
@@ -71,4 +71,7 @@ bt_message_iterator_class_seek_beginning_method_status debug_info_msg_iter_seek_
 BT_HIDDEN
 void debug_info_msg_iter_finalize(bt_self_message_iterator *it);
 
+BT_HIDDEN
+void debug_info_plugin_finalize(void);
+
 #endif /* BABELTRACE_PLUGIN_DEBUG_INFO_H */
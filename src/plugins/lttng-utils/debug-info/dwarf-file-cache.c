@@ -0,0 +1,301 @@
+/*
+ * Babeltrace - Process-wide cache of opened DWARF files
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#define BT_COMP_LOG_SELF_COMP self_comp
+#define BT_LOG_OUTPUT_LEVEL log_level
+#define BT_LOG_TAG "PLUGIN/FLT.LTTNG-UTILS.DEBUG-INFO/DWARF-FILE-CACHE"
+#include "logging/comp-logging.h"
+
+#include <fcntl.h>
+#include <inttypes.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+#include <glib.h>
+
+#include "common/assert.h"
+
+#include "dwarf.h"
+#include "dwarf-file-cache.h"
+
+/*
+ * Maximum total size of the cached DWARF files.
+ *
+ * When it's exceeded, unused files are closed, least recently used
+ * first. Files in use are never closed, so the actual total size can
+ * exceed this value.
+ */
+#define DWARF_FILE_CACHE_MAX_SIZE	(UINT64_C(1) << 30)
+
+/* Protects `cache` and the reference counts of the cached files */
+static GMutex cache_lock;
+
+static struct {
+	/*
+	 * Hash table: file key (string) to (struct bt_dwarf_file *);
+	 * owns the files.
+	 */
+	GHashTable *files;
+
+	/*
+	 * Unused files (struct bt_dwarf_file *), least recently used
+	 * first; weak references.
+	 */
+	GQueue unused;
+
+	/* Total size of all the cached files */
+	uint64_t total_size;
+} cache = { NULL, G_QUEUE_INIT, 0 };
+
+static
+void dwarf_file_destroy(struct bt_dwarf_file *file)
+{
+	if (!file) {
+		return;
+	}
+
+	if (file->cu_ranges) {
+		g_array_free(file->cu_ranges, TRUE);
+	}
+
+	if (file->src_loc_cache) {
+		g_hash_table_destroy(file->src_loc_cache);
+	}
+
+	dwarf_end(file->dwarf_info);
+
+	if (file->fd >= 0) {
+		close(file->fd);
+	}
+
+	g_mutex_clear(&file->lock);
+	g_free(file->path);
+	g_free(file->key);
+	g_free(file);
+}
+
+static
+struct bt_dwarf_file *dwarf_file_create(const char *path, int fd,
+		uint64_t size, bt_logging_level log_level,
+		bt_self_component *self_comp)
+{
+	struct bt_dwarf_file *file = g_new0(struct bt_dwarf_file, 1);
+	struct bt_dwarf_cu *cu = NULL;
+
+	if (!file) {
+		goto error;
+	}
+
+	g_mutex_init(&file->lock);
+	file->fd = fd;
+	file->size = size;
+	file->path = g_strdup(path);
+	if (!file->path) {
+		goto error;
+	}
+
+	file->dwarf_info = dwarf_begin(fd, DWARF_C_READ);
+	if (!file->dwarf_info) {
+		BT_COMP_LOGI("Cannot read DWARF info: path=\"%s\"", path);
+		goto error;
+	}
+
+	/*
+	 * Check if the DWARF info has any CU. If not, the object file
+	 * contains no DWARF info.
+	 */
+	cu = bt_dwarf_cu_create(file->dwarf_info);
+	if (!cu) {
+		goto error;
+	}
+
+	if (bt_dwarf_cu_next(cu)) {
+		BT_COMP_LOGI("No DWARF compile unit: path=\"%s\"", path);
+		goto error;
+	}
+
+	goto end;
+
+error:
+	if (file) {
+		/* The caller keeps the ownership of `fd` on error */
+		file->fd = -1;
+	}
+
+	dwarf_file_destroy(file);
+	file = NULL;
+
+end:
+	bt_dwarf_cu_destroy(cu);
+	return file;
+}
+
+/*
+ * Closes unused files, least recently used first, until the total size
+ * of the cached files is less than or equal to `max_size`.
+ *
+ * `cache_lock` must be held.
+ */
+static
+void evict_unused_files(uint64_t max_size)
+{
+	while (cache.total_size > max_size &&
+			!g_queue_is_empty(&cache.unused)) {
+		struct bt_dwarf_file *file = g_queue_pop_head(&cache.unused);
+
+		BT_ASSERT(file->ref_count == 0);
+		file->unused_link = NULL;
+		cache.total_size -= file->size;
+		g_hash_table_remove(cache.files, file->key);
+	}
+}
+
+BT_HIDDEN
+struct bt_dwarf_file *bt_dwarf_file_cache_get(const char *path,
+		bt_logging_level log_level, bt_self_component *self_comp)
+{
+	struct bt_dwarf_file *file = NULL;
+	gchar *key = NULL;
+	struct stat st;
+	int fd;
+
+	BT_ASSERT(path);
+
+	fd = open(path, O_RDONLY);
+	if (fd < 0) {
+		BT_COMP_LOGI_ERRNO("Cannot open DWARF file", ": path=\"%s\"",
+			path);
+		goto end;
+	}
+
+	if (fstat(fd, &st)) {
+		BT_COMP_LOGI_ERRNO("Cannot get DWARF file's status",
+			": path=\"%s\"", path);
+		goto end;
+	}
+
+	key = g_strdup_printf("%" PRIu64 ":%" PRIu64 ":%" PRIu64 ":%" PRId64,
+		(uint64_t) st.st_dev, (uint64_t) st.st_ino,
+		(uint64_t) st.st_size, (int64_t) st.st_mtime);
+	if (!key) {
+		goto end;
+	}
+
+	g_mutex_lock(&cache_lock);
+
+	if (!cache.files) {
+		cache.files = g_hash_table_new_full(g_str_hash, g_str_equal,
+			NULL, (GDestroyNotify) dwarf_file_destroy);
+		if (!cache.files) {
+			goto unlock;
+		}
+	}
+
+	file = g_hash_table_lookup(cache.files, key);
+	if (file) {
+		BT_COMP_LOGD("Reusing cached DWARF file: path=\"%s\", "
+			"cached-path=\"%s\", ref-count=%lu", path, file->path,
+			file->ref_count);
+
+		if (file->unused_link) {
+			g_queue_delete_link(&cache.unused, file->unused_link);
+			file->unused_link = NULL;
+		}
+
+		file->ref_count++;
+		goto unlock;
+	}
+
+	/*
+	 * Parse the file while holding the cache's lock so that two
+	 * threads needing the same file don't both parse it.
+	 */
+	file = dwarf_file_create(path, fd, (uint64_t) st.st_size,
+		log_level, self_comp);
+	if (!file) {
+		goto unlock;
+	}
+
+	/* Ownership of `fd` and `key` passed to `file` */
+	fd = -1;
+	file->key = key;
+	key = NULL;
+	file->ref_count = 1;
+	g_hash_table_insert(cache.files, file->key, file);
+	cache.total_size += file->size;
+	BT_COMP_LOGD("Cached DWARF file: path=\"%s\", size=%" PRIu64 ", "
+		"cache-total-size=%" PRIu64, path, file->size,
+		cache.total_size);
+	evict_unused_files(DWARF_FILE_CACHE_MAX_SIZE);
+
+unlock:
+	g_mutex_unlock(&cache_lock);
+
+end:
+	if (fd >= 0) {
+		close(fd);
+	}
+
+	g_free(key);
+	return file;
+}
+
+BT_HIDDEN
+void bt_dwarf_file_put(struct bt_dwarf_file *file)
+{
+	if (!file) {
+		return;
+	}
+
+	g_mutex_lock(&cache_lock);
+	BT_ASSERT(file->ref_count > 0);
+	file->ref_count--;
+
+	if (file->ref_count == 0) {
+		g_queue_push_tail(&cache.unused, file);
+		file->unused_link = cache.unused.tail;
+		evict_unused_files(DWARF_FILE_CACHE_MAX_SIZE);
+	}
+
+	g_mutex_unlock(&cache_lock);
+}
+
+BT_HIDDEN
+void bt_dwarf_file_cache_clear_unused(void)
+{
+	g_mutex_lock(&cache_lock);
+
+	if (!cache.files) {
+		goto end;
+	}
+
+	evict_unused_files(0);
+
+	if (g_hash_table_size(cache.files) == 0) {
+		g_hash_table_destroy(cache.files);
+		cache.files = NULL;
+	}
+
+end:
+	g_mutex_unlock(&cache_lock);
+}
@@ -0,0 +1,129 @@
+#ifndef BABELTRACE_PLUGIN_DEBUG_INFO_DWARF_FILE_CACHE_H
+#define BABELTRACE_PLUGIN_DEBUG_INFO_DWARF_FILE_CACHE_H
+
+/*
+ * Babeltrace - Process-wide cache of opened DWARF files
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <glib.h>
+#include <elfutils/libdw.h>
+#include <babeltrace2/babeltrace.h>
+#include "common/macros.h"
+
+/*
+ * A DWARF file, opened and parsed once per process, and shared by all
+ * the bin_info objects (of all the `flt.lttng-utils.debug-info`
+ * components) which need the same file.
+ *
+ * Two paths designate the same DWARF file when they lead to the same
+ * file (device and inode numbers) with the same size and modification
+ * time.
+ */
+struct bt_dwarf_file {
+	/* Path used to open the file the first time */
+	gchar *path;
+
+	int fd;
+
+	/* libdw object representing the file; owned by this */
+	Dwarf *dwarf_info;
+
+	/* Size of the file, accounted for in the cache's budget */
+	uint64_t size;
+
+	/*
+	 * Lock protecting `dwarf_info` and the members below: a libdw
+	 * object must not be used from more than one thread at a time.
+	 */
+	GMutex lock;
+
+	/*
+	 * Array of (struct bin_info_cu_range), sorted by low address:
+	 * address range to compile unit index, built lazily by
+	 * bin-info.c on the first lookup.
+	 */
+	GArray *cu_ranges;
+
+	/*
+	 * Denotes whether every compile unit of `dwarf_info` has its
+	 * address ranges in `cu_ranges`.
+	 */
+	bool cu_ranges_complete;
+
+	/*
+	 * Hash table: address (pointer to uint64_t), relative to the
+	 * binary's base address for PIC, to (struct source_location *),
+	 * or `NULL` if the address has no source location; created by
+	 * bin-info.c.
+	 */
+	GHashTable *src_loc_cache;
+
+	/* Private to the cache */
+	gchar *key;
+	unsigned long ref_count;
+
+	/* Link within the cache's list of unused files, if unused */
+	GList *unused_link;
+};
+
+/*
+ * Returns a new reference to the DWARF file at `path`, opening and
+ * parsing it if it's not already cached.
+ *
+ * Returns `NULL` if the file cannot be opened or if it contains no
+ * DWARF compile unit.
+ */
+BT_HIDDEN
+struct bt_dwarf_file *bt_dwarf_file_cache_get(const char *path,
+		bt_logging_level log_level, bt_self_component *self_comp);
+
+/*
+ * Releases a reference to a DWARF file obtained with
+ * bt_dwarf_file_cache_get().
+ *
+ * An unused file remains cached, so that it's not parsed again if it's
+ * needed later, until the total size of the cached files exceeds the
+ * cache's budget.
+ */
+BT_HIDDEN
+void bt_dwarf_file_put(struct bt_dwarf_file *file);
+
+/*
+ * Closes all the cached DWARF files which are not used anymore.
+ */
+BT_HIDDEN
+void bt_dwarf_file_cache_clear_unused(void);
+
+static inline
+void bt_dwarf_file_lock(struct bt_dwarf_file *file)
+{
+	g_mutex_lock(&file->lock);
+}
+
+static inline
+void bt_dwarf_file_unlock(struct bt_dwarf_file *file)
+{
+	g_mutex_unlock(&file->lock);
+}
+
+#endif /* BABELTRACE_PLUGIN_DEBUG_INFO_DWARF_FILE_CACHE_H */
@@ -85,6 +85,34 @@ end:
 	return ret;
 }
 
+BT_HIDDEN
+int bt_dwarf_cu_seek(struct bt_dwarf_cu *cu, Dwarf_Off offset)
+{
+	int ret;
+	Dwarf_Off next_offset;
+	size_t cu_header_size;
+
+	if (!cu) {
+		ret = -1;
+		goto end;
+	}
+
+	ret = dwarf_nextcu(cu->dwarf_info, offset, &next_offset,
+			&cu_header_size, NULL, NULL, NULL);
+	if (ret) {
+		/* There's no CU at this offset. */
+		ret = -1;
+		goto end;
+	}
+
+	cu->offset = offset;
+	cu->next_offset = next_offset;
+	cu->header_size = cu_header_size;
+
+end:
+	return ret;
+}
+
 BT_HIDDEN
 struct bt_dwarf_die *bt_dwarf_die_create(struct bt_dwarf_cu *cu)
 {
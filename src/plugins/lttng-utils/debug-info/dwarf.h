@@ -100,6 +100,19 @@ void bt_dwarf_cu_destroy(struct bt_dwarf_cu *cu);
 BT_HIDDEN
 int bt_dwarf_cu_next(struct bt_dwarf_cu *cu);
 
+/**
+ * Move the compile unit `cu` to the one of which the header is
+ * located at `offset` in the DWARF file.
+ *
+ * On failure, `cu` remains unchanged.
+ *
+ * @param cu		bt_dwarf_cu instance
+ * @param offset	Offset in bytes of the CU header
+ * @returns		0 on success, -1 on failure
+ */
+BT_HIDDEN
+int bt_dwarf_cu_seek(struct bt_dwarf_cu *cu, Dwarf_Off offset);
+
 /**
  * Instantiate a structure to access debug information entries (DIE)
  * for the given compile unit `cu`.
@@ -0,0 +1,56 @@
+/*
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <babeltrace2/babeltrace.h>
+#include "shm-sink.h"
+#include "shm-src.h"
+
+#ifndef BT_BUILT_IN_PLUGINS
+BT_PLUGIN_MODULE();
+#endif
+
+BT_PLUGIN(shm);
+BT_PLUGIN_DESCRIPTION("Shared memory graph boundary");
+BT_PLUGIN_AUTHOR("EfficiOS <https://www.efficios.com/>");
+BT_PLUGIN_LICENSE("MIT");
+
+/* sink.shm.ring */
+BT_PLUGIN_SINK_COMPONENT_CLASS(ring, shm_sink_consume);
+BT_PLUGIN_SINK_COMPONENT_CLASS_INITIALIZE_METHOD(ring, shm_sink_init);
+BT_PLUGIN_SINK_COMPONENT_CLASS_FINALIZE_METHOD(ring, shm_sink_finalize);
+BT_PLUGIN_SINK_COMPONENT_CLASS_GRAPH_IS_CONFIGURED_METHOD(ring,
+	shm_sink_graph_is_configured);
+BT_PLUGIN_SINK_COMPONENT_CLASS_DESCRIPTION(ring,
+	"Write messages to a shared memory ring buffer.");
+BT_PLUGIN_SINK_COMPONENT_CLASS_HELP(ring,
+	"See the babeltrace2-sink.shm.ring(7) manual page.");
+
+/* source.shm.ring */
+BT_PLUGIN_SOURCE_COMPONENT_CLASS(ring, shm_src_msg_iter_next);
+BT_PLUGIN_SOURCE_COMPONENT_CLASS_INITIALIZE_METHOD(ring, shm_src_init);
+BT_PLUGIN_SOURCE_COMPONENT_CLASS_FINALIZE_METHOD(ring, shm_src_finalize);
+BT_PLUGIN_SOURCE_COMPONENT_CLASS_MESSAGE_ITERATOR_CLASS_INITIALIZE_METHOD(ring,
+	shm_src_msg_iter_init);
+BT_PLUGIN_SOURCE_COMPONENT_CLASS_MESSAGE_ITERATOR_CLASS_FINALIZE_METHOD(ring,
+	shm_src_msg_iter_finalize);
+BT_PLUGIN_SOURCE_COMPONENT_CLASS_DESCRIPTION(ring,
+	"Read messages from a shared memory ring buffer.");
+BT_PLUGIN_SOURCE_COMPONENT_CLASS_HELP(ring,
+	"See the babeltrace2-source.shm.ring(7) manual page.");
@@ -0,0 +1,608 @@
+/*
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#define BT_COMP_LOG_SELF_COMP (ring->self_comp)
+#define BT_LOG_OUTPUT_LEVEL (ring->log_level)
+#define BT_LOG_TAG "PLUGIN/SHM/RING"
+#include "logging/comp-logging.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <inttypes.h>
+#include <linux/futex.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+#include <glib.h>
+#include "common/assert.h"
+#include "common/common.h"
+
+#include "ring.h"
+
+/*
+ * Offset of the data area within the shared memory object: the header
+ * gets its own page.
+ */
+#define DATA_OFFSET		4096
+
+/* Size of the size prefix of a record */
+#define RECORD_SIZE_SIZE	sizeof(uint32_t)
+
+/*
+ * Maximum time to wait for the creator of an existing shared memory
+ * object to initialize its header (µs).
+ */
+#define ATTACH_INIT_TIMEOUT_US	(5 * G_USEC_PER_SEC)
+
+static
+int futex_wait(uint32_t *uaddr, uint32_t val, int64_t timeout_us)
+{
+	struct timespec ts = {
+		.tv_sec = timeout_us / G_USEC_PER_SEC,
+		.tv_nsec = (timeout_us % G_USEC_PER_SEC) * 1000,
+	};
+
+	/*
+	 * Not `FUTEX_WAIT_PRIVATE`: the futex word is shared with
+	 * another process.
+	 */
+	return syscall(SYS_futex, uaddr, FUTEX_WAIT, val, &ts, NULL, 0);
+}
+
+static
+void futex_wake(uint32_t *uaddr)
+{
+	(void) syscall(SYS_futex, uaddr, FUTEX_WAKE, INT32_MAX, NULL, NULL, 0);
+}
+
+static
+uint64_t round_up_pow2(uint64_t val)
+{
+	uint64_t pow2 = 1;
+
+	while (pow2 < val) {
+		pow2 <<= 1;
+	}
+
+	return pow2;
+}
+
+static
+enum shm_ring_role peer_role(enum shm_ring_role role)
+{
+	return role == SHM_RING_ROLE_PRODUCER ? SHM_RING_ROLE_CONSUMER :
+		SHM_RING_ROLE_PRODUCER;
+}
+
+static
+const char *role_string(enum shm_ring_role role)
+{
+	return role == SHM_RING_ROLE_PRODUCER ? "producer" : "consumer";
+}
+
+static
+bool peer_detached(struct shm_ring *ring)
+{
+	return __atomic_load_n(&ring->header->detached_roles,
+		__ATOMIC_SEQ_CST) & peer_role(ring->role);
+}
+
+static
+int map(struct shm_ring *ring, size_t size)
+{
+	int ret = 0;
+
+	ring->addr = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED,
+		ring->fd, 0);
+	if (ring->addr == MAP_FAILED) {
+		BT_COMP_LOGE_APPEND_CAUSE_ERRNO(ring->self_comp,
+			"Cannot map shared memory object",
+			": name=\"%s\", size=%zu", ring->name->str, size);
+		ring->addr = NULL;
+		ret = -1;
+		goto end;
+	}
+
+	ring->map_size = size;
+	ring->header = ring->addr;
+	ring->data = (uint8_t *) ring->addr + DATA_OFFSET;
+
+end:
+	return ret;
+}
+
+/* Creates and initializes the shared memory object of `ring`. */
+static
+int create(struct shm_ring *ring, uint64_t size)
+{
+	uint64_t capacity = round_up_pow2(MAX(size, SHM_RING_MIN_SIZE));
+	int ret;
+
+	ret = ftruncate(ring->fd, DATA_OFFSET + capacity);
+	if (ret) {
+		BT_COMP_LOGE_APPEND_CAUSE_ERRNO(ring->self_comp,
+			"Cannot set size of shared memory object",
+			": name=\"%s\", size=%" PRIu64, ring->name->str,
+			DATA_OFFSET + capacity);
+		goto end;
+	}
+
+	ret = map(ring, DATA_OFFSET + capacity);
+	if (ret) {
+		goto end;
+	}
+
+	/* ftruncate() zeroed the other members */
+	ring->header->version = SHM_RING_VERSION;
+	ring->header->capacity = capacity;
+	__atomic_store_n(&ring->header->magic, SHM_RING_MAGIC,
+		__ATOMIC_RELEASE);
+	BT_COMP_LOGI("Created shared memory ring: name=\"%s\", capacity=%" PRIu64,
+		ring->name->str, capacity);
+
+end:
+	return ret;
+}
+
+/*
+ * Maps the existing shared memory object of `ring`, waiting for its
+ * creator to initialize it.
+ */
+static
+int open_existing(struct shm_ring *ring)
+{
+	int64_t deadline = g_get_monotonic_time() + ATTACH_INIT_TIMEOUT_US;
+	struct stat st;
+	int ret;
+
+	/* Wait for the creator to set the size of the object */
+	while (true) {
+		ret = fstat(ring->fd, &st);
+		if (ret) {
+			BT_COMP_LOGE_APPEND_CAUSE_ERRNO(ring->self_comp,
+				"Cannot get size of shared memory object",
+				": name=\"%s\"", ring->name->str);
+			goto end;
+		}
+
+		if (st.st_size > DATA_OFFSET) {
+			break;
+		}
+
+		if (g_get_monotonic_time() >= deadline) {
+			goto timeout;
+		}
+
+		g_usleep(1000);
+	}
+
+	ret = map(ring, st.st_size);
+	if (ret) {
+		goto end;
+	}
+
+	/* Wait for the creator to initialize the header */
+	while (__atomic_load_n(&ring->header->magic, __ATOMIC_ACQUIRE) !=
+			SHM_RING_MAGIC) {
+		if (g_get_monotonic_time() >= deadline) {
+			goto timeout;
+		}
+
+		g_usleep(1000);
+	}
+
+	if (ring->header->version != SHM_RING_VERSION) {
+		BT_COMP_LOGE_APPEND_CAUSE(ring->self_comp,
+			"Unsupported shared memory ring version: "
+			"name=\"%s\", version=%" PRIu32 ", expected-version=%d",
+			ring->name->str, ring->header->version,
+			SHM_RING_VERSION);
+		goto error;
+	}
+
+	if (DATA_OFFSET + ring->header->capacity > ring->map_size) {
+		BT_COMP_LOGE_APPEND_CAUSE(ring->self_comp,
+			"Shared memory object is too small for its ring: "
+			"name=\"%s\", size=%zu, capacity=%" PRIu64,
+			ring->name->str, ring->map_size,
+			ring->header->capacity);
+		goto error;
+	}
+
+	BT_COMP_LOGI("Opened existing shared memory ring: name=\"%s\", "
+		"capacity=%" PRIu64, ring->name->str, ring->header->capacity);
+	goto end;
+
+timeout:
+	BT_COMP_LOGE_APPEND_CAUSE(ring->self_comp,
+		"Timeout while waiting for the initialization of an existing "
+		"shared memory object: name=\"%s\"", ring->name->str);
+
+error:
+	ret = -1;
+
+end:
+	return ret;
+}
+
+/* Claims the role of `ring` within its shared header. */
+static
+int claim_role(struct shm_ring *ring)
+{
+	uint32_t roles = __atomic_load_n(&ring->header->roles,
+		__ATOMIC_SEQ_CST);
+	int ret = 0;
+
+	do {
+		if (roles & ring->role) {
+			BT_COMP_LOGE_APPEND_CAUSE(ring->self_comp,
+				"Shared memory ring already has a %s: name=\"%s\"",
+				role_string(ring->role), ring->name->str);
+			ret = -1;
+			goto end;
+		}
+	} while (!__atomic_compare_exchange_n(&ring->header->roles, &roles,
+		roles | ring->role, false, __ATOMIC_SEQ_CST,
+		__ATOMIC_SEQ_CST));
+
+	if (__atomic_add_fetch(&ring->header->attach_count, 1,
+			__ATOMIC_SEQ_CST) == 2) {
+		/*
+		 * Both sides have the object mapped: remove its name so
+		 * that it goes away with the last mapping.
+		 */
+		if (shm_unlink(ring->name->str)) {
+			BT_COMP_LOGW_ERRNO("Cannot remove shared memory object",
+				": name=\"%s\"", ring->name->str);
+		}
+	}
+
+end:
+	return ret;
+}
+
+BT_HIDDEN
+int shm_ring_attach(struct shm_ring *ring, const char *name, uint64_t size,
+		enum shm_ring_role role, bt_logging_level log_level,
+		bt_self_component *self_comp)
+{
+	int ret = 0;
+
+	memset(ring, 0, sizeof(*ring));
+	ring->log_level = log_level;
+	ring->self_comp = self_comp;
+	ring->role = role;
+	ring->fd = -1;
+	ring->name = g_string_new(NULL);
+	if (!ring->name) {
+		BT_COMP_LOGE_APPEND_CAUSE(self_comp, "Failed to allocate a GString.");
+		goto error;
+	}
+
+	/* POSIX shared memory object names start with `/` */
+	if (name[0] != '/') {
+		g_string_append_c(ring->name, '/');
+	}
+
+	g_string_append(ring->name, name);
+
+	if (strchr(ring->name->str + 1, '/')) {
+		BT_COMP_LOGE_APPEND_CAUSE(self_comp,
+			"Invalid shared memory ring name: "
+			"name must not contain `/`, except at its beginning: "
+			"name=\"%s\"", name);
+		goto error;
+	}
+
+	ring->fd = shm_open(ring->name->str, O_RDWR | O_CREAT | O_EXCL, 0600);
+	if (ring->fd >= 0) {
+		ring->is_creator = true;
+		ret = create(ring, size);
+	} else if (errno == EEXIST) {
+		ring->fd = shm_open(ring->name->str, O_RDWR, 0);
+		if (ring->fd < 0) {
+			BT_COMP_LOGE_APPEND_CAUSE_ERRNO(self_comp,
+				"Cannot open shared memory object",
+				": name=\"%s\"", ring->name->str);
+			goto error;
+		}
+
+		ret = open_existing(ring);
+	} else {
+		BT_COMP_LOGE_APPEND_CAUSE_ERRNO(self_comp,
+			"Cannot create shared memory object",
+			": name=\"%s\"", ring->name->str);
+		goto error;
+	}
+
+	if (ret) {
+		goto error;
+	}
+
+	ret = claim_role(ring);
+	if (ret) {
+		goto error;
+	}
+
+	BT_COMP_LOGI("Attached to shared memory ring: name=\"%s\", role=%s",
+		ring->name->str, role_string(role));
+	goto end;
+
+error:
+	if (ring->is_creator) {
+		(void) shm_unlink(ring->name->str);
+	}
+
+	if (ring->addr) {
+		(void) munmap(ring->addr, ring->map_size);
+		ring->addr = NULL;
+	}
+
+	if (ring->fd >= 0) {
+		(void) close(ring->fd);
+		ring->fd = -1;
+	}
+
+	if (ring->name) {
+		g_string_free(ring->name, TRUE);
+		ring->name = NULL;
+	}
+
+	ret = -1;
+
+end:
+	return ret;
+}
+
+BT_HIDDEN
+void shm_ring_detach(struct shm_ring *ring)
+{
+	struct shm_ring_header *header = ring->header;
+
+	if (!header) {
+		goto end;
+	}
+
+	__atomic_or_fetch(&header->detached_roles, ring->role,
+		__ATOMIC_SEQ_CST);
+
+	/* Wake the other side, whichever futex it sleeps on */
+	__atomic_add_fetch(&header->data_seq, 1, __ATOMIC_SEQ_CST);
+	__atomic_add_fetch(&header->space_seq, 1, __ATOMIC_SEQ_CST);
+	futex_wake(&header->data_seq);
+	futex_wake(&header->space_seq);
+
+	/*
+	 * A consumer which created the ring removes its name if no
+	 * producer ever attached. A producer which created the ring
+	 * leaves it: a consumer can still attach and read its records.
+	 */
+	if (ring->is_creator && ring->role == SHM_RING_ROLE_CONSUMER &&
+			__atomic_load_n(&header->attach_count,
+				__ATOMIC_SEQ_CST) == 1) {
+		(void) shm_unlink(ring->name->str);
+	}
+
+	BT_COMP_LOGI("Detached from shared memory ring: name=\"%s\", role=%s",
+		ring->name->str, role_string(ring->role));
+	(void) munmap(ring->addr, ring->map_size);
+	ring->addr = NULL;
+	ring->header = NULL;
+	ring->data = NULL;
+
+end:
+	if (ring->fd >= 0) {
+		(void) close(ring->fd);
+		ring->fd = -1;
+	}
+
+	if (ring->name) {
+		g_string_free(ring->name, TRUE);
+		ring->name = NULL;
+	}
+}
+
+static
+void copy_to_ring(struct shm_ring *ring, uint64_t pos, const void *src,
+		size_t size)
+{
+	uint64_t capacity = ring->header->capacity;
+	uint64_t offset = pos & (capacity - 1);
+	size_t first_size = MIN(size, capacity - offset);
+
+	memcpy(&ring->data[offset], src, first_size);
+	memcpy(ring->data, (const uint8_t *) src + first_size,
+		size - first_size);
+}
+
+static
+void copy_from_ring(struct shm_ring *ring, uint64_t pos, void *dst,
+		size_t size)
+{
+	uint64_t capacity = ring->header->capacity;
+	uint64_t offset = pos & (capacity - 1);
+	size_t first_size = MIN(size, capacity - offset);
+
+	memcpy(dst, &ring->data[offset], first_size);
+	memcpy((uint8_t *) dst + first_size, ring->data, size - first_size);
+}
+
+/*
+ * Waits, until `deadline` (monotonic time, µs), for the other side to
+ * change the futex word `seq`.
+ *
+ * `seq_val` is the value of `seq` which the caller read before finding
+ * that it cannot make progress: if the other side changed `seq` in
+ * between, this function returns immediately.
+ */
+static
+enum shm_ring_status wait_seq(struct shm_ring *ring, uint32_t *seq,
+		uint32_t seq_val, uint32_t *waiter, int64_t deadline)
+{
+	enum shm_ring_status status = SHM_RING_STATUS_OK;
+	int64_t now = g_get_monotonic_time();
+	int ret;
+
+	if (now >= deadline) {
+		status = SHM_RING_STATUS_AGAIN;
+		goto end;
+	}
+
+	__atomic_store_n(waiter, 1, __ATOMIC_SEQ_CST);
+	ret = futex_wait(seq, seq_val, deadline - now);
+	__atomic_store_n(waiter, 0, __ATOMIC_SEQ_CST);
+	if (ret && errno != EAGAIN && errno != EINTR && errno != ETIMEDOUT) {
+		BT_COMP_LOGE_APPEND_CAUSE_ERRNO(ring->self_comp,
+			"Cannot wait on shared memory ring futex",
+			": name=\"%s\"", ring->name->str);
+		status = SHM_RING_STATUS_ERROR;
+	}
+
+end:
+	return status;
+}
+
+BT_HIDDEN
+enum shm_ring_status shm_ring_write(struct shm_ring *ring,
+		const uint8_t *data, size_t size, uint64_t timeout_us)
+{
+	struct shm_ring_header *header = ring->header;
+	int64_t deadline = g_get_monotonic_time() + (int64_t) timeout_us;
+	uint64_t record_size = RECORD_SIZE_SIZE + size;
+	uint64_t write_pos = header->write_pos;
+	enum shm_ring_status status;
+	uint32_t size_prefix = (uint32_t) size;
+
+	BT_ASSERT_DBG(ring->role == SHM_RING_ROLE_PRODUCER);
+
+	if (size > UINT32_MAX || record_size > header->capacity) {
+		BT_COMP_LOGE_APPEND_CAUSE(ring->self_comp,
+			"Record is larger than the shared memory ring: "
+			"name=\"%s\", record-size=%" PRIu64 ", capacity=%" PRIu64,
+			ring->name->str, record_size, header->capacity);
+		status = SHM_RING_STATUS_ERROR;
+		goto end;
+	}
+
+	while (true) {
+		uint32_t space_seq = __atomic_load_n(&header->space_seq,
+			__ATOMIC_SEQ_CST);
+		uint64_t read_pos = __atomic_load_n(&header->read_pos,
+			__ATOMIC_SEQ_CST);
+
+		if (peer_detached(ring)) {
+			status = SHM_RING_STATUS_DETACHED;
+			goto end;
+		}
+
+		if (header->capacity - (write_pos - read_pos) >= record_size) {
+			break;
+		}
+
+		status = wait_seq(ring, &header->space_seq, space_seq,
+			&header->space_waiter, deadline);
+		if (status != SHM_RING_STATUS_OK) {
+			goto end;
+		}
+	}
+
+	copy_to_ring(ring, write_pos, &size_prefix, RECORD_SIZE_SIZE);
+	copy_to_ring(ring, write_pos + RECORD_SIZE_SIZE, data, size);
+
+	/* Publish the record, then wake the consumer if it sleeps */
+	__atomic_store_n(&header->write_pos, write_pos + record_size,
+		__ATOMIC_SEQ_CST);
+	__atomic_add_fetch(&header->data_seq, 1, __ATOMIC_SEQ_CST);
+
+	if (__atomic_load_n(&header->data_waiter, __ATOMIC_SEQ_CST)) {
+		futex_wake(&header->data_seq);
+	}
+
+	status = SHM_RING_STATUS_OK;
+
+end:
+	return status;
+}
+
+BT_HIDDEN
+enum shm_ring_status shm_ring_read(struct shm_ring *ring, GByteArray *buf,
+		uint64_t timeout_us)
+{
+	struct shm_ring_header *header = ring->header;
+	int64_t deadline = g_get_monotonic_time() + (int64_t) timeout_us;
+	uint64_t read_pos = header->read_pos;
+	enum shm_ring_status status;
+	uint32_t size;
+
+	BT_ASSERT_DBG(ring->role == SHM_RING_ROLE_CONSUMER);
+
+	while (true) {
+		uint32_t data_seq = __atomic_load_n(&header->data_seq,
+			__ATOMIC_SEQ_CST);
+		bool producer_detached = peer_detached(ring);
+		uint64_t write_pos = __atomic_load_n(&header->write_pos,
+			__ATOMIC_SEQ_CST);
+
+		if (write_pos != read_pos) {
+			/*
+			 * The producer publishes whole records: the
+			 * record's data follows its size prefix.
+			 */
+			BT_ASSERT_DBG(write_pos - read_pos >= RECORD_SIZE_SIZE);
+			break;
+		}
+
+		/*
+		 * Checking `detached_roles` _before_ reading `write_pos`
+		 * guarantees that no record follows.
+		 */
+		if (producer_detached) {
+			status = SHM_RING_STATUS_END;
+			goto end;
+		}
+
+		status = wait_seq(ring, &header->data_seq, data_seq,
+			&header->data_waiter, deadline);
+		if (status != SHM_RING_STATUS_OK) {
+			goto end;
+		}
+	}
+
+	copy_from_ring(ring, read_pos, &size, RECORD_SIZE_SIZE);
+	g_byte_array_set_size(buf, size);
+	copy_from_ring(ring, read_pos + RECORD_SIZE_SIZE, buf->data, size);
+
+	/* Free the record's space, then wake the producer if it sleeps */
+	__atomic_store_n(&header->read_pos,
+		read_pos + RECORD_SIZE_SIZE + size, __ATOMIC_SEQ_CST);
+	__atomic_add_fetch(&header->space_seq, 1, __ATOMIC_SEQ_CST);
+
+	if (__atomic_load_n(&header->space_waiter, __ATOMIC_SEQ_CST)) {
+		futex_wake(&header->space_seq);
+	}
+
+	status = SHM_RING_STATUS_OK;
+
+end:
+	return status;
+}
@@ -0,0 +1,200 @@
+#ifndef BABELTRACE_PLUGINS_SHM_RING_H
+#define BABELTRACE_PLUGINS_SHM_RING_H
+
+/*
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <glib.h>
+#include <babeltrace2/babeltrace.h>
+#include "common/macros.h"
+
+/*
+ * Shared memory ring buffer between one producer process
+ * (`sink.shm.ring` component) and one consumer process
+ * (`source.shm.ring` component).
+ *
+ * The ring is a POSIX shared memory object which starts with a
+ * `struct shm_ring_header` followed by the data area. The producer
+ * writes records (a 32-bit size followed by the record's bytes) to the
+ * data area, possibly wrapping around its end, and the consumer reads
+ * them in the same order.
+ *
+ * A side which finds the ring empty (consumer) or full (producer)
+ * sleeps on a futex word of the header which the other side increments
+ * and wakes when it makes progress.
+ */
+
+#define SHM_RING_MAGIC			0xb72e5a11U
+#define SHM_RING_VERSION		1
+
+/* Default and minimum sizes of the data area (bytes) */
+#define SHM_RING_DEFAULT_SIZE		(UINT64_C(4) * 1024 * 1024)
+#define SHM_RING_MIN_SIZE		(UINT64_C(64) * 1024)
+
+enum shm_ring_role {
+	SHM_RING_ROLE_PRODUCER		= 1 << 0,
+	SHM_RING_ROLE_CONSUMER		= 1 << 1,
+};
+
+enum shm_ring_status {
+	SHM_RING_STATUS_OK,
+
+	/* Nothing to read (consumer) or no room to write (producer) yet */
+	SHM_RING_STATUS_AGAIN,
+
+	/* Producer is done and the ring is empty (consumer) */
+	SHM_RING_STATUS_END,
+
+	/* Other side detached */
+	SHM_RING_STATUS_DETACHED,
+
+	SHM_RING_STATUS_ERROR,
+};
+
+/* Beginning of the shared memory object */
+struct shm_ring_header {
+	/*
+	 * `SHM_RING_MAGIC`, set last by the creator once the other
+	 * members are initialized.
+	 */
+	uint32_t magic;
+	uint32_t version;
+
+	/* Size of the data area (bytes, power of two) */
+	uint64_t capacity;
+
+	/*
+	 * Number of bytes the producer wrote and the consumer read
+	 * since the creation of the ring: the readable bytes are at
+	 * [`read_pos`, `write_pos`[ (modulo `capacity`).
+	 */
+	uint64_t write_pos;
+	uint64_t read_pos;
+
+	/*
+	 * Futex words: the producer increments `data_seq` after
+	 * writing and the consumer increments `space_seq` after
+	 * reading.
+	 */
+	uint32_t data_seq;
+	uint32_t space_seq;
+
+	/* True if a side sleeps on `data_seq` or on `space_seq` */
+	uint32_t data_waiter;
+	uint32_t space_waiter;
+
+	/* `enum shm_ring_role` bits of the attached sides */
+	uint32_t roles;
+
+	/* Number of sides which attached since the creation */
+	uint32_t attach_count;
+
+	/* `enum shm_ring_role` bits of the sides which detached */
+	uint32_t detached_roles;
+};
+
+struct shm_ring {
+	bt_logging_level log_level;
+
+	/* Weak */
+	bt_self_component *self_comp;
+
+	enum shm_ring_role role;
+
+	/* Name of the shared memory object */
+	GString *name;
+
+	int fd;
+
+	/* Mapping of the whole shared memory object */
+	void *addr;
+	size_t map_size;
+
+	/* Within `addr` */
+	struct shm_ring_header *header;
+	uint8_t *data;
+
+	/* True if this side created the shared memory object */
+	bool is_creator;
+};
+
+/*
+ * Attaches to the ring named `name` (a POSIX shared memory object
+ * name, starting with `/`) with the role `role`, creating it with a
+ * data area of at least `size` bytes if it does not exist yet.
+ *
+ * The side which attaches second removes the name: two other processes
+ * can then reuse it while the ring is in use.
+ */
+BT_HIDDEN
+int shm_ring_attach(struct shm_ring *ring, const char *name, uint64_t size,
+		enum shm_ring_role role, bt_logging_level log_level,
+		bt_self_component *self_comp);
+
+/*
+ * Detaches from `ring`, waking the other side.
+ *
+ * The producer must call this once it wrote its last record, so that
+ * the consumer gets `SHM_RING_STATUS_END` after reading it.
+ */
+BT_HIDDEN
+void shm_ring_detach(struct shm_ring *ring);
+
+/*
+ * Writes the record `data` of size `size` to `ring`.
+ *
+ * Waits for room, for up to `timeout_us` µs, if `ring` is full.
+ */
+BT_HIDDEN
+enum shm_ring_status shm_ring_write(struct shm_ring *ring,
+		const uint8_t *data, size_t size, uint64_t timeout_us);
+
+/*
+ * Reads the next record of `ring` into `buf`, replacing its content.
+ *
+ * Waits for a record, for up to `timeout_us` µs, if `ring` is empty.
+ */
+BT_HIDDEN
+enum shm_ring_status shm_ring_read(struct shm_ring *ring, GByteArray *buf,
+		uint64_t timeout_us);
+
+static inline
+const char *shm_ring_status_string(enum shm_ring_status status)
+{
+	switch (status) {
+	case SHM_RING_STATUS_OK:
+		return "OK";
+	case SHM_RING_STATUS_AGAIN:
+		return "AGAIN";
+	case SHM_RING_STATUS_END:
+		return "END";
+	case SHM_RING_STATUS_DETACHED:
+		return "DETACHED";
+	case SHM_RING_STATUS_ERROR:
+		return "ERROR";
+	default:
+		return "(unknown)";
+	}
+}
+
+#endif /* BABELTRACE_PLUGINS_SHM_RING_H */
@@ -0,0 +1,1377 @@
+/*
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#define BT_COMP_LOG_SELF_COMP (shm_sink->self_comp)
+#define BT_LOG_OUTPUT_LEVEL (shm_sink->log_level)
+#define BT_LOG_TAG "PLUGIN/SINK.SHM.RING"
+#include "logging/comp-logging.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <glib.h>
+#include <babeltrace2/babeltrace.h>
+#include "common/assert.h"
+#include "common/common.h"
+#include "plugins/common/param-validation/param-validation.h"
+
+#include "ring.h"
+#include "shm-sink.h"
+#include "wire.h"
+
+static
+const char * const in_port_name = "in";
+
+/*
+ * Maximum time to wait for room in the ring within a single "consume"
+ * method call (µs).
+ */
+#define WRITE_TIMEOUT_US	(100 * 1000)
+
+static
+void write_value(GByteArray *buf, const bt_value *val);
+
+static
+bt_value_map_foreach_entry_const_func_status write_map_entry(
+		const char *key, const bt_value *val, void *user_data)
+{
+	GByteArray *buf = user_data;
+
+	shm_wire_write_string(buf, key);
+	write_value(buf, val);
+	return BT_VALUE_MAP_FOREACH_ENTRY_CONST_FUNC_STATUS_OK;
+}
+
+static
+void write_value(GByteArray *buf, const bt_value *val)
+{
+	bt_value_type type = bt_value_get_type(val);
+	uint64_t i;
+
+	shm_wire_write_uint(buf, type);
+
+	switch (type) {
+	case BT_VALUE_TYPE_NULL:
+		break;
+	case BT_VALUE_TYPE_BOOL:
+		shm_wire_write_bool(buf, bt_value_bool_get(val));
+		break;
+	case BT_VALUE_TYPE_UNSIGNED_INTEGER:
+		shm_wire_write_uint(buf, bt_value_integer_unsigned_get(val));
+		break;
+	case BT_VALUE_TYPE_SIGNED_INTEGER:
+		shm_wire_write_int(buf, bt_value_integer_signed_get(val));
+		break;
+	case BT_VALUE_TYPE_REAL:
+		shm_wire_write_double(buf, bt_value_real_get(val));
+		break;
+	case BT_VALUE_TYPE_STRING:
+		shm_wire_write_string(buf, bt_value_string_get(val));
+		break;
+	case BT_VALUE_TYPE_ARRAY:
+		shm_wire_write_uint(buf, bt_value_array_get_length(val));
+
+		for (i = 0; i < bt_value_array_get_length(val); i++) {
+			write_value(buf,
+				bt_value_array_borrow_element_by_index_const(
+					val, i));
+		}
+
+		break;
+	case BT_VALUE_TYPE_MAP:
+		shm_wire_write_uint(buf, bt_value_map_get_size(val));
+		(void) bt_value_map_foreach_entry_const(val, write_map_entry,
+			buf);
+		break;
+	default:
+		bt_common_abort();
+	}
+}
+
+static
+void write_uint_range_set(GByteArray *buf,
+		const bt_integer_range_set_unsigned *range_set)
+{
+	uint64_t count = bt_integer_range_set_get_range_count(
+		bt_integer_range_set_unsigned_as_range_set_const(range_set));
+	uint64_t i;
+
+	shm_wire_write_uint(buf, count);
+
+	for (i = 0; i < count; i++) {
+		const bt_integer_range_unsigned *range =
+			bt_integer_range_set_unsigned_borrow_range_by_index_const(
+				range_set, i);
+
+		shm_wire_write_uint(buf,
+			bt_integer_range_unsigned_get_lower(range));
+		shm_wire_write_uint(buf,
+			bt_integer_range_unsigned_get_upper(range));
+	}
+}
+
+static
+void write_int_range_set(GByteArray *buf,
+		const bt_integer_range_set_signed *range_set)
+{
+	uint64_t count = bt_integer_range_set_get_range_count(
+		bt_integer_range_set_signed_as_range_set_const(range_set));
+	uint64_t i;
+
+	shm_wire_write_uint(buf, count);
+
+	for (i = 0; i < count; i++) {
+		const bt_integer_range_signed *range =
+			bt_integer_range_set_signed_borrow_range_by_index_const(
+				range_set, i);
+
+		shm_wire_write_int(buf,
+			bt_integer_range_signed_get_lower(range));
+		shm_wire_write_int(buf,
+			bt_integer_range_signed_get_upper(range));
+	}
+}
+
+/* Writes `field_path` as a key (see `wire.h`) */
+static
+void write_field_path(GByteArray *buf, const bt_field_path *field_path)
+{
+	GString *key = g_string_new(NULL);
+	uint64_t i;
+
+	BT_ASSERT(key);
+	g_string_append_printf(key, "%d",
+		(int) bt_field_path_get_root_scope(field_path));
+
+	for (i = 0; i < bt_field_path_get_item_count(field_path); i++) {
+		const bt_field_path_item *item =
+			bt_field_path_borrow_item_by_index_const(field_path, i);
+
+		switch (bt_field_path_item_get_type(item)) {
+		case BT_FIELD_PATH_ITEM_TYPE_INDEX:
+			shm_wire_field_path_key_append_index(key,
+				bt_field_path_item_index_get_index(item));
+			break;
+		case BT_FIELD_PATH_ITEM_TYPE_CURRENT_ARRAY_ELEMENT:
+			shm_wire_field_path_key_append_char(key,
+				SHM_WIRE_FIELD_PATH_KEY_CURRENT_ARRAY_ELEMENT);
+			break;
+		case BT_FIELD_PATH_ITEM_TYPE_CURRENT_OPTION_CONTENT:
+			shm_wire_field_path_key_append_char(key,
+				SHM_WIRE_FIELD_PATH_KEY_CURRENT_OPTION_CONTENT);
+			break;
+		default:
+			bt_common_abort();
+		}
+	}
+
+	shm_wire_write_string(buf, key->str);
+	g_string_free(key, TRUE);
+}
+
+static
+void write_field_class(GByteArray *buf, const bt_field_class *fc);
+
+static
+void write_enum_mappings(GByteArray *buf, const bt_field_class *fc)
+{
+	uint64_t count = bt_field_class_enumeration_get_mapping_count(fc);
+	bool is_signed = bt_field_class_get_type(fc) ==
+		BT_FIELD_CLASS_TYPE_SIGNED_ENUMERATION;
+	uint64_t i;
+
+	shm_wire_write_uint(buf, count);
+
+	for (i = 0; i < count; i++) {
+		if (is_signed) {
+			const bt_field_class_enumeration_signed_mapping *mapping =
+				bt_field_class_enumeration_signed_borrow_mapping_by_index_const(
+					fc, i);
+
+			shm_wire_write_string(buf,
+				bt_field_class_enumeration_mapping_get_label(
+					bt_field_class_enumeration_signed_mapping_as_mapping_const(
+						mapping)));
+			write_int_range_set(buf,
+				bt_field_class_enumeration_signed_mapping_borrow_ranges_const(
+					mapping));
+		} else {
+			const bt_field_class_enumeration_unsigned_mapping *mapping =
+				bt_field_class_enumeration_unsigned_borrow_mapping_by_index_const(
+					fc, i);
+
+			shm_wire_write_string(buf,
+				bt_field_class_enumeration_mapping_get_label(
+					bt_field_class_enumeration_unsigned_mapping_as_mapping_const(
+						mapping)));
+			write_uint_range_set(buf,
+				bt_field_class_enumeration_unsigned_mapping_borrow_ranges_const(
+					mapping));
+		}
+	}
+}
+
+static
+void write_variant_options(GByteArray *buf, const bt_field_class *fc)
+{
+	bt_field_class_type type = bt_field_class_get_type(fc);
+	uint64_t count = bt_field_class_variant_get_option_count(fc);
+	uint64_t i;
+
+	shm_wire_write_uint(buf, count);
+
+	for (i = 0; i < count; i++) {
+		const bt_field_class_variant_option *option =
+			bt_field_class_variant_borrow_option_by_index_const(
+				fc, i);
+
+		shm_wire_write_string(buf,
+			bt_field_class_variant_option_get_name(option));
+		write_value(buf,
+			bt_field_class_variant_option_borrow_user_attributes_const(
+				option));
+
+		if (type == BT_FIELD_CLASS_TYPE_VARIANT_WITH_UNSIGNED_INTEGER_SELECTOR_FIELD) {
+			write_uint_range_set(buf,
+				bt_field_class_variant_with_selector_field_integer_unsigned_option_borrow_ranges_const(
+					bt_field_class_variant_with_selector_field_integer_unsigned_borrow_option_by_index_const(
+						fc, i)));
+		} else if (type == BT_FIELD_CLASS_TYPE_VARIANT_WITH_SIGNED_INTEGER_SELECTOR_FIELD) {
+			write_int_range_set(buf,
+				bt_field_class_variant_with_selector_field_integer_signed_option_borrow_ranges_const(
+					bt_field_class_variant_with_selector_field_integer_signed_borrow_option_by_index_const(
+						fc, i)));
+		}
+
+		write_field_class(buf,
+			bt_field_class_variant_option_borrow_field_class_const(
+				option));
+	}
+}
+
+/*
+ * Writes `fc`: its type, its user attributes, and then its
+ * type-specific properties, in the order in which `source.shm.ring`
+ * needs them to create it.
+ */
+static
+void write_field_class(GByteArray *buf, const bt_field_class *fc)
+{
+	bt_field_class_type type = bt_field_class_get_type(fc);
+	uint64_t i;
+
+	shm_wire_write_uint(buf, type);
+	write_value(buf, bt_field_class_borrow_user_attributes_const(fc));
+
+	switch (type) {
+	case BT_FIELD_CLASS_TYPE_BOOL:
+	case BT_FIELD_CLASS_TYPE_SINGLE_PRECISION_REAL:
+	case BT_FIELD_CLASS_TYPE_DOUBLE_PRECISION_REAL:
+	case BT_FIELD_CLASS_TYPE_STRING:
+		break;
+	case BT_FIELD_CLASS_TYPE_BIT_ARRAY:
+		shm_wire_write_uint(buf,
+			bt_field_class_bit_array_get_length(fc));
+		break;
+	case BT_FIELD_CLASS_TYPE_UNSIGNED_INTEGER:
+	case BT_FIELD_CLASS_TYPE_SIGNED_INTEGER:
+	case BT_FIELD_CLASS_TYPE_UNSIGNED_ENUMERATION:
+	case BT_FIELD_CLASS_TYPE_SIGNED_ENUMERATION:
+		shm_wire_write_uint(buf,
+			bt_field_class_integer_get_field_value_range(fc));
+		shm_wire_write_uint(buf,
+			bt_field_class_integer_get_preferred_display_base(fc));
+
+		if (bt_field_class_type_is(type,
+				BT_FIELD_CLASS_TYPE_ENUMERATION)) {
+			write_enum_mappings(buf, fc);
+		}
+
+		break;
+	case BT_FIELD_CLASS_TYPE_STRUCTURE:
+	{
+		uint64_t count = bt_field_class_structure_get_member_count(fc);
+
+		shm_wire_write_uint(buf, count);
+
+		for (i = 0; i < count; i++) {
+			const bt_field_class_structure_member *member =
+				bt_field_class_structure_borrow_member_by_index_const(
+					fc, i);
+
+			shm_wire_write_string(buf,
+				bt_field_class_structure_member_get_name(member));
+			write_value(buf,
+				bt_field_class_structure_member_borrow_user_attributes_const(
+					member));
+			write_field_class(buf,
+				bt_field_class_structure_member_borrow_field_class_const(
+					member));
+		}
+
+		break;
+	}
+	case BT_FIELD_CLASS_TYPE_STATIC_ARRAY:
+		shm_wire_write_uint(buf,
+			bt_field_class_array_static_get_length(fc));
+		write_field_class(buf,
+			bt_field_class_array_borrow_element_field_class_const(fc));
+		break;
+	case BT_FIELD_CLASS_TYPE_DYNAMIC_ARRAY_WITHOUT_LENGTH_FIELD:
+		write_field_class(buf,
+			bt_field_class_array_borrow_element_field_class_const(fc));
+		break;
+	case BT_FIELD_CLASS_TYPE_DYNAMIC_ARRAY_WITH_LENGTH_FIELD:
+		write_field_path(buf,
+			bt_field_class_array_dynamic_with_length_field_borrow_length_field_path_const(
+				fc));
+		write_field_class(buf,
+			bt_field_class_array_borrow_element_field_class_const(fc));
+		break;
+	case BT_FIELD_CLASS_TYPE_OPTION_WITHOUT_SELECTOR_FIELD:
+		write_field_class(buf,
+			bt_field_class_option_borrow_field_class_const(fc));
+		break;
+	case BT_FIELD_CLASS_TYPE_OPTION_WITH_BOOL_SELECTOR_FIELD:
+		write_field_path(buf,
+			bt_field_class_option_with_selector_field_borrow_selector_field_path_const(
+				fc));
+		shm_wire_write_bool(buf,
+			bt_field_class_option_with_selector_field_bool_selector_is_reversed(
+				fc));
+		write_field_class(buf,
+			bt_field_class_option_borrow_field_class_const(fc));
+		break;
+	case BT_FIELD_CLASS_TYPE_OPTION_WITH_UNSIGNED_INTEGER_SELECTOR_FIELD:
+		write_field_path(buf,
+			bt_field_class_option_with_selector_field_borrow_selector_field_path_const(
+				fc));
+		write_uint_range_set(buf,
+			bt_field_class_option_with_selector_field_integer_unsigned_borrow_selector_ranges_const(
+				fc));
+		write_field_class(buf,
+			bt_field_class_option_borrow_field_class_const(fc));
+		break;
+	case BT_FIELD_CLASS_TYPE_OPTION_WITH_SIGNED_INTEGER_SELECTOR_FIELD:
+		write_field_path(buf,
+			bt_field_class_option_with_selector_field_borrow_selector_field_path_const(
+				fc));
+		write_int_range_set(buf,
+			bt_field_class_option_with_selector_field_integer_signed_borrow_selector_ranges_const(
+				fc));
+		write_field_class(buf,
+			bt_field_class_option_borrow_field_class_const(fc));
+		break;
+	case BT_FIELD_CLASS_TYPE_VARIANT_WITHOUT_SELECTOR_FIELD:
+		write_variant_options(buf, fc);
+		break;
+	case BT_FIELD_CLASS_TYPE_VARIANT_WITH_UNSIGNED_INTEGER_SELECTOR_FIELD:
+	case BT_FIELD_CLASS_TYPE_VARIANT_WITH_SIGNED_INTEGER_SELECTOR_FIELD:
+		write_field_path(buf,
+			bt_field_class_variant_with_selector_field_borrow_selector_field_path_const(
+				fc));
+		write_variant_options(buf, fc);
+		break;
+	default:
+		bt_common_abort();
+	}
+}
+
+/* Writes whether or not there's a field class, and `fc` if not `NULL` */
+static
+void write_opt_field_class(GByteArray *buf, const bt_field_class *fc)
+{
+	shm_wire_write_bool(buf, fc);
+
+	if (fc) {
+		write_field_class(buf, fc);
+	}
+}
+
+static
+void write_field(GByteArray *buf, const bt_field *field)
+{
+	bt_field_class_type type = bt_field_get_class_type(field);
+	uint64_t i;
+
+	if (type == BT_FIELD_CLASS_TYPE_BOOL) {
+		shm_wire_write_bool(buf, bt_field_bool_get_value(field));
+	} else if (type == BT_FIELD_CLASS_TYPE_BIT_ARRAY) {
+		shm_wire_write_uint(buf,
+			bt_field_bit_array_get_value_as_integer(field));
+	} else if (bt_field_class_type_is(type,
+			BT_FIELD_CLASS_TYPE_UNSIGNED_INTEGER)) {
+		shm_wire_write_uint(buf,
+			bt_field_integer_unsigned_get_value(field));
+	} else if (bt_field_class_type_is(type,
+			BT_FIELD_CLASS_TYPE_SIGNED_INTEGER)) {
+		shm_wire_write_int(buf,
+			bt_field_integer_signed_get_value(field));
+	} else if (type == BT_FIELD_CLASS_TYPE_SINGLE_PRECISION_REAL) {
+		shm_wire_write_float(buf,
+			bt_field_real_single_precision_get_value(field));
+	} else if (type == BT_FIELD_CLASS_TYPE_DOUBLE_PRECISION_REAL) {
+		shm_wire_write_double(buf,
+			bt_field_real_double_precision_get_value(field));
+	} else if (type == BT_FIELD_CLASS_TYPE_STRING) {
+		uint64_t len = bt_field_string_get_length(field);
+
+		shm_wire_write_uint(buf, len + 1);
+		shm_wire_write_bytes(buf, bt_field_string_get_value(field),
+			len + 1);
+	} else if (type == BT_FIELD_CLASS_TYPE_STRUCTURE) {
+		uint64_t count = bt_field_class_structure_get_member_count(
+			bt_field_borrow_class_const(field));
+
+		for (i = 0; i < count; i++) {
+			write_field(buf,
+				bt_field_structure_borrow_member_field_by_index_const(
+					field, i));
+		}
+	} else if (bt_field_class_type_is(type, BT_FIELD_CLASS_TYPE_ARRAY)) {
+		uint64_t len = bt_field_array_get_length(field);
+
+		if (bt_field_class_type_is(type,
+				BT_FIELD_CLASS_TYPE_DYNAMIC_ARRAY)) {
+			shm_wire_write_uint(buf, len);
+		}
+
+		for (i = 0; i < len; i++) {
+			write_field(buf,
+				bt_field_array_borrow_element_field_by_index_const(
+					field, i));
+		}
+	} else if (bt_field_class_type_is(type, BT_FIELD_CLASS_TYPE_OPTION)) {
+		const bt_field *content_field =
+			bt_field_option_borrow_field_const(field);
+
+		shm_wire_write_bool(buf, content_field);
+
+		if (content_field) {
+			write_field(buf, content_field);
+		}
+	} else if (bt_field_class_type_is(type, BT_FIELD_CLASS_TYPE_VARIANT)) {
+		shm_wire_write_uint(buf,
+			bt_field_variant_get_selected_option_index(field));
+		write_field(buf,
+			bt_field_variant_borrow_selected_option_field_const(
+				field));
+	} else {
+		bt_common_abort();
+	}
+}
+
+/*
+ * Finds the handle of the metadata object `obj` of kind `kind`.
+ *
+ * Returns true if `obj` has a handle.
+ */
+static
+bool find_handle(struct shm_sink_comp *shm_sink, enum shm_wire_obj_kind kind,
+		const void *obj, uint64_t *handle)
+{
+	gpointer val;
+	bool found = g_hash_table_lookup_extended(shm_sink->handles[kind], obj,
+		NULL, &val);
+
+	if (found) {
+		*handle = GPOINTER_TO_UINT(val);
+	}
+
+	return found;
+}
+
+/*
+ * Assigns a new handle to the metadata object `obj` of kind `kind`,
+ * of which the caller gave a reference to this.
+ */
+static
+uint64_t add_handle(struct shm_sink_comp *shm_sink, enum shm_wire_obj_kind kind,
+		const void *obj)
+{
+	uint64_t handle = shm_sink->next_handles[kind]++;
+
+	g_hash_table_insert(shm_sink->handles[kind], (gpointer) obj,
+		GUINT_TO_POINTER(handle));
+	return handle;
+}
+
+static
+uint64_t register_clock_class(struct shm_sink_comp *shm_sink,
+		const bt_clock_class *cc)
+{
+	GByteArray *buf = shm_sink->buf;
+	uint64_t handle;
+	int64_t offset_seconds;
+	uint64_t offset_cycles;
+
+	if (find_handle(shm_sink, SHM_WIRE_OBJ_KIND_CLOCK_CLASS, cc, &handle)) {
+		goto end;
+	}
+
+	bt_clock_class_get_ref(cc);
+	handle = add_handle(shm_sink, SHM_WIRE_OBJ_KIND_CLOCK_CLASS, cc);
+	bt_clock_class_get_offset(cc, &offset_seconds, &offset_cycles);
+	shm_wire_write_uint(buf, SHM_WIRE_RECORD_TYPE_CLOCK_CLASS);
+	shm_wire_write_uint(buf, handle);
+	shm_wire_write_string(buf, bt_clock_class_get_name(cc));
+	shm_wire_write_string(buf, bt_clock_class_get_description(cc));
+	shm_wire_write_uint(buf, bt_clock_class_get_frequency(cc));
+	shm_wire_write_uint(buf, bt_clock_class_get_precision(cc));
+	shm_wire_write_int(buf, offset_seconds);
+	shm_wire_write_uint(buf, offset_cycles);
+	shm_wire_write_bool(buf, bt_clock_class_origin_is_unix_epoch(cc));
+	shm_wire_write_uuid(buf, bt_clock_class_get_uuid(cc));
+	write_value(buf, bt_clock_class_borrow_user_attributes_const(cc));
+
+end:
+	return handle;
+}
+
+static
+uint64_t register_event_class(struct shm_sink_comp *shm_sink,
+		uint64_t sc_handle, const bt_event_class *ec)
+{
+	GByteArray *buf = shm_sink->buf;
+	uint64_t handle;
+	bt_event_class_log_level log_level;
+	bt_property_availability log_level_avail;
+
+	if (find_handle(shm_sink, SHM_WIRE_OBJ_KIND_EVENT_CLASS, ec, &handle)) {
+		goto end;
+	}
+
+	bt_event_class_get_ref(ec);
+	handle = add_handle(shm_sink, SHM_WIRE_OBJ_KIND_EVENT_CLASS, ec);
+	log_level_avail = bt_event_class_get_log_level(ec, &log_level);
+	shm_wire_write_uint(buf, SHM_WIRE_RECORD_TYPE_EVENT_CLASS);
+	shm_wire_write_uint(buf, handle);
+	shm_wire_write_uint(buf, sc_handle);
+	shm_wire_write_uint(buf, bt_event_class_get_id(ec));
+	shm_wire_write_string(buf, bt_event_class_get_name(ec));
+	shm_wire_write_bool(buf,
+		log_level_avail == BT_PROPERTY_AVAILABILITY_AVAILABLE);
+
+	if (log_level_avail == BT_PROPERTY_AVAILABILITY_AVAILABLE) {
+		shm_wire_write_uint(buf, log_level);
+	}
+
+	shm_wire_write_string(buf, bt_event_class_get_emf_uri(ec));
+	write_opt_field_class(buf,
+		bt_event_class_borrow_specific_context_field_class_const(ec));
+	write_opt_field_class(buf,
+		bt_event_class_borrow_payload_field_class_const(ec));
+	write_value(buf, bt_event_class_borrow_user_attributes_const(ec));
+
+end:
+	return handle;
+}
+
+static
+uint64_t register_stream_class(struct shm_sink_comp *shm_sink,
+		uint64_t tc_handle, const bt_stream_class *sc)
+{
+	GByteArray *buf = shm_sink->buf;
+	const bt_clock_class *cc;
+	uint64_t cc_handle = 0;
+	uint64_t handle;
+
+	if (find_handle(shm_sink, SHM_WIRE_OBJ_KIND_STREAM_CLASS, sc,
+			&handle)) {
+		goto end;
+	}
+
+	/* The clock class record must precede the stream class record */
+	cc = bt_stream_class_borrow_default_clock_class_const(sc);
+	if (cc) {
+		cc_handle = register_clock_class(shm_sink, cc);
+	}
+
+	bt_stream_class_get_ref(sc);
+	handle = add_handle(shm_sink, SHM_WIRE_OBJ_KIND_STREAM_CLASS, sc);
+	shm_wire_write_uint(buf, SHM_WIRE_RECORD_TYPE_STREAM_CLASS);
+	shm_wire_write_uint(buf, handle);
+	shm_wire_write_uint(buf, tc_handle);
+	shm_wire_write_uint(buf, bt_stream_class_get_id(sc));
+	shm_wire_write_string(buf, bt_stream_class_get_name(sc));
+	shm_wire_write_bool(buf,
+		bt_stream_class_assigns_automatic_event_class_id(sc));
+	shm_wire_write_bool(buf,
+		bt_stream_class_assigns_automatic_stream_id(sc));
+
+	/* Default clock class handle plus one, or 0 for none */
+	shm_wire_write_uint(buf, cc ? cc_handle + 1 : 0);
+	shm_wire_write_bool(buf, bt_stream_class_supports_packets(sc));
+	shm_wire_write_bool(buf,
+		bt_stream_class_packets_have_beginning_default_clock_snapshot(sc));
+	shm_wire_write_bool(buf,
+		bt_stream_class_packets_have_end_default_clock_snapshot(sc));
+	shm_wire_write_bool(buf, bt_stream_class_supports_discarded_events(sc));
+	shm_wire_write_bool(buf,
+		bt_stream_class_discarded_events_have_default_clock_snapshots(sc));
+	shm_wire_write_bool(buf, bt_stream_class_supports_discarded_packets(sc));
+	shm_wire_write_bool(buf,
+		bt_stream_class_discarded_packets_have_default_clock_snapshots(sc));
+	write_opt_field_class(buf,
+		bt_stream_class_borrow_packet_context_field_class_const(sc));
+	write_opt_field_class(buf,
+		bt_stream_class_borrow_event_common_context_field_class_const(sc));
+	write_value(buf, bt_stream_class_borrow_user_attributes_const(sc));
+
+end:
+	return handle;
+}
+
+/*
+ * Registers the trace class `tc` as well as all its stream classes and
+ * their event classes which are not registered yet, in index order.
+ *
+ * Registering them in index order makes `source.shm.ring` create them
+ * in the same order, which matters for the classes of which the parent
+ * assigns automatic IDs.
+ */
+static
+uint64_t register_trace_class(struct shm_sink_comp *shm_sink,
+		const bt_trace_class *tc)
+{
+	GByteArray *buf = shm_sink->buf;
+	uint64_t handle;
+	uint64_t i;
+
+	if (!find_handle(shm_sink, SHM_WIRE_OBJ_KIND_TRACE_CLASS, tc,
+			&handle)) {
+		bt_trace_class_get_ref(tc);
+		handle = add_handle(shm_sink, SHM_WIRE_OBJ_KIND_TRACE_CLASS,
+			tc);
+		shm_wire_write_uint(buf, SHM_WIRE_RECORD_TYPE_TRACE_CLASS);
+		shm_wire_write_uint(buf, handle);
+		shm_wire_write_bool(buf,
+			bt_trace_class_assigns_automatic_stream_class_id(tc));
+		write_value(buf,
+			bt_trace_class_borrow_user_attributes_const(tc));
+	}
+
+	for (i = 0; i < bt_trace_class_get_stream_class_count(tc); i++) {
+		const bt_stream_class *sc =
+			bt_trace_class_borrow_stream_class_by_index_const(tc, i);
+		uint64_t sc_handle = register_stream_class(shm_sink, handle,
+			sc);
+		uint64_t j;
+
+		for (j = 0; j < bt_stream_class_get_event_class_count(sc); j++) {
+			register_event_class(shm_sink, sc_handle,
+				bt_stream_class_borrow_event_class_by_index_const(
+					sc, j));
+		}
+	}
+
+	return handle;
+}
+
+static
+uint64_t register_trace(struct shm_sink_comp *shm_sink,
+		const bt_trace *trace)
+{
+	GByteArray *buf = shm_sink->buf;
+	uint64_t tc_handle;
+	uint64_t handle;
+	uint64_t count;
+	uint64_t i;
+
+	if (find_handle(shm_sink, SHM_WIRE_OBJ_KIND_TRACE, trace, &handle)) {
+		goto end;
+	}
+
+	tc_handle = register_trace_class(shm_sink,
+		bt_trace_borrow_class_const(trace));
+	bt_trace_get_ref(trace);
+	handle = add_handle(shm_sink, SHM_WIRE_OBJ_KIND_TRACE, trace);
+	shm_wire_write_uint(buf, SHM_WIRE_RECORD_TYPE_TRACE);
+	shm_wire_write_uint(buf, handle);
+	shm_wire_write_uint(buf, tc_handle);
+	shm_wire_write_string(buf, bt_trace_get_name(trace));
+	shm_wire_write_uuid(buf, bt_trace_get_uuid(trace));
+	count = bt_trace_get_environment_entry_count(trace);
+	shm_wire_write_uint(buf, count);
+
+	for (i = 0; i < count; i++) {
+		const char *name;
+		const bt_value *val;
+
+		bt_trace_borrow_environment_entry_by_index_const(trace, i,
+			&name, &val);
+		shm_wire_write_string(buf, name);
+		write_value(buf, val);
+	}
+
+	write_value(buf, bt_trace_borrow_user_attributes_const(trace));
+
+end:
+	return handle;
+}
+
+/*
+ * Returns the handle of `stream`, registering it as well as its trace,
+ * trace class, and stream class first if needed.
+ */
+static
+uint64_t register_stream(struct shm_sink_comp *shm_sink,
+		const bt_stream *stream)
+{
+	GByteArray *buf = shm_sink->buf;
+	const bt_trace *trace = bt_stream_borrow_trace_const(stream);
+	uint64_t trace_handle;
+	uint64_t tc_handle;
+	uint64_t sc_handle;
+	uint64_t handle;
+
+	if (find_handle(shm_sink, SHM_WIRE_OBJ_KIND_STREAM, stream, &handle)) {
+		goto end;
+	}
+
+	/*
+	 * The trace class can have new stream classes since this
+	 * registered it.
+	 */
+	tc_handle = register_trace_class(shm_sink,
+		bt_trace_borrow_class_const(trace));
+	trace_handle = register_trace(shm_sink, trace);
+	sc_handle = register_stream_class(shm_sink, tc_handle,
+		bt_stream_borrow_class_const(stream));
+	bt_stream_get_ref(stream);
+	handle = add_handle(shm_sink, SHM_WIRE_OBJ_KIND_STREAM, stream);
+	shm_wire_write_uint(buf, SHM_WIRE_RECORD_TYPE_STREAM);
+	shm_wire_write_uint(buf, handle);
+	shm_wire_write_uint(buf, sc_handle);
+	shm_wire_write_uint(buf, trace_handle);
+	shm_wire_write_uint(buf, bt_stream_get_id(stream));
+	shm_wire_write_string(buf, bt_stream_get_name(stream));
+	write_value(buf, bt_stream_borrow_user_attributes_const(stream));
+
+end:
+	return handle;
+}
+
+/*
+ * Returns the handle of `ec`, registering the new classes of its trace
+ * class first if needed (the producer can add event classes to a
+ * stream class at any time).
+ */
+static
+uint64_t register_event_class_of_event(struct shm_sink_comp *shm_sink,
+		const bt_event_class *ec)
+{
+	uint64_t handle;
+
+	if (!find_handle(shm_sink, SHM_WIRE_OBJ_KIND_EVENT_CLASS, ec,
+			&handle)) {
+		(void) register_trace_class(shm_sink,
+			bt_stream_class_borrow_trace_class_const(
+				bt_event_class_borrow_stream_class_const(ec)));
+		(void) find_handle(shm_sink, SHM_WIRE_OBJ_KIND_EVENT_CLASS, ec,
+			&handle);
+	}
+
+	return handle;
+}
+
+static
+void write_clock_snapshot(GByteArray *buf, const bt_clock_snapshot *cs)
+{
+	shm_wire_write_uint(buf, bt_clock_snapshot_get_value(cs));
+}
+
+static
+void write_stream_clock_snapshot(GByteArray *buf,
+		bt_message_stream_clock_snapshot_state state,
+		const bt_clock_snapshot *cs)
+{
+	bool is_known = state == BT_MESSAGE_STREAM_CLOCK_SNAPSHOT_STATE_KNOWN;
+
+	shm_wire_write_bool(buf, is_known);
+
+	if (is_known) {
+		write_clock_snapshot(buf, cs);
+	}
+}
+
+/* Appends the wire records of `msg` to the buffer of `shm_sink` */
+static
+void write_msg(struct shm_sink_comp *shm_sink, const bt_message *msg)
+{
+	GByteArray *buf = shm_sink->buf;
+	const bt_stream *stream;
+	const bt_stream_class *sc;
+	const bt_clock_snapshot *cs;
+	uint64_t stream_handle;
+	size_t msg_end_offset;
+
+	switch (bt_message_get_type(msg)) {
+	case BT_MESSAGE_TYPE_EVENT:
+	{
+		const bt_event *event = bt_message_event_borrow_event_const(msg);
+		const bt_event_class *ec = bt_event_borrow_class_const(event);
+		const bt_field *field;
+		uint64_t ec_handle;
+
+		stream = bt_event_borrow_stream_const(event);
+		sc = bt_stream_borrow_class_const(stream);
+		stream_handle = register_stream(shm_sink, stream);
+		ec_handle = register_event_class_of_event(shm_sink, ec);
+		shm_wire_write_uint(buf, SHM_WIRE_RECORD_TYPE_EVENT);
+		shm_wire_write_uint(buf, stream_handle);
+		shm_wire_write_uint(buf, ec_handle);
+
+		if (bt_stream_class_borrow_default_clock_class_const(sc)) {
+			write_clock_snapshot(buf,
+				bt_message_event_borrow_default_clock_snapshot_const(
+					msg));
+		}
+
+		field = bt_event_borrow_common_context_field_const(event);
+		if (field) {
+			write_field(buf, field);
+		}
+
+		field = bt_event_borrow_specific_context_field_const(event);
+		if (field) {
+			write_field(buf, field);
+		}
+
+		field = bt_event_borrow_payload_field_const(event);
+		if (field) {
+			write_field(buf, field);
+		}
+
+		break;
+	}
+	case BT_MESSAGE_TYPE_STREAM_BEGINNING:
+	{
+		bt_message_stream_clock_snapshot_state cs_state;
+
+		stream = bt_message_stream_beginning_borrow_stream_const(msg);
+		sc = bt_stream_borrow_class_const(stream);
+		stream_handle = register_stream(shm_sink, stream);
+		shm_wire_write_uint(buf, SHM_WIRE_RECORD_TYPE_STREAM_BEGINNING);
+		shm_wire_write_uint(buf, stream_handle);
+
+		if (bt_stream_class_borrow_default_clock_class_const(sc)) {
+			cs_state = bt_message_stream_beginning_borrow_default_clock_snapshot_const(
+				msg, &cs);
+			write_stream_clock_snapshot(buf, cs_state, cs);
+		}
+
+		break;
+	}
+	case BT_MESSAGE_TYPE_STREAM_END:
+	{
+		bt_message_stream_clock_snapshot_state cs_state;
+
+		stream = bt_message_stream_end_borrow_stream_const(msg);
+		sc = bt_stream_borrow_class_const(stream);
+		stream_handle = register_stream(shm_sink, stream);
+		shm_wire_write_uint(buf, SHM_WIRE_RECORD_TYPE_STREAM_END);
+		shm_wire_write_uint(buf, stream_handle);
+
+		if (bt_stream_class_borrow_default_clock_class_const(sc)) {
+			cs_state = bt_message_stream_end_borrow_default_clock_snapshot_const(
+				msg, &cs);
+			write_stream_clock_snapshot(buf, cs_state, cs);
+		}
+
+		/* The stream handle is not valid anymore */
+		g_hash_table_remove(shm_sink->handles[SHM_WIRE_OBJ_KIND_STREAM],
+			stream);
+		break;
+	}
+	case BT_MESSAGE_TYPE_PACKET_BEGINNING:
+	{
+		const bt_packet *packet =
+			bt_message_packet_beginning_borrow_packet_const(msg);
+		const bt_field *ctx_field =
+			bt_packet_borrow_context_field_const(packet);
+
+		stream = bt_packet_borrow_stream_const(packet);
+		sc = bt_stream_borrow_class_const(stream);
+		stream_handle = register_stream(shm_sink, stream);
+		shm_wire_write_uint(buf, SHM_WIRE_RECORD_TYPE_PACKET_BEGINNING);
+		shm_wire_write_uint(buf, stream_handle);
+
+		if (bt_stream_class_packets_have_beginning_default_clock_snapshot(sc)) {
+			write_clock_snapshot(buf,
+				bt_message_packet_beginning_borrow_default_clock_snapshot_const(
+					msg));
+		}
+
+		if (ctx_field) {
+			write_field(buf, ctx_field);
+		}
+
+		break;
+	}
+	case BT_MESSAGE_TYPE_PACKET_END:
+		stream = bt_packet_borrow_stream_const(
+			bt_message_packet_end_borrow_packet_const(msg));
+		sc = bt_stream_borrow_class_const(stream);
+		stream_handle = register_stream(shm_sink, stream);
+		shm_wire_write_uint(buf, SHM_WIRE_RECORD_TYPE_PACKET_END);
+		shm_wire_write_uint(buf, stream_handle);
+
+		if (bt_stream_class_packets_have_end_default_clock_snapshot(sc)) {
+			write_clock_snapshot(buf,
+				bt_message_packet_end_borrow_default_clock_snapshot_const(
+					msg));
+		}
+
+		break;
+	case BT_MESSAGE_TYPE_DISCARDED_EVENTS:
+	{
+		uint64_t count;
+		bt_property_availability count_avail;
+
+		stream = bt_message_discarded_events_borrow_stream_const(msg);
+		sc = bt_stream_borrow_class_const(stream);
+		stream_handle = register_stream(shm_sink, stream);
+		shm_wire_write_uint(buf, SHM_WIRE_RECORD_TYPE_DISCARDED_EVENTS);
+		shm_wire_write_uint(buf, stream_handle);
+
+		if (bt_stream_class_discarded_events_have_default_clock_snapshots(sc)) {
+			write_clock_snapshot(buf,
+				bt_message_discarded_events_borrow_beginning_default_clock_snapshot_const(
+					msg));
+			write_clock_snapshot(buf,
+				bt_message_discarded_events_borrow_end_default_clock_snapshot_const(
+					msg));
+		}
+
+		count_avail = bt_message_discarded_events_get_count(msg, &count);
+		shm_wire_write_bool(buf,
+			count_avail == BT_PROPERTY_AVAILABILITY_AVAILABLE);
+
+		if (count_avail == BT_PROPERTY_AVAILABILITY_AVAILABLE) {
+			shm_wire_write_uint(buf, count);
+		}
+
+		break;
+	}
+	case BT_MESSAGE_TYPE_DISCARDED_PACKETS:
+	{
+		uint64_t count;
+		bt_property_availability count_avail;
+
+		stream = bt_message_discarded_packets_borrow_stream_const(msg);
+		sc = bt_stream_borrow_class_const(stream);
+		stream_handle = register_stream(shm_sink, stream);
+		shm_wire_write_uint(buf, SHM_WIRE_RECORD_TYPE_DISCARDED_PACKETS);
+		shm_wire_write_uint(buf, stream_handle);
+
+		if (bt_stream_class_discarded_packets_have_default_clock_snapshots(sc)) {
+			write_clock_snapshot(buf,
+				bt_message_discarded_packets_borrow_beginning_default_clock_snapshot_const(
+					msg));
+			write_clock_snapshot(buf,
+				bt_message_discarded_packets_borrow_end_default_clock_snapshot_const(
+					msg));
+		}
+
+		count_avail = bt_message_discarded_packets_get_count(msg, &count);
+		shm_wire_write_bool(buf,
+			count_avail == BT_PROPERTY_AVAILABILITY_AVAILABLE);
+
+		if (count_avail == BT_PROPERTY_AVAILABILITY_AVAILABLE) {
+			shm_wire_write_uint(buf, count);
+		}
+
+		break;
+	}
+	case BT_MESSAGE_TYPE_MESSAGE_ITERATOR_INACTIVITY:
+	{
+		uint64_t cc_handle;
+
+		cs = bt_message_message_iterator_inactivity_borrow_clock_snapshot_const(
+			msg);
+		cc_handle = register_clock_class(shm_sink,
+			bt_clock_snapshot_borrow_clock_class_const(cs));
+		shm_wire_write_uint(buf,
+			SHM_WIRE_RECORD_TYPE_MSG_ITER_INACTIVITY);
+		shm_wire_write_uint(buf, cc_handle);
+		write_clock_snapshot(buf, cs);
+		break;
+	}
+	default:
+		bt_common_abort();
+	}
+
+	msg_end_offset = buf->len;
+	g_array_append_val(shm_sink->msg_end_offsets, msg_end_offset);
+}
+
+/*
+ * Writes the pending wire records of `shm_sink` to its ring, as one or
+ * more ring records.
+ *
+ * Returns `BT_COMPONENT_CLASS_SINK_CONSUME_METHOD_STATUS_AGAIN`, keeping
+ * the remaining wire records, if the ring has no room for them after
+ * `WRITE_TIMEOUT_US` µs.
+ */
+static
+bt_component_class_sink_consume_method_status flush(
+		struct shm_sink_comp *shm_sink)
+{
+	bt_component_class_sink_consume_method_status status =
+		BT_COMPONENT_CLASS_SINK_CONSUME_METHOD_STATUS_OK;
+	GArray *offsets = shm_sink->msg_end_offsets;
+	uint64_t max_record_size = shm_sink->ring.header->capacity -
+		sizeof(uint32_t);
+	guint next_offset_index = 0;
+
+	while (shm_sink->flushed_size < shm_sink->buf->len) {
+		size_t record_end = 0;
+		enum shm_ring_status ring_status;
+
+		/*
+		 * Find the largest sequence of whole messages which fits
+		 * in a single ring record.
+		 */
+		while (next_offset_index < offsets->len) {
+			size_t offset = g_array_index(offsets, size_t,
+				next_offset_index);
+
+			if (offset <= shm_sink->flushed_size) {
+				next_offset_index++;
+				continue;
+			}
+
+			if (offset - shm_sink->flushed_size > max_record_size) {
+				break;
+			}
+
+			record_end = offset;
+			next_offset_index++;
+		}
+
+		if (record_end == 0) {
+			BT_COMP_LOGE_APPEND_CAUSE(shm_sink->self_comp,
+				"Encoded message is larger than the shared memory ring: "
+				"capacity=%" PRIu64 ", ring-name=\"%s\"",
+				shm_sink->ring.header->capacity,
+				shm_sink->ring.name->str);
+			status = BT_COMPONENT_CLASS_SINK_CONSUME_METHOD_STATUS_ERROR;
+			goto end;
+		}
+
+		ring_status = shm_ring_write(&shm_sink->ring,
+			&shm_sink->buf->data[shm_sink->flushed_size],
+			record_end - shm_sink->flushed_size, WRITE_TIMEOUT_US);
+		switch (ring_status) {
+		case SHM_RING_STATUS_OK:
+			shm_sink->flushed_size = record_end;
+			break;
+		case SHM_RING_STATUS_AGAIN:
+			BT_COMP_LOGD("Shared memory ring is full: "
+				"ring-name=\"%s\", pending-size=%zu",
+				shm_sink->ring.name->str,
+				(size_t) (shm_sink->buf->len -
+					shm_sink->flushed_size));
+			status = BT_COMPONENT_CLASS_SINK_CONSUME_METHOD_STATUS_AGAIN;
+			goto end;
+		case SHM_RING_STATUS_DETACHED:
+			BT_COMP_LOGE_APPEND_CAUSE(shm_sink->self_comp,
+				"Consumer detached from the shared memory ring: "
+				"ring-name=\"%s\"", shm_sink->ring.name->str);
+			status = BT_COMPONENT_CLASS_SINK_CONSUME_METHOD_STATUS_ERROR;
+			goto end;
+		default:
+			BT_COMP_LOGE_APPEND_CAUSE(shm_sink->self_comp,
+				"Cannot write to the shared memory ring: "
+				"ring-name=\"%s\", status=%s",
+				shm_sink->ring.name->str,
+				shm_ring_status_string(ring_status));
+			status = BT_COMPONENT_CLASS_SINK_CONSUME_METHOD_STATUS_ERROR;
+			goto end;
+		}
+	}
+
+	/* Everything is written */
+	g_byte_array_set_size(shm_sink->buf, 0);
+	g_array_set_size(offsets, 0);
+	shm_sink->flushed_size = 0;
+
+end:
+	return status;
+}
+
+static
+void destroy_shm_sink_data(struct shm_sink_comp *shm_sink)
+{
+	unsigned int i;
+
+	if (!shm_sink) {
+		goto end;
+	}
+
+	if (shm_sink->ring_is_attached) {
+		shm_ring_detach(&shm_sink->ring);
+	}
+
+	for (i = 0; i < SHM_WIRE_OBJ_KIND_COUNT; i++) {
+		if (shm_sink->handles[i]) {
+			g_hash_table_destroy(shm_sink->handles[i]);
+		}
+	}
+
+	if (shm_sink->buf) {
+		g_byte_array_free(shm_sink->buf, TRUE);
+	}
+
+	if (shm_sink->msg_end_offsets) {
+		g_array_free(shm_sink->msg_end_offsets, TRUE);
+	}
+
+	BT_MESSAGE_ITERATOR_PUT_REF_AND_RESET(shm_sink->upstream_iter);
+	g_free(shm_sink);
+
+end:
+	return;
+}
+
+static
+struct bt_param_validation_map_value_entry_descr shm_sink_params[] = {
+	{ "name", BT_PARAM_VALIDATION_MAP_VALUE_ENTRY_MANDATORY, { .type = BT_VALUE_TYPE_STRING } },
+	{ "size", BT_PARAM_VALIDATION_MAP_VALUE_ENTRY_OPTIONAL, { .type = BT_VALUE_TYPE_UNSIGNED_INTEGER } },
+	BT_PARAM_VALIDATION_MAP_VALUE_ENTRY_END
+};
+
+BT_HIDDEN
+bt_component_class_initialize_method_status shm_sink_init(
+		bt_self_component_sink *self_comp_sink,
+		__attribute__((unused)) bt_self_component_sink_configuration *config,
+		const bt_value *params,
+		__attribute__((unused)) void *init_method_data)
+{
+	bt_component_class_initialize_method_status status;
+	bt_self_component_add_port_status add_port_status;
+	bt_self_component *self_comp =
+		bt_self_component_sink_as_self_component(self_comp_sink);
+	struct shm_sink_comp *shm_sink = g_new0(struct shm_sink_comp, 1);
+	enum bt_param_validation_status validation_status;
+	gchar *validate_error = NULL;
+	const bt_value *val;
+	uint64_t size = SHM_RING_DEFAULT_SIZE;
+	static GDestroyNotify put_ref_funcs[SHM_WIRE_OBJ_KIND_COUNT] = {
+		[SHM_WIRE_OBJ_KIND_CLOCK_CLASS] =
+			(GDestroyNotify) bt_clock_class_put_ref,
+		[SHM_WIRE_OBJ_KIND_TRACE_CLASS] =
+			(GDestroyNotify) bt_trace_class_put_ref,
+		[SHM_WIRE_OBJ_KIND_TRACE] = (GDestroyNotify) bt_trace_put_ref,
+		[SHM_WIRE_OBJ_KIND_STREAM_CLASS] =
+			(GDestroyNotify) bt_stream_class_put_ref,
+		[SHM_WIRE_OBJ_KIND_EVENT_CLASS] =
+			(GDestroyNotify) bt_event_class_put_ref,
+		[SHM_WIRE_OBJ_KIND_STREAM] = (GDestroyNotify) bt_stream_put_ref,
+	};
+	unsigned int i;
+
+	if (!shm_sink) {
+		BT_COMP_LOG_CUR_LVL(BT_LOG_ERROR,
+			bt_component_get_logging_level(
+				bt_self_component_as_component(self_comp)),
+			self_comp,
+			"Failed to allocate one shared memory sink structure.");
+		status = BT_COMPONENT_CLASS_INITIALIZE_METHOD_STATUS_MEMORY_ERROR;
+		goto end;
+	}
+
+	shm_sink->log_level = bt_component_get_logging_level(
+		bt_self_component_as_component(self_comp));
+	shm_sink->self_comp = self_comp;
+	shm_sink->self_comp_sink = self_comp_sink;
+
+	validation_status = bt_param_validation_validate(params,
+		shm_sink_params, &validate_error);
+	if (validation_status == BT_PARAM_VALIDATION_STATUS_MEMORY_ERROR) {
+		status = BT_COMPONENT_CLASS_INITIALIZE_METHOD_STATUS_MEMORY_ERROR;
+		goto error;
+	} else if (validation_status == BT_PARAM_VALIDATION_STATUS_VALIDATION_ERROR) {
+		status = BT_COMPONENT_CLASS_INITIALIZE_METHOD_STATUS_ERROR;
+		BT_COMP_LOGE_APPEND_CAUSE(self_comp, "%s", validate_error);
+		goto error;
+	}
+
+	shm_sink->buf = g_byte_array_new();
+	shm_sink->msg_end_offsets = g_array_new(FALSE, FALSE, sizeof(size_t));
+	if (!shm_sink->buf || !shm_sink->msg_end_offsets) {
+		BT_COMP_LOGE_APPEND_CAUSE(self_comp,
+			"Failed to allocate buffers.");
+		status = BT_COMPONENT_CLASS_INITIALIZE_METHOD_STATUS_MEMORY_ERROR;
+		goto error;
+	}
+
+	for (i = 0; i < SHM_WIRE_OBJ_KIND_COUNT; i++) {
+		shm_sink->handles[i] = g_hash_table_new_full(g_direct_hash,
+			g_direct_equal, put_ref_funcs[i], NULL);
+		if (!shm_sink->handles[i]) {
+			BT_COMP_LOGE_APPEND_CAUSE(self_comp,
+				"Failed to allocate a GHashTable.");
+			status = BT_COMPONENT_CLASS_INITIALIZE_METHOD_STATUS_MEMORY_ERROR;
+			goto error;
+		}
+	}
+
+	val = bt_value_map_borrow_entry_value_const(params, "size");
+	if (val) {
+		size = bt_value_integer_unsigned_get(val);
+	}
+
+	val = bt_value_map_borrow_entry_value_const(params, "name");
+	if (shm_ring_attach(&shm_sink->ring, bt_value_string_get(val), size,
+			SHM_RING_ROLE_PRODUCER, shm_sink->log_level, self_comp)) {
+		BT_COMP_LOGE_APPEND_CAUSE(self_comp,
+			"Cannot attach to shared memory ring: name=\"%s\"",
+			bt_value_string_get(val));
+		status = BT_COMPONENT_CLASS_INITIALIZE_METHOD_STATUS_ERROR;
+		goto error;
+	}
+
+	shm_sink->ring_is_attached = true;
+
+	add_port_status = bt_self_component_sink_add_input_port(self_comp_sink,
+		in_port_name, NULL, NULL);
+	if (add_port_status != BT_SELF_COMPONENT_ADD_PORT_STATUS_OK) {
+		status = (int) add_port_status;
+		goto error;
+	}
+
+	bt_self_component_set_data(self_comp, shm_sink);
+	status = BT_COMPONENT_CLASS_INITIALIZE_METHOD_STATUS_OK;
+	goto end;
+
+error:
+	destroy_shm_sink_data(shm_sink);
+
+end:
+	g_free(validate_error);
+	return status;
+}
+
+BT_HIDDEN
+void shm_sink_finalize(bt_self_component_sink *self_comp_sink)
+{
+	struct shm_sink_comp *shm_sink = bt_self_component_get_data(
+		bt_self_component_sink_as_self_component(self_comp_sink));
+
+	destroy_shm_sink_data(shm_sink);
+}
+
+BT_HIDDEN
+bt_component_class_sink_graph_is_configured_method_status
+shm_sink_graph_is_configured(bt_self_component_sink *self_comp_sink)
+{
+	bt_component_class_sink_graph_is_configured_method_status status;
+	bt_message_iterator_create_from_sink_component_status
+		msg_iter_status;
+	struct shm_sink_comp *shm_sink = bt_self_component_get_data(
+		bt_self_component_sink_as_self_component(self_comp_sink));
+
+	msg_iter_status = bt_message_iterator_create_from_sink_component(
+		self_comp_sink,
+		bt_self_component_sink_borrow_input_port_by_name(
+			self_comp_sink, in_port_name),
+		&shm_sink->upstream_iter);
+	if (msg_iter_status != BT_MESSAGE_ITERATOR_CREATE_FROM_SINK_COMPONENT_STATUS_OK) {
+		BT_COMP_LOGE_APPEND_CAUSE(shm_sink->self_comp,
+			"Failed to create upstream iterator.");
+		status = (int) msg_iter_status;
+		goto end;
+	}
+
+	status = BT_COMPONENT_CLASS_SINK_GRAPH_IS_CONFIGURED_METHOD_STATUS_OK;
+
+end:
+	return status;
+}
+
+BT_HIDDEN
+bt_component_class_sink_consume_method_status shm_sink_consume(
+		bt_self_component_sink *self_comp_sink)
+{
+	bt_component_class_sink_consume_method_status status;
+	struct shm_sink_comp *shm_sink = bt_self_component_get_data(
+		bt_self_component_sink_as_self_component(self_comp_sink));
+	bt_message_iterator_next_status next_status;
+	bt_message_array_const msgs;
+	uint64_t msg_count;
+	uint64_t i;
+
+	BT_ASSERT_DBG(shm_sink);
+
+	/* Write what's left from the previous call first */
+	status = flush(shm_sink);
+	if (status != BT_COMPONENT_CLASS_SINK_CONSUME_METHOD_STATUS_OK) {
+		goto end;
+	}
+
+	if (shm_sink->upstream_ended) {
+		status = BT_COMPONENT_CLASS_SINK_CONSUME_METHOD_STATUS_END;
+		goto end;
+	}
+
+	next_status = bt_message_iterator_next(shm_sink->upstream_iter,
+		&msgs, &msg_count);
+	switch (next_status) {
+	case BT_MESSAGE_ITERATOR_NEXT_STATUS_OK:
+		for (i = 0; i < msg_count; i++) {
+			write_msg(shm_sink, msgs[i]);
+			bt_message_put_ref(msgs[i]);
+		}
+
+		break;
+	case BT_MESSAGE_ITERATOR_NEXT_STATUS_END:
+	{
+		size_t msg_end_offset;
+
+		shm_wire_write_uint(shm_sink->buf, SHM_WIRE_RECORD_TYPE_END);
+		msg_end_offset = shm_sink->buf->len;
+		g_array_append_val(shm_sink->msg_end_offsets, msg_end_offset);
+		shm_sink->upstream_ended = true;
+		BT_MESSAGE_ITERATOR_PUT_REF_AND_RESET(shm_sink->upstream_iter);
+		break;
+	}
+	case BT_MESSAGE_ITERATOR_NEXT_STATUS_AGAIN:
+		status = BT_COMPONENT_CLASS_SINK_CONSUME_METHOD_STATUS_AGAIN;
+		goto end;
+	case BT_MESSAGE_ITERATOR_NEXT_STATUS_MEMORY_ERROR:
+		status = BT_COMPONENT_CLASS_SINK_CONSUME_METHOD_STATUS_MEMORY_ERROR;
+		goto end;
+	case BT_MESSAGE_ITERATOR_NEXT_STATUS_ERROR:
+		status = BT_COMPONENT_CLASS_SINK_CONSUME_METHOD_STATUS_ERROR;
+		goto end;
+	default:
+		bt_common_abort();
+	}
+
+	status = flush(shm_sink);
+	if (status == BT_COMPONENT_CLASS_SINK_CONSUME_METHOD_STATUS_OK &&
+			shm_sink->upstream_ended) {
+		status = BT_COMPONENT_CLASS_SINK_CONSUME_METHOD_STATUS_END;
+	}
+
+end:
+	return status;
+}
@@ -0,0 +1,93 @@
+#ifndef BABELTRACE_PLUGINS_SHM_SHM_SINK_H
+#define BABELTRACE_PLUGINS_SHM_SHM_SINK_H
+
+/*
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <glib.h>
+#include <babeltrace2/babeltrace.h>
+#include "common/macros.h"
+
+#include "ring.h"
+#include "wire.h"
+
+struct shm_sink_comp {
+	bt_logging_level log_level;
+
+	/* Weak */
+	bt_self_component *self_comp;
+
+	/* Weak */
+	bt_self_component_sink *self_comp_sink;
+
+	/* Owned by this */
+	bt_message_iterator *upstream_iter;
+
+	struct shm_ring ring;
+	bool ring_is_attached;
+
+	/*
+	 * Encoded wire records which are not written to the ring yet,
+	 * starting at `flushed_size`.
+	 */
+	GByteArray *buf;
+	size_t flushed_size;
+
+	/*
+	 * Offsets, within `buf`, of the ends of the encoded messages
+	 * (`size_t`): this component splits `buf` into ring records at
+	 * those offsets when it is too large for a single ring record.
+	 */
+	GArray *msg_end_offsets;
+
+	/*
+	 * Metadata object (owned by this) to handle
+	 * (`GUINT_TO_POINTER(handle)`), one table per
+	 * `enum shm_wire_obj_kind`.
+	 */
+	GHashTable *handles[SHM_WIRE_OBJ_KIND_COUNT];
+
+	/* Next handle to assign, one per `enum shm_wire_obj_kind` */
+	uint64_t next_handles[SHM_WIRE_OBJ_KIND_COUNT];
+
+	/* True once the upstream message iterator ended */
+	bool upstream_ended;
+};
+
+BT_HIDDEN
+bt_component_class_initialize_method_status shm_sink_init(
+		bt_self_component_sink *self_comp,
+		bt_self_component_sink_configuration *config,
+		const bt_value *params, void *init_method_data);
+
+BT_HIDDEN
+void shm_sink_finalize(bt_self_component_sink *self_comp);
+
+BT_HIDDEN
+bt_component_class_sink_graph_is_configured_method_status
+shm_sink_graph_is_configured(bt_self_component_sink *self_comp);
+
+BT_HIDDEN
+bt_component_class_sink_consume_method_status shm_sink_consume(
+		bt_self_component_sink *self_comp);
+
+#endif /* BABELTRACE_PLUGINS_SHM_SHM_SINK_H */
@@ -0,0 +1,2297 @@
+/*
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#define BT_COMP_LOG_SELF_COMP (msg_iter->self_comp)
+#define BT_LOG_OUTPUT_LEVEL (msg_iter->log_level)
+#define BT_LOG_TAG "PLUGIN/SRC.SHM.RING"
+#include "logging/comp-logging.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <glib.h>
+#include <babeltrace2/babeltrace.h>
+#include "common/assert.h"
+#include "common/common.h"
+#include "plugins/common/param-validation/param-validation.h"
+
+#include "ring.h"
+#include "shm-src.h"
+#include "wire.h"
+
+/*
+ * Maximum time to wait for a record within a single "next" method
+ * call (µs).
+ */
+#define READ_TIMEOUT_US		(100 * 1000)
+
+static
+const char *obj_kind_string(enum shm_wire_obj_kind kind)
+{
+	switch (kind) {
+	case SHM_WIRE_OBJ_KIND_CLOCK_CLASS:
+		return "clock class";
+	case SHM_WIRE_OBJ_KIND_TRACE_CLASS:
+		return "trace class";
+	case SHM_WIRE_OBJ_KIND_TRACE:
+		return "trace";
+	case SHM_WIRE_OBJ_KIND_STREAM_CLASS:
+		return "stream class";
+	case SHM_WIRE_OBJ_KIND_EVENT_CLASS:
+		return "event class";
+	case SHM_WIRE_OBJ_KIND_STREAM:
+		return "stream";
+	default:
+		return "(unknown)";
+	}
+}
+
+/*
+ * Appends an error cause if the reader of `msg_iter` reached the end
+ * of the ring record too soon or found malformed data.
+ *
+ * Returns 0 if there's no such error.
+ */
+static
+int check_reader(struct shm_src_msg_iter *msg_iter, const char *what)
+{
+	int ret = 0;
+
+	if (msg_iter->reader.error) {
+		BT_COMP_LOGE_APPEND_CAUSE(msg_iter->self_comp,
+			"Malformed shared memory ring record: "
+			"while-reading=\"%s\", offset=%zu, record-size=%zu",
+			what, msg_iter->reader.offset, msg_iter->reader.size);
+		ret = -1;
+	}
+
+	return ret;
+}
+
+/* Returns the object of kind `kind` having the handle `handle` */
+static
+void *borrow_obj(struct shm_src_msg_iter *msg_iter,
+		enum shm_wire_obj_kind kind, uint64_t handle)
+{
+	GPtrArray *objs = msg_iter->objs[kind];
+	void *obj = NULL;
+
+	if (handle < objs->len) {
+		obj = g_ptr_array_index(objs, handle);
+	}
+
+	if (!obj) {
+		BT_COMP_LOGE_APPEND_CAUSE(msg_iter->self_comp,
+			"Unknown handle in shared memory ring record: "
+			"kind=%s, handle=%" PRIu64, obj_kind_string(kind),
+			handle);
+	}
+
+	return obj;
+}
+
+/* Reads a handle and returns its object of kind `kind` */
+static
+void *read_obj(struct shm_src_msg_iter *msg_iter, enum shm_wire_obj_kind kind)
+{
+	uint64_t handle = shm_wire_read_uint(&msg_iter->reader);
+
+	if (check_reader(msg_iter, obj_kind_string(kind))) {
+		return NULL;
+	}
+
+	return borrow_obj(msg_iter, kind, handle);
+}
+
+/*
+ * Adds the object `obj` of kind `kind`, of which the handle is
+ * `handle`, moving the caller's reference to this.
+ *
+ * The producer assigns sequential handles: `handle` must be the next
+ * one.
+ */
+static
+int add_obj(struct shm_src_msg_iter *msg_iter, enum shm_wire_obj_kind kind,
+		uint64_t handle, void *obj)
+{
+	GPtrArray *objs = msg_iter->objs[kind];
+	int ret = 0;
+
+	if (handle != objs->len) {
+		BT_COMP_LOGE_APPEND_CAUSE(msg_iter->self_comp,
+			"Unexpected handle in shared memory ring record: "
+			"kind=%s, handle=%" PRIu64 ", expected-handle=%u",
+			obj_kind_string(kind), handle, objs->len);
+		ret = -1;
+		goto end;
+	}
+
+	g_ptr_array_add(objs, obj);
+
+end:
+	return ret;
+}
+
+static
+bt_value *read_value(struct shm_src_msg_iter *msg_iter)
+{
+	struct shm_wire_reader *reader = &msg_iter->reader;
+	uint64_t type = shm_wire_read_uint(reader);
+	bt_value *val = NULL;
+	uint64_t count;
+	uint64_t i;
+
+	if (reader->error) {
+		goto error;
+	}
+
+	switch (type) {
+	case BT_VALUE_TYPE_NULL:
+		val = bt_value_null;
+		bt_value_get_ref(val);
+		break;
+	case BT_VALUE_TYPE_BOOL:
+		val = bt_value_bool_create_init(shm_wire_read_bool(reader));
+		break;
+	case BT_VALUE_TYPE_UNSIGNED_INTEGER:
+		val = bt_value_integer_unsigned_create_init(
+			shm_wire_read_uint(reader));
+		break;
+	case BT_VALUE_TYPE_SIGNED_INTEGER:
+		val = bt_value_integer_signed_create_init(
+			shm_wire_read_int(reader));
+		break;
+	case BT_VALUE_TYPE_REAL:
+		val = bt_value_real_create_init(shm_wire_read_double(reader));
+		break;
+	case BT_VALUE_TYPE_STRING:
+	{
+		const char *str = shm_wire_read_string(reader);
+
+		if (!str) {
+			goto error;
+		}
+
+		val = bt_value_string_create_init(str);
+		break;
+	}
+	case BT_VALUE_TYPE_ARRAY:
+		val = bt_value_array_create();
+		if (!val) {
+			goto error;
+		}
+
+		count = shm_wire_read_uint(reader);
+
+		for (i = 0; i < count; i++) {
+			bt_value *elem = read_value(msg_iter);
+			bt_value_array_append_element_status append_status;
+
+			if (!elem) {
+				goto error;
+			}
+
+			append_status = bt_value_array_append_element(val,
+				elem);
+			bt_value_put_ref(elem);
+			if (append_status) {
+				goto error;
+			}
+		}
+
+		break;
+	case BT_VALUE_TYPE_MAP:
+		val = bt_value_map_create();
+		if (!val) {
+			goto error;
+		}
+
+		count = shm_wire_read_uint(reader);
+
+		for (i = 0; i < count; i++) {
+			const char *key = shm_wire_read_string(reader);
+			bt_value *entry_val;
+			bt_value_map_insert_entry_status insert_status;
+
+			if (!key) {
+				goto error;
+			}
+
+			entry_val = read_value(msg_iter);
+			if (!entry_val) {
+				goto error;
+			}
+
+			insert_status = bt_value_map_insert_entry(val, key,
+				entry_val);
+			bt_value_put_ref(entry_val);
+			if (insert_status) {
+				goto error;
+			}
+		}
+
+		break;
+	default:
+		reader->error = true;
+		goto error;
+	}
+
+	if (!val || reader->error) {
+		goto error;
+	}
+
+	goto end;
+
+error:
+	BT_VALUE_PUT_REF_AND_RESET(val);
+
+end:
+	return val;
+}
+
+/*
+ * Reads user attributes and sets them on `obj`, a metadata object of
+ * kind `kind`.
+ */
+static
+int read_user_attributes(struct shm_src_msg_iter *msg_iter,
+		enum shm_wire_obj_kind kind, void *obj)
+{
+	bt_value *user_attrs = read_value(msg_iter);
+	int ret = 0;
+
+	if (!user_attrs || !bt_value_is_map(user_attrs)) {
+		msg_iter->reader.error = true;
+		ret = check_reader(msg_iter, "user attributes");
+		goto end;
+	}
+
+	switch (kind) {
+	case SHM_WIRE_OBJ_KIND_CLOCK_CLASS:
+		bt_clock_class_set_user_attributes(obj, user_attrs);
+		break;
+	case SHM_WIRE_OBJ_KIND_TRACE_CLASS:
+		bt_trace_class_set_user_attributes(obj, user_attrs);
+		break;
+	case SHM_WIRE_OBJ_KIND_TRACE:
+		bt_trace_set_user_attributes(obj, user_attrs);
+		break;
+	case SHM_WIRE_OBJ_KIND_STREAM_CLASS:
+		bt_stream_class_set_user_attributes(obj, user_attrs);
+		break;
+	case SHM_WIRE_OBJ_KIND_EVENT_CLASS:
+		bt_event_class_set_user_attributes(obj, user_attrs);
+		break;
+	case SHM_WIRE_OBJ_KIND_STREAM:
+		bt_stream_set_user_attributes(obj, user_attrs);
+		break;
+	default:
+		bt_common_abort();
+	}
+
+end:
+	bt_value_put_ref(user_attrs);
+	return ret;
+}
+
+static
+bt_integer_range_set_unsigned *read_uint_range_set(
+		struct shm_src_msg_iter *msg_iter)
+{
+	struct shm_wire_reader *reader = &msg_iter->reader;
+	bt_integer_range_set_unsigned *range_set =
+		bt_integer_range_set_unsigned_create();
+	uint64_t count = shm_wire_read_uint(reader);
+	uint64_t i;
+
+	if (!range_set) {
+		goto end;
+	}
+
+	for (i = 0; i < count && !reader->error; i++) {
+		uint64_t lower = shm_wire_read_uint(reader);
+		uint64_t upper = shm_wire_read_uint(reader);
+
+		if (lower > upper || bt_integer_range_set_unsigned_add_range(
+				range_set, lower, upper)) {
+			reader->error = true;
+		}
+	}
+
+	if (reader->error) {
+		BT_INTEGER_RANGE_SET_UNSIGNED_PUT_REF_AND_RESET(range_set);
+	}
+
+end:
+	return range_set;
+}
+
+static
+bt_integer_range_set_signed *read_int_range_set(
+		struct shm_src_msg_iter *msg_iter)
+{
+	struct shm_wire_reader *reader = &msg_iter->reader;
+	bt_integer_range_set_signed *range_set =
+		bt_integer_range_set_signed_create();
+	uint64_t count = shm_wire_read_uint(reader);
+	uint64_t i;
+
+	if (!range_set) {
+		goto end;
+	}
+
+	for (i = 0; i < count && !reader->error; i++) {
+		int64_t lower = shm_wire_read_int(reader);
+		int64_t upper = shm_wire_read_int(reader);
+
+		if (lower > upper || bt_integer_range_set_signed_add_range(
+				range_set, lower, upper)) {
+			reader->error = true;
+		}
+	}
+
+	if (reader->error) {
+		BT_INTEGER_RANGE_SET_SIGNED_PUT_REF_AND_RESET(range_set);
+	}
+
+end:
+	return range_set;
+}
+
+/* Context of the field classes of a stream class or an event class */
+struct fc_ctx {
+	/* Weak */
+	bt_trace_class *tc;
+
+	/*
+	 * Field path key to field class tables (weak) of the stream
+	 * class (packet context and event common context) and of the
+	 * event class (event specific context and payload; `NULL` while
+	 * reading the field classes of a stream class).
+	 */
+	GHashTable *sc_fcs;
+	GHashTable *ec_fcs;
+};
+
+/* Returns the field class of which the key is the next string */
+static
+bt_field_class *read_field_path(struct shm_src_msg_iter *msg_iter,
+		struct fc_ctx *ctx)
+{
+	const char *key = shm_wire_read_string(&msg_iter->reader);
+	GHashTable *fcs;
+	bt_field_class *fc = NULL;
+
+	if (!key) {
+		msg_iter->reader.error = true;
+		(void) check_reader(msg_iter, "field path");
+		goto end;
+	}
+
+	switch (key[0]) {
+	case '0' + BT_FIELD_PATH_SCOPE_PACKET_CONTEXT:
+	case '0' + BT_FIELD_PATH_SCOPE_EVENT_COMMON_CONTEXT:
+		fcs = ctx->sc_fcs;
+		break;
+	default:
+		fcs = ctx->ec_fcs;
+		break;
+	}
+
+	if (fcs) {
+		fc = g_hash_table_lookup(fcs, key);
+	}
+
+	if (!fc) {
+		BT_COMP_LOGE_APPEND_CAUSE(msg_iter->self_comp,
+			"Unknown field path in shared memory ring record: "
+			"key=\"%s\"", key);
+	}
+
+end:
+	return fc;
+}
+
+static
+bt_field_class *read_field_class(struct shm_src_msg_iter *msg_iter,
+		struct fc_ctx *ctx);
+
+/*
+ * Reads the field class of the structure member or variant option of
+ * which the index is `index`, extending the current field path key
+ * accordingly.
+ */
+static
+bt_field_class *read_child_field_class(struct shm_src_msg_iter *msg_iter,
+		struct fc_ctx *ctx, uint64_t index, char step)
+{
+	GString *key = msg_iter->fp_key;
+	size_t key_len = key->len;
+	bt_field_class *fc;
+
+	if (step) {
+		shm_wire_field_path_key_append_char(key, step);
+	} else {
+		shm_wire_field_path_key_append_index(key, index);
+	}
+
+	fc = read_field_class(msg_iter, ctx);
+	g_string_truncate(key, key_len);
+	return fc;
+}
+
+static
+int read_enum_mappings(struct shm_src_msg_iter *msg_iter, bt_field_class *fc)
+{
+	struct shm_wire_reader *reader = &msg_iter->reader;
+	bool is_signed = bt_field_class_get_type(fc) ==
+		BT_FIELD_CLASS_TYPE_SIGNED_ENUMERATION;
+	uint64_t count = shm_wire_read_uint(reader);
+	uint64_t i;
+	int ret = 0;
+
+	for (i = 0; i < count; i++) {
+		const char *label = shm_wire_read_string(reader);
+
+		if (!label) {
+			goto error;
+		}
+
+		if (is_signed) {
+			bt_integer_range_set_signed *ranges =
+				read_int_range_set(msg_iter);
+
+			if (!ranges) {
+				goto error;
+			}
+
+			ret = bt_field_class_enumeration_signed_add_mapping(fc,
+				label, ranges);
+			bt_integer_range_set_signed_put_ref(ranges);
+		} else {
+			bt_integer_range_set_unsigned *ranges =
+				read_uint_range_set(msg_iter);
+
+			if (!ranges) {
+				goto error;
+			}
+
+			ret = bt_field_class_enumeration_unsigned_add_mapping(fc,
+				label, ranges);
+			bt_integer_range_set_unsigned_put_ref(ranges);
+		}
+
+		if (ret) {
+			goto error;
+		}
+	}
+
+	goto end;
+
+error:
+	reader->error = true;
+	ret = check_reader(msg_iter, "enumeration field class mappings");
+
+end:
+	return ret;
+}
+
+static
+int read_variant_options(struct shm_src_msg_iter *msg_iter,
+		struct fc_ctx *ctx, bt_field_class *fc)
+{
+	struct shm_wire_reader *reader = &msg_iter->reader;
+	bt_field_class_type type = bt_field_class_get_type(fc);
+	uint64_t count = shm_wire_read_uint(reader);
+	uint64_t i;
+	int ret = 0;
+
+	for (i = 0; i < count; i++) {
+		const char *name = shm_wire_read_string(reader);
+		bt_value *user_attrs = read_value(msg_iter);
+		bt_integer_range_set_unsigned *uint_ranges = NULL;
+		bt_integer_range_set_signed *int_ranges = NULL;
+		bt_field_class *option_fc = NULL;
+
+		if (type == BT_FIELD_CLASS_TYPE_VARIANT_WITH_UNSIGNED_INTEGER_SELECTOR_FIELD) {
+			uint_ranges = read_uint_range_set(msg_iter);
+		} else if (type == BT_FIELD_CLASS_TYPE_VARIANT_WITH_SIGNED_INTEGER_SELECTOR_FIELD) {
+			int_ranges = read_int_range_set(msg_iter);
+		}
+
+		if (!reader->error && user_attrs) {
+			option_fc = read_child_field_class(msg_iter, ctx, i, 0);
+		}
+
+		if (!option_fc) {
+			ret = -1;
+		} else if (type == BT_FIELD_CLASS_TYPE_VARIANT_WITH_UNSIGNED_INTEGER_SELECTOR_FIELD) {
+			ret = uint_ranges ?
+				bt_field_class_variant_with_selector_field_integer_unsigned_append_option(
+					fc, name, option_fc, uint_ranges) : -1;
+		} else if (type == BT_FIELD_CLASS_TYPE_VARIANT_WITH_SIGNED_INTEGER_SELECTOR_FIELD) {
+			ret = int_ranges ?
+				bt_field_class_variant_with_selector_field_integer_signed_append_option(
+					fc, name, option_fc, int_ranges) : -1;
+		} else {
+			ret = bt_field_class_variant_without_selector_append_option(
+				fc, name, option_fc);
+		}
+
+		if (!ret) {
+			bt_field_class_variant_option_set_user_attributes(
+				bt_field_class_variant_borrow_option_by_index(
+					fc, i), user_attrs);
+		}
+
+		bt_value_put_ref(user_attrs);
+		bt_integer_range_set_unsigned_put_ref(uint_ranges);
+		bt_integer_range_set_signed_put_ref(int_ranges);
+		bt_field_class_put_ref(option_fc);
+
+		if (ret) {
+			reader->error = true;
+			ret = check_reader(msg_iter, "variant field class options");
+			goto end;
+		}
+	}
+
+end:
+	return ret;
+}
+
+static
+int read_structure_members(struct shm_src_msg_iter *msg_iter,
+		struct fc_ctx *ctx, bt_field_class *fc)
+{
+	struct shm_wire_reader *reader = &msg_iter->reader;
+	uint64_t count = shm_wire_read_uint(reader);
+	uint64_t i;
+	int ret = 0;
+
+	for (i = 0; i < count; i++) {
+		const char *name = shm_wire_read_string(reader);
+		bt_value *user_attrs = read_value(msg_iter);
+		bt_field_class *member_fc = NULL;
+
+		if (name && user_attrs) {
+			member_fc = read_child_field_class(msg_iter, ctx, i, 0);
+		}
+
+		ret = member_fc ? bt_field_class_structure_append_member(fc,
+			name, member_fc) : -1;
+		if (!ret) {
+			bt_field_class_structure_member_set_user_attributes(
+				bt_field_class_structure_borrow_member_by_index(
+					fc, i), user_attrs);
+		}
+
+		bt_value_put_ref(user_attrs);
+		bt_field_class_put_ref(member_fc);
+
+		if (ret) {
+			reader->error = true;
+			ret = check_reader(msg_iter,
+				"structure field class members");
+			goto end;
+		}
+	}
+
+end:
+	return ret;
+}
+
+/*
+ * Reads a field class which `sink.shm.ring` wrote with
+ * write_field_class().
+ *
+ * The field path key of `msg_iter` is the key of this field class.
+ */
+static
+bt_field_class *read_field_class(struct shm_src_msg_iter *msg_iter,
+		struct fc_ctx *ctx)
+{
+	struct shm_wire_reader *reader = &msg_iter->reader;
+	bt_trace_class *tc = ctx->tc;
+	uint64_t type = shm_wire_read_uint(reader);
+	bt_value *user_attrs = read_value(msg_iter);
+	bt_field_class *fc = NULL;
+	bt_field_class *child_fc = NULL;
+	bt_field_class *target_fc;
+
+	if (!user_attrs) {
+		goto error;
+	}
+
+	switch (type) {
+	case BT_FIELD_CLASS_TYPE_BOOL:
+		fc = bt_field_class_bool_create(tc);
+		break;
+	case BT_FIELD_CLASS_TYPE_BIT_ARRAY:
+	{
+		uint64_t length = shm_wire_read_uint(reader);
+
+		if (length == 0 || length > 64) {
+			goto error;
+		}
+
+		fc = bt_field_class_bit_array_create(tc, length);
+		break;
+	}
+	case BT_FIELD_CLASS_TYPE_UNSIGNED_INTEGER:
+	case BT_FIELD_CLASS_TYPE_SIGNED_INTEGER:
+	case BT_FIELD_CLASS_TYPE_UNSIGNED_ENUMERATION:
+	case BT_FIELD_CLASS_TYPE_SIGNED_ENUMERATION:
+	{
+		uint64_t range = shm_wire_read_uint(reader);
+		uint64_t base = shm_wire_read_uint(reader);
+
+		if (range == 0 || range > 64) {
+			goto error;
+		}
+
+		if (type == BT_FIELD_CLASS_TYPE_UNSIGNED_INTEGER) {
+			fc = bt_field_class_integer_unsigned_create(tc);
+		} else if (type == BT_FIELD_CLASS_TYPE_SIGNED_INTEGER) {
+			fc = bt_field_class_integer_signed_create(tc);
+		} else if (type == BT_FIELD_CLASS_TYPE_UNSIGNED_ENUMERATION) {
+			fc = bt_field_class_enumeration_unsigned_create(tc);
+		} else {
+			fc = bt_field_class_enumeration_signed_create(tc);
+		}
+
+		if (!fc) {
+			goto error;
+		}
+
+		bt_field_class_integer_set_field_value_range(fc, range);
+		bt_field_class_integer_set_preferred_display_base(fc, base);
+
+		if (bt_field_class_type_is(type,
+				BT_FIELD_CLASS_TYPE_ENUMERATION) &&
+				read_enum_mappings(msg_iter, fc)) {
+			goto error;
+		}
+
+		break;
+	}
+	case BT_FIELD_CLASS_TYPE_SINGLE_PRECISION_REAL:
+		fc = bt_field_class_real_single_precision_create(tc);
+		break;
+	case BT_FIELD_CLASS_TYPE_DOUBLE_PRECISION_REAL:
+		fc = bt_field_class_real_double_precision_create(tc);
+		break;
+	case BT_FIELD_CLASS_TYPE_STRING:
+		fc = bt_field_class_string_create(tc);
+		break;
+	case BT_FIELD_CLASS_TYPE_STRUCTURE:
+		fc = bt_field_class_structure_create(tc);
+		if (!fc || read_structure_members(msg_iter, ctx, fc)) {
+			goto error;
+		}
+
+		break;
+	case BT_FIELD_CLASS_TYPE_STATIC_ARRAY:
+	{
+		uint64_t length = shm_wire_read_uint(reader);
+
+		child_fc = read_child_field_class(msg_iter, ctx, 0,
+			SHM_WIRE_FIELD_PATH_KEY_CURRENT_ARRAY_ELEMENT);
+		if (!child_fc) {
+			goto error;
+		}
+
+		fc = bt_field_class_array_static_create(tc, child_fc, length);
+		break;
+	}
+	case BT_FIELD_CLASS_TYPE_DYNAMIC_ARRAY_WITHOUT_LENGTH_FIELD:
+	case BT_FIELD_CLASS_TYPE_DYNAMIC_ARRAY_WITH_LENGTH_FIELD:
+		target_fc = NULL;
+
+		if (type == BT_FIELD_CLASS_TYPE_DYNAMIC_ARRAY_WITH_LENGTH_FIELD) {
+			target_fc = read_field_path(msg_iter, ctx);
+			if (!target_fc) {
+				goto error;
+			}
+		}
+
+		child_fc = read_child_field_class(msg_iter, ctx, 0,
+			SHM_WIRE_FIELD_PATH_KEY_CURRENT_ARRAY_ELEMENT);
+		if (!child_fc) {
+			goto error;
+		}
+
+		fc = bt_field_class_array_dynamic_create(tc, child_fc,
+			target_fc);
+		break;
+	case BT_FIELD_CLASS_TYPE_OPTION_WITHOUT_SELECTOR_FIELD:
+		child_fc = read_child_field_class(msg_iter, ctx, 0,
+			SHM_WIRE_FIELD_PATH_KEY_CURRENT_OPTION_CONTENT);
+		if (!child_fc) {
+			goto error;
+		}
+
+		fc = bt_field_class_option_without_selector_create(tc,
+			child_fc);
+		break;
+	case BT_FIELD_CLASS_TYPE_OPTION_WITH_BOOL_SELECTOR_FIELD:
+	{
+		bool is_reversed;
+
+		target_fc = read_field_path(msg_iter, ctx);
+		if (!target_fc) {
+			goto error;
+		}
+
+		is_reversed = shm_wire_read_bool(reader);
+		child_fc = read_child_field_class(msg_iter, ctx, 0,
+			SHM_WIRE_FIELD_PATH_KEY_CURRENT_OPTION_CONTENT);
+		if (!child_fc) {
+			goto error;
+		}
+
+		fc = bt_field_class_option_with_selector_field_bool_create(tc,
+			child_fc, target_fc);
+		if (fc) {
+			bt_field_class_option_with_selector_field_bool_set_selector_is_reversed(
+				fc, is_reversed);
+		}
+
+		break;
+	}
+	case BT_FIELD_CLASS_TYPE_OPTION_WITH_UNSIGNED_INTEGER_SELECTOR_FIELD:
+	{
+		bt_integer_range_set_unsigned *ranges;
+
+		target_fc = read_field_path(msg_iter, ctx);
+		if (!target_fc) {
+			goto error;
+		}
+
+		ranges = read_uint_range_set(msg_iter);
+		if (!ranges) {
+			goto error;
+		}
+
+		child_fc = read_child_field_class(msg_iter, ctx, 0,
+			SHM_WIRE_FIELD_PATH_KEY_CURRENT_OPTION_CONTENT);
+		if (child_fc) {
+			fc = bt_field_class_option_with_selector_field_integer_unsigned_create(
+				tc, child_fc, target_fc, ranges);
+		}
+
+		bt_integer_range_set_unsigned_put_ref(ranges);
+		break;
+	}
+	case BT_FIELD_CLASS_TYPE_OPTION_WITH_SIGNED_INTEGER_SELECTOR_FIELD:
+	{
+		bt_integer_range_set_signed *ranges;
+
+		target_fc = read_field_path(msg_iter, ctx);
+		if (!target_fc) {
+			goto error;
+		}
+
+		ranges = read_int_range_set(msg_iter);
+		if (!ranges) {
+			goto error;
+		}
+
+		child_fc = read_child_field_class(msg_iter, ctx, 0,
+			SHM_WIRE_FIELD_PATH_KEY_CURRENT_OPTION_CONTENT);
+		if (child_fc) {
+			fc = bt_field_class_option_with_selector_field_integer_signed_create(
+				tc, child_fc, target_fc, ranges);
+		}
+
+		bt_integer_range_set_signed_put_ref(ranges);
+		break;
+	}
+	case BT_FIELD_CLASS_TYPE_VARIANT_WITHOUT_SELECTOR_FIELD:
+	case BT_FIELD_CLASS_TYPE_VARIANT_WITH_UNSIGNED_INTEGER_SELECTOR_FIELD:
+	case BT_FIELD_CLASS_TYPE_VARIANT_WITH_SIGNED_INTEGER_SELECTOR_FIELD:
+		target_fc = NULL;
+
+		if (type != BT_FIELD_CLASS_TYPE_VARIANT_WITHOUT_SELECTOR_FIELD) {
+			target_fc = read_field_path(msg_iter, ctx);
+			if (!target_fc) {
+				goto error;
+			}
+		}
+
+		fc = bt_field_class_variant_create(tc, target_fc);
+		if (!fc || read_variant_options(msg_iter, ctx, fc)) {
+			goto error;
+		}
+
+		break;
+	default:
+		BT_COMP_LOGE_APPEND_CAUSE(msg_iter->self_comp,
+			"Unknown field class type in shared memory ring record: "
+			"type=%" PRIu64, type);
+		goto error;
+	}
+
+	if (!fc || reader->error || !bt_value_is_map(user_attrs)) {
+		goto error;
+	}
+
+	bt_field_class_set_user_attributes(fc, user_attrs);
+
+	/*
+	 * Register the possible targets of dynamic array length and of
+	 * option/variant selector field paths.
+	 */
+	if (type == BT_FIELD_CLASS_TYPE_BOOL ||
+			bt_field_class_type_is(type,
+				BT_FIELD_CLASS_TYPE_INTEGER)) {
+		g_hash_table_insert(ctx->ec_fcs ? ctx->ec_fcs : ctx->sc_fcs,
+			g_strdup(msg_iter->fp_key->str), fc);
+	}
+
+	goto end;
+
+error:
+	msg_iter->reader.error = true;
+	(void) check_reader(msg_iter, "field class");
+	BT_FIELD_CLASS_PUT_REF_AND_RESET(fc);
+
+end:
+	bt_field_class_put_ref(child_fc);
+	bt_value_put_ref(user_attrs);
+	return fc;
+}
+
+/*
+ * Reads whether or not there's a field class of the root scope `scope`
+ * and, if there's one, reads it to `*fc`.
+ */
+static
+int read_opt_field_class(struct shm_src_msg_iter *msg_iter,
+		struct fc_ctx *ctx, bt_field_path_scope scope,
+		bt_field_class **fc)
+{
+	int ret = 0;
+
+	*fc = NULL;
+
+	if (!shm_wire_read_bool(&msg_iter->reader)) {
+		ret = check_reader(msg_iter, "field class");
+		goto end;
+	}
+
+	g_string_printf(msg_iter->fp_key, "%d", (int) scope);
+	*fc = read_field_class(msg_iter, ctx);
+	if (!*fc) {
+		ret = -1;
+	}
+
+end:
+	return ret;
+}
+
+static
+int read_field(struct shm_src_msg_iter *msg_iter, bt_field *field)
+{
+	struct shm_wire_reader *reader = &msg_iter->reader;
+	bt_field_class_type type = bt_field_get_class_type(field);
+	uint64_t i;
+	int ret = 0;
+
+	if (type == BT_FIELD_CLASS_TYPE_BOOL) {
+		bt_field_bool_set_value(field, shm_wire_read_bool(reader));
+	} else if (type == BT_FIELD_CLASS_TYPE_BIT_ARRAY) {
+		bt_field_bit_array_set_value_as_integer(field,
+			shm_wire_read_uint(reader));
+	} else if (bt_field_class_type_is(type,
+			BT_FIELD_CLASS_TYPE_UNSIGNED_INTEGER)) {
+		bt_field_integer_unsigned_set_value(field,
+			shm_wire_read_uint(reader));
+	} else if (bt_field_class_type_is(type,
+			BT_FIELD_CLASS_TYPE_SIGNED_INTEGER)) {
+		bt_field_integer_signed_set_value(field,
+			shm_wire_read_int(reader));
+	} else if (type == BT_FIELD_CLASS_TYPE_SINGLE_PRECISION_REAL) {
+		bt_field_real_single_precision_set_value(field,
+			shm_wire_read_float(reader));
+	} else if (type == BT_FIELD_CLASS_TYPE_DOUBLE_PRECISION_REAL) {
+		bt_field_real_double_precision_set_value(field,
+			shm_wire_read_double(reader));
+	} else if (type == BT_FIELD_CLASS_TYPE_STRING) {
+		const char *str = shm_wire_read_string(reader);
+
+		if (!str || bt_field_string_set_value(field, str)) {
+			goto error;
+		}
+	} else if (type == BT_FIELD_CLASS_TYPE_STRUCTURE) {
+		uint64_t count = bt_field_class_structure_get_member_count(
+			bt_field_borrow_class_const(field));
+
+		for (i = 0; i < count; i++) {
+			if (read_field(msg_iter,
+					bt_field_structure_borrow_member_field_by_index(
+						field, i))) {
+				goto error;
+			}
+		}
+	} else if (bt_field_class_type_is(type, BT_FIELD_CLASS_TYPE_ARRAY)) {
+		uint64_t len;
+
+		if (bt_field_class_type_is(type,
+				BT_FIELD_CLASS_TYPE_DYNAMIC_ARRAY)) {
+			len = shm_wire_read_uint(reader);
+
+			/* Each element has at least one byte */
+			if (len > reader->size - reader->offset ||
+					bt_field_array_dynamic_set_length(
+						field, len)) {
+				goto error;
+			}
+		} else {
+			len = bt_field_array_get_length(field);
+		}
+
+		for (i = 0; i < len; i++) {
+			if (read_field(msg_iter,
+					bt_field_array_borrow_element_field_by_index(
+						field, i))) {
+				goto error;
+			}
+		}
+	} else if (bt_field_class_type_is(type, BT_FIELD_CLASS_TYPE_OPTION)) {
+		bool has_field = shm_wire_read_bool(reader);
+
+		bt_field_option_set_has_field(field, has_field);
+
+		if (has_field && read_field(msg_iter,
+				bt_field_option_borrow_field(field))) {
+			goto error;
+		}
+	} else if (bt_field_class_type_is(type, BT_FIELD_CLASS_TYPE_VARIANT)) {
+		uint64_t index = shm_wire_read_uint(reader);
+
+		if (index >= bt_field_class_variant_get_option_count(
+				bt_field_borrow_class_const(field)) ||
+				bt_field_variant_select_option_by_index(field,
+					index)) {
+			goto error;
+		}
+
+		if (read_field(msg_iter,
+				bt_field_variant_borrow_selected_option_field(
+					field))) {
+			goto error;
+		}
+	} else {
+		bt_common_abort();
+	}
+
+	if (reader->error) {
+		goto error;
+	}
+
+	goto end;
+
+error:
+	reader->error = true;
+	ret = -1;
+
+end:
+	return ret;
+}
+
+static
+void destroy_stream_class(struct shm_src_stream_class *sc)
+{
+	if (!sc) {
+		return;
+	}
+
+	bt_stream_class_put_ref(sc->sc);
+
+	if (sc->fcs_by_key) {
+		g_hash_table_destroy(sc->fcs_by_key);
+	}
+
+	g_free(sc);
+}
+
+static
+void destroy_stream(struct shm_src_stream *stream)
+{
+	if (!stream) {
+		return;
+	}
+
+	bt_packet_put_ref(stream->packet);
+	bt_stream_put_ref(stream->stream);
+	g_free(stream);
+}
+
+static
+int read_clock_class_record(struct shm_src_msg_iter *msg_iter)
+{
+	struct shm_wire_reader *reader = &msg_iter->reader;
+	uint64_t handle = shm_wire_read_uint(reader);
+	const char *name = shm_wire_read_string(reader);
+	const char *descr = shm_wire_read_string(reader);
+	uint64_t frequency = shm_wire_read_uint(reader);
+	uint64_t precision = shm_wire_read_uint(reader);
+	int64_t offset_seconds = shm_wire_read_int(reader);
+	uint64_t offset_cycles = shm_wire_read_uint(reader);
+	bool origin_is_unix_epoch = shm_wire_read_bool(reader);
+	const uint8_t *uuid = shm_wire_read_uuid(reader);
+	bt_clock_class *cc = NULL;
+	int ret;
+
+	ret = check_reader(msg_iter, "clock class");
+	if (ret) {
+		goto end;
+	}
+
+	if (frequency == 0 || offset_cycles >= frequency) {
+		reader->error = true;
+		ret = check_reader(msg_iter, "clock class");
+		goto end;
+	}
+
+	cc = bt_clock_class_create(msg_iter->self_comp);
+	if (!cc) {
+		BT_COMP_LOGE_APPEND_CAUSE(msg_iter->self_comp,
+			"Cannot create clock class.");
+		ret = -1;
+		goto end;
+	}
+
+	if ((name && bt_clock_class_set_name(cc, name)) ||
+			(descr && bt_clock_class_set_description(cc, descr))) {
+		ret = -1;
+		goto end;
+	}
+
+	bt_clock_class_set_frequency(cc, frequency);
+	bt_clock_class_set_precision(cc, precision);
+	bt_clock_class_set_offset(cc, offset_seconds, offset_cycles);
+	bt_clock_class_set_origin_is_unix_epoch(cc, origin_is_unix_epoch);
+
+	if (uuid) {
+		bt_clock_class_set_uuid(cc, uuid);
+	}
+
+	ret = read_user_attributes(msg_iter,
+		SHM_WIRE_OBJ_KIND_CLOCK_CLASS, cc);
+	if (ret) {
+		goto end;
+	}
+
+	ret = add_obj(msg_iter, SHM_WIRE_OBJ_KIND_CLOCK_CLASS, handle, cc);
+	if (ret) {
+		goto end;
+	}
+
+	cc = NULL;
+
+end:
+	bt_clock_class_put_ref(cc);
+	return ret;
+}
+
+static
+int read_trace_class_record(struct shm_src_msg_iter *msg_iter)
+{
+	struct shm_wire_reader *reader = &msg_iter->reader;
+	uint64_t handle = shm_wire_read_uint(reader);
+	bool assigns_auto_sc_id = shm_wire_read_bool(reader);
+	bt_trace_class *tc = NULL;
+	int ret;
+
+	ret = check_reader(msg_iter, "trace class");
+	if (ret) {
+		goto end;
+	}
+
+	tc = bt_trace_class_create(msg_iter->self_comp);
+	if (!tc) {
+		BT_COMP_LOGE_APPEND_CAUSE(msg_iter->self_comp,
+			"Cannot create trace class.");
+		ret = -1;
+		goto end;
+	}
+
+	bt_trace_class_set_assigns_automatic_stream_class_id(tc,
+		assigns_auto_sc_id);
+	ret = read_user_attributes(msg_iter,
+		SHM_WIRE_OBJ_KIND_TRACE_CLASS, tc);
+	if (ret) {
+		goto end;
+	}
+
+	ret = add_obj(msg_iter, SHM_WIRE_OBJ_KIND_TRACE_CLASS, handle, tc);
+	if (ret) {
+		goto end;
+	}
+
+	tc = NULL;
+
+end:
+	bt_trace_class_put_ref(tc);
+	return ret;
+}
+
+static
+int read_trace_record(struct shm_src_msg_iter *msg_iter)
+{
+	struct shm_wire_reader *reader = &msg_iter->reader;
+	uint64_t handle = shm_wire_read_uint(reader);
+	bt_trace_class *tc = read_obj(msg_iter, SHM_WIRE_OBJ_KIND_TRACE_CLASS);
+	const char *name = shm_wire_read_string(reader);
+	const uint8_t *uuid = shm_wire_read_uuid(reader);
+	uint64_t env_count = shm_wire_read_uint(reader);
+	bt_trace *trace = NULL;
+	uint64_t i;
+	int ret = 0;
+
+	if (!tc || check_reader(msg_iter, "trace")) {
+		goto error;
+	}
+
+	trace = bt_trace_create(tc);
+	if (!trace) {
+		BT_COMP_LOGE_APPEND_CAUSE(msg_iter->self_comp,
+			"Cannot create trace.");
+		goto error;
+	}
+
+	if (name && bt_trace_set_name(trace, name)) {
+		goto error;
+	}
+
+	if (uuid) {
+		bt_trace_set_uuid(trace, uuid);
+	}
+
+	for (i = 0; i < env_count; i++) {
+		const char *entry_name = shm_wire_read_string(reader);
+		bt_value *entry_val = read_value(msg_iter);
+
+		if (!entry_name || !entry_val) {
+			ret = -1;
+		} else if (bt_value_is_signed_integer(entry_val)) {
+			ret = bt_trace_set_environment_entry_integer(trace,
+				entry_name,
+				bt_value_integer_signed_get(entry_val));
+		} else if (bt_value_is_string(entry_val)) {
+			ret = bt_trace_set_environment_entry_string(trace,
+				entry_name, bt_value_string_get(entry_val));
+		} else {
+			reader->error = true;
+			ret = -1;
+		}
+
+		bt_value_put_ref(entry_val);
+
+		if (ret) {
+			(void) check_reader(msg_iter, "trace environment");
+			goto error;
+		}
+	}
+
+	if (read_user_attributes(msg_iter,
+			SHM_WIRE_OBJ_KIND_TRACE, trace)) {
+		goto error;
+	}
+
+	if (add_obj(msg_iter, SHM_WIRE_OBJ_KIND_TRACE, handle, trace)) {
+		goto error;
+	}
+
+	trace = NULL;
+	goto end;
+
+error:
+	ret = -1;
+
+end:
+	bt_trace_put_ref(trace);
+	return ret;
+}
+
+static
+int read_stream_class_record(struct shm_src_msg_iter *msg_iter)
+{
+	struct shm_wire_reader *reader = &msg_iter->reader;
+	uint64_t handle = shm_wire_read_uint(reader);
+	bt_trace_class *tc = read_obj(msg_iter, SHM_WIRE_OBJ_KIND_TRACE_CLASS);
+	uint64_t id = shm_wire_read_uint(reader);
+	const char *name = shm_wire_read_string(reader);
+	bool assigns_auto_ec_id = shm_wire_read_bool(reader);
+	bool assigns_auto_stream_id = shm_wire_read_bool(reader);
+	uint64_t cc_handle_plus_one = shm_wire_read_uint(reader);
+	bool supports_packets = shm_wire_read_bool(reader);
+	bool packets_have_beginning_cs = shm_wire_read_bool(reader);
+	bool packets_have_end_cs = shm_wire_read_bool(reader);
+	bool supports_discarded_events = shm_wire_read_bool(reader);
+	bool discarded_events_have_cs = shm_wire_read_bool(reader);
+	bool supports_discarded_packets = shm_wire_read_bool(reader);
+	bool discarded_packets_have_cs = shm_wire_read_bool(reader);
+	struct shm_src_stream_class *sc = NULL;
+	bt_clock_class *cc = NULL;
+	bt_field_class *fc = NULL;
+	struct fc_ctx ctx;
+	int ret = 0;
+
+	if (!tc || check_reader(msg_iter, "stream class")) {
+		goto error;
+	}
+
+	if (cc_handle_plus_one > 0) {
+		cc = borrow_obj(msg_iter, SHM_WIRE_OBJ_KIND_CLOCK_CLASS,
+			cc_handle_plus_one - 1);
+		if (!cc) {
+			goto error;
+		}
+	}
+
+	sc = g_new0(struct shm_src_stream_class, 1);
+	if (!sc) {
+		BT_COMP_LOGE_APPEND_CAUSE(msg_iter->self_comp,
+			"Failed to allocate one stream class structure.");
+		goto error;
+	}
+
+	sc->fcs_by_key = g_hash_table_new_full(g_str_hash, g_str_equal,
+		g_free, NULL);
+	if (!sc->fcs_by_key) {
+		BT_COMP_LOGE_APPEND_CAUSE(msg_iter->self_comp,
+			"Failed to allocate a GHashTable.");
+		goto error;
+	}
+
+	if (bt_trace_class_assigns_automatic_stream_class_id(tc)) {
+		sc->sc = bt_stream_class_create(tc);
+	} else {
+		sc->sc = bt_stream_class_create_with_id(tc, id);
+	}
+
+	if (!sc->sc) {
+		BT_COMP_LOGE_APPEND_CAUSE(msg_iter->self_comp,
+			"Cannot create stream class.");
+		goto error;
+	}
+
+	if (name && bt_stream_class_set_name(sc->sc, name)) {
+		goto error;
+	}
+
+	bt_stream_class_set_assigns_automatic_event_class_id(sc->sc,
+		assigns_auto_ec_id);
+	bt_stream_class_set_assigns_automatic_stream_id(sc->sc,
+		assigns_auto_stream_id);
+
+	if (cc) {
+		bt_stream_class_set_default_clock_class(sc->sc, cc);
+	} else if (packets_have_beginning_cs || packets_have_end_cs ||
+			discarded_events_have_cs || discarded_packets_have_cs) {
+		reader->error = true;
+		(void) check_reader(msg_iter, "stream class");
+		goto error;
+	}
+
+	bt_stream_class_set_supports_packets(sc->sc, supports_packets,
+		packets_have_beginning_cs, packets_have_end_cs);
+	bt_stream_class_set_supports_discarded_events(sc->sc,
+		supports_discarded_events, discarded_events_have_cs);
+	bt_stream_class_set_supports_discarded_packets(sc->sc,
+		supports_discarded_packets, discarded_packets_have_cs);
+
+	ctx.tc = tc;
+	ctx.sc_fcs = sc->fcs_by_key;
+	ctx.ec_fcs = NULL;
+
+	if (read_opt_field_class(msg_iter, &ctx,
+			BT_FIELD_PATH_SCOPE_PACKET_CONTEXT, &fc)) {
+		goto error;
+	}
+
+	if (fc && bt_stream_class_set_packet_context_field_class(sc->sc, fc)) {
+		goto error;
+	}
+
+	BT_FIELD_CLASS_PUT_REF_AND_RESET(fc);
+
+	if (read_opt_field_class(msg_iter, &ctx,
+			BT_FIELD_PATH_SCOPE_EVENT_COMMON_CONTEXT, &fc)) {
+		goto error;
+	}
+
+	if (fc && bt_stream_class_set_event_common_context_field_class(sc->sc,
+			fc)) {
+		goto error;
+	}
+
+	if (read_user_attributes(msg_iter,
+			SHM_WIRE_OBJ_KIND_STREAM_CLASS, sc->sc)) {
+		goto error;
+	}
+
+	if (add_obj(msg_iter, SHM_WIRE_OBJ_KIND_STREAM_CLASS, handle, sc)) {
+		goto error;
+	}
+
+	sc = NULL;
+	goto end;
+
+error:
+	ret = -1;
+
+end:
+	bt_field_class_put_ref(fc);
+	destroy_stream_class(sc);
+	return ret;
+}
+
+static
+int read_event_class_record(struct shm_src_msg_iter *msg_iter)
+{
+	struct shm_wire_reader *reader = &msg_iter->reader;
+	uint64_t handle = shm_wire_read_uint(reader);
+	struct shm_src_stream_class *sc = read_obj(msg_iter,
+		SHM_WIRE_OBJ_KIND_STREAM_CLASS);
+	uint64_t id = shm_wire_read_uint(reader);
+	const char *name = shm_wire_read_string(reader);
+	bool has_log_level = shm_wire_read_bool(reader);
+	uint64_t log_level = has_log_level ? shm_wire_read_uint(reader) : 0;
+	const char *emf_uri = shm_wire_read_string(reader);
+	GHashTable *ec_fcs = NULL;
+	bt_event_class *ec = NULL;
+	bt_field_class *fc = NULL;
+	struct fc_ctx ctx;
+	int ret = 0;
+
+	if (!sc || check_reader(msg_iter, "event class")) {
+		goto error;
+	}
+
+	if (bt_stream_class_assigns_automatic_event_class_id(sc->sc)) {
+		ec = bt_event_class_create(sc->sc);
+	} else {
+		ec = bt_event_class_create_with_id(sc->sc, id);
+	}
+
+	if (!ec) {
+		BT_COMP_LOGE_APPEND_CAUSE(msg_iter->self_comp,
+			"Cannot create event class.");
+		goto error;
+	}
+
+	if (name && bt_event_class_set_name(ec, name)) {
+		goto error;
+	}
+
+	if (has_log_level) {
+		bt_event_class_set_log_level(ec, log_level);
+	}
+
+	if (emf_uri && bt_event_class_set_emf_uri(ec, emf_uri)) {
+		goto error;
+	}
+
+	ec_fcs = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, NULL);
+	if (!ec_fcs) {
+		BT_COMP_LOGE_APPEND_CAUSE(msg_iter->self_comp,
+			"Failed to allocate a GHashTable.");
+		goto error;
+	}
+
+	ctx.tc = bt_stream_class_borrow_trace_class(sc->sc);
+	ctx.sc_fcs = sc->fcs_by_key;
+	ctx.ec_fcs = ec_fcs;
+
+	if (read_opt_field_class(msg_iter, &ctx,
+			BT_FIELD_PATH_SCOPE_EVENT_SPECIFIC_CONTEXT, &fc)) {
+		goto error;
+	}
+
+	if (fc && bt_event_class_set_specific_context_field_class(ec, fc)) {
+		goto error;
+	}
+
+	BT_FIELD_CLASS_PUT_REF_AND_RESET(fc);
+
+	if (read_opt_field_class(msg_iter, &ctx,
+			BT_FIELD_PATH_SCOPE_EVENT_PAYLOAD, &fc)) {
+		goto error;
+	}
+
+	if (fc && bt_event_class_set_payload_field_class(ec, fc)) {
+		goto error;
+	}
+
+	if (read_user_attributes(msg_iter,
+			SHM_WIRE_OBJ_KIND_EVENT_CLASS, ec)) {
+		goto error;
+	}
+
+	if (add_obj(msg_iter, SHM_WIRE_OBJ_KIND_EVENT_CLASS, handle, ec)) {
+		goto error;
+	}
+
+	ec = NULL;
+	goto end;
+
+error:
+	ret = -1;
+
+end:
+	if (ec_fcs) {
+		g_hash_table_destroy(ec_fcs);
+	}
+
+	bt_field_class_put_ref(fc);
+	bt_event_class_put_ref(ec);
+	return ret;
+}
+
+static
+int read_stream_record(struct shm_src_msg_iter *msg_iter)
+{
+	struct shm_wire_reader *reader = &msg_iter->reader;
+	uint64_t handle = shm_wire_read_uint(reader);
+	struct shm_src_stream_class *sc = read_obj(msg_iter,
+		SHM_WIRE_OBJ_KIND_STREAM_CLASS);
+	bt_trace *trace = read_obj(msg_iter, SHM_WIRE_OBJ_KIND_TRACE);
+	uint64_t id = shm_wire_read_uint(reader);
+	const char *name = shm_wire_read_string(reader);
+	struct shm_src_stream *stream = NULL;
+	int ret = 0;
+
+	if (!sc || !trace || check_reader(msg_iter, "stream")) {
+		goto error;
+	}
+
+	stream = g_new0(struct shm_src_stream, 1);
+	if (!stream) {
+		BT_COMP_LOGE_APPEND_CAUSE(msg_iter->self_comp,
+			"Failed to allocate one stream structure.");
+		goto error;
+	}
+
+	if (bt_stream_class_assigns_automatic_stream_id(sc->sc)) {
+		stream->stream = bt_stream_create(sc->sc, trace);
+	} else {
+		stream->stream = bt_stream_create_with_id(sc->sc, trace, id);
+	}
+
+	if (!stream->stream) {
+		BT_COMP_LOGE_APPEND_CAUSE(msg_iter->self_comp,
+			"Cannot create stream.");
+		goto error;
+	}
+
+	if (name && bt_stream_set_name(stream->stream, name)) {
+		goto error;
+	}
+
+	if (read_user_attributes(msg_iter,
+			SHM_WIRE_OBJ_KIND_STREAM, stream->stream)) {
+		goto error;
+	}
+
+	if (add_obj(msg_iter, SHM_WIRE_OBJ_KIND_STREAM, handle, stream)) {
+		goto error;
+	}
+
+	stream = NULL;
+	goto end;
+
+error:
+	ret = -1;
+
+end:
+	destroy_stream(stream);
+	return ret;
+}
+
+/*
+ * Reads the default clock snapshot of a message of which the stream
+ * class has a default clock class.
+ */
+static
+uint64_t read_clock_snapshot(struct shm_src_msg_iter *msg_iter)
+{
+	return shm_wire_read_uint(&msg_iter->reader);
+}
+
+static
+bt_message *read_event_record(struct shm_src_msg_iter *msg_iter)
+{
+	struct shm_src_stream *stream = read_obj(msg_iter,
+		SHM_WIRE_OBJ_KIND_STREAM);
+	bt_event_class *ec = read_obj(msg_iter, SHM_WIRE_OBJ_KIND_EVENT_CLASS);
+	bt_self_message_iterator *self_msg_iter = msg_iter->self_msg_iter;
+	const bt_stream_class *sc;
+	bt_message *msg = NULL;
+	bt_event *event;
+	bt_field *field;
+
+	if (!stream || !ec) {
+		goto error;
+	}
+
+	sc = bt_stream_borrow_class_const(stream->stream);
+	if (bt_event_class_borrow_stream_class_const(ec) != sc ||
+			(bt_stream_class_supports_packets(sc) &&
+				!stream->packet)) {
+		BT_COMP_LOGE_APPEND_CAUSE(msg_iter->self_comp,
+			"Unexpected event record in shared memory ring: "
+			"stream-id=%" PRIu64 ", event-class-id=%" PRIu64,
+			bt_stream_get_id(stream->stream),
+			bt_event_class_get_id(ec));
+		goto error;
+	}
+
+	if (bt_stream_class_borrow_default_clock_class_const(sc)) {
+		uint64_t cs = read_clock_snapshot(msg_iter);
+
+		if (stream->packet) {
+			msg = bt_message_event_create_with_packet_and_default_clock_snapshot(
+				self_msg_iter, ec, stream->packet, cs);
+		} else {
+			msg = bt_message_event_create_with_default_clock_snapshot(
+				self_msg_iter, ec, stream->stream, cs);
+		}
+	} else {
+		if (stream->packet) {
+			msg = bt_message_event_create_with_packet(
+				self_msg_iter, ec, stream->packet);
+		} else {
+			msg = bt_message_event_create(self_msg_iter, ec,
+				stream->stream);
+		}
+	}
+
+	if (!msg) {
+		BT_COMP_LOGE_APPEND_CAUSE(msg_iter->self_comp,
+			"Cannot create event message.");
+		goto error;
+	}
+
+	event = bt_message_event_borrow_event(msg);
+	field = bt_event_borrow_common_context_field(event);
+	if (field && read_field(msg_iter, field)) {
+		goto error;
+	}
+
+	field = bt_event_borrow_specific_context_field(event);
+	if (field && read_field(msg_iter, field)) {
+		goto error;
+	}
+
+	field = bt_event_borrow_payload_field(event);
+	if (field && read_field(msg_iter, field)) {
+		goto error;
+	}
+
+	if (check_reader(msg_iter, "event")) {
+		goto error;
+	}
+
+	goto end;
+
+error:
+	BT_MESSAGE_PUT_REF_AND_RESET(msg);
+
+end:
+	return msg;
+}
+
+static
+bt_message *read_stream_record_msg(struct shm_src_msg_iter *msg_iter,
+		bool is_beginning)
+{
+	struct shm_wire_reader *reader = &msg_iter->reader;
+	uint64_t handle = shm_wire_read_uint(reader);
+	struct shm_src_stream *stream;
+	bt_message *msg = NULL;
+
+	if (check_reader(msg_iter, "stream message")) {
+		goto end;
+	}
+
+	stream = borrow_obj(msg_iter, SHM_WIRE_OBJ_KIND_STREAM, handle);
+	if (!stream) {
+		goto end;
+	}
+
+	if (is_beginning) {
+		msg = bt_message_stream_beginning_create(
+			msg_iter->self_msg_iter, stream->stream);
+	} else {
+		msg = bt_message_stream_end_create(msg_iter->self_msg_iter,
+			stream->stream);
+	}
+
+	if (!msg) {
+		BT_COMP_LOGE_APPEND_CAUSE(msg_iter->self_comp,
+			"Cannot create stream message.");
+		goto end;
+	}
+
+	if (bt_stream_class_borrow_default_clock_class_const(
+			bt_stream_borrow_class_const(stream->stream)) &&
+			shm_wire_read_bool(reader)) {
+		uint64_t cs = read_clock_snapshot(msg_iter);
+
+		if (is_beginning) {
+			bt_message_stream_beginning_set_default_clock_snapshot(
+				msg, cs);
+		} else {
+			bt_message_stream_end_set_default_clock_snapshot(msg,
+				cs);
+		}
+	}
+
+	if (check_reader(msg_iter, "stream message")) {
+		BT_MESSAGE_PUT_REF_AND_RESET(msg);
+		goto end;
+	}
+
+	if (!is_beginning) {
+		/* The stream handle is not valid anymore */
+		destroy_stream(stream);
+		g_ptr_array_index(msg_iter->objs[SHM_WIRE_OBJ_KIND_STREAM],
+			handle) = NULL;
+	}
+
+end:
+	return msg;
+}
+
+static
+bt_message *read_packet_beginning_record(struct shm_src_msg_iter *msg_iter)
+{
+	struct shm_src_stream *stream = read_obj(msg_iter,
+		SHM_WIRE_OBJ_KIND_STREAM);
+	const bt_stream_class *sc;
+	bt_message *msg = NULL;
+	bt_field *ctx_field;
+
+	if (!stream) {
+		goto error;
+	}
+
+	sc = bt_stream_borrow_class_const(stream->stream);
+	if (!bt_stream_class_supports_packets(sc) || stream->packet) {
+		BT_COMP_LOGE_APPEND_CAUSE(msg_iter->self_comp,
+			"Unexpected packet beginning record in shared memory ring: "
+			"stream-id=%" PRIu64, bt_stream_get_id(stream->stream));
+		goto error;
+	}
+
+	stream->packet = bt_packet_create(stream->stream);
+	if (!stream->packet) {
+		BT_COMP_LOGE_APPEND_CAUSE(msg_iter->self_comp,
+			"Cannot create packet.");
+		goto error;
+	}
+
+	if (bt_stream_class_packets_have_beginning_default_clock_snapshot(sc)) {
+		msg = bt_message_packet_beginning_create_with_default_clock_snapshot(
+			msg_iter->self_msg_iter, stream->packet,
+			read_clock_snapshot(msg_iter));
+	} else {
+		msg = bt_message_packet_beginning_create(
+			msg_iter->self_msg_iter, stream->packet);
+	}
+
+	if (!msg) {
+		BT_COMP_LOGE_APPEND_CAUSE(msg_iter->self_comp,
+			"Cannot create packet beginning message.");
+		goto error;
+	}
+
+	ctx_field = bt_packet_borrow_context_field(stream->packet);
+	if (ctx_field && read_field(msg_iter, ctx_field)) {
+		goto error;
+	}
+
+	if (check_reader(msg_iter, "packet beginning")) {
+		goto error;
+	}
+
+	goto end;
+
+error:
+	BT_MESSAGE_PUT_REF_AND_RESET(msg);
+
+end:
+	return msg;
+}
+
+static
+bt_message *read_packet_end_record(struct shm_src_msg_iter *msg_iter)
+{
+	struct shm_src_stream *stream = read_obj(msg_iter,
+		SHM_WIRE_OBJ_KIND_STREAM);
+	bt_message *msg = NULL;
+
+	if (!stream) {
+		goto end;
+	}
+
+	if (!stream->packet) {
+		BT_COMP_LOGE_APPEND_CAUSE(msg_iter->self_comp,
+			"Unexpected packet end record in shared memory ring: "
+			"stream-id=%" PRIu64, bt_stream_get_id(stream->stream));
+		goto end;
+	}
+
+	if (bt_stream_class_packets_have_end_default_clock_snapshot(
+			bt_stream_borrow_class_const(stream->stream))) {
+		msg = bt_message_packet_end_create_with_default_clock_snapshot(
+			msg_iter->self_msg_iter, stream->packet,
+			read_clock_snapshot(msg_iter));
+	} else {
+		msg = bt_message_packet_end_create(msg_iter->self_msg_iter,
+			stream->packet);
+	}
+
+	if (!msg) {
+		BT_COMP_LOGE_APPEND_CAUSE(msg_iter->self_comp,
+			"Cannot create packet end message.");
+		goto end;
+	}
+
+	if (check_reader(msg_iter, "packet end")) {
+		BT_MESSAGE_PUT_REF_AND_RESET(msg);
+		goto end;
+	}
+
+	BT_PACKET_PUT_REF_AND_RESET(stream->packet);
+
+end:
+	return msg;
+}
+
+static
+bt_message *read_discarded_items_record(struct shm_src_msg_iter *msg_iter,
+		bool is_events)
+{
+	struct shm_src_stream *stream = read_obj(msg_iter,
+		SHM_WIRE_OBJ_KIND_STREAM);
+	const bt_stream_class *sc;
+	bt_message *msg = NULL;
+	bool with_cs;
+
+	if (!stream) {
+		goto error;
+	}
+
+	sc = bt_stream_borrow_class_const(stream->stream);
+
+	if (is_events) {
+		with_cs = bt_stream_class_discarded_events_have_default_clock_snapshots(
+			sc);
+	} else {
+		with_cs = bt_stream_class_discarded_packets_have_default_clock_snapshots(
+			sc);
+	}
+
+	if (with_cs) {
+		uint64_t beginning_cs = read_clock_snapshot(msg_iter);
+		uint64_t end_cs = read_clock_snapshot(msg_iter);
+
+		if (is_events) {
+			msg = bt_message_discarded_events_create_with_default_clock_snapshots(
+				msg_iter->self_msg_iter, stream->stream,
+				beginning_cs, end_cs);
+		} else {
+			msg = bt_message_discarded_packets_create_with_default_clock_snapshots(
+				msg_iter->self_msg_iter, stream->stream,
+				beginning_cs, end_cs);
+		}
+	} else {
+		if (is_events) {
+			msg = bt_message_discarded_events_create(
+				msg_iter->self_msg_iter, stream->stream);
+		} else {
+			msg = bt_message_discarded_packets_create(
+				msg_iter->self_msg_iter, stream->stream);
+		}
+	}
+
+	if (!msg) {
+		BT_COMP_LOGE_APPEND_CAUSE(msg_iter->self_comp,
+			"Cannot create discarded %s message.",
+			is_events ? "events" : "packets");
+		goto error;
+	}
+
+	if (shm_wire_read_bool(&msg_iter->reader)) {
+		uint64_t count = shm_wire_read_uint(&msg_iter->reader);
+
+		if (count == 0) {
+			msg_iter->reader.error = true;
+		} else if (is_events) {
+			bt_message_discarded_events_set_count(msg, count);
+		} else {
+			bt_message_discarded_packets_set_count(msg, count);
+		}
+	}
+
+	if (check_reader(msg_iter, "discarded items")) {
+		goto error;
+	}
+
+	goto end;
+
+error:
+	BT_MESSAGE_PUT_REF_AND_RESET(msg);
+
+end:
+	return msg;
+}
+
+static
+bt_message *read_msg_iter_inactivity_record(
+		struct shm_src_msg_iter *msg_iter)
+{
+	bt_clock_class *cc = read_obj(msg_iter, SHM_WIRE_OBJ_KIND_CLOCK_CLASS);
+	uint64_t cs = shm_wire_read_uint(&msg_iter->reader);
+	bt_message *msg = NULL;
+
+	if (!cc || check_reader(msg_iter, "message iterator inactivity")) {
+		goto end;
+	}
+
+	msg = bt_message_message_iterator_inactivity_create(
+		msg_iter->self_msg_iter, cc, cs);
+	if (!msg) {
+		BT_COMP_LOGE_APPEND_CAUSE(msg_iter->self_comp,
+			"Cannot create message iterator inactivity message.");
+	}
+
+end:
+	return msg;
+}
+
+/*
+ * Reads the next wire record of the current ring record.
+ *
+ * Sets `*msg` to a new message if the wire record is a message.
+ */
+static
+int read_record(struct shm_src_msg_iter *msg_iter, bt_message **msg)
+{
+	uint64_t type = shm_wire_read_uint(&msg_iter->reader);
+	int ret = 0;
+
+	*msg = NULL;
+
+	switch (type) {
+	case SHM_WIRE_RECORD_TYPE_CLOCK_CLASS:
+		ret = read_clock_class_record(msg_iter);
+		break;
+	case SHM_WIRE_RECORD_TYPE_TRACE_CLASS:
+		ret = read_trace_class_record(msg_iter);
+		break;
+	case SHM_WIRE_RECORD_TYPE_TRACE:
+		ret = read_trace_record(msg_iter);
+		break;
+	case SHM_WIRE_RECORD_TYPE_STREAM_CLASS:
+		ret = read_stream_class_record(msg_iter);
+		break;
+	case SHM_WIRE_RECORD_TYPE_EVENT_CLASS:
+		ret = read_event_class_record(msg_iter);
+		break;
+	case SHM_WIRE_RECORD_TYPE_STREAM:
+		ret = read_stream_record(msg_iter);
+		break;
+	case SHM_WIRE_RECORD_TYPE_EVENT:
+		*msg = read_event_record(msg_iter);
+		break;
+	case SHM_WIRE_RECORD_TYPE_STREAM_BEGINNING:
+		*msg = read_stream_record_msg(msg_iter, true);
+		break;
+	case SHM_WIRE_RECORD_TYPE_STREAM_END:
+		*msg = read_stream_record_msg(msg_iter, false);
+		break;
+	case SHM_WIRE_RECORD_TYPE_PACKET_BEGINNING:
+		*msg = read_packet_beginning_record(msg_iter);
+		break;
+	case SHM_WIRE_RECORD_TYPE_PACKET_END:
+		*msg = read_packet_end_record(msg_iter);
+		break;
+	case SHM_WIRE_RECORD_TYPE_DISCARDED_EVENTS:
+		*msg = read_discarded_items_record(msg_iter, true);
+		break;
+	case SHM_WIRE_RECORD_TYPE_DISCARDED_PACKETS:
+		*msg = read_discarded_items_record(msg_iter, false);
+		break;
+	case SHM_WIRE_RECORD_TYPE_MSG_ITER_INACTIVITY:
+		*msg = read_msg_iter_inactivity_record(msg_iter);
+		break;
+	case SHM_WIRE_RECORD_TYPE_END:
+		if (!shm_wire_reader_is_done(&msg_iter->reader)) {
+			BT_COMP_LOGE_APPEND_CAUSE(msg_iter->self_comp,
+				"Unexpected data after end record in shared memory ring.");
+			ret = -1;
+			break;
+		}
+
+		BT_COMP_LOGI_STR("Read end record from shared memory ring.");
+		msg_iter->ended = true;
+		break;
+	default:
+		(void) check_reader(msg_iter, "record type");
+		BT_COMP_LOGE_APPEND_CAUSE(msg_iter->self_comp,
+			"Unknown record type in shared memory ring: "
+			"type=%" PRIu64, type);
+		ret = -1;
+		break;
+	}
+
+	if (type >= SHM_WIRE_RECORD_TYPE_STREAM_BEGINNING &&
+			type < SHM_WIRE_RECORD_TYPE_END && !*msg) {
+		ret = -1;
+	}
+
+	return ret;
+}
+
+BT_HIDDEN
+bt_message_iterator_class_next_method_status shm_src_msg_iter_next(
+		bt_self_message_iterator *self_msg_iter,
+		bt_message_array_const msgs, uint64_t capacity,
+		uint64_t *count)
+{
+	bt_message_iterator_class_next_method_status status =
+		BT_MESSAGE_ITERATOR_CLASS_NEXT_METHOD_STATUS_OK;
+	struct shm_src_msg_iter *msg_iter =
+		bt_self_message_iterator_get_data(self_msg_iter);
+	uint64_t i = 0;
+
+	BT_ASSERT_DBG(msg_iter);
+
+	while (i < capacity) {
+		bt_message *msg;
+
+		if (shm_wire_reader_is_done(&msg_iter->reader)) {
+			enum shm_ring_status ring_status;
+
+			/* Return what's ready instead of waiting */
+			if (i > 0) {
+				break;
+			}
+
+			if (msg_iter->ended) {
+				status = BT_MESSAGE_ITERATOR_CLASS_NEXT_METHOD_STATUS_END;
+				goto end;
+			}
+
+			ring_status = shm_ring_read(&msg_iter->shm_src->ring,
+				msg_iter->buf, READ_TIMEOUT_US);
+			switch (ring_status) {
+			case SHM_RING_STATUS_OK:
+				shm_wire_reader_init(&msg_iter->reader,
+					msg_iter->buf->data,
+					msg_iter->buf->len);
+				continue;
+			case SHM_RING_STATUS_AGAIN:
+				/*
+				 * This already waited for the producer:
+				 * it's worth calling this again
+				 * immediately.
+				 */
+				bt_self_message_iterator_set_wait_timeout(
+					self_msg_iter, 0);
+				status = BT_MESSAGE_ITERATOR_CLASS_NEXT_METHOD_STATUS_AGAIN;
+				goto end;
+			case SHM_RING_STATUS_END:
+				BT_COMP_LOGE_APPEND_CAUSE(msg_iter->self_comp,
+					"Producer detached from the shared memory ring before its end: "
+					"ring-name=\"%s\"",
+					msg_iter->shm_src->ring.name->str);
+				status = BT_MESSAGE_ITERATOR_CLASS_NEXT_METHOD_STATUS_ERROR;
+				goto end;
+			default:
+				BT_COMP_LOGE_APPEND_CAUSE(msg_iter->self_comp,
+					"Cannot read from the shared memory ring: "
+					"ring-name=\"%s\", status=%s",
+					msg_iter->shm_src->ring.name->str,
+					shm_ring_status_string(ring_status));
+				status = BT_MESSAGE_ITERATOR_CLASS_NEXT_METHOD_STATUS_ERROR;
+				goto end;
+			}
+		}
+
+		if (read_record(msg_iter, &msg)) {
+			status = BT_MESSAGE_ITERATOR_CLASS_NEXT_METHOD_STATUS_ERROR;
+			goto end;
+		}
+
+		if (msg) {
+			msgs[i] = msg;
+			i++;
+		}
+	}
+
+end:
+	if (status == BT_MESSAGE_ITERATOR_CLASS_NEXT_METHOD_STATUS_OK) {
+		*count = i;
+	} else {
+		uint64_t j;
+
+		for (j = 0; j < i; j++) {
+			bt_message_put_ref(msgs[j]);
+		}
+	}
+
+	return status;
+}
+
+static
+void destroy_shm_src_msg_iter(struct shm_src_msg_iter *msg_iter)
+{
+	unsigned int i;
+
+	if (!msg_iter) {
+		goto end;
+	}
+
+	/* Streams first: they hold references on the classes */
+	for (i = SHM_WIRE_OBJ_KIND_COUNT; i > 0; i--) {
+		if (msg_iter->objs[i - 1]) {
+			g_ptr_array_free(msg_iter->objs[i - 1], TRUE);
+		}
+	}
+
+	if (msg_iter->buf) {
+		g_byte_array_free(msg_iter->buf, TRUE);
+	}
+
+	if (msg_iter->fp_key) {
+		g_string_free(msg_iter->fp_key, TRUE);
+	}
+
+	g_free(msg_iter);
+
+end:
+	return;
+}
+
+BT_HIDDEN
+bt_message_iterator_class_initialize_method_status shm_src_msg_iter_init(
+		bt_self_message_iterator *self_msg_iter,
+		__attribute__((unused)) bt_self_message_iterator_configuration *config,
+		__attribute__((unused)) bt_self_component_port_output *self_port)
+{
+	bt_message_iterator_class_initialize_method_status status;
+	bt_self_component *self_comp =
+		bt_self_message_iterator_borrow_component(self_msg_iter);
+	struct shm_src_comp *shm_src = bt_self_component_get_data(self_comp);
+	struct shm_src_msg_iter *msg_iter;
+	static GDestroyNotify destroy_funcs[SHM_WIRE_OBJ_KIND_COUNT] = {
+		[SHM_WIRE_OBJ_KIND_CLOCK_CLASS] =
+			(GDestroyNotify) bt_clock_class_put_ref,
+		[SHM_WIRE_OBJ_KIND_TRACE_CLASS] =
+			(GDestroyNotify) bt_trace_class_put_ref,
+		[SHM_WIRE_OBJ_KIND_TRACE] = (GDestroyNotify) bt_trace_put_ref,
+		[SHM_WIRE_OBJ_KIND_STREAM_CLASS] =
+			(GDestroyNotify) destroy_stream_class,
+		[SHM_WIRE_OBJ_KIND_EVENT_CLASS] =
+			(GDestroyNotify) bt_event_class_put_ref,
+		[SHM_WIRE_OBJ_KIND_STREAM] = (GDestroyNotify) destroy_stream,
+	};
+	unsigned int i;
+
+	msg_iter = g_new0(struct shm_src_msg_iter, 1);
+	if (!msg_iter) {
+		BT_COMP_LOG_CUR_LVL(BT_LOG_ERROR, shm_src->log_level, self_comp,
+			"Failed to allocate one shared memory message iterator structure.");
+		status = BT_MESSAGE_ITERATOR_CLASS_INITIALIZE_METHOD_STATUS_MEMORY_ERROR;
+		goto end;
+	}
+
+	msg_iter->shm_src = shm_src;
+	msg_iter->self_msg_iter = self_msg_iter;
+	msg_iter->log_level = shm_src->log_level;
+	msg_iter->self_comp = self_comp;
+
+	if (shm_src->has_msg_iter) {
+		BT_COMP_LOGE_APPEND_CAUSE(self_comp,
+			"A message iterator already reads the shared memory ring: "
+			"ring-name=\"%s\"", shm_src->ring.name->str);
+		status = BT_MESSAGE_ITERATOR_CLASS_INITIALIZE_METHOD_STATUS_ERROR;
+		goto error;
+	}
+
+	msg_iter->buf = g_byte_array_new();
+	msg_iter->fp_key = g_string_new(NULL);
+	if (!msg_iter->buf || !msg_iter->fp_key) {
+		BT_COMP_LOGE_APPEND_CAUSE(self_comp,
+			"Failed to allocate buffers.");
+		status = BT_MESSAGE_ITERATOR_CLASS_INITIALIZE_METHOD_STATUS_MEMORY_ERROR;
+		goto error;
+	}
+
+	for (i = 0; i < SHM_WIRE_OBJ_KIND_COUNT; i++) {
+		msg_iter->objs[i] = g_ptr_array_new_with_free_func(
+			destroy_funcs[i]);
+		if (!msg_iter->objs[i]) {
+			BT_COMP_LOGE_APPEND_CAUSE(self_comp,
+				"Failed to allocate a GPtrArray.");
+			status = BT_MESSAGE_ITERATOR_CLASS_INITIALIZE_METHOD_STATUS_MEMORY_ERROR;
+			goto error;
+		}
+	}
+
+	shm_wire_reader_init(&msg_iter->reader, NULL, 0);
+	shm_src->has_msg_iter = true;
+	bt_self_message_iterator_set_data(self_msg_iter, msg_iter);
+	status = BT_MESSAGE_ITERATOR_CLASS_INITIALIZE_METHOD_STATUS_OK;
+	goto end;
+
+error:
+	destroy_shm_src_msg_iter(msg_iter);
+
+end:
+	return status;
+}
+
+BT_HIDDEN
+void shm_src_msg_iter_finalize(bt_self_message_iterator *self_msg_iter)
+{
+	struct shm_src_msg_iter *msg_iter =
+		bt_self_message_iterator_get_data(self_msg_iter);
+
+	msg_iter->shm_src->has_msg_iter = false;
+	destroy_shm_src_msg_iter(msg_iter);
+}
+
+static
+struct bt_param_validation_map_value_entry_descr shm_src_params[] = {
+	{ "name", BT_PARAM_VALIDATION_MAP_VALUE_ENTRY_MANDATORY, { .type = BT_VALUE_TYPE_STRING } },
+	{ "size", BT_PARAM_VALIDATION_MAP_VALUE_ENTRY_OPTIONAL, { .type = BT_VALUE_TYPE_UNSIGNED_INTEGER } },
+	BT_PARAM_VALIDATION_MAP_VALUE_ENTRY_END
+};
+
+static
+void destroy_shm_src_data(struct shm_src_comp *shm_src)
+{
+	if (!shm_src) {
+		return;
+	}
+
+	if (shm_src->ring_is_attached) {
+		shm_ring_detach(&shm_src->ring);
+	}
+
+	g_free(shm_src);
+}
+
+BT_HIDDEN
+bt_component_class_initialize_method_status shm_src_init(
+		bt_self_component_source *self_comp_src,
+		__attribute__((unused)) bt_self_component_source_configuration *config,
+		const bt_value *params,
+		__attribute__((unused)) void *init_method_data)
+{
+	bt_component_class_initialize_method_status status;
+	bt_self_component_add_port_status add_port_status;
+	bt_self_component *self_comp =
+		bt_self_component_source_as_self_component(self_comp_src);
+	bt_logging_level log_level = bt_component_get_logging_level(
+		bt_self_component_as_component(self_comp));
+	struct shm_src_comp *shm_src = g_new0(struct shm_src_comp, 1);
+	enum bt_param_validation_status validation_status;
+	gchar *validate_error = NULL;
+	const bt_value *val;
+	uint64_t size = SHM_RING_DEFAULT_SIZE;
+
+	if (!shm_src) {
+		BT_COMP_LOG_CUR_LVL(BT_LOG_ERROR, log_level, self_comp,
+			"Failed to allocate one shared memory source structure.");
+		status = BT_COMPONENT_CLASS_INITIALIZE_METHOD_STATUS_MEMORY_ERROR;
+		goto end;
+	}
+
+	shm_src->log_level = log_level;
+	shm_src->self_comp = self_comp;
+
+	validation_status = bt_param_validation_validate(params,
+		shm_src_params, &validate_error);
+	if (validation_status == BT_PARAM_VALIDATION_STATUS_MEMORY_ERROR) {
+		status = BT_COMPONENT_CLASS_INITIALIZE_METHOD_STATUS_MEMORY_ERROR;
+		goto error;
+	} else if (validation_status == BT_PARAM_VALIDATION_STATUS_VALIDATION_ERROR) {
+		status = BT_COMPONENT_CLASS_INITIALIZE_METHOD_STATUS_ERROR;
+		BT_COMP_LOG_CUR_LVL(BT_LOG_ERROR, log_level, self_comp, "%s",
+			validate_error);
+		(void) BT_CURRENT_THREAD_ERROR_APPEND_CAUSE_FROM_COMPONENT(
+			self_comp, "%s", validate_error);
+		goto error;
+	}
+
+	val = bt_value_map_borrow_entry_value_const(params, "size");
+	if (val) {
+		size = bt_value_integer_unsigned_get(val);
+	}
+
+	val = bt_value_map_borrow_entry_value_const(params, "name");
+	if (shm_ring_attach(&shm_src->ring, bt_value_string_get(val), size,
+			SHM_RING_ROLE_CONSUMER, log_level, self_comp)) {
+		BT_COMP_LOG_CUR_LVL(BT_LOG_ERROR, log_level, self_comp,
+			"Cannot attach to shared memory ring: name=\"%s\"",
+			bt_value_string_get(val));
+		(void) BT_CURRENT_THREAD_ERROR_APPEND_CAUSE_FROM_COMPONENT(
+			self_comp,
+			"Cannot attach to shared memory ring: name=\"%s\"",
+			bt_value_string_get(val));
+		status = BT_COMPONENT_CLASS_INITIALIZE_METHOD_STATUS_ERROR;
+		goto error;
+	}
+
+	shm_src->ring_is_attached = true;
+
+	add_port_status = bt_self_component_source_add_output_port(
+		self_comp_src, "out", NULL, NULL);
+	if (add_port_status != BT_SELF_COMPONENT_ADD_PORT_STATUS_OK) {
+		status = (int) add_port_status;
+		goto error;
+	}
+
+	bt_self_component_set_data(self_comp, shm_src);
+	status = BT_COMPONENT_CLASS_INITIALIZE_METHOD_STATUS_OK;
+	goto end;
+
+error:
+	destroy_shm_src_data(shm_src);
+
+end:
+	g_free(validate_error);
+	return status;
+}
+
+BT_HIDDEN
+void shm_src_finalize(bt_self_component_source *self_comp_src)
+{
+	destroy_shm_src_data(bt_self_component_get_data(
+		bt_self_component_source_as_self_component(self_comp_src)));
+}
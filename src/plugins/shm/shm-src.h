@@ -0,0 +1,138 @@
+#ifndef BABELTRACE_PLUGINS_SHM_SHM_SRC_H
+#define BABELTRACE_PLUGINS_SHM_SHM_SRC_H
+
+/*
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <glib.h>
+#include <babeltrace2/babeltrace.h>
+#include "common/macros.h"
+
+#include "ring.h"
+#include "wire.h"
+
+struct shm_src_comp {
+	bt_logging_level log_level;
+
+	/* Weak */
+	bt_self_component *self_comp;
+
+	struct shm_ring ring;
+	bool ring_is_attached;
+
+	/* True if a message iterator reads the ring */
+	bool has_msg_iter;
+};
+
+struct shm_src_stream_class {
+	/* Owned by this */
+	bt_stream_class *sc;
+
+	/*
+	 * Field path key (owned `char *`, see `wire.h`) to packet
+	 * context or event common context field class (weak; owned by
+	 * `sc`) which can be the target of a field path.
+	 */
+	GHashTable *fcs_by_key;
+};
+
+struct shm_src_stream {
+	/* Owned by this */
+	bt_stream *stream;
+
+	/* Current packet (owned by this), if any */
+	bt_packet *packet;
+};
+
+struct shm_src_msg_iter {
+	/* Weak */
+	struct shm_src_comp *shm_src;
+
+	/* Weak */
+	bt_self_message_iterator *self_msg_iter;
+
+	bt_logging_level log_level;
+
+	/* Weak */
+	bt_self_component *self_comp;
+
+	/* Current ring record and read cursor within it */
+	GByteArray *buf;
+	struct shm_wire_reader reader;
+
+	/*
+	 * Handle (index) to metadata object, one array per
+	 * `enum shm_wire_obj_kind`:
+	 *
+	 * `SHM_WIRE_OBJ_KIND_CLOCK_CLASS`:
+	 *     `bt_clock_class *` (owned)
+	 *
+	 * `SHM_WIRE_OBJ_KIND_TRACE_CLASS`:
+	 *     `bt_trace_class *` (owned)
+	 *
+	 * `SHM_WIRE_OBJ_KIND_TRACE`:
+	 *     `bt_trace *` (owned)
+	 *
+	 * `SHM_WIRE_OBJ_KIND_STREAM_CLASS`:
+	 *     `struct shm_src_stream_class *` (owned)
+	 *
+	 * `SHM_WIRE_OBJ_KIND_EVENT_CLASS`:
+	 *     `bt_event_class *` (owned)
+	 *
+	 * `SHM_WIRE_OBJ_KIND_STREAM`:
+	 *     `struct shm_src_stream *` (owned), or `NULL` once the
+	 *     stream ended
+	 */
+	GPtrArray *objs[SHM_WIRE_OBJ_KIND_COUNT];
+
+	/* Temporary field path key */
+	GString *fp_key;
+
+	/* True once this iterator read the producer's end record */
+	bool ended;
+};
+
+BT_HIDDEN
+bt_component_class_initialize_method_status shm_src_init(
+		bt_self_component_source *self_comp,
+		bt_self_component_source_configuration *config,
+		const bt_value *params, void *init_method_data);
+
+BT_HIDDEN
+void shm_src_finalize(bt_self_component_source *self_comp);
+
+BT_HIDDEN
+bt_message_iterator_class_initialize_method_status shm_src_msg_iter_init(
+		bt_self_message_iterator *self_msg_iter,
+		bt_self_message_iterator_configuration *config,
+		bt_self_component_port_output *self_port);
+
+BT_HIDDEN
+void shm_src_msg_iter_finalize(bt_self_message_iterator *self_msg_iter);
+
+BT_HIDDEN
+bt_message_iterator_class_next_method_status shm_src_msg_iter_next(
+		bt_self_message_iterator *self_msg_iter,
+		bt_message_array_const msgs, uint64_t capacity,
+		uint64_t *count);
+
+#endif /* BABELTRACE_PLUGINS_SHM_SHM_SRC_H */
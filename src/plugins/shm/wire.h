@@ -0,0 +1,363 @@
+#ifndef BABELTRACE_PLUGINS_SHM_WIRE_H
+#define BABELTRACE_PLUGINS_SHM_WIRE_H
+
+/*
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <glib.h>
+
+/*
+ * Encoding of the records which `sink.shm.ring` writes to a shared
+ * memory ring and which `source.shm.ring` reads.
+ *
+ * A ring record contains one or more wire records. A wire record
+ * starts with its type (`enum shm_wire_record_type`, as an unsigned
+ * integer) followed by its type-specific content.
+ *
+ * Both sides run on the same machine: the encoding does not need to be
+ * portable. Integers are LEB128 variable-length integers (signed ones
+ * zigzag-encoded first), real numbers are copied as is, and strings
+ * are a variable-length integer (0 for no string, or the string's
+ * length plus one) followed by the string's bytes and a null
+ * character.
+ *
+ * Metadata objects (clock classes, trace classes, traces, stream
+ * classes, event classes, and streams) are sent once, each one with a
+ * handle, unique per object kind, which subsequent records use to
+ * refer to them.
+ */
+
+enum shm_wire_record_type {
+	/* Metadata */
+	SHM_WIRE_RECORD_TYPE_CLOCK_CLASS		= 1,
+	SHM_WIRE_RECORD_TYPE_TRACE_CLASS		= 2,
+	SHM_WIRE_RECORD_TYPE_TRACE			= 3,
+	SHM_WIRE_RECORD_TYPE_STREAM_CLASS		= 4,
+	SHM_WIRE_RECORD_TYPE_EVENT_CLASS		= 5,
+	SHM_WIRE_RECORD_TYPE_STREAM			= 6,
+
+	/* Messages */
+	SHM_WIRE_RECORD_TYPE_STREAM_BEGINNING		= 16,
+	SHM_WIRE_RECORD_TYPE_STREAM_END			= 17,
+	SHM_WIRE_RECORD_TYPE_PACKET_BEGINNING		= 18,
+	SHM_WIRE_RECORD_TYPE_PACKET_END			= 19,
+	SHM_WIRE_RECORD_TYPE_EVENT			= 20,
+	SHM_WIRE_RECORD_TYPE_DISCARDED_EVENTS		= 21,
+	SHM_WIRE_RECORD_TYPE_DISCARDED_PACKETS		= 22,
+	SHM_WIRE_RECORD_TYPE_MSG_ITER_INACTIVITY	= 23,
+
+	/* The producer has no more messages */
+	SHM_WIRE_RECORD_TYPE_END			= 32,
+};
+
+/* Kinds of metadata objects which have a handle */
+enum shm_wire_obj_kind {
+	SHM_WIRE_OBJ_KIND_CLOCK_CLASS,
+	SHM_WIRE_OBJ_KIND_TRACE_CLASS,
+	SHM_WIRE_OBJ_KIND_TRACE,
+	SHM_WIRE_OBJ_KIND_STREAM_CLASS,
+	SHM_WIRE_OBJ_KIND_EVENT_CLASS,
+	SHM_WIRE_OBJ_KIND_STREAM,
+	SHM_WIRE_OBJ_KIND_COUNT,
+};
+
+/*
+ * Field path key steps for the current array element and for the
+ * current option content (see shm_wire_field_path_key_append_char()).
+ */
+#define SHM_WIRE_FIELD_PATH_KEY_CURRENT_ARRAY_ELEMENT	'e'
+#define SHM_WIRE_FIELD_PATH_KEY_CURRENT_OPTION_CONTENT	'o'
+
+/* Writing */
+
+static inline
+void shm_wire_write_uint(GByteArray *buf, uint64_t val)
+{
+	uint8_t bytes[10];
+	unsigned int len = 0;
+
+	do {
+		uint8_t byte = val & 0x7f;
+
+		val >>= 7;
+
+		if (val != 0) {
+			byte |= 0x80;
+		}
+
+		bytes[len++] = byte;
+	} while (val != 0);
+
+	g_byte_array_append(buf, bytes, len);
+}
+
+static inline
+void shm_wire_write_int(GByteArray *buf, int64_t val)
+{
+	shm_wire_write_uint(buf,
+		((uint64_t) val << 1) ^ (uint64_t) (val >> 63));
+}
+
+static inline
+void shm_wire_write_bool(GByteArray *buf, bool val)
+{
+	uint8_t byte = val ? 1 : 0;
+
+	g_byte_array_append(buf, &byte, 1);
+}
+
+static inline
+void shm_wire_write_bytes(GByteArray *buf, const void *data, size_t size)
+{
+	g_byte_array_append(buf, data, size);
+}
+
+static inline
+void shm_wire_write_double(GByteArray *buf, double val)
+{
+	shm_wire_write_bytes(buf, &val, sizeof(val));
+}
+
+static inline
+void shm_wire_write_float(GByteArray *buf, float val)
+{
+	shm_wire_write_bytes(buf, &val, sizeof(val));
+}
+
+/* `str` may be `NULL` */
+static inline
+void shm_wire_write_string(GByteArray *buf, const char *str)
+{
+	size_t len;
+
+	if (!str) {
+		shm_wire_write_uint(buf, 0);
+		return;
+	}
+
+	len = strlen(str);
+	shm_wire_write_uint(buf, len + 1);
+	shm_wire_write_bytes(buf, str, len + 1);
+}
+
+/* `uuid` may be `NULL` */
+static inline
+void shm_wire_write_uuid(GByteArray *buf, const uint8_t *uuid)
+{
+	shm_wire_write_bool(buf, uuid);
+
+	if (uuid) {
+		shm_wire_write_bytes(buf, uuid, 16);
+	}
+}
+
+/* Reading */
+
+struct shm_wire_reader {
+	const uint8_t *data;
+	size_t size;
+	size_t offset;
+
+	/*
+	 * True if a read function tried to read past the end of the
+	 * data or found malformed data: the read functions then
+	 * return zeros.
+	 */
+	bool error;
+};
+
+static inline
+void shm_wire_reader_init(struct shm_wire_reader *reader,
+		const uint8_t *data, size_t size)
+{
+	reader->data = data;
+	reader->size = size;
+	reader->offset = 0;
+	reader->error = false;
+}
+
+static inline
+bool shm_wire_reader_is_done(struct shm_wire_reader *reader)
+{
+	return reader->error || reader->offset == reader->size;
+}
+
+/*
+ * Returns the address of the next `size` bytes of `reader` and skips
+ * them, or `NULL` on error.
+ */
+static inline
+const uint8_t *shm_wire_read_bytes(struct shm_wire_reader *reader,
+		size_t size)
+{
+	const uint8_t *bytes = NULL;
+
+	if (reader->error || size > reader->size - reader->offset) {
+		reader->error = true;
+		goto end;
+	}
+
+	bytes = &reader->data[reader->offset];
+	reader->offset += size;
+
+end:
+	return bytes;
+}
+
+static inline
+uint64_t shm_wire_read_uint(struct shm_wire_reader *reader)
+{
+	uint64_t val = 0;
+	unsigned int shift = 0;
+
+	while (true) {
+		const uint8_t *byte = shm_wire_read_bytes(reader, 1);
+
+		if (!byte || shift > 63) {
+			reader->error = true;
+			val = 0;
+			break;
+		}
+
+		val |= (uint64_t) (*byte & 0x7f) << shift;
+
+		if (!(*byte & 0x80)) {
+			break;
+		}
+
+		shift += 7;
+	}
+
+	return val;
+}
+
+static inline
+int64_t shm_wire_read_int(struct shm_wire_reader *reader)
+{
+	uint64_t val = shm_wire_read_uint(reader);
+
+	return (int64_t) ((val >> 1) ^ -(val & 1));
+}
+
+static inline
+bool shm_wire_read_bool(struct shm_wire_reader *reader)
+{
+	const uint8_t *byte = shm_wire_read_bytes(reader, 1);
+
+	return byte && *byte;
+}
+
+static inline
+double shm_wire_read_double(struct shm_wire_reader *reader)
+{
+	const uint8_t *bytes = shm_wire_read_bytes(reader, sizeof(double));
+	double val = 0;
+
+	if (bytes) {
+		memcpy(&val, bytes, sizeof(val));
+	}
+
+	return val;
+}
+
+static inline
+float shm_wire_read_float(struct shm_wire_reader *reader)
+{
+	const uint8_t *bytes = shm_wire_read_bytes(reader, sizeof(float));
+	float val = 0;
+
+	if (bytes) {
+		memcpy(&val, bytes, sizeof(val));
+	}
+
+	return val;
+}
+
+/*
+ * Returns the next string of `reader` (within its data, so valid as
+ * long as its data is), or `NULL` if there's no string or on error.
+ */
+static inline
+const char *shm_wire_read_string(struct shm_wire_reader *reader)
+{
+	uint64_t len_plus_one = shm_wire_read_uint(reader);
+	const char *str = NULL;
+
+	if (len_plus_one == 0) {
+		goto end;
+	}
+
+	str = (const char *) shm_wire_read_bytes(reader, len_plus_one);
+	if (str && str[len_plus_one - 1] != '\0') {
+		reader->error = true;
+		str = NULL;
+	}
+
+end:
+	return str;
+}
+
+/* Returns the next UUID of `reader`, or `NULL` if there's none */
+static inline
+const uint8_t *shm_wire_read_uuid(struct shm_wire_reader *reader)
+{
+	const uint8_t *uuid = NULL;
+
+	if (shm_wire_read_bool(reader)) {
+		uuid = shm_wire_read_bytes(reader, 16);
+	}
+
+	return uuid;
+}
+
+/* Field path keys */
+
+/*
+ * A field path key is a string which identifies a field class within
+ * the field classes of a stream class or of an event class: the root
+ * scope's number followed by, for each step, `/` and either the index
+ * of a structure member or of a variant option, or
+ * `SHM_WIRE_FIELD_PATH_KEY_CURRENT_ARRAY_ELEMENT`, or
+ * `SHM_WIRE_FIELD_PATH_KEY_CURRENT_OPTION_CONTENT`, for example
+ * `3/2/e/0`.
+ *
+ * The producer sends the field paths of dynamic array length and of
+ * option/variant selector field classes as keys, and the consumer finds
+ * the field classes it created for them with the same keys.
+ */
+static inline
+void shm_wire_field_path_key_append_index(GString *key, uint64_t index)
+{
+	g_string_append_printf(key, "/%" PRIu64, index);
+}
+
+static inline
+void shm_wire_field_path_key_append_char(GString *key, char c)
+{
+	g_string_append_c(key, '/');
+	g_string_append_c(key, c);
+}
+
+#endif /* BABELTRACE_PLUGINS_SHM_WIRE_H */
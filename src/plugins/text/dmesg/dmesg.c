@@ -32,11 +32,13 @@
 #include <string.h>
 #include <ctype.h>
 #include <stdio.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
 #include "common/common.h"
 #include "common/assert.h"
 #include <babeltrace2/babeltrace.h>
 #include "compat/utc.h"
-#include "compat/stdio.h"
 #include <glib.h>
 #include "plugins/common/param-validation/param-validation.h"
 
@@ -45,6 +47,12 @@
 #define NSEC_PER_SEC 1000000000ULL
 #define USEC_PER_SEC 1000000UL
 
+/*
+ * Initial size of a message iterator's input buffer. The buffer grows
+ * (doubles) when a single line does not fit.
+ */
+#define INPUT_BUF_INIT_SIZE (1024 * 1024)
+
 struct dmesg_component;
 
 struct dmesg_msg_iter {
@@ -53,9 +61,25 @@ struct dmesg_msg_iter {
 	/* Weak */
 	bt_self_message_iterator *self_msg_iter;
 
-	char *linebuf;
-	size_t linebuf_len;
-	FILE *fp;
+	/* Input file descriptor (`STDIN_FILENO` when reading stdin) */
+	int fd;
+
+	/*
+	 * Input buffer, filled with big read() calls: lines are found
+	 * within it with memchr() instead of being read one character
+	 * at a time.
+	 *
+	 * `buf_len` is the number of valid bytes in `buf`, and
+	 * `buf_pos` is the offset of the next line to consume. There's
+	 * always at least one spare byte after `buf_len` so that the
+	 * last line can be null-terminated in place.
+	 */
+	char *buf;
+	size_t buf_size;
+	size_t buf_len;
+	size_t buf_pos;
+	bool input_eof;
+
 	bt_message *tmp_event_msg;
 	uint64_t last_clock_value;
 
@@ -459,6 +483,137 @@ void dmesg_finalize(bt_self_component_source *self_comp)
 		bt_self_component_source_as_self_component(self_comp)));
 }
 
+/*
+ * Parses an unsigned decimal integer at `*pos`, skipping any leading
+ * space or tab character (like the scanf(3) `%u` conversion does), and
+ * advances `*pos` after the last digit.
+ *
+ * Returns `false` if there's no digit or if the value does not fit in
+ * 64 bits.
+ */
+static inline
+bool parse_uint(const char **pos, uint64_t *value)
+{
+	const char *ch = *pos;
+	uint64_t v = 0;
+	uint64_t digit;
+
+	while (*ch == ' ' || *ch == '\t') {
+		ch++;
+	}
+
+	if (*ch < '0' || *ch > '9') {
+		return false;
+	}
+
+	do {
+		digit = (uint64_t) (*ch - '0');
+		if (v > (UINT64_MAX - digit) / 10) {
+			return false;
+		}
+
+		v = v * 10 + digit;
+		ch++;
+	} while (*ch >= '0' && *ch <= '9');
+
+	*pos = ch;
+	*value = v;
+	return true;
+}
+
+static inline
+bool parse_uint_then_char(const char **pos, uint64_t *value, char exp_ch)
+{
+	if (!parse_uint(pos, value) || **pos != exp_ch) {
+		return false;
+	}
+
+	(*pos)++;
+	return true;
+}
+
+/*
+ * Hand-written parser for the two timestamp formats which `dmesg`
+ * writes:
+ *
+ *     [SEC.USEC]
+ *     [YEAR-MON-MDAY HOUR:MIN:SEC.MSEC]
+ *
+ * This is the fast path of create_init_event_msg_from_line(): on
+ * success, `*ts` is the timestamp (ns) and `*ts_end` points right after
+ * the closing `]`. Returns `false` if the line does not begin with
+ * one of those exact formats, in which case the caller falls back to
+ * the more lenient sscanf(3)-based parsing.
+ */
+static
+bool parse_timestamp_fast(const char *line, uint64_t *ts,
+		const char **ts_end)
+{
+	const char *ch = line;
+	uint64_t first;
+
+	if (*ch != '[') {
+		return false;
+	}
+
+	ch++;
+
+	if (!parse_uint(&ch, &first)) {
+		return false;
+	}
+
+	if (*ch == '.') {
+		uint64_t usec;
+
+		ch++;
+
+		if (!parse_uint_then_char(&ch, &usec, ']')) {
+			return false;
+		}
+
+		/*
+		 * The clock class we use has a 1 GHz frequency: convert
+		 * from µs to ns.
+		 */
+		*ts = (first * USEC_PER_SEC + usec) * NSEC_PER_USEC;
+	} else if (*ch == '-') {
+		uint64_t mon, mday, hour, min, sec, msec;
+		time_t ep_sec;
+		struct tm ti;
+
+		ch++;
+
+		if (!parse_uint_then_char(&ch, &mon, '-') ||
+				!parse_uint(&ch, &mday) ||
+				!parse_uint_then_char(&ch, &hour, ':') ||
+				!parse_uint_then_char(&ch, &min, ':') ||
+				!parse_uint_then_char(&ch, &sec, '.') ||
+				!parse_uint_then_char(&ch, &msec, ']')) {
+			return false;
+		}
+
+		memset(&ti, 0, sizeof(ti));
+		ti.tm_year = (int) first - 1900;	/* From 1900 */
+		ti.tm_mon = (int) mon - 1;		/* 0 to 11 */
+		ti.tm_mday = (int) mday;
+		ti.tm_hour = (int) hour;
+		ti.tm_min = (int) min;
+		ti.tm_sec = (int) sec;
+		*ts = 0;
+
+		ep_sec = bt_timegm(&ti);
+		if (ep_sec != (time_t) -1) {
+			*ts = (uint64_t) ep_sec * NSEC_PER_SEC
+				+ msec * NSEC_PER_MSEC;
+		}
+	} else {
+		return false;
+	}
+
+	*ts_end = ch;
+	return true;
+}
+
 static
 bt_message *create_init_event_msg_from_line(
 		struct dmesg_msg_iter *msg_iter,
@@ -480,7 +635,9 @@ bt_message *create_init_event_msg_from_line(
 	}
 
 	/* Extract time from input line */
-	if (sscanf(line, "[%lu.%lu] ", &sec, &usec) == 2) {
+	if (parse_timestamp_fast(line, &ts, new_start)) {
+		has_timestamp = true;
+	} else if (sscanf(line, "[%lu.%lu] ", &sec, &usec) == 2) {
 		ts = (uint64_t) sec * USEC_PER_SEC + (uint64_t) usec;
 
 		/*
@@ -513,10 +670,18 @@ bt_message *create_init_event_msg_from_line(
 	}
 
 	if (has_timestamp) {
-		/* Set new start for the message portion of the line */
-		*new_start = strchr(line, ']');
-		BT_ASSERT_DBG(*new_start);
-		(*new_start)++;
+		if (*new_start == line) {
+			/*
+			 * Slow path: set new start for the message
+			 * portion of the line.
+			 */
+			*new_start = strchr(line, ']');
+			if (!*new_start) {
+				*new_start = line + strlen(line);
+			} else {
+				(*new_start)++;
+			}
+		}
 
 		if ((*new_start)[0] == ' ') {
 			(*new_start)++;
@@ -563,11 +728,11 @@ end:
 
 static
 int fill_event_payload_from_line(struct dmesg_component *dmesg_comp,
-		const char *line, bt_event *event)
+		const char *line, size_t len, bt_event *event)
 {
 	bt_field *ep_field = NULL;
 	bt_field *str_field = NULL;
-	size_t len;
+	const char *nul;
 	int ret;
 
 	ep_field = bt_event_borrow_payload_field(event);
@@ -579,10 +744,10 @@ int fill_event_payload_from_line(struct dmesg_component *dmesg_comp,
 		goto error;
 	}
 
-	len = strlen(line);
-	if (line[len - 1] == '\n') {
-		/* Do not include the newline character in the payload */
-		len--;
+	/* A string field cannot contain a null character: truncate */
+	nul = memchr(line, '\0', len);
+	if (nul) {
+		len = nul - line;
 	}
 
 	bt_field_string_clear(str_field);
@@ -602,9 +767,13 @@ end:
 	return ret;
 }
 
+/*
+ * `line` is null-terminated and `len` excludes the newline character.
+ */
 static
 bt_message *create_msg_from_line(
-		struct dmesg_msg_iter *dmesg_msg_iter, const char *line)
+		struct dmesg_msg_iter *dmesg_msg_iter, const char *line,
+		size_t len)
 {
 	struct dmesg_component *dmesg_comp = dmesg_msg_iter->dmesg_comp;
 	bt_event *event = NULL;
@@ -621,7 +790,8 @@ bt_message *create_msg_from_line(
 
 	event = bt_message_event_borrow_event(msg);
 	BT_ASSERT_DBG(event);
-	ret = fill_event_payload_from_line(dmesg_comp, new_start, event);
+	ret = fill_event_payload_from_line(dmesg_comp, new_start,
+		len - (new_start - line), event);
 	if (ret) {
 		BT_COMP_LOGE("Cannot fill event payload field from line: "
 			"ret=%d", ret);
@@ -648,17 +818,133 @@ void destroy_dmesg_msg_iter(struct dmesg_msg_iter *dmesg_msg_iter)
 
 	dmesg_comp = dmesg_msg_iter->dmesg_comp;
 
-	if (dmesg_msg_iter->fp && dmesg_msg_iter->fp != stdin) {
-		if (fclose(dmesg_msg_iter->fp)) {
+	if (dmesg_msg_iter->fd >= 0 && dmesg_msg_iter->fd != STDIN_FILENO) {
+		if (close(dmesg_msg_iter->fd)) {
 			BT_COMP_LOGE_ERRNO("Cannot close input file", ".");
 		}
 	}
 
 	bt_message_put_ref(dmesg_msg_iter->tmp_event_msg);
-	free(dmesg_msg_iter->linebuf);
+	g_free(dmesg_msg_iter->buf);
 	g_free(dmesg_msg_iter);
 }
 
+/*
+ * Reads more data from the input file descriptor into the input
+ * buffer, first moving the unconsumed bytes to the beginning of the
+ * buffer and growing it if it's full.
+ *
+ * Sets `input_eof` when there's no more data to read.
+ *
+ * Returns 0 on success or -1 on error.
+ */
+static
+int fill_input_buf(struct dmesg_msg_iter *dmesg_msg_iter)
+{
+	struct dmesg_component *dmesg_comp = dmesg_msg_iter->dmesg_comp;
+	ssize_t read_len;
+	int ret = 0;
+
+	if (dmesg_msg_iter->buf_pos > 0) {
+		dmesg_msg_iter->buf_len -= dmesg_msg_iter->buf_pos;
+		memmove(dmesg_msg_iter->buf,
+			dmesg_msg_iter->buf + dmesg_msg_iter->buf_pos,
+			dmesg_msg_iter->buf_len);
+		dmesg_msg_iter->buf_pos = 0;
+	}
+
+	if (dmesg_msg_iter->buf_len + 1 >= dmesg_msg_iter->buf_size) {
+		/* Current line does not fit: grow buffer */
+		size_t new_size = dmesg_msg_iter->buf_size * 2;
+		char *new_buf = g_try_realloc(dmesg_msg_iter->buf, new_size);
+
+		if (!new_buf) {
+			BT_COMP_LOGE("Failed to grow input buffer: size=%zu",
+				new_size);
+			goto error;
+		}
+
+		dmesg_msg_iter->buf = new_buf;
+		dmesg_msg_iter->buf_size = new_size;
+	}
+
+	do {
+		read_len = read(dmesg_msg_iter->fd,
+			dmesg_msg_iter->buf + dmesg_msg_iter->buf_len,
+			dmesg_msg_iter->buf_size - dmesg_msg_iter->buf_len - 1);
+	} while (read_len < 0 && errno == EINTR);
+
+	if (read_len < 0) {
+		BT_COMP_LOGE_ERRNO("Cannot read input file", ".");
+		goto error;
+	}
+
+	if (read_len == 0) {
+		dmesg_msg_iter->input_eof = true;
+	}
+
+	dmesg_msg_iter->buf_len += read_len;
+	goto end;
+
+error:
+	ret = -1;
+
+end:
+	return ret;
+}
+
+/*
+ * Borrows the next line of the input buffer, refilling it as needed.
+ *
+ * On success, `*line` is null-terminated (in place, where its newline
+ * character was) and `*len` is its length, excluding the newline
+ * character.
+ *
+ * Returns 0 on success, 1 at the end of the input, or -1 on error.
+ */
+static
+int next_line(struct dmesg_msg_iter *dmesg_msg_iter, char **line,
+		size_t *len)
+{
+	int ret = 0;
+
+	while (true) {
+		char *begin = dmesg_msg_iter->buf + dmesg_msg_iter->buf_pos;
+		size_t avail = dmesg_msg_iter->buf_len -
+			dmesg_msg_iter->buf_pos;
+		char *nl = memchr(begin, '\n', avail);
+
+		if (nl) {
+			*nl = '\0';
+			*line = begin;
+			*len = nl - begin;
+			dmesg_msg_iter->buf_pos += *len + 1;
+			goto end;
+		}
+
+		if (dmesg_msg_iter->input_eof) {
+			if (avail == 0) {
+				ret = 1;
+				goto end;
+			}
+
+			/* Last line without a newline character */
+			begin[avail] = '\0';
+			*line = begin;
+			*len = avail;
+			dmesg_msg_iter->buf_pos = dmesg_msg_iter->buf_len;
+			goto end;
+		}
+
+		if (fill_input_buf(dmesg_msg_iter)) {
+			ret = -1;
+			goto end;
+		}
+	}
+
+end:
+	return ret;
+}
 
 
 BT_HIDDEN
@@ -681,14 +967,25 @@ bt_message_iterator_class_initialize_method_status dmesg_msg_iter_init(
 	}
 
 	BT_ASSERT(dmesg_comp);
+	dmesg_msg_iter->fd = -1;
 	dmesg_msg_iter->dmesg_comp = dmesg_comp;
 	dmesg_msg_iter->self_msg_iter = self_msg_iter;
 
+	dmesg_msg_iter->buf = g_try_malloc(INPUT_BUF_INIT_SIZE);
+	if (!dmesg_msg_iter->buf) {
+		BT_COMP_LOGE_STR("Failed to allocate input buffer.");
+		status = BT_MESSAGE_ITERATOR_CLASS_INITIALIZE_METHOD_STATUS_MEMORY_ERROR;
+		goto error;
+	}
+
+	dmesg_msg_iter->buf_size = INPUT_BUF_INIT_SIZE;
+
 	if (dmesg_comp->params.read_from_stdin) {
-		dmesg_msg_iter->fp = stdin;
+		dmesg_msg_iter->fd = STDIN_FILENO;
 	} else {
-		dmesg_msg_iter->fp = fopen(dmesg_comp->params.path->str, "r");
-		if (!dmesg_msg_iter->fp) {
+		dmesg_msg_iter->fd = open(dmesg_comp->params.path->str,
+			O_RDONLY);
+		if (dmesg_msg_iter->fd < 0) {
 			BT_COMP_LOGE_ERRNO("Cannot open input file in read mode", ": path=\"%s\"",
 				dmesg_comp->params.path->str);
 			goto error;
@@ -723,7 +1020,9 @@ bt_message_iterator_class_next_method_status dmesg_msg_iter_next_one(
 		struct dmesg_msg_iter *dmesg_msg_iter,
 		bt_message **msg)
 {
-	ssize_t len;
+	char *line;
+	size_t len;
+	int ret;
 	struct dmesg_component *dmesg_comp;
 	bt_message_iterator_class_next_method_status status =
 		BT_MESSAGE_ITERATOR_CLASS_NEXT_METHOD_STATUS_OK;
@@ -746,33 +1045,24 @@ bt_message_iterator_class_next_method_status dmesg_msg_iter_next_one(
 		const char *ch;
 		bool only_spaces = true;
 
-		len = bt_getline(&dmesg_msg_iter->linebuf,
-			&dmesg_msg_iter->linebuf_len, dmesg_msg_iter->fp);
-		if (len < 0) {
-			if (errno == EINVAL) {
-				status = BT_MESSAGE_ITERATOR_CLASS_NEXT_METHOD_STATUS_ERROR;
-			} else if (errno == ENOMEM) {
-				status = BT_MESSAGE_ITERATOR_CLASS_NEXT_METHOD_STATUS_MEMORY_ERROR;
+		ret = next_line(dmesg_msg_iter, &line, &len);
+		if (ret < 0) {
+			status = BT_MESSAGE_ITERATOR_CLASS_NEXT_METHOD_STATUS_ERROR;
+			goto end;
+		} else if (ret > 0) {
+			if (dmesg_msg_iter->state == STATE_EMIT_STREAM_BEGINNING) {
+				/* Stream did not even begin */
+				status = BT_MESSAGE_ITERATOR_CLASS_NEXT_METHOD_STATUS_END;
+				goto end;
 			} else {
-				if (dmesg_msg_iter->state == STATE_EMIT_STREAM_BEGINNING) {
-					/* Stream did not even begin */
-					status = BT_MESSAGE_ITERATOR_CLASS_NEXT_METHOD_STATUS_END;
-					goto end;
-				} else {
-					/* End stream now */
-					dmesg_msg_iter->state =
-						STATE_EMIT_STREAM_END;
-					goto handle_state;
-				}
+				/* End stream now */
+				dmesg_msg_iter->state = STATE_EMIT_STREAM_END;
+				goto handle_state;
 			}
-
-			goto end;
 		}
 
-		BT_ASSERT_DBG(dmesg_msg_iter->linebuf);
-
 		/* Ignore empty lines, once trimmed */
-		for (ch = dmesg_msg_iter->linebuf; *ch != '\0'; ch++) {
+		for (ch = line; *ch != '\0'; ch++) {
 			if (!isspace(*ch)) {
 				only_spaces = false;
 				break;
@@ -785,11 +1075,11 @@ bt_message_iterator_class_next_method_status dmesg_msg_iter_next_one(
 	}
 
 	dmesg_msg_iter->tmp_event_msg = create_msg_from_line(
-		dmesg_msg_iter, dmesg_msg_iter->linebuf);
+		dmesg_msg_iter, line, len);
 	if (!dmesg_msg_iter->tmp_event_msg) {
 		BT_COMP_LOGE("Cannot create event message from line: "
 			"dmesg-comp-addr=%p, line=\"%s\"", dmesg_comp,
-			dmesg_msg_iter->linebuf);
+			line);
 		goto end;
 	}
 
@@ -893,11 +1183,26 @@ dmesg_msg_iter_seek_beginning(
 {
 	struct dmesg_msg_iter *dmesg_msg_iter =
 		bt_self_message_iterator_get_data(self_msg_iter);
+	struct dmesg_component *dmesg_comp = dmesg_msg_iter->dmesg_comp;
+	bt_message_iterator_class_seek_beginning_method_status status =
+		BT_MESSAGE_ITERATOR_CLASS_SEEK_BEGINNING_METHOD_STATUS_OK;
 
-	BT_ASSERT(!dmesg_msg_iter->dmesg_comp->params.read_from_stdin);
+	BT_ASSERT(!dmesg_comp->params.read_from_stdin);
+
+	if (lseek(dmesg_msg_iter->fd, 0, SEEK_SET) < 0) {
+		BT_COMP_LOGE_ERRNO("Cannot seek the beginning of the input file",
+			": path=\"%s\"", dmesg_comp->params.path->str);
+		status = BT_MESSAGE_ITERATOR_CLASS_SEEK_BEGINNING_METHOD_STATUS_ERROR;
+		goto end;
+	}
 
+	dmesg_msg_iter->buf_len = 0;
+	dmesg_msg_iter->buf_pos = 0;
+	dmesg_msg_iter->input_eof = false;
 	BT_MESSAGE_PUT_REF_AND_RESET(dmesg_msg_iter->tmp_event_msg);
 	dmesg_msg_iter->last_clock_value = 0;
 	dmesg_msg_iter->state = STATE_EMIT_STREAM_BEGINNING;
-	return BT_MESSAGE_ITERATOR_CLASS_SEEK_BEGINNING_METHOD_STATUS_OK;
+
+end:
+	return status;
 }
@@ -0,0 +1,329 @@
+/*
+ * gen_trace.c
+ *
+ * Synthetic CTF trace generator for the benchmarks
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; under version 2 of the License.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <babeltrace2-ctf-writer/writer.h>
+#include <babeltrace2-ctf-writer/clock.h>
+#include <babeltrace2-ctf-writer/stream.h>
+#include <babeltrace2-ctf-writer/event.h>
+#include <babeltrace2-ctf-writer/event-types.h>
+#include <babeltrace2-ctf-writer/event-fields.h>
+#include <babeltrace2-ctf-writer/stream-class.h>
+#include <babeltrace2-ctf-writer/object.h>
+#include <glib.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*
+ * Time between two consecutive events of the whole trace (ns).
+ *
+ * The events are written to the streams in a round-robin fashion, so
+ * that the streams overlap in time and a muxer has to interleave them.
+ */
+#define EVENT_PERIOD_NS		1000
+
+struct gen_params {
+	const char *output_dir;
+	uint64_t stream_count;
+	uint64_t event_count;
+	uint64_t payload_size;
+	uint64_t packet_size;
+};
+
+static
+void print_usage(FILE *fp)
+{
+	fprintf(fp, "Usage: gen_trace OUTPUT-DIR STREAM-COUNT EVENT-COUNT "
+		"PAYLOAD-SIZE PACKET-SIZE\n\n");
+	fprintf(fp, "Write a CTF trace of EVENT-COUNT events (in total) to "
+		"OUTPUT-DIR, spread\n");
+	fprintf(fp, "over STREAM-COUNT data streams. Each event has a "
+		"PAYLOAD-SIZE-byte\n");
+	fprintf(fp, "array field and packets are closed when their content "
+		"reaches PACKET-SIZE\n");
+	fprintf(fp, "bytes.\n");
+}
+
+static
+int parse_uint(const char *arg, uint64_t *val)
+{
+	gchar *end;
+
+	*val = g_ascii_strtoull(arg, &end, 10);
+	if (*arg == '\0' || *end != '\0') {
+		fprintf(stderr, "Invalid unsigned integer: `%s`\n", arg);
+		return -1;
+	}
+
+	return 0;
+}
+
+static
+struct bt_ctf_event_class *create_event_class(uint64_t payload_size)
+{
+	struct bt_ctf_event_class *ec = NULL;
+	struct bt_ctf_field_type *u8_ft = NULL;
+	struct bt_ctf_field_type *u32_ft = NULL;
+	struct bt_ctf_field_type *u64_ft = NULL;
+	struct bt_ctf_field_type *data_ft = NULL;
+
+	ec = bt_ctf_event_class_create("bench");
+	u8_ft = bt_ctf_field_type_integer_create(8);
+	u32_ft = bt_ctf_field_type_integer_create(32);
+	u64_ft = bt_ctf_field_type_integer_create(64);
+	if (!ec || !u8_ft || !u32_ft || !u64_ft) {
+		goto error;
+	}
+
+	if (bt_ctf_event_class_add_field(ec, u64_ft, "seq") ||
+			bt_ctf_event_class_add_field(ec, u32_ft, "value")) {
+		goto error;
+	}
+
+	if (payload_size > 0) {
+		data_ft = bt_ctf_field_type_array_create(u8_ft,
+			(unsigned int) payload_size);
+		if (!data_ft) {
+			goto error;
+		}
+
+		if (bt_ctf_event_class_add_field(ec, data_ft, "data")) {
+			goto error;
+		}
+	}
+
+	goto end;
+
+error:
+	BT_CTF_OBJECT_PUT_REF_AND_RESET(ec);
+
+end:
+	bt_ctf_object_put_ref(u8_ft);
+	bt_ctf_object_put_ref(u32_ft);
+	bt_ctf_object_put_ref(u64_ft);
+	bt_ctf_object_put_ref(data_ft);
+	return ec;
+}
+
+/*
+ * Sets the fields of the event template which do not change from one
+ * event to the other.
+ */
+static
+int init_event_template(struct bt_ctf_event *event, uint64_t payload_size)
+{
+	struct bt_ctf_field *data_field = NULL;
+	uint64_t i;
+	int ret = 0;
+
+	if (payload_size == 0) {
+		goto end;
+	}
+
+	data_field = bt_ctf_event_get_payload(event, "data");
+	if (!data_field) {
+		ret = -1;
+		goto end;
+	}
+
+	for (i = 0; i < payload_size; i++) {
+		struct bt_ctf_field *elem_field =
+			bt_ctf_field_array_get_field(data_field, i);
+
+		if (!elem_field) {
+			ret = -1;
+			goto end;
+		}
+
+		ret = bt_ctf_field_integer_unsigned_set_value(elem_field,
+			i & 0xff);
+		bt_ctf_object_put_ref(elem_field);
+		if (ret) {
+			goto end;
+		}
+	}
+
+end:
+	bt_ctf_object_put_ref(data_field);
+	return ret;
+}
+
+static
+int set_uint_payload(struct bt_ctf_event *event, const char *name,
+		uint64_t val)
+{
+	struct bt_ctf_field *field = bt_ctf_event_get_payload(event, name);
+	int ret;
+
+	if (!field) {
+		return -1;
+	}
+
+	ret = bt_ctf_field_integer_unsigned_set_value(field, val);
+	bt_ctf_object_put_ref(field);
+	return ret;
+}
+
+static
+int gen_trace(const struct gen_params *params)
+{
+	struct bt_ctf_writer *writer = NULL;
+	struct bt_ctf_clock *clock = NULL;
+	struct bt_ctf_stream_class *sc = NULL;
+	struct bt_ctf_event_class *ec = NULL;
+	struct bt_ctf_stream **streams = NULL;
+	struct bt_ctf_event **events = NULL;
+	uint64_t i;
+	int ret = 0;
+
+	writer = bt_ctf_writer_create(params->output_dir);
+	if (!writer) {
+		fprintf(stderr, "Cannot create CTF writer: path=\"%s\"\n",
+			params->output_dir);
+		goto error;
+	}
+
+	clock = bt_ctf_clock_create("monotonic");
+	if (!clock || bt_ctf_writer_add_clock(writer, clock)) {
+		fprintf(stderr, "Cannot create clock.\n");
+		goto error;
+	}
+
+	sc = bt_ctf_stream_class_create("bench");
+	if (!sc || bt_ctf_stream_class_set_clock(sc, clock)) {
+		fprintf(stderr, "Cannot create stream class.\n");
+		goto error;
+	}
+
+	ec = create_event_class(params->payload_size);
+	if (!ec || bt_ctf_stream_class_add_event_class(sc, ec)) {
+		fprintf(stderr, "Cannot create event class.\n");
+		goto error;
+	}
+
+	streams = g_new0(struct bt_ctf_stream *, params->stream_count);
+	events = g_new0(struct bt_ctf_event *, params->stream_count);
+	if (!streams || !events) {
+		goto error;
+	}
+
+	for (i = 0; i < params->stream_count; i++) {
+		streams[i] = bt_ctf_writer_create_stream(writer, sc);
+		if (!streams[i]) {
+			fprintf(stderr, "Cannot create stream #%" PRIu64 ".\n",
+				i);
+			goto error;
+		}
+
+		if (bt_ctf_stream_set_max_packet_size(streams[i],
+				params->packet_size)) {
+			fprintf(stderr, "Cannot set maximum packet size.\n");
+			goto error;
+		}
+
+		events[i] = bt_ctf_stream_get_event_template(streams[i], ec);
+		if (!events[i] ||
+				init_event_template(events[i],
+					params->payload_size)) {
+			fprintf(stderr, "Cannot initialize event template.\n");
+			goto error;
+		}
+	}
+
+	for (i = 0; i < params->event_count; i++) {
+		uint64_t stream_index = i % params->stream_count;
+		struct bt_ctf_event *event = events[stream_index];
+
+		if (bt_ctf_clock_set_time(clock,
+				(int64_t) (i * EVENT_PERIOD_NS))) {
+			goto error;
+		}
+
+		if (set_uint_payload(event, "seq", i) ||
+				set_uint_payload(event, "value",
+					(uint32_t) (i * 2654435761U))) {
+			goto error;
+		}
+
+		if (bt_ctf_stream_write_event(streams[stream_index], event)) {
+			fprintf(stderr, "Cannot write event #%" PRIu64 ".\n",
+				i);
+			goto error;
+		}
+	}
+
+	for (i = 0; i < params->stream_count; i++) {
+		if (bt_ctf_stream_flush(streams[i])) {
+			fprintf(stderr, "Cannot flush stream #%" PRIu64 ".\n",
+				i);
+			goto error;
+		}
+	}
+
+	bt_ctf_writer_flush_metadata(writer);
+	goto end;
+
+error:
+	ret = -1;
+
+end:
+	if (streams) {
+		for (i = 0; i < params->stream_count; i++) {
+			bt_ctf_object_put_ref(events[i]);
+			bt_ctf_object_put_ref(streams[i]);
+		}
+	}
+
+	g_free(events);
+	g_free(streams);
+	bt_ctf_object_put_ref(ec);
+	bt_ctf_object_put_ref(sc);
+	bt_ctf_object_put_ref(clock);
+	bt_ctf_object_put_ref(writer);
+	return ret;
+}
+
+int main(int argc, char **argv)
+{
+	struct gen_params params;
+
+	if (argc != 6) {
+		print_usage(stderr);
+		return 1;
+	}
+
+	params.output_dir = argv[1];
+
+	if (parse_uint(argv[2], &params.stream_count) ||
+			parse_uint(argv[3], &params.event_count) ||
+			parse_uint(argv[4], &params.payload_size) ||
+			parse_uint(argv[5], &params.packet_size)) {
+		print_usage(stderr);
+		return 1;
+	}
+
+	if (params.stream_count == 0 || params.packet_size == 0) {
+		fprintf(stderr, "STREAM-COUNT and PACKET-SIZE must be greater "
+			"than 0.\n");
+		return 1;
+	}
+
+	return gen_trace(&params) ? 1 : 0;
+}
@@ -343,6 +343,106 @@ class EventTestCase(unittest.TestCase):
         self.assertEqual(ev['something'], 154)
         self.assertIs(type(ev['something']), bt2_field._UnsignedIntegerField)
 
+    def _create_test_const_event_message_all_fields(self):
+        def event_fields_config(event):
+            event.payload_field['giraffe'] = 1
+            event.payload_field['gnu'] = 23
+            event.payload_field['mosquito'] = 42
+            event.specific_context_field['ant'] = -1
+            event.specific_context_field['msg'] = 'hellooo'
+            event.common_context_field['cpu_id'] = 1
+            event.common_context_field['stuff'] = 13.194
+
+        def packet_fields_config(packet):
+            packet.context_field['something'] = 154
+            packet.context_field['something_else'] = 17.2
+
+        return self._create_test_const_event_message(
+            packet_fields_config=packet_fields_config,
+            event_fields_config=event_fields_config,
+            with_cc=True,
+            with_sc=True,
+            with_ep=True,
+            with_packet=True,
+        )
+
+    def test_const_field_by_path(self):
+        msg = self._create_test_const_event_message_all_fields()
+        ev = msg.event
+        ec = ev.cls
+
+        fp = ec.create_field_path(bt2.FieldPathScope.EVENT_PAYLOAD, ['gnu'])
+        self.assertEqual(ev.field_by_path(fp), 23)
+        self.assertIs(type(ev.field_by_path(fp)), bt2_field._SignedIntegerFieldConst)
+        fp = ec.create_field_path(bt2.FieldPathScope.EVENT_SPECIFIC_CONTEXT, ['msg'])
+        self.assertEqual(ev.field_by_path(fp), 'hellooo')
+        fp = ec.create_field_path(bt2.FieldPathScope.EVENT_COMMON_CONTEXT, ['cpu_id'])
+        self.assertEqual(ev.field_by_path(fp), 1)
+        fp = ec.create_field_path(bt2.FieldPathScope.PACKET_CONTEXT, ['something'])
+        self.assertEqual(ev.field_by_path(fp), 154)
+
+    def test_const_field_by_path_root(self):
+        msg = self._create_test_const_event_message_all_fields()
+        fp = msg.event.cls.create_field_path(bt2.FieldPathScope.EVENT_PAYLOAD, [])
+        self.assertEqual(len(fp), 0)
+        self.assertEqual(
+            msg.event.field_by_path(fp).addr, msg.event.payload_field.addr
+        )
+
+    def test_const_integer_field_value_by_path(self):
+        msg = self._create_test_const_event_message_all_fields()
+        ev = msg.event
+        ec = ev.cls
+
+        fp = ec.create_field_path(bt2.FieldPathScope.EVENT_SPECIFIC_CONTEXT, ['ant'])
+        self.assertEqual(ev.signed_integer_field_value_by_path(fp), -1)
+
+        with self.assertRaises(TypeError):
+            ev.unsigned_integer_field_value_by_path(fp)
+
+        fp = ec.create_field_path(bt2.FieldPathScope.PACKET_CONTEXT, ['something'])
+        self.assertEqual(ev.unsigned_integer_field_value_by_path(fp), 154)
+
+        with self.assertRaises(TypeError):
+            ev.signed_integer_field_value_by_path(fp)
+
+    def test_create_field_path_not_found(self):
+        msg = self._create_test_const_event_message_all_fields()
+
+        with self.assertRaises(KeyError):
+            msg.event.cls.create_field_path(bt2.FieldPathScope.EVENT_PAYLOAD, ['yes'])
+
+        with self.assertRaises(KeyError):
+            msg.event.cls.create_field_path(
+                bt2.FieldPathScope.EVENT_PAYLOAD, ['gnu', 'gnu']
+            )
+
+    def test_create_field_path_no_root_field_class(self):
+        msg = self._create_test_const_event_message(with_ep=True)
+
+        with self.assertRaises(KeyError):
+            msg.event.cls.create_field_path(
+                bt2.FieldPathScope.EVENT_COMMON_CONTEXT, ['cpu_id']
+            )
+
+    def test_create_field_path_invalid_scope(self):
+        msg = self._create_test_const_event_message_all_fields()
+
+        with self.assertRaises(ValueError):
+            msg.event.cls.create_field_path(23, ['gnu'])
+
+    def test_create_field_path_wrong_name_type(self):
+        msg = self._create_test_const_event_message_all_fields()
+
+        with self.assertRaises(TypeError):
+            msg.event.cls.create_field_path(bt2.FieldPathScope.EVENT_PAYLOAD, [23])
+
+    def test_field_by_path_wrong_type(self):
+        msg = self._create_test_const_event_message_all_fields()
+
+        with self.assertRaises(TypeError):
+            msg.event.field_by_path(['gnu'])
+
 
 if __name__ == "__main__":
     unittest.main()
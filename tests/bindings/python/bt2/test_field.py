@@ -1353,6 +1353,46 @@ class SignedEnumerationFieldTestCase(_TestIntegerFieldCommon, unittest.TestCase)
         labels = sorted(self._field.labels)
         self.assertEqual(labels, ['something', 'whole range', 'zip'])
 
+    def test_labels_range_bounds(self):
+        for value, expected_labels in (
+            (-(2 ** 31), ['whole range']),
+            (-46, ['whole range']),
+            (-45, ['whole range', 'zip']),
+            (0, ['whole range', 'zip']),
+            (12, ['speaker', 'whole range', 'zip']),
+            (16, ['speaker', 'whole range', 'zip']),
+            (18, ['can', 'whole range', 'zip']),
+            (1001, ['can', 'whole range', 'zip']),
+            (1002, ['can', 'whole range']),
+            (2540, ['can', 'whole range']),
+            (2541, ['whole range']),
+            ((2 ** 31) - 1, ['whole range']),
+        ):
+            self._field.value = value
+            self.assertEqual(sorted(self._field.labels), expected_labels)
+
+    def test_labels_no_mapping(self):
+        fc = self._tc.create_signed_enumeration_field_class(32)
+        fc.add_mapping('a', bt2.SignedIntegerRangeSet([(-3, -1), (300, 400)]))
+        fc.add_mapping('b', bt2.SignedIntegerRangeSet([(2, 2)]))
+        field = _create_field(self._tc, fc)
+
+        for value, expected_labels in (
+            (-4, []),
+            (-3, ['a']),
+            (-1, ['a']),
+            (0, []),
+            (1, []),
+            (2, ['b']),
+            (3, []),
+            (299, []),
+            (300, ['a']),
+            (400, ['a']),
+            (401, []),
+        ):
+            field.value = value
+            self.assertEqual(field.labels, expected_labels)
+
 
 class SingleRealFieldTestCase(_TestNumericField, unittest.TestCase):
     @staticmethod
@@ -407,6 +407,126 @@ class TraceCollectionMessageIteratorTestCase(unittest.TestCase):
             )
 
 
+class TraceCollectionMessageIteratorColumnarTestCase(unittest.TestCase):
+    def _create_msg_iter(self):
+        return bt2.TraceCollectionMessageIterator(_3EVENTS_INTERSECT_TRACE_PATH)
+
+    def _get_expected_events(self):
+        return [
+            (
+                msg.default_clock_snapshot.ns_from_origin,
+                msg.event.cls.name,
+                int(msg.event.payload_field['dummy_value']),
+                int(msg.event.payload_field['tracefile_id']),
+            )
+            for msg in self._create_msg_iter()
+            if type(msg) is bt2._EventMessageConst
+        ]
+
+    def _get_events(self, batches):
+        events = []
+
+        for batch in batches:
+            timestamps = batch.timestamps.values
+            names = batch.event_class_names
+            dummy_values = batch['dummy'].values
+            tracefile_ids = batch['tracefile'].values
+
+            for i in range(batch.event_count):
+                self.assertEqual(batch.timestamps.validity[i], 1)
+                self.assertEqual(batch['dummy'].validity[i], 1)
+                events.append(
+                    (
+                        timestamps[i],
+                        names.dictionary[names.values[i]],
+                        dummy_values[i],
+                        tracefile_ids[i],
+                    )
+                )
+
+        return events
+
+    def test_columnar_batches(self):
+        batches = list(
+            self._create_msg_iter().columnar_batches(
+                {
+                    'dummy': 'dummy_value',
+                    'tracefile': (bt2.FieldPathScope.EVENT_PAYLOAD, 'tracefile_id'),
+                },
+                max_event_count=3,
+            )
+        )
+        self.assertEqual([batch.event_count for batch in batches], [3, 3, 2])
+        self.assertEqual(batches[0]['dummy'].values.format, 'Q')
+        self.assertFalse(batches[0]['dummy'].is_dictionary_encoded)
+        self.assertTrue(batches[0].event_class_names.is_dictionary_encoded)
+        self.assertEqual(self._get_events(batches), self._get_expected_events())
+
+    def test_columnar_batches_max_event_count(self):
+        for max_event_count in (1, 2, 5):
+            batches = list(
+                self._create_msg_iter().columnar_batches(
+                    {'dummy': 'dummy_value'}, max_event_count=max_event_count
+                )
+            )
+
+            for batch in batches[:-1]:
+                self.assertEqual(batch.event_count, max_event_count)
+
+            self.assertLessEqual(batches[-1].event_count, max_event_count)
+            self.assertEqual(sum(batch.event_count for batch in batches), 8)
+
+    def test_columnar_batches_after_next(self):
+        msg_iter = self._create_msg_iter()
+        msgs = [next(msg_iter) for i in range(4)]
+        batches = list(
+            msg_iter.columnar_batches(
+                {'dummy': 'dummy_value', 'tracefile': ['tracefile_id']}
+            )
+        )
+        msg_event_count = len(
+            [msg for msg in msgs if type(msg) is bt2._EventMessageConst]
+        )
+        self.assertEqual(
+            self._get_events(batches), self._get_expected_events()[msg_event_count:]
+        )
+
+    def test_columnar_batches_event_class_names(self):
+        batches = list(
+            self._create_msg_iter().columnar_batches(
+                {'dummy': 'dummy_value'}, event_class_names=['unknown_event']
+            )
+        )
+        self.assertEqual(batches, [])
+
+    def test_columnar_batches_missing_field(self):
+        batches = list(
+            self._create_msg_iter().columnar_batches({'missing': 'no_such_member'})
+        )
+        self.assertEqual(sum(batch.event_count for batch in batches), 8)
+
+        for batch in batches:
+            self.assertEqual(list(batch['missing'].validity), [0] * batch.event_count)
+
+    def test_columnar_batches_compound_field(self):
+        with self.assertRaises(bt2._Error):
+            list(
+                self._create_msg_iter().columnar_batches(
+                    {'payload': (bt2.FieldPathScope.EVENT_PAYLOAD,)}
+                )
+            )
+
+    def test_columnar_batches_wrong_columns_type(self):
+        with self.assertRaises(TypeError):
+            self._create_msg_iter().columnar_batches(['dummy_value'])
+
+    def test_columnar_batches_zero_max_event_count(self):
+        with self.assertRaises(ValueError):
+            self._create_msg_iter().columnar_batches(
+                {'dummy': 'dummy_value'}, max_event_count=0
+            )
+
+
 class _TestAutoDiscoverSourceComponentSpecs(unittest.TestCase):
     def setUp(self):
         self._saved_babeltrace_plugin_path = os.environ['BABELTRACE_PLUGIN_PATH']
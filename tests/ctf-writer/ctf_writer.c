@@ -57,7 +57,7 @@
 #define DEFAULT_CLOCK_TIME 0
 #define DEFAULT_CLOCK_VALUE 0
 
-#define NR_TESTS 325
+#define NR_TESTS 331
 
 struct bt_utsname {
 	char sysname[BABELTRACE_HOST_NAME_MAX];
@@ -1430,6 +1430,148 @@ end:
 	bt_ctf_object_put_ref(event_header_type);
 }
 
+static
+void test_streaming_write(struct bt_ctf_writer *writer,
+		struct bt_ctf_clock *clock)
+{
+	int i, ret;
+	struct bt_ctf_stream_class *stream_class = NULL;
+	struct bt_ctf_stream *stream = NULL;
+	struct bt_ctf_field_type *integer_type = NULL;
+	struct bt_ctf_field *integer = NULL, *packet_header = NULL;
+	struct bt_ctf_event_class *event_class = NULL;
+	struct bt_ctf_event *event = NULL, *other_event = NULL,
+		*appended_event = NULL;
+
+	stream_class = bt_ctf_stream_class_create("streaming_stream");
+	if (!stream_class) {
+		fail("Failed to create stream class");
+		goto end;
+	}
+
+	ret = bt_ctf_stream_class_set_clock(stream_class, clock);
+	if (ret) {
+		fail("Failed to set stream class clock");
+		goto end;
+	}
+
+	integer_type = bt_ctf_field_type_integer_create(32);
+	if (!integer_type) {
+		fail("Failed to create integer type");
+		goto end;
+	}
+
+	event_class = bt_ctf_event_class_create("streaming_event");
+	if (!event_class) {
+		fail("Failed to create event class");
+		goto end;
+	}
+
+	ret = bt_ctf_event_class_add_field(event_class, integer_type,
+		"value");
+	if (ret) {
+		fail("Failed to add a field to an event class");
+		goto end;
+	}
+
+	ret = bt_ctf_stream_class_add_event_class(stream_class, event_class);
+	if (ret) {
+		fail("Failed to add event class to stream class");
+		goto end;
+	}
+
+	stream = bt_ctf_writer_create_stream(writer, stream_class);
+	if (!stream) {
+		fail("Failed to create stream");
+		goto end;
+	}
+
+	packet_header = bt_ctf_stream_get_packet_header(stream);
+	if (!packet_header) {
+		fail("Failed to get stream packet header");
+		goto end;
+	}
+
+	integer = bt_ctf_field_structure_get_field_by_name(packet_header,
+		"custom_trace_packet_header_field");
+	if (!integer) {
+		fail("Failed to retrieve custom_trace_packet_header_field");
+		goto end;
+	}
+
+	ret = bt_ctf_field_integer_unsigned_set_value(integer, 1234);
+	if (ret) {
+		fail("Failed to set custom_trace_packet_header_field value");
+		goto end;
+	}
+
+	BT_CTF_OBJECT_PUT_REF_AND_RESET(integer);
+	ret = bt_ctf_stream_set_max_packet_size(stream, 4096);
+	if (ret) {
+		fail("Failed to set stream's maximum packet size");
+		goto end;
+	}
+
+	event = bt_ctf_stream_get_event_template(stream, event_class);
+	ok(event, "bt_ctf_stream_get_event_template returns an event");
+	other_event = bt_ctf_stream_get_event_template(stream, event_class);
+	ok(other_event == event,
+		"bt_ctf_stream_get_event_template returns the same event for the same event class");
+	ok(bt_ctf_stream_write_event(stream, NULL),
+		"bt_ctf_stream_write_event handles a NULL event correctly");
+
+	/* Write enough events to fill many packets */
+	for (i = 0; i < 4096; i++) {
+		integer = bt_ctf_event_get_payload(event, "value");
+		if (!integer) {
+			break;
+		}
+
+		ret = bt_ctf_field_integer_unsigned_set_value(integer, i);
+		BT_CTF_OBJECT_PUT_REF_AND_RESET(integer);
+		if (ret) {
+			break;
+		}
+
+		current_time += 10;
+		ret = bt_ctf_clock_set_time(clock, current_time);
+		if (ret) {
+			break;
+		}
+
+		ret = bt_ctf_stream_write_event(stream, event);
+		if (ret) {
+			break;
+		}
+	}
+
+	ok(i == 4096, "Write many events with the same event template");
+
+	/* Open a packet and try to mix both modes */
+	ret = bt_ctf_stream_write_event(stream, event);
+	appended_event = bt_ctf_event_create(event_class);
+	BT_ASSERT(appended_event);
+	integer = bt_ctf_event_get_payload(appended_event, "value");
+	BT_ASSERT(integer);
+	ret |= bt_ctf_field_integer_unsigned_set_value(integer, 42);
+	BT_ASSERT(ret == 0);
+	ok(bt_ctf_stream_append_event(stream, appended_event),
+		"bt_ctf_stream_append_event fails while a packet is open for writing");
+	ok(bt_ctf_stream_flush(stream) == 0,
+		"Flush a stream written with bt_ctf_stream_write_event");
+
+end:
+	bt_ctf_object_put_ref(stream);
+	bt_ctf_object_put_ref(stream_class);
+	bt_ctf_object_put_ref(event_class);
+	bt_ctf_object_put_ref(event);
+	bt_ctf_object_put_ref(other_event);
+	bt_ctf_object_put_ref(appended_event);
+	bt_ctf_object_put_ref(integer);
+	bt_ctf_object_put_ref(packet_header);
+	bt_ctf_object_put_ref(integer_type);
+}
+
 static
 void test_instanciate_event_before_stream(struct bt_ctf_writer *writer,
 		struct bt_ctf_clock *clock)
@@ -2045,6 +2187,8 @@ int main(int argc, char **argv)
 
 	test_custom_event_header_stream(writer, clock);
 
+	test_streaming_write(writer, clock);
+
 	metadata_string = bt_ctf_writer_get_metadata_string(writer);
 	ok(metadata_string, "Get metadata string");
 
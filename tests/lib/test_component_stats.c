@@ -0,0 +1,288 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; under version 2 of the License.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <babeltrace2/babeltrace.h>
+#include "common/assert.h"
+#include <glib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include "tap/tap.h"
+
+#define NR_TESTS 14
+
+/* Trace IR objects of the source component */
+static struct {
+	bt_trace_class *tc;
+	bt_stream_class *sc;
+	bt_event_class *ec;
+	bt_trace *trace;
+	bt_stream *stream;
+} src_objs;
+
+/* Number of calls to the source message iterator's "next" method */
+static unsigned int src_iter_next_calls;
+
+static
+bt_component_class_initialize_method_status src_init(
+		bt_self_component_source *self_comp,
+		bt_self_component_source_configuration *config,
+		const bt_value *params, void *init_method_data)
+{
+	bt_self_component_add_port_status status;
+
+	status = bt_self_component_source_add_output_port(self_comp,
+		"out", NULL, NULL);
+	BT_ASSERT(status == BT_SELF_COMPONENT_ADD_PORT_STATUS_OK);
+	src_objs.tc = bt_trace_class_create(
+		bt_self_component_source_as_self_component(self_comp));
+	BT_ASSERT(src_objs.tc);
+	src_objs.sc = bt_stream_class_create(src_objs.tc);
+	BT_ASSERT(src_objs.sc);
+	src_objs.ec = bt_event_class_create(src_objs.sc);
+	BT_ASSERT(src_objs.ec);
+	src_objs.trace = bt_trace_create(src_objs.tc);
+	BT_ASSERT(src_objs.trace);
+	src_objs.stream = bt_stream_create(src_objs.sc, src_objs.trace);
+	BT_ASSERT(src_objs.stream);
+	return BT_COMPONENT_CLASS_INITIALIZE_METHOD_STATUS_OK;
+}
+
+static
+void src_finalize(bt_self_component_source *self_comp)
+{
+	bt_stream_put_ref(src_objs.stream);
+	bt_trace_put_ref(src_objs.trace);
+	bt_event_class_put_ref(src_objs.ec);
+	bt_stream_class_put_ref(src_objs.sc);
+	bt_trace_class_put_ref(src_objs.tc);
+}
+
+static
+const bt_message *create_event_msg(bt_self_message_iterator *self_msg_iter)
+{
+	bt_message *msg = bt_message_event_create(self_msg_iter,
+		src_objs.ec, src_objs.stream);
+
+	BT_ASSERT(msg);
+	return msg;
+}
+
+/*
+ * Returns, over successive calls:
+ *
+ * 1. AGAIN.
+ * 2. Stream beginning, event, event.
+ * 3. Event, stream end.
+ * 4. END.
+ */
+static
+bt_message_iterator_class_next_method_status src_iter_next(
+		bt_self_message_iterator *self_msg_iter,
+		bt_message_array_const msgs, uint64_t capacity,
+		uint64_t *count)
+{
+	bt_message_iterator_class_next_method_status status =
+		BT_MESSAGE_ITERATOR_CLASS_NEXT_METHOD_STATUS_OK;
+
+	BT_ASSERT(capacity >= 3);
+	src_iter_next_calls++;
+
+	switch (src_iter_next_calls) {
+	case 1:
+		status = BT_MESSAGE_ITERATOR_CLASS_NEXT_METHOD_STATUS_AGAIN;
+		break;
+	case 2:
+		msgs[0] = bt_message_stream_beginning_create(self_msg_iter,
+			src_objs.stream);
+		BT_ASSERT(msgs[0]);
+		msgs[1] = create_event_msg(self_msg_iter);
+		msgs[2] = create_event_msg(self_msg_iter);
+		*count = 3;
+		break;
+	case 3:
+		msgs[0] = create_event_msg(self_msg_iter);
+		msgs[1] = bt_message_stream_end_create(self_msg_iter,
+			src_objs.stream);
+		BT_ASSERT(msgs[1]);
+		*count = 2;
+		break;
+	default:
+		status = BT_MESSAGE_ITERATOR_CLASS_NEXT_METHOD_STATUS_END;
+		break;
+	}
+
+	return status;
+}
+
+static
+bt_graph_simple_sink_component_consume_func_status sink_consume(
+		bt_message_iterator *iterator, void *data)
+{
+	bt_message_array_const msgs;
+	uint64_t count;
+	uint64_t i;
+
+	switch (bt_message_iterator_next(iterator, &msgs, &count)) {
+	case BT_MESSAGE_ITERATOR_NEXT_STATUS_OK:
+		for (i = 0; i < count; i++) {
+			bt_message_put_ref(msgs[i]);
+		}
+
+		return BT_GRAPH_SIMPLE_SINK_COMPONENT_CONSUME_FUNC_STATUS_OK;
+	case BT_MESSAGE_ITERATOR_NEXT_STATUS_AGAIN:
+		return BT_GRAPH_SIMPLE_SINK_COMPONENT_CONSUME_FUNC_STATUS_AGAIN;
+	case BT_MESSAGE_ITERATOR_NEXT_STATUS_END:
+		return BT_GRAPH_SIMPLE_SINK_COMPONENT_CONSUME_FUNC_STATUS_END;
+	default:
+		return BT_GRAPH_SIMPLE_SINK_COMPONENT_CONSUME_FUNC_STATUS_ERROR;
+	}
+}
+
+/*
+ * Creates a graph with the source and a simple sink, enabling its
+ * statistics if `enable_stats` is true, and runs it to completion.
+ */
+static
+bt_graph *create_and_run_graph(bool enable_stats,
+		const bt_component_source **src_comp,
+		const bt_component_sink **sink_comp)
+{
+	bt_message_iterator_class *msg_iter_cls;
+	bt_component_class_source *src_comp_cls;
+	bt_graph *graph;
+	bt_graph_add_component_status add_comp_status;
+	bt_graph_connect_ports_status connect_status;
+	bt_component_class_set_method_status set_method_status;
+	bt_graph_run_status run_status;
+
+	src_iter_next_calls = 0;
+	msg_iter_cls = bt_message_iterator_class_create(src_iter_next);
+	BT_ASSERT(msg_iter_cls);
+	src_comp_cls = bt_component_class_source_create("src", msg_iter_cls);
+	BT_ASSERT(src_comp_cls);
+	set_method_status = bt_component_class_source_set_initialize_method(
+		src_comp_cls, src_init);
+	BT_ASSERT(set_method_status == BT_COMPONENT_CLASS_SET_METHOD_STATUS_OK);
+	set_method_status = bt_component_class_source_set_finalize_method(
+		src_comp_cls, src_finalize);
+	BT_ASSERT(set_method_status == BT_COMPONENT_CLASS_SET_METHOD_STATUS_OK);
+	graph = bt_graph_create(0);
+	BT_ASSERT(graph);
+
+	if (enable_stats) {
+		bt_graph_enable_statistics(graph);
+	}
+
+	add_comp_status = bt_graph_add_source_component(graph, src_comp_cls,
+		"src", NULL, BT_LOGGING_LEVEL_NONE, src_comp);
+	BT_ASSERT(add_comp_status == BT_GRAPH_ADD_COMPONENT_STATUS_OK);
+	add_comp_status = bt_graph_add_simple_sink_component(graph, "sink",
+		NULL, sink_consume, NULL, NULL, sink_comp);
+	BT_ASSERT(add_comp_status == BT_GRAPH_ADD_COMPONENT_STATUS_OK);
+	connect_status = bt_graph_connect_ports(graph,
+		bt_component_source_borrow_output_port_by_index_const(
+			*src_comp, 0),
+		bt_component_sink_borrow_input_port_by_name_const(
+			*sink_comp, "in"), NULL);
+	BT_ASSERT(connect_status == BT_GRAPH_CONNECT_PORTS_STATUS_OK);
+
+	do {
+		run_status = bt_graph_run(graph);
+	} while (run_status == BT_GRAPH_RUN_STATUS_AGAIN);
+
+	BT_ASSERT(run_status == BT_GRAPH_RUN_STATUS_OK);
+	bt_component_class_source_put_ref(src_comp_cls);
+	bt_message_iterator_class_put_ref(msg_iter_cls);
+	return graph;
+}
+
+#define get_counter(_comp, _counter)					\
+	bt_component_get_statistics_counter((_comp),			\
+		BT_COMPONENT_STATISTICS_COUNTER_ ## _counter)
+
+static
+void test_disabled(void)
+{
+	const bt_component_source *src_comp = NULL;
+	const bt_component_sink *sink_comp = NULL;
+	bt_graph *graph = create_and_run_graph(false, &src_comp, &sink_comp);
+	const bt_component *src = bt_component_source_as_component_const(
+		src_comp);
+	const bt_component *sink = bt_component_sink_as_component_const(
+		sink_comp);
+
+	ok(get_counter(src, METHOD_CALLS) == 0 &&
+		get_counter(src, MESSAGES) == 0 &&
+		get_counter(src, TOTAL_TIME_NS) == 0,
+		"source component statistics remain 0 when they are not enabled");
+	ok(get_counter(sink, METHOD_CALLS) == 0 &&
+		get_counter(sink, TOTAL_TIME_NS) == 0,
+		"sink component statistics remain 0 when they are not enabled");
+	bt_graph_put_ref(graph);
+}
+
+static
+void test_enabled(void)
+{
+	const bt_component_source *src_comp = NULL;
+	const bt_component_sink *sink_comp = NULL;
+	bt_graph *graph = create_and_run_graph(true, &src_comp, &sink_comp);
+	const bt_component *src = bt_component_source_as_component_const(
+		src_comp);
+	const bt_component *sink = bt_component_sink_as_component_const(
+		sink_comp);
+	uint64_t src_total_ns, sink_total_ns, sink_self_ns;
+
+	ok(get_counter(src, METHOD_CALLS) == 4,
+		"source component: \"next\" method calls are counted");
+	ok(get_counter(src, AGAIN_STATUSES) == 1,
+		"source component: AGAIN statuses are counted");
+	ok(get_counter(src, MESSAGES) == 5,
+		"source component: messages are counted");
+	ok(get_counter(src, MAX_BATCH_SIZE) == 3,
+		"source component: maximum batch size is right");
+	ok(bt_component_get_statistics_message_count(src,
+		BT_MESSAGE_TYPE_STREAM_BEGINNING) == 1,
+		"source component: stream beginning messages are counted");
+	ok(bt_component_get_statistics_message_count(src,
+		BT_MESSAGE_TYPE_EVENT) == 3,
+		"source component: event messages are counted");
+	ok(bt_component_get_statistics_message_count(src,
+		BT_MESSAGE_TYPE_STREAM_END) == 1,
+		"source component: stream end messages are counted");
+	ok(get_counter(sink, METHOD_CALLS) == 4,
+		"sink component: \"consume\" method calls are counted");
+	ok(get_counter(sink, AGAIN_STATUSES) == 1,
+		"sink component: AGAIN statuses are counted");
+	ok(get_counter(sink, MESSAGES) == 0,
+		"sink component: no messages are counted");
+
+	src_total_ns = get_counter(src, TOTAL_TIME_NS);
+	sink_total_ns = get_counter(sink, TOTAL_TIME_NS);
+	sink_self_ns = get_counter(sink, SELF_TIME_NS);
+	ok(sink_total_ns >= src_total_ns,
+		"sink component's total time includes the upstream calls");
+	ok(sink_self_ns == sink_total_ns - src_total_ns,
+		"sink component's self time excludes the upstream calls");
+	bt_graph_put_ref(graph);
+}
+
+int main(void)
+{
+	plan_tests(NR_TESTS);
+	test_disabled();
+	test_enabled();
+	return exit_status();
+}
@@ -0,0 +1,212 @@
+/*
+ * test_fd_cache.c
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; under version 2 of the License.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <glib.h>
+
+#include <babeltrace2/babeltrace.h>
+#include <tap/tap.h>
+
+#include "fd-cache/fd-cache.h"
+
+#define NR_TESTS	16
+#define FILE_COUNT	3
+#define READ_COUNT	6
+
+static
+bool read_file_content(struct bt_fd_cache *fdc, const char *path,
+		const char *expected)
+{
+	struct bt_fd_cache_handle *handle;
+	char buf[64] = { 0 };
+	size_t len = strlen(expected);
+	ssize_t ret;
+
+	handle = bt_fd_cache_get_handle(fdc, path);
+	if (!handle) {
+		return false;
+	}
+
+	ret = pread(bt_fd_cache_handle_get_fd(handle), buf, len, 0);
+	bt_fd_cache_put_handle(fdc, handle);
+	return ret == (ssize_t) len && memcmp(buf, expected, len) == 0;
+}
+
+/*
+ * Reads `FILE_COUNT` files alternately through a cache which keeps at
+ * most one file descriptor open: each read evicts the idle file
+ * descriptor of the previous file and reopens its own file.
+ */
+static
+void test_alternate_reads(char **paths, char **contents)
+{
+	struct bt_fd_cache fdc;
+	unsigned int i;
+	bool all_ok = true;
+	bool bounded = true;
+
+	ok(bt_fd_cache_init(&fdc, BT_LOGGING_LEVEL_NONE) == 0,
+		"bt_fd_cache_init() succeeds");
+	bt_fd_cache_set_max_open_fds(&fdc, 1);
+
+	for (i = 0; i < READ_COUNT * FILE_COUNT; i++) {
+		unsigned int file_i = i % FILE_COUNT;
+
+		if (!read_file_content(&fdc, paths[file_i],
+				contents[file_i])) {
+			all_ok = false;
+		}
+
+		if (fdc.open_fd_count > 1) {
+			bounded = false;
+		}
+	}
+
+	ok(all_ok, "alternate reads with a limit of 1 return the right content");
+	ok(bounded, "alternate reads with a limit of 1 keep at most 1 open file descriptor");
+	ok(fdc.open_fd_count == 1,
+		"the last file descriptor is kept open while idle");
+	bt_fd_cache_fini(&fdc);
+}
+
+/*
+ * Checks that referenced handles are never evicted, even when they
+ * exceed the limit, and that the idle ones are evicted least recently
+ * used first.
+ */
+static
+void test_referenced_handles(char **paths, char **contents)
+{
+	struct bt_fd_cache fdc;
+	struct bt_fd_cache_handle *handles[FILE_COUNT];
+	unsigned int i;
+	bool all_ok = true;
+
+	ok(bt_fd_cache_init(&fdc, BT_LOGGING_LEVEL_NONE) == 0,
+		"bt_fd_cache_init() succeeds");
+	bt_fd_cache_set_max_open_fds(&fdc, 1);
+
+	for (i = 0; i < FILE_COUNT; i++) {
+		handles[i] = bt_fd_cache_get_handle(&fdc, paths[i]);
+		if (!handles[i]) {
+			all_ok = false;
+		}
+	}
+
+	ok(all_ok, "getting a handle for each file succeeds");
+	ok(fdc.open_fd_count == FILE_COUNT,
+		"referenced file descriptors exceed the limit");
+
+	for (i = 0; i < FILE_COUNT; i++) {
+		char buf[64] = { 0 };
+		size_t len = strlen(contents[i]);
+
+		if (!handles[i] ||
+				pread(bt_fd_cache_handle_get_fd(handles[i]),
+					buf, len, 0) != (ssize_t) len ||
+				memcmp(buf, contents[i], len) != 0) {
+			all_ok = false;
+		}
+	}
+
+	ok(all_ok, "referenced handles read the right content");
+
+	/* Getting the same file again reuses its file descriptor */
+	if (handles[0]) {
+		struct bt_fd_cache_handle *handle =
+			bt_fd_cache_get_handle(&fdc, paths[0]);
+
+		ok(handle == handles[0],
+			"getting a referenced file again returns the same handle");
+		bt_fd_cache_put_handle(&fdc, handle);
+	} else {
+		fail("getting a referenced file again returns the same handle");
+	}
+
+	for (i = 0; i < FILE_COUNT; i++) {
+		bt_fd_cache_put_handle(&fdc, handles[i]);
+	}
+
+	ok(fdc.open_fd_count == 1,
+		"putting handles evicts idle file descriptors down to the limit");
+
+	/* `paths[0]` was evicted first: reading it reopens it */
+	ok(read_file_content(&fdc, paths[0], contents[0]),
+		"reading an evicted file reopens it");
+	ok(fdc.open_fd_count == 1, "the limit of 1 is still respected");
+
+	/* `paths[0]` is now the least recently used idle file */
+	bt_fd_cache_set_max_open_fds(&fdc, 2);
+	ok(read_file_content(&fdc, paths[1], contents[1]),
+		"reading a second file with a limit of 2 succeeds");
+	ok(fdc.open_fd_count == 2,
+		"two idle file descriptors are kept open with a limit of 2");
+	ok(read_file_content(&fdc, paths[2], contents[2]) &&
+		read_file_content(&fdc, paths[0], contents[0]),
+		"reading the least recently used, evicted file again succeeds");
+	ok(fdc.open_fd_count == 2, "the limit of 2 is still respected");
+	bt_fd_cache_fini(&fdc);
+}
+
+int main(void)
+{
+	gchar *dir;
+	char *paths[FILE_COUNT] = { NULL };
+	char *contents[FILE_COUNT] = { NULL };
+	unsigned int i;
+
+	plan_tests(NR_TESTS);
+
+	dir = g_build_filename(g_get_tmp_dir(), "test_fd_cache-XXXXXX", NULL);
+	if (!mkdtemp(dir)) {
+		diag("Cannot create temporary directory.");
+		g_free(dir);
+		return 1;
+	}
+
+	for (i = 0; i < FILE_COUNT; i++) {
+		paths[i] = g_strdup_printf("%s" G_DIR_SEPARATOR_S "file%u",
+			dir, i);
+		contents[i] = g_strdup_printf("content of file #%u", i);
+
+		if (!g_file_set_contents(paths[i], contents[i], -1, NULL)) {
+			diag("Cannot write temporary file `%s`.", paths[i]);
+			goto end;
+		}
+	}
+
+	test_alternate_reads(paths, contents);
+	test_referenced_handles(paths, contents);
+
+end:
+	for (i = 0; i < FILE_COUNT; i++) {
+		if (paths[i]) {
+			unlink(paths[i]);
+		}
+
+		g_free(paths[i]);
+		g_free(contents[i]);
+	}
+
+	rmdir(dir);
+	g_free(dir);
+	return exit_status();
+}
@@ -0,0 +1,262 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; under version 2 of the License.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <babeltrace2/babeltrace.h>
+#include "common/assert.h"
+#include <glib.h>
+#include <stdbool.h>
+#include <inttypes.h>
+#include <stdint.h>
+#include <unistd.h>
+#include "tap/tap.h"
+
+#define NR_TESTS 15
+
+/* Durations (µs) */
+#define SHORT_DURATION_US	(50 * 1000)
+#define LONG_DURATION_US	(10 * 1000 * 1000)
+
+/*
+ * Tolerance (µs) when checking that a wait lasted at least some
+ * duration, and maximum duration (µs) of a wait which must return
+ * early.
+ */
+#define TOLERANCE_US		(2 * 1000)
+#define EARLY_MAX_US		(5 * 1000 * 1000)
+
+enum wait_mode {
+	WAIT_MODE_NONE,
+	WAIT_MODE_FD,
+	WAIT_MODE_TIMEOUT,
+};
+
+/* What the source message iterator declares before returning AGAIN */
+static struct {
+	enum wait_mode mode;
+	int fd;
+	uint64_t timeout_us;
+
+	/* True to make the source message iterator end */
+	bool ended;
+} src_iter_state;
+
+static
+bt_component_class_initialize_method_status src_init(
+		bt_self_component_source *self_comp,
+		bt_self_component_source_configuration *config,
+		const bt_value *params, void *init_method_data)
+{
+	bt_self_component_add_port_status status;
+
+	status = bt_self_component_source_add_output_port(self_comp,
+		"out", NULL, NULL);
+	BT_ASSERT(status == BT_SELF_COMPONENT_ADD_PORT_STATUS_OK);
+	return BT_COMPONENT_CLASS_INITIALIZE_METHOD_STATUS_OK;
+}
+
+static
+bt_message_iterator_class_next_method_status src_iter_next(
+		bt_self_message_iterator *self_msg_iter,
+		bt_message_array_const msgs, uint64_t capacity,
+		uint64_t *count)
+{
+	if (src_iter_state.ended) {
+		return BT_MESSAGE_ITERATOR_CLASS_NEXT_METHOD_STATUS_END;
+	}
+
+	switch (src_iter_state.mode) {
+	case WAIT_MODE_FD:
+		bt_self_message_iterator_set_wait_fd(self_msg_iter,
+			src_iter_state.fd);
+		break;
+	case WAIT_MODE_TIMEOUT:
+		bt_self_message_iterator_set_wait_timeout(self_msg_iter,
+			src_iter_state.timeout_us);
+		break;
+	default:
+		break;
+	}
+
+	return BT_MESSAGE_ITERATOR_CLASS_NEXT_METHOD_STATUS_AGAIN;
+}
+
+static
+bt_graph_simple_sink_component_consume_func_status sink_consume(
+		bt_message_iterator *iterator, void *data)
+{
+	bt_message_array_const msgs;
+	uint64_t count;
+
+	switch (bt_message_iterator_next(iterator, &msgs, &count)) {
+	case BT_MESSAGE_ITERATOR_NEXT_STATUS_AGAIN:
+		return BT_GRAPH_SIMPLE_SINK_COMPONENT_CONSUME_FUNC_STATUS_AGAIN;
+	case BT_MESSAGE_ITERATOR_NEXT_STATUS_END:
+		return BT_GRAPH_SIMPLE_SINK_COMPONENT_CONSUME_FUNC_STATUS_END;
+	default:
+		return BT_GRAPH_SIMPLE_SINK_COMPONENT_CONSUME_FUNC_STATUS_ERROR;
+	}
+}
+
+static
+bt_graph *create_graph(void)
+{
+	bt_message_iterator_class *msg_iter_cls;
+	bt_component_class_source *src_comp_cls;
+	bt_graph *graph;
+	const bt_component_source *src_comp = NULL;
+	const bt_component_sink *sink_comp = NULL;
+	bt_graph_add_component_status add_comp_status;
+	bt_graph_connect_ports_status connect_status;
+	bt_component_class_set_method_status set_method_status;
+
+	msg_iter_cls = bt_message_iterator_class_create(src_iter_next);
+	BT_ASSERT(msg_iter_cls);
+	src_comp_cls = bt_component_class_source_create("src", msg_iter_cls);
+	BT_ASSERT(src_comp_cls);
+	set_method_status = bt_component_class_source_set_initialize_method(
+		src_comp_cls, src_init);
+	BT_ASSERT(set_method_status == BT_COMPONENT_CLASS_SET_METHOD_STATUS_OK);
+	graph = bt_graph_create(0);
+	BT_ASSERT(graph);
+	add_comp_status = bt_graph_add_source_component(graph, src_comp_cls,
+		"src", NULL, BT_LOGGING_LEVEL_NONE, &src_comp);
+	BT_ASSERT(add_comp_status == BT_GRAPH_ADD_COMPONENT_STATUS_OK);
+	add_comp_status = bt_graph_add_simple_sink_component(graph, "sink",
+		NULL, sink_consume, NULL, NULL, &sink_comp);
+	BT_ASSERT(add_comp_status == BT_GRAPH_ADD_COMPONENT_STATUS_OK);
+	connect_status = bt_graph_connect_ports(graph,
+		bt_component_source_borrow_output_port_by_index_const(
+			src_comp, 0),
+		bt_component_sink_borrow_input_port_by_name_const(
+			sink_comp, "in"), NULL);
+	BT_ASSERT(connect_status == BT_GRAPH_CONNECT_PORTS_STATUS_OK);
+	bt_component_class_source_put_ref(src_comp_cls);
+	bt_message_iterator_class_put_ref(msg_iter_cls);
+	return graph;
+}
+
+/*
+ * Calls bt_graph_wait() on `graph` for at most `max_duration_us` and
+ * returns how long it lasted (µs).
+ */
+static
+int64_t timed_wait(bt_graph *graph, uint64_t max_duration_us)
+{
+	int64_t begin_us = g_get_monotonic_time();
+	bt_graph_wait_status status;
+
+	status = bt_graph_wait(graph, max_duration_us);
+	ok(status == BT_GRAPH_WAIT_STATUS_OK,
+		"bt_graph_wait() succeeds (max duration: %" PRIu64 " µs)",
+		max_duration_us);
+	return g_get_monotonic_time() - begin_us;
+}
+
+static
+void run_once_expect_again(bt_graph *graph)
+{
+	ok(bt_graph_run_once(graph) == BT_GRAPH_RUN_ONCE_STATUS_AGAIN,
+		"bt_graph_run_once() returns AGAIN");
+}
+
+static
+void test_no_wait_condition(void)
+{
+	bt_graph *graph = create_graph();
+	int64_t duration_us;
+
+	src_iter_state.mode = WAIT_MODE_NONE;
+	src_iter_state.ended = false;
+	run_once_expect_again(graph);
+	duration_us = timed_wait(graph, SHORT_DURATION_US);
+	ok(duration_us >= SHORT_DURATION_US - TOLERANCE_US,
+		"without wait condition, bt_graph_wait() waits for the maximum duration (%" PRId64 " µs)",
+		duration_us);
+	bt_graph_put_ref(graph);
+}
+
+static
+void test_wait_timeout(void)
+{
+	bt_graph *graph = create_graph();
+	int64_t duration_us;
+
+	src_iter_state.mode = WAIT_MODE_TIMEOUT;
+	src_iter_state.timeout_us = SHORT_DURATION_US;
+	src_iter_state.ended = false;
+	run_once_expect_again(graph);
+	duration_us = timed_wait(graph, LONG_DURATION_US);
+	ok(duration_us >= SHORT_DURATION_US - TOLERANCE_US &&
+		duration_us < EARLY_MAX_US,
+		"bt_graph_wait() returns when the declared timeout expires (%" PRId64 " µs)",
+		duration_us);
+	src_iter_state.ended = true;
+	ok(bt_graph_run_once(graph) == BT_GRAPH_RUN_ONCE_STATUS_END,
+		"bt_graph_run_once() returns END once the iterator ends");
+	bt_graph_put_ref(graph);
+}
+
+static
+void test_wait_fd(void)
+{
+	bt_graph *graph = create_graph();
+	int64_t duration_us;
+	int fds[2];
+	int ret;
+
+	ret = pipe(fds);
+	BT_ASSERT(ret == 0);
+	src_iter_state.mode = WAIT_MODE_FD;
+	src_iter_state.fd = fds[0];
+	src_iter_state.ended = false;
+	run_once_expect_again(graph);
+
+	/* Nothing to read yet */
+	duration_us = timed_wait(graph, SHORT_DURATION_US);
+	ok(duration_us >= SHORT_DURATION_US - TOLERANCE_US,
+		"bt_graph_wait() waits for the maximum duration when the file descriptor is not ready (%" PRId64 " µs)",
+		duration_us);
+
+	ret = write(fds[1], "x", 1);
+	BT_ASSERT(ret == 1);
+	duration_us = timed_wait(graph, LONG_DURATION_US);
+	ok(duration_us < EARLY_MAX_US,
+		"bt_graph_wait() returns when the declared file descriptor is ready (%" PRId64 " µs)",
+		duration_us);
+
+	/*
+	 * The wait conditions are reset when the graph runs again:
+	 * the file descriptor, still ready, is not waited for anymore.
+	 */
+	src_iter_state.mode = WAIT_MODE_NONE;
+	run_once_expect_again(graph);
+	duration_us = timed_wait(graph, SHORT_DURATION_US);
+	ok(duration_us >= SHORT_DURATION_US - TOLERANCE_US,
+		"running the graph again resets the wait conditions (%" PRId64 " µs)",
+		duration_us);
+
+	bt_graph_put_ref(graph);
+	close(fds[0]);
+	close(fds[1]);
+}
+
+int main(void)
+{
+	plan_tests(NR_TESTS);
+	test_no_wait_condition();
+	test_wait_timeout();
+	test_wait_fd();
+	return exit_status();
+}
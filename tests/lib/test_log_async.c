@@ -0,0 +1,197 @@
+/*
+ * test_log_async.c
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; under version 2 of the License.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#define BT_LOG_OUTPUT_LEVEL BT_LOG_INFO
+#define BT_LOG_TAG "TEST/LOG-ASYNC"
+#include "logging/log.h"
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <glib.h>
+
+#include <babeltrace2/babeltrace.h>
+#include "common/assert.h"
+#include "tap/tap.h"
+
+/* Thread 0 is the main thread */
+#define THREAD_COUNT	4
+#define LINE_COUNT	200
+#define NR_TESTS	(3 + THREAD_COUNT)
+
+#define GRAPH_LINE	"Created graph object"
+
+static
+gpointer log_thread(gpointer data)
+{
+	unsigned int thread_id = GPOINTER_TO_UINT(data);
+	unsigned int seq;
+
+	for (seq = 0; seq < LINE_COUNT; seq++) {
+		BT_LOGI("thread=%u seq=%u", thread_id, seq);
+	}
+
+	return NULL;
+}
+
+/*
+ * Child process: logs, with the asynchronous backend, `LINE_COUNT`
+ * lines from each thread to `path`. The main thread also makes the
+ * library log a line after each of its own lines.
+ */
+static
+void log_child(const char *path)
+{
+	GThread *threads[THREAD_COUNT];
+	unsigned int i;
+	unsigned int seq;
+	FILE *fp;
+
+	fp = freopen(path, "w", stderr);
+	if (!fp) {
+		exit(1);
+	}
+
+	bt_logging_set_global_level(BT_LOGGING_LEVEL_INFO);
+
+	for (i = 1; i < THREAD_COUNT; i++) {
+		threads[i] = g_thread_new("logger", log_thread,
+			GUINT_TO_POINTER(i));
+	}
+
+	for (seq = 0; seq < LINE_COUNT; seq++) {
+		BT_LOGI("thread=%u seq=%u", 0, seq);
+		bt_graph_put_ref(bt_graph_create(0));
+	}
+
+	for (i = 1; i < THREAD_COUNT; i++) {
+		g_thread_join(threads[i]);
+	}
+
+	/* The remaining records are written when the library is finalized */
+	exit(0);
+}
+
+static
+void check_output(const char *path)
+{
+	gchar *content = NULL;
+	gchar **lines = NULL;
+	unsigned int next_seq[THREAD_COUNT] = { 0 };
+	bool in_order[THREAD_COUNT];
+	bool graph_lines_ordered = true;
+	bool dropped = false;
+	unsigned int graph_line_count = 0;
+	unsigned int i;
+
+	for (i = 0; i < THREAD_COUNT; i++) {
+		in_order[i] = true;
+	}
+
+	if (!g_file_get_contents(path, &content, NULL, NULL)) {
+		diag("Cannot read log file `%s`.", path);
+		content = g_strdup("");
+	}
+
+	lines = g_strsplit(content, "\n", -1);
+
+	for (i = 0; lines[i]; i++) {
+		const char *line = lines[i];
+		const char *thread_str = strstr(line, "thread=");
+		unsigned int thread_id, seq;
+
+		if (strstr(line, "Dropped")) {
+			dropped = true;
+		} else if (strstr(line, GRAPH_LINE)) {
+			graph_line_count++;
+		} else if (thread_str && sscanf(thread_str, "thread=%u seq=%u",
+				&thread_id, &seq) == 2 && thread_id < THREAD_COUNT) {
+			if (seq != next_seq[thread_id]) {
+				in_order[thread_id] = false;
+			}
+
+			next_seq[thread_id] = seq + 1;
+
+			if (thread_id == 0) {
+				/*
+				 * Exactly one library line follows each
+				 * line of the main thread.
+				 */
+				if (seq > 0 && graph_line_count != 1) {
+					graph_lines_ordered = false;
+				}
+
+				graph_line_count = 0;
+			}
+		}
+	}
+
+	if (graph_line_count != 1) {
+		graph_lines_ordered = false;
+	}
+
+	for (i = 0; i < THREAD_COUNT; i++) {
+		ok(in_order[i] && next_seq[i] == LINE_COUNT,
+			"all the lines of thread #%u are written in order", i);
+	}
+
+	ok(graph_lines_ordered,
+		"the lines of the library and of the program are written in order");
+	ok(!dropped, "no log record is dropped");
+	g_strfreev(lines);
+	g_free(content);
+}
+
+int main(void)
+{
+	gchar *path;
+	pid_t pid;
+	int fd;
+	int status;
+
+	path = g_build_filename(g_get_tmp_dir(), "test_log_async-XXXXXX",
+		NULL);
+	fd = mkstemp(path);
+	if (fd < 0) {
+		diag("Cannot create temporary file.");
+		g_free(path);
+		return 1;
+	}
+
+	close(fd);
+	fflush(stdout);
+	setenv("BABELTRACE_LOGGING_ASYNC", "1", 1);
+	pid = fork();
+	if (pid == 0) {
+		log_child(path);
+	}
+
+	/* Planned after forking: the child process must not report */
+	plan_tests(NR_TESTS);
+
+	ok(pid > 0 && waitpid(pid, &status, 0) == pid &&
+		WIFEXITED(status) && WEXITSTATUS(status) == 0,
+		"child process logs and exits successfully");
+	check_output(path);
+	unlink(path);
+	g_free(path);
+	return exit_status();
+}
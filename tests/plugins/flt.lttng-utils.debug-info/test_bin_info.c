@@ -37,7 +37,7 @@
 
 #include "tap/tap.h"
 
-#define NR_TESTS 57
+#define NR_TESTS 67
 
 #define SO_NAME "libhello_so"
 #define DEBUG_NAME "libhello_so.debug"
@@ -365,6 +365,7 @@ void test_bin_info_bundled(const char *bin_info_dir)
 	int ret;
 	char *data_dir, *bin_path;
 	struct bin_info *bin = NULL;
+	struct bin_info *other_bin = NULL;
 	struct bt_fd_cache fdc;
 
 	diag("bin-info tests - DWARF bundled in SO file");
@@ -404,6 +405,23 @@ void test_bin_info_bundled(const char *bin_info_dir)
 				       opt_func_foo_tp_line_no,
 				       FUNC_FOO_FILENAME);
 
+	/* Test source location lookup - inlined function, cached result */
+	subtest_lookup_source_location(bin, func_foo_tp_addr,
+				       opt_func_foo_tp_line_no,
+				       FUNC_FOO_FILENAME);
+
+	/* Test DWARF file sharing between bin_info objects */
+	other_bin = bin_info_create(&fdc, bin_path, SO_LOW_ADDR, SO_MEMSZ,
+		true, data_dir, NULL, BT_LOG_OUTPUT_LEVEL, NULL);
+	ok(other_bin, "bin_info_create successful (%s)", bin_path);
+	subtest_lookup_source_location(other_bin, func_foo_tp_addr,
+				       opt_func_foo_tp_line_no,
+				       FUNC_FOO_FILENAME);
+	ok(other_bin && other_bin->dwarf_file &&
+		other_bin->dwarf_file == bin->dwarf_file,
+		"bin_info objects share the same DWARF file");
+
+	bin_info_destroy(other_bin);
 	bin_info_destroy(bin);
 	bt_fd_cache_fini(&fdc);
 	g_free(data_dir);
@@ -18,6 +18,8 @@ import unittest
 import bt2
 import os
 import re
+import shutil
+import tempfile
 
 
 test_ctf_traces_path = os.environ['BT_CTF_TRACES_PATH']
@@ -288,5 +290,69 @@ class QueryTraceInfoPacketTimestampQuirksTestCase(unittest.TestCase):
         self.assertEqual(streams[0]['range-ns']['end'], 1565891729293526525)
 
 
+class QueryLightTraceInfoTestCase(unittest.TestCase):
+    def setUp(self):
+        ctf = bt2.find_plugin('ctf')
+        self._fs = ctf.source_component_classes['fs']
+
+    def _query(self, obj, inputs):
+        return bt2.QueryExecutor(self._fs, obj, {'inputs': inputs}).query()
+
+    # The `light-trace-infos` query object must give the same result as
+    # `babeltrace.trace-infos` for traces without tracer bugs to fix.
+
+    def _test_same_as_trace_infos_abs(self, trace_path):
+        inputs = [trace_path]
+        res = self._query('babeltrace.trace-infos', inputs)
+        light_res = self._query('light-trace-infos', inputs)
+        self.assertEqual(light_res, res)
+
+    def _test_same_as_trace_infos(self, *path):
+        self._test_same_as_trace_infos_abs(os.path.join(test_ctf_traces_path, *path))
+
+    def test_same_as_trace_infos(self):
+        self._test_same_as_trace_infos('intersection', '3eventsintersect')
+
+    def test_same_as_trace_infos_multiple_packets(self):
+        self._test_same_as_trace_infos('succeed', '2packets')
+
+    def test_same_as_trace_infos_multiple_files(self):
+        self._test_same_as_trace_infos('succeed', 'trace-with-index')
+
+    def test_same_as_trace_infos_no_range(self):
+        self._test_same_as_trace_infos('succeed', 'succeed1')
+
+    # Without an index file, `light-trace-infos` reads all the packets
+    # of a data stream file, but only keeps the first and last ones:
+    # each data stream file of this trace has five packets.
+
+    def test_same_as_trace_infos_multiple_packets_no_index(self):
+        with tempfile.TemporaryDirectory() as temp_dir:
+            trace_path = os.path.join(temp_dir, 'trace-without-index')
+            shutil.copytree(
+                os.path.join(test_ctf_traces_path, 'succeed', 'trace-with-index'),
+                trace_path,
+                ignore=shutil.ignore_patterns('index'),
+            )
+            self._test_same_as_trace_infos_abs(trace_path)
+
+    def test_clock_class_offset_s(self):
+        res = bt2.QueryExecutor(
+            self._fs,
+            'light-trace-infos',
+            {
+                'inputs': [
+                    os.path.join(
+                        test_ctf_traces_path, 'intersection', '3eventsintersect'
+                    )
+                ],
+                'clock-class-offset-s': 2,
+            },
+        ).query()
+        streams = sorted(res[0]['stream-infos'], key=sort_predictably)
+        self.assertEqual(streams[0]['range-ns']['begin'], 13515311000000000)
+        self.assertEqual(streams[1]['range-ns']['end'], 13515311000000120)
+
+
 if __name__ == '__main__':
     unittest.main()
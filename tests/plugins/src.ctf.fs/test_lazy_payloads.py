@@ -0,0 +1,113 @@
+# This program is free software; you can redistribute it and/or
+# modify it under the terms of the GNU General Public License
+# as published by the Free Software Foundation; only version 2
+# of the License.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program; if not, write to the Free Software
+# Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+
+import unittest
+import bt2
+import os
+
+
+test_ctf_traces_path = os.environ['BT_CTF_TRACES_PATH']
+
+# Every payload of this trace has a static binary layout: little-endian
+# (`le` event class) or big-endian (`be` event class) integers,
+# enumerations, real numbers, and static arrays, most of them not
+# starting on a byte boundary.
+_STATIC_PAYLOADS_TRACE_PATH = os.path.join(
+    test_ctf_traces_path, 'succeed', 'static-payloads'
+)
+
+_EXPECTED_EVENTS = [
+    (
+        'le',
+        5,
+        {
+            'u5': 31,
+            's13': -4096,
+            'e2': 2,
+            'a4': [1, 15, 8],
+            'f32': -1.5,
+            's64': -123456789012345,
+        },
+    ),
+    (
+        'be',
+        1,
+        {'u8': 200, 's7': -64, 'e3': 5, 'a6': [63, 1], 'f64': 2.5, 'u9': 511},
+    ),
+    (
+        'le',
+        2,
+        {
+            'u5': 0,
+            's13': 4095,
+            'e2': 1,
+            'a4': [0, 7, 10],
+            'f32': 3.25,
+            's64': 9223372036854775807,
+        },
+    ),
+    (
+        'be',
+        6,
+        {'u8': 0, 's7': 63, 'e3': 1, 'a6': [32, 17], 'f64': -0.125, 'u9': 256},
+    ),
+]
+
+
+class LazyPayloadsTestCase(unittest.TestCase):
+    # Returns the event messages of the static payloads trace.
+    #
+    # This function gets all the messages before returning so that the
+    # caller borrows the payload fields of lazy events after the
+    # message iterator is done with their packet.
+    def _get_event_msgs(self, lazy_payloads):
+        spec = bt2.ComponentSpec.from_named_plugin_and_component_class(
+            'ctf',
+            'fs',
+            {
+                'inputs': [_STATIC_PAYLOADS_TRACE_PATH],
+                'lazy-payloads': lazy_payloads,
+            },
+        )
+        msg_iter = bt2.TraceCollectionMessageIterator(spec)
+        return [msg for msg in msg_iter if type(msg) is bt2._EventMessageConst]
+
+    def _check_events(self, lazy_payloads):
+        msgs = self._get_event_msgs(lazy_payloads)
+        self.assertEqual(len(msgs), len(_EXPECTED_EVENTS))
+
+        for msg, (name, ctx, payload) in zip(msgs, _EXPECTED_EVENTS):
+            event = msg.event
+            self.assertEqual(event.name, name)
+            self.assertEqual(event.common_context_field['ctx'], ctx)
+            self.assertEqual(event.payload_field, payload)
+
+            # Borrowing the payload field again gives the same values
+            self.assertEqual(event.payload_field, payload)
+
+    def test_eager_payloads(self):
+        self._check_events(False)
+
+    def test_lazy_payloads(self):
+        self._check_events(True)
+
+    def test_lazy_payloads_enum_labels(self):
+        msgs = self._get_event_msgs(True)
+        self.assertEqual(msgs[0].event.payload_field['e2'].labels, ['C'])
+        self.assertEqual(msgs[1].event.payload_field['e3'].labels, ['Y'])
+        self.assertEqual(msgs[3].event.payload_field['e3'].labels, ['X'])
+
+
+if __name__ == '__main__':
+    unittest.main()